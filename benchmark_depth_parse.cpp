@@ -0,0 +1,182 @@
+#include "api/BinanceMessages.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace MasterMind;
+
+namespace {
+constexpr int WARMUP = 10000;
+constexpr int ITERATIONS = 200000;
+constexpr double TARGET_NANOS = 1000;  // A 10-level diff must decode well inside this
+
+const std::string TRADE = "{\"e\":\"trade\",\"E\":1718000000123,\"s\":\"BTCUSDT\",\"t\":3400000123,"
+                          "\"p\":\"67250.01000000\",\"q\":\"0.01820000\",\"T\":1718000000122,\"m\":true,\"M\":true}";
+
+std::string price(double base, int level, int direction) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.2f", base + direction * 0.01 * level);
+    return text;
+}
+
+std::string quantity(int level) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.8f", 0.01 + 0.37913117 * ((level * 7919) % 23));
+    return text;
+}
+
+// Binance-style levels: [["price","quantity"],...], best first
+std::string levels(int count, double best, int direction) {
+    std::string out = "[";
+    for (int i = 0; i < count; ++i) {
+        out += (i ? ",[\"" : "[\"") + price(best, i, direction) + "\",\"" + quantity(i + (direction > 0)) + "\"]";
+    }
+    return out + "]";
+}
+
+std::string depthUpdate(int count) {
+    return "{\"e\":\"depthUpdate\",\"E\":1718000000081,\"s\":\"BTCUSDT\",\"U\":47000000002,\"u\":47000000007,"
+           "\"b\":" + levels(count, 67249.99, -1) + ",\"a\":" + levels(count, 67250.00, 1) + "}";
+}
+
+std::string depthSnapshot(int count) {
+    return "{\"lastUpdateId\":47000000001,\"bids\":" + levels(count, 67249.99, -1) +
+           ",\"asks\":" + levels(count, 67250.00, 1) + "}";
+}
+
+// The quoted numbers of a payload, for the strtod baseline and the result check
+std::vector<std::string> numbers(const std::string& payload, size_t from) {
+    std::vector<std::string> out;
+    for (size_t quote = payload.find("[\"", from); quote != std::string::npos; quote = payload.find("[\"", quote + 1)) {
+        size_t start = quote + 2;
+        size_t end = payload.find('"', start);
+        out.push_back(payload.substr(start, end - start));
+        start = payload.find('"', end + 1) + 1;
+        out.push_back(payload.substr(start, payload.find('"', start) - start));
+    }
+    return out;
+}
+
+bool sameAsStrtod(const BinanceDepthUpdate& update, const std::vector<std::string>& expected) {
+    std::vector<double> decoded;
+    for (const auto* side : {&update.bids, &update.asks}) {
+        for (const auto& level : *side) {
+            decoded.push_back(level.price);
+            decoded.push_back(level.quantity);
+        }
+    }
+    if (decoded.size() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < decoded.size(); ++i) {
+        double reference = std::strtod(expected[i].c_str(), nullptr);
+        if (std::memcmp(&decoded[i], &reference, sizeof(double)) != 0) {
+            std::cout << expected[i] << " decoded as " << std::setprecision(17) << decoded[i] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Per-call latency in nanoseconds, sorted
+std::vector<double> measure(const std::function<size_t(int)>& parseOnce, size_t& sink) {
+    for (int i = 0; i < WARMUP; ++i) {
+        sink += parseOnce(i);
+    }
+    std::vector<double> samples;
+    samples.reserve(ITERATIONS);
+    for (int i = 0; i < ITERATIONS; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        sink += parseOnce(i);
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples;
+}
+
+// Prints one row and returns its p99
+double report(const std::string& name, const std::vector<double>& samples) {
+    double total = 0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    auto percentile = [&samples](double p) { return samples[static_cast<size_t>(p * (samples.size() - 1))]; };
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << total / samples.size() << std::setw(10) << percentile(0.5)
+              << std::setw(10) << percentile(0.99) << std::setw(10) << percentile(0.999) << std::endl;
+    return percentile(0.99);
+}
+}
+
+int main() {
+    std::cout << "\n=== DEPTH PARSE BENCHMARK ===\n" << std::endl;
+
+    const std::string diff = depthUpdate(10);
+    const std::string combined = "{\"stream\":\"btcusdt@depth@100ms\",\"data\":" + diff + "}";
+    const std::string snapshot = depthSnapshot(100);
+    const std::vector<std::string> diffNumbers = numbers(diff, 0);
+
+    // One output struct per stream, as VenueCodec keeps them
+    BinanceDepthUpdate update;
+    BinanceTrade trade;
+    if (!BinanceMessageParser::parseDepthUpdate(diff.data(), diff.size(), update) || update.bids.size() != 10 ||
+        update.finalUpdateId != 47000000007ULL || !sameAsStrtod(update, diffNumbers)) {
+        std::cout << "depthUpdate decoded wrong" << std::endl;
+        return 1;
+    }
+    if (!BinanceMessageParser::parseDepthUpdate(snapshot.data(), snapshot.size(), update) ||
+        !sameAsStrtod(update, numbers(snapshot, 0))) {
+        std::cout << "Depth snapshot decoded wrong" << std::endl;
+        return 1;
+    }
+    if (!BinanceMessageParser::parseTrade(TRADE.data(), TRADE.size(), trade) || trade.price != 67250.01) {
+        std::cout << "Trade decoded wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "depthUpdate: 10 levels a side, " << diff.size() << " bytes; snapshot: 100 levels a side, "
+              << snapshot.size() << " bytes; " << ITERATIONS << " iterations\n" << std::endl;
+
+    size_t sink = 0;
+    std::cout << std::left << std::setw(32) << "ns per message" << std::right << std::setw(10) << "mean"
+              << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::endl;
+    double diffP99 = report("depthUpdate, 10 levels", measure([&](int) {
+        BinanceMessageParser::parseDepthUpdate(diff.data(), diff.size(), update);
+        return update.bids.size();
+    }, sink));
+    report("stream envelope + depthUpdate", measure([&](int) {
+        std::string_view stream;
+        std::string_view payload;
+        BinanceMessageParser::parseStreamEnvelope(combined.data(), combined.size(), stream, payload);
+        BinanceMessageParser::parseDepthUpdate(payload.data(), payload.size(), update);
+        return update.asks.size();
+    }, sink));
+    report("strtod only, same 40 numbers", measure([&](int) {
+        double total = 0;
+        for (const auto& number : diffNumbers) {
+            total += std::strtod(number.c_str(), nullptr);
+        }
+        return static_cast<size_t>(total);
+    }, sink));
+    report("trade", measure([&](int) {
+        BinanceMessageParser::parseTrade(TRADE.data(), TRADE.size(), trade);
+        return static_cast<size_t>(trade.tradeId);
+    }, sink));
+    report("depth snapshot, 100 levels", measure([&](int) {
+        BinanceMessageParser::parseDepthUpdate(snapshot.data(), snapshot.size(), update);
+        return update.bids.size();
+    }, sink));
+
+    std::cout << "\ndepthUpdate p99 " << std::fixed << std::setprecision(0) << diffP99 << " ns ("
+              << (diffP99 < TARGET_NANOS ? "within" : "over") << " the " << TARGET_NANOS << " ns budget)" << std::endl;
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "core/ExposureTracker.h"
+#include "core/PreTradeRiskCheck.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MasterMind;
+
+namespace {
+constexpr int SYMBOLS = 64;
+constexpr int WARMUP = 10000;
+constexpr int ITERATIONS = 200000;
+constexpr double TARGET_NANOS = 1000;  // Budget for one check on the submission path
+
+std::vector<Order> makeOrders(const std::string& prefix, OrderSide side) {
+    std::vector<Order> orders(SYMBOLS);
+    for (int i = 0; i < SYMBOLS; ++i) {
+        orders[i].orderId = "bench-" + std::to_string(i);
+        orders[i].symbol = prefix + std::to_string(i) + "USDT";
+        orders[i].side = side;
+        orders[i].price = 100.0 + i;
+        orders[i].quantity = 0.5;
+        orders[i].stopLoss = side == OrderSide::BUY ? 99.0 + i : 101.0 + i;
+    }
+    return orders;
+}
+
+// Per-call latency in nanoseconds, sorted
+std::vector<double> measure(const std::function<size_t(int)>& checkOnce, size_t& sink) {
+    for (int i = 0; i < WARMUP; ++i) {
+        sink += checkOnce(i);
+    }
+    std::vector<double> samples;
+    samples.reserve(ITERATIONS);
+    for (int i = 0; i < ITERATIONS; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        sink += checkOnce(i);
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples;
+}
+
+// Prints one row and returns its p99
+double report(const std::string& name, const std::vector<double>& samples) {
+    double total = 0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    auto percentile = [&samples](double p) { return samples[static_cast<size_t>(p * (samples.size() - 1))]; };
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << total / samples.size() << std::setw(10) << percentile(0.5)
+              << std::setw(10) << percentile(0.99) << std::setw(10) << percentile(0.999) << std::endl;
+    return percentile(0.99);
+}
+
+bool expect(const PreTradeRiskCheck& gate, const Order& order, RiskRejectReason expected) {
+    RiskRejectReason reason = gate.check(order);
+    if (reason != expected) {
+        std::cout << order.symbol << ": " << PreTradeRiskCheck::reasonToString(reason) << ", expected "
+                  << PreTradeRiskCheck::reasonToString(expected) << std::endl;
+        return false;
+    }
+    return true;
+}
+}
+
+int main() {
+    std::cout << "\n=== PRE-TRADE RISK CHECK BENCHMARK ===\n" << std::endl;
+
+    // Registered symbols hold a long position each; orders on other symbols
+    // fall back to the default limits
+    ExposureTracker positions;
+    PreTradeRiskCheck gate(&positions);
+    gate.updateAccount(1e9, false);
+    gate.setDefaultLimits(1e6, 1e12);
+    std::vector<Order> buys = makeOrders("REG", OrderSide::BUY);
+    std::vector<Order> exits = makeOrders("REG", OrderSide::SELL);
+    std::vector<Order> unregistered = makeOrders("DEF", OrderSide::BUY);
+    for (const auto& order : buys) {
+        gate.setSymbolLimits(order.symbol, 1e6, 1e12);
+        positions.setPosition(order.symbol, 2.0, order.price, order.price);
+    }
+
+    // Same book with the drawdown gate tripped, and one halted outright
+    PreTradeRiskCheck halted(&positions);
+    halted.updateAccount(1e9, true);
+    PreTradeRiskCheck stopped(&positions);
+    stopped.setEmergencyStop(true);
+
+    if (!expect(gate, buys[0], RiskRejectReason::NONE) || !expect(gate, unregistered[0], RiskRejectReason::NONE) ||
+        !expect(halted, exits[0], RiskRejectReason::NONE) || !expect(halted, buys[0], RiskRejectReason::DRAWDOWN_LIMIT) ||
+        !expect(stopped, buys[0], RiskRejectReason::EMERGENCY_STOP)) {
+        return 1;
+    }
+    std::cout << SYMBOLS << " registered symbols with open positions, " << ITERATIONS << " iterations\n" << std::endl;
+
+    size_t sink = 0;
+    double worst = 0;
+    std::cout << std::left << std::setw(32) << "ns per check" << std::right << std::setw(10) << "mean"
+              << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::endl;
+    worst = std::max(worst, report("pass, symbol limits", measure([&](int i) {
+        return static_cast<size_t>(gate.check(buys[i % SYMBOLS]));
+    }, sink)));
+    worst = std::max(worst, report("pass, default limits", measure([&](int i) {
+        return static_cast<size_t>(gate.check(unregistered[i % SYMBOLS]));
+    }, sink)));
+    worst = std::max(worst, report("exit under drawdown", measure([&](int i) {
+        return static_cast<size_t>(halted.check(exits[i % SYMBOLS]));
+    }, sink)));
+    worst = std::max(worst, report("reject, drawdown", measure([&](int i) {
+        return static_cast<size_t>(halted.check(buys[i % SYMBOLS]));
+    }, sink)));
+    worst = std::max(worst, report("reject, emergency stop", measure([&](int i) {
+        return static_cast<size_t>(stopped.check(buys[i % SYMBOLS]));
+    }, sink)));
+
+    // Limits and positions republished from another thread while checking
+    std::atomic<bool> writing{true};
+    std::thread writer([&]() {
+        for (uint64_t n = 0; writing.load(std::memory_order_relaxed); ++n) {
+            const Order& order = buys[n % SYMBOLS];
+            gate.updateAccount(1e9 - static_cast<double>(n % 1000), false);
+            gate.setSymbolLimits(order.symbol, 1e6, 1e12);
+            positions.onFill(order.symbol, n % 2 ? OrderSide::BUY : OrderSide::SELL, 0.001, order.price);
+        }
+    });
+    worst = std::max(worst, report("pass, concurrent publishing", measure([&](int i) {
+        return static_cast<size_t>(gate.check(buys[i % SYMBOLS]));
+    }, sink)));
+    writing = false;
+    writer.join();
+
+    std::cout << "\nWorst p99 " << std::fixed << std::setprecision(0) << worst << " ns ("
+              << (worst < TARGET_NANOS ? "within" : "over") << " the " << TARGET_NANOS << " ns budget)" << std::endl;
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "api/RequestSigner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef SSL_ENABLED
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#endif
+
+using namespace MasterMind;
+
+namespace {
+// Binance API documentation example
+const std::string SECRET = "NhqPtmdSJYdKjVHjA7PZj4Mge3R5YNiP1e3UZjInClVN65XAbvqqM6A7H5fATj0j";
+const std::string EXAMPLE_QUERY = "symbol=LTCBTC&side=BUY&type=LIMIT&timeInForce=GTC&quantity=1&price=0.1"
+                                  "&recvWindow=5000&timestamp=1499827319559";
+const std::string EXAMPLE_SIGNATURE = "c8db56825ae71d6d79447849e617115f4a920fa2acdcab2b053c4b2838bd6b71";
+
+const std::string ORDER_PARAMS = "symbol=BTCUSDT&side=BUY&type=LIMIT&quantity=0.00100000&price=65000.00000000"
+                                 "&timeInForce=GTC&newClientOrderId=BN1760000000000-1";
+
+constexpr int WARMUP = 10000;
+constexpr int ITERATIONS = 200000;
+
+// What BinanceAPI::signParams did before RequestSigner
+std::string legacySignParams(const std::string& params, int64_t timestamp) {
+    std::string fullParams = params;
+    if (!fullParams.empty()) {
+        fullParams += "&";
+    }
+    fullParams += "timestamp=" + std::to_string(timestamp);
+
+#ifdef SSL_ENABLED
+    unsigned char hash[SHA256_DIGEST_LENGTH];
+    unsigned int hash_len = SHA256_DIGEST_LENGTH;
+    HMAC(EVP_sha256(), SECRET.c_str(), SECRET.length(),
+         reinterpret_cast<const unsigned char*>(fullParams.c_str()), fullParams.length(), hash, &hash_len);
+    std::ostringstream ss;
+    for (unsigned int i = 0; i < hash_len; ++i) {
+        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
+    }
+#else
+    std::hash<std::string> hasher;
+    std::ostringstream ss;
+    ss << std::hex << hasher(fullParams + SECRET);
+#endif
+    return fullParams + "&signature=" + ss.str();
+}
+
+// Per-call latency in nanoseconds, sorted
+std::vector<double> measure(const std::function<size_t(int)>& signOnce, size_t& sink) {
+    for (int i = 0; i < WARMUP; ++i) {
+        sink += signOnce(i);
+    }
+    std::vector<double> samples;
+    samples.reserve(ITERATIONS);
+    for (int i = 0; i < ITERATIONS; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        sink += signOnce(i);
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples;
+}
+
+void report(const std::string& name, const std::vector<double>& samples) {
+    double total = 0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    auto percentile = [&samples](double p) { return samples[static_cast<size_t>(p * (samples.size() - 1))]; };
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << total / samples.size() << std::setw(10) << percentile(0.5)
+              << std::setw(10) << percentile(0.99) << std::setw(10) << percentile(0.999) << std::endl;
+}
+}
+
+int main() {
+    std::cout << "\n=== REQUEST SIGNING BENCHMARK ===\n" << std::endl;
+
+    RequestSigner signer(SECRET);
+    std::string signature = signer.sign(EXAMPLE_QUERY);
+    if (signature != EXAMPLE_SIGNATURE) {
+        std::cout << "Signature mismatch: " << signature << " expected " << EXAMPLE_SIGNATURE << std::endl;
+        return 1;
+    }
+#ifdef SSL_ENABLED
+    const int64_t timestamp = 1760000000000;
+    std::string legacy = legacySignParams(ORDER_PARAMS, timestamp);
+    if (legacy != signer.signParams(ORDER_PARAMS, timestamp)) {
+        std::cout << "RequestSigner disagrees with one-shot HMAC" << std::endl;
+        return 1;
+    }
+    std::cout << "Legacy path: one-shot OpenSSL HMAC, ostringstream hex" << std::endl;
+#else
+    std::cout << "Legacy path: std::hash placeholder (built without OpenSSL)" << std::endl;
+#endif
+    std::cout << "Order query: " << ORDER_PARAMS.size() << " bytes, " << ITERATIONS << " iterations\n" << std::endl;
+
+    size_t sink = 0;
+    std::cout << std::left << std::setw(28) << "ns per signed query" << std::right << std::setw(10) << "mean"
+              << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::endl;
+    report("legacy signParams", measure([](int i) {
+        return legacySignParams(ORDER_PARAMS, 1760000000000 + i).size();
+    }, sink));
+    report("RequestSigner::sign", measure([&signer](int i) {
+        return signer.sign(ORDER_PARAMS)[i & 63] == '0' ? 1u : 0u;
+    }, sink));
+    report("RequestSigner::signParams", measure([&signer](int i) {
+        return signer.signParams(ORDER_PARAMS, 1760000000000 + i).size();
+    }, sink));
+
+    std::cout << "\n(checksum " << sink << ")" << std::endl;
+    return 0;
+}
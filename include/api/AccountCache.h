@@ -0,0 +1,107 @@
+#ifndef MASTERMIND_ACCOUNT_CACHE_H
+#define MASTERMIND_ACCOUNT_CACHE_H
+
+#include "core/PreTradeRiskCheck.h"
+#include "core/Types.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MasterMind {
+
+/**
+ * @brief Venue account, asset balance and position state kept from pushes
+ *
+ * Adapters feed it from their user-data streams and from fills; getters
+ * read it without a request. Every record sits behind its own sequence
+ * lock (account, one per asset, one per symbol), so readers on the risk
+ * path never block and always see one consistent update. Writers are
+ * serialized and report whether anything actually changed, so callbacks
+ * fire only on change.
+ *
+ * The currency is fixed before the first update. Assets and symbols are
+ * held in SymbolRegistry slots (CAPACITY each).
+ */
+class AccountCache {
+public:
+    explicit AccountCache(const Currency& currency = "USDT");
+
+    AccountCache(const AccountCache&) = delete;
+    AccountCache& operator=(const AccountCache&) = delete;
+
+    void setCurrency(const Currency& currency);  // Before the first update
+    const Currency& getCurrency() const { return currency_; }
+
+    // Updates; true when the cached state changed
+    bool updateAccount(const AccountInfo& account);
+    // Balance of one asset; the account currency's also sets balance (free + locked), margin (locked).
+    // Ignored when older than the asset's last update, so a slow REST load cannot undo a push.
+    bool updateBalance(const std::string& asset, double free, double locked, TimePoint time);
+    bool updatePosition(const Position& position);
+    bool applyFill(const Symbol& symbol, OrderSide side, Volume quantity, Price price, TimePoint time);
+    void reset();
+
+    // Lock-free snapshots
+    bool isInitialized() const { return version_.load(std::memory_order_acquire) > 0; }
+    uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+    AccountInfo getAccountInfo() const;
+    double getBalance() const { return account_->balance.load(std::memory_order_relaxed); }
+    double getEquity() const { return account_->equity.load(std::memory_order_relaxed); }
+    double getMargin() const { return account_->margin.load(std::memory_order_relaxed); }
+    double getFreeMargin() const { return account_->freeMargin.load(std::memory_order_relaxed); }
+    bool getAssetBalance(const std::string& asset, double& free, double& locked) const;
+    Position getPosition(const Symbol& symbol) const;
+    std::vector<Position> getPositions() const;  // Open positions only
+
+private:
+    struct alignas(64) AccountState {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<double> balance{0};
+        std::atomic<double> equity{0};
+        std::atomic<double> margin{0};
+        std::atomic<double> freeMargin{0};
+        std::atomic<double> marginLevel{0};
+        std::atomic<double> unrealizedPnL{0};
+        std::atomic<double> realizedPnL{0};
+        std::atomic<int64_t> updateMillis{0};
+    };
+
+    struct alignas(64) BalanceState {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<double> free{0};
+        std::atomic<double> locked{0};
+        std::atomic<int64_t> updateMillis{0};
+    };
+
+    struct alignas(64) PositionState {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<double> quantity{0};      // Signed, negative when short
+        std::atomic<double> averagePrice{0};
+        std::atomic<double> currentPrice{0};
+        std::atomic<double> realizedPnL{0};
+        std::atomic<int64_t> openMillis{0};
+        std::atomic<int64_t> updateMillis{0};
+    };
+
+    Currency currency_;
+    std::unique_ptr<AccountState> account_;       // Held apart so the cache itself is not over-aligned
+    SymbolRegistry assets_;
+    std::unique_ptr<BalanceState[]> balances_;    // Indexed by assets_ slot
+    SymbolRegistry symbols_;
+    std::unique_ptr<PositionState[]> positions_;  // Indexed by symbols_ slot
+    std::atomic<uint64_t> version_;
+    std::mutex writeMutex_;
+
+    // Private methods (caller holds writeMutex_)
+    bool writeAccount(double balance, double equity, double margin, double freeMargin, double marginLevel,
+                      double unrealizedPnL, double realizedPnL, TimePoint time);
+    bool writePosition(PositionState& state, double quantity, double averagePrice, double currentPrice,
+                       double realizedPnL, TimePoint time);
+    Position readPosition(const Symbol& symbol, const PositionState& state) const;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_ACCOUNT_CACHE_H
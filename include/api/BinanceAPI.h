@@ -1,19 +1,48 @@
 #ifndef MASTERMIND_BINANCE_API_H
 #define MASTERMIND_BINANCE_API_H
 
+#include "api/BinanceMessages.h"
 #include "api/ExchangeAPI.h"
+#include "api/RateLimiter.h"
+#include "api/RequestSigner.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace MasterMind {
 
+struct HttpResponse;
+
 /**
  * @brief Binance exchange API implementation
  * 
  * Provides integration with Binance spot and futures trading
  * Supports both testnet and live trading environments
+ *
+ * Market data comes from one combined-stream WebSocket (bookTicker, diff
+ * depth and trades per symbol), decoded by BinanceCodec and applied by
+ * WebSocketExchangeAPI: book tickers and trades update a cached tick that
+ * is passed to the tick callback; depth diffs go into the symbol's
+ * OrderBook.
+ *
+ * REST calls are admitted through the rate limiter with Binance endpoint
+ * weights (REQUEST_WEIGHT 1200/min, ORDERS 50/10s by default), resynced
+ * from the X-MBX-USED-WEIGHT-1M and X-MBX-ORDER-COUNT-10S headers, and
+ * paused on 429/418 for Retry-After. Concurrent identical signed queries
+ * such as getAccountInfo() share one request.
+ *
+ * Once authenticated, a second WebSocket carries the user-data stream
+ * (listenKey): balance pushes and execution reports update the account
+ * cache, and fills from the reports build positions, so account and
+ * position getters read the cache without a request. Spot has no venue
+ * positions; they are net fills since the stream opened. The account is
+ * reloaded over REST whenever the stream is (re)opened.
  */
-class BinanceAPI : public RestExchangeAPI {
+class BinanceAPI : public RestExchangeAPI, public WebSocketExchangeAPI {
 public:
     /**
      * @brief Constructor
@@ -30,6 +59,8 @@ public:
     bool disconnect() override;
     bool isConnected() const override;
     bool reconnect() override;
+    bool isSessionLost() const override;   // Also while a once-authenticated session is not
+    bool restoreSession() override;        // Reconnects, then restores authentication and the user stream
     
     // Authentication
     bool authenticate(const std::string& apiKey, 
@@ -37,7 +68,14 @@ public:
                      const std::string& passphrase = "") override;
     bool isAuthenticated() const override;
     
-    // Market data
+    // User-data stream; authenticate() opens it, or connect() when already
+    // authenticated (retried in the background if the first open fails);
+    // disconnect() closes it
+    bool startUserDataStream();
+    void stopUserDataStream();
+    bool isUserDataStreamConnected() const;
+    
+    // Market data (setStreamEndpoint() defaults to wss://stream.binance.com:9443)
     bool subscribeMarketData(const std::vector<Symbol>& symbols) override;
     bool unsubscribeMarketData(const std::vector<Symbol>& symbols) override;
     Tick getLastTick(const Symbol& symbol) const override;
@@ -48,6 +86,16 @@ public:
     
     // Order management
     OrderId placeOrder(const Order& order) override;
+    
+    /**
+     * @brief Send an order without waiting for the exchange
+     * @return Client order id (newClientOrderId): order.orderId, or a
+     *         generated one when that is empty; empty if the order was not sent
+     *
+     * The ack or rejection reaches the order callback later, on the HTTP
+     * reactor thread, with the client order id as orderId.
+     */
+    OrderId placeOrderAsync(const Order& order);
     bool cancelOrder(const OrderId& orderId) override;
     bool modifyOrder(const OrderId& orderId, const Order& newOrder) override;
     Order getOrder(const OrderId& orderId) const override;
@@ -105,10 +153,70 @@ protected:
                                         const std::string& params = "") const;
     std::string buildAuthHeader() const override;
     std::string signRequest(const std::string& request) const override;
+    // Appends timestamp and signature; per-thread buffer, valid until the next call on this thread
+    const std::string& signParams(const std::string& params) const;
+    
+    // WebSocket event handlers
+    void onWebSocketConnect() override;
+    void onWebSocketDisconnect() override;
+    void onWebSocketError(const std::string& error) override;
+    // Depth snapshots count against the REST weight budget like any query
+    void fetchBookSnapshot(const std::string& path, const std::string& query,
+                           std::function<void(const HttpResponse&)> done) override;
     
     // Utility methods
+    std::string buildOrderParams(const Order& order, const OrderId& clientOrderId) const;
+    void rejectOrder(const Order& order, const OrderId& clientOrderId, const std::string& reason);
+    void applyRateLimitFeedback(const HttpResponse& response) const;
+    static RequestPriority requestPriority(const std::string& method, const std::string& path);
+    static uint32_t requestWeight(const std::string& method, const std::string& path, const std::string& query);
     std::string getOrderTypeString(OrderType type) const;
     std::string generateOrderId() const;
+    OrderId clientOrderIdFor(const Order& order) const;  // The caller's id when Binance accepts it
+
+private:
+    // Orders are known by the caller's order id, sent as the client order
+    // id (one is generated only when the caller has none). A
+    // cancel-replace gives the venue a new id for the same order; reports
+    // under it are mapped back, so callers never see it.
+    struct TrackedOrder {
+        Symbol symbol;
+        std::string venueId;  // Client order id of the live leg
+    };
+    
+
+    RequestSigner signer_;  // Keyed from apiSecret_ by authenticate()
+    
+    // User-data stream; a keep-alive timer on the maintenance wheel renews the listenKey and reopens
+    // a dropped stream
+    std::unique_ptr<WebSocketClient> userStream_;
+    std::string listenKey_;
+    mutable std::mutex userStreamMutex_;
+    std::mutex keepAliveMutex_;  // Never held across I/O: stream handlers take it
+    TimerId keepAliveTimer_;
+    bool keepAliveRunning_;
+    bool keepAliveBusy_;         // A renewal or reopen is in progress
+    std::condition_variable keepAliveDone_;
+    bool userStreamStale_;       // Dropped or key expired
+    std::atomic<bool> authenticationWanted_;  // Authenticated once; restoreSession() does it again
+    BinanceUserEvent userEventScratch_;  // User stream reactor thread only
+    
+    std::unordered_map<OrderId, TrackedOrder> trackedOrders_;
+    std::unordered_map<std::string, OrderId> replacementIds_;  // Venue id -> order id, legs from cancel-replace
+    mutable std::mutex trackedOrdersMutex_;
+    
+    bool fetchAccount(BinanceAccount& account) const;
+    bool loadAccount();
+    bool openUserStream();
+    bool renewListenKey();
+    void markUserStreamStale();
+    void scheduleKeepAlive(Duration delay);  // Caller holds keepAliveMutex_
+    void runKeepAlive();
+    void onUserDataMessage(const char* data, size_t length);
+    void trackOrder(const OrderId& orderId, const Symbol& symbol);
+    void untrackOrder(const OrderId& orderId);
+    bool findTrackedOrder(const OrderId& orderId, TrackedOrder& order) const;
+    void resolveReport(const std::string& venueId, Order& order, bool& currentLeg);  // Maps the report to its order
 };
 
 } // namespace MasterMind
@@ -0,0 +1,138 @@
+#ifndef MASTERMIND_BINANCE_MESSAGES_H
+#define MASTERMIND_BINANCE_MESSAGES_H
+
+#include "api/OrderBook.h"
+#include "core/Types.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MasterMind {
+
+// Diff-depth stream event, or a REST depth snapshot (finalUpdateId = lastUpdateId)
+struct BinanceDepthUpdate {
+    Symbol symbol;
+    uint64_t firstUpdateId;
+    uint64_t finalUpdateId;
+    uint64_t previousUpdateId;  // Futures streams only ("pu"), 0 otherwise
+    TimePoint eventTime;
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+
+    BinanceDepthUpdate() : firstUpdateId(0), finalUpdateId(0), previousUpdateId(0) {}
+};
+
+// Trade or aggregate trade stream event
+struct BinanceTrade {
+    Symbol symbol;
+    uint64_t tradeId;
+    Price price;
+    Volume quantity;
+    TimePoint tradeTime;
+    bool buyerIsMaker;
+
+    BinanceTrade() : tradeId(0), price(0), quantity(0), buyerIsMaker(false) {}
+};
+
+// Response to order placement, query or cancel
+struct BinanceOrderAck {
+    Order order;
+    std::string clientOrderId;
+    Volume cumulativeQuoteQuantity;
+
+    BinanceOrderAck() : cumulativeQuoteQuantity(0) {}
+};
+
+struct BinanceBalance {
+    std::string asset;
+    double free;
+    double locked;
+
+    BinanceBalance() : free(0), locked(0) {}
+};
+
+struct BinanceAccount {
+    bool canTrade;
+    int makerCommission;  // Basis points
+    int takerCommission;
+    TimePoint updateTime;
+    std::vector<BinanceBalance> balances;
+
+    BinanceAccount() : canTrade(false), makerCommission(0), takerCommission(0) {}
+};
+
+// User-data stream event (wss://.../ws/<listenKey>)
+struct BinanceUserEvent {
+    enum class Kind {
+        UNKNOWN,
+        ACCOUNT_POSITION,   // outboundAccountPosition: free/locked of every asset that changed
+        BALANCE_UPDATE,     // balanceUpdate: deposit, withdrawal or transfer of one asset
+        EXECUTION_REPORT,   // executionReport: order state change, with the fill if any
+        LISTEN_KEY_EXPIRED  // listenKeyExpired: the stream is closing, a new key is needed
+    };
+
+    Kind kind;
+    TimePoint eventTime;
+    std::vector<BinanceBalance> balances;  // ACCOUNT_POSITION
+    std::string asset;                     // BALANCE_UPDATE
+    double balanceDelta;
+    Order order;                           // EXECUTION_REPORT; orderId is the exchange id
+    std::string clientOrderId;
+    std::string originalClientOrderId;     // Of the cancelled order, on cancels only
+    std::string executionType;             // NEW, TRADE, CANCELED, EXPIRED, ...
+    Volume lastQuantity;                   // Of this fill, 0 unless executionType is TRADE
+    Price lastPrice;
+
+    BinanceUserEvent() : kind(Kind::UNKNOWN), balanceDelta(0), lastQuantity(0), lastPrice(0) {}
+};
+
+/**
+ * @brief Decoders for Binance REST and WebSocket payloads
+ *
+ * Each parser walks the message once with JsonReader, picks out the fields
+ * it needs and skips the rest. Output structs are filled in place, so a
+ * caller that keeps one per stream reuses its vectors and strings and
+ * steady-state decoding does not allocate. Numeric strings go straight
+ * from the payload to double.
+ *
+ * All parsers return false on malformed input or when the message lacks
+ * its identifying fields; the output is then unspecified.
+ */
+class BinanceMessageParser {
+public:
+    // 24hr ticker and book ticker, REST or stream form
+    static bool parseTicker(const char* data, size_t length, Tick& tick);
+    static bool parseDepthUpdate(const char* data, size_t length, BinanceDepthUpdate& update);
+    static bool parseTrade(const char* data, size_t length, BinanceTrade& trade);
+    static bool parseOrderAck(const char* data, size_t length, BinanceOrderAck& ack);
+    static bool parseAccount(const char* data, size_t length, BinanceAccount& account);
+
+    // POST /api/v3/userDataStream response ({"listenKey":"..."})
+    static bool parseListenKey(const char* data, size_t length, std::string& listenKey);
+    // false only on malformed input; events this does not decode come back as UNKNOWN
+    static bool parseUserEvent(const char* data, size_t length, BinanceUserEvent& event);
+
+    // exchangeInfo symbols with PRICE_FILTER and LOT_SIZE applied; non-TRADING ones are inactive
+    static bool parseExchangeInfo(const char* data, size_t length, std::vector<InstrumentSpec>& instruments);
+
+    /**
+     * @brief Decode an error response ({"code":-1013,"msg":"..."})
+     * @return true if the payload is an error
+     */
+    static bool parseError(const char* data, size_t length, int& code, std::string& message);
+
+    /**
+     * @brief Split a combined-stream message ({"stream":"btcusdt@trade","data":{...}})
+     * @return false unless both fields are present; both views point into data
+     */
+    static bool parseStreamEnvelope(const char* data, size_t length, std::string_view& stream,
+                                    std::string_view& payload);
+
+    static OrderStatus toOrderStatus(std::string_view status);
+    static OrderType toOrderType(std::string_view type);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_BINANCE_MESSAGES_H
@@ -0,0 +1,134 @@
+#ifndef MASTERMIND_BOOK_SYNCHRONIZER_H
+#define MASTERMIND_BOOK_SYNCHRONIZER_H
+
+#include "api/VenueCodec.h"
+#include "core/Types.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace MasterMind {
+
+struct BookSyncStats {
+    uint64_t gaps;               // Sequence breaks detected on a synced book
+    uint64_t initialSyncs;       // Books first built from a fetched snapshot
+    uint64_t recoveries;         // Gaps repaired: snapshot applied, held updates replayed
+    uint64_t snapshotRetries;    // Snapshot failed or predates the held updates; fetched again
+    uint64_t stale;              // Updates dropped as already covered by the book
+    uint64_t held;               // Updates buffered while a snapshot was awaited
+    uint64_t overflows;          // Oldest held updates discarded at the buffer limit
+    size_t recovering;           // Books waiting for a snapshot now
+    double lastRecoveryMicros;   // Gap detected to book consistent again
+    double maxRecoveryMicros;
+    double totalRecoveryMicros;  // Over recoveries
+
+    BookSyncStats() : gaps(0), initialSyncs(0), recoveries(0), snapshotRetries(0), stale(0), held(0), overflows(0),
+                      recovering(0), lastRecoveryMicros(0), maxRecoveryMicros(0), totalRecoveryMicros(0) {}
+};
+
+/**
+ * @brief Sequence tracking and snapshot resync for streamed order books
+ *
+ * Every sequenced book update (VenueEvent BOOK_UPDATE with a sequence) is
+ * checked against the last one applied for its symbol. An update follows
+ * when its previousSequence equals the last sequence, or - for venues
+ * without one - when its firstSequence is the next id. Anything else is a
+ * gap: the symbol's updates are held from then on and the caller fetches
+ * a snapshot. When it arrives, held updates it already covers are
+ * dropped, the first one kept must straddle it (firstSequence <= snapshot
+ * + 1 <= sequence, Binance's lastUpdateId rule) and the rest must chain;
+ * then the snapshot and the held updates are applied in order. A snapshot
+ * that is older than the held updates is fetched again. A book with no
+ * snapshot yet starts the same way, so diff-only streams get their first
+ * book from REST.
+ *
+ * Only the symbol in recovery waits; every other symbol's updates keep
+ * being applied. Each recovery has a generation, bumped by reset() and
+ * clear(), so a snapshot answering an abandoned fetch is ignored.
+ * After a failover or reconnect, onStreamSwitch() lets each book continue
+ * from the new connection's first update when it overlaps the book, as
+ * after a snapshot; one that does not is a gap like any other.
+ *
+ * Not thread-safe except getStats(): call it from the thread that
+ * decodes the stream (its reactor).
+ */
+class BookSynchronizer {
+public:
+    using Apply = std::function<void(const VenueEvent&)>;
+    using SteadyTime = std::chrono::steady_clock::time_point;
+
+    enum class Action {
+        APPLY,  // In sequence, or not sequenced: apply it
+        HOLD,   // Held for replay, or stale: nothing to apply now
+        FETCH   // Held; a snapshot is needed for the returned generation
+    };
+
+    /**
+     * @param recoverable false when the venue offers no snapshot: gaps are
+     *        counted and the book carries on from the update that broke it
+     * @param maxHeld Held updates per symbol before the oldest are dropped
+     */
+    explicit BookSynchronizer(bool recoverable = true, size_t maxHeld = 4096);
+
+    BookSynchronizer(const BookSynchronizer&) = delete;
+    BookSynchronizer& operator=(const BookSynchronizer&) = delete;
+
+    Action onUpdate(const VenueEvent& update, uint64_t& generation);
+    // Snapshot carried by the stream itself: the book is in sequence from it on
+    void onStreamSnapshot(const VenueEvent& snapshot);
+    /**
+     * @brief Snapshot fetched for generation
+     * @return true if the book is consistent again; apply has been called with
+     *         the snapshot and then each held update. false if the fetch was
+     *         abandoned or must be repeated (see isRecovering()).
+     */
+    bool onSnapshot(const VenueEvent& snapshot, uint64_t generation, const Apply& apply);
+    // Snapshot fetch failed; the caller repeats it after the returned delay
+    Duration onSnapshotFailed(const Symbol& symbol, uint64_t generation);
+    Duration getRetryDelay(const Symbol& symbol) const;
+
+    bool isRecovering(const Symbol& symbol, uint64_t generation) const;
+    bool isSynced(const Symbol& symbol) const;
+    void reset(const Symbol& symbol);  // Next update starts a fresh sync
+    // Updates now come from another connection: each synced book accepts a
+    // first update that overlaps it; books in recovery start over
+    void onStreamSwitch();
+    void clear();
+
+    BookSyncStats getStats() const;
+
+private:
+    struct Stream {
+        bool synced = false;
+        bool bridging = false;     // Next update is the first after a snapshot
+        bool recovering = false;
+        bool initial = true;       // Recovering a book that never had a snapshot
+        uint64_t last = 0;
+        uint64_t generation = 0;
+        unsigned attempts = 0;
+        SteadyTime detected;
+        std::deque<VenueEvent> held;
+    };
+
+    bool recoverable_;
+    size_t maxHeld_;
+    std::unordered_map<Symbol, Stream> streams_;
+    uint64_t nextGeneration_;
+
+    mutable std::mutex statsMutex_;
+    BookSyncStats stats_;
+
+    // Private methods
+    static bool follows(uint64_t last, bool bridging, const VenueEvent& update);
+    void hold(Stream& stream, const VenueEvent& update);
+    void beginRecovery(Stream& stream, bool gap);
+    void endRecovery(Stream& stream, uint64_t last);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_BOOK_SYNCHRONIZER_H
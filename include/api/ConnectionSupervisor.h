@@ -0,0 +1,138 @@
+#ifndef MASTERMIND_CONNECTION_SUPERVISOR_H
+#define MASTERMIND_CONNECTION_SUPERVISOR_H
+
+#include "core/Types.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace MasterMind {
+
+class ExchangeAPI;
+class WebSocketExchangeAPI;
+
+struct SupervisorConfig {
+    Duration heartbeatInterval;  // Ping a stream silent this long; drop it after twice as long
+    Duration initialBackoff;     // Wait after the first failed reconnect; doubles per failure
+    Duration maxBackoff;
+    double jitter;               // Each wait is scaled by a random factor in [1 - jitter, 1 + jitter]
+    Duration giveUpAfter;        // Outage reported as given up (0 never); retries go on at maxBackoff
+    bool hotStandby;             // Keep a second subscribed stream connection per venue
+
+    SupervisorConfig()
+        : heartbeatInterval(std::chrono::seconds(30)), initialBackoff(std::chrono::milliseconds(100)),
+          maxBackoff(std::chrono::seconds(60)), jitter(0.2), giveUpAfter(0), hotStandby(false) {}
+};
+
+struct SupervisorStats {
+    uint64_t sessionReconnects;  // Venues connected again after reporting disconnected
+    uint64_t streamRestores;     // Lost streams reopened (no standby to fail over to)
+    uint64_t failedAttempts;
+    uint64_t failovers;          // Streams switched to their standby, over current venues
+    uint64_t standbysOpened;
+    uint64_t givenUp;            // Outages that outlasted giveUpAfter
+    size_t venues;
+    size_t down;                 // Venues with the session or stream down now
+    double lastDowntimeMicros;   // Loss noticed to session or stream back
+    double maxDowntimeMicros;
+
+    SupervisorStats() : sessionReconnects(0), streamRestores(0), failedAttempts(0), failovers(0), standbysOpened(0),
+                        givenUp(0), venues(0), down(0), lastDowntimeMicros(0), maxDowntimeMicros(0) {}
+};
+
+/**
+ * @brief Keeps venue sessions and market data streams up
+ *
+ * One thread watches every venue added. A venue whose session is lost
+ * (ExchangeAPI::isSessionLost) has it restored, authenticated state
+ * included; one disconnected on purpose is left alone until connect()
+ * asks for the session again. A WebSocketExchangeAPI whose stream is
+ * lost has it reopened with every subscribed symbol, and a live stream is
+ * heartbeat-checked each half heartbeatInterval (pinged when quiet,
+ * dropped when silent). The first attempt follows the loss at once - a
+ * stream reports it from the reactor, waking the thread - and failures are
+ * retried after a jittered exponential backoff, so venues lost together
+ * do not all come back in the same instant. Retries never stop: the wait
+ * settles at maxBackoff, and an outage longer than giveUpAfter is only
+ * reported (givenUp) until the venue is back.
+ *
+ * With hotStandby, each stream also keeps a second connection subscribed
+ * to the same symbols. The venue switches to it on the reactor the moment
+ * the active connection drops, and the supervisor then opens a new
+ * standby; data stops only for the switch itself.
+ *
+ * Reconnects block (REST handshakes, WebSocket upgrades), which is why
+ * they run here and never on a reactor or a caller's thread. Venues are
+ * not owned: remove one before destroying it. removeVenue() and stop()
+ * wait for a check of that venue in progress.
+ */
+class ConnectionSupervisor {
+public:
+    explicit ConnectionSupervisor(const SupervisorConfig& config = SupervisorConfig());
+    ~ConnectionSupervisor();
+
+    ConnectionSupervisor(const ConnectionSupervisor&) = delete;
+    ConnectionSupervisor& operator=(const ConnectionSupervisor&) = delete;
+
+    void setConfig(const SupervisorConfig& config);
+    SupervisorConfig getConfig() const;
+
+    bool start();
+    void stop();
+    bool isRunning() const;
+
+    void addVenue(ExchangeAPI* venue);
+    void removeVenue(ExchangeAPI* venue);
+
+    SupervisorStats getStats() const;
+
+private:
+    using SteadyTime = std::chrono::steady_clock::time_point;
+
+    // Loop thread only, apart from removed (mutex_)
+    struct Venue {
+        ExchangeAPI* api = nullptr;
+        WebSocketExchangeAPI* stream = nullptr;  // Null for REST-only venues
+        bool removed = false;
+        bool down = false;
+        bool gaveUp = false;                     // Down past giveUpAfter, still retried
+        unsigned attempts = 0;                   // Failed reconnects since it went down
+        unsigned standbyAttempts = 0;
+        SteadyTime downSince;
+        SteadyTime nextAttempt;
+        SteadyTime nextStandby;
+        SteadyTime nextHeartbeat;
+    };
+
+    SupervisorConfig config_;
+    std::vector<std::shared_ptr<Venue>> venues_;
+    Venue* checking_;                // In a check outside the lock
+    bool running_;
+    bool woken_;
+    mutable std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable checked_;
+    std::thread thread_;
+    std::mt19937 jitterGenerator_;  // Loop thread only
+    SupervisorStats stats_;
+
+    // Private methods
+    void supervisorLoop();
+    void wake();
+    SteadyTime check(Venue& venue, const SupervisorConfig& config);
+    SteadyTime checkStandby(Venue& venue, const SupervisorConfig& config, SteadyTime now);
+    void markDown(Venue& venue, SteadyTime now, const char* what);
+    void markUp(Venue& venue);
+    void release(Venue& venue);
+    void recordFailure(Venue& venue, const SupervisorConfig& config, SteadyTime now);
+    Duration getBackoff(const SupervisorConfig& config, unsigned attempts);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_CONNECTION_SUPERVISOR_H
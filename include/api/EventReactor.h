@@ -0,0 +1,157 @@
+#ifndef MASTERMIND_EVENT_REACTOR_H
+#define MASTERMIND_EVENT_REACTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace MasterMind {
+
+struct EventReactorStats {
+    uint64_t wakeups;         // epoll_wait returns
+    uint64_t events;          // Socket events dispatched
+    uint64_t tasks;           // Posted tasks run
+    uint64_t timers;          // Timers fired
+    size_t sources;           // Registered now
+    double maxHandlerMicros;  // Slowest event, task or timer
+
+    EventReactorStats() : wakeups(0), events(0), tasks(0), timers(0), sources(0), maxHandlerMicros(0) {}
+};
+
+/**
+ * @brief One epoll loop thread shared by many sockets
+ *
+ * Sources register a file descriptor with a handler that runs on the
+ * reactor thread for every readiness event. Work from other threads is
+ * handed over with post() (an eventfd wakes the loop) and deadlines with
+ * runAt(). Handlers, tasks and timers all run on the one thread, in that
+ * order per loop pass, so state touched only from them needs no lock.
+ *
+ * add() and modify() may be called from any thread. remove() stops
+ * further events at once but must run on the reactor thread (or through
+ * runSync()) when the handler's owner is about to be destroyed, so the
+ * handler is not running at the same time. Linux only; elsewhere start()
+ * fails and nothing is dispatched.
+ */
+class EventReactor {
+public:
+    using Handler = std::function<void(uint32_t events)>;  // EPOLLIN, EPOLLOUT, EPOLLERR, ...
+    using Task = std::function<void()>;
+    using SteadyTime = std::chrono::steady_clock::time_point;
+    using TimerId = uint64_t;
+
+    explicit EventReactor(const std::string& name = "reactor");
+    ~EventReactor();
+
+    EventReactor(const EventReactor&) = delete;
+    EventReactor& operator=(const EventReactor&) = delete;
+
+    bool start(int cpu = -1);  // cpu >= 0 pins the loop thread
+    void stop();               // Runs queued tasks, then joins
+    bool isRunning() const { return running_; }
+    bool inReactorThread() const { return std::this_thread::get_id() == threadId_.load(std::memory_order_relaxed); }
+
+    bool add(int fd, uint32_t events, Handler handler);
+    bool modify(int fd, uint32_t events);
+    void remove(int fd);
+
+    void post(Task task);
+    void runSync(const Task& task);  // Inline on the reactor thread, else waits for the loop to run it
+    TimerId runAt(SteadyTime when, Task task);
+    void cancelTimer(TimerId id);
+
+    const std::string& getName() const { return name_; }
+    size_t getSourceCount() const { return sourceCount_.load(std::memory_order_relaxed); }
+    EventReactorStats getStats() const;
+
+private:
+    struct Source {
+        int fd;
+        Handler handler;
+        std::atomic<bool> active{true};
+    };
+
+    std::string name_;
+    int epoll_;
+    int wake_;
+    std::thread thread_;
+    std::atomic<std::thread::id> threadId_;
+    std::atomic<bool> running_;
+
+    // Registration; removed sources are kept until the current batch is dispatched
+    std::mutex sourcesMutex_;
+    std::unordered_map<int, std::shared_ptr<Source>> sources_;
+    std::vector<std::shared_ptr<Source>> retired_;
+    std::atomic<size_t> sourceCount_;
+
+    std::mutex tasksMutex_;
+    std::vector<Task> tasks_;
+    std::atomic<bool> wakePending_;
+
+    // Timers (reactor thread, plus runAt/cancelTimer under timersMutex_)
+    std::mutex timersMutex_;
+    std::map<std::pair<SteadyTime, TimerId>, Task> timers_;
+    std::unordered_map<TimerId, SteadyTime> timerDeadlines_;
+    TimerId nextTimerId_;
+
+    // Statistics (written by the reactor thread)
+    std::atomic<uint64_t> wakeups_;
+    std::atomic<uint64_t> events_;
+    std::atomic<uint64_t> tasksRun_;
+    std::atomic<uint64_t> timersFired_;
+    std::atomic<double> maxHandlerMicros_;
+
+    void loop();
+    void wake();
+    void runTasks();
+    void runTimers(SteadyTime now);
+    int nextTimeoutMillis(SteadyTime now);
+    void recordHandler(SteadyTime start);
+};
+
+struct ReactorPoolConfig {
+    size_t threads;         // Reactor threads shared by every venue
+    std::vector<int> cpus;  // Pin reactor i to cpus[i % size]; empty leaves scheduling to the OS
+
+    ReactorPoolConfig() : threads(1) {}
+};
+
+/**
+ * @brief Fixed set of reactors that every venue connection shares
+ *
+ * Connections are spread over the reactors by current source count, so
+ * adding a venue adds sockets, not threads. The process-wide pool is built
+ * on first use of shared(); configureShared() before that sets its size
+ * and CPU placement, keeping I/O off the cores reserved for strategies.
+ */
+class ReactorPool {
+public:
+    explicit ReactorPool(const ReactorPoolConfig& config = ReactorPoolConfig());
+    ~ReactorPool();
+
+    ReactorPool(const ReactorPool&) = delete;
+    ReactorPool& operator=(const ReactorPool&) = delete;
+
+    static ReactorPool& shared();
+    static bool configureShared(const ReactorPoolConfig& config);  // false once shared() was used
+
+    EventReactor& next();  // Least loaded
+    EventReactor& at(size_t index) { return *reactors_[index]; }
+    size_t size() const { return reactors_.size(); }
+
+private:
+    std::vector<std::unique_ptr<EventReactor>> reactors_;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_EVENT_REACTOR_H
@@ -8,6 +8,9 @@
 #include <atomic>
 #include <string>
 #include "core/Types.h"
+#include "api/AccountCache.h"
+#include "api/InstrumentRegistry.h"
+#include "api/OrderBook.h"
 
 namespace MasterMind {
 
@@ -36,6 +39,11 @@ public:
     virtual bool isConnected() const = 0;
     virtual bool reconnect() = 0;
     
+    // Session supervision: connect() asks for the session, disconnect() releases it
+    bool isSessionWanted() const { return sessionWanted_; }
+    virtual bool isSessionLost() const { return sessionWanted_ && !isConnected(); }
+    virtual bool restoreSession() { return connect(); }  // Adapters also restore authenticated state
+    
     // Authentication
     virtual bool authenticate(const std::string& apiKey, 
                             const std::string& apiSecret,
@@ -77,16 +85,29 @@ public:
     virtual InstrumentSpec getInstrumentSpec(const Symbol& symbol) const = 0;
     virtual bool isSymbolAvailable(const Symbol& symbol) const = 0;
     
+    // Lock-free instrument lookups; resolve a symbol once, then index by id
+    const InstrumentRegistry& getInstrumentRegistry() const { return instrumentRegistry_; }
+    SymbolId getSymbolId(const Symbol& symbol) const { return instrumentRegistry_.getId(symbol); }
+    const InstrumentSpec* findInstrument(SymbolId id) const { return instrumentRegistry_.find(id); }  // Read at once, never keep
+    
+    // Lock-free account and position snapshot, kept from the venue's pushes
+    const AccountCache& getAccountCache() const { return accountCache_; }
+    
     // Exchange-specific information
     Exchange getExchangeType() const { return exchangeType_; }
     virtual std::string getExchangeName() const = 0;
     virtual std::vector<AssetClass> getSupportedAssetClasses() const = 0;
     
+    // Depth of book (nullptr until the adapter has published the symbol)
+    std::shared_ptr<const OrderBook> getOrderBook(const Symbol& symbol) const;
+    
     // Callbacks for real-time updates
     void setTickCallback(TickCallback callback) { tickCallback_ = callback; }
     void setOrderCallback(OrderCallback callback) { orderCallback_ = callback; }
+    void setFillCallback(FillCallback callback) { fillCallback_ = callback; }
     void setPositionCallback(std::function<void(const Position&)> callback) { positionCallback_ = callback; }
     void setAccountCallback(std::function<void(const AccountInfo&)> callback) { accountCallback_ = callback; }
+    void setOrderBookCallback(std::function<void(const Symbol&)> callback) { orderBookCallback_ = callback; }
     
     // Trading session information
     virtual bool isTradingSessionOpen() const = 0;
@@ -107,14 +128,28 @@ protected:
     // Callbacks
     TickCallback tickCallback_;
     OrderCallback orderCallback_;
+    FillCallback fillCallback_;
     std::function<void(const Position&)> positionCallback_;
     std::function<void(const AccountInfo&)> accountCallback_;
+    std::function<void(const Symbol&)> orderBookCallback_;
     
     // Helper methods for derived classes
     void notifyTick(const Tick& tick);
     void notifyOrderUpdate(const Order& order);
+    void notifyFill(const OrderId& orderId, Volume quantity, Price price);
     void notifyPositionUpdate(const Position& position);
     void notifyAccountUpdate(const AccountInfo& account);
+    void notifyOrderBookUpdate(const Symbol& symbol);
+    
+    // Update accountCache_, notifying only on change
+    void publishAccount(const AccountInfo& account);
+    void publishBalance(const std::string& asset, double free, double locked, TimePoint time);
+    void publishPosition(const Position& position);
+    void publishFill(const OrderId& orderId, const Symbol& symbol, OrderSide side, Volume quantity, Price price,
+                     TimePoint time);
+    
+    // Order book feed for adapters
+    OrderBook& getOrCreateOrderBook(const Symbol& symbol);
     
     // Validation helpers
     virtual bool validateSymbol(const Symbol& symbol) const = 0;
@@ -124,36 +159,187 @@ protected:
     mutable std::mutex connectionMutex_;
     std::atomic<bool> connected_;
     std::atomic<bool> authenticated_;
-    std::string lastError_;
+    std::atomic<bool> sessionWanted_;
+    
+    // Last error; set from caller, reactor and background threads alike, so
+    // written only through setError() and read as a copy under errorMutex_
+    void setError(const std::string& error) const;
+    mutable std::mutex errorMutex_;
+    mutable std::string lastError_;
+    
+    // Venue instruments, published by the adapter
+    InstrumentRegistry instrumentRegistry_;
+    
+    // Account state, published by the adapter
+    AccountCache accountCache_;
+    
+    // Per-symbol depth of book
+    std::unordered_map<Symbol, std::shared_ptr<OrderBook>> orderBooks_;
+    mutable std::mutex orderBooksMutex_;
 };
 
+class WebSocketClient;
+class HttpClient;
+class VenueCodec;
+class BookSynchronizer;
+struct VenueEvent;
+struct BookSyncStats;
+struct HttpResponse;
+
 /**
  * @brief WebSocket-based exchange API for real-time data
+ *
+ * connectWebSocket() opens wsUrl_ on an owned WebSocketClient and routes
+ * its events to the onWebSocket* handlers. The client runs on a reactor
+ * from ReactorPool::shared(), so the handlers share one thread with every
+ * other venue socket and must not block. A message is a view into the
+ * receive buffer, valid only for the duration of the call. Derived
+ * classes must call disconnectWebSocket() in their destructor, while the
+ * handlers can still be dispatched.
+ *
+ * An adapter that sets a VenueCodec gets the market data path as well:
+ * subscribeStreams() opens or extends the stream, and the default
+ * onWebSocketMessage() decodes each message and applies its events with
+ * applyVenueEvent() - ticks and trades to the cached last tick, book
+ * snapshots and updates to the symbol's OrderBook - before the tick and
+ * order book callbacks and the normalized venue event callback run.
+ * Sequenced book updates pass through a BookSynchronizer first: a book
+ * with a gap (or no snapshot yet) holds its updates while the codec's
+ * REST snapshot is fetched without blocking the reactor, then replays
+ * them onto it. Other symbols keep streaming meanwhile.
+ *
+ * The stream has two client slots on the same reactor. Normally only
+ * wsClient_ is open; a supervisor (ConnectionSupervisor) may keep the
+ * other one connected and subscribed as a hot standby with
+ * ensureStandby(). Its messages are dropped unread until the active
+ * connection is lost, when the lost handler switches to it on the spot
+ * instead of reporting the stream down; the books then continue from the
+ * standby's updates, or resync where it was ahead. A lost stream with no
+ * standby is reported through the stream state callback so the supervisor
+ * can restoreStream() off the reactor.
  */
-class WebSocketExchangeAPI : public ExchangeAPI {
+class WebSocketExchangeAPI : public virtual ExchangeAPI {
 public:
+    using VenueEventCallback = std::function<void(const VenueEvent&)>;
+    
     explicit WebSocketExchangeAPI(Exchange exchangeType);
     virtual ~WebSocketExchangeAPI();
     
     // WebSocket specific methods
-    virtual bool connectWebSocket() = 0;
-    virtual bool disconnectWebSocket() = 0;
-    virtual bool isWebSocketConnected() const = 0;
+    virtual bool connectWebSocket();
+    virtual bool disconnectWebSocket();
+    virtual bool isWebSocketConnected() const;
+    
+    // Market data stream origin; defaults to the codec's production endpoint
+    void setStreamEndpoint(const std::string& url);
+    std::string getStreamEndpoint() const;
+    // Every decoded event, on the reactor thread; set before subscribing
+    void setVenueEventCallback(VenueEventCallback callback) { venueEventCallback_ = std::move(callback); }
+    // Origin of book snapshots fetched after a gap; defaults to the codec's. Set before subscribing
+    void setSnapshotEndpoint(const std::string& url) { snapshotEndpoint_ = url; }
+    
+    // Gap and recovery counts over all symbols
+    BookSyncStats getBookSyncStats() const;
+    
+    enum class StreamState {
+        IDLE,  // Nothing subscribed, or closed on purpose
+        UP,
+        DOWN   // Subscribed, but the connection was lost
+    };
+    
+    // Supervision; these block on connects, so never call them from the reactor
+    StreamState getStreamState() const;
+    void checkStreamHeartbeat(Duration interval);  // Ping after interval of silence, drop after twice it
+    bool restoreStream();                          // Reopen with every subscribed symbol
+    bool ensureStandby();                          // Open the other slot on the same stream
+    void dropStandby();
+    bool hasStandby() const;
+    uint64_t getFailoverCount() const { return failovers_; }
+    // Runs when a subscription opens the stream (caller's thread) and when the
+    // wanted stream or its standby is lost (reactor); must not block
+    void setStreamStateCallback(std::function<void()> callback);
     
 protected:
     // WebSocket event handlers
-    virtual void onWebSocketMessage(const std::string& message) = 0;
+    virtual void onWebSocketMessage(const char* data, size_t length);  // Decodes through codec_
     virtual void onWebSocketConnect() = 0;
     virtual void onWebSocketDisconnect() = 0;
     virtual void onWebSocketError(const std::string& error) = 0;
     
+    bool sendWebSocketMessage(const std::string& message);
+    
+    // Codec-driven market data
+    void setCodec(std::unique_ptr<VenueCodec> codec);  // From the constructor
+    bool subscribeStreams(const std::vector<Symbol>& symbols);
+    bool unsubscribeStreams(const std::vector<Symbol>& symbols);
+    bool getStreamTick(const Symbol& symbol, Tick& tick) const;
+    void applyVenueEvent(const VenueEvent& event);
+    
+    // GET a book snapshot from the venue; done may run on any thread.
+    // Adapters with a REST budget override this to admit it first.
+    virtual void fetchBookSnapshot(const std::string& path, const std::string& query,
+                                   std::function<void(const HttpResponse&)> done);
+    
+    std::unique_ptr<WebSocketClient> wsClient_;
+    std::string wsUrl_;
     std::atomic<bool> wsConnected_;
+    
+    std::unique_ptr<VenueCodec> codec_;
+    std::string streamEndpoint_;
+    std::vector<Symbol> streamSymbols_;
+    uint64_t streamRequestId_;
+    mutable std::mutex streamMutex_;
+    
+    // Latest streamed tick per symbol
+    std::unordered_map<Symbol, Tick> streamTicks_;
+    mutable std::mutex streamTicksMutex_;
+    
+private:
+    std::function<void(const VenueEvent&)> eventSink_;  // Bound to onVenueEvent once
+    VenueEventCallback venueEventCallback_;
+    
+    // Book resync (reactor thread)
+    std::unique_ptr<BookSynchronizer> bookSync_;
+    std::unordered_map<Symbol, uint64_t> snapshotRetryTimers_;
+    std::unique_ptr<VenueEvent> snapshotEvent_;
+    std::unique_ptr<HttpClient> snapshotClient_;  // Default fetchBookSnapshot()
+    std::string snapshotEndpoint_;
+    
+    // Failover
+    std::unique_ptr<WebSocketClient> standbyClient_;  // Second slot; trades roles with wsClient_
+    std::atomic<WebSocketClient*> activeClient_;      // Slot whose messages are applied
+    std::atomic<bool> streamWanted_;                  // Opened by a subscription, not closed on purpose
+    std::atomic<uint64_t> failovers_;
+    std::function<void()> streamStateCallback_;
+    std::mutex streamStateMutex_;
+    
+    // Private methods
+    void bindStreamClient(WebSocketClient* client);
+    WebSocketClient* peerOf(WebSocketClient* client) const;
+    void onStreamLost(WebSocketClient* client);
+    void notifyStreamState();
+    void sendToStandby(const std::string& message);
+    std::string getStreamName() const;
+    void onVenueEvent(const VenueEvent& event);
+    void requestBookSnapshot(const Symbol& symbol, uint64_t generation);
+    void onBookSnapshot(const Symbol& symbol, uint64_t generation, const HttpResponse& response);
+    void stopBookRecovery();
 };
 
+class RateLimiter;
+class RequestCoalescer;
+struct RateLimitConfig;
+struct RateLimiterStats;
+
 /**
  * @brief REST-based exchange API for standard operations
+ *
+ * Requests go through one pooled keep-alive HttpClient for baseUrl_,
+ * created on first use with the auth header applied. Adapters admit each
+ * request through the venue's RateLimiter first and may coalesce identical
+ * concurrent queries into one.
  */
-class RestExchangeAPI : public ExchangeAPI {
+class RestExchangeAPI : public virtual ExchangeAPI {
 public:
     explicit RestExchangeAPI(Exchange exchangeType);
     virtual ~RestExchangeAPI();
@@ -163,15 +349,44 @@ public:
                                   const std::string& method,
                                   const std::string& params = "") const = 0;
     
+    // Point REST calls at another origin (testnet, local stub); drops pooled connections
+    void setBaseUrl(const std::string& url);
+    std::string getBaseUrl() const;
+    
+    // Request budget (ExchangeConfig rateLimitRequests per rateLimitWindow, plus venue rules)
+    void setRateLimit(const RateLimitConfig& config);
+    RateLimitConfig getRateLimit() const;
+    RateLimiterStats getRateLimiterStats() const;
+    
+    // Housekeeping that blocks on REST (instrument refreshes, listenKey renewals) for every
+    // venue runs on this wheel's one thread, never on a reactor
+    static TimerWheel& maintenanceTimers();
+    
 protected:
     // HTTP helpers
     virtual std::string buildAuthHeader() const = 0;
     virtual std::string signRequest(const std::string& request) const = 0;
     
+    std::shared_ptr<HttpClient> getHttpClient() const;
+    void refreshAuthHeader();  // After the API key changes
+    void closeHttpClient();    // Fails outstanding and rate-queued requests; call before callbacks' targets go away
+    
+    RateLimiter& getRateLimiter() const { return *rateLimiter_; }
+    // Runs fetch, or joins an identical request already in flight under key
+    std::string coalesce(const std::string& key, const std::function<std::string()>& fetch) const;
+    
     std::string baseUrl_;
     std::string apiKey_;
     std::string apiSecret_;
     std::string passphrase_;
+    
+private:
+    mutable std::shared_ptr<HttpClient> httpClient_;
+    mutable std::mutex httpClientMutex_;
+    std::unique_ptr<RateLimiter> rateLimiter_;
+    std::unique_ptr<RequestCoalescer> coalescer_;
+    
+    void applyAuthHeader(HttpClient& client) const;
 };
 
 /**
@@ -185,6 +400,7 @@ public:
     static std::unique_ptr<ExchangeAPI> createCoinbaseAPI();
     static std::unique_ptr<ExchangeAPI> createMT4API();
     static std::unique_ptr<ExchangeAPI> createMT5API();
+    static std::unique_ptr<ExchangeAPI> createSimulatedAPI();
     
     // Configuration-based factory
     static std::unique_ptr<ExchangeAPI> createFromConfig(const std::string& configFile);
@@ -0,0 +1,189 @@
+#ifndef MASTERMIND_HTTP_CLIENT_H
+#define MASTERMIND_HTTP_CLIENT_H
+
+#include "api/EventReactor.h"
+#include "core/Types.h"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MasterMind {
+
+struct HttpResponse {
+    int status;            // 0 when the request never got a response
+    std::string head;      // Status line and header fields
+    std::string body;
+    std::string error;     // Transport failure or timeout, empty otherwise
+    double latencyMicros;  // Submission to last byte of the response
+
+    HttpResponse() : status(0), latencyMicros(0) {}
+    bool ok() const { return error.empty() && status >= 200 && status < 300; }
+    std::string header(const std::string& name) const;  // Empty when absent
+};
+
+struct HttpClientConfig {
+    size_t maxConnections;     // Keep-alive pool size for the origin
+    size_t maxPipelineDepth;   // Requests in flight per connection; 1 disables pipelining
+    Duration connectTimeout;
+    Duration requestTimeout;   // Submission to complete response
+    Duration idleTimeout;      // Idle pooled connections are closed after this
+
+    HttpClientConfig()
+        : maxConnections(4), maxPipelineDepth(4), connectTimeout(std::chrono::seconds(5)),
+          requestTimeout(std::chrono::seconds(10)), idleTimeout(std::chrono::seconds(60)) {}
+};
+
+struct HttpClientStats {
+    uint64_t requestsSent;
+    uint64_t responsesReceived;
+    uint64_t connectionsOpened;
+    uint64_t reusedConnections;   // Requests sent on a connection that had served one before
+    uint64_t pipelinedRequests;   // Requests sent while another was in flight on the connection
+    uint64_t retries;
+    uint64_t timeouts;
+    uint64_t failures;
+
+    HttpClientStats() : requestsSent(0), responsesReceived(0), connectionsOpened(0), reusedConnections(0),
+                        pipelinedRequests(0), retries(0), timeouts(0), failures(0) {}
+};
+
+/**
+ * @brief Pooled keep-alive HTTP/1.1 client for one origin
+ *
+ * Requests are serialized on the caller's thread from a cached template
+ * per method and path (request line and headers built once; only the
+ * query and body are appended) and handed to the EventReactor given at
+ * construction, normally shared with the venue's streams
+ * (ReactorPool::shared()); without one the client starts its own. All
+ * connection state lives on that reactor, which keeps up to maxConnections keep-alive
+ * connections, pipelines idempotent requests (GET, HEAD, PUT, DELETE) up to
+ * maxPipelineDepth per connection, sends other methods only on an idle
+ * connection with nothing queued behind them, and enforces connect,
+ * request and idle timeouts.
+ *
+ * A request that was in flight when its connection closed is resent once
+ * if idempotent; anything else fails rather than risk a duplicate order.
+ * Callbacks run on the reactor thread and must not block; the future
+ * overload fails at once when called from that thread rather than
+ * deadlock waiting on itself. https:// needs a
+ * build with OpenSSL (SSL_ENABLED). Linux only; elsewhere every request
+ * fails.
+ */
+class HttpClient {
+public:
+    using ResponseCallback = std::function<void(const HttpResponse&)>;
+
+    explicit HttpClient(const std::string& baseUrl, const HttpClientConfig& config = HttpClientConfig(),
+                        EventReactor* reactor = nullptr);
+    ~HttpClient();
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    // Added to every request prepared afterwards; an empty value removes it
+    void setDefaultHeader(const std::string& name, const std::string& value);
+
+    /**
+     * @brief Queue a request; the callback gets the response or the failure
+     * @param path Absolute path, e.g. /api/v3/order
+     * @param query Encoded query string without '?', may be empty
+     */
+    void request(const std::string& method, const std::string& path, const std::string& query,
+                 const std::string& body, ResponseCallback callback);
+    std::future<HttpResponse> request(const std::string& method, const std::string& path,
+                                      const std::string& query = "", const std::string& body = "");
+
+    void close();  // Fails outstanding requests and leaves the reactor
+
+    HttpClientStats getStats() const;
+    const std::string& getBaseUrl() const { return baseUrl_; }
+    size_t getOpenConnections() const { return openConnections_.load(std::memory_order_relaxed); }
+
+private:
+    struct RequestTemplate {
+        std::string prefix;   // "METHOD /path"
+        std::string suffix;   // " HTTP/1.1\r\n" and the headers, without the blank line
+        bool idempotent;
+        bool expectsBody;     // false for HEAD
+    };
+
+    struct PendingRequest {
+        std::string wire;
+        bool idempotent;
+        bool expectsBody;
+        bool retried;
+        std::chrono::steady_clock::time_point submitted;
+        std::chrono::steady_clock::time_point deadline;
+        ResponseCallback callback;
+    };
+
+    struct Connection;
+
+    std::string baseUrl_;
+    HttpClientConfig config_;
+    bool secure_;
+    std::string host_;
+    std::string port_;
+    bool valid_;
+
+    mutable std::mutex templateMutex_;
+    std::vector<std::pair<std::string, std::string>> defaultHeaders_;
+    std::unordered_map<std::string, std::shared_ptr<const RequestTemplate>> templates_;
+
+    // Submission queue, drained by the reactor
+    std::mutex queueMutex_;
+    std::vector<PendingRequest> submitted_;
+
+    // Reactor state; everything below running_ is touched on reactor_ only
+    EventReactor* reactor_;
+    std::unique_ptr<EventReactor> ownReactor_;  // When no reactor was given
+    std::atomic<bool> running_;
+    std::atomic<bool> passPosted_;
+    EventReactor::TimerId timer_;               // Next timeout pass, 0 when none
+    std::chrono::steady_clock::time_point timerDeadline_;
+    void* sslContext_;
+    std::deque<PendingRequest> waiting_;
+    std::vector<std::unique_ptr<Connection>> connections_;
+    std::atomic<size_t> openConnections_;
+
+    // Statistics
+    std::atomic<uint64_t> requestsSent_;
+    std::atomic<uint64_t> responsesReceived_;
+    std::atomic<uint64_t> connectionsOpened_;
+    std::atomic<uint64_t> reusedConnections_;
+    std::atomic<uint64_t> pipelinedRequests_;
+    std::atomic<uint64_t> retries_;
+    std::atomic<uint64_t> timeouts_;
+    std::atomic<uint64_t> failures_;
+
+    std::shared_ptr<const RequestTemplate> getTemplate(const std::string& method, const std::string& path);
+    void schedulePass();
+
+    void pass();
+    void onConnectionEvent(Connection& connection, uint32_t events);
+    void shutdown();
+    void dispatch(std::chrono::steady_clock::time_point now);
+    Connection* findConnection(const PendingRequest& request);
+    bool openConnection(std::chrono::steady_clock::time_point now);
+    bool advanceConnect(Connection& connection);
+    bool readConnection(Connection& connection);
+    bool writeConnection(Connection& connection);
+    bool parseResponses(Connection& connection, bool atEof);
+    void updateInterest(Connection& connection, bool wantWrite);
+    void closeConnection(Connection& connection, const std::string& reason);
+    void expire(std::chrono::steady_clock::time_point now);
+    std::chrono::steady_clock::time_point nextDeadline() const;
+    void complete(PendingRequest& request, HttpResponse& response);
+    void fail(PendingRequest& request, const std::string& error);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_HTTP_CLIENT_H
@@ -0,0 +1,113 @@
+#ifndef MASTERMIND_HTTP_STUB_SERVER_H
+#define MASTERMIND_HTTP_STUB_SERVER_H
+
+#include "core/Types.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MasterMind {
+
+struct HttpStubRequest {
+    std::string method;
+    std::string target;   // Path and query as sent
+    std::string head;     // Request line and headers
+    std::string body;
+};
+
+struct HttpStubResponse {
+    int status;
+    std::string body;
+    Duration delay;       // Hold the response back (and any pipelined behind it)
+    bool close;           // Send Connection: close and drop the connection
+    bool chunked;         // Chunked transfer encoding instead of Content-Length
+
+    HttpStubResponse() : status(200), delay(0), close(false), chunked(false) {}
+    HttpStubResponse(int code, const std::string& content)
+        : status(code), body(content), delay(0), close(false), chunked(false) {}
+};
+
+/**
+ * @brief Loopback HTTP/1.1 server for exercising REST clients offline
+ *
+ * A handler maps each request to a canned response; the default answers
+ * 200 with "{}". Connections are kept alive and pipelined requests are
+ * answered in order, so connection reuse, pipelining, timeouts and server
+ * closes can all be driven from a test. Requests are recorded.
+ *
+ * Binds 127.0.0.1 only. The handler runs on the server's epoll thread.
+ * Linux only; elsewhere start() fails.
+ */
+class HttpStubServer {
+public:
+    using Handler = std::function<HttpStubResponse(const HttpStubRequest&)>;
+
+    explicit HttpStubServer(uint16_t port = 0);
+    ~HttpStubServer();
+
+    HttpStubServer(const HttpStubServer&) = delete;
+    HttpStubServer& operator=(const HttpStubServer&) = delete;
+
+    void setHandler(Handler handler);  // Before start()
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_; }
+
+    uint16_t getPort() const { return port_; }
+    std::string getUrl() const;
+
+    uint64_t getRequestCount() const { return requestCount_.load(std::memory_order_relaxed); }
+    uint64_t getConnectionCount() const { return connectionCount_.load(std::memory_order_relaxed); }
+    size_t getMaxPipelined() const { return maxPipelined_.load(std::memory_order_relaxed); }
+    std::vector<HttpStubRequest> getRequests() const;
+
+private:
+    struct Queued {
+        std::string wire;
+        std::chrono::steady_clock::time_point due;
+        bool close;
+    };
+
+    struct Session {
+        int socket = -1;
+        std::string input;
+        std::vector<Queued> responses;  // Answered in order
+        std::string output;
+        size_t outputOffset = 0;
+        bool closeAfterWrite = false;
+    };
+
+    uint16_t requestedPort_;
+    uint16_t port_;
+    Handler handler_;
+    int listenSocket_;
+    int epoll_;
+    int wake_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::vector<Session> sessions_;   // Server thread only
+
+    std::atomic<uint64_t> requestCount_;
+    std::atomic<uint64_t> connectionCount_;
+    std::atomic<size_t> maxPipelined_;
+    mutable std::mutex requestsMutex_;
+    std::vector<HttpStubRequest> requests_;
+
+    void serverLoop();
+    void acceptClients();
+    bool readSession(Session& session);
+    bool parseRequests(Session& session);
+    bool writeSession(Session& session, std::chrono::steady_clock::time_point now);
+    int nextTimeoutMillis(std::chrono::steady_clock::time_point now) const;
+    void closeSession(Session& session);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_HTTP_STUB_SERVER_H
@@ -0,0 +1,148 @@
+#ifndef MASTERMIND_INSTRUMENT_REGISTRY_H
+#define MASTERMIND_INSTRUMENT_REGISTRY_H
+
+#include "core/Types.h"
+#include "core/TimerWheel.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace MasterMind {
+
+// Dense per-venue instrument index; stable for the life of the registry
+using SymbolId = uint32_t;
+constexpr SymbolId INVALID_SYMBOL_ID = UINT32_MAX;
+
+/**
+ * @brief Immutable instrument list of one venue at one point in time
+ *
+ * Specs are held in an array indexed by SymbolId, so a lookup by id is one
+ * bounds check and one load. Ids of symbols missing from this load (delisted)
+ * map to nullptr; suspended symbols are present with isActive false.
+ */
+class InstrumentSnapshot {
+public:
+    InstrumentSnapshot(std::vector<InstrumentSpec> specs, std::vector<SymbolId> specIds,
+                       std::unordered_map<Symbol, SymbolId> ids, size_t idCount, uint64_t version);
+
+    InstrumentSnapshot(const InstrumentSnapshot&) = delete;
+    InstrumentSnapshot& operator=(const InstrumentSnapshot&) = delete;
+
+    const InstrumentSpec* find(SymbolId id) const {
+        return id < byId_.size() ? byId_[id] : nullptr;
+    }
+    const InstrumentSpec* find(const Symbol& symbol) const { return find(getId(symbol)); }
+    SymbolId getId(const Symbol& symbol) const;
+
+    const std::vector<InstrumentSpec>& getInstruments() const { return specs_; }
+    size_t size() const { return specs_.size(); }
+    uint64_t getVersion() const { return version_; }
+    TimePoint getLoadTime() const { return loadTime_; }
+
+private:
+    std::vector<InstrumentSpec> specs_;
+    std::vector<const InstrumentSpec*> byId_;
+    std::unordered_map<Symbol, SymbolId> ids_;
+    uint64_t version_;
+    TimePoint loadTime_;
+};
+
+struct InstrumentRegistryStats {
+    uint64_t version;          // Snapshots published so far
+    uint64_t refreshes;        // Successful loader runs
+    uint64_t failures;         // Loader runs that returned false or threw
+    size_t instruments;        // In the current snapshot
+    size_t symbolIds;          // Ever assigned
+    TimePoint lastRefresh;
+    double lastLoadMillis;
+
+    InstrumentRegistryStats() : version(0), refreshes(0), failures(0), instruments(0), symbolIds(0),
+                                lastLoadMillis(0) {}
+};
+
+/**
+ * @brief Per-venue instrument registry with atomically swapped snapshots
+ *
+ * The venue's instrument list is loaded once, then refreshed from a
+ * repeating timer on a wheel the caller provides. Each load is published as a new InstrumentSnapshot
+ * with one atomic pointer store, so readers never lock and never see a
+ * half-built list. current() is a single acquire load.
+ *
+ * A SymbolId, once assigned, keeps naming the same symbol in every later
+ * snapshot, so callers may resolve a symbol once and cache the id.
+ *
+ * current() and the find()/getId() shortcuts built on it are for lookups
+ * that do not block: read what is needed and drop the pointer, never store
+ * it or hold it across I/O, a lock wait or a callback. Nothing tracks such
+ * readers; a replaced snapshot is freed RETIRE_GRACE after the publish that
+ * replaced it, which only a lookup that runs to completion can rely on.
+ * Anything else - copying the list, returning a spec, iterating - goes
+ * through acquire(), whose shared_ptr keeps the snapshot alive for as long
+ * as it is held.
+ */
+class InstrumentRegistry {
+public:
+    // Fill specs from the venue; false keeps the current snapshot
+    using Loader = std::function<bool(std::vector<InstrumentSpec>& specs)>;
+
+    static constexpr std::chrono::seconds RETIRE_GRACE{60};
+
+    InstrumentRegistry();
+    ~InstrumentRegistry();
+
+    InstrumentRegistry(const InstrumentRegistry&) = delete;
+    InstrumentRegistry& operator=(const InstrumentRegistry&) = delete;
+
+    // Reads; never null (empty before the first publish)
+    const InstrumentSnapshot* current() const { return current_.load(std::memory_order_acquire); }  // Non-blocking lookups only
+    std::shared_ptr<const InstrumentSnapshot> acquire() const;  // Owning; takes the publish lock briefly
+
+    const InstrumentSpec* find(SymbolId id) const { return current()->find(id); }
+    const InstrumentSpec* find(const Symbol& symbol) const { return current()->find(symbol); }
+    SymbolId getId(const Symbol& symbol) const { return current()->getId(symbol); }
+
+    // Writes
+    uint64_t publish(const std::vector<InstrumentSpec>& specs);  // Returns the new version
+    void setLoader(Loader loader);
+    bool refresh();  // Runs the loader now, on the caller's thread
+
+    // Periodic refresh on timers' thread; the first load runs before startRefresh returns
+    bool startRefresh(Duration interval, TimerWheel& timers);
+    void stopRefresh();
+    bool isRefreshing() const;
+
+    InstrumentRegistryStats getStats() const;
+
+private:
+    std::atomic<const InstrumentSnapshot*> current_;
+
+    // Publishing side
+    mutable std::mutex publishMutex_;
+    std::shared_ptr<const InstrumentSnapshot> owner_;
+    std::vector<std::pair<std::shared_ptr<const InstrumentSnapshot>, std::chrono::steady_clock::time_point>> retired_;
+    std::unordered_map<Symbol, SymbolId> ids_;  // Only grows
+    uint64_t version_;
+
+    // Loading side
+    mutable std::mutex loaderMutex_;
+    Loader loader_;
+    uint64_t refreshes_;
+    uint64_t failures_;
+    TimePoint lastRefresh_;
+    double lastLoadMillis_;
+
+    // Refresh timer
+    mutable std::mutex refreshMutex_;
+    TimerWheel* refreshTimers_;
+    TimerId refreshTimer_;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_INSTRUMENT_REGISTRY_H
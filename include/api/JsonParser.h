@@ -0,0 +1,91 @@
+#ifndef MASTERMIND_JSON_PARSER_H
+#define MASTERMIND_JSON_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace MasterMind {
+
+enum class JsonType {
+    NONE,       // End of input or error
+    OBJECT,
+    ARRAY,
+    STRING,
+    NUMBER,
+    BOOLEAN,
+    NULL_VALUE
+};
+
+/**
+ * @brief On-demand, zero-copy JSON reader for exchange payloads
+ *
+ * A cursor over the caller's buffer: the caller walks objects and arrays
+ * and pulls the fields it wants, skipping the rest. Nothing is built and
+ * nothing is allocated - keys and strings come back as views into the
+ * input, and numbers (bare or quoted, as exchanges send prices) are
+ * decoded straight from the characters into double or fixed point.
+ *
+ * Decimals are accumulated as an integer mantissa, eight fraction digits
+ * at a time, and scaled by one exact power of ten - correctly rounded for
+ * any mantissa below 2^53 and exponent within 1e22, which covers every
+ * exchange price and quantity; anything else falls back to strtod. Depth
+ * levels have their own call (readPair). The first syntax error latches:
+ * every later call returns false and ok() reports the failure.
+ *
+ * The buffer must outlive the reader and every view taken from it.
+ */
+class JsonReader {
+public:
+    JsonReader(const char* data, size_t length);
+    explicit JsonReader(std::string_view text);
+
+    // Structure
+    JsonType peek();
+    bool enterObject();
+    bool nextKey(std::string_view& key);  // false once the object closes
+    bool enterArray();
+    bool nextElement();                   // false once the array closes
+
+    // Values
+    bool readString(std::string_view& value);  // Raw contents, escapes left in place
+    bool readString(std::string& value);       // Unescaped into caller-owned storage
+    bool readDouble(double& value);            // Number or numeric string
+    bool readInteger(int64_t& value);
+    bool readUnsigned(uint64_t& value);
+    bool readFixed(int64_t& value, int scale); // value * 10^scale, excess digits truncated
+    bool readBool(bool& value);
+    bool readPair(double& first, double& second);  // ["price","qty"(, ...)] depth level
+    bool readNull();
+    bool skipValue();
+
+    bool ok() const { return !failed_; }
+    bool atEnd();
+    size_t getOffset() const { return static_cast<size_t>(position_ - begin_); }
+
+    /**
+     * @brief Decode a decimal without the reader (e.g. a field already held as a view)
+     * @return false unless the whole text is one number
+     */
+    static bool parseDouble(std::string_view text, double& value);
+
+private:
+    const char* begin_;
+    const char* position_;
+    const char* end_;
+    bool failed_;
+
+    void skipWhitespace();
+    bool fail();
+    bool expect(char c);
+    bool scanString(std::string_view& value);
+    bool scanNumber(std::string_view& value);
+    bool scanNumberOrString(std::string_view& value);
+    bool readMagnitude(uint64_t& magnitude, bool& negative);
+    bool skipLiteral(const char* literal, size_t length);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_JSON_PARSER_H
@@ -0,0 +1,109 @@
+#ifndef MASTERMIND_ORDER_BOOK_H
+#define MASTERMIND_ORDER_BOOK_H
+
+#include "core/Types.h"
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace MasterMind {
+
+struct PriceLevel {
+    Price price;
+    Volume quantity;
+
+    PriceLevel() : price(0), quantity(0) {}
+    PriceLevel(Price p, Volume q) : price(p), quantity(q) {}
+};
+
+struct TopOfBook {
+    Price bid;
+    Volume bidQuantity;
+    Price ask;
+    Volume askQuantity;
+    uint64_t updateId;
+
+    TopOfBook() : bid(0), bidQuantity(0), ask(0), askQuantity(0), updateId(0) {}
+};
+
+/**
+ * @brief Aggregated (L2) depth of book for one symbol
+ *
+ * Fed by exchange adapters from snapshots and incremental diffs, read by
+ * order routing and slippage estimation. Each side is a sorted flat array of
+ * levels with the best price at the back: updates near the touch - the vast
+ * majority of diff-depth traffic - insert or erase with little or no element
+ * movement, top of book is a single load, and depth walks read contiguous
+ * memory. Capacity is reserved up front so steady-state updates do not
+ * allocate.
+ *
+ * All methods are thread-safe; queries that touch several levels take one
+ * lock for the whole walk.
+ */
+class OrderBook {
+public:
+    /**
+     * @brief Constructor
+     * @param symbol Instrument symbol
+     * @param reserveLevels Levels to pre-allocate per side
+     */
+    explicit OrderBook(const Symbol& symbol, size_t reserveLevels = 5000);
+
+    // Feed
+    void applySnapshot(const std::vector<PriceLevel>& bids,
+                       const std::vector<PriceLevel>& asks,
+                       uint64_t updateId);
+    void applyDiff(const std::vector<PriceLevel>& bids,
+                   const std::vector<PriceLevel>& asks,
+                   uint64_t updateId);
+    void applyUpdate(OrderSide side, Price price, Volume quantity);  // quantity 0 removes the level
+    void clear();
+
+    // Top of book (O(1))
+    TopOfBook getTopOfBook() const;
+    Price getBestBid() const;
+    Price getBestAsk() const;
+    Price getMidPrice() const;
+    Price getSpread() const;
+
+    // Depth queries
+    std::vector<PriceLevel> getDepth(OrderSide side, size_t levels) const;  // Best first
+    Volume getCumulativeVolume(OrderSide side, size_t levels) const;
+    Volume getVolumeWithin(OrderSide side, Price limitPrice) const;
+
+    /**
+     * @brief Estimate the average fill price of an aggressive order
+     * @param side Side of the aggressive order (BUY walks the asks)
+     * @param quantity Quantity to fill
+     * @param filledQuantity Optional output: quantity the visible book can fill
+     * @return Volume-weighted average price, 0 if the opposite side is empty
+     */
+    Price estimateAverageFillPrice(OrderSide side, Volume quantity,
+                                   Volume* filledQuantity = nullptr) const;
+
+    // State
+    const Symbol& getSymbol() const { return symbol_; }
+    size_t getLevelCount(OrderSide side) const;
+    bool isEmpty() const;
+    uint64_t getLastUpdateId() const;
+    uint64_t getUpdateCount() const;
+    TimePoint getLastUpdateTime() const;
+
+private:
+    Symbol symbol_;
+    std::vector<PriceLevel> bids_;  // Ascending price, best bid at back
+    std::vector<PriceLevel> asks_;  // Descending price, best ask at back
+    uint64_t lastUpdateId_;
+    uint64_t updateCount_;
+    TimePoint lastUpdateTime_;
+    mutable std::mutex bookMutex_;
+
+    // Private methods (caller holds bookMutex_)
+    void setLevel(std::vector<PriceLevel>& levels, bool ascending, Price price, Volume quantity);
+    std::vector<PriceLevel>& sideLevels(OrderSide side) { return side == OrderSide::BUY ? bids_ : asks_; }
+    const std::vector<PriceLevel>& sideLevels(OrderSide side) const { return side == OrderSide::BUY ? bids_ : asks_; }
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_ORDER_BOOK_H
@@ -0,0 +1,203 @@
+#ifndef MASTERMIND_RATE_LIMITER_H
+#define MASTERMIND_RATE_LIMITER_H
+
+#include "core/Types.h"
+#include "api/EventReactor.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MasterMind {
+
+// Lower value is served first
+enum class RequestPriority : uint8_t {
+    CANCEL = 0,
+    NEW_ORDER,
+    QUERY,
+    COUNT
+};
+
+enum class RateLimitRule : uint8_t {
+    REQUEST_WEIGHT = 0,   // Every request, by endpoint weight
+    ORDERS,               // New orders only
+    COUNT
+};
+
+struct RateLimitConfig {
+    double weightLimit;        // Request weight allowed per weightWindow
+    Duration weightWindow;
+    double orderLimit;         // New orders allowed per orderWindow; 0 disables the rule
+    Duration orderWindow;
+    Duration windowGuard;      // Budget of a new window opens this late, covering clock skew with the venue;
+                               // usage in that interval counts against both windows
+    size_t maxQueued;          // Per priority lane; further requests are refused
+    Duration maxQueueDelay;    // Queued longer than this fails
+
+    RateLimitConfig()
+        : weightLimit(1200), weightWindow(std::chrono::seconds(60)), orderLimit(0),
+          orderWindow(std::chrono::seconds(10)), windowGuard(std::chrono::milliseconds(100)),
+          maxQueued(1024), maxQueueDelay(std::chrono::seconds(5)) {}
+    RateLimitConfig(double requests, Duration window) : RateLimitConfig() {
+        weightLimit = requests;
+        weightWindow = window;
+    }
+};
+
+struct RateLimiterStats {
+    std::array<uint64_t, static_cast<size_t>(RequestPriority::COUNT)> admitted;
+    std::array<uint64_t, static_cast<size_t>(RequestPriority::COUNT)> delayed;   // Had to queue first
+    uint64_t refused;          // Lane full, queue timeout or limiter stopped
+    uint64_t coalesced;        // Callers served by another caller's in-flight request
+    uint64_t throttled;        // Venue told us to back off (429/418)
+    uint64_t resynced;         // Venue reported more usage than counted locally
+    size_t queued;             // Waiting now, all lanes
+    size_t maxQueued;
+    double weightUsed;         // In the current window
+    double ordersUsed;
+    double maxWaitMicros;
+    double totalWaitMicros;    // Over delayed requests
+
+    RateLimiterStats() : refused(0), coalesced(0), throttled(0), resynced(0), queued(0), maxQueued(0),
+                         weightUsed(0), ordersUsed(0), maxWaitMicros(0), totalWaitMicros(0) {
+        admitted.fill(0);
+        delayed.fill(0);
+    }
+};
+
+/**
+ * @brief Client-side request budget for one venue
+ *
+ * Each rule counts usage in fixed windows aligned to the wall clock, the way
+ * venues such as Binance count REQUEST_WEIGHT per minute and ORDERS per 10
+ * seconds. A token bucket of the same rate could spend twice the limit
+ * inside one of those windows; a fixed window spends exactly the limit and
+ * never more. Local windows open windowGuard after the venue's; what is
+ * spent in that interval may land in either venue window, so it is charged
+ * to the closing window and carried into the next one. When the venue reports its own count (usage headers), sync()
+ * raises the local count so drift and other sessions on the same key are
+ * accounted for.
+ *
+ * A request that fits is admitted on the caller's thread with no hand-off.
+ * Otherwise it waits in its priority lane (cancels, then new orders, then
+ * queries) and is admitted from a timer on a shared reactor as soon as the
+ * next window opens, so a venue's budget costs no thread of its own.
+ * Admission callbacks therefore must not block. A waiting higher lane reserves its share of every rule it
+ * needs, so a lower lane never takes that budget, but may still pass it
+ * with what is left (a query is not held behind new orders that only wait
+ * for the order budget).
+ */
+class RateLimiter {
+public:
+    // true when admitted, false when refused; the request must not be sent on false
+    using Callback = std::function<void(bool admitted)>;
+
+    // reactor: runs the admission timer; null picks one from ReactorPool::shared()
+    explicit RateLimiter(const RateLimitConfig& config = RateLimitConfig(), EventReactor* reactor = nullptr);
+    ~RateLimiter();
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    void setConfig(const RateLimitConfig& config);
+    RateLimitConfig getConfig() const;
+
+    // Admit now or not at all
+    bool tryAcquire(RequestPriority priority, uint32_t weight, uint32_t orders = 0);
+
+    // Callback runs inline when admitted at once, else on the reactor
+    void submit(RequestPriority priority, uint32_t weight, uint32_t orders, Callback callback);
+
+    // Blocks until admitted or refused (maxQueueDelay at most)
+    bool acquire(RequestPriority priority, uint32_t weight, uint32_t orders = 0);
+
+    // Venue feedback
+    void sync(RateLimitRule rule, double usedInWindow);
+    void pause(Duration duration);     // Admit nothing, cancels included, until it elapses
+    void recordCoalesced();
+
+    void stop();  // Refuses everything queued and later
+
+    RateLimiterStats getStats() const;
+
+private:
+    struct Rule {
+        double limit = 0;
+        int64_t windowMillis = 1;
+        int64_t windowIndex = -1;
+        double used = 0;
+        double carry = 0;   // Used past the venue's boundary; opens the next window
+    };
+
+    struct Waiter {
+        uint32_t weight;
+        uint32_t orders;
+        std::chrono::steady_clock::time_point enqueued;
+        Callback callback;
+    };
+
+    // Budget that waiting higher-priority requests keep from lower lanes
+    struct Hold {
+        std::array<bool, static_cast<size_t>(RateLimitRule::COUNT)> blocked{};
+        std::array<double, static_cast<size_t>(RateLimitRule::COUNT)> reserved{};
+    };
+
+    using Admission = std::pair<Callback, bool>;
+
+    RateLimitConfig config_;
+    std::array<Rule, static_cast<size_t>(RateLimitRule::COUNT)> rules_;
+    std::array<std::deque<Waiter>, static_cast<size_t>(RequestPriority::COUNT)> lanes_;
+    std::chrono::system_clock::time_point pausedUntil_;
+    bool stopped_;
+    mutable std::mutex mutex_;
+    EventReactor* reactor_;
+    EventReactor::TimerId timer_;
+    std::chrono::steady_clock::time_point timerDue_;
+    bool timerArmed_;
+    uint64_t timerGeneration_;  // Tells a superseded timer that already fired from the armed one
+    RateLimiterStats stats_;
+
+    void onTimer(uint64_t generation);
+    void armTimer(std::chrono::steady_clock::time_point when);  // Caller holds mutex_
+    std::chrono::steady_clock::time_point nextWake(std::chrono::system_clock::time_point now,
+                                                   std::chrono::steady_clock::time_point steadyNow) const;
+    bool admit(RequestPriority priority, uint32_t weight, uint32_t orders, std::chrono::system_clock::time_point now);
+    void drainLanes(std::chrono::system_clock::time_point now, std::vector<Admission>& ready);
+    void expireLanes(std::chrono::steady_clock::time_point now, std::vector<Admission>& ready);
+    void rollWindows(int64_t nowMillis);
+    int64_t windowIndexAt(const Rule& rule, int64_t nowMillis) const;
+    void holdFor(uint32_t weight, uint32_t orders, Hold& hold) const;
+    bool fits(uint32_t weight, uint32_t orders, const Hold& hold) const;
+    bool fitsRule(size_t rule, uint32_t cost, double reserved) const;
+    void charge(size_t lane, uint32_t weight, uint32_t orders, int64_t nowMillis);
+    std::chrono::system_clock::time_point nextOpening(std::chrono::system_clock::time_point now) const;
+    size_t queuedLocked() const;
+    int64_t toMillis(std::chrono::system_clock::time_point time) const;
+};
+
+/**
+ * @brief Shares one in-flight request among identical concurrent callers
+ *
+ * The first caller for a key runs the fetch; callers arriving before it
+ * finishes wait for and return the same result. Nothing is cached after the
+ * fetch completes.
+ */
+class RequestCoalescer {
+public:
+    // coalesced is set when the result came from another caller's fetch
+    std::string run(const std::string& key, const std::function<std::string()>& fetch, bool* coalesced = nullptr);
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_future<std::string>> inFlight_;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_RATE_LIMITER_H
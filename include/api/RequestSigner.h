@@ -0,0 +1,60 @@
+#ifndef MASTERMIND_REQUEST_SIGNER_H
+#define MASTERMIND_REQUEST_SIGNER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace MasterMind {
+
+/**
+ * @brief HMAC-SHA256 request signing for venue REST APIs
+ *
+ * HMAC hashes (key ^ ipad) and (key ^ opad) ahead of every message. Both
+ * are a single SHA-256 block for keys up to 64 bytes, so setSecret()
+ * compresses them once and keeps the two intermediate hash states. A
+ * signature then copies those states into the calling thread's working
+ * context and hashes only the message and the inner digest: no key
+ * schedule, no allocation, no context setup per request.
+ *
+ * The SHA-256 block function is OpenSSL's when built with SSL_ENABLED
+ * (hardware SHA extensions where present) and a portable one otherwise,
+ * so signatures are real HMAC-SHA256 in both builds.
+ *
+ * Set the secret before signing starts; sign() and signParams() may then
+ * run on any number of threads at once.
+ */
+class RequestSigner {
+public:
+    static constexpr size_t DIGEST_SIZE = 32;
+    static constexpr size_t HEX_SIZE = 2 * DIGEST_SIZE;
+
+    explicit RequestSigner(const std::string& secret = "");
+
+    void setSecret(const std::string& secret);
+    bool hasSecret() const { return keyed_; }
+
+    // Lowercase hex signature, HEX_SIZE characters written to hex (not terminated)
+    void sign(const char* data, size_t length, char* hex) const;
+    std::string sign(std::string_view message) const;
+
+    /**
+     * @brief Build "params&timestamp=<ms>&signature=<hex>"
+     * @return Reference to a per-thread buffer, valid until the next signParams() on this thread
+     */
+    const std::string& signParams(std::string_view params, int64_t timestampMillis) const;
+
+    static void toHex(const unsigned char* bytes, size_t length, char* hex);
+
+private:
+    // SHA-256 chaining values after the ipad and opad blocks
+    std::array<uint32_t, 8> innerState_;
+    std::array<uint32_t, 8> outerState_;
+    bool keyed_;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_REQUEST_SIGNER_H
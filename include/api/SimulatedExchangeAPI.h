@@ -0,0 +1,293 @@
+#ifndef MASTERMIND_SIMULATED_EXCHANGE_API_H
+#define MASTERMIND_SIMULATED_EXCHANGE_API_H
+
+#include "api/ExchangeAPI.h"
+#include "api/SimulatedOrderBook.h"
+#include <deque>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <unordered_set>
+
+namespace MasterMind {
+
+/**
+ * @brief In-process matching engine exchange for paper trading, backtests and tests
+ *
+ * Keeps a price-time priority SimulatedOrderBook per symbol and matches
+ * market, limit, stop, stop-limit and iceberg orders. Orders placed through
+ * the ExchangeAPI interface can trade against each other, and against the
+ * replayed tick stream which stands in for the rest of the market:
+ * - Aggressive orders first match resting book liquidity, then take the
+ *   tick's bid/ask adjusted by the slippage model
+ * - Resting limit orders fill when the tick's opposite quote crosses them
+ * - Stops trigger on the tick's last price
+ *
+ * The resting orders plus the current tick quote are published as the
+ * symbol's L2 OrderBook after every change.
+ *
+ * Order entry and cancellation can be delayed by a configurable latency
+ * model measured in replayed (tick) time. Callbacks are dispatched after
+ * the internal lock is released, fills before the order update.
+ */
+class SimulatedExchangeAPI : public ExchangeAPI {
+public:
+    struct SimulationConfig {
+        Duration orderLatency = Duration::zero();    // Entry to book activation
+        Duration cancelLatency = Duration::zero();
+        Duration latencyJitter = Duration::zero();   // Uniform [0, jitter] added to both
+        double slippageBps = 0.0;                    // Fixed slippage vs tick quotes
+        double impactBpsPerUnit = 0.0;               // Linear impact per unit quantity
+        Volume tickLiquidity = 0.0;                  // Quantity available per tick (0 = unlimited)
+        double makerFeeRate = 0.001;
+        double takerFeeRate = 0.001;
+        double defaultTickSize = 0.01;
+        double initialBalance = 10000.0;
+        Currency currency = "USDT";
+        uint64_t randomSeed = 42;
+    };
+
+    /**
+     * @brief Constructor
+     */
+    SimulatedExchangeAPI();
+    explicit SimulatedExchangeAPI(const SimulationConfig& config);
+
+    /**
+     * @brief Destructor
+     */
+    ~SimulatedExchangeAPI() override;
+
+    // Simulation control
+    void setSimulationConfig(const SimulationConfig& config);
+    SimulationConfig getSimulationConfig() const;
+    void addInstrument(const InstrumentSpec& spec);
+    void onMarketTick(const Tick& tick);              // Replay one tick
+    void replayTicks(const std::vector<Tick>& ticks);
+    void advanceTime(TimePoint now);                  // Release latency-delayed events
+    void loadHistoricalData(const Symbol& symbol, const std::vector<OHLC>& bars);
+    void reset();
+    uint64_t getMatchedEventCount() const;
+
+    // Connection management
+    bool connect() override;
+    bool disconnect() override;
+    bool isConnected() const override;
+    bool reconnect() override;
+
+    // Authentication
+    bool authenticate(const std::string& apiKey,
+                      const std::string& apiSecret,
+                      const std::string& passphrase = "") override;
+    bool isAuthenticated() const override;
+
+    // Market data
+    bool subscribeMarketData(const std::vector<Symbol>& symbols) override;
+    bool unsubscribeMarketData(const std::vector<Symbol>& symbols) override;
+    Tick getLastTick(const Symbol& symbol) const override;
+    std::vector<OHLC> getHistoricalData(const Symbol& symbol,
+                                        TimePoint start,
+                                        TimePoint end,
+                                        Duration interval) const override;
+
+    // Order management
+    OrderId placeOrder(const Order& order) override;
+    bool cancelOrder(const OrderId& orderId) override;
+    bool modifyOrder(const OrderId& orderId, const Order& newOrder) override;
+    Order getOrder(const OrderId& orderId) const override;
+    std::vector<Order> getActiveOrders() const override;
+    std::vector<Order> getOrderHistory(const Symbol& symbol = "", int limit = 100) const override;
+
+    // Position management
+    std::vector<Position> getPositions() const override;
+    Position getPosition(const Symbol& symbol) const override;
+    bool closePosition(const Symbol& symbol) override;
+    bool closeAllPositions() override;
+
+    // Account information
+    AccountInfo getAccountInfo() const override;
+    double getBalance() const override;
+    double getEquity() const override;
+    double getMargin() const override;
+    double getFreeMargin() const override;
+
+    // Instrument information
+    std::vector<InstrumentSpec> getInstruments() const override;
+    InstrumentSpec getInstrumentSpec(const Symbol& symbol) const override;
+    bool isSymbolAvailable(const Symbol& symbol) const override;
+
+    // Exchange-specific information
+    std::string getExchangeName() const override;
+    std::vector<AssetClass> getSupportedAssetClasses() const override;
+
+    // Trading session information
+    bool isTradingSessionOpen() const override;
+    TimePoint getNextTradingSession() const override;
+    std::vector<std::pair<TimePoint, TimePoint>> getTradingSessions() const override;
+
+    // Fee and cost calculations
+    double calculateTradingFee(const Order& order) const override;
+    double calculateMarginRequirement(const Order& order) const override;
+
+    // Error handling
+    std::string getLastError() const override;
+    void clearErrors() override;
+
+protected:
+    bool validateSymbol(const Symbol& symbol) const override;
+    bool validateOrder(const Order& order) const override;
+
+private:
+    struct SimOrder {
+        Order order;
+        uint64_t tag = 0;
+        SimulatedOrderBook::Handle handle = SimulatedOrderBook::INVALID_HANDLE;
+        double notionalFilled = 0.0;
+        bool active = false;     // Past its order latency, resting or armed at the venue
+        bool triggered = false;  // Stop orders: trigger reached
+    };
+
+    struct SymbolState {
+        explicit SymbolState(double tickSize) : book(tickSize) {}
+
+        SimulatedOrderBook book;
+        InstrumentSpec spec;
+        Tick lastTick;
+        bool hasTick = false;
+        Volume tickLiquidityUsed = 0;                 // Synthetic liquidity taken this tick
+        bool bookDirty = false;                       // L2 book needs republishing
+        std::multimap<int64_t, uint64_t> buyStops;   // Trigger ticks -> order tag
+        std::multimap<int64_t, uint64_t> sellStops;
+        Position position;
+        std::vector<OHLC> history;
+    };
+
+    enum class EventType { NEW_ORDER, CANCEL_ORDER };
+    struct PendingEvent {
+        TimePoint activateAt;
+        uint64_t sequence;
+        EventType type;
+        uint64_t tag;
+        bool operator>(const PendingEvent& other) const {
+            return activateAt != other.activateAt ? activateAt > other.activateAt
+                                                  : sequence > other.sequence;
+        }
+    };
+
+    // Callback dispatch, collected under the lock and fired after it. Each
+    // record names its payload by index into the buffer's pool for its kind.
+    struct Notification {
+        enum class Kind : uint8_t { TICK, FILL, ORDER, POSITION, ACCOUNT, BOOK };
+
+        Kind kind;
+        uint32_t index;   // Into ticks, fillIds, orders, positions or books
+        Volume quantity;  // FILL
+        Price price;      // FILL
+    };
+
+    // Grows to the largest batch seen; clear() keeps the elements, so
+    // assigning into them later reuses their string capacity
+    template <typename T>
+    struct RecyclingPool {
+        std::vector<T> items;
+        size_t count = 0;
+
+        uint32_t add(const T& value) {
+            if (count < items.size()) {
+                items[count] = value;
+            } else {
+                items.push_back(value);
+            }
+            return static_cast<uint32_t>(count++);
+        }
+        const T& operator[](uint32_t index) const { return items[index]; }
+        void clear() { count = 0; }
+    };
+
+    struct NotificationBuffer {
+        std::vector<Notification> records;
+        RecyclingPool<Tick> ticks;
+        RecyclingPool<OrderId> fillIds;
+        RecyclingPool<Order> orders;
+        RecyclingPool<Position> positions;
+        RecyclingPool<Symbol> books;
+        AccountInfo account;  // At most one per batch
+
+        void clear();
+    };
+
+    SimulationConfig config_;
+    mutable std::mutex simMutex_;
+
+    std::unordered_map<Symbol, std::unique_ptr<SymbolState>> symbols_;
+    std::unordered_map<uint64_t, SimOrder> orders_;      // Live orders by tag
+    std::unordered_map<OrderId, uint64_t> orderTags_;    // Client id -> tag
+    std::deque<Order> completedOrders_;
+    std::unordered_set<Symbol> subscriptions_;
+    std::priority_queue<PendingEvent, std::vector<PendingEvent>, std::greater<PendingEvent>> pendingEvents_;
+
+    double balance_;
+    double realizedPnL_;
+    TimePoint clock_;
+    bool clockStarted_;
+    uint64_t nextTag_;
+    uint64_t nextSequence_;
+    uint64_t matchedEvents_;
+    bool accountDirty_;
+    std::mt19937_64 rng_;
+
+    // Reused scratch buffers: after warm-up the hot path allocates nothing
+    // beyond what new orders and symbols bring with them
+    std::vector<SimulatedOrderBook::Fill> fills_;
+    std::vector<uint64_t> triggered_;
+    std::vector<SymbolState*> dirtyBooks_;
+    std::vector<PriceLevel> bookBids_;
+    std::vector<PriceLevel> bookAsks_;
+    uint64_t bookUpdateId_;
+    
+    // Notifications: pending_ collects under simMutex_; a dispatch swaps in a
+    // spare buffer and hands its own back once the callbacks have run. One
+    // dispatching thread cycles between two buffers; concurrent ones add more.
+    std::unique_ptr<NotificationBuffer> pending_;
+    std::vector<std::unique_ptr<NotificationBuffer>> spareBuffers_;  // bufferMutex_
+    std::mutex bufferMutex_;
+
+    static constexpr size_t MAX_COMPLETED_ORDERS = 10000;
+    static constexpr size_t PUBLISHED_DEPTH = 50;
+
+    // Order lifecycle (caller holds simMutex_)
+    SymbolState& getSymbolState(const Symbol& symbol);
+    const SymbolState* findSymbolState(const Symbol& symbol) const;
+    void activateOrder(uint64_t tag);
+    void executeOrder(SimOrder& simOrder, SymbolState& state);
+    void executeCancel(uint64_t tag);
+    void takeLiquidity(SimOrder& simOrder, SymbolState& state, int64_t limitTicks);
+    void applyMakerFills(SymbolState& state);
+    void matchRestingAgainstTick(SymbolState& state);
+    void triggerStops(SymbolState& state);
+    void finishOrder(uint64_t tag, OrderStatus status);
+    void releasePendingEvents();
+    Duration sampleLatency(Duration base);
+
+    // Accounting (caller holds simMutex_)
+    void recordFill(SimOrder& simOrder, SymbolState& state, Volume quantity, Price price, bool maker);
+    void updatePosition(SymbolState& state, OrderSide side, Volume quantity, Price price);
+    AccountInfo buildAccountInfo() const;
+    void queueOrderUpdate(const Order& order);
+    void queuePositionUpdate(const SymbolState& state);
+    void markBookDirty(SymbolState& state);
+    void publishBook(SymbolState& state);
+    TimePoint currentTime() const;
+
+    void queueNotification(Notification::Kind kind, uint32_t index, Volume quantity = 0, Price price = 0);
+    
+    // Swaps out the queued notifications (caller holds simMutex_); dispatch
+    // runs without it and recycles the buffer
+    std::unique_ptr<NotificationBuffer> takeNotifications();
+    void dispatchNotifications(std::unique_ptr<NotificationBuffer> notifications);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_SIMULATED_EXCHANGE_API_H
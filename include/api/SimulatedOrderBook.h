@@ -0,0 +1,137 @@
+#ifndef MASTERMIND_SIMULATED_ORDER_BOOK_H
+#define MASTERMIND_SIMULATED_ORDER_BOOK_H
+
+#include "core/Types.h"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace MasterMind {
+
+/**
+ * @brief Price-time priority limit order book for one symbol (L3)
+ *
+ * Matching core of the SimulatedExchangeAPI. Prices are held as integer
+ * ticks, orders live in a pooled node array linked into per-level FIFO
+ * queues, and each side is a sorted flat array of levels with the best
+ * price at the back so that top-of-book inserts and removals are O(1)
+ * amortised. Orders are addressed by handles returned from add(), so
+ * the hot path performs no hashing and no allocation once warmed up.
+ *
+ * Iceberg orders expose displayQuantity at a time; when the visible slice
+ * is consumed it is refilled from the hidden quantity and re-queued at the
+ * back of its level (losing time priority, as on real venues).
+ */
+class SimulatedOrderBook {
+public:
+    using Handle = uint64_t;
+
+    static constexpr Handle INVALID_HANDLE = 0;
+    static constexpr int64_t MARKET_BUY_LIMIT = std::numeric_limits<int64_t>::max();
+    static constexpr int64_t MARKET_SELL_LIMIT = std::numeric_limits<int64_t>::min();
+
+    struct Fill {
+        Handle makerHandle;
+        uint64_t makerTag;
+        int64_t priceTicks;
+        Volume quantity;
+        bool makerComplete;
+    };
+
+    struct Level {
+        int64_t priceTicks;
+        Volume visibleQuantity;
+        uint32_t orderCount;
+        uint32_t head;
+        uint32_t tail;
+    };
+
+    /**
+     * @brief Constructor
+     * @param tickSize Minimum price increment used for tick conversion
+     * @param expectedOrders Number of resting orders to pre-allocate
+     */
+    explicit SimulatedOrderBook(double tickSize, size_t expectedOrders = 65536);
+
+    // Order entry
+    Handle add(uint64_t tag, OrderSide side, int64_t priceTicks,
+               Volume quantity, Volume displayQuantity = 0);
+    bool cancel(Handle handle);
+    bool reduce(Handle handle, Volume newQuantity);  // Keeps time priority
+
+    /**
+     * @brief Match an aggressive order against the opposite side
+     * @param side Side of the aggressive order
+     * @param limitTicks Worst acceptable price (MARKET_* limits for market orders)
+     * @param quantity Quantity to match
+     * @param fills Output buffer (appended to; caller reuses it)
+     * @return Quantity matched
+     */
+    Volume match(OrderSide side, int64_t limitTicks, Volume quantity, std::vector<Fill>& fills);
+
+    // Queries
+    bool contains(Handle handle) const;
+    Volume getRemaining(Handle handle) const;
+    uint64_t getTag(Handle handle) const;
+    int64_t getPriceTicks(Handle handle) const;
+    bool hasBids() const { return !bids_.empty(); }
+    bool hasAsks() const { return !asks_.empty(); }
+    int64_t getBestBidTicks() const { return bids_.empty() ? 0 : bids_.back().priceTicks; }
+    int64_t getBestAskTicks() const { return asks_.empty() ? 0 : asks_.back().priceTicks; }
+    Price getBestBid() const { return toPrice(getBestBidTicks()); }
+    Price getBestAsk() const { return toPrice(getBestAskTicks()); }
+    size_t getOrderCount() const { return orderCount_; }
+
+    // Levels ordered best-first: index 0 is the top of book
+    size_t getLevelCount(OrderSide side) const;
+    const Level& getLevel(OrderSide side, size_t index) const;
+
+    // Price conversion
+    int64_t toTicks(Price price) const;
+    Price toPrice(int64_t ticks) const { return static_cast<Price>(ticks) * tickSize_; }
+    double getTickSize() const { return tickSize_; }
+
+    void clear();
+
+private:
+    static constexpr uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Node {
+        uint64_t tag;
+        int64_t priceTicks;
+        Volume remaining;         // Total remaining including hidden quantity
+        Volume visibleRemaining;  // Currently displayed quantity
+        Volume displayQuantity;   // Iceberg slice size (0 = fully visible)
+        uint32_t prev;
+        uint32_t next;
+        uint32_t generation;
+        OrderSide side;
+        bool active;
+    };
+
+    double tickSize_;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> freeList_;
+    std::vector<Level> bids_;  // Ascending price, best bid at back
+    std::vector<Level> asks_;  // Descending price, best ask at back
+    size_t orderCount_;
+
+    // Private methods
+    uint32_t allocateNode();
+    void releaseNode(uint32_t index);
+    Node* resolve(Handle handle);
+    const Node* resolve(Handle handle) const;
+    std::vector<Level>& sideLevels(OrderSide side) { return side == OrderSide::BUY ? bids_ : asks_; }
+    const std::vector<Level>& sideLevels(OrderSide side) const { return side == OrderSide::BUY ? bids_ : asks_; }
+    Level* findLevel(OrderSide side, int64_t priceTicks);
+    Level& findOrInsertLevel(OrderSide side, int64_t priceTicks);
+    void eraseLevel(OrderSide side, int64_t priceTicks);
+    void appendToLevel(Level& level, uint32_t index);
+    void unlinkFromLevel(Level& level, uint32_t index);
+
+    static Handle makeHandle(uint32_t index, uint32_t generation);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_SIMULATED_ORDER_BOOK_H
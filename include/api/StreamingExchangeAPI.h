@@ -0,0 +1,107 @@
+#ifndef MASTERMIND_STREAMING_EXCHANGE_API_H
+#define MASTERMIND_STREAMING_EXCHANGE_API_H
+
+#include "api/ExchangeAPI.h"
+#include <string>
+#include <vector>
+
+namespace MasterMind {
+
+/**
+ * @brief Market-data-only adapter for any venue with a VenueCodec
+ *
+ * Everything a venue needs for public data comes from its codec: the
+ * stream URL, subscription messages and decoding into VenueEvents, which
+ * WebSocketExchangeAPI applies to ticks and order books. The socket joins
+ * the shared reactor pool, so a venue added this way costs no thread.
+ *
+ * Used for Deribit and Coinbase until they have order entry. Connecting
+ * opens nothing by itself (the stream opens on the first subscription);
+ * order, position and account calls fail or return empty with an error.
+ */
+class StreamingExchangeAPI : public WebSocketExchangeAPI {
+public:
+    explicit StreamingExchangeAPI(Exchange exchangeType);
+    ~StreamingExchangeAPI() override;
+
+    // Connection management
+    bool connect() override;
+    bool disconnect() override;
+    bool isConnected() const override;
+    bool reconnect() override;
+
+    // Authentication
+    bool authenticate(const std::string& apiKey,
+                      const std::string& apiSecret,
+                      const std::string& passphrase = "") override;
+    bool isAuthenticated() const override;
+
+    // Market data
+    bool subscribeMarketData(const std::vector<Symbol>& symbols) override;
+    bool unsubscribeMarketData(const std::vector<Symbol>& symbols) override;
+    Tick getLastTick(const Symbol& symbol) const override;
+    std::vector<OHLC> getHistoricalData(const Symbol& symbol,
+                                        TimePoint start,
+                                        TimePoint end,
+                                        Duration interval) const override;
+
+    // Order management
+    OrderId placeOrder(const Order& order) override;
+    bool cancelOrder(const OrderId& orderId) override;
+    bool modifyOrder(const OrderId& orderId, const Order& newOrder) override;
+    Order getOrder(const OrderId& orderId) const override;
+    std::vector<Order> getActiveOrders() const override;
+    std::vector<Order> getOrderHistory(const Symbol& symbol = "", int limit = 100) const override;
+
+    // Position management
+    std::vector<Position> getPositions() const override;
+    Position getPosition(const Symbol& symbol) const override;
+    bool closePosition(const Symbol& symbol) override;
+    bool closeAllPositions() override;
+
+    // Account information
+    AccountInfo getAccountInfo() const override;
+    double getBalance() const override;
+    double getEquity() const override;
+    double getMargin() const override;
+    double getFreeMargin() const override;
+
+    // Instrument information
+    std::vector<InstrumentSpec> getInstruments() const override;
+    InstrumentSpec getInstrumentSpec(const Symbol& symbol) const override;
+    bool isSymbolAvailable(const Symbol& symbol) const override;
+
+    // Exchange-specific information
+    std::string getExchangeName() const override;
+    std::vector<AssetClass> getSupportedAssetClasses() const override;
+
+    // Trading session information
+    bool isTradingSessionOpen() const override;
+    TimePoint getNextTradingSession() const override;
+    std::vector<std::pair<TimePoint, TimePoint>> getTradingSessions() const override;
+
+    // Fee and cost calculations
+    double calculateTradingFee(const Order& order) const override;
+    double calculateMarginRequirement(const Order& order) const override;
+
+    // Error handling
+    std::string getLastError() const override;
+    void clearErrors() override;
+
+protected:
+    bool validateSymbol(const Symbol& symbol) const override;
+    bool validateOrder(const Order& order) const override;
+
+    void onWebSocketConnect() override;
+    void onWebSocketDisconnect() override;
+    void onWebSocketError(const std::string& error) override;
+
+private:
+    std::string name_;
+
+    bool unsupported(const char* operation) const;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_STREAMING_EXCHANGE_API_H
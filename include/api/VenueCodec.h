@@ -0,0 +1,191 @@
+#ifndef MASTERMIND_VENUE_CODEC_H
+#define MASTERMIND_VENUE_CODEC_H
+
+#include "api/BinanceMessages.h"
+#include "api/OrderBook.h"
+#include "core/Types.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MasterMind {
+
+// One market data update in venue-neutral form
+struct VenueEvent {
+    enum class Type {
+        TICK,           // Best bid/ask (and last price where the venue sends it)
+        TRADE,
+        BOOK_SNAPSHOT,  // Replaces the book
+        BOOK_UPDATE     // Levels to set; quantity 0 removes
+    };
+
+    Type type;
+    Exchange venue;
+    Symbol symbol;               // Venue spelling (BTCUSDT, BTC-PERPETUAL, BTC-USD)
+    TimePoint time;              // Venue timestamp, receive time when it sends none
+    Price bid;                   // TICK; 0 where the venue left a field out
+    Price ask;
+    Price price;                 // TRADE, or last price on a TICK
+    Volume quantity;             // TRADE
+    OrderSide side;              // TRADE: aggressor side
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+    uint64_t firstSequence;      // BOOK_*: first and last venue update ids covered, 0 when unsequenced
+    uint64_t sequence;
+    uint64_t previousSequence;   // Id this update follows, where the venue sends one
+
+    VenueEvent()
+        : type(Type::TICK), venue(Exchange::SIMULATED), bid(0), ask(0), price(0), quantity(0), side(OrderSide::BUY),
+          firstSequence(0), sequence(0), previousSequence(0) {}
+
+    // Clears everything but venue, symbol and time; vectors keep their capacity
+    void reset(Type eventType) {
+        type = eventType;
+        bid = ask = price = quantity = 0;
+        side = OrderSide::BUY;
+        bids.clear();
+        asks.clear();
+        firstSequence = sequence = previousSequence = 0;
+    }
+};
+
+/**
+ * @brief Wire format of one venue's public market data stream
+ *
+ * A codec knows how to address the stream (URL and subscription
+ * messages) and how to turn each inbound message into VenueEvents. It
+ * holds no connection: WebSocketExchangeAPI owns the socket and applies
+ * the events to its tick cache and order books, so a new venue is a codec
+ * plus whatever REST it needs, not another transport.
+ *
+ * decode() runs on the reactor thread and reuses the codec's scratch
+ * event, so one codec serves one connection. An event is valid only for
+ * the duration of the sink call.
+ */
+class VenueCodec {
+public:
+    using EventSink = std::function<void(const VenueEvent&)>;
+
+    virtual ~VenueCodec() = default;
+
+    virtual Exchange getExchange() const = 0;
+    virtual const char* getName() const = 0;
+    virtual std::string getDefaultEndpoint() const = 0;
+
+    // URL to open for symbols; venues that subscribe by message ignore them
+    virtual std::string buildStreamUrl(const std::string& endpoint, const std::vector<Symbol>& symbols) const = 0;
+    virtual bool subscribesInUrl() const { return false; }
+    // Message (un)subscribing symbols on an open connection
+    virtual std::string buildSubscription(const std::vector<Symbol>& symbols, bool subscribe,
+                                          uint64_t requestId) const = 0;
+
+    /**
+     * @brief Decode one message, calling sink once per event it carries
+     * @return false if the message is not market data (replies, heartbeats) or is malformed
+     */
+    virtual bool decode(const char* data, size_t length, const EventSink& sink) = 0;
+
+    // REST origin and request for a full book of symbol; false when the venue has none
+    virtual std::string getSnapshotEndpoint() const { return ""; }
+    virtual bool buildSnapshotRequest(const Symbol&, std::string&, std::string&) const { return false; }
+    // The response as a BOOK_SNAPSHOT whose sequence is the update id it is current to
+    virtual bool decodeSnapshot(const Symbol&, const char*, size_t, VenueEvent&) const { return false; }
+
+    static std::unique_ptr<VenueCodec> create(Exchange exchange);  // nullptr for venues without one
+};
+
+/**
+ * @brief Binance combined streams: bookTicker, depth@100ms and trade per symbol
+ *
+ * Symbols go in the URL when connecting (/stream?streams=...) and through
+ * SUBSCRIBE/UNSUBSCRIBE requests afterwards. Depth diffs carry U and u as
+ * first and last update id, and pu on futures streams; books start from
+ * /api/v3/depth, current to its lastUpdateId.
+ */
+class BinanceCodec : public VenueCodec {
+public:
+    Exchange getExchange() const override { return Exchange::BINANCE; }
+    const char* getName() const override { return "Binance"; }
+    std::string getDefaultEndpoint() const override { return "wss://stream.binance.com:9443"; }
+
+    std::string buildStreamUrl(const std::string& endpoint, const std::vector<Symbol>& symbols) const override;
+    bool subscribesInUrl() const override { return true; }
+    std::string buildSubscription(const std::vector<Symbol>& symbols, bool subscribe,
+                                  uint64_t requestId) const override;
+    bool decode(const char* data, size_t length, const EventSink& sink) override;
+
+    std::string getSnapshotEndpoint() const override { return "https://api.binance.com"; }
+    bool buildSnapshotRequest(const Symbol& symbol, std::string& path, std::string& query) const override;
+    bool decodeSnapshot(const Symbol& symbol, const char* data, size_t length, VenueEvent& snapshot) const override;
+
+    static std::vector<std::string> streamNames(const Symbol& symbol);
+
+private:
+    VenueEvent event_;
+    Tick tick_;
+    BinanceDepthUpdate depth_;
+    BinanceTrade trade_;
+};
+
+/**
+ * @brief Deribit JSON-RPC v2: book, trades and ticker channels at 100ms
+ *
+ * public/subscribe with book.<instrument>.100ms, trades.<instrument>.100ms
+ * and ticker.<instrument>.100ms. Book notifications are a snapshot, then
+ * changes whose prev_change_id must equal the last change_id; levels are
+ * [action, price, amount] with action new, change or delete. After a gap
+ * the book is fetched from public/get_order_book (its change_id).
+ */
+class DeribitCodec : public VenueCodec {
+public:
+    Exchange getExchange() const override { return Exchange::DERIBIT; }
+    const char* getName() const override { return "Deribit"; }
+    std::string getDefaultEndpoint() const override { return "wss://www.deribit.com"; }
+
+    std::string buildStreamUrl(const std::string& endpoint, const std::vector<Symbol>& symbols) const override;
+    std::string buildSubscription(const std::vector<Symbol>& symbols, bool subscribe,
+                                  uint64_t requestId) const override;
+    bool decode(const char* data, size_t length, const EventSink& sink) override;
+
+    std::string getSnapshotEndpoint() const override { return "https://www.deribit.com"; }
+    bool buildSnapshotRequest(const Symbol& symbol, std::string& path, std::string& query) const override;
+    bool decodeSnapshot(const Symbol& symbol, const char* data, size_t length, VenueEvent& snapshot) const override;
+
+private:
+    VenueEvent event_;
+
+    bool decodeBook(const char* data, size_t length, const EventSink& sink);
+    bool decodeTrades(const char* data, size_t length, const EventSink& sink);
+    bool decodeTicker(const char* data, size_t length, const EventSink& sink);
+};
+
+/**
+ * @brief Coinbase Exchange feed: ticker, level2_batch and matches channels
+ *
+ * Products are subscribed by message after connecting. level2_batch
+ * sends a snapshot, then l2update changes batched every 50ms with no
+ * sequence number; ticker and match messages carry the product sequence.
+ */
+class CoinbaseCodec : public VenueCodec {
+public:
+    Exchange getExchange() const override { return Exchange::COINBASE; }
+    const char* getName() const override { return "Coinbase"; }
+    std::string getDefaultEndpoint() const override { return "wss://ws-feed.exchange.coinbase.com"; }
+
+    std::string buildStreamUrl(const std::string& endpoint, const std::vector<Symbol>& symbols) const override;
+    std::string buildSubscription(const std::vector<Symbol>& symbols, bool subscribe,
+                                  uint64_t requestId) const override;
+    bool decode(const char* data, size_t length, const EventSink& sink) override;
+
+    // "2024-01-02T03:04:05.678901Z" to a TimePoint; false if it does not parse
+    static bool parseTime(std::string_view text, TimePoint& time);
+
+private:
+    VenueEvent event_;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_VENUE_CODEC_H
@@ -0,0 +1,180 @@
+#ifndef MASTERMIND_WEBSOCKET_CLIENT_H
+#define MASTERMIND_WEBSOCKET_CLIENT_H
+
+#include "api/EventReactor.h"
+#include "api/WebSocketProtocol.h"
+#include "core/Types.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace MasterMind {
+
+struct WebSocketStats {
+    uint64_t messagesReceived;
+    uint64_t bytesReceived;      // Payload bytes
+    uint64_t framesReceived;
+    uint64_t messagesSent;
+    uint64_t pingsReceived;
+    uint64_t readCalls;          // Socket reads; bytes per read shows batching
+    double maxDispatchMicros;    // Slowest message handler
+
+    WebSocketStats() : messagesReceived(0), bytesReceived(0), framesReceived(0), messagesSent(0),
+                       pingsReceived(0), readCalls(0), maxDispatchMicros(0) {}
+};
+
+/**
+ * @brief Non-blocking RFC 6455 client driven by an EventReactor
+ *
+ * connect() resolves, connects, runs TLS (wss://, when built with OpenSSL)
+ * and the upgrade handshake, then registers the socket with the reactor
+ * given at construction, typically one shared by every venue connection
+ * (ReactorPool::shared()). Without one the client starts a private
+ * reactor, i.e. its own I/O thread. Sends are queued and flushed by a task
+ * posted to the reactor.
+ *
+ * Received bytes land in one growable buffer. Frames are decoded in place
+ * and a complete single-frame message is passed to the message handler as
+ * a pointer into that buffer - no copy; only fragmented messages are
+ * reassembled. The pointer is valid for the duration of the call. Pings
+ * are answered and a close frame is echoed before the socket is closed.
+ *
+ * Handlers run on the reactor thread (connect on the caller's) and share
+ * it with every other source on that reactor, so they must not block.
+ * send() may be called from any thread. Linux only; elsewhere connect()
+ * fails.
+ */
+class WebSocketClient {
+public:
+    using MessageHandler = std::function<void(const char* data, size_t length)>;
+    using EventHandler = std::function<void()>;
+    using ErrorHandler = std::function<void(const std::string&)>;
+
+    explicit WebSocketClient(EventReactor* reactor = nullptr);
+    ~WebSocketClient();
+
+    WebSocketClient(const WebSocketClient&) = delete;
+    WebSocketClient& operator=(const WebSocketClient&) = delete;
+
+    void setMessageHandler(MessageHandler handler) { messageHandler_ = std::move(handler); }
+    void setConnectHandler(EventHandler handler) { connectHandler_ = std::move(handler); }
+    void setDisconnectHandler(EventHandler handler) { disconnectHandler_ = std::move(handler); }
+    void setErrorHandler(ErrorHandler handler) { errorHandler_ = std::move(handler); }
+    void clearHandlers();  // Waits out a handler running on the reactor
+
+    /**
+     * @brief Connect and complete the opening handshake
+     * @param url ws://host[:port]/path or wss://host[:port]/path
+     * @return true once the connection is upgraded and registered with the reactor
+     */
+    bool connect(const std::string& url, Duration timeout = std::chrono::seconds(10));
+    void disconnect();  // Sends a close frame and leaves the reactor
+    bool isConnected() const;
+
+    bool send(const std::string& text);
+    bool ping();  // The pong, like any other traffic, moves getLastReceiveTime()
+
+    // Last time bytes arrived (or the connection opened); for liveness checks
+    std::chrono::steady_clock::time_point getLastReceiveTime() const;
+
+    WebSocketStats getStats() const;
+    std::string getLastError() const;
+    const std::string& getUrl() const { return url_; }
+    EventReactor* getReactor() const { return reactor_; }
+
+private:
+    struct Endpoint {
+        bool secure = false;
+        std::string host;
+        std::string port;
+        std::string path;
+    };
+
+    static constexpr size_t INITIAL_BUFFER_SIZE = 256 * 1024;
+    static constexpr size_t MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+
+    std::string url_;
+    int socket_;
+    int epoll_;        // Handshake waits only; the reactor owns the connected socket
+    void* ssl_;        // SSL* when the connection is secure
+    void* sslContext_;
+
+    EventReactor* reactor_;
+    std::unique_ptr<EventReactor> ownReactor_;  // When no reactor was given
+    std::atomic<bool> attached_;                // Registered with reactor_
+    std::atomic<bool> flushPosted_;
+    bool dispatching_;                          // In this client's handler (reactor thread)
+    std::atomic<bool> connected_;
+    std::atomic<bool> closeRequested_;
+
+    // Receive side (reactor thread only)
+    std::vector<char> receiveBuffer_;
+    size_t receiveStart_;
+    size_t receiveEnd_;
+    std::string fragments_;
+    WebSocketOpcode fragmentOpcode_;
+    bool inFragment_;
+
+    // Send side: producers append frames under sendMutex_, the reactor
+    // swaps them out and writes without holding it
+    std::mutex sendMutex_;
+    std::string pendingSend_;
+    std::string writing_;
+    size_t writeOffset_;
+    std::mt19937 maskGenerator_;   // Guarded by sendMutex_
+    bool writeInterest_;
+
+    mutable std::mutex errorMutex_;
+    std::string lastError_;
+
+    // Statistics (written by the reactor thread)
+    std::atomic<uint64_t> messagesReceived_;
+    std::atomic<uint64_t> bytesReceived_;
+    std::atomic<uint64_t> framesReceived_;
+    std::atomic<uint64_t> messagesSent_;
+    std::atomic<uint64_t> pingsReceived_;
+    std::atomic<uint64_t> readCalls_;
+    std::atomic<double> maxDispatchMicros_;
+    std::atomic<int64_t> lastReceiveTicks_;     // steady_clock ticks
+
+    MessageHandler messageHandler_;
+    EventHandler connectHandler_;
+    EventHandler disconnectHandler_;
+    ErrorHandler errorHandler_;
+
+    static bool parseUrl(const std::string& url, Endpoint& endpoint);
+    bool openSocket(const Endpoint& endpoint, TimePoint deadline);
+    bool startTls(const Endpoint& endpoint, TimePoint deadline);
+    bool performHandshake(const Endpoint& endpoint, TimePoint deadline);
+    bool waitFor(bool writable, TimePoint deadline);
+    void closeSocket();
+
+    void onSocketEvent(uint32_t events);
+    void finishIo(bool open);
+    void detach(bool sendClose);
+    bool readAvailable();
+    bool processFrames();
+    bool handleFrame(const WebSocketFrameHeader& header, char* payload, size_t length);
+    void dispatchMessage(const char* data, size_t length);
+    void makeRoom(size_t frameLength);
+    bool flushWrites();
+    void queueFrame(WebSocketOpcode opcode, const char* payload, size_t length);
+    void updateWriteInterest(bool enable);
+    void scheduleFlush();
+
+    long readSome(char* buffer, size_t length);         // >0 bytes, 0 would block, <0 closed/error
+    long writeSome(const char* buffer, size_t length);  // >=0 bytes, <0 error
+
+    void setError(const std::string& error);
+    void dispatchDisconnect();
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_WEBSOCKET_CLIENT_H
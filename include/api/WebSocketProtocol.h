@@ -0,0 +1,69 @@
+#ifndef MASTERMIND_WEBSOCKET_PROTOCOL_H
+#define MASTERMIND_WEBSOCKET_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MasterMind {
+
+enum class WebSocketOpcode : uint8_t {
+    CONTINUATION = 0x0,
+    TEXT = 0x1,
+    BINARY = 0x2,
+    CLOSE = 0x8,
+    PING = 0x9,
+    PONG = 0xA
+};
+
+struct WebSocketFrameHeader {
+    bool fin;
+    WebSocketOpcode opcode;
+    bool masked;
+    uint8_t mask[4];
+    uint64_t payloadLength;
+    size_t headerLength;
+
+    WebSocketFrameHeader() : fin(false), opcode(WebSocketOpcode::CONTINUATION), masked(false),
+                             mask{0, 0, 0, 0}, payloadLength(0), headerLength(0) {}
+};
+
+/**
+ * @brief RFC 6455 framing and handshake helpers shared by client and server
+ *
+ * Frames are decoded straight out of the receive buffer: parseHeader reads
+ * the header in place, and masked payloads are unmasked in place, eight
+ * bytes at a time, so a message can be handed on without being copied.
+ */
+class WebSocketProtocol {
+public:
+    static constexpr size_t MAX_HEADER_SIZE = 14;
+    static constexpr size_t MAX_CONTROL_PAYLOAD = 125;
+
+    /**
+     * @brief Decode a frame header
+     * @return Header length, 0 if more bytes are needed, -1 if malformed
+     */
+    static int parseHeader(const char* data, size_t length, WebSocketFrameHeader& header);
+
+    static void unmask(char* payload, size_t length, const uint8_t mask[4]);
+
+    // Append one complete frame; a null mask sends it unmasked (server side)
+    static void appendFrame(std::string& out, WebSocketOpcode opcode, const char* payload, size_t length,
+                            const uint8_t* mask = nullptr);
+
+    // Opening handshake
+    static std::string generateKey();
+    static std::string computeAccept(const std::string& key);
+    static std::string base64Encode(const unsigned char* data, size_t length);
+
+    /**
+     * @brief Case-insensitive header lookup in a raw HTTP head
+     * @return Trimmed value, empty if absent
+     */
+    static std::string findHeader(const std::string& head, const std::string& name);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_WEBSOCKET_PROTOCOL_H
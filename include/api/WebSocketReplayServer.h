@@ -0,0 +1,129 @@
+#ifndef MASTERMIND_WEBSOCKET_REPLAY_SERVER_H
+#define MASTERMIND_WEBSOCKET_REPLAY_SERVER_H
+
+#include "core/Types.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MasterMind {
+
+struct ReplayConfig {
+    uint16_t port;              // 0 picks a free port
+    double messagesPerSecond;   // Per client; 0 sends as fast as the socket drains
+    size_t loops;               // Passes over the capture per client
+    bool closeWhenDone;         // Send a close frame after the last pass
+    bool recordSendTimes;       // Keep a send timestamp per message (first client)
+
+    ReplayConfig() : port(0), messagesPerSecond(0), loops(1), closeWhenDone(false), recordSendTimes(false) {}
+};
+
+/**
+ * @brief Loopback WebSocket server that replays captured exchange frames
+ *
+ * Serves a capture (one message per line) to every client that completes
+ * the upgrade, so feed handlers can be exercised for throughput and
+ * latency without a network. Messages are framed once at load time into a
+ * single buffer and written from it directly; pacing is per client on a
+ * 1ms tick. Text frames sent by clients (e.g. SUBSCRIBE requests) are
+ * kept for inspection, pings are answered and close frames echoed.
+ *
+ * Binds 127.0.0.1 only. Runs on its own epoll thread; Linux only,
+ * elsewhere start() fails.
+ */
+class WebSocketReplayServer {
+public:
+    using SteadyTime = std::chrono::steady_clock::time_point;
+
+    explicit WebSocketReplayServer(const ReplayConfig& config = ReplayConfig());
+    ~WebSocketReplayServer();
+
+    WebSocketReplayServer(const WebSocketReplayServer&) = delete;
+    WebSocketReplayServer& operator=(const WebSocketReplayServer&) = delete;
+
+    /**
+     * @brief Load a capture file; blank lines and lines starting with '#' are skipped
+     * @return false if the file cannot be read or holds no messages
+     */
+    bool loadCapture(const std::string& path);
+    void setMessages(const std::vector<std::string>& messages);
+    size_t getMessageCount() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_; }
+
+    uint16_t getPort() const { return port_; }
+    std::string getUrl(const std::string& path = "/") const;
+
+    // Progress
+    uint64_t getMessagesSent() const { return messagesSent_.load(std::memory_order_relaxed); }
+    size_t getClientCount() const { return clientCount_.load(std::memory_order_relaxed); }
+    bool waitForClients(size_t count, Duration timeout) const;
+    bool waitForMessagesSent(uint64_t count, Duration timeout) const;
+
+    // What clients sent: upgrade request paths and text frames
+    std::vector<std::string> getRequestPaths() const;
+    std::vector<std::string> getReceivedMessages() const;
+
+    // Send time of each message to the first client, when recordSendTimes is set
+    std::vector<SteadyTime> getSendTimes() const;
+
+    std::string getLastError() const;
+
+private:
+    struct Session {
+        int socket = -1;
+        bool upgraded = false;
+        bool closing = false;       // Close frame queued
+        bool peerClosed = false;    // Drop once the control queue is written
+        bool recordTimes = false;
+        std::string input;
+        std::string control;        // Handshake response and control frames
+        size_t controlOffset = 0;
+        uint64_t nextMessage = 0;   // Across loops
+        size_t partial = 0;         // Bytes of the next message already written
+        SteadyTime startTime;
+    };
+
+    ReplayConfig config_;
+    std::string frames_;             // All messages, framed, back to back
+    std::vector<size_t> offsets_;    // Frame boundaries in frames_
+
+    int listenSocket_;
+    int epoll_;
+    int wake_;
+    uint16_t port_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::vector<Session> sessions_;  // Server thread only
+
+    std::atomic<uint64_t> messagesSent_;
+    std::atomic<size_t> clientCount_;
+
+    mutable std::mutex recordMutex_;
+    std::vector<std::string> requestPaths_;
+    std::vector<std::string> receivedMessages_;
+    std::vector<SteadyTime> sendTimes_;
+    bool timesClaimed_;              // First upgraded client records times
+    std::string lastError_;
+
+    void serverLoop();
+    void acceptClients();
+    bool readClient(Session& session);
+    bool handleHandshake(Session& session);
+    bool handleClientFrames(Session& session);
+    bool writeClient(Session& session, SteadyTime now);
+    uint64_t dueMessages(const Session& session, SteadyTime now) const;
+    bool hasPacedWork() const;
+    void closeSession(Session& session);
+    void setError(const std::string& error);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_WEBSOCKET_REPLAY_SERVER_H
@@ -131,8 +131,10 @@ public:
         bool enablePaperTrading = false;
         bool autoStart = false;
         Duration heartbeatInterval = std::chrono::seconds(30);
-        Duration reconnectInterval = std::chrono::seconds(60);
-        int maxReconnectAttempts = 5;
+        Duration reconnectInterval = std::chrono::seconds(60);  // Longest wait between reconnect attempts
+        int maxReconnectAttempts = 5;  // Outage of this many reconnectIntervals is reported given up
+        bool hotStandbyStreams = false;  // Second market data connection per venue for failover
+        Duration orderTimeout = Duration::zero();  // Working orders cancelled after this long (0 = never)
         bool enableWebInterface = false;
         int webPort = 8080;
     };
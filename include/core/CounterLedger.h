@@ -0,0 +1,140 @@
+#ifndef MASTERMIND_COUNTER_LEDGER_H
+#define MASTERMIND_COUNTER_LEDGER_H
+
+#include "Types.h"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace MasterMind {
+
+enum class LedgerEventType : uint8_t {
+    COUNTER_STARTED = 1,  // count = counter number, value = initial capital
+    ORDER_ADDED,          // reference = order id
+    COUNTER_PNL,          // value = P&L, value2 = charges
+    COUNTER_COMPLETED,
+    TRADE_RECORDED,       // count = 1 if profitable
+    MODE_CHANGED,         // count = 1 for paper mode
+    DAILY_RESET,          // value = new daily start balance; daily risk used cleared
+    STREAK_RESET,         // Consecutive win/loss counts cleared
+    RISK_USED             // value = stop-loss risk opened by a fill, reference = order id
+};
+
+struct LedgerEvent {
+    LedgerEventType type;
+    uint64_t sequence;     // Assigned by the ledger on append
+    TimePoint timestamp;
+    int64_t count;
+    double value;
+    double value2;
+    std::string reference;
+
+    LedgerEvent() : type(LedgerEventType::COUNTER_STARTED), sequence(0), count(0), value(0), value2(0) {}
+    LedgerEvent(LedgerEventType eventType, TimePoint time)
+        : type(eventType), sequence(0), timestamp(time), count(0), value(0), value2(0) {}
+};
+
+struct CounterRecord {
+    int counterNumber;
+    int ordersCount;
+    std::vector<OrderId> orderIds;
+    double initialCapital;
+    double currentCapital;
+    double totalPnL;
+    double totalCharges;
+    TimePoint startTime;
+    TimePoint endTime;
+    bool isComplete;
+
+    CounterRecord() : counterNumber(0), ordersCount(0), initialCapital(0),
+                      currentCapital(0), totalPnL(0), totalCharges(0),
+                      isComplete(false) {}
+};
+
+/**
+ * @brief Complete counter, consecutive-loss and daily state at one sequence
+ */
+struct LedgerSnapshot {
+    uint64_t sequence;  // Last event folded into this state
+    CounterRecord currentCounter;
+    std::vector<CounterRecord> completedCounters;  // Most recent, bounded
+    int completedCount;
+    int consecutiveLosses;
+    int consecutiveWins;
+    int maxConsecutiveLosses;
+    double totalTrades;
+    double profitableTrades;
+    bool paperMode;
+    double dailyStartBalance;
+    double dailyPnL;
+    double dailyRiskUsed;
+    TimePoint lastDailyReset;
+
+    LedgerSnapshot() : sequence(0), completedCount(0), consecutiveLosses(0), consecutiveWins(0),
+                       maxConsecutiveLosses(0), totalTrades(0), profitableTrades(0),
+                       paperMode(false), dailyStartBalance(0), dailyPnL(0), dailyRiskUsed(0) {}
+};
+
+/**
+ * @brief Append-only, checksummed log of counter events with compact snapshots
+ *
+ * counters.log holds length-prefixed records, each with a CRC-32 of its
+ * payload; counters.snap holds the latest snapshot, replaced atomically by
+ * write-then-rename (file and directory fsynced before the log is
+ * truncated). Recovery loads the snapshot and replays only the events
+ * logged after it; a torn or corrupt record ends the log and is cut off.
+ * Every append is fsynced before it returns, so an acknowledged event
+ * survives a process or host crash; a failed append closes the ledger until
+ * it is opened again.
+ *
+ * Encoding is native-endian: files are only read back on the same host.
+ * Not thread-safe - the owner serializes access.
+ */
+class CounterLedger {
+public:
+    using SnapshotHandler = std::function<void(const LedgerSnapshot&)>;
+    using EventHandler = std::function<void(const LedgerEvent&)>;
+
+    explicit CounterLedger(size_t snapshotInterval = 4096);
+    ~CounterLedger();
+
+    CounterLedger(const CounterLedger&) = delete;
+    CounterLedger& operator=(const CounterLedger&) = delete;
+
+    /**
+     * @brief Open the ledger in a directory and replay its state
+     * @return false if the directory's files cannot be opened or written
+     */
+    bool open(const std::string& directory, SnapshotHandler onSnapshot, EventHandler onEvent);
+    void close();
+    bool isOpen() const;
+
+    bool append(LedgerEvent& event);  // Assigns event.sequence
+    bool writeSnapshot(const LedgerSnapshot& snapshot);
+    bool isSnapshotDue() const;
+
+    uint64_t getSequence() const;
+    size_t getEventsSinceSnapshot() const;
+    size_t getReplayedCount() const;
+    double getRecoveryMillis() const;
+
+private:
+    size_t snapshotInterval_;
+    std::string logPath_;
+    std::string snapshotPath_;
+    std::FILE* log_;
+    uint64_t sequence_;
+    size_t eventsSinceSnapshot_;
+    size_t replayed_;
+    double recoveryMillis_;
+    std::string buffer_;  // Encode scratch
+
+    bool loadSnapshot(LedgerSnapshot& snapshot) const;
+    long replayLog(uint64_t afterSequence, const EventHandler& onEvent);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_COUNTER_LEDGER_H
@@ -0,0 +1,91 @@
+#ifndef MASTERMIND_COVARIANCE_MATRIX_H
+#define MASTERMIND_COVARIANCE_MATRIX_H
+
+#include "Types.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace MasterMind {
+
+/**
+ * @brief Exponentially weighted covariance of per-symbol bar returns
+ *
+ * Each bar applies the RiskMetrics rank-1 update
+ *     S = lambda * S + (1 - lambda) * r * r^T
+ * in O(n^2), with zero-mean returns. The matrix is stored dense and
+ * row-major in one buffer with rows padded to a multiple of 8 doubles, so
+ * both the update and the portfolio variance w^T S w run as contiguous
+ * multiply-add loops the compiler can vectorize.
+ *
+ * Returns are sampled on a common time grid of sampleInterval: each bar
+ * time is rounded to the nearest grid point, so bars of the same period
+ * land in one sample despite per-symbol timestamp skew, and the first close
+ * in a later grid slot commits the staged sample. A symbol without a close
+ * in a slot has its last close carried forward (a flat period, not a
+ * missing one); symbols with no close yet stay out until their first.
+ */
+class CovarianceMatrix {
+public:
+    explicit CovarianceMatrix(double lambda = 0.94, Duration sampleInterval = std::chrono::minutes(1));
+
+    CovarianceMatrix(const CovarianceMatrix&) = delete;
+    CovarianceMatrix& operator=(const CovarianceMatrix&) = delete;
+
+    // Symbols
+    size_t addSymbol(const Symbol& symbol);
+    bool hasSymbol(const Symbol& symbol) const;
+    std::vector<Symbol> getSymbols() const;  // Index order
+    size_t size() const;
+
+    // Updates
+    void onBar(const Symbol& symbol, Price close, TimePoint barTime);
+    bool commitBar();                         // Apply the staged bar now
+    void update(const std::vector<double>& returns);  // Index order, one bar
+    void reset();
+
+    // Queries
+    double getCovariance(const Symbol& a, const Symbol& b) const;
+    double getCorrelation(const Symbol& a, const Symbol& b) const;
+    double getVolatility(const Symbol& symbol) const;   // Per bar
+    double portfolioVariance(const std::vector<double>& weights) const;  // Index order
+    double portfolioVariance(const std::unordered_map<Symbol, double>& weights) const;
+    double undiversifiedVariance(const std::unordered_map<Symbol, double>& weights) const;  // Correlations ignored
+    double covarianceWithPortfolio(const Symbol& symbol, const std::unordered_map<Symbol, double>& weights) const;
+    uint64_t getUpdateCount() const;
+    double getLambda() const;
+    Duration getSampleInterval() const;
+
+private:
+    static constexpr size_t ROW_ALIGN = 8;
+
+    double lambda_;
+    Duration sampleInterval_;
+    size_t size_;
+    size_t stride_;                 // Padded row length
+    std::vector<double> matrix_;    // size_ x stride_, row-major, symmetric
+    std::vector<Symbol> symbols_;
+    std::unordered_map<Symbol, size_t> indices_;
+
+    // Bar alignment
+    std::vector<double> lastClose_;    // Close of the last committed bar
+    std::vector<double> stagedClose_;  // Close in the slot being collected, 0 if none
+    int64_t stagedSlot_;               // Grid slot being collected
+    bool staged_;
+
+    std::vector<double> returns_;   // Scratch, index order
+    uint64_t updates_;
+    mutable std::mutex matrixMutex_;
+
+    // Private methods (caller holds matrixMutex_)
+    size_t addSymbolLocked(const Symbol& symbol);
+    int64_t gridSlot(TimePoint barTime) const;
+    void applyUpdate(const double* returns);
+    bool commitLocked();
+    double quadraticForm(const double* weights) const;
+    void denseWeights(const std::unordered_map<Symbol, double>& weights, std::vector<double>& dense) const;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_COVARIANCE_MATRIX_H
@@ -1,13 +1,136 @@
 #pragma once
 
 #include "Types.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 #include <mutex>
 
+struct sqlite3;
+struct sqlite3_stmt;
+
 namespace MasterMind {
 
+/**
+ * @brief One deferred write, as queued by PersistenceQueue
+ *
+ * Plain data, so filling a ring slot copies bytes and normally never
+ * allocates: strings sit in fixed buffers, enums in bytes and times in
+ * clock ticks. The writer thread rebuilds the Order or Position when it
+ * applies the record. A string too long for its buffer is never cut: the
+ * whole record is also copied to the heap (overflow), which the writer
+ * uses instead and then releases.
+ */
+struct PersistenceRecord {
+    enum class Kind : uint8_t {
+        ORDER,            // Insert or replace
+        ORDER_UPDATE,
+        POSITION,         // Insert or replace
+        POSITION_UPDATE,
+        TRADE_RESULT,     // key = order id, text = strategy, value = P&L
+        RISK_EVENT,       // key = event, text = details
+        COUNTER_RESULT,   // number = counter, count = orders, value = P&L
+        AUDIT_ENTRY       // key = action, text = details, user = user id
+    };
+    
+    template <size_t N>
+    struct Text {
+        char data[N];
+        
+        // False when the value did not fit and was cut
+        bool assign(const std::string& value) {
+            size_t length = std::min(value.size(), N - 1);
+            std::memcpy(data, value.data(), length);
+            data[length] = '\0';
+            return length == value.size();
+        }
+        std::string str() const { return std::string(data); }
+    };
+    using IdText = Text<64>;       // Order, strategy and user ids; event and action names
+    using SymbolText = Text<24>;   // Symbols and exchange ids
+    using DetailText = Text<192>;  // Risk event and audit details
+    
+    struct OrderFields {
+        IdText orderId;
+        SymbolText symbol;
+        SymbolText exchange;
+        IdText strategyId;
+        uint8_t type;
+        uint8_t side;
+        uint8_t status;
+        int32_t tickOffset;
+        Price price;
+        Volume quantity;
+        Volume filledQuantity;
+        Price stopLoss;
+        Price takeProfit;
+        Price triggerPrice;
+        Volume visibleQuantity;
+        TimePoint::rep createTime;
+        TimePoint::rep updateTime;
+    };
+    
+    struct PositionFields {
+        SymbolText symbol;
+        SymbolText exchange;
+        uint8_t side;
+        Volume quantity;
+        Price averagePrice;
+        Price currentPrice;
+        Price unrealizedPnL;
+        Price realizedPnL;
+        TimePoint::rep openTime;
+        TimePoint::rep updateTime;
+    };
+    
+    struct EventFields {
+        IdText key;
+        IdText user;
+        DetailText text;
+        double value;
+        int32_t number;
+        int32_t count;
+    };
+    
+    // Full copy of a record whose text did not fit the buffers above
+    struct Overflow {
+        Order order;
+        Position position;
+        std::string key;
+        std::string text;
+        std::string user;
+    };
+    
+    Kind kind;
+    TimePoint time;       // When the caller enqueued it
+    Overflow* overflow;   // Owned by the record's consumer; see releaseOverflow()
+    union {
+        OrderFields order;        // ORDER, ORDER_UPDATE
+        PositionFields position;  // POSITION, POSITION_UPDATE
+        EventFields event;        // Everything else
+    };
+    
+    PersistenceRecord() : kind(Kind::ORDER), overflow(nullptr) {}
+    
+    // Each allocates an overflow copy when some text does not fit
+    void setOrder(Kind recordKind, const Order& value);
+    void setPosition(Kind recordKind, const Position& value);
+    void setEvent(Kind recordKind, const std::string& key, const std::string& text,
+                  const std::string& user = std::string(), double value = 0, int number = 0, int count = 0);
+    void releaseOverflow();
+    
+    // Writer thread
+    Order toOrder() const;
+    Position toPosition() const;
+    std::string eventKey() const;
+    std::string eventText() const;
+    std::string eventUser() const;
+};
+
 /**
  * @brief Database management system for Master Mind trading system
  * 
@@ -16,6 +139,11 @@ namespace MasterMind {
  * - Configuration backups
  * - Performance statistics
  * - Risk management records
+ *
+ * Backed by an embedded SQLite database (the connection string is the file
+ * path, or ":memory:") in WAL mode. Every query type has one prepared
+ * statement, compiled on first use and reused afterwards; wrap bulk inserts
+ * in beginTransaction()/commitTransaction() to batch their commits.
  */
 class DatabaseManager {
 public:
@@ -91,6 +219,12 @@ public:
     bool commitTransaction();
     bool rollbackTransaction();
     
+    /**
+     * @brief Apply queued records in one transaction under a single lock
+     * @return Number of records written; failed records are skipped
+     */
+    size_t writeBatch(const PersistenceRecord* records, size_t count);
+    
     // Error handling
     std::string getLastError() const;
     bool hasError() const;
@@ -100,13 +234,47 @@ private:
     // Database connection
     std::string connectionString_;
     bool connected_;
-    std::string lastError_;
+    mutable std::string lastError_;
     
     // Thread safety
     mutable std::mutex dbMutex_;
     
     // Internal implementation details
-    void* dbHandle_; // SQLite database handle
+    enum class Statement {
+        INSERT_ORDER, UPDATE_ORDER, DELETE_ORDER, GET_ORDER,
+        ORDER_HISTORY, ORDER_HISTORY_BY_SYMBOL, ORDER_COUNT, ORDER_COUNT_BY_SYMBOL,
+        INSERT_POSITION, UPDATE_POSITION, GET_POSITIONS, GET_POSITIONS_BY_SYMBOL,
+        INSERT_TRADE_RESULT, UPDATE_PERFORMANCE, GET_PERFORMANCE,
+        TOTAL_PNL, TOTAL_PNL_BY_SYMBOL, TRADE_COUNT, WIN_RATE,
+        INSERT_RISK_EVENT, INSERT_COUNTER_RESULT, GET_RISK_EVENTS,
+        INSERT_CONFIG, LATEST_CONFIG, CONFIG_HISTORY,
+        INSERT_AUDIT, GET_AUDIT_TRAIL,
+        BEGIN, COMMIT, ROLLBACK,
+        COUNT
+    };
+    
+    sqlite3* dbHandle_;
+    mutable std::array<sqlite3_stmt*, static_cast<size_t>(Statement::COUNT)> statements_;
+    
+    // Statement cache (caller holds dbMutex_)
+    sqlite3_stmt* statement(Statement id) const;  // Reset and ready to bind, nullptr on error
+    bool execute(sqlite3_stmt* stmt) const;        // Steps to completion
+    void finalizeStatements();
+    bool connectLocked();
+    void disconnectLocked();
+    bool createTablesLocked();
+    bool applyRecord(const PersistenceRecord& record);
+    
+    // Writes (caller holds dbMutex_)
+    bool insertOrderLocked(const Order& order);
+    bool updateOrderLocked(const Order& order);
+    bool insertPositionLocked(const Position& position);
+    bool updatePositionLocked(const Position& position);
+    bool insertTradeResultLocked(const OrderId& orderId, double pnl, const std::string& strategy, TimePoint time);
+    bool insertRiskEventLocked(const std::string& event, const std::string& details, TimePoint time);
+    bool insertCounterResultLocked(int counterNumber, double pnl, int orderCount, TimePoint time);
+    bool insertAuditEntryLocked(const std::string& action, const std::string& details,
+                                const std::string& userId, TimePoint time);
     
     // Schema creation helpers
     bool createOrdersTable();
@@ -129,7 +297,7 @@ private:
     // Utility methods
     std::string getCurrentTimestamp() const;
     bool tableExists(const std::string& tableName) const;
-    void logError(const std::string& error);
+    void logError(const std::string& error) const;
 };
 
 } // namespace MasterMind 
\ No newline at end of file
@@ -0,0 +1,109 @@
+#ifndef MASTERMIND_EXPOSURE_TRACKER_H
+#define MASTERMIND_EXPOSURE_TRACKER_H
+
+#include "Types.h"
+#include "PreTradeRiskCheck.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace MasterMind {
+
+struct SymbolExposure {
+    Volume position;        // Signed: positive long, negative short
+    Price averagePrice;
+    Price markPrice;
+    double exposure;        // |position| * mark
+    double unrealizedPnL;
+    double realizedPnL;
+    double margin;
+
+    SymbolExposure() : position(0), averagePrice(0), markPrice(0), exposure(0),
+                       unrealizedPnL(0), realizedPnL(0), margin(0) {}
+};
+
+struct PortfolioExposure {
+    double grossExposure;   // Sum of |position| * mark
+    double netExposure;     // Sum of position * mark
+    double unrealizedPnL;
+    double realizedPnL;
+    double margin;
+    size_t openPositions;
+
+    PortfolioExposure() : grossExposure(0), netExposure(0), unrealizedPnL(0),
+                          realizedPnL(0), margin(0), openPositions(0) {}
+};
+
+/**
+ * @brief Running per-symbol and portfolio exposure, P&L and margin
+ *
+ * Fills and mark-to-market prices update one symbol's state and apply the
+ * change in its contribution to the portfolio totals, so every update is O(1)
+ * regardless of how many positions are open. Writers are serialized; readers
+ * (GUI, risk checks) take consistent snapshots through per-symbol and portfolio
+ * sequence locks without blocking the writers.
+ */
+class ExposureTracker {
+public:
+    explicit ExposureTracker(double marginRate = 1.0);
+
+    ExposureTracker(const ExposureTracker&) = delete;
+    ExposureTracker& operator=(const ExposureTracker&) = delete;
+
+    // Updates
+    void onFill(const Symbol& symbol, OrderSide side, Volume quantity, Price price);
+    void onMark(const Symbol& symbol, Price price);
+    void setPosition(const Symbol& symbol, Volume signedQuantity, Price averagePrice, Price markPrice);
+    void setMarginRate(double marginRate);
+    void setMarginRate(const Symbol& symbol, double marginRate);
+    void reset();
+
+    // Lock-free snapshots
+    SymbolExposure getSymbolExposure(const Symbol& symbol) const;
+    Volume getPosition(const Symbol& symbol) const;  // One load; the pre-trade check's position source
+    PortfolioExposure getPortfolioExposure() const;
+
+private:
+    struct alignas(64) SymbolState {
+        std::atomic<uint32_t> sequence;
+        std::atomic<double> position;
+        std::atomic<double> averagePrice;
+        std::atomic<double> markPrice;
+        std::atomic<double> realizedPnL;
+        std::atomic<double> marginRate;  // <= 0 uses the portfolio rate
+    };
+
+    struct Contribution {
+        double gross = 0;
+        double net = 0;
+        double unrealized = 0;
+        double margin = 0;
+        bool open = false;
+    };
+
+    SymbolRegistry registry_;
+    std::unique_ptr<SymbolState[]> states_;  // Indexed by registry slot
+
+    // Portfolio totals, guarded by totalsSequence_
+    alignas(64) std::atomic<uint32_t> totalsSequence_;
+    std::atomic<double> grossExposure_;
+    std::atomic<double> netExposure_;
+    std::atomic<double> unrealizedPnL_;
+    std::atomic<double> realizedPnL_;
+    std::atomic<double> margin_;
+    std::atomic<size_t> openPositions_;
+
+    std::atomic<double> marginRate_;
+    std::mutex writeMutex_;
+
+    // Private methods (caller holds writeMutex_)
+    SymbolState* stateFor(const Symbol& symbol);
+    Contribution contribution(const SymbolState& state) const;
+    void publish(SymbolState& state, double position, double averagePrice, double markPrice,
+                 double realizedDelta, double marginRate);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_EXPOSURE_TRACKER_H
@@ -0,0 +1,69 @@
+#ifndef MASTERMIND_MONTE_CARLO_RISK_SIMULATOR_H
+#define MASTERMIND_MONTE_CARLO_RISK_SIMULATOR_H
+
+#include "Types.h"
+#include <cstdint>
+#include <vector>
+
+namespace MasterMind {
+
+struct MonteCarloConfig {
+    uint64_t paths;         // Simulated trading histories
+    int counters;           // Horizon in counters of ordersPerCounter trades
+    int threads;            // 0 = hardware concurrency
+    double ruinDrawdown;    // Drawdown from the starting equity that counts as ruin
+    int liveAfterWins;      // Consecutive paper wins before returning to live
+    uint64_t seed;
+
+    MonteCarloConfig() : paths(1000000), counters(10), threads(0), ruinDrawdown(0.5),
+                         liveAfterWins(3), seed(42) {}
+};
+
+struct MonteCarloResult {
+    uint64_t paths;
+    double ruinProbability;
+    std::vector<double> ruinProbabilityByCounter;  // Cumulative, one entry per counter
+    double meanMaxDrawdown;
+    std::vector<double> maxDrawdownPercentiles;    // Index p = p-th percentile, 0..100
+    double meanFinalEquity;                        // Relative to a starting equity of 1
+    std::vector<double> finalEquityPercentiles;
+    std::vector<double> counterReturnPercentiles;  // Return of one counter
+    double paperTradeFraction;
+    double elapsedSeconds;
+
+    MonteCarloResult() : paths(0), ruinProbability(0), meanMaxDrawdown(0), meanFinalEquity(0),
+                         paperTradeFraction(0), elapsedSeconds(0) {}
+};
+
+/**
+ * @brief Monte Carlo simulation of the counter and paper-trading rules
+ *
+ * Bootstraps historical trade results (R-multiples: P&L over the amount
+ * risked) into paths that follow RiskManager's rules: each trade risks
+ * dailyRiskPercent of equity, trades are grouped into counters of
+ * ordersPerCounter, consecutiveLossLimit losses switch to paper mode (paper
+ * trades leave equity untouched) and liveAfterWins paper wins switch back.
+ *
+ * Paths run in fixed-width lane batches with branchless updates over
+ * structure-of-arrays state so the per-trade arithmetic vectorizes. Each
+ * worker thread owns an independent RNG stream and its own accumulators;
+ * results are deterministic for a given seed and thread count.
+ */
+class MonteCarloRiskSimulator {
+public:
+    explicit MonteCarloRiskSimulator(const RiskParameters& params = RiskParameters());
+
+    void setRiskParameters(const RiskParameters& params);
+    void setTradeResults(const std::vector<double>& rMultiples);
+    size_t getTradeResultCount() const;
+
+    MonteCarloResult run(const MonteCarloConfig& config) const;
+
+private:
+    RiskParameters params_;
+    std::vector<double> tradeResults_;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_MONTE_CARLO_RISK_SIMULATOR_H
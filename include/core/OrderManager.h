@@ -2,10 +2,14 @@
 #define MASTERMIND_ORDER_MANAGER_H
 
 #include "Types.h"
+#include "TimerWheel.h"
+#include "StopEngine.h"
 #include "api/ExchangeAPI.h"
+#include <array>
 #include <memory>
 #include <vector>
 #include <queue>
+#include <unordered_set>
 #include <atomic>
 #include <mutex>
 #include <thread>
@@ -15,6 +19,42 @@ namespace MasterMind {
 
 // Forward declarations
 class Logger;
+class SmartOrderRouter;
+class ExecutionStrategy;
+class VolumeProfileCache;
+
+/**
+ * @brief One child order of a scheduled parent order
+ */
+struct ExecutionSlice {
+    Duration offset;   // From the start of the schedule
+    Volume quantity;
+
+    ExecutionSlice() : offset(Duration::zero()), quantity(0) {}
+    ExecutionSlice(Duration o, Volume q) : offset(o), quantity(q) {}
+};
+
+/**
+ * @brief Progress of a parent order worked by an execution strategy
+ */
+struct ExecutionProgress {
+    OrderId parentOrderId;
+    Symbol symbol;
+    std::string strategy;
+    Volume targetQuantity = 0;
+    Volume sentQuantity = 0;     // Cumulative, including re-sent remainders
+    Volume filledQuantity = 0;
+    Price arrivalPrice = 0;      // Mid (or limit) when the schedule started
+    Price averageFillPrice = 0;
+    double slippage = 0;         // vs arrival price, positive = worse
+    int slicesPlanned = 0;
+    int slicesSent = 0;
+    TimePoint startTime;
+    TimePoint scheduledEndTime;
+    bool complete = false;
+
+    double getCompletion() const { return targetQuantity > 0 ? filledQuantity / targetQuantity : 0.0; }
+};
 
 /**
  * @brief Advanced order management system for Master Mind strategy
@@ -54,39 +94,60 @@ public:
                             Volume icebergQuantity,
                             Price pegOffset);
     
+    // Local stops rest in the stop engine and are sent when a tick crosses
+    // them: MARKET orders exit at market, LIMIT orders exit with a limit
+    // tickBuffer ticks beyond the trigger. Trailing stops start from order.price.
     OrderId submitStopOrder(const Order& order,
                           Price triggerPrice,
                           int tickBuffer = 2);
     
     OrderId submitTrailingStop(const Order& order,
                              Price trailAmount,
-                             bool usePercent = false);
+                             bool usePercent = false);  // usePercent: trailAmount in percent
     
     // Order status and tracking
     Order getOrder(const OrderId& orderId) const;
     std::vector<Order> getActiveOrders() const;
     std::vector<Order> getOrderHistory(const Symbol& symbol = "") const;
     OrderStatus getOrderStatus(const OrderId& orderId) const;
+    Price getStopLevel(const OrderId& orderId) const;  // Current level of a resting stop, 0 if none
     
     // Position-based order management
     bool setStopLoss(const Symbol& symbol, Price stopPrice);
     bool setTakeProfit(const Symbol& symbol, Price targetPrice);
-    bool updateTrailingStop(const Symbol& symbol, Price newTrailPrice);
+    bool updateTrailingStop(const Symbol& symbol, Price newTrailPrice);  // Trails the position stop by newTrailPrice
     
     // Exchange routing
     void addExchange(Exchange exchange, std::unique_ptr<ExchangeAPI> api);
+    ExchangeAPI* getExchange(Exchange exchange) const;
     Exchange getBestExchange(const Symbol& symbol, OrderSide side, Volume quantity) const;
     bool routeOrder(Order& order);
     
-    // Order execution strategies
+    // Order execution strategies ("TWAP", "VWAP", "MinSlippage"; empty routes immediately)
     void setExecutionStrategy(const Symbol& symbol, const std::string& strategy);
+    void setExecutionStrategy(const Symbol& symbol, std::shared_ptr<ExecutionStrategy> strategy);
+    std::shared_ptr<VolumeProfileCache> getVolumeProfileCache() const;
+    bool refreshVolumeProfile(const Symbol& symbol);  // Blocking: fetches bars from a venue
+    ExecutionProgress getExecutionProgress(const OrderId& parentOrderId) const;
+    std::vector<ExecutionProgress> getActiveExecutions() const;
     void enableSmartRouting(bool enable);
     void setSlippageThreshold(double maxSlippagePercent);
+    void setMaxSplitSlices(int maxSlices);  // 1 disables cross-venue splitting
+    SmartOrderRouter* getSmartRouter() const;
+    
+    // Order expiry (uses the shared timer wheel when one is attached)
+    void setTimerWheel(TimerWheel* timerWheel);
+    void setOrderTimeout(Duration timeout);  // 0 disables expiry
+    
+    // Hybrid order re-pegging (at most one amend per child per interval)
+    void setMinRepegInterval(Duration interval);
     
     // Real-time updates
+    void onTick(const Tick& tick);
     void onOrderUpdate(const Order& order);
     void onFillUpdate(const OrderId& orderId, Volume fillQuantity, Price fillPrice);
     void onOrderRejected(const OrderId& orderId, const std::string& reason);
+    void onOrderBookUpdate(Exchange exchange, const Symbol& symbol);
     
     // Risk integration
     void setRiskValidationCallback(std::function<bool(const Order&)> callback);
@@ -95,6 +156,7 @@ public:
     // Callbacks and events
     void setOrderCallback(OrderCallback callback);
     void setFillCallback(std::function<void(const OrderId&, Volume, Price)> callback);
+    void setTradeCallback(std::function<void(const Order&, Volume, Price)> callback);  // Order carries symbol and side; must not call back into OrderManager
     void setRejectionCallback(std::function<void(const OrderId&, const std::string&)> callback);
     
     // Statistics and monitoring
@@ -113,6 +175,43 @@ private:
     // Exchange management
     std::unordered_map<Exchange, std::unique_ptr<ExchangeAPI>> exchanges_;
     std::unordered_map<Symbol, Exchange> symbolExchangeMapping_;
+    std::unordered_map<OrderId, Exchange> orderRouting_;  // Guarded by ordersMutex_
+    mutable std::mutex exchangesMutex_;
+    std::unique_ptr<SmartOrderRouter> router_;
+    
+    // Orders split across venues (guarded by ordersMutex_)
+    struct SplitOrderInfo {
+        std::vector<OrderId> childOrders;
+        size_t openChildren = 0;
+    };
+    std::unordered_map<OrderId, SplitOrderInfo> splitOrders_;
+    std::unordered_map<OrderId, OrderId> childToParent_;
+    int maxSplitSlices_;
+    
+    // Parent orders worked over time by an execution strategy (guarded by
+    // ordersMutex_). Slices fire from the shared timer wheel and are sent by
+    // the order processing thread, so any number of parents slice concurrently.
+    struct ScheduledExecution {
+        std::shared_ptr<ExecutionStrategy> strategy;
+        std::vector<ExecutionSlice> slices;
+        size_t nextSlice = 0;
+        Volume carry = 0;            // Unsent or returned quantity for the next slice
+        std::vector<OrderId> childOrders;
+        size_t openChildren = 0;
+        int failedSlices = 0;        // Consecutive rejected slices
+        double fillNotional = 0;
+        TimerId timer = TimerWheel::INVALID_TIMER;
+        TimePoint nextDue;
+        bool slicePending = false;   // Timer armed or slice queued
+        bool cancelled = false;
+        ExecutionProgress progress;
+    };
+    std::unordered_map<OrderId, ScheduledExecution> scheduledExecutions_;
+    std::unordered_map<OrderId, ExecutionProgress> executionHistory_;
+    std::queue<OrderId> dueSlices_;
+    std::shared_ptr<VolumeProfileCache> volumeProfiles_;
+    std::unordered_map<Symbol, TimerId> profileTimers_;  // Periodic refresh per VWAP symbol
+    std::queue<Symbol> profileRefreshes_;                // Fetched by the order processing thread
     
     // Threading and processing
     std::thread orderProcessingThread_;
@@ -120,15 +219,22 @@ private:
     std::atomic<bool> running_;
     std::condition_variable orderCV_;
     
+    // Order expiry
+    TimerWheel* timerWheel_;
+    Duration orderTimeout_;
+    std::unordered_map<OrderId, TimePoint> orderDeadlines_;
+    std::unordered_map<OrderId, TimerId> expiryTimers_;
+    
     // Configuration
     bool smartRoutingEnabled_;
     double maxSlippagePercent_;
     bool riskValidationEnabled_;
-    std::unordered_map<Symbol, std::string> executionStrategies_;
+    std::unordered_map<Symbol, std::shared_ptr<ExecutionStrategy>> executionStrategies_;  // Guarded by ordersMutex_
     
     // Callbacks
     OrderCallback orderCallback_;
     std::function<void(const OrderId&, Volume, Price)> fillCallback_;
+    std::function<void(const Order&, Volume, Price)> tradeCallback_;
     std::function<void(const OrderId&, const std::string&)> rejectionCallback_;
     std::function<bool(const Order&)> riskValidationCallback_;
     
@@ -143,28 +249,53 @@ private:
     };
     std::unordered_map<Symbol, ExecutionStats> executionStats_;
     
-    // Stop loss and trailing stop management
+    // Stop loss and trailing stop management. Resting stops are PENDING
+    // orders that are not queued; their levels live in stopEngine_.
+    // (guarded by ordersMutex_)
     struct StopLossInfo {
         OrderId orderId;
         Symbol symbol;
+        StopId stopId;
         Price stopPrice;
         Price trailAmount;
         bool isTrailing;
         bool usePercent;
+        Price limitOffset;  // Stop-limit exits: limit distance beyond the trigger
         TimePoint lastUpdate;
     };
-    std::unordered_map<Symbol, StopLossInfo> stopLossOrders_;
+    std::unordered_map<OrderId, StopLossInfo> stopLossOrders_;
+    std::unordered_map<StopId, OrderId> stopOrderIds_;
+    std::unordered_map<Symbol, OrderId> positionStops_;  // Set by setStopLoss
+    std::unique_ptr<StopEngine> stopEngine_;
     
-    // Hybrid order management
+    // Hybrid order management (guarded by ordersMutex_). One visible child
+    // at a time, pegged pegOffset behind the same-side touch of its venue.
     struct HybridOrderInfo {
         OrderId parentOrderId;
+        Symbol symbol;
         Volume totalQuantity;
         Volume visibleQuantity;
         Price pegOffset;
         std::vector<OrderId> childOrders;
-        int currentSlice;
+        int currentSlice = 0;
+        
+        Exchange exchange = Exchange::BINANCE;
+        double tickSize = 0;
+        OrderId activeChild;         // Empty between slices
+        Price activePrice = 0;
+        Volume activeQuantity = 0;
+        TimePoint lastRepeg;
+        TimerId repegTimer = TimerWheel::INVALID_TIMER;
+        int repegCount = 0;
+        int failedSlices = 0;        // Consecutive rejected slices
+        bool cancelled = false;
     };
     std::unordered_map<OrderId, HybridOrderInfo> hybridOrders_;
+    std::queue<OrderId> hybridRefills_;
+    std::queue<Symbol> repegQueue_;
+    std::unordered_set<Symbol> pendingRepegs_;  // Symbols already in repegQueue_
+    std::atomic<int> activeHybridCount_;
+    Duration minRepegInterval_;
     
     // Private methods - Order processing
     void orderProcessingWorker();
@@ -184,6 +315,21 @@ private:
     Exchange selectOptimalExchange(const Order& order) const;
     double calculateExecutionCost(const Order& order, Exchange exchange) const;
     bool isExchangeAvailable(Exchange exchange) const;
+    std::vector<Exchange> getRoutableExchanges() const;
+    bool sendToExchange(Order& order, Exchange exchange, std::string& error);
+    bool routeSplitOrder(const Order& parent, std::vector<Order>& children);
+    void onChildOrderUpdate(const OrderId& parentId, const Order& child);
+    std::vector<std::pair<ExchangeAPI*, OrderId>> collectVenueOrders(const OrderId& orderId) const;
+    
+    // Scheduled execution
+    bool startScheduledExecution(const Order& order, std::shared_ptr<ExecutionStrategy> strategy);
+    void processDueSlice(const OrderId& parentId);
+    // (caller holds ordersMutex_)
+    void scheduleSlice(const OrderId& parentId, ScheduledExecution& execution, Duration delay);
+    void scheduleProfileRefresh(const Symbol& symbol);
+    bool onScheduledChildDone(const OrderId& parentId, ScheduledExecution& execution, const Order& child);
+    bool completeScheduledExecution(const OrderId& parentId, Order& parent);
+    bool isScheduleDone(const ScheduledExecution& execution) const;
     
     // Slippage management
     double calculateSlippage(const Order& order, Price fillPrice) const;
@@ -191,19 +337,26 @@ private:
     bool isSlippageAcceptable(double slippage) const;
     
     // Stop loss management
-    void updateTrailingStops(const Symbol& symbol, Price currentPrice);
-    void triggerStopLoss(const Symbol& symbol);
-    bool shouldUpdateTrailingStop(const StopLossInfo& info, Price currentPrice) const;
+    OrderId registerStop(const Order& order, Price stopPrice, Price trail,
+                         bool trailing, bool usePercent, int tickBuffer);
+    void checkStops(const Symbol& symbol, Price currentPrice);
+    void triggerStop(const StopEngine::Trigger& trigger);
+    void releaseStop(const OrderId& orderId);  // Caller holds ordersMutex_
     
     // Hybrid order management
-    void manageHybridOrder(const HybridOrderInfo& info);
-    void submitNextSlice(const HybridOrderInfo& info);
-    bool isHybridOrderComplete(const OrderId& orderId) const;
+    void manageHybridOrder(const OrderId& parentId);
+    void submitNextSlice(const OrderId& parentId);
+    void repegHybridOrders(const Symbol& symbol);
+    bool completeHybridOrder(const OrderId& parentId, Order& parent);  // Caller holds ordersMutex_
+    void releaseHybridOrder(const OrderId& parentId);                  // Caller holds ordersMutex_
     
     // Order state management
     void updateOrderStatus(const OrderId& orderId, OrderStatus status);
     void moveToHistory(const OrderId& orderId);
     void cleanupExpiredOrders();
+    void expireOrder(const OrderId& orderId);
+    void scheduleExpiry(const OrderId& orderId);
+    void clearExpiry(const OrderId& orderId);
     
     // Risk and validation
     bool performRiskValidation(const Order& order) const;
@@ -223,18 +376,37 @@ private:
 
 /**
  * @brief Order execution strategies
+ *
+ * A strategy plans the child slices of a parent order up front and may
+ * resize each slice against the live book when it comes due. Scheduling,
+ * sending and fill aggregation are done by OrderManager, so strategies are
+ * stateless and one instance can serve any number of parent orders.
  */
 class ExecutionStrategy {
 public:
     virtual ~ExecutionStrategy() = default;
-    virtual bool execute(Order& order, const std::vector<ExchangeAPI*>& exchanges) = 0;
+    
+    /**
+     * @brief Plan the child slices of a parent order
+     * @return Slices ordered by offset whose quantities sum to order.quantity
+     */
+    virtual std::vector<ExecutionSlice> plan(const Order& order, TimePoint start) const = 0;
+    
+    /**
+     * @brief Size a due slice; the remainder carries over to the next one
+     * @param book Book of the venue the slice will be sent to (may be null)
+     */
+    virtual Volume sizeSlice(const Order& parent, Volume scheduled, const OrderBook* book) const;
+    
+    // Delay before re-sending quantity left over after the last planned slice
+    virtual Duration getRetryInterval() const { return std::chrono::seconds(1); }
     virtual std::string getName() const = 0;
 };
 
 class TWAPStrategy : public ExecutionStrategy {
 public:
     TWAPStrategy(Duration timeWindow, int slices);
-    bool execute(Order& order, const std::vector<ExchangeAPI*>& exchanges) override;
+    std::vector<ExecutionSlice> plan(const Order& order, TimePoint start) const override;
     std::string getName() const override { return "TWAP"; }
     
 private:
@@ -244,51 +416,159 @@ private:
 
 class VWAPStrategy : public ExecutionStrategy {
 public:
-    VWAPStrategy(Duration timeWindow);
-    bool execute(Order& order, const std::vector<ExchangeAPI*>& exchanges) override;
+    /**
+     * @param slices Number of slices, 0 for one per volume profile bucket
+     */
+    VWAPStrategy(Duration timeWindow,
+                 std::shared_ptr<const VolumeProfileCache> profiles = nullptr,
+                 int slices = 0);
+    std::vector<ExecutionSlice> plan(const Order& order, TimePoint start) const override;
     std::string getName() const override { return "VWAP"; }
     
 private:
     Duration timeWindow_;
+    std::shared_ptr<const VolumeProfileCache> profiles_;
+    int slices_;
 };
 
 class MinimizeSlippageStrategy : public ExecutionStrategy {
 public:
-    MinimizeSlippageStrategy(double maxSlippage);
-    bool execute(Order& order, const std::vector<ExchangeAPI*>& exchanges) override;
+    /**
+     * @param maxSlippage Maximum price move from mid per slice (fraction)
+     * @param interval Delay between slices while liquidity is insufficient
+     */
+    MinimizeSlippageStrategy(double maxSlippage, Duration interval = std::chrono::seconds(1));
+    std::vector<ExecutionSlice> plan(const Order& order, TimePoint start) const override;
+    Volume sizeSlice(const Order& parent, Volume scheduled, const OrderBook* book) const override;
+    Duration getRetryInterval() const override { return interval_; }
     std::string getName() const override { return "MinSlippage"; }
     
 private:
     double maxSlippage_;
+    Duration interval_;
+};
+
+/**
+ * @brief Intraday volume profiles for VWAP scheduling
+ *
+ * Built from historical bars: average volume per time-of-day bucket (UTC).
+ * Profiles are immutable once built and swapped in whole, so planning reads
+ * them without holding the lock.
+ */
+class VolumeProfileCache {
+public:
+    explicit VolumeProfileCache(Duration bucketSize = std::chrono::minutes(5));
+    
+    void buildProfile(const Symbol& symbol, const std::vector<OHLC>& bars);
+    bool hasProfile(const Symbol& symbol) const;
+    void removeProfile(const Symbol& symbol);
+    void clear();
+    Duration getBucketSize() const { return bucketSize_; }
+    
+    /**
+     * @brief Expected share of volume in each of `slices` equal parts of a window
+     * @return Weights summing to 1 (uniform when there is no profile)
+     */
+    std::vector<double> getSliceWeights(const Symbol& symbol, TimePoint start,
+                                        Duration window, int slices) const;
+    
+private:
+    using Profile = std::vector<double>;  // Average volume per bucket of the day
+    
+    Duration bucketSize_;
+    size_t bucketsPerDay_;
+    std::unordered_map<Symbol, std::shared_ptr<const Profile>> profiles_;
+    mutable std::mutex profileMutex_;
 };
 
 /**
  * @brief Smart order router for optimal execution
+ *
+ * Scores venues by expected all-in cost: trading fee, spread and market
+ * impact from the venue's live L2 book, plus penalties derived from rolling
+ * per-venue latency and fill-rate metrics. Metrics are EWMAs updated from
+ * execution feedback (sent / acknowledged / fill / completed) and stored in
+ * a fixed array indexed by Exchange, so a routing decision is a handful of
+ * atomic loads and one short book walk per venue - no hashing, no
+ * allocation beyond the result.
  */
 class SmartOrderRouter {
 public:
+    struct ExchangeMetrics {
+        double avgSpread = 0.0;     // Quoted spread relative to mid
+        double avgSlippage = 0.0;   // Adverse fill price vs arrival mid (relative)
+        double fillRate = 1.0;      // Filled quantity / routed quantity
+        double avgLatencyMs = 0.0;  // Submission to acknowledgement
+        Volume avgVolume = 0.0;     // Filled quantity per completed order
+        uint64_t samples = 0;
+        TimePoint lastUpdate;
+    };
+    
     SmartOrderRouter();
     
+    // Venue registry (APIs are owned by the caller and must outlive the router)
+    void addExchange(Exchange exchange, ExchangeAPI* api);
+    void removeExchange(Exchange exchange);
+    std::vector<Exchange> getExchanges() const;
+    
     Exchange selectBestExchange(const Order& order, 
                               const std::vector<Exchange>& availableExchanges) const;
     
+    // Child orders carry the target venue in Order::exchange (see toExchangeId)
     std::vector<Order> splitOrder(const Order& order, int maxSlices) const;
     
+    // Expected cost as a fraction of notional (infinity if the venue cannot trade it)
     double estimateExecutionCost(const Order& order, Exchange exchange) const;
     
+    // Execution feedback
+    void onOrderSent(const Order& order, Exchange exchange);
+    void onOrderAcknowledged(const OrderId& orderId);
+    void onOrderFill(const OrderId& orderId, Volume quantity, Price price);
+    void onOrderCompleted(const OrderId& orderId);
+    ExchangeMetrics getExchangeMetrics(Exchange exchange) const;
+    
+    // Cost model tuning
+    void setLatencyCostPerMs(double cost);
+    void setMetricsSmoothing(double alpha);
+    
+    static ExchangeId toExchangeId(Exchange exchange);
+    static bool fromExchangeId(const ExchangeId& id, Exchange& exchange);
+    
 private:
-    struct ExchangeMetrics {
-        double avgSpread;
-        double avgSlippage;
-        double fillRate;
-        Volume avgVolume;
-        TimePoint lastUpdate;
+    static constexpr size_t MAX_EXCHANGES = static_cast<size_t>(Exchange::SIMULATED) + 1;
+    
+    // One cache line per venue; written by feedback, read lock-free when routing
+    struct alignas(64) MetricsSlot {
+        std::atomic<ExchangeAPI*> api;
+        std::atomic<double> avgSpread;
+        std::atomic<double> avgSlippage;
+        std::atomic<double> fillRate;
+        std::atomic<double> avgLatencyMs;
+        std::atomic<double> avgVolume;
+        std::atomic<uint64_t> samples;
+        std::atomic<int64_t> lastUpdateMs;
+    };
+    std::array<MetricsSlot, MAX_EXCHANGES> slots_;
+    
+    struct RoutedOrder {
+        Exchange exchange;
+        Order order;
+        Price arrivalPrice;
+        TimePoint sentAt;
+        Volume filledQuantity;
+        double filledNotional;
+        bool acknowledged;
     };
+    std::unordered_map<OrderId, RoutedOrder> routedOrders_;
+    mutable std::mutex feedbackMutex_;
     
-    std::unordered_map<Exchange, ExchangeMetrics> exchangeMetrics_;
+    std::atomic<double> latencyCostPerMs_;
+    std::atomic<double> alpha_;
     
     void updateExchangeMetrics(Exchange exchange, const Order& order, 
                              double slippage, bool filled);
+    void updateAverage(std::atomic<double>& average, double sample) const;
+    Price referencePrice(ExchangeAPI* api, const Order& order) const;
 };
 
 } // namespace MasterMind
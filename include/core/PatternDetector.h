@@ -3,9 +3,11 @@
 
 #include "Types.h"
 #include "RenkoChart.h"
+#include "TimerWheel.h"
 #include <memory>
 #include <vector>
 #include <functional>
+#include <mutex>
 
 namespace MasterMind {
 
@@ -47,6 +49,8 @@ public:
     void setTickBuffer(int ticks);  // Default 2 ticks
     void enableSetup1(bool enable);
     void enableSetup2(bool enable);
+    void setPatternTimeout(Duration timeout);  // Default 30 minutes
+    void setTimerWheel(TimerWheel* timerWheel);
     
     // Pattern state tracking
     bool isPatternActive(const Symbol& symbol) const;
@@ -86,6 +90,17 @@ private:
     // Pattern state tracking
     std::unordered_map<Symbol, PatternType> activePatterns_;
     std::unordered_map<Symbol, TimePoint> patternStartTime_;
+    mutable std::mutex stateMutex_;
+    
+    // Pattern expiry (driven by the shared timer wheel)
+    struct ExpiryTimer {
+        TimerId timerId;
+        uint64_t generation;  // Tells a stale callback from the symbol's current one
+    };
+    Duration patternTimeout_;
+    TimerWheel* timerWheel_;
+    std::unordered_map<Symbol, ExpiryTimer> expiryTimers_;
+    uint64_t expiryGeneration_;
     
     // Pattern statistics
     struct PatternStats {
@@ -134,6 +149,10 @@ private:
                            const RenkoChart& chart) const;
     bool isPatternRiskAcceptable(const PatternResult& pattern) const;
     
+    // Pattern state helpers
+    void activatePattern(const PatternResult& pattern);
+    void expirePattern(const Symbol& symbol, uint64_t generation);
+    
     // Utility methods
     OrderSide getOppositeDirection(OrderSide side) const;
     std::string patternTypeToString(PatternType type) const;
@@ -0,0 +1,135 @@
+#ifndef MASTERMIND_PERSISTENCE_QUEUE_H
+#define MASTERMIND_PERSISTENCE_QUEUE_H
+
+#include "DatabaseManager.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MasterMind {
+
+struct PersistenceStats {
+    uint64_t enqueued;
+    uint64_t written;
+    uint64_t failed;           // Rejected by the database
+    uint64_t dropped;          // Arrived while the queue was full and stopped
+    uint64_t batches;
+    uint64_t producerStalls;   // Enqueues that found the queue full and waited
+    uint64_t oversizedText;    // Records whose text did not fit inline and went to the heap
+    size_t depth;              // Records waiting now
+    size_t maxDepth;
+    size_t maxBatch;
+    double lastCommitMicros;
+    double maxCommitMicros;
+    double maxRecordLatencyMicros;  // Enqueue to commit, worst record
+
+    PersistenceStats() : enqueued(0), written(0), failed(0), dropped(0), batches(0), producerStalls(0),
+                         oversizedText(0), depth(0), maxDepth(0), maxBatch(0), lastCommitMicros(0), maxCommitMicros(0),
+                         maxRecordLatencyMicros(0) {}
+};
+
+/**
+ * @brief Write-behind queue in front of DatabaseManager
+ *
+ * Producers pay one lock-free enqueue into a bounded multi-producer ring
+ * (per-slot sequence numbers, one CAS to claim a slot) and copy a plain
+ * PersistenceRecord into it; nothing is allocated until the writer thread
+ * rebuilds the order or position. A single writer
+ * thread drains up to maxBatch records and group-commits them in one
+ * transaction through DatabaseManager::writeBatch. The writer wakes at least
+ * every maxLatency, so a record waits at most about maxLatency plus one
+ * commit.
+ *
+ * A full ring makes producers yield until the writer frees a slot; each such
+ * wait is counted as a stall. stop() and the destructor drain everything
+ * already enqueued before the writer exits.
+ *
+ * Text longer than the record's buffers (ids over 63 bytes, details over
+ * 191) travels in a heap overflow copy instead of being cut; such records
+ * are counted in oversizedText.
+ */
+class PersistenceQueue {
+public:
+    explicit PersistenceQueue(DatabaseManager& database, size_t capacity = 16384,
+                              Duration maxLatency = std::chrono::milliseconds(5), size_t maxBatch = 4096);
+    ~PersistenceQueue();
+
+    PersistenceQueue(const PersistenceQueue&) = delete;
+    PersistenceQueue& operator=(const PersistenceQueue&) = delete;
+
+    // Writer thread lifecycle
+    bool start();
+    void stop();  // Flushes, then joins
+    bool isRunning() const;
+
+    // Producer side, safe from any thread
+    void insertOrder(const Order& order);
+    void updateOrder(const Order& order);
+    void insertPosition(const Position& position);
+    void updatePosition(const Position& position);
+    void insertTradeResult(const OrderId& orderId, double pnl, const std::string& strategy);
+    void insertRiskEvent(const std::string& event, const std::string& details);
+    void insertCounterResult(int counterNumber, double pnl, int orderCount);
+    void insertAuditEntry(const std::string& action, const std::string& details,
+                          const std::string& userId = "system");
+    void enqueue(const PersistenceRecord& record);  // Takes ownership of record.overflow
+
+    /**
+     * @brief Wait until every record enqueued before the call is committed
+     * @return false on timeout or if the writer is not running
+     */
+    bool flush(Duration timeout = std::chrono::seconds(5));
+
+    PersistenceStats getStats() const;
+    size_t getCapacity() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        PersistenceRecord record;
+    };
+
+    DatabaseManager& database_;
+    const size_t capacity_;
+    const Duration maxLatency_;
+    const size_t maxBatch_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(64) std::atomic<uint64_t> enqueuePosition_;
+    alignas(64) std::atomic<uint64_t> dequeuePosition_;  // Advanced by the writer only
+    std::atomic<uint64_t> processed_;                     // Records committed or failed
+
+    // Statistics (producer counters are relaxed; writer counters single-writer)
+    std::atomic<uint64_t> producerStalls_;
+    std::atomic<uint64_t> oversizedText_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> written_;
+    std::atomic<uint64_t> failed_;
+    std::atomic<uint64_t> batches_;
+    std::atomic<size_t> maxDepth_;
+    std::atomic<size_t> maxBatchSize_;
+    std::atomic<double> lastCommitMicros_;
+    std::atomic<double> maxCommitMicros_;
+    std::atomic<double> maxRecordLatencyMicros_;
+
+    // Writer thread
+    std::thread writer_;
+    std::atomic<bool> running_;
+    bool wakeRequested_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    std::condition_variable flushCondition_;
+
+    void writerLoop();
+    size_t drain(std::vector<PersistenceRecord>& batch);
+    void commit(std::vector<PersistenceRecord>& batch);
+    void wakeWriter();
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_PERSISTENCE_QUEUE_H
@@ -0,0 +1,151 @@
+#ifndef MASTERMIND_PRE_TRADE_RISK_CHECK_H
+#define MASTERMIND_PRE_TRADE_RISK_CHECK_H
+
+#include "Types.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace MasterMind {
+
+class ExposureTracker;
+
+enum class RiskRejectReason : uint8_t {
+    NONE = 0,
+    EMERGENCY_STOP,
+    DRAWDOWN_LIMIT,
+    DAILY_RISK_LIMIT,
+    INVALID_ORDER,
+    POSITION_LIMIT,
+    EXPOSURE_LIMIT,
+    COUNT
+};
+
+struct RiskRejection {
+    OrderId orderId;
+    Symbol symbol;
+    RiskRejectReason reason;
+};
+
+/**
+ * @brief Fixed-capacity symbol to slot index map with lock-free lookups
+ *
+ * Symbols are only ever added. Each slot's name is written before its index
+ * is published to the open-addressed table, so find() can run concurrently
+ * with registerSymbol() without a lock.
+ */
+class SymbolRegistry {
+public:
+    using SlotId = uint32_t;
+
+    static constexpr SlotId INVALID_SLOT = UINT32_MAX;
+    static constexpr size_t CAPACITY = 1024;
+
+    SymbolRegistry();
+
+    SymbolRegistry(const SymbolRegistry&) = delete;
+    SymbolRegistry& operator=(const SymbolRegistry&) = delete;
+
+    SlotId registerSymbol(const Symbol& symbol);  // Existing slot if known, INVALID_SLOT when full
+    SlotId find(const Symbol& symbol) const;
+    const Symbol& getSymbol(SlotId slot) const { return symbols_[slot]; }  // Any slot below size()
+    size_t size() const;
+
+private:
+    static constexpr size_t TABLE_SIZE = CAPACITY * 2;  // Power of two, load factor <= 0.5
+
+    std::array<Symbol, CAPACITY> symbols_;
+    std::array<std::atomic<uint32_t>, TABLE_SIZE> table_;  // Slot + 1, 0 when empty
+    std::atomic<size_t> count_;
+    std::mutex registerMutex_;
+};
+
+/**
+ * @brief Pre-trade risk gate for the order submission path
+ *
+ * Keeps the limits that decide an order precomputed in atomics, so a check
+ * takes no lock, allocates nothing and performs no I/O:
+ * - Account gates (emergency stop, drawdown, exhausted daily budget) fold into
+ *   one word - an emergency stop costs a single load
+ * - The remaining daily risk budget is published as one value; an order's risk
+ *   is its stop distance times quantity
+ * - Position and exposure limits sit in one cache line per symbol, found
+ *   through a lock-free SymbolRegistry
+ * - Positions are not kept here: they are read from the ExposureTracker the
+ *   fills are booked into, so the gate and the exposure figures never disagree
+ *
+ * Orders that reduce an existing position pass every gate but the emergency
+ * stop, so stop-loss exits still go out while drawdown or the daily budget
+ * halts new risk.
+ * Rejections are counted per reason and reported through the rejection callback.
+ */
+class PreTradeRiskCheck {
+public:
+    explicit PreTradeRiskCheck(const ExposureTracker* positions = nullptr);  // Null: every position flat
+
+    PreTradeRiskCheck(const PreTradeRiskCheck&) = delete;
+    PreTradeRiskCheck& operator=(const PreTradeRiskCheck&) = delete;
+
+    // Hot path
+    RiskRejectReason check(const Order& order) const;
+
+    // Limit publication (risk manager side)
+    void setEmergencyStop(bool active);
+    void updateAccount(double remainingDailyRisk, bool drawdownBreached);
+    void setDefaultLimits(Volume maxPosition, double maxExposure);
+    bool setSymbolLimits(const Symbol& symbol, Volume maxPosition, double maxExposure);
+
+    // Statistics
+    uint64_t getCheckCount() const;
+    uint64_t getRejectCount() const;
+    uint64_t getRejectCount(RiskRejectReason reason) const;
+    void resetCounters();
+
+    void setRejectionCallback(std::function<void(const RiskRejection&)> callback);
+
+    static const char* reasonToString(RiskRejectReason reason);
+
+private:
+    enum Gate : uint32_t {
+        GATE_EMERGENCY = 1u << 0,
+        GATE_DRAWDOWN = 1u << 1,
+        GATE_DAILY_RISK = 1u << 2
+    };
+
+    struct alignas(64) SymbolLimits {
+        std::atomic<double> maxPosition;
+        std::atomic<double> maxExposure;
+    };
+
+    struct alignas(64) Counter {
+        std::atomic<uint64_t> value{0};
+    };
+
+    // Account state, written together by updateAccount
+    alignas(64) std::atomic<uint32_t> gates_;
+    std::atomic<double> remainingDailyRisk_;
+    std::atomic<double> defaultMaxPosition_;
+    std::atomic<double> defaultMaxExposure_;
+    const ExposureTracker* positions_;
+
+    SymbolRegistry registry_;
+    std::unique_ptr<SymbolLimits[]> symbolLimits_;  // Indexed by registry slot
+
+    mutable Counter checks_;
+    mutable std::array<Counter, static_cast<size_t>(RiskRejectReason::COUNT)> rejects_;
+
+    std::function<void(const RiskRejection&)> rejectionCallback_;
+    std::mutex limitsMutex_;  // Serializes limit writers; never taken by check()
+
+    // Private methods
+    RiskRejectReason evaluate(const Order& order) const;
+    SymbolLimits* limitsFor(const Symbol& symbol);
+    void setGate(uint32_t gate, bool active);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_PRE_TRADE_RISK_CHECK_H
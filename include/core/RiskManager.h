@@ -2,7 +2,16 @@
 #define MASTERMIND_RISK_MANAGER_H
 
 #include "Types.h"
+#include "TimerWheel.h"
+#include "PreTradeRiskCheck.h"
+#include "ExposureTracker.h"
+#include "StreamingRiskEstimator.h"
+#include "MonteCarloRiskSimulator.h"
+#include "CovarianceMatrix.h"
+#include "CounterLedger.h"
+#include <deque>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <atomic>
 #include <mutex>
@@ -48,9 +57,21 @@ public:
                           const InstrumentSpec& instrument) const;
     
     // Risk validation
+    /**
+     * @brief Pre-trade check against the published limits snapshot
+     *
+     * Lock-free and silent; rejections are counted by the PreTradeRiskCheck.
+     * Account and positions reach the snapshot through updateRiskStatus.
+     */
+    bool validateOrder(const Order& order) const;
     bool validateOrder(const Order& order,
                       const AccountInfo& account,
                       const std::vector<Position>& positions) const;
+    void setSymbolLimits(const Symbol& symbol, Volume maxPosition, double maxExposure);
+    void onFill(const Symbol& symbol, OrderSide side, Volume quantity, Price price);
+    void onFill(const Order& order, Volume quantity, Price price);  // Also charges opened stop risk to the day
+    void onMarketPrice(const Symbol& symbol, Price price);  // Mark-to-market, O(1)
+    PreTradeRiskCheck* getPreTradeCheck() const;
     
     bool isWithinDailyRiskLimit(const Order& order,
                               const AccountInfo& account) const;
@@ -69,6 +90,25 @@ public:
     int getOrdersInCurrentCounter() const;
     double getCounterPnL() const;
     double getCapitalAfterCounter(double initialCapital) const;
+    void recordCounterPnL(double pnl, double charges = 0);
+    int getCompletedCounterCount() const;
+    
+    /**
+     * @brief Persist counter, consecutive-loss and daily state in a directory
+     *
+     * Restores the state found there (snapshot plus log tail) before
+     * returning; afterwards every change is logged before it is applied.
+     */
+    bool openLedger(const std::string& directory);
+    void closeLedger();
+    bool snapshotLedger();
+    
+    /**
+     * @brief Forward-looking counter outcomes under the current parameters
+     * @param tradeResults Historical trade results as R-multiples (P&L / amount risked)
+     */
+    MonteCarloResult simulateCounters(const std::vector<double>& tradeResults,
+                                      const MonteCarloConfig& config = MonteCarloConfig()) const;
     
     // Risk status monitoring
     RiskStatus getCurrentRiskStatus() const;
@@ -97,8 +137,16 @@ public:
     void performDailyReset();
     void resetDailyCounters();
     bool isDailyResetRequired() const;
-    
-    // Risk metrics and reporting
+    void setTimerWheel(TimerWheel* timerWheel);  // Schedules the daily reset and return sampling
+    
+    // Risk metrics and reporting, streaming over portfolio P&L returns sampled
+    // every RETURN_SAMPLE_INTERVAL (fills and marks, as fractions of equity)
+    static constexpr Duration RETURN_SAMPLE_INTERVAL = std::chrono::minutes(1);
+    void recordReturn(double periodReturn);
+    double getValueAtRisk(double confidence = 0.95) const;
+    double getExpectedShortfall(double confidence = 0.95) const;
+    double getVolatility() const;
+    const StreamingRiskEstimator& getReturnEstimator() const;
     double getEquityHighWaterMark() const;
     double getRiskAdjustedReturn() const;
     double getSharpeRatio() const;
@@ -108,6 +156,19 @@ public:
     double getMaxPositionSize(const Symbol& symbol,
                             const InstrumentSpec& instrument) const;
     
+    // Running exposure, P&L and margin (lock-free snapshots)
+    double getTotalExposure() const;
+    double getSymbolExposure(const Symbol& symbol) const;
+    PortfolioExposure getPortfolioExposure() const;
+    ExposureTracker* getExposureTracker() const;
+    
+    // Correlation risk over the EWMA covariance of bar returns
+    void onBar(const Symbol& symbol, const OHLC& bar);
+    double getPortfolioRisk() const;      // 1-sigma P&L per bar of the current exposure
+    double getCorrelationRisk() const;    // Portfolio risk added by correlation
+    double getCorrelationAdjustment(const Symbol& symbol, OrderSide side) const;  // Position size factor in (0.5, 1]
+    CovarianceMatrix* getCovarianceMatrix() const;
+    
     double getTotalExposure(const std::vector<Position>& positions) const;
     double getSymbolExposure(const Symbol& symbol,
                            const std::vector<Position>& positions) const;
@@ -131,38 +192,37 @@ private:
     std::atomic<bool> paperMode_;
     std::atomic<bool> emergencyStop_;
     
+    // Pre-trade limits snapshot, republished whenever its inputs change
+    std::unique_ptr<ExposureTracker> exposureTracker_;      // Position truth, read by the pre-trade check
+    std::unique_ptr<PreTradeRiskCheck> preTradeCheck_;
+    std::unique_ptr<CovarianceMatrix> covariance_;
+    std::atomic<double> accountEquity_;
+    
     // Drawdown tracking
     double equityHighWaterMark_;
-    double currentDrawdown_;
+    std::atomic<double> currentDrawdown_;
     double maxDrawdown_;
     TimePoint highWaterMarkTime_;
     
     // Daily tracking
     double dailyStartBalance_;
     double dailyPnL_;
-    double dailyRiskUsed_;
+    std::atomic<double> dailyRiskUsed_;
     TimePoint lastDailyReset_;
+    TimerWheel* timerWheel_;
+    TimerId dailyResetTimer_;
+    TimerId returnSampleTimer_;
+    double lastSampledPnL_;  // Timer thread only
     
-    // Counter management
-    struct TradingCounter {
-        int counterNumber;
-        int ordersCount;
-        std::vector<Order> orders;
-        double initialCapital;
-        double currentCapital;
-        double totalPnL;
-        double totalCharges;
-        TimePoint startTime;
-        TimePoint endTime;
-        bool isComplete;
-        
-        TradingCounter() : counterNumber(0), ordersCount(0), initialCapital(0),
-                          currentCapital(0), totalPnL(0), totalCharges(0), 
-                          isComplete(false) {}
-    };
+    // Counter management (counters, streaks, daily P&L and daily risk used change only
+    // through ledger events)
+    using TradingCounter = CounterRecord;
+    static constexpr size_t MAX_COMPLETED_COUNTERS = 100;
     
     TradingCounter currentCounter_;
-    std::vector<TradingCounter> completedCounters_;
+    std::deque<TradingCounter> completedCounters_;  // Most recent only
+    int completedCount_;
+    std::unique_ptr<CounterLedger> ledger_;
     mutable std::mutex counterMutex_;
     
     // Consecutive loss tracking
@@ -172,7 +232,7 @@ private:
     TimePoint lastTradeTime_;
     
     // Statistics
-    std::vector<double> dailyReturns_;
+    StreamingRiskEstimator returnEstimator_;
     double totalTrades_;
     double profitableTrades_;
     
@@ -181,6 +241,9 @@ private:
     
     // Private methods
     void calculateDrawdown(double currentEquity);
+    void publishLimits();
+    void addDailyRiskUsed(double risk);
+    void sampleReturn();
     void updateEquityHighWaterMark(double equity);
     bool checkDailyRiskLimit(double additionalRisk) const;
     bool checkDrawdownThreshold(double currentEquity) const;
@@ -198,9 +261,18 @@ private:
     double calculateCounterPerformance() const;
     bool shouldStartNextCounter() const;
     
+    // Ledger helpers (caller holds counterMutex_)
+    bool commitCounterEvent(LedgerEvent& event);  // False (and emergency stop) when the ledger write fails
+    void applyCounterEvent(const LedgerEvent& event);
+    LedgerSnapshot makeSnapshot() const;
+    void restoreSnapshot(const LedgerSnapshot& snapshot);
+    
     // Risk calculation methods
     double calculatePortfolioRisk(const std::vector<Position>& positions) const;
     double calculateCorrelationRisk(const std::vector<Position>& positions) const;
+    double calculatePortfolioRisk(const std::unordered_map<Symbol, double>& exposures) const;
+    double calculateCorrelationRisk(const std::unordered_map<Symbol, double>& exposures) const;
+    std::unordered_map<Symbol, double> getCurrentExposures() const;  // Signed market value per covariance symbol
     double calculateLeverageRisk(const AccountInfo& account) const;
     
     // Alert and notification helpers
@@ -235,7 +307,10 @@ public:
 };
 
 /**
- * @brief Risk assessment utilities
+ * @brief Risk assessment utilities for one-off batches of returns
+ *
+ * Single pass or selection (O(n)) - nothing sorts the full history. For
+ * series that grow over time use StreamingRiskEstimator instead.
  */
 class RiskAssessment {
 public:
@@ -0,0 +1,44 @@
+#ifndef MASTERMIND_SEQ_LOCK_H
+#define MASTERMIND_SEQ_LOCK_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace MasterMind {
+
+/**
+ * @brief Sequence lock over a counter that is odd while a write is in progress
+ *
+ * One writer brackets its stores with beginWrite()/endWrite(); readers copy
+ * the guarded fields between beginRead() and endRead() and retry while
+ * endRead() returns false. The guarded fields must be atomics read and
+ * written relaxed. Used by ExposureTracker and AccountCache.
+ */
+namespace SeqLock {
+
+inline void beginWrite(std::atomic<uint32_t>& sequence) {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+inline void endWrite(std::atomic<uint32_t>& sequence) {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+inline uint32_t beginRead(const std::atomic<uint32_t>& sequence) {
+    uint32_t begin;
+    while ((begin = sequence.load(std::memory_order_acquire)) & 1) {
+    }
+    return begin;
+}
+
+inline bool endRead(const std::atomic<uint32_t>& sequence, uint32_t begin) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return sequence.load(std::memory_order_relaxed) == begin;
+}
+
+} // namespace SeqLock
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_SEQ_LOCK_H
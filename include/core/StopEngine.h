@@ -0,0 +1,134 @@
+#ifndef MASTERMIND_STOP_ENGINE_H
+#define MASTERMIND_STOP_ENGINE_H
+
+#include "Types.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MasterMind {
+
+using StopId = uint64_t;
+
+/**
+ * @brief Local stop and trailing stop trigger engine
+ *
+ * Holds resting stops per symbol and exit direction, and reports the ones a
+ * price update triggers. Prices are mapped so that every stop triggers when
+ * the (mapped) price falls to or below its level: x = price for SELL exits
+ * (protecting longs), x = -price for BUY exits (protecting shorts).
+ *
+ * - Fixed stops sit in a level-sorted map; the nearest trigger is begin()
+ * - Trailing stops are grouped by their high-water mark. Groups form a stack
+ *   with strictly decreasing peaks (older stops have seen more history); a new
+ *   high merges the groups it overtakes (small into large), so a rising market
+ *   ratchets every trailing stop without touching them one by one. A prefix
+ *   maximum of the groups' highest levels makes the trigger check O(1)
+ *
+ * A tick that triggers nothing costs a hash lookup and a few comparisons per
+ * direction regardless of how many stops rest on the symbol.
+ */
+class StopEngine {
+public:
+    struct Trigger {
+        StopId stopId;
+        Symbol symbol;
+        OrderSide exitSide;
+        Price stopPrice;  // Level that was crossed
+    };
+
+    StopEngine();
+
+    StopEngine(const StopEngine&) = delete;
+    StopEngine& operator=(const StopEngine&) = delete;
+
+    // Stop registration
+    StopId addStop(const Symbol& symbol, OrderSide exitSide, Price stopPrice);
+
+    /**
+     * @brief Add a trailing stop
+     * @param referencePrice Price the trail starts from when the symbol has no price yet
+     * @param trail Trail distance, or fraction of price when percent is set
+     */
+    StopId addTrailingStop(const Symbol& symbol, OrderSide exitSide, Price referencePrice,
+                           double trail, bool percent);
+    bool cancelStop(StopId stopId);
+    bool updateStop(StopId stopId, Price stopPrice);  // Fixed stops
+    bool updateTrail(StopId stopId, double trail);    // Trailing stops
+
+    /**
+     * @brief Apply a price update and collect the stops it triggers
+     * @return Number of triggered stops appended (they are removed from the engine)
+     */
+    size_t onPrice(const Symbol& symbol, Price price, std::vector<Trigger>& triggered);
+
+    // Queries
+    Price getStopPrice(StopId stopId) const;  // Current level, 0 if unknown
+    bool hasStop(StopId stopId) const;
+    size_t getStopCount() const;
+    size_t getStopCount(const Symbol& symbol) const;
+    void clear();
+
+private:
+    using FixedMap = std::multimap<double, StopId, std::greater<double>>;  // Highest level first
+    using TrailMap = std::multimap<double, StopId>;                        // Tightest trail first
+
+    struct Group {
+        double peak = 0;         // High-water mark in mapped prices
+        TrailMap amountTrails;
+        TrailMap percentTrails;
+
+        size_t size() const { return amountTrails.size() + percentTrails.size(); }
+    };
+
+    struct Side {
+        double sign = 1.0;       // +1 SELL exits, -1 BUY exits
+        FixedMap fixed;
+        std::vector<std::unique_ptr<Group>> groups;  // Peaks strictly decreasing bottom to top
+        std::vector<double> prefixBest;              // Max trailing level of groups[0..i]
+    };
+
+    struct SymbolStops {
+        Side sides[2];  // [0] SELL exits, [1] BUY exits
+        Price lastPrice = 0;
+        size_t count = 0;
+
+        SymbolStops() { sides[1].sign = -1.0; }
+    };
+
+    struct StopRecord {
+        Symbol symbol;
+        OrderSide exitSide;
+        bool trailing = false;
+        bool percent = false;
+        double trail = 0;
+        FixedMap::iterator fixedIt;
+        Group* group = nullptr;
+        TrailMap::iterator trailIt;
+    };
+
+    std::unordered_map<Symbol, SymbolStops> symbols_;
+    std::unordered_map<StopId, StopRecord> stops_;
+    StopId nextStopId_;
+    size_t stopCount_;
+    mutable std::mutex engineMutex_;
+
+    // Private methods (caller holds engineMutex_)
+    static size_t sideIndex(OrderSide exitSide) { return exitSide == OrderSide::SELL ? 0 : 1; }
+    static double trailLevel(const Side& side, double peak, double trail, bool percent);
+    static double groupBest(const Side& side, const Group& group);
+    void ratchet(Side& side, double x);
+    void mergeGroup(Group& into, Group& from);
+    void recomputePrefix(Side& side, size_t from);
+    size_t findGroup(const Side& side, const Group* group) const;
+    void eraseTrailing(Side& side, StopRecord& record);
+    void collectTriggers(SymbolStops& stops, Side& side, const Symbol& symbol, double x,
+                         std::vector<Trigger>& triggered);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_STOP_ENGINE_H
@@ -0,0 +1,97 @@
+#ifndef MASTERMIND_STREAMING_RISK_ESTIMATOR_H
+#define MASTERMIND_STREAMING_RISK_ESTIMATOR_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace MasterMind {
+
+/**
+ * @brief Merging t-digest quantile sketch
+ *
+ * Values are buffered and periodically merged into centroids whose size is
+ * bounded by q(1-q) - small near the tails, where VaR lives. Memory stays
+ * O(compression) however many values are added; add() is amortized
+ * O(log compression).
+ */
+class TDigest {
+public:
+    explicit TDigest(double compression = 100);
+
+    void add(double value, double weight = 1.0);
+    void merge(const TDigest& other);
+    void clear();
+
+    double quantile(double q) const;  // q in [0, 1]
+    double tailMean(double q) const;  // Mean of the lowest q fraction of values
+    double getCount() const;
+    double getMin() const;
+    double getMax() const;
+    size_t getCentroidCount() const;
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    double compression_;
+    size_t bufferLimit_;
+    mutable std::vector<Centroid> centroids_;  // Sorted by mean
+    mutable std::vector<Centroid> buffer_;     // Not yet merged
+    mutable std::vector<Centroid> scratch_;    // Merge input, kept to avoid reallocating
+    double totalWeight_;
+    double min_;
+    double max_;
+
+    void flush() const;
+};
+
+/**
+ * @brief Streaming VaR, expected shortfall, volatility and drawdown
+ *
+ * Each return costs an amortized O(log compression) digest insert plus a
+ * Welford update; each equity point a running peak comparison. Queries never
+ * touch the return history, so they stay instant over years of data.
+ * VaR and ES are reported as positive loss fractions.
+ */
+class StreamingRiskEstimator {
+public:
+    explicit StreamingRiskEstimator(double compression = 100);
+
+    StreamingRiskEstimator(const StreamingRiskEstimator&) = delete;
+    StreamingRiskEstimator& operator=(const StreamingRiskEstimator&) = delete;
+
+    void addReturn(double periodReturn);
+    void addEquity(double equity);
+    void reset();
+
+    double getValueAtRisk(double confidence = 0.95) const;
+    double getExpectedShortfall(double confidence = 0.95) const;
+    double getMean() const;
+    double getVolatility() const;  // Sample standard deviation per period
+    double getSharpeRatio(double riskFreeRate = 0.02, int periodsPerYear = 252) const;
+    double getMaxDrawdown() const;
+    double getCurrentDrawdown() const;
+    uint64_t getReturnCount() const;
+
+private:
+    TDigest digest_;
+
+    // Welford running moments
+    uint64_t count_;
+    double mean_;
+    double m2_;
+
+    // Drawdown from the running equity peak
+    double equityPeak_;
+    double currentDrawdown_;
+    double maxDrawdown_;
+
+    mutable std::mutex estimatorMutex_;
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_STREAMING_RISK_ESTIMATOR_H
@@ -0,0 +1,141 @@
+#ifndef MASTERMIND_TIMER_WHEEL_H
+#define MASTERMIND_TIMER_WHEEL_H
+
+#include "Types.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MasterMind {
+
+using TimerId = uint64_t;
+
+/**
+ * @brief Hierarchical timer wheel shared by all core components
+ *
+ * A single service for pattern expiry, order timeouts, trailing stop checks,
+ * session events, counter resets and reconnect backoff. Four levels of 256
+ * slots cover 2^32 ticks (~497 days at the default 10ms resolution).
+ *
+ * - schedule() and cancel() are O(1) (intrusive slot lists over a node pool)
+ * - advance() processes all elapsed ticks in one batch and fires callbacks
+ *   outside the internal lock, so callbacks may schedule or cancel timers
+ * - cancel() also drops a callback already due in the batch but not yet
+ *   run; cancelSync() then waits for one that is running, after which the
+ *   callback's owner may go away
+ * - start() runs an internal driver thread; alternatively the owner can call
+ *   advance() itself (e.g. from a replayed tick stream in backtests)
+ */
+class TimerWheel {
+public:
+    using Callback = std::function<void()>;
+
+    static constexpr TimerId INVALID_TIMER = 0;
+
+    /**
+     * @brief Constructor
+     * @param tickInterval Wheel resolution (default: 10ms)
+     * @param epoch Time of tick zero (default: now); backtests pass the first replayed timestamp
+     */
+    explicit TimerWheel(Duration tickInterval = std::chrono::milliseconds(10),
+                        TimePoint epoch = TimePoint());
+
+    /**
+     * @brief Destructor
+     */
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Driver thread lifecycle
+    bool start();
+    void stop();
+    bool isRunning() const;
+
+    // Timer registration
+    TimerId schedule(Duration delay, Callback callback);
+    TimerId scheduleAt(TimePoint when, Callback callback);
+    TimerId scheduleRepeating(Duration interval, Callback callback,
+                              Duration initialDelay = Duration::zero());
+    bool cancel(TimerId timerId);
+    bool cancelSync(TimerId timerId);  // Not from the timer's own callback
+    bool isScheduled(TimerId timerId) const;
+
+    /**
+     * @brief Advance the wheel to the given time and fire expired timers
+     * @return Number of callbacks fired
+     */
+    size_t advance(TimePoint now);
+
+    // Monitoring
+    size_t getPendingCount() const;
+    Duration getTickInterval() const;
+    uint64_t getFiredCount() const;
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+    static constexpr uint32_t NIL = 0xFFFFFFFFu;
+
+    struct TimerNode {
+        Callback callback;
+        uint64_t expiryTick = 0;
+        uint64_t intervalTicks = 0;  // 0 for one-shot timers
+        uint32_t generation = 1;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+        uint16_t level = 0;
+        uint16_t slot = 0;
+        bool active = false;
+    };
+
+    Duration tickInterval_;
+    TimePoint epoch_;
+    uint64_t currentTick_;  // Next tick to be processed
+
+    std::vector<TimerNode> nodes_;
+    std::vector<uint32_t> freeList_;
+    std::array<std::array<uint32_t, SLOTS>, LEVELS> slots_;
+    size_t pendingCount_;
+
+    mutable std::mutex wheelMutex_;
+    std::mutex advanceMutex_;
+
+    // Due batch, run by advance() one callback at a time (guarded by wheelMutex_)
+    std::vector<std::pair<TimerId, Callback>> firing_;
+    size_t firingNext_;
+    TimerId firingTimer_;           // Callback running now
+    std::thread::id firingThread_;
+    std::condition_variable firedCV_;
+
+    std::thread driverThread_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> firedCount_;
+
+    // Private methods
+    TimerId scheduleTicks(uint64_t expiryTick, uint64_t intervalTicks, Callback callback);
+    uint64_t toTick(TimePoint when) const;
+    uint64_t toTicks(Duration delay) const;
+    uint32_t allocateNode();
+    void releaseNode(uint32_t index);
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    void cascade(int level, uint32_t slot);
+    void processTick();
+    bool dropFiring(TimerId timerId);
+    void driverWorker();
+
+    static TimerId makeId(uint32_t index, uint32_t generation);
+};
+
+} // namespace MasterMind
+
+#endif // MASTERMIND_TIMER_WHEEL_H
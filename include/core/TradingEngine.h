@@ -2,6 +2,7 @@
 #define MASTERMIND_TRADING_ENGINE_H
 
 #include "Types.h"
+#include "TimerWheel.h"
 #include "api/ExchangeAPI.h"
 #include <memory>
 #include <thread>
@@ -20,6 +21,9 @@ class RiskManager;
 class ConfigManager;
 class Logger;
 class DatabaseManager;
+class PersistenceQueue;
+class SimulatedExchangeAPI;
+class ConnectionSupervisor;
 
 /**
  * @brief Main trading engine that coordinates all components
@@ -56,7 +60,7 @@ public:
     
     // Market data handling
     void onTick(const Tick& tick);
-    void onOHLC(const OHLC& ohlc);
+    void onOHLC(const Symbol& symbol, const OHLC& ohlc);  // Completed bars only
     void processMarketData();
     
     // Signal and trading methods
@@ -83,6 +87,7 @@ public:
     TradingStats getTradingStats() const;
     
     // Exchange management
+    // After initialize(): the venue is routed by the order manager, which owns it
     bool addExchange(std::unique_ptr<ExchangeAPI> exchange);
     ExchangeAPI* getExchange(Exchange exchangeType) const;
     std::vector<Exchange> getActiveExchanges() const;
@@ -105,12 +110,20 @@ public:
     bool isWithinTradingSession(const Symbol& symbol) const;
     void setTradingSession(const Symbol& symbol, TimePoint start, TimePoint end);
     
+    // Shared timer service used by all components
+    TimerWheel* getTimerWheel() const;
+    
 private:
+    // Shared timer wheel - declared first so it outlives the components
+    // that cancel their timers on destruction
+    std::unique_ptr<TimerWheel> timerWheel_;
+    
     // Core components
     std::unique_ptr<ConfigManager> configManager_;
     std::unique_ptr<OrderManager> orderManager_;
     std::unique_ptr<RiskManager> riskManager_;
     std::unique_ptr<DatabaseManager> databaseManager_;
+    std::unique_ptr<PersistenceQueue> persistenceQueue_;  // Write-behind; destroyed (and drained) before the database
     // Removed logger_ member - using singleton instead
     
     // Pattern detection and charting
@@ -118,7 +131,10 @@ private:
     std::unique_ptr<PatternDetector> patternDetector_;
     
     // Exchange APIs
-    std::unordered_map<Exchange, std::unique_ptr<ExchangeAPI>> exchanges_;
+    std::unordered_map<Exchange, ExchangeAPI*> exchanges_;  // Live venues, owned by orderManager_
+    SimulatedExchangeAPI* simulatedExchange_;  // Paper-mode venue, owned by orderManager_
+    // Reconnects the venues above; declared after orderManager_ so it goes first
+    std::unique_ptr<ConnectionSupervisor> connectionSupervisor_;
     
     // Threading and synchronization
     std::thread marketDataThread_;
@@ -142,6 +158,7 @@ private:
     std::atomic<RiskStatus> riskStatus_;
     std::atomic<bool> paperMode_;
     std::atomic<double> currentDrawdown_;
+    TimerId riskUpdateTimer_ = TimerWheel::INVALID_TIMER;  // Feeds venue accounts to the risk manager
     
     // Callbacks
     TickCallback tickCallback_;
@@ -152,6 +169,17 @@ private:
     mutable std::mutex statsMutex_;
     TradingStats tradingStats_;
     
+    // Trading sessions (time-of-day windows, opened/closed by daily timers)
+    struct SessionState {
+        TimePoint start;
+        TimePoint end;
+        bool isOpen = false;
+        TimerId openTimer = TimerWheel::INVALID_TIMER;
+        TimerId closeTimer = TimerWheel::INVALID_TIMER;
+    };
+    std::unordered_map<Symbol, SessionState> sessions_;
+    mutable std::mutex sessionMutex_;
+    
     // Private methods
     void marketDataWorker();
     void patternDetectionWorker();
@@ -180,6 +208,8 @@ private:
     void handleConsecutiveLosses();
     
     // Session management helpers
+    void onSessionEvent(const Symbol& symbol, bool open);
+    void cancelSessionTimers(SessionState& session);
     bool isMarketOpen(const Symbol& symbol) const;
     TimePoint getNextTradingSession(const Symbol& symbol) const;
     
@@ -62,7 +62,8 @@ enum class Exchange {
     COINBASE,
     DELTA_EXCHANGE,
     MT4,
-    MT5
+    MT5,
+    SIMULATED   // In-process matching engine for paper trading and backtests
 };
 
 enum class RiskStatus {
@@ -225,13 +226,16 @@ struct InstrumentSpec {
     double tickValue;
     double contractSize;
     double marginRequirement;
+    double minOrderSize;
+    double maxOrderSize;
     int precision;
     bool isActive;
     std::string baseAsset;
     std::string quoteAsset;
     
     InstrumentSpec() : tickSize(0.0001), tickValue(1), contractSize(1), 
-                      marginRequirement(0.01), precision(5), isActive(true) {}
+                      marginRequirement(0.01), minOrderSize(0.01), maxOrderSize(1000000),
+                      precision(5), isActive(true) {}
 };
 
 // Configuration for each symbol
@@ -293,6 +297,7 @@ struct TradingStats {
 // Callback function types
 using TickCallback = std::function<void(const Tick&)>;
 using OrderCallback = std::function<void(const Order&)>;
+using FillCallback = std::function<void(const OrderId&, Volume, Price)>;
 using SignalCallback = std::function<void(const TradingSignal&)>;
 
 } // namespace MasterMind
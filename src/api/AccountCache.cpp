@@ -0,0 +1,273 @@
+#include "api/AccountCache.h"
+#include "core/SeqLock.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MasterMind {
+
+namespace {
+constexpr double QUANTITY_EPSILON = 1e-9;
+
+int64_t toMillis(TimePoint time) {
+    if (time == TimePoint()) {
+        time = std::chrono::system_clock::now();
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+TimePoint fromMillis(int64_t millis) {
+    return TimePoint(std::chrono::milliseconds(millis));
+}
+}
+
+AccountCache::AccountCache(const Currency& currency)
+    : currency_(currency), account_(new AccountState), balances_(new BalanceState[SymbolRegistry::CAPACITY]),
+      positions_(new PositionState[SymbolRegistry::CAPACITY]), version_(0) {
+}
+
+void AccountCache::setCurrency(const Currency& currency) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    currency_ = currency;
+}
+
+bool AccountCache::updateAccount(const AccountInfo& account) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return writeAccount(account.balance, account.equity, account.margin, account.freeMargin, account.marginLevel,
+                        account.unrealizedPnL, account.realizedPnL, account.lastUpdate);
+}
+
+bool AccountCache::updateBalance(const std::string& asset, double free, double locked, TimePoint time) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    SymbolRegistry::SlotId slot = assets_.registerSymbol(asset);
+    if (slot == SymbolRegistry::INVALID_SLOT) {
+        return false;
+    }
+
+    BalanceState& state = balances_[slot];
+    int64_t millis = toMillis(time);
+    if (millis < state.updateMillis.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    state.updateMillis.store(millis, std::memory_order_relaxed);
+    bool changed = state.free.load(std::memory_order_relaxed) != free ||
+                   state.locked.load(std::memory_order_relaxed) != locked;
+    if (changed) {
+        SeqLock::beginWrite(state.sequence);
+        state.free.store(free, std::memory_order_relaxed);
+        state.locked.store(locked, std::memory_order_relaxed);
+        SeqLock::endWrite(state.sequence);
+        version_.fetch_add(1, std::memory_order_release);
+    }
+
+    if (asset != currency_) {
+        return changed;
+    }
+    // Cash account: the quote asset is the balance, locked funds the margin
+    double balance = free + locked;
+    double unrealized = account_->unrealizedPnL.load(std::memory_order_relaxed);
+    double margin = locked;  // No leverage, so no margin level
+    return writeAccount(balance, balance + unrealized, margin, free, 0, unrealized, account_->realizedPnL.load(std::memory_order_relaxed), time) || changed;
+}
+
+bool AccountCache::updatePosition(const Position& position) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    SymbolRegistry::SlotId slot = symbols_.registerSymbol(position.symbol);
+    if (slot == SymbolRegistry::INVALID_SLOT) {
+        return false;
+    }
+    double quantity = position.side == OrderSide::SELL ? -position.quantity : position.quantity;
+    return writePosition(positions_[slot], quantity, position.averagePrice, position.currentPrice,
+                         position.realizedPnL, position.updateTime);
+}
+
+bool AccountCache::applyFill(const Symbol& symbol, OrderSide side, Volume quantity, Price price, TimePoint time) {
+    if (quantity <= 0 || price <= 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    SymbolRegistry::SlotId slot = symbols_.registerSymbol(symbol);
+    if (slot == SymbolRegistry::INVALID_SLOT) {
+        return false;
+    }
+
+    PositionState& state = positions_[slot];
+    double position = state.quantity.load(std::memory_order_relaxed);
+    double average = state.averagePrice.load(std::memory_order_relaxed);
+    double realized = state.realizedPnL.load(std::memory_order_relaxed);
+    double delta = side == OrderSide::BUY ? quantity : -quantity;
+    double updated = position + delta;
+
+    if (position == 0 || (position > 0) == (delta > 0)) {
+        average = (std::abs(position) * average + quantity * price) / std::abs(updated);
+    } else {
+        // Reducing: realize P&L on the closed part, a flip opens the rest at the fill price
+        double closed = std::min(quantity, std::abs(position));
+        realized += closed * (price - average) * (position > 0 ? 1.0 : -1.0);
+        if (std::abs(updated) < QUANTITY_EPSILON) {
+            updated = 0;
+            average = 0;
+        } else if ((updated > 0) != (position > 0)) {
+            average = price;
+        }
+    }
+    return writePosition(state, updated, average, price, realized, time);
+}
+
+void AccountCache::reset() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    writeAccount(0, 0, 0, 0, 0, 0, 0, TimePoint());
+    for (size_t slot = 0; slot < assets_.size(); ++slot) {
+        BalanceState& state = balances_[slot];
+        SeqLock::beginWrite(state.sequence);
+        state.free.store(0, std::memory_order_relaxed);
+        state.locked.store(0, std::memory_order_relaxed);
+        state.updateMillis.store(0, std::memory_order_relaxed);
+        SeqLock::endWrite(state.sequence);
+    }
+    for (size_t slot = 0; slot < symbols_.size(); ++slot) {
+        writePosition(positions_[slot], 0, 0, 0, 0, TimePoint());
+    }
+    version_.store(0, std::memory_order_release);  // Uninitialized until the next load
+}
+
+AccountInfo AccountCache::getAccountInfo() const {
+    AccountInfo account;
+    account.currency = currency_;
+    int64_t updateMillis;
+    uint32_t begin;
+    do {
+        begin = SeqLock::beginRead(account_->sequence);
+        account.balance = account_->balance.load(std::memory_order_relaxed);
+        account.equity = account_->equity.load(std::memory_order_relaxed);
+        account.margin = account_->margin.load(std::memory_order_relaxed);
+        account.freeMargin = account_->freeMargin.load(std::memory_order_relaxed);
+        account.marginLevel = account_->marginLevel.load(std::memory_order_relaxed);
+        account.unrealizedPnL = account_->unrealizedPnL.load(std::memory_order_relaxed);
+        account.realizedPnL = account_->realizedPnL.load(std::memory_order_relaxed);
+        updateMillis = account_->updateMillis.load(std::memory_order_relaxed);
+    } while (!SeqLock::endRead(account_->sequence, begin));
+    account.lastUpdate = fromMillis(updateMillis);
+    return account;
+}
+
+bool AccountCache::getAssetBalance(const std::string& asset, double& free, double& locked) const {
+    SymbolRegistry::SlotId slot = assets_.find(asset);
+    if (slot == SymbolRegistry::INVALID_SLOT) {
+        free = locked = 0;
+        return false;
+    }
+
+    const BalanceState& state = balances_[slot];
+    uint32_t begin;
+    do {
+        begin = SeqLock::beginRead(state.sequence);
+        free = state.free.load(std::memory_order_relaxed);
+        locked = state.locked.load(std::memory_order_relaxed);
+    } while (!SeqLock::endRead(state.sequence, begin));
+    return true;
+}
+
+Position AccountCache::getPosition(const Symbol& symbol) const {
+    SymbolRegistry::SlotId slot = symbols_.find(symbol);
+    if (slot == SymbolRegistry::INVALID_SLOT) {
+        Position position;
+        position.symbol = symbol;
+        return position;
+    }
+    return readPosition(symbol, positions_[slot]);
+}
+
+std::vector<Position> AccountCache::getPositions() const {
+    std::vector<Position> positions;
+    size_t count = symbols_.size();
+    for (size_t slot = 0; slot < count; ++slot) {
+        if (positions_[slot].quantity.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        positions.push_back(readPosition(symbols_.getSymbol(static_cast<SymbolRegistry::SlotId>(slot)), positions_[slot]));
+    }
+    return positions;
+}
+
+// Private methods
+bool AccountCache::writeAccount(double balance, double equity, double margin, double freeMargin,
+                                double marginLevel, double unrealizedPnL, double realizedPnL, TimePoint time) {
+    bool changed = account_->balance.load(std::memory_order_relaxed) != balance ||
+                   account_->equity.load(std::memory_order_relaxed) != equity ||
+                   account_->margin.load(std::memory_order_relaxed) != margin ||
+                   account_->freeMargin.load(std::memory_order_relaxed) != freeMargin ||
+                   account_->marginLevel.load(std::memory_order_relaxed) != marginLevel ||
+                   account_->unrealizedPnL.load(std::memory_order_relaxed) != unrealizedPnL ||
+                   account_->realizedPnL.load(std::memory_order_relaxed) != realizedPnL;
+    bool first = version_.load(std::memory_order_relaxed) == 0;
+    if (!changed && !first) {
+        return false;
+    }
+
+    SeqLock::beginWrite(account_->sequence);
+    account_->balance.store(balance, std::memory_order_relaxed);
+    account_->equity.store(equity, std::memory_order_relaxed);
+    account_->margin.store(margin, std::memory_order_relaxed);
+    account_->freeMargin.store(freeMargin, std::memory_order_relaxed);
+    account_->marginLevel.store(marginLevel, std::memory_order_relaxed);
+    account_->unrealizedPnL.store(unrealizedPnL, std::memory_order_relaxed);
+    account_->realizedPnL.store(realizedPnL, std::memory_order_relaxed);
+    account_->updateMillis.store(toMillis(time), std::memory_order_relaxed);
+    SeqLock::endWrite(account_->sequence);
+    version_.fetch_add(1, std::memory_order_release);
+    return true;  // The first load counts as a change, even of an empty account
+}
+
+bool AccountCache::writePosition(PositionState& state, double quantity, double averagePrice, double currentPrice,
+                                 double realizedPnL, TimePoint time) {
+    double previous = state.quantity.load(std::memory_order_relaxed);
+    bool changed = previous != quantity ||
+                   state.averagePrice.load(std::memory_order_relaxed) != averagePrice ||
+                   state.currentPrice.load(std::memory_order_relaxed) != currentPrice ||
+                   state.realizedPnL.load(std::memory_order_relaxed) != realizedPnL;
+    if (!changed) {
+        return false;
+    }
+
+    int64_t millis = toMillis(time);
+    SeqLock::beginWrite(state.sequence);
+    state.quantity.store(quantity, std::memory_order_relaxed);
+    state.averagePrice.store(averagePrice, std::memory_order_relaxed);
+    state.currentPrice.store(currentPrice, std::memory_order_relaxed);
+    state.realizedPnL.store(realizedPnL, std::memory_order_relaxed);
+    if (previous == 0 && quantity != 0) {
+        state.openMillis.store(millis, std::memory_order_relaxed);
+    }
+    state.updateMillis.store(millis, std::memory_order_relaxed);
+    SeqLock::endWrite(state.sequence);
+    version_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+Position AccountCache::readPosition(const Symbol& symbol, const PositionState& state) const {
+    Position position;
+    position.symbol = symbol;
+    double quantity;
+    int64_t openMillis;
+    int64_t updateMillis;
+    uint32_t begin;
+    do {
+        begin = SeqLock::beginRead(state.sequence);
+        quantity = state.quantity.load(std::memory_order_relaxed);
+        position.averagePrice = state.averagePrice.load(std::memory_order_relaxed);
+        position.currentPrice = state.currentPrice.load(std::memory_order_relaxed);
+        position.realizedPnL = state.realizedPnL.load(std::memory_order_relaxed);
+        openMillis = state.openMillis.load(std::memory_order_relaxed);
+        updateMillis = state.updateMillis.load(std::memory_order_relaxed);
+    } while (!SeqLock::endRead(state.sequence, begin));
+
+    position.side = quantity < 0 ? OrderSide::SELL : OrderSide::BUY;
+    position.quantity = std::abs(quantity);
+    position.unrealizedPnL = quantity * (position.currentPrice - position.averagePrice);
+    position.openTime = fromMillis(openMillis);
+    position.updateTime = fromMillis(updateMillis);
+    return position;
+}
+
+} // namespace MasterMind
@@ -1,28 +1,65 @@
 #include "api/BinanceAPI.h"
+#include "api/BinanceMessages.h"
+#include "api/HttpClient.h"
+#include "api/VenueCodec.h"
+#include "api/WebSocketClient.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <iostream>
-#include <sstream>
-#include <iomanip>
-#ifdef SSL_ENABLED
-#include <openssl/hmac.h>
-#include <openssl/sha.h>
-#endif
 #include <chrono>
-// Removed json/json.h dependency
+#include <cstdio>
 
 namespace MasterMind {
 
-BinanceAPI::BinanceAPI() : RestExchangeAPI(Exchange::BINANCE) {
+namespace {
+// Binance drops a listenKey after 60 minutes without a keep-alive
+constexpr auto LISTEN_KEY_KEEPALIVE = std::chrono::minutes(30);
+constexpr auto USER_STREAM_RETRY = std::chrono::seconds(5);
+}
+
+BinanceAPI::BinanceAPI()
+    : ExchangeAPI(Exchange::BINANCE), RestExchangeAPI(Exchange::BINANCE), WebSocketExchangeAPI(Exchange::BINANCE),
+      keepAliveTimer_(TimerWheel::INVALID_TIMER), keepAliveRunning_(false), keepAliveBusy_(false),
+      userStreamStale_(false), authenticationWanted_(false) {
     baseUrl_ = "https://api.binance.com";
+    setCodec(std::make_unique<BinanceCodec>());
+    
+    // Binance's published limits; TradingEngine applies the configured request weight over these
+    RateLimitConfig limits(1200, std::chrono::seconds(60));
+    limits.orderLimit = 50;
+    limits.orderWindow = std::chrono::seconds(10);
+    setRateLimit(limits);
+    
+    // Known until exchangeInfo replaces it on connect
+    InstrumentSpec btcusdt;
+    btcusdt.symbol = "BTCUSDT";
+    btcusdt.assetClass = AssetClass::CRYPTO;
+    btcusdt.tickSize = 0.01;
+    btcusdt.minOrderSize = 0.00001;
+    btcusdt.maxOrderSize = 1000.0;
+    btcusdt.baseAsset = "BTC";
+    btcusdt.quoteAsset = "USDT";
+    instrumentRegistry_.publish({btcusdt});
+    instrumentRegistry_.setLoader([this](std::vector<InstrumentSpec>& specs) {
+        auto response = makeRequest("/api/v3/exchangeInfo", "GET");
+        return !response.empty() && BinanceMessageParser::parseExchangeInfo(response.data(), response.size(), specs);
+    });
     std::cout << "BinanceAPI initialized" << std::endl;
 }
 
 BinanceAPI::~BinanceAPI() {
+    instrumentRegistry_.stopRefresh();
+    stopUserDataStream();
     disconnect();
+    disconnectWebSocket();
+    closeHttpClient();  // Pending order callbacks run before the object goes away
 }
 
 bool BinanceAPI::connect() {
     std::lock_guard<std::mutex> lock(connectionMutex_);
     
+    sessionWanted_ = true;
     if (connected_) {
         return true;
     }
@@ -31,25 +68,34 @@ bool BinanceAPI::connect() {
         // Test connectivity
         auto response = makeRequest("/api/v3/ping", "GET");
         if (response.empty()) {
-            lastError_ = "Failed to ping Binance API";
+            setError("Failed to ping Binance API");
             return false;
         }
         
         // Get server time
         response = makeRequest("/api/v3/time", "GET");
         if (response.empty()) {
-            lastError_ = "Failed to get server time";
+            setError("Failed to get server time");
             return false;
         }
         
+        // Instruments: loaded now, refreshed in the background
+        if (!instrumentRegistry_.startRefresh(std::chrono::hours(1), maintenanceTimers())) {
+            std::cout << "Binance exchangeInfo unavailable, keeping "
+                      << instrumentRegistry_.current()->size() << " known instruments" << std::endl;
+        }
+        
         connected_ = true;
         clearErrors();
         
         std::cout << "Connected to Binance API" << std::endl;
+        if (authenticated_ && !startUserDataStream()) {
+            std::cout << "Binance user data stream unavailable: " << getLastError() << std::endl;
+        }
         return true;
         
     } catch (const std::exception& e) {
-        lastError_ = std::string("Connection error: ") + e.what();
+        setError(std::string("Connection error: ") + e.what());
         connected_ = false;
         return false;
     }
@@ -58,12 +104,17 @@ bool BinanceAPI::connect() {
 bool BinanceAPI::disconnect() {
     std::lock_guard<std::mutex> lock(connectionMutex_);
     
+    sessionWanted_ = false;
     if (!connected_) {
         return true;
     }
     
     connected_ = false;
     authenticated_ = false;
+    instrumentRegistry_.stopRefresh();
+    stopUserDataStream();
+    accountCache_.reset();  // Stale without the stream; getters fall back to REST
+    disconnectWebSocket();
     
     std::cout << "Disconnected from Binance API" << std::endl;
     return true;
@@ -78,35 +129,61 @@ bool BinanceAPI::reconnect() {
     return connect();
 }
 
+bool BinanceAPI::isSessionLost() const {
+    return sessionWanted_ && (!connected_ || (authenticationWanted_ && !authenticated_));
+}
+
+bool BinanceAPI::restoreSession() {
+    if (!connect()) {
+        return false;
+    }
+    if (!authenticationWanted_ || authenticated_) {
+        return true;  // connect() reopened the user-data stream of an authenticated session
+    }
+    
+    // disconnect() dropped the authentication along with the user-data stream
+    std::string apiKey = apiKey_;
+    std::string apiSecret = apiSecret_;
+    return authenticate(apiKey, apiSecret);
+}
+
 bool BinanceAPI::authenticate(const std::string& apiKey, 
                             const std::string& apiSecret,
                             const std::string& passphrase) {
     
     apiKey_ = apiKey;
     apiSecret_ = apiSecret;
+    signer_.setSecret(apiSecret_);
     
     if (apiKey_.empty() || apiSecret_.empty()) {
-        lastError_ = "API key and secret are required";
+        setError("API key and secret are required");
         return false;
     }
+    refreshAuthHeader();
     
     try {
         // Test authentication with account info request
         auto response = makeAuthenticatedRequest("/api/v3/account", "GET");
-        if (response.empty()) {
-            lastError_ = "Authentication failed";
+        int code = 0;
+        std::string message;
+        if (response.empty() || BinanceMessageParser::parseError(response.data(), response.size(), code, message)) {
+            setError(message.empty() ? "Authentication failed" : "Authentication failed (" + std::to_string(code) + "): " + message);
             authenticated_ = false;
             return false;
         }
         
         authenticated_ = true;
+        authenticationWanted_ = true;
         clearErrors();
         
         std::cout << "Authenticated with Binance API" << std::endl;
+        if (connected_ && !startUserDataStream()) {
+            std::cout << "Binance user data stream unavailable: " << getLastError() << std::endl;
+        }
         return true;
         
     } catch (const std::exception& e) {
-        lastError_ = std::string("Authentication error: ") + e.what();
+        setError(std::string("Authentication error: ") + e.what());
         authenticated_ = false;
         return false;
     }
@@ -116,37 +193,86 @@ bool BinanceAPI::isAuthenticated() const {
     return authenticated_;
 }
 
+bool BinanceAPI::startUserDataStream() {
+    bool opened;
+    {
+        std::lock_guard<std::mutex> lock(userStreamMutex_);
+        opened = isUserDataStreamConnected() || openUserStream();
+    }
+    {
+        // A stream that failed to open is retried by the keep-alive timer like a dropped one
+        std::lock_guard<std::mutex> lock(keepAliveMutex_);
+        userStreamStale_ = !opened;
+        if (!keepAliveRunning_) {
+            keepAliveRunning_ = true;
+            scheduleKeepAlive(opened ? Duration(LISTEN_KEY_KEEPALIVE) : Duration::zero());
+        }
+    }
+    if (opened) {
+        // After subscribing, so no change can fall between the snapshot and the stream
+        loadAccount();
+    }
+    return opened;
+}
+
+void BinanceAPI::stopUserDataStream() {
+    TimerId keepAlive;
+    {
+        std::lock_guard<std::mutex> lock(keepAliveMutex_);
+        keepAliveRunning_ = false;
+        keepAlive = keepAliveTimer_;
+        keepAliveTimer_ = TimerWheel::INVALID_TIMER;
+    }
+    // Waits out a run that has fired but not yet marked itself busy, then one that has
+    maintenanceTimers().cancelSync(keepAlive);
+    {
+        std::unique_lock<std::mutex> lock(keepAliveMutex_);
+        keepAliveDone_.wait(lock, [this]() { return !keepAliveBusy_; });
+    }
+    
+    std::lock_guard<std::mutex> lock(userStreamMutex_);
+    if (userStream_) {
+        userStream_->disconnect();
+    }
+    if (!listenKey_.empty()) {
+        makeRequest("/api/v3/userDataStream", "DELETE", "listenKey=" + listenKey_);
+        listenKey_.clear();
+        std::cout << "Binance user data stream closed" << std::endl;
+    }
+}
+
+bool BinanceAPI::isUserDataStreamConnected() const {
+    return userStream_ && userStream_->isConnected();
+}
+
 bool BinanceAPI::subscribeMarketData(const std::vector<Symbol>& symbols) {
-    // For now, return true as stub implementation
-    // In full implementation, this would establish WebSocket connections
-    std::cout << "Subscribed to market data for " << symbols.size() << " symbols" << std::endl;
-    return true;
+    return subscribeStreams(symbols);
 }
 
 bool BinanceAPI::unsubscribeMarketData(const std::vector<Symbol>& symbols) {
-    std::cout << "Unsubscribed from market data for " << symbols.size() << " symbols" << std::endl;
-    return true;
+    return unsubscribeStreams(symbols);
 }
 
 Tick BinanceAPI::getLastTick(const Symbol& symbol) const {
+    Tick streamed;
+    if (getStreamTick(symbol, streamed)) {
+        return streamed;
+    }
+    
     try {
         std::string endpoint = "/api/v3/ticker/24hr?symbol=" + symbol;
         auto response = makeRequest(endpoint, "GET");
         
-        // Parse JSON response and convert to Tick
-        // This is a simplified implementation
         Tick tick;
-        tick.symbol = symbol;
-        tick.timestamp = std::chrono::system_clock::now();
-        tick.bid = 0.0;
-        tick.ask = 0.0;
-        tick.last = 0.0;
-        tick.volume = 0.0;
+        if (!BinanceMessageParser::parseTicker(response.data(), response.size(), tick)) {
+            setError("Failed to parse ticker for " + symbol);
+            tick = Tick(symbol, 0.0, 0.0, 0.0, 0.0, std::chrono::system_clock::now());
+        }
         
         return tick;
         
     } catch (const std::exception& e) {
-        lastError_ = std::string("Failed to get tick data: ") + e.what();
+        setError(std::string("Failed to get tick data: ") + e.what());
         return Tick{};
     }
 }
@@ -163,54 +289,150 @@ std::vector<OHLC> BinanceAPI::getHistoricalData(const Symbol& symbol,
 
 OrderId BinanceAPI::placeOrder(const Order& order) {
     if (!isAuthenticated()) {
-        lastError_ = "Not authenticated";
+        setError("Not authenticated");
         return "";
     }
     
+    // Known by the caller's id, as with placeOrderAsync and the user stream
+    OrderId clientOrderId = clientOrderIdFor(order);
+    trackOrder(clientOrderId, order.symbol);
     try {
-        std::ostringstream params;
-        params << "symbol=" << order.symbol;
-        params << "&side=" << (order.side == OrderSide::BUY ? "BUY" : "SELL");
-        params << "&type=" << getOrderTypeString(order.type);
-        params << "&quantity=" << std::fixed << std::setprecision(8) << order.quantity;
-        
-        if (order.type == OrderType::LIMIT) {
-            params << "&price=" << std::fixed << std::setprecision(8) << order.price;
-            params << "&timeInForce=GTC";
+        auto response = makeAuthenticatedRequest("/api/v3/order", "POST", buildOrderParams(order, clientOrderId));
+        if (response.empty()) {
+            untrackOrder(clientOrderId);
+            return "";  // Transport failure, lastError_ already set
         }
         
-        auto response = makeAuthenticatedRequest("/api/v3/order", "POST", params.str());
+        BinanceOrderAck ack;
+        if (BinanceMessageParser::parseOrderAck(response.data(), response.size(), ack)) {
+            std::cout << "Order placed successfully on Binance: " << clientOrderId
+                      << " (exchange id " << ack.order.orderId << ")" << std::endl;
+            return clientOrderId;
+        }
         
-        if (!response.empty()) {
-            // Parse response to extract order ID
-            // This is simplified - in real implementation, parse JSON
-            std::cout << "Order placed successfully on Binance" << std::endl;
-            return generateOrderId();
+        untrackOrder(clientOrderId);
+        int code = 0;
+        std::string message;
+        if (BinanceMessageParser::parseError(response.data(), response.size(), code, message)) {
+            setError("Order rejected (" + std::to_string(code) + "): " + message);
+            return "";
         }
         
-        lastError_ = "Failed to place order";
+        setError("Failed to place order");
         return "";
         
     } catch (const std::exception& e) {
-        lastError_ = std::string("Order placement error: ") + e.what();
+        untrackOrder(clientOrderId);
+        setError(std::string("Order placement error: ") + e.what());
         return "";
     }
 }
 
+OrderId BinanceAPI::placeOrderAsync(const Order& order) {
+    if (!isAuthenticated()) {
+        setError("Not authenticated");
+        return "";
+    }
+    
+    OrderId clientOrderId = clientOrderIdFor(order);
+    trackOrder(clientOrderId, order.symbol);
+    std::shared_ptr<HttpClient> client = getHttpClient();
+    getRateLimiter().submit(RequestPriority::NEW_ORDER, requestWeight("POST", "/api/v3/order", ""), 1,
+                            [this, client, order, clientOrderId](bool admitted) {
+        if (!admitted) {
+            rejectOrder(order, clientOrderId, "Refused by rate limiter");
+            return;
+        }
+        // Signed on admission, so time spent queued does not eat into recvWindow
+        std::string params = signParams(buildOrderParams(order, clientOrderId));
+        client->request("POST", "/api/v3/order", "", params, [this, order, clientOrderId](const HttpResponse& response) {
+            applyRateLimitFeedback(response);
+            BinanceOrderAck ack;
+            if (response.error.empty() &&
+                BinanceMessageParser::parseOrderAck(response.body.data(), response.body.size(), ack)) {
+                ack.order.orderId = clientOrderId;
+                notifyOrderUpdate(ack.order);
+                return;
+            }
+            
+            int code = 0;
+            std::string message = response.error;
+            BinanceMessageParser::parseError(response.body.data(), response.body.size(), code, message);
+            rejectOrder(order, clientOrderId, message);
+        });
+    });
+    return clientOrderId;
+}
+
 bool BinanceAPI::cancelOrder(const OrderId& orderId) {
     if (!isAuthenticated()) {
-        lastError_ = "Not authenticated";
+        setError("Not authenticated");
+        return false;
+    }
+    TrackedOrder tracked;
+    if (!findTrackedOrder(orderId, tracked)) {
+        setError("Unknown or completed order " + orderId);
         return false;
     }
     
+    // DELETE travels in the cancel lane, ahead of queued new orders
+    std::string params = "symbol=" + tracked.symbol + "&origClientOrderId=" + tracked.venueId;
+    auto response = makeAuthenticatedRequest("/api/v3/order", "DELETE", params);
+    if (response.empty()) {
+        return false;
+    }
+    
+    int code = 0;
+    std::string message;
+    if (BinanceMessageParser::parseError(response.data(), response.size(), code, message)) {
+        setError("Cancel of " + orderId + " rejected (" + std::to_string(code) + "): " + message);
+        return false;
+    }
+    untrackOrder(orderId);
     std::cout << "Order cancelled: " << orderId << std::endl;
     return true;
 }
 
 bool BinanceAPI::modifyOrder(const OrderId& orderId, const Order& newOrder) {
-    // Binance doesn't support direct order modification
-    // Implementation would cancel and replace
-    std::cout << "Order modification requested: " << orderId << std::endl;
+    if (!isAuthenticated()) {
+        setError("Not authenticated");
+        return false;
+    }
+    TrackedOrder tracked;
+    if (!findTrackedOrder(orderId, tracked)) {
+        setError("Unknown or completed order " + orderId);
+        return false;
+    }
+    
+    // No amend for price or size up: cancel-replace in one request, and only
+    // place the replacement once the cancel has gone through
+    Order replacement = newOrder;
+    replacement.symbol = tracked.symbol;
+    std::string venueId = generateOrderId();
+    std::string params = buildOrderParams(replacement, venueId);
+    params.append("&cancelReplaceMode=STOP_ON_FAILURE&cancelOrigClientOrderId=").append(tracked.venueId);
+    auto response = makeAuthenticatedRequest("/api/v3/order/cancelReplace", "POST", params);
+    if (response.empty()) {
+        return false;
+    }
+    
+    int code = 0;
+    std::string message;
+    if (BinanceMessageParser::parseError(response.data(), response.size(), code, message)) {
+        // A cancel that went through with a failed replacement reports itself on the user stream
+        setError("Modify of " + orderId + " rejected (" + std::to_string(code) + "): " + message);
+        return false;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(trackedOrdersMutex_);
+        auto it = trackedOrders_.find(orderId);
+        if (it != trackedOrders_.end()) {
+            it->second.venueId = venueId;  // The old leg stays mapped until its cancel is reported
+            replacementIds_[venueId] = orderId;
+        }
+    }
+    std::cout << "Order modified: " << orderId << " (now " << venueId << " on Binance)" << std::endl;
     return true;
 }
 
@@ -231,13 +453,12 @@ std::vector<Order> BinanceAPI::getOrderHistory(const Symbol& symbol, int limit)
 }
 
 std::vector<Position> BinanceAPI::getPositions() const {
-    std::vector<Position> positions;
-    return positions;
+    return accountCache_.getPositions();
 }
 
 Position BinanceAPI::getPosition(const Symbol& symbol) const {
-    Position position;
-    position.symbol = symbol;
+    Position position = accountCache_.getPosition(symbol);
+    position.exchange = "BINANCE";
     return position;
 }
 
@@ -252,63 +473,62 @@ bool BinanceAPI::closeAllPositions() {
 }
 
 AccountInfo BinanceAPI::getAccountInfo() const {
+    if (accountCache_.isInitialized()) {
+        return accountCache_.getAccountInfo();
+    }
+    
+    // Not loaded yet: ask the venue, without caching what may already be stale
     AccountInfo account;
-    account.balance = 10000.0;  // Placeholder
-    account.equity = 10000.0;
-    account.margin = 0.0;
-    account.freeMargin = 10000.0;
+    account.currency = accountCache_.getCurrency();
+    BinanceAccount parsed;
+    if (!fetchAccount(parsed)) {
+        return account;
+    }
+    
+    // Spot has no margin: report the quote asset, with locked funds as margin
+    for (const auto& balance : parsed.balances) {
+        if (balance.asset == account.currency) {
+            account.balance = balance.free + balance.locked;
+            account.equity = account.balance;
+            account.margin = balance.locked;
+            account.freeMargin = balance.free;
+            break;
+        }
+    }
+    account.lastUpdate = parsed.updateTime;
     return account;
 }
 
 double BinanceAPI::getBalance() const {
-    return getAccountInfo().balance;
+    return accountCache_.isInitialized() ? accountCache_.getBalance() : getAccountInfo().balance;
 }
 
 double BinanceAPI::getEquity() const {
-    return getAccountInfo().equity;
+    return accountCache_.isInitialized() ? accountCache_.getEquity() : getAccountInfo().equity;
 }
 
 double BinanceAPI::getMargin() const {
-    return getAccountInfo().margin;
+    return accountCache_.isInitialized() ? accountCache_.getMargin() : getAccountInfo().margin;
 }
 
 double BinanceAPI::getFreeMargin() const {
-    return getAccountInfo().freeMargin;
+    return accountCache_.isInitialized() ? accountCache_.getFreeMargin() : getAccountInfo().freeMargin;
 }
 
 std::vector<InstrumentSpec> BinanceAPI::getInstruments() const {
-    std::vector<InstrumentSpec> instruments;
-    
-    // Add some common instruments
-    InstrumentSpec btcusdt;
-    btcusdt.symbol = "BTCUSDT";
-    btcusdt.assetClass = AssetClass::CRYPTO;
-    btcusdt.tickSize = 0.01;
-    btcusdt.minOrderSize = 0.00001;
-    btcusdt.maxOrderSize = 1000.0;
-    instruments.push_back(btcusdt);
-    
-    return instruments;
+    // Copies the whole list: hold the snapshot rather than rely on the retire grace
+    return instrumentRegistry_.acquire()->getInstruments();
 }
 
 InstrumentSpec BinanceAPI::getInstrumentSpec(const Symbol& symbol) const {
-    auto instruments = getInstruments();
-    for (const auto& instrument : instruments) {
-        if (instrument.symbol == symbol) {
-            return instrument;
-        }
-    }
-    return InstrumentSpec{};
+    std::shared_ptr<const InstrumentSnapshot> snapshot = instrumentRegistry_.acquire();
+    const InstrumentSpec* spec = snapshot->find(symbol);
+    return spec ? *spec : InstrumentSpec{};
 }
 
 bool BinanceAPI::isSymbolAvailable(const Symbol& symbol) const {
-    auto instruments = getInstruments();
-    for (const auto& instrument : instruments) {
-        if (instrument.symbol == symbol) {
-            return true;
-        }
-    }
-    return false;
+    const InstrumentSpec* spec = instrumentRegistry_.find(symbol);
+    return spec && spec->isActive;
 }
 
 std::string BinanceAPI::getExchangeName() const {
@@ -345,10 +565,12 @@ double BinanceAPI::calculateMarginRequirement(const Order& order) const {
 }
 
 std::string BinanceAPI::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
     return lastError_;
 }
 
 void BinanceAPI::clearErrors() {
+    std::lock_guard<std::mutex> lock(errorMutex_);
     lastError_.clear();
 }
 
@@ -372,67 +594,440 @@ bool BinanceAPI::validateOrder(const Order& order) const {
 std::string BinanceAPI::makeRequest(const std::string& endpoint, 
                                    const std::string& method,
                                    const std::string& params) const {
-    // Simplified HTTP request implementation
-    // In real implementation, use libcurl or similar
-    std::cout << "Making " << method << " request to " << endpoint << std::endl;
-    return "{}"; // Placeholder JSON response
+    // Parameters travel in the query string, or in the body for POST/PUT
+    std::string path = endpoint;
+    std::string query;
+    size_t queryStart = endpoint.find('?');
+    if (queryStart != std::string::npos) {
+        path = endpoint.substr(0, queryStart);
+        query = endpoint.substr(queryStart + 1);
+    }
+    std::string body;
+    if (method == "POST" || method == "PUT") {
+        body = params;
+    } else if (!params.empty()) {
+        query.append(query.empty() ? "" : "&").append(params);
+    }
+    
+    uint32_t orders = (method == "POST" && (path == "/api/v3/order" || path == "/api/v3/order/cancelReplace")) ? 1 : 0;
+    if (!getRateLimiter().acquire(requestPriority(method, path), requestWeight(method, path, query), orders)) {
+        setError(method + " " + path + " refused by rate limiter");
+        return "";
+    }
+    
+    HttpResponse response = getHttpClient()->request(method, path, query, body).get();
+    applyRateLimitFeedback(response);
+    if (!response.error.empty()) {
+        setError(method + " " + path + " failed: " + response.error);
+        return "";
+    }
+    return response.body;  // Error statuses carry {"code":...,"msg":...}
 }
 
 std::string BinanceAPI::makeAuthenticatedRequest(const std::string& endpoint,
                                                const std::string& method,
                                                const std::string& params) const {
     
-    if (!isAuthenticated()) {
+    // Checks credentials rather than isAuthenticated(): authenticate() itself signs a request
+    if (apiKey_.empty() || apiSecret_.empty()) {
         return "";
     }
     
-    // Add timestamp and signature
+    if (method != "GET") {
+        return makeRequest(endpoint, method, signParams(params));
+    }
+    // Callers asking for the same data at once (account, open orders) share one request
+    return coalesce(endpoint + '?' + params, [this, &endpoint, &method, &params]() {
+        return makeRequest(endpoint, method, signParams(params));
+    });
+}
+
+const std::string& BinanceAPI::signParams(const std::string& params) const {
     auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
+    return signer_.signParams(params, timestamp);
+}
+
+std::string BinanceAPI::buildAuthHeader() const {
+    return "X-MBX-APIKEY: " + apiKey_;
+}
+
+std::string BinanceAPI::signRequest(const std::string& request) const {
+    // HMAC SHA256 signature, hex encoded
+    return signer_.sign(request);
+}
+
+void BinanceAPI::onWebSocketConnect() {
+    std::cout << "Binance market data stream connected" << std::endl;
+}
+
+void BinanceAPI::onWebSocketDisconnect() {
+    std::cout << "Binance market data stream disconnected" << std::endl;
+}
+
+void BinanceAPI::onWebSocketError(const std::string& error) {
+    setError("Market data stream: " + error);
+}
+
+void BinanceAPI::fetchBookSnapshot(const std::string& path, const std::string& query,
+                                   std::function<void(const HttpResponse&)> done) {
+    std::shared_ptr<HttpClient> client = getHttpClient();
+    getRateLimiter().submit(RequestPriority::QUERY, requestWeight("GET", path, query), 0,
+                            [this, client, path, query, done](bool admitted) {
+        if (!admitted) {
+            HttpResponse refused;
+            refused.error = "Refused by rate limiter";
+            done(refused);
+            return;
+        }
+        client->request("GET", path, query, "", [this, done](const HttpResponse& response) {
+            applyRateLimitFeedback(response);
+            done(response);
+        });
+    });
+}
+
+bool BinanceAPI::fetchAccount(BinanceAccount& account) const {
+    auto response = makeAuthenticatedRequest("/api/v3/account", "GET");
+    if (!BinanceMessageParser::parseAccount(response.data(), response.size(), account)) {
+        setError("Failed to parse account information");
+        return false;
+    }
+    return true;
+}
+
+bool BinanceAPI::loadAccount() {
+    BinanceAccount account;
+    if (!fetchAccount(account)) {
+        return false;
+    }
     
-    std::string fullParams = params;
-    if (!fullParams.empty()) {
-        fullParams += "&";
+    bool sawCurrency = false;
+    for (const auto& balance : account.balances) {
+        publishBalance(balance.asset, balance.free, balance.locked, account.updateTime);
+        sawCurrency = sawCurrency || balance.asset == accountCache_.getCurrency();
+    }
+    if (!sawCurrency) {
+        publishBalance(accountCache_.getCurrency(), 0, 0, account.updateTime);  // Marks the cache loaded
+    }
+    return true;
+}
+
+bool BinanceAPI::openUserStream() {
+    // Caller holds userStreamMutex_
+    auto response = makeRequest("/api/v3/userDataStream", "POST");  // API key only, unsigned
+    std::string listenKey;
+    if (!BinanceMessageParser::parseListenKey(response.data(), response.size(), listenKey)) {
+        if (getLastError().empty() || !response.empty()) {
+            setError("Failed to get a user data stream listenKey");
+        }
+        return false;
     }
-    fullParams += "timestamp=" + std::to_string(timestamp);
     
-    // Sign the request
-    std::string signature = signRequest(fullParams);
-    fullParams += "&signature=" + signature;
+    if (!userStream_) {
+        userStream_ = std::make_unique<WebSocketClient>(&ReactorPool::shared().next());
+        userStream_->setMessageHandler([this](const char* data, size_t length) {
+            onUserDataMessage(data, length);
+        });
+        userStream_->setDisconnectHandler([this]() {
+            markUserStreamStale();
+        });
+        userStream_->setErrorHandler([this](const std::string& error) {
+            setError("User data stream: " + error);
+        });
+    } else {
+        userStream_->disconnect();
+    }
     
-    return makeRequest(endpoint, method, fullParams);
+    std::string url;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        url = streamEndpoint_ + "/ws/" + listenKey;
+    }
+    if (!userStream_->connect(url)) {
+        setError("User data stream: " + userStream_->getLastError());
+        return false;
+    }
+    listenKey_ = listenKey;
+    std::cout << "Binance user data stream connected" << std::endl;
+    return true;
 }
 
-std::string BinanceAPI::buildAuthHeader() const {
-    return "X-MBX-APIKEY: " + apiKey_;
+bool BinanceAPI::renewListenKey() {
+    std::lock_guard<std::mutex> lock(userStreamMutex_);
+    if (listenKey_.empty()) {
+        return false;
+    }
+    auto response = makeRequest("/api/v3/userDataStream", "PUT", "listenKey=" + listenKey_);
+    int code = 0;
+    std::string message;
+    if (response.empty() || BinanceMessageParser::parseError(response.data(), response.size(), code, message)) {
+        setError("listenKey keep-alive failed: " + (message.empty() ? getLastError() : message));
+        return false;
+    }
+    return true;
 }
 
-std::string BinanceAPI::signRequest(const std::string& request) const {
-#ifdef SSL_ENABLED
-    // HMAC SHA256 signature
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    unsigned int hash_len = SHA256_DIGEST_LENGTH;
+void BinanceAPI::markUserStreamStale() {
+    std::lock_guard<std::mutex> lock(keepAliveMutex_);
+    if (!keepAliveRunning_) {
+        return;  // Closed on purpose
+    }
+    // Already stale means a reopen is pending, possibly pausing after a failure
+    bool pending = userStreamStale_;
+    userStreamStale_ = true;
+    if (!pending && !keepAliveBusy_) {
+        scheduleKeepAlive(Duration::zero());
+    }
+}
+
+void BinanceAPI::scheduleKeepAlive(Duration delay) {
+    // Caller holds keepAliveMutex_
+    TimerWheel& timers = maintenanceTimers();
+    timers.cancel(keepAliveTimer_);
+    keepAliveTimer_ = timers.schedule(delay, [this]() { runKeepAlive(); });
+}
+
+void BinanceAPI::runKeepAlive() {
+    // Maintenance wheel thread: one renewal or reopen, then the next one is scheduled
+    bool stale;
+    {
+        std::lock_guard<std::mutex> lock(keepAliveMutex_);
+        if (!keepAliveRunning_) {
+            return;
+        }
+        // This run covers any renewal or reopen armed since it became due
+        maintenanceTimers().cancel(keepAliveTimer_);
+        keepAliveTimer_ = TimerWheel::INVALID_TIMER;
+        keepAliveBusy_ = true;
+        stale = userStreamStale_;
+        userStreamStale_ = false;
+    }
     
-    HMAC(EVP_sha256(), 
-         apiSecret_.c_str(), apiSecret_.length(),
-         reinterpret_cast<const unsigned char*>(request.c_str()), request.length(),
-         hash, &hash_len);
+    bool ok;
+    if (stale) {
+        {
+            std::lock_guard<std::mutex> streamLock(userStreamMutex_);
+            ok = openUserStream();
+        }
+        if (ok) {
+            loadAccount();  // Pushes missed while the stream was down
+        }
+    } else {
+        ok = renewListenKey();
+    }
     
-    // Convert to hex string
-    std::ostringstream ss;
-    for (unsigned int i = 0; i < hash_len; ++i) {
-        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
+    std::lock_guard<std::mutex> lock(keepAliveMutex_);
+    keepAliveBusy_ = false;
+    keepAliveDone_.notify_all();
+    if (!keepAliveRunning_) {
+        return;
+    }
+    if (!ok) {
+        // A key that failed to renew is gone; open a new stream after a pause
+        std::cout << "Binance user data stream: " << getLastError() << ", retrying" << std::endl;
+        userStreamStale_ = true;
+        scheduleKeepAlive(USER_STREAM_RETRY);
+        return;
+    }
+    if (stale) {
+        userStreamStale_ = false;  // Set again by closing the old socket
+    }
+    // Dropped during a renewal: reopen now
+    scheduleKeepAlive(userStreamStale_ ? Duration::zero() : Duration(LISTEN_KEY_KEEPALIVE));
+}
+
+void BinanceAPI::onUserDataMessage(const char* data, size_t length) {
+    BinanceUserEvent& event = userEventScratch_;
+    if (!BinanceMessageParser::parseUserEvent(data, length, event)) {
+        return;
+    }
+    
+    switch (event.kind) {
+        case BinanceUserEvent::Kind::ACCOUNT_POSITION:
+            for (const auto& balance : event.balances) {
+                publishBalance(balance.asset, balance.free, balance.locked, event.eventTime);
+            }
+            break;
+        case BinanceUserEvent::Kind::BALANCE_UPDATE: {
+            // A delta; the outboundAccountPosition that follows carries the totals
+            double free = 0;
+            double locked = 0;
+            accountCache_.getAssetBalance(event.asset, free, locked);
+            publishBalance(event.asset, free + event.balanceDelta, locked, event.eventTime);
+            break;
+        }
+        case BinanceUserEvent::Kind::EXECUTION_REPORT: {
+            // Cancels name the cancelled order in "C"; "c" is then the cancel request's own id
+            const std::string& venueId = event.originalClientOrderId.empty() ? event.clientOrderId
+                                                                              : event.originalClientOrderId;
+            bool currentLeg = true;
+            resolveReport(venueId, event.order, currentLeg);
+            if (event.executionType == "TRADE" && event.lastQuantity > 0) {
+                publishFill(event.order.orderId, event.order.symbol, event.order.side, event.lastQuantity,
+                            event.lastPrice, event.order.updateTime);
+            }
+            if (currentLeg) {
+                notifyOrderUpdate(event.order);  // A replaced leg's own cancel is not the order's
+            }
+            break;
+        }
+        case BinanceUserEvent::Kind::LISTEN_KEY_EXPIRED:
+            markUserStreamStale();
+            break;
+        case BinanceUserEvent::Kind::UNKNOWN:
+            break;
+    }
+}
+
+void BinanceAPI::trackOrder(const OrderId& orderId, const Symbol& symbol) {
+    std::lock_guard<std::mutex> lock(trackedOrdersMutex_);
+    trackedOrders_[orderId] = TrackedOrder{symbol, orderId};
+}
+
+void BinanceAPI::untrackOrder(const OrderId& orderId) {
+    std::lock_guard<std::mutex> lock(trackedOrdersMutex_);
+    auto it = trackedOrders_.find(orderId);
+    if (it == trackedOrders_.end()) {
+        return;
+    }
+    if (it->second.venueId != orderId) {
+        replacementIds_.erase(it->second.venueId);
+    }
+    trackedOrders_.erase(it);
+}
+
+bool BinanceAPI::findTrackedOrder(const OrderId& orderId, TrackedOrder& order) const {
+    std::lock_guard<std::mutex> lock(trackedOrdersMutex_);
+    auto it = trackedOrders_.find(orderId);
+    if (it == trackedOrders_.end()) {
+        return false;
+    }
+    order = it->second;
+    return true;
+}
+
+void BinanceAPI::resolveReport(const std::string& venueId, Order& order, bool& currentLeg) {
+    std::lock_guard<std::mutex> lock(trackedOrdersMutex_);
+    auto replaced = replacementIds_.find(venueId);
+    OrderId orderId = replaced != replacementIds_.end() ? replaced->second : venueId;
+    currentLeg = true;
+    
+    auto it = trackedOrders_.find(orderId);
+    if (it == trackedOrders_.end()) {
+        // Placed elsewhere, or already completed: the venue id is all there is
+        order.orderId = venueId.empty() ? order.orderId : venueId;
+        return;
+    }
+    order.orderId = orderId;
+    currentLeg = it->second.venueId == venueId;
+    
+    bool complete = order.status == OrderStatus::FILLED || order.status == OrderStatus::CANCELLED ||
+                    order.status == OrderStatus::REJECTED || order.status == OrderStatus::EXPIRED;
+    if (!complete) {
+        return;
+    }
+    if (!currentLeg) {
+        if (replaced != replacementIds_.end()) {
+            replacementIds_.erase(replaced);  // Replaced leg done; the order lives on
+        }
+        return;
+    }
+    if (it->second.venueId != orderId) {
+        replacementIds_.erase(it->second.venueId);
+    }
+    trackedOrders_.erase(it);
+}
+
+std::string BinanceAPI::buildOrderParams(const Order& order, const OrderId& clientOrderId) const {
+    // Appended in place: one allocation for the whole query
+    char number[64];
+    std::string params;
+    params.reserve(160);
+    params.append("symbol=").append(order.symbol);
+    params.append(order.side == OrderSide::BUY ? "&side=BUY" : "&side=SELL");
+    params.append("&type=").append(getOrderTypeString(order.type));
+    params.append(number, std::snprintf(number, sizeof(number), "&quantity=%.8f", order.quantity));
+    
+    if (order.type == OrderType::LIMIT) {
+        params.append(number, std::snprintf(number, sizeof(number), "&price=%.8f", order.price));
+        params.append("&timeInForce=GTC");
+    }
+    params.append("&newClientOrderId=").append(clientOrderId);
+    return params;
+}
+
+void BinanceAPI::rejectOrder(const Order& order, const OrderId& clientOrderId, const std::string& reason) {
+    untrackOrder(clientOrderId);
+    Order rejected = order;
+    rejected.orderId = clientOrderId;
+    rejected.status = OrderStatus::REJECTED;
+    rejected.updateTime = std::chrono::system_clock::now();
+    std::cout << "Order " << clientOrderId << " rejected: " << reason << std::endl;
+    notifyOrderUpdate(rejected);
+}
+
+void BinanceAPI::applyRateLimitFeedback(const HttpResponse& response) const {
+    if (response.head.empty()) {
+        return;
+    }
+    std::string usedWeight = response.header("X-MBX-USED-WEIGHT-1M");
+    if (!usedWeight.empty()) {
+        getRateLimiter().sync(RateLimitRule::REQUEST_WEIGHT, std::atof(usedWeight.c_str()));
+    }
+    std::string orderCount = response.header("X-MBX-ORDER-COUNT-10S");
+    if (!orderCount.empty()) {
+        getRateLimiter().sync(RateLimitRule::ORDERS, std::atof(orderCount.c_str()));
     }
     
-    return ss.str();
-#else
-    // Fallback: simple hash for demo purposes (NOT secure for real trading)
-    std::hash<std::string> hasher;
-    auto hashValue = hasher(request + apiSecret_);
-    std::ostringstream ss;
-    ss << std::hex << hashValue;
-    return ss.str();
-#endif
+    // 429 warns, 418 means the IP is already banned; both say how long to stay away
+    if (response.status == 429 || response.status == 418) {
+        std::string retryAfter = response.header("Retry-After");
+        int seconds = retryAfter.empty() ? 1 : std::max(std::atoi(retryAfter.c_str()), 1);
+        getRateLimiter().pause(std::chrono::seconds(seconds));
+        std::cout << "Binance rate limit hit (" << response.status << "), pausing requests for "
+                  << seconds << "s" << std::endl;
+    }
+}
+
+RequestPriority BinanceAPI::requestPriority(const std::string& method, const std::string& path) {
+    if (method == "DELETE" || path == "/api/v3/order/cancelReplace") {
+        return RequestPriority::CANCEL;
+    }
+    if (method == "POST" && (path == "/api/v3/order" || path == "/api/v3/order/oco")) {
+        return RequestPriority::NEW_ORDER;
+    }
+    return RequestPriority::QUERY;
+}
+
+uint32_t BinanceAPI::requestWeight(const std::string& method, const std::string& path, const std::string& query) {
+    // Spot REQUEST_WEIGHT per endpoint; anything unlisted counts 1
+    bool oneSymbol = query.find("symbol=") != std::string::npos;
+    if (path == "/api/v3/account" || path == "/api/v3/exchangeInfo" || path == "/api/v3/allOrders" ||
+        path == "/api/v3/myTrades") {
+        return 20;
+    }
+    if (path == "/api/v3/ticker/24hr") {
+        return oneSymbol ? 2 : 80;
+    }
+    if (path == "/api/v3/openOrders") {
+        return oneSymbol ? 6 : 80;
+    }
+    if (path == "/api/v3/userDataStream") {
+        return 2;
+    }
+    if (path == "/api/v3/order" && method == "GET") {
+        return 4;
+    }
+    if (path == "/api/v3/klines" || path == "/api/v3/ticker/price" || path == "/api/v3/ticker/bookTicker") {
+        return 2;
+    }
+    if (path == "/api/v3/depth") {
+        size_t limitStart = query.find("limit=");
+        int limit = limitStart == std::string::npos ? 100 : std::atoi(query.c_str() + limitStart + 6);
+        return limit <= 100 ? 5 : limit <= 500 ? 25 : limit <= 1000 ? 50 : 250;
+    }
+    return 1;
 }
 
 std::string BinanceAPI::getOrderTypeString(OrderType type) const {
@@ -446,11 +1041,22 @@ std::string BinanceAPI::getOrderTypeString(OrderType type) const {
 }
 
 std::string BinanceAPI::generateOrderId() const {
-    static int counter = 0;
+    static std::atomic<int> counter(0);
     auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
     
     return "BN" + std::to_string(timestamp) + "-" + std::to_string(++counter);
 }
 
+OrderId BinanceAPI::clientOrderIdFor(const Order& order) const {
+    // newClientOrderId: 1-36 of [.A-Za-z0-9:/_-]
+    const OrderId& id = order.orderId;
+    bool accepted = !id.empty() && id.size() <= 36 &&
+                    std::all_of(id.begin(), id.end(), [](char c) {
+                        return std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == ':' || c == '/' ||
+                               c == '_' || c == '-';
+                    });
+    return accepted ? id : generateOrderId();
+}
+
 } // namespace MasterMind 
\ No newline at end of file
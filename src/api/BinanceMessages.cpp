@@ -0,0 +1,574 @@
+#include "api/BinanceMessages.h"
+#include "api/JsonParser.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MasterMind {
+
+namespace {
+TimePoint fromMillis(uint64_t millis) {
+    return TimePoint(std::chrono::milliseconds(millis));
+}
+
+bool readMillis(JsonReader& reader, TimePoint& time) {
+    uint64_t millis;
+    if (!reader.readUnsigned(millis)) {
+        return false;
+    }
+    time = fromMillis(millis);
+    return true;
+}
+
+bool readSymbol(JsonReader& reader, Symbol& symbol) {
+    std::string_view value;
+    if (!reader.readString(value)) {
+        return false;
+    }
+    symbol.assign(value.data(), value.size());
+    return true;
+}
+
+// [["price","qty"], ...] into a reused vector
+bool readLevels(JsonReader& reader, std::vector<PriceLevel>& levels) {
+    levels.clear();
+    if (!reader.enterArray()) {
+        return false;
+    }
+    PriceLevel level;
+    while (reader.nextElement() && reader.readPair(level.price, level.quantity)) {
+        levels.push_back(level);
+    }
+    return reader.ok();
+}
+}
+
+bool BinanceMessageParser::parseTicker(const char* data, size_t length, Tick& tick) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    tick.symbol.clear();
+    tick.bid = tick.ask = tick.last = tick.volume = 0.0;
+    tick.timestamp = TimePoint();
+
+    // Stream keys are single letters; REST responses spell them out
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "s" || key == "symbol") {
+            readSymbol(reader, tick.symbol);
+        } else if (key == "b" || key == "bidPrice") {
+            reader.readDouble(tick.bid);
+        } else if (key == "a" || key == "askPrice") {
+            reader.readDouble(tick.ask);
+        } else if (key == "c" || key == "lastPrice" || key == "price") {
+            reader.readDouble(tick.last);
+        } else if (key == "v" || key == "volume") {
+            reader.readDouble(tick.volume);
+        } else if (key == "E" || key == "closeTime" || key == "time") {
+            readMillis(reader, tick.timestamp);
+        } else {
+            reader.skipValue();
+        }
+    }
+
+    if (tick.timestamp == TimePoint()) {
+        tick.timestamp = std::chrono::system_clock::now();  // Book tickers carry no time
+    }
+    return reader.ok() && !tick.symbol.empty();
+}
+
+bool BinanceMessageParser::parseDepthUpdate(const char* data, size_t length, BinanceDepthUpdate& update) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    update.symbol.clear();
+    update.firstUpdateId = update.finalUpdateId = update.previousUpdateId = 0;
+    update.eventTime = TimePoint();
+    update.bids.clear();
+    update.asks.clear();
+
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "b" || key == "bids") {
+            readLevels(reader, update.bids);
+        } else if (key == "a" || key == "asks") {
+            readLevels(reader, update.asks);
+        } else if (key == "u" || key == "lastUpdateId") {
+            reader.readUnsigned(update.finalUpdateId);
+        } else if (key == "U") {
+            reader.readUnsigned(update.firstUpdateId);
+        } else if (key == "pu") {
+            reader.readUnsigned(update.previousUpdateId);
+        } else if (key == "s") {
+            readSymbol(reader, update.symbol);
+        } else if (key == "E") {
+            readMillis(reader, update.eventTime);
+        } else {
+            reader.skipValue();
+        }
+    }
+
+    if (update.firstUpdateId == 0) {
+        update.firstUpdateId = update.finalUpdateId;  // Snapshot: one point in the sequence
+    }
+    return reader.ok() && update.finalUpdateId != 0;
+}
+
+bool BinanceMessageParser::parseTrade(const char* data, size_t length, BinanceTrade& trade) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    trade.symbol.clear();
+    trade.tradeId = 0;
+    trade.price = trade.quantity = 0.0;
+    trade.tradeTime = TimePoint();
+    trade.buyerIsMaker = false;
+
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "p") {
+            reader.readDouble(trade.price);
+        } else if (key == "q") {
+            reader.readDouble(trade.quantity);
+        } else if (key == "t" || key == "a") {
+            reader.readUnsigned(trade.tradeId);  // Aggregate trades use "a"
+        } else if (key == "T") {
+            readMillis(reader, trade.tradeTime);
+        } else if (key == "m") {
+            reader.readBool(trade.buyerIsMaker);
+        } else if (key == "s") {
+            readSymbol(reader, trade.symbol);
+        } else {
+            reader.skipValue();
+        }
+    }
+    return reader.ok() && !trade.symbol.empty() && trade.price > 0;
+}
+
+bool BinanceMessageParser::parseOrderAck(const char* data, size_t length, BinanceOrderAck& ack) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    ack.order = Order();
+    ack.order.type = OrderType::MARKET;
+    ack.order.side = OrderSide::BUY;
+    ack.order.exchange = "BINANCE";
+    ack.clientOrderId.clear();
+    ack.cumulativeQuoteQuantity = 0.0;
+
+    std::string_view key;
+    std::string_view value;
+    while (reader.nextKey(key)) {
+        if (key == "orderId") {
+            // Numeric on the wire; kept as text like every other exchange id
+            uint64_t orderId;
+            if (reader.peek() == JsonType::STRING) {
+                readSymbol(reader, ack.order.orderId);
+            } else if (reader.readUnsigned(orderId)) {
+                ack.order.orderId = std::to_string(orderId);
+            }
+        } else if (key == "symbol") {
+            readSymbol(reader, ack.order.symbol);
+        } else if (key == "clientOrderId") {
+            reader.readString(ack.clientOrderId);
+        } else if (key == "price") {
+            reader.readDouble(ack.order.price);
+        } else if (key == "origQty") {
+            reader.readDouble(ack.order.quantity);
+        } else if (key == "executedQty") {
+            reader.readDouble(ack.order.filledQuantity);
+        } else if (key == "cummulativeQuoteQty") {
+            reader.readDouble(ack.cumulativeQuoteQuantity);
+        } else if (key == "stopPrice") {
+            reader.readDouble(ack.order.triggerPrice);
+        } else if (key == "status") {
+            if (reader.readString(value)) {
+                ack.order.status = toOrderStatus(value);
+            }
+        } else if (key == "type") {
+            if (reader.readString(value)) {
+                ack.order.type = toOrderType(value);
+            }
+        } else if (key == "side") {
+            if (reader.readString(value)) {
+                ack.order.side = value == "SELL" ? OrderSide::SELL : OrderSide::BUY;
+            }
+        } else if (key == "transactTime" || key == "time") {
+            readMillis(reader, ack.order.createTime);
+        } else if (key == "updateTime") {
+            readMillis(reader, ack.order.updateTime);
+        } else {
+            reader.skipValue();
+        }
+    }
+
+    if (ack.order.updateTime == TimePoint()) {
+        ack.order.updateTime = ack.order.createTime;
+    }
+    return reader.ok() && !ack.order.orderId.empty();
+}
+
+bool BinanceMessageParser::parseAccount(const char* data, size_t length, BinanceAccount& account) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    account.canTrade = false;
+    account.makerCommission = account.takerCommission = 0;
+    account.updateTime = TimePoint();
+
+    bool sawBalances = false;
+    size_t count = 0;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "balances") {
+            sawBalances = true;
+            if (!reader.enterArray()) {
+                break;
+            }
+            while (reader.nextElement()) {
+                // Overwrite existing entries so their strings keep capacity
+                if (count == account.balances.size()) {
+                    account.balances.emplace_back();
+                }
+                BinanceBalance& balance = account.balances[count++];
+                balance.free = balance.locked = 0.0;
+                balance.asset.clear();
+
+                std::string_view field;
+                if (!reader.enterObject()) {
+                    break;
+                }
+                while (reader.nextKey(field)) {
+                    if (field == "asset") {
+                        readSymbol(reader, balance.asset);
+                    } else if (field == "free") {
+                        reader.readDouble(balance.free);
+                    } else if (field == "locked") {
+                        reader.readDouble(balance.locked);
+                    } else {
+                        reader.skipValue();
+                    }
+                }
+            }
+        } else if (key == "canTrade") {
+            reader.readBool(account.canTrade);
+        } else if (key == "makerCommission" || key == "takerCommission") {
+            int64_t commission;
+            if (reader.readInteger(commission)) {
+                (key == "makerCommission" ? account.makerCommission : account.takerCommission) =
+                    static_cast<int>(commission);
+            }
+        } else if (key == "updateTime") {
+            readMillis(reader, account.updateTime);
+        } else {
+            reader.skipValue();
+        }
+    }
+
+    account.balances.resize(count);
+    return reader.ok() && sawBalances;
+}
+
+bool BinanceMessageParser::parseListenKey(const char* data, size_t length, std::string& listenKey) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    listenKey.clear();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "listenKey") {
+            reader.readString(listenKey);
+        } else {
+            reader.skipValue();
+        }
+    }
+    return reader.ok() && !listenKey.empty();
+}
+
+bool BinanceMessageParser::parseUserEvent(const char* data, size_t length, BinanceUserEvent& event) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    event.kind = BinanceUserEvent::Kind::UNKNOWN;
+    event.eventTime = TimePoint();
+    event.asset.clear();
+    event.balanceDelta = 0.0;
+    event.order = Order();
+    event.order.type = OrderType::MARKET;
+    event.order.side = OrderSide::BUY;
+    event.order.exchange = "BINANCE";
+    event.clientOrderId.clear();
+    event.originalClientOrderId.clear();
+    event.executionType.clear();
+    event.lastQuantity = event.lastPrice = 0.0;
+
+    // Single-letter keys are case-sensitive: "c" is the client order id, "C" the original one on cancels
+    size_t count = 0;
+    std::string_view key;
+    std::string_view value;
+    while (reader.nextKey(key)) {
+        if (key == "e") {
+            if (reader.readString(value)) {
+                if (value == "outboundAccountPosition") {
+                    event.kind = BinanceUserEvent::Kind::ACCOUNT_POSITION;
+                } else if (value == "balanceUpdate") {
+                    event.kind = BinanceUserEvent::Kind::BALANCE_UPDATE;
+                } else if (value == "executionReport") {
+                    event.kind = BinanceUserEvent::Kind::EXECUTION_REPORT;
+                } else if (value == "listenKeyExpired") {
+                    event.kind = BinanceUserEvent::Kind::LISTEN_KEY_EXPIRED;
+                }
+            }
+        } else if (key == "E") {
+            readMillis(reader, event.eventTime);
+        } else if (key == "B") {
+            if (!reader.enterArray()) {
+                break;
+            }
+            while (reader.nextElement()) {
+                // Overwrite existing entries so their strings keep capacity
+                if (count == event.balances.size()) {
+                    event.balances.emplace_back();
+                }
+                BinanceBalance& balance = event.balances[count++];
+                balance.free = balance.locked = 0.0;
+                balance.asset.clear();
+
+                std::string_view field;
+                if (!reader.enterObject()) {
+                    break;
+                }
+                while (reader.nextKey(field)) {
+                    if (field == "a") {
+                        readSymbol(reader, balance.asset);
+                    } else if (field == "f") {
+                        reader.readDouble(balance.free);
+                    } else if (field == "l") {
+                        reader.readDouble(balance.locked);
+                    } else {
+                        reader.skipValue();
+                    }
+                }
+            }
+        } else if (key == "a") {
+            readSymbol(reader, event.asset);
+        } else if (key == "d") {
+            reader.readDouble(event.balanceDelta);
+        } else if (key == "s") {
+            readSymbol(reader, event.order.symbol);
+        } else if (key == "c") {
+            reader.readString(event.clientOrderId);
+        } else if (key == "C") {
+            reader.readString(event.originalClientOrderId);
+        } else if (key == "i") {
+            uint64_t orderId;
+            if (reader.readUnsigned(orderId)) {
+                event.order.orderId = std::to_string(orderId);
+            }
+        } else if (key == "S") {
+            if (reader.readString(value)) {
+                event.order.side = value == "SELL" ? OrderSide::SELL : OrderSide::BUY;
+            }
+        } else if (key == "o") {
+            if (reader.readString(value)) {
+                event.order.type = toOrderType(value);
+            }
+        } else if (key == "q") {
+            reader.readDouble(event.order.quantity);
+        } else if (key == "p") {
+            reader.readDouble(event.order.price);
+        } else if (key == "P") {
+            reader.readDouble(event.order.triggerPrice);
+        } else if (key == "x") {
+            reader.readString(event.executionType);
+        } else if (key == "X") {
+            if (reader.readString(value)) {
+                event.order.status = toOrderStatus(value);
+            }
+        } else if (key == "z") {
+            reader.readDouble(event.order.filledQuantity);
+        } else if (key == "l") {
+            reader.readDouble(event.lastQuantity);
+        } else if (key == "L") {
+            reader.readDouble(event.lastPrice);
+        } else if (key == "O") {
+            readMillis(reader, event.order.createTime);
+        } else if (key == "T") {
+            readMillis(reader, event.order.updateTime);
+        } else {
+            reader.skipValue();
+        }
+    }
+
+    event.balances.resize(count);
+    if (event.order.updateTime == TimePoint()) {
+        event.order.updateTime = event.eventTime;
+    }
+    return reader.ok();
+}
+
+bool BinanceMessageParser::parseExchangeInfo(const char* data, size_t length,
+                                             std::vector<InstrumentSpec>& instruments) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    instruments.clear();
+    bool sawSymbols = false;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key != "symbols") {
+            reader.skipValue();
+            continue;
+        }
+        sawSymbols = true;
+        if (!reader.enterArray()) {
+            break;
+        }
+        while (reader.nextElement()) {
+            InstrumentSpec spec;
+            spec.assetClass = AssetClass::CRYPTO;
+            spec.marginRequirement = 1.0;  // Spot is fully funded
+            std::string_view field;
+            std::string_view value;
+            if (!reader.enterObject()) {
+                break;
+            }
+            while (reader.nextKey(field)) {
+                if (field == "symbol") {
+                    readSymbol(reader, spec.symbol);
+                } else if (field == "status") {
+                    if (reader.readString(value)) {
+                        spec.isActive = value == "TRADING";
+                    }
+                } else if (field == "baseAsset") {
+                    readSymbol(reader, spec.baseAsset);
+                } else if (field == "quoteAsset") {
+                    readSymbol(reader, spec.quoteAsset);
+                } else if (field == "filters") {
+                    if (!reader.enterArray()) {
+                        break;
+                    }
+                    while (reader.nextElement()) {
+                        // Key order within a filter is not guaranteed, so apply after the object closes
+                        std::string_view type;
+                        double tickSize = 0, minQty = 0, maxQty = 0;
+                        std::string_view name;
+                        if (!reader.enterObject()) {
+                            break;
+                        }
+                        while (reader.nextKey(name)) {
+                            if (name == "filterType") {
+                                reader.readString(type);
+                            } else if (name == "tickSize") {
+                                reader.readDouble(tickSize);
+                            } else if (name == "minQty") {
+                                reader.readDouble(minQty);
+                            } else if (name == "maxQty") {
+                                reader.readDouble(maxQty);
+                            } else {
+                                reader.skipValue();
+                            }
+                        }
+                        if (type == "PRICE_FILTER" && tickSize > 0) {
+                            spec.tickSize = tickSize;
+                            spec.precision = std::max(0, static_cast<int>(std::lround(-std::log10(tickSize))));
+                        } else if (type == "LOT_SIZE") {
+                            spec.minOrderSize = minQty;
+                            spec.maxOrderSize = maxQty > 0 ? maxQty : spec.maxOrderSize;
+                        }
+                    }
+                } else {
+                    reader.skipValue();
+                }
+            }
+            if (!spec.symbol.empty()) {
+                spec.tickValue = spec.tickSize;  // One tick on one unit, in the quote asset
+                instruments.push_back(std::move(spec));
+            }
+        }
+    }
+    return reader.ok() && sawSymbols;
+}
+
+bool BinanceMessageParser::parseError(const char* data, size_t length, int& code, std::string& message) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    bool sawCode = false;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "code") {
+            int64_t value;
+            if (reader.readInteger(value)) {
+                code = static_cast<int>(value);
+                sawCode = true;
+            }
+        } else if (key == "msg") {
+            reader.readString(message);
+        } else {
+            reader.skipValue();
+        }
+    }
+    return reader.ok() && sawCode;
+}
+
+bool BinanceMessageParser::parseStreamEnvelope(const char* data, size_t length, std::string_view& stream,
+                                               std::string_view& payload) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    stream = std::string_view();
+    payload = std::string_view();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "stream") {
+            reader.readString(stream);
+        } else if (key == "data") {
+            reader.peek();  // Step over whitespace so the view starts at the value
+            size_t start = reader.getOffset();
+            reader.skipValue();
+            payload = std::string_view(data + start, reader.getOffset() - start);
+        } else {
+            reader.skipValue();
+        }
+    }
+    return reader.ok() && !stream.empty() && !payload.empty();
+}
+
+OrderStatus BinanceMessageParser::toOrderStatus(std::string_view status) {
+    if (status == "NEW" || status == "PENDING_NEW" || status == "PENDING_CANCEL") return OrderStatus::SUBMITTED;
+    if (status == "PARTIALLY_FILLED") return OrderStatus::PARTIALLY_FILLED;
+    if (status == "FILLED") return OrderStatus::FILLED;
+    if (status == "CANCELED") return OrderStatus::CANCELLED;
+    if (status == "REJECTED") return OrderStatus::REJECTED;
+    if (status == "EXPIRED" || status == "EXPIRED_IN_MATCH") return OrderStatus::EXPIRED;
+    return OrderStatus::PENDING;
+}
+
+OrderType BinanceMessageParser::toOrderType(std::string_view type) {
+    if (type == "LIMIT" || type == "LIMIT_MAKER") return OrderType::LIMIT;
+    if (type == "STOP_LOSS" || type == "TAKE_PROFIT") return OrderType::STOP;
+    if (type == "STOP_LOSS_LIMIT" || type == "TAKE_PROFIT_LIMIT") return OrderType::STOP_LIMIT;
+    return OrderType::MARKET;
+}
+
+} // namespace MasterMind
@@ -0,0 +1,255 @@
+#include "api/BookSynchronizer.h"
+#include <algorithm>
+
+namespace MasterMind {
+
+namespace {
+constexpr Duration FIRST_RETRY_DELAY(100);
+constexpr Duration MAX_RETRY_DELAY(5000);
+}
+
+BookSynchronizer::BookSynchronizer(bool recoverable, size_t maxHeld)
+    : recoverable_(recoverable), maxHeld_(std::max<size_t>(maxHeld, 1)), nextGeneration_(0) {}
+
+BookSynchronizer::Action BookSynchronizer::onUpdate(const VenueEvent& update, uint64_t& generation) {
+    if (update.sequence == 0) {
+        return Action::APPLY;  // Unsequenced feed: nothing to check against
+    }
+
+    Stream& stream = streams_[update.symbol];
+    if (stream.recovering) {
+        hold(stream, update);
+        return Action::HOLD;
+    }
+    if (!stream.synced) {
+        if (!recoverable_) {
+            stream.synced = true;
+            stream.last = update.sequence;
+            return Action::APPLY;
+        }
+        beginRecovery(stream, false);
+        hold(stream, update);
+        generation = stream.generation;
+        return Action::FETCH;
+    }
+
+    if (update.sequence <= stream.last) {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.stale++;
+        return Action::HOLD;
+    }
+    if (follows(stream.last, stream.bridging, update)) {
+        stream.last = update.sequence;
+        stream.bridging = false;
+        return Action::APPLY;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.gaps++;
+    }
+    if (!recoverable_) {
+        stream.last = update.sequence;  // Nothing to resync from; carry on
+        stream.bridging = false;
+        return Action::APPLY;
+    }
+    beginRecovery(stream, true);
+    hold(stream, update);
+    generation = stream.generation;
+    return Action::FETCH;
+}
+
+void BookSynchronizer::onStreamSnapshot(const VenueEvent& snapshot) {
+    if (snapshot.sequence == 0) {
+        return;
+    }
+    Stream& stream = streams_[snapshot.symbol];
+    if (stream.recovering) {
+        stream.held.clear();  // The stream is ordered: everything held predates it
+        endRecovery(stream, snapshot.sequence);
+    } else {
+        stream.synced = true;
+        stream.last = snapshot.sequence;
+        stream.bridging = true;
+    }
+    stream.generation = ++nextGeneration_;  // A fetch still in flight is no longer wanted
+}
+
+bool BookSynchronizer::onSnapshot(const VenueEvent& snapshot, uint64_t generation, const Apply& apply) {
+    auto it = streams_.find(snapshot.symbol);
+    if (it == streams_.end() || !it->second.recovering || it->second.generation != generation) {
+        return false;
+    }
+    Stream& stream = it->second;
+
+    // Held updates the snapshot already covers are dropped; the rest must
+    // continue from it without a break before anything is applied
+    uint64_t dropped = 0;
+    while (!stream.held.empty() && stream.held.front().sequence <= snapshot.sequence) {
+        stream.held.pop_front();
+        dropped++;
+    }
+    uint64_t last = snapshot.sequence;
+    bool bridging = true;
+    bool consistent = true;
+    for (const auto& update : stream.held) {
+        if (!follows(last, bridging, update)) {
+            consistent = false;
+            break;
+        }
+        last = update.sequence;
+        bridging = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.stale += dropped;
+        if (!consistent) {
+            stats_.snapshotRetries++;
+        }
+    }
+    if (!consistent) {
+        stream.attempts++;  // Snapshot predates the held updates, or they have a gap of their own
+        return false;
+    }
+
+    apply(snapshot);
+    for (const auto& update : stream.held) {
+        apply(update);
+    }
+    endRecovery(stream, last);
+    return true;
+}
+
+Duration BookSynchronizer::onSnapshotFailed(const Symbol& symbol, uint64_t generation) {
+    auto it = streams_.find(symbol);
+    if (it == streams_.end() || !it->second.recovering || it->second.generation != generation) {
+        return Duration(0);
+    }
+    it->second.attempts++;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.snapshotRetries++;
+    }
+    return getRetryDelay(symbol);
+}
+
+Duration BookSynchronizer::getRetryDelay(const Symbol& symbol) const {
+    auto it = streams_.find(symbol);
+    unsigned attempts = it == streams_.end() ? 0 : it->second.attempts;
+    if (attempts == 0) {
+        return Duration(0);
+    }
+    Duration delay = FIRST_RETRY_DELAY * (1LL << std::min(attempts - 1, 6u));
+    return std::min(delay, MAX_RETRY_DELAY);
+}
+
+bool BookSynchronizer::isRecovering(const Symbol& symbol, uint64_t generation) const {
+    auto it = streams_.find(symbol);
+    return it != streams_.end() && it->second.recovering && it->second.generation == generation;
+}
+
+bool BookSynchronizer::isSynced(const Symbol& symbol) const {
+    auto it = streams_.find(symbol);
+    return it != streams_.end() && it->second.synced && !it->second.recovering;
+}
+
+void BookSynchronizer::reset(const Symbol& symbol) {
+    auto it = streams_.find(symbol);
+    if (it == streams_.end()) {
+        return;
+    }
+    if (it->second.recovering) {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.recovering--;
+    }
+    streams_.erase(it);
+}
+
+void BookSynchronizer::onStreamSwitch() {
+    for (auto it = streams_.begin(); it != streams_.end();) {
+        if (it->second.recovering) {
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                stats_.recovering--;
+            }
+            it = streams_.erase(it);  // Held updates may overlap the new connection's
+        } else {
+            it->second.bridging = true;
+            ++it;
+        }
+    }
+}
+
+void BookSynchronizer::clear() {
+    streams_.clear();
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.recovering = 0;
+}
+
+BookSyncStats BookSynchronizer::getStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
+}
+
+// Private methods
+bool BookSynchronizer::follows(uint64_t last, bool bridging, const VenueEvent& update) {
+    if (update.sequence <= last) {
+        return false;
+    }
+    if (bridging) {
+        return update.firstSequence <= last + 1;  // Straddles the snapshot
+    }
+    if (update.previousSequence != 0) {
+        return update.previousSequence == last;
+    }
+    return update.firstSequence == 0 || update.firstSequence == last + 1;
+}
+
+void BookSynchronizer::hold(Stream& stream, const VenueEvent& update) {
+    bool overflow = stream.held.size() >= maxHeld_;
+    if (overflow) {
+        stream.held.pop_front();  // The snapshot must then be newer than what is left
+    }
+    stream.held.push_back(update);
+
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.held++;
+    if (overflow) {
+        stats_.overflows++;
+    }
+}
+
+void BookSynchronizer::beginRecovery(Stream& stream, bool gap) {
+    stream.recovering = true;
+    stream.initial = !gap && !stream.synced;
+    stream.generation = ++nextGeneration_;
+    stream.attempts = 0;
+    stream.detected = std::chrono::steady_clock::now();
+    stream.held.clear();
+
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.recovering++;
+}
+
+void BookSynchronizer::endRecovery(Stream& stream, uint64_t last) {
+    stream.synced = true;
+    stream.bridging = stream.held.empty();  // Otherwise the last replayed update is the anchor
+    stream.recovering = false;
+    stream.last = last;
+    stream.attempts = 0;
+    stream.held.clear();
+
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - stream.detected).count();
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.recovering--;
+    if (stream.initial) {
+        stats_.initialSyncs++;
+        return;
+    }
+    stats_.recoveries++;
+    stats_.lastRecoveryMicros = micros;
+    stats_.maxRecoveryMicros = std::max(stats_.maxRecoveryMicros, micros);
+    stats_.totalRecoveryMicros += micros;
+}
+
+} // namespace MasterMind
@@ -0,0 +1,175 @@
+#include "api/VenueCodec.h"
+#include "api/JsonParser.h"
+
+namespace MasterMind {
+
+namespace {
+// Days since 1970-01-01 of a proleptic Gregorian date
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+bool readDigits(std::string_view text, size_t position, size_t count, unsigned& value) {
+    if (position + count > text.size()) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = position; i < position + count; ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<unsigned>(text[i] - '0');
+    }
+    return true;
+}
+
+// [["buy"|"sell", "price", "size"], ...] split by side
+bool readChanges(JsonReader& reader, std::vector<PriceLevel>& bids, std::vector<PriceLevel>& asks) {
+    if (!reader.enterArray()) {
+        return false;
+    }
+    while (reader.nextElement()) {
+        std::string_view side;
+        PriceLevel level;
+        if (!reader.enterArray() || !reader.nextElement() || !reader.readString(side) ||
+            !reader.nextElement() || !reader.readDouble(level.price) ||
+            !reader.nextElement() || !reader.readDouble(level.quantity)) {
+            return false;
+        }
+        while (reader.nextElement()) {
+            reader.skipValue();
+        }
+        (side == "buy" ? bids : asks).push_back(level);
+    }
+    return reader.ok();
+}
+
+bool readLevels(JsonReader& reader, std::vector<PriceLevel>& levels) {
+    if (!reader.enterArray()) {
+        return false;
+    }
+    PriceLevel level;
+    while (reader.nextElement() && reader.readPair(level.price, level.quantity)) {
+        levels.push_back(level);
+    }
+    return reader.ok();
+}
+}
+
+std::string CoinbaseCodec::buildStreamUrl(const std::string& endpoint, const std::vector<Symbol>&) const {
+    return endpoint;
+}
+
+std::string CoinbaseCodec::buildSubscription(const std::vector<Symbol>& symbols, bool subscribe, uint64_t) const {
+    std::string products;
+    for (const auto& symbol : symbols) {
+        products += (products.empty() ? "\"" : ",\"") + symbol + "\"";
+    }
+    return std::string("{\"type\":\"") + (subscribe ? "subscribe" : "unsubscribe") + "\",\"product_ids\":[" +
+           products + "],\"channels\":[\"ticker\",\"level2_batch\",\"matches\"]}";
+}
+
+bool CoinbaseCodec::decode(const char* data, size_t length, const EventSink& sink) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    // One pass whatever the key order; the type decides which fields count
+    VenueEvent& event = event_;
+    event.reset(VenueEvent::Type::TICK);
+    event.venue = Exchange::COINBASE;
+    event.symbol.clear();
+    event.time = TimePoint();
+    std::string_view type;
+    std::string_view side;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "type") {
+            reader.readString(type);
+        } else if (key == "product_id") {
+            reader.readString(event.symbol);
+        } else if (key == "price") {
+            reader.readDouble(event.price);
+        } else if (key == "size") {
+            reader.readDouble(event.quantity);
+        } else if (key == "best_bid") {
+            reader.readDouble(event.bid);
+        } else if (key == "best_ask") {
+            reader.readDouble(event.ask);
+        } else if (key == "side") {
+            reader.readString(side);
+        } else if (key == "sequence") {
+            reader.readUnsigned(event.sequence);
+        } else if (key == "time") {
+            std::string_view time;
+            if (reader.readString(time)) {
+                parseTime(time, event.time);
+            }
+        } else if (key == "bids") {
+            readLevels(reader, event.bids);
+        } else if (key == "asks") {
+            readLevels(reader, event.asks);
+        } else if (key == "changes") {
+            readChanges(reader, event.bids, event.asks);
+        } else {
+            reader.skipValue();
+        }
+    }
+    if (!reader.ok() || event.symbol.empty()) {
+        return false;  // subscriptions, heartbeat and error messages carry no product
+    }
+
+    if (type == "ticker") {
+        event.type = VenueEvent::Type::TICK;
+    } else if (type == "match" || type == "last_match") {
+        event.type = VenueEvent::Type::TRADE;
+        event.side = side == "buy" ? OrderSide::SELL : OrderSide::BUY;  // side is the maker's
+    } else if (type == "snapshot") {
+        event.type = VenueEvent::Type::BOOK_SNAPSHOT;
+    } else if (type == "l2update") {
+        event.type = VenueEvent::Type::BOOK_UPDATE;
+        event.sequence = 0;  // level2_batch is unsequenced
+    } else {
+        return false;
+    }
+    if (event.time == TimePoint()) {
+        event.time = std::chrono::system_clock::now();  // Snapshots carry no time
+    }
+    sink(event);
+    return true;
+}
+
+bool CoinbaseCodec::parseTime(std::string_view text, TimePoint& time) {
+    // YYYY-MM-DDTHH:MM:SS[.ffffff]Z
+    unsigned year, month, day, hour, minute, second;
+    if (!readDigits(text, 0, 4, year) || text.size() < 20 || text[4] != '-' || !readDigits(text, 5, 2, month) ||
+        text[7] != '-' || !readDigits(text, 8, 2, day) || text[10] != 'T' || !readDigits(text, 11, 2, hour) ||
+        text[13] != ':' || !readDigits(text, 14, 2, minute) || text[16] != ':' || !readDigits(text, 17, 2, second)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+
+    int64_t micros = 0;
+    size_t position = 19;
+    if (position < text.size() && text[position] == '.') {
+        int64_t scale = 100000;
+        for (++position; position < text.size() && text[position] >= '0' && text[position] <= '9'; ++position) {
+            micros += (text[position] - '0') * scale;
+            scale /= 10;
+        }
+    }
+    int64_t seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    time = TimePoint(std::chrono::duration_cast<TimePoint::duration>(
+        std::chrono::seconds(seconds) + std::chrono::microseconds(micros)));
+    return true;
+}
+
+} // namespace MasterMind
@@ -0,0 +1,324 @@
+#include "api/ConnectionSupervisor.h"
+#include "api/ExchangeAPI.h"
+#include <algorithm>
+#include <iostream>
+
+namespace MasterMind {
+
+using SteadyClock = std::chrono::steady_clock;
+
+ConnectionSupervisor::ConnectionSupervisor(const SupervisorConfig& config)
+    : config_(config), checking_(nullptr), running_(false), woken_(false),
+      jitterGenerator_(std::random_device{}()) {}
+
+ConnectionSupervisor::~ConnectionSupervisor() {
+    stop();
+}
+
+void ConnectionSupervisor::setConfig(const SupervisorConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    woken_ = true;
+    wakeup_.notify_all();
+}
+
+SupervisorConfig ConnectionSupervisor::getConfig() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+bool ConnectionSupervisor::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return true;
+    }
+    running_ = true;
+    thread_ = std::thread(&ConnectionSupervisor::supervisorLoop, this);
+    std::cout << "Connection supervisor started for " << venues_.size() << " venues" << std::endl;
+    return true;
+}
+
+void ConnectionSupervisor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        wakeup_.notify_all();
+    }
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();  // After a reconnect in progress, if any
+    }
+}
+
+bool ConnectionSupervisor::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+void ConnectionSupervisor::addVenue(ExchangeAPI* venue) {
+    if (!venue) {
+        return;
+    }
+    auto entry = std::make_shared<Venue>();
+    entry->api = venue;
+    entry->stream = dynamic_cast<WebSocketExchangeAPI*>(venue);
+
+    // Set outside mutex_: the reactor holds the venue's callback lock while it calls wake()
+    if (entry->stream) {
+        entry->stream->setStreamStateCallback([this]() { wake(); });
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& existing : venues_) {
+        if (existing->api == venue) {
+            return;
+        }
+    }
+    venues_.push_back(std::move(entry));
+    woken_ = true;
+    wakeup_.notify_all();
+}
+
+void ConnectionSupervisor::removeVenue(ExchangeAPI* venue) {
+    if (auto* stream = dynamic_cast<WebSocketExchangeAPI*>(venue)) {
+        stream->setStreamStateCallback(nullptr);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = std::find_if(venues_.begin(), venues_.end(),
+                           [venue](const std::shared_ptr<Venue>& entry) { return entry->api == venue; });
+    if (it == venues_.end()) {
+        return;
+    }
+    std::shared_ptr<Venue> entry = *it;
+    entry->removed = true;
+    venues_.erase(it);
+    checked_.wait(lock, [this, &entry]() { return checking_ != entry.get(); });
+    if (entry->down) {
+        stats_.down--;
+    }
+}
+
+SupervisorStats ConnectionSupervisor::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SupervisorStats stats = stats_;
+    stats.venues = venues_.size();
+    for (const auto& venue : venues_) {
+        if (venue->stream) {
+            stats.failovers += venue->stream->getFailoverCount();
+        }
+    }
+    return stats;
+}
+
+// Private methods
+void ConnectionSupervisor::supervisorLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (running_) {
+        woken_ = false;
+        SupervisorConfig config = config_;
+        std::vector<std::shared_ptr<Venue>> venues = venues_;
+
+        // Venues are checked outside the lock: reconnects block, and a
+        // heartbeat drop reports back through wake() on the reactor
+        SteadyTime wake = SteadyTime::max();
+        for (const auto& venue : venues) {
+            if (venue->removed || !running_) {
+                continue;
+            }
+            checking_ = venue.get();
+            lock.unlock();
+            SteadyTime due = check(*venue, config);
+            lock.lock();
+            checking_ = nullptr;
+            checked_.notify_all();
+            wake = std::min(wake, due);
+        }
+
+        if (!running_ || woken_) {
+            continue;
+        }
+        if (wake == SteadyTime::max()) {
+            wakeup_.wait(lock);
+        } else {
+            wakeup_.wait_until(lock, wake);
+        }
+    }
+}
+
+void ConnectionSupervisor::wake() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    woken_ = true;
+    wakeup_.notify_all();
+}
+
+ConnectionSupervisor::SteadyTime ConnectionSupervisor::check(Venue& venue, const SupervisorConfig& config) {
+    SteadyTime now = SteadyClock::now();
+    Duration period = std::max<Duration>(config.heartbeatInterval / 2, Duration(10));
+
+    // Disconnected on purpose: nothing to restore until connect() is called again
+    if (!venue.api->isSessionWanted()) {
+        release(venue);
+        return now + period;
+    }
+
+    // A lost session takes the stream with it; both come back together
+    bool sessionRestored = false;
+    if (venue.api->isSessionLost()) {
+        markDown(venue, now, "session");
+        if (now < venue.nextAttempt) {
+            return venue.nextAttempt;
+        }
+        if (!venue.api->restoreSession()) {
+            recordFailure(venue, config, now);
+            return venue.nextAttempt;
+        }
+        sessionRestored = true;
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.sessionReconnects++;
+    }
+    if (!venue.stream) {
+        markUp(venue);
+        return now + period;
+    }
+
+    if (sessionRestored || venue.stream->getStreamState() == WebSocketExchangeAPI::StreamState::DOWN) {
+        if (!sessionRestored) {
+            markDown(venue, now, "market data stream");
+            if (now < venue.nextAttempt) {
+                return venue.nextAttempt;
+            }
+        }
+        if (!venue.stream->restoreStream()) {
+            recordFailure(venue, config, now);
+            return venue.nextAttempt;
+        }
+        if (!sessionRestored) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.streamRestores++;
+        }
+        now = SteadyClock::now();
+        venue.nextHeartbeat = now + period;  // Fresh connection
+    }
+    markUp(venue);
+
+    if (venue.stream->getStreamState() != WebSocketExchangeAPI::StreamState::UP) {
+        return now + period;  // Nothing subscribed
+    }
+    if (now >= venue.nextHeartbeat) {
+        venue.stream->checkStreamHeartbeat(config.heartbeatInterval);
+        venue.nextHeartbeat = now + period;
+    }
+    return std::min(venue.nextHeartbeat, checkStandby(venue, config, now));
+}
+
+ConnectionSupervisor::SteadyTime ConnectionSupervisor::checkStandby(Venue& venue, const SupervisorConfig& config,
+                                                                    SteadyTime now) {
+    if (!config.hotStandby) {
+        if (venue.stream->hasStandby()) {
+            venue.stream->dropStandby();
+        }
+        return SteadyTime::max();
+    }
+    if (venue.stream->hasStandby()) {
+        venue.standbyAttempts = 0;
+        return SteadyTime::max();
+    }
+    if (now < venue.nextStandby) {
+        return venue.nextStandby;
+    }
+
+    if (venue.stream->ensureStandby()) {
+        venue.standbyAttempts = 0;
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.standbysOpened++;
+        return SteadyTime::max();
+    }
+    // The stream itself is up, so this only retries; it never gives up
+    venue.standbyAttempts++;
+    venue.nextStandby = now + getBackoff(config, venue.standbyAttempts);
+    std::cout << venue.api->getExchangeName() << " standby stream failed (" << venue.api->getLastError()
+              << "), retrying in " << std::chrono::duration_cast<Duration>(venue.nextStandby - now).count() << "ms"
+              << std::endl;
+    return venue.nextStandby;
+}
+
+void ConnectionSupervisor::markDown(Venue& venue, SteadyTime now, const char* what) {
+    if (venue.down) {
+        return;
+    }
+    venue.down = true;
+    venue.downSince = now;
+    venue.nextAttempt = now;  // First attempt at once
+    venue.attempts = 0;
+    std::cout << venue.api->getExchangeName() << " " << what << " down, reconnecting" << std::endl;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.down++;
+}
+
+void ConnectionSupervisor::markUp(Venue& venue) {
+    if (!venue.down) {
+        return;
+    }
+    double micros = std::chrono::duration<double, std::micro>(SteadyClock::now() - venue.downSince).count();
+    std::cout << venue.api->getExchangeName() << " back up after " << micros / 1000.0 << "ms ("
+              << venue.attempts + 1 << " attempts)" << std::endl;
+    venue.down = false;
+    venue.gaveUp = false;
+    venue.attempts = 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.down--;
+    stats_.lastDowntimeMicros = micros;
+    stats_.maxDowntimeMicros = std::max(stats_.maxDowntimeMicros, micros);
+}
+
+void ConnectionSupervisor::release(Venue& venue) {
+    if (!venue.down) {
+        return;
+    }
+    std::cout << venue.api->getExchangeName() << " disconnected on purpose, no longer reconnecting" << std::endl;
+    venue.down = false;
+    venue.gaveUp = false;
+    venue.attempts = 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.down--;
+}
+
+void ConnectionSupervisor::recordFailure(Venue& venue, const SupervisorConfig& config, SteadyTime now) {
+    venue.attempts++;
+    venue.nextAttempt = now + getBackoff(config, venue.attempts);
+    bool giveUp = !venue.gaveUp && config.giveUpAfter > Duration::zero() && now - venue.downSince >= config.giveUpAfter;
+    if (giveUp) {
+        // Reported once; a venue that comes back is worth more than a quiet log
+        venue.gaveUp = true;
+        std::cout << venue.api->getExchangeName() << " still down after " << venue.attempts
+                  << " attempts, giving up (retrying every " << config.maxBackoff.count()
+                  << "ms): " << venue.api->getLastError() << std::endl;
+    } else if (!venue.gaveUp) {
+        std::cout << venue.api->getExchangeName() << " reconnect attempt " << venue.attempts << " failed ("
+                  << venue.api->getLastError() << "), retrying in "
+                  << std::chrono::duration_cast<Duration>(venue.nextAttempt - now).count() << "ms" << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.failedAttempts++;
+    if (giveUp) {
+        stats_.givenUp++;
+    }
+}
+
+Duration ConnectionSupervisor::getBackoff(const SupervisorConfig& config, unsigned attempts) {
+    double millis = static_cast<double>(config.initialBackoff.count()) *
+                    static_cast<double>(1ULL << std::min(attempts - 1, 30u));
+    millis = std::min(millis, static_cast<double>(config.maxBackoff.count()));
+    double jitter = std::min(std::max(config.jitter, 0.0), 1.0);
+    if (jitter > 0) {
+        std::uniform_real_distribution<double> spread(1.0 - jitter, 1.0 + jitter);
+        millis *= spread(jitterGenerator_);
+    }
+    return Duration(static_cast<Duration::rep>(millis));
+}
+
+} // namespace MasterMind
@@ -0,0 +1,282 @@
+#include "api/VenueCodec.h"
+#include "api/JsonParser.h"
+
+namespace MasterMind {
+
+namespace {
+// Price fields are null while the book side is empty
+bool readOptionalDouble(JsonReader& reader, double& value) {
+    if (reader.peek() == JsonType::NULL_VALUE) {
+        value = 0;
+        return reader.readNull();
+    }
+    return reader.readDouble(value);
+}
+
+bool readMillis(JsonReader& reader, TimePoint& time) {
+    uint64_t millis;
+    if (!reader.readUnsigned(millis)) {
+        return false;
+    }
+    time = TimePoint(std::chrono::milliseconds(millis));
+    return true;
+}
+
+// [["new"|"change"|"delete", price, amount], ...]; delete becomes quantity 0
+bool readActionLevels(JsonReader& reader, std::vector<PriceLevel>& levels) {
+    levels.clear();
+    if (!reader.enterArray()) {
+        return false;
+    }
+    while (reader.nextElement()) {
+        std::string_view action;
+        PriceLevel level;
+        if (!reader.enterArray() || !reader.nextElement() || !reader.readString(action) ||
+            !reader.nextElement() || !reader.readDouble(level.price) ||
+            !reader.nextElement() || !reader.readDouble(level.quantity)) {
+            return false;
+        }
+        while (reader.nextElement()) {
+            reader.skipValue();
+        }
+        if (action == "delete") {
+            level.quantity = 0;
+        }
+        levels.push_back(level);
+    }
+    return reader.ok();
+}
+}
+
+std::string DeribitCodec::buildStreamUrl(const std::string& endpoint, const std::vector<Symbol>&) const {
+    return endpoint + "/ws/api/v2";
+}
+
+std::string DeribitCodec::buildSubscription(const std::vector<Symbol>& symbols, bool subscribe,
+                                            uint64_t requestId) const {
+    std::string channels;
+    for (const auto& symbol : symbols) {
+        for (const char* channel : {"book.", "trades.", "ticker."}) {
+            channels += (channels.empty() ? "\"" : ",\"") + std::string(channel) + symbol + ".100ms\"";
+        }
+    }
+    return "{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(requestId) + ",\"method\":\"public/" +
+           (subscribe ? "subscribe" : "unsubscribe") + "\",\"params\":{\"channels\":[" + channels + "]}}";
+}
+
+bool DeribitCodec::decode(const char* data, size_t length, const EventSink& sink) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    // {"jsonrpc":"2.0","method":"subscription","params":{"channel":"...","data":...}}
+    bool notification = false;
+    std::string_view channel;
+    const char* payload = nullptr;
+    size_t payloadLength = 0;
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "method") {
+            std::string_view method;
+            reader.readString(method);
+            notification = method == "subscription";
+        } else if (key == "params" && reader.enterObject()) {
+            std::string_view paramsKey;
+            while (reader.nextKey(paramsKey)) {
+                if (paramsKey == "channel") {
+                    reader.readString(channel);
+                } else if (paramsKey == "data") {
+                    // Kept as a view: channel may come after it
+                    size_t start = reader.getOffset();
+                    reader.skipValue();
+                    payload = data + start;
+                    payloadLength = reader.getOffset() - start;
+                } else {
+                    reader.skipValue();
+                }
+            }
+        } else {
+            reader.skipValue();
+        }
+    }
+    if (!reader.ok() || !notification || !payload) {
+        return false;  // RPC replies and heartbeats
+    }
+
+    event_.venue = Exchange::DERIBIT;
+    if (channel.compare(0, 5, "book.") == 0) {
+        return decodeBook(payload, payloadLength, sink);
+    }
+    if (channel.compare(0, 7, "trades.") == 0) {
+        return decodeTrades(payload, payloadLength, sink);
+    }
+    if (channel.compare(0, 7, "ticker.") == 0) {
+        return decodeTicker(payload, payloadLength, sink);
+    }
+    return false;
+}
+
+bool DeribitCodec::buildSnapshotRequest(const Symbol& symbol, std::string& path, std::string& query) const {
+    path = "/api/v2/public/get_order_book";
+    query = "instrument_name=" + symbol + "&depth=1000";
+    return true;
+}
+
+bool DeribitCodec::decodeSnapshot(const Symbol& symbol, const char* data, size_t length, VenueEvent& snapshot) const {
+    // {"jsonrpc":"2.0","result":{"change_id":N,"bids":[[price,amount],...],"asks":[...],...}}
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+    snapshot.reset(VenueEvent::Type::BOOK_SNAPSHOT);
+    snapshot.venue = Exchange::DERIBIT;
+    snapshot.symbol = symbol;
+    snapshot.time = std::chrono::system_clock::now();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key != "result" || !reader.enterObject()) {
+            reader.skipValue();
+            continue;
+        }
+        std::string_view resultKey;
+        while (reader.nextKey(resultKey)) {
+            if (resultKey == "change_id") {
+                reader.readUnsigned(snapshot.sequence);
+            } else if (resultKey == "timestamp") {
+                readMillis(reader, snapshot.time);
+            } else if (resultKey == "bids" || resultKey == "asks") {
+                std::vector<PriceLevel>& levels = resultKey == "bids" ? snapshot.bids : snapshot.asks;
+                PriceLevel level;
+                if (reader.enterArray()) {
+                    while (reader.nextElement() && reader.readPair(level.price, level.quantity)) {
+                        levels.push_back(level);
+                    }
+                }
+            } else {
+                reader.skipValue();
+            }
+        }
+    }
+    snapshot.firstSequence = snapshot.sequence;
+    return reader.ok() && snapshot.sequence != 0;  // Errors come as {"error":{...}}
+}
+
+// Private methods
+bool DeribitCodec::decodeBook(const char* data, size_t length, const EventSink& sink) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    VenueEvent& event = event_;
+    event.reset(VenueEvent::Type::BOOK_UPDATE);
+    event.symbol.clear();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "type") {
+            std::string_view type;
+            reader.readString(type);
+            if (type == "snapshot") {
+                event.type = VenueEvent::Type::BOOK_SNAPSHOT;
+            }
+        } else if (key == "instrument_name") {
+            reader.readString(event.symbol);
+        } else if (key == "timestamp") {
+            readMillis(reader, event.time);
+        } else if (key == "change_id") {
+            reader.readUnsigned(event.sequence);
+        } else if (key == "prev_change_id") {
+            reader.readUnsigned(event.previousSequence);
+        } else if (key == "bids") {
+            readActionLevels(reader, event.bids);
+        } else if (key == "asks") {
+            readActionLevels(reader, event.asks);
+        } else {
+            reader.skipValue();
+        }
+    }
+    if (!reader.ok() || event.symbol.empty()) {
+        return false;
+    }
+    // Change ids are not contiguous; this one covers everything after prev_change_id
+    event.firstSequence = event.previousSequence != 0 ? event.previousSequence + 1 : event.sequence;
+    sink(event);
+    return true;
+}
+
+bool DeribitCodec::decodeTrades(const char* data, size_t length, const EventSink& sink) {
+    // An array of trades, oldest first
+    JsonReader reader(data, length);
+    if (!reader.enterArray()) {
+        return false;
+    }
+
+    VenueEvent& event = event_;
+    while (reader.nextElement()) {
+        if (!reader.enterObject()) {
+            return false;
+        }
+        event.reset(VenueEvent::Type::TRADE);
+        event.symbol.clear();
+        std::string_view key;
+        while (reader.nextKey(key)) {
+            if (key == "instrument_name") {
+                reader.readString(event.symbol);
+            } else if (key == "price") {
+                reader.readDouble(event.price);
+            } else if (key == "amount") {
+                reader.readDouble(event.quantity);
+            } else if (key == "direction") {
+                std::string_view direction;
+                reader.readString(direction);
+                event.side = direction == "sell" ? OrderSide::SELL : OrderSide::BUY;
+            } else if (key == "trade_seq") {
+                reader.readUnsigned(event.sequence);
+            } else if (key == "timestamp") {
+                readMillis(reader, event.time);
+            } else {
+                reader.skipValue();
+            }
+        }
+        if (!reader.ok() || event.symbol.empty()) {
+            return false;
+        }
+        sink(event);
+    }
+    return reader.ok();
+}
+
+bool DeribitCodec::decodeTicker(const char* data, size_t length, const EventSink& sink) {
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+
+    VenueEvent& event = event_;
+    event.reset(VenueEvent::Type::TICK);
+    event.symbol.clear();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "instrument_name") {
+            reader.readString(event.symbol);
+        } else if (key == "best_bid_price") {
+            readOptionalDouble(reader, event.bid);
+        } else if (key == "best_ask_price") {
+            readOptionalDouble(reader, event.ask);
+        } else if (key == "last_price") {
+            readOptionalDouble(reader, event.price);
+        } else if (key == "timestamp") {
+            readMillis(reader, event.time);
+        } else {
+            reader.skipValue();
+        }
+    }
+    if (!reader.ok() || event.symbol.empty()) {
+        return false;
+    }
+    sink(event);
+    return true;
+}
+
+} // namespace MasterMind
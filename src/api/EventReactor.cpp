@@ -0,0 +1,367 @@
+#include "api/EventReactor.h"
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <iostream>
+#ifdef __linux__
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace MasterMind {
+
+namespace {
+constexpr int MAX_EVENTS = 64;
+
+// Single-writer counters: a plain load and store, no locked instruction
+inline void bump(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+std::mutex sharedPoolMutex;
+ReactorPoolConfig sharedPoolConfig;
+bool sharedPoolBuilt = false;
+}
+
+EventReactor::EventReactor(const std::string& name)
+    : name_(name), epoll_(-1), wake_(-1), threadId_(std::thread::id()), running_(false), sourceCount_(0),
+      wakePending_(false), nextTimerId_(1), wakeups_(0), events_(0), tasksRun_(0), timersFired_(0),
+      maxHandlerMicros_(0) {
+}
+
+EventReactor::~EventReactor() {
+    stop();
+}
+
+bool EventReactor::start(int cpu) {
+    if (running_) {
+        return true;
+    }
+#ifdef __linux__
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_ < 0 || wake_ < 0) {
+        std::cout << "EventReactor " << name_ << ": cannot create epoll/eventfd: " << std::strerror(errno) << std::endl;
+        stop();
+        return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, wake_, &event);
+
+    running_ = true;
+    thread_ = std::thread(&EventReactor::loop, this);
+    threadId_.store(thread_.get_id(), std::memory_order_relaxed);
+    if (cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        if (pthread_setaffinity_np(thread_.native_handle(), sizeof(cpus), &cpus) != 0) {
+            std::cout << "EventReactor " << name_ << ": cannot pin to CPU " << cpu << std::endl;
+        }
+    }
+    return true;
+#else
+    (void)cpu;
+    std::cout << "EventReactor requires Linux (epoll)" << std::endl;
+    return false;
+#endif
+}
+
+void EventReactor::stop() {
+    if (thread_.joinable()) {
+        running_ = false;
+        wake();
+        thread_.join();
+    }
+    running_ = false;
+    threadId_.store(std::thread::id(), std::memory_order_relaxed);
+    runTasks();  // Posted after the loop exited; owners may be waiting on them
+#ifdef __linux__
+    for (int* fd : {&epoll_, &wake_}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+#endif
+}
+
+bool EventReactor::add(int fd, uint32_t events, Handler handler) {
+#ifdef __linux__
+    if (epoll_ < 0) {
+        return false;
+    }
+    auto source = std::make_shared<Source>();
+    source->fd = fd;
+    source->handler = std::move(handler);
+
+    std::lock_guard<std::mutex> lock(sourcesMutex_);
+    epoll_event event{};
+    event.events = events;
+    event.data.ptr = source.get();
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return false;
+    }
+    sources_[fd] = std::move(source);
+    sourceCount_.store(sources_.size(), std::memory_order_relaxed);
+    return true;
+#else
+    (void)fd;
+    (void)events;
+    (void)handler;
+    return false;
+#endif
+}
+
+bool EventReactor::modify(int fd, uint32_t events) {
+#ifdef __linux__
+    std::lock_guard<std::mutex> lock(sourcesMutex_);
+    auto it = sources_.find(fd);
+    if (it == sources_.end()) {
+        return false;
+    }
+    epoll_event event{};
+    event.events = events;
+    event.data.ptr = it->second.get();
+    return epoll_ctl(epoll_, EPOLL_CTL_MOD, fd, &event) == 0;
+#else
+    (void)fd;
+    (void)events;
+    return false;
+#endif
+}
+
+void EventReactor::remove(int fd) {
+#ifdef __linux__
+    std::lock_guard<std::mutex> lock(sourcesMutex_);
+    auto it = sources_.find(fd);
+    if (it == sources_.end()) {
+        return;
+    }
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, fd, nullptr);
+    it->second->active = false;
+    retired_.push_back(std::move(it->second));  // Its pointer may still be in the current batch
+    sources_.erase(it);
+    sourceCount_.store(sources_.size(), std::memory_order_relaxed);
+#else
+    (void)fd;
+#endif
+}
+
+void EventReactor::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex_);
+        tasks_.push_back(std::move(task));
+    }
+    if (!wakePending_.exchange(true, std::memory_order_acq_rel)) {
+        wake();
+    }
+}
+
+void EventReactor::runSync(const Task& task) {
+    if (!running_ || inReactorThread()) {
+        task();
+        return;
+    }
+    auto done = std::make_shared<std::promise<void>>();
+    std::future<void> finished = done->get_future();
+    post([&task, done]() {
+        task();
+        done->set_value();
+    });
+    finished.wait();
+}
+
+EventReactor::TimerId EventReactor::runAt(SteadyTime when, Task task) {
+    TimerId id;
+    {
+        std::lock_guard<std::mutex> lock(timersMutex_);
+        id = nextTimerId_++;
+        timers_.emplace(std::make_pair(when, id), std::move(task));
+        timerDeadlines_[id] = when;
+    }
+    if (!inReactorThread()) {
+        wake();  // The loop may be sleeping past this deadline
+    }
+    return id;
+}
+
+void EventReactor::cancelTimer(TimerId id) {
+    std::lock_guard<std::mutex> lock(timersMutex_);
+    auto it = timerDeadlines_.find(id);
+    if (it != timerDeadlines_.end()) {
+        timers_.erase(std::make_pair(it->second, id));
+        timerDeadlines_.erase(it);
+    }
+}
+
+EventReactorStats EventReactor::getStats() const {
+    EventReactorStats stats;
+    stats.wakeups = wakeups_.load(std::memory_order_relaxed);
+    stats.events = events_.load(std::memory_order_relaxed);
+    stats.tasks = tasksRun_.load(std::memory_order_relaxed);
+    stats.timers = timersFired_.load(std::memory_order_relaxed);
+    stats.sources = sourceCount_.load(std::memory_order_relaxed);
+    stats.maxHandlerMicros = maxHandlerMicros_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// Private methods
+void EventReactor::loop() {
+#ifdef __linux__
+    threadId_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    epoll_event events[MAX_EVENTS];
+    while (running_) {
+        int n = epoll_wait(epoll_, events, MAX_EVENTS, nextTimeoutMillis(std::chrono::steady_clock::now()));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cout << "EventReactor " << name_ << ": epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        bump(wakeups_);
+
+        for (int i = 0; i < n; ++i) {
+            if (!events[i].data.ptr) {
+                uint64_t count;
+                ssize_t ignored = ::read(wake_, &count, sizeof(count));
+                (void)ignored;
+                continue;
+            }
+            Source* source = static_cast<Source*>(events[i].data.ptr);
+            if (!source->active.load(std::memory_order_relaxed)) {
+                continue;  // Removed by an earlier handler in this batch
+            }
+            bump(events_);
+            SteadyTime start = std::chrono::steady_clock::now();
+            source->handler(events[i].events);
+            recordHandler(start);
+        }
+
+        runTimers(std::chrono::steady_clock::now());
+        runTasks();
+        std::lock_guard<std::mutex> lock(sourcesMutex_);
+        retired_.clear();
+    }
+#endif
+}
+
+void EventReactor::wake() {
+#ifdef __linux__
+    if (wake_ >= 0) {
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wake_, &one, sizeof(one));
+        (void)ignored;
+    }
+#endif
+}
+
+void EventReactor::runTasks() {
+    std::vector<Task> tasks;
+    wakePending_.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex_);
+        tasks.swap(tasks_);
+    }
+    for (auto& task : tasks) {
+        bump(tasksRun_);
+        SteadyTime start = std::chrono::steady_clock::now();
+        task();
+        recordHandler(start);
+    }
+}
+
+void EventReactor::runTimers(SteadyTime now) {
+    for (;;) {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(timersMutex_);
+            if (timers_.empty() || timers_.begin()->first.first > now) {
+                return;
+            }
+            auto it = timers_.begin();
+            task = std::move(it->second);
+            timerDeadlines_.erase(it->first.second);
+            timers_.erase(it);
+        }
+        bump(timersFired_);
+        SteadyTime start = std::chrono::steady_clock::now();
+        task();
+        recordHandler(start);
+    }
+}
+
+int EventReactor::nextTimeoutMillis(SteadyTime now) {
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex_);
+        if (!tasks_.empty()) {
+            return 0;
+        }
+    }
+    std::lock_guard<std::mutex> lock(timersMutex_);
+    if (timers_.empty()) {
+        return -1;
+    }
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(timers_.begin()->first.first - now).count();
+    return static_cast<int>(std::max<int64_t>(std::min<int64_t>(wait + 1, INT32_MAX), 0));  // Round up, never early
+}
+
+void EventReactor::recordHandler(SteadyTime start) {
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    if (micros > maxHandlerMicros_.load(std::memory_order_relaxed)) {
+        maxHandlerMicros_.store(micros, std::memory_order_relaxed);
+    }
+}
+
+ReactorPool::ReactorPool(const ReactorPoolConfig& config) {
+    size_t threads = std::max<size_t>(config.threads, 1);
+    for (size_t i = 0; i < threads; ++i) {
+        reactors_.push_back(std::make_unique<EventReactor>("reactor-" + std::to_string(i)));
+        int cpu = config.cpus.empty() ? -1 : config.cpus[i % config.cpus.size()];
+        reactors_.back()->start(cpu);
+    }
+}
+
+ReactorPool::~ReactorPool() {
+    for (auto& reactor : reactors_) {
+        reactor->stop();
+    }
+}
+
+ReactorPool& ReactorPool::shared() {
+    static ReactorPool* pool = [] {
+        std::lock_guard<std::mutex> lock(sharedPoolMutex);
+        sharedPoolBuilt = true;
+        // Never destroyed: connections may still be closing during static destruction
+        return new ReactorPool(sharedPoolConfig);
+    }();
+    return *pool;
+}
+
+bool ReactorPool::configureShared(const ReactorPoolConfig& config) {
+    std::lock_guard<std::mutex> lock(sharedPoolMutex);
+    if (sharedPoolBuilt) {
+        return false;
+    }
+    sharedPoolConfig = config;
+    return true;
+}
+
+EventReactor& ReactorPool::next() {
+    EventReactor* best = reactors_.front().get();
+    for (auto& reactor : reactors_) {
+        if (reactor->getSourceCount() < best->getSourceCount()) {
+            best = reactor.get();
+        }
+    }
+    return *best;
+}
+
+} // namespace MasterMind
@@ -1,15 +1,42 @@
 #include "api/ExchangeAPI.h"
+#include "api/BookSynchronizer.h"
+#include "api/EventReactor.h"
+#include "api/HttpClient.h"
+#include "api/RateLimiter.h"
+#include "api/VenueCodec.h"
+#include "api/WebSocketClient.h"
+#include <algorithm>
 #include <iostream>
 
 namespace MasterMind {
 
 // ExchangeAPI base class implementation
 ExchangeAPI::ExchangeAPI(Exchange exchangeType)
-    : exchangeType_(exchangeType), connected_(false), authenticated_(false) {
+    : exchangeType_(exchangeType), connected_(false), authenticated_(false), sessionWanted_(false) {
     std::cout << "ExchangeAPI base class initialized for exchange type: " 
               << static_cast<int>(exchangeType) << std::endl;
 }
 
+void ExchangeAPI::setError(const std::string& error) const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    lastError_ = error;
+}
+
+std::shared_ptr<const OrderBook> ExchangeAPI::getOrderBook(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(orderBooksMutex_);
+    auto it = orderBooks_.find(symbol);
+    return it != orderBooks_.end() ? it->second : nullptr;
+}
+
+OrderBook& ExchangeAPI::getOrCreateOrderBook(const Symbol& symbol) {
+    std::lock_guard<std::mutex> lock(orderBooksMutex_);
+    auto& book = orderBooks_[symbol];
+    if (!book) {
+        book = std::make_shared<OrderBook>(symbol);
+    }
+    return *book;
+}
+
 void ExchangeAPI::notifyTick(const Tick& tick) {
     if (tickCallback_) {
         tickCallback_(tick);
@@ -22,6 +49,12 @@ void ExchangeAPI::notifyOrderUpdate(const Order& order) {
     }
 }
 
+void ExchangeAPI::notifyFill(const OrderId& orderId, Volume quantity, Price price) {
+    if (fillCallback_) {
+        fillCallback_(orderId, quantity, price);
+    }
+}
+
 void ExchangeAPI::notifyPositionUpdate(const Position& position) {
     if (positionCallback_) {
         positionCallback_(position);
@@ -34,24 +67,626 @@ void ExchangeAPI::notifyAccountUpdate(const AccountInfo& account) {
     }
 }
 
+void ExchangeAPI::notifyOrderBookUpdate(const Symbol& symbol) {
+    if (orderBookCallback_) {
+        orderBookCallback_(symbol);
+    }
+}
+
+void ExchangeAPI::publishAccount(const AccountInfo& account) {
+    if (accountCache_.updateAccount(account)) {
+        notifyAccountUpdate(account);
+    }
+}
+
+void ExchangeAPI::publishBalance(const std::string& asset, double free, double locked, TimePoint time) {
+    // Only the account currency moves AccountInfo; other assets are cached silently
+    if (accountCache_.updateBalance(asset, free, locked, time) && asset == accountCache_.getCurrency()) {
+        notifyAccountUpdate(accountCache_.getAccountInfo());
+    }
+}
+
+void ExchangeAPI::publishPosition(const Position& position) {
+    if (accountCache_.updatePosition(position)) {
+        notifyPositionUpdate(position);
+    }
+}
+
+void ExchangeAPI::publishFill(const OrderId& orderId, const Symbol& symbol, OrderSide side, Volume quantity,
+                              Price price, TimePoint time) {
+    notifyFill(orderId, quantity, price);
+    if (accountCache_.applyFill(symbol, side, quantity, price, time)) {
+        notifyPositionUpdate(accountCache_.getPosition(symbol));
+    }
+}
+
 // WebSocketExchangeAPI implementation
 WebSocketExchangeAPI::WebSocketExchangeAPI(Exchange exchangeType)
-    : ExchangeAPI(exchangeType), wsConnected_(false) {
+    : ExchangeAPI(exchangeType), wsConnected_(false), streamRequestId_(0),
+      eventSink_([this](const VenueEvent& event) { onVenueEvent(event); }),
+      activeClient_(nullptr), streamWanted_(false), failovers_(0) {
     std::cout << "WebSocketExchangeAPI initialized" << std::endl;
 }
 
 WebSocketExchangeAPI::~WebSocketExchangeAPI() {
-    if (wsConnected_) {
+    // The handlers are pure virtual here, so detach them before closing
+    if (wsClient_) {
+        wsClient_->clearHandlers();
+        standbyClient_->clearHandlers();
+        wsClient_->disconnect();
+        standbyClient_->disconnect();
+        if (snapshotClient_) {
+            snapshotClient_->close();  // Fails fetches in flight; their completions are posted
+        }
+        // Runs after those completions: nothing of ours is left on the reactor
+        wsClient_->getReactor()->runSync([this]() { stopBookRecovery(); });
+    }
+    wsConnected_ = false;
+}
+
+bool WebSocketExchangeAPI::connectWebSocket() {
+    if (wsUrl_.empty()) {
+        setError("No WebSocket endpoint configured");
+        return false;
+    }
+    
+    if (!wsClient_) {
+        // Both slots feed the same books, so they share the reactor that owns them
+        EventReactor* reactor = &ReactorPool::shared().next();
+        wsClient_ = std::make_unique<WebSocketClient>(reactor);
+        standbyClient_ = std::make_unique<WebSocketClient>(reactor);
+        bindStreamClient(wsClient_.get());
+        bindStreamClient(standbyClient_.get());
+        activeClient_ = wsClient_.get();
+    }
+    
+    WebSocketClient* client = activeClient_;
+    if (!client->connect(wsUrl_)) {
+        setError(client->getLastError());
+        return false;
+    }
+    return true;
+}
+
+bool WebSocketExchangeAPI::disconnectWebSocket() {
+    streamWanted_ = false;  // First, so the lost handlers neither fail over nor report it
+    if (wsClient_) {
+        wsClient_->disconnect();
+        standbyClient_->disconnect();
+        // Books resync from the next connection's first update
+        wsClient_->getReactor()->runSync([this]() {
+            stopBookRecovery();
+            activeClient_ = wsClient_.get();
+        });
+    }
+    wsConnected_ = false;
+    return true;
+}
+
+bool WebSocketExchangeAPI::isWebSocketConnected() const {
+    WebSocketClient* client = activeClient_;
+    return client && client->isConnected();
+}
+
+bool WebSocketExchangeAPI::sendWebSocketMessage(const std::string& message) {
+    WebSocketClient* client = activeClient_;
+    if (!client || !client->send(message)) {
+        setError("WebSocket not connected");
+        return false;
+    }
+    return true;
+}
+
+void WebSocketExchangeAPI::setStreamEndpoint(const std::string& url) {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    streamEndpoint_ = url;
+    while (!streamEndpoint_.empty() && streamEndpoint_.back() == '/') {
+        streamEndpoint_.pop_back();
+    }
+}
+
+std::string WebSocketExchangeAPI::getStreamEndpoint() const {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    return streamEndpoint_;
+}
+
+void WebSocketExchangeAPI::onWebSocketMessage(const char* data, size_t length) {
+    if (codec_) {
+        codec_->decode(data, length, eventSink_);
+    }
+}
+
+void WebSocketExchangeAPI::setCodec(std::unique_ptr<VenueCodec> codec) {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    codec_ = std::move(codec);
+    streamEndpoint_ = codec_ ? codec_->getDefaultEndpoint() : "";
+    snapshotEndpoint_ = codec_ ? codec_->getSnapshotEndpoint() : "";
+    bookSync_ = std::make_unique<BookSynchronizer>(!snapshotEndpoint_.empty());
+    snapshotEvent_ = std::make_unique<VenueEvent>();
+}
+
+BookSyncStats WebSocketExchangeAPI::getBookSyncStats() const {
+    return bookSync_ ? bookSync_->getStats() : BookSyncStats();
+}
+
+bool WebSocketExchangeAPI::subscribeStreams(const std::vector<Symbol>& symbols) {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    if (!codec_) {
+        setError("No market data codec for this venue");
+        return false;
+    }
+    
+    std::vector<Symbol> added;
+    for (const auto& symbol : symbols) {
+        if (symbol.empty()) {
+            setError("Empty symbol in market data subscription");
+            return false;
+        }
+        if (std::find(streamSymbols_.begin(), streamSymbols_.end(), symbol) == streamSymbols_.end() &&
+            std::find(added.begin(), added.end(), symbol) == added.end()) {
+            added.push_back(symbol);
+        }
+    }
+    if (added.empty()) {
+        return true;
+    }
+    
+    // A live connection takes new symbols in place; otherwise open one
+    // stream carrying everything subscribed so far
+    if (isWebSocketConnected()) {
+        std::string message = codec_->buildSubscription(added, true, ++streamRequestId_);
+        if (!sendWebSocketMessage(message)) {
+            return false;
+        }
+        sendToStandby(message);
+        streamSymbols_.insert(streamSymbols_.end(), added.begin(), added.end());
+    } else {
+        std::vector<Symbol> all = streamSymbols_;
+        all.insert(all.end(), added.begin(), added.end());
+        
+        wsUrl_ = codec_->buildStreamUrl(streamEndpoint_, all);
+        if (!connectWebSocket()) {
+            return false;
+        }
+        streamWanted_ = true;
+        if (!codec_->subscribesInUrl() &&
+            !sendWebSocketMessage(codec_->buildSubscription(all, true, ++streamRequestId_))) {
+            return false;
+        }
+        streamSymbols_ = std::move(all);
+        notifyStreamState();  // A supervisor can open the standby now
+    }
+    
+    std::cout << codec_->getName() << ": subscribed to market data for " << added.size() << " symbols" << std::endl;
+    return true;
+}
+
+bool WebSocketExchangeAPI::unsubscribeStreams(const std::vector<Symbol>& symbols) {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    
+    std::vector<Symbol> removed;
+    for (const auto& symbol : symbols) {
+        auto it = std::find(streamSymbols_.begin(), streamSymbols_.end(), symbol);
+        if (it != streamSymbols_.end()) {
+            streamSymbols_.erase(it);
+            removed.push_back(symbol);
+        }
+    }
+    if (removed.empty()) {
+        return true;
+    }
+    
+    if (streamSymbols_.empty()) {
         disconnectWebSocket();
+    } else if (isWebSocketConnected()) {
+        std::string message = codec_->buildSubscription(removed, false, ++streamRequestId_);
+        if (!sendWebSocketMessage(message)) {
+            return false;
+        }
+        sendToStandby(message);
+    }
+    {
+        std::lock_guard<std::mutex> ticksLock(streamTicksMutex_);
+        for (const auto& symbol : removed) {
+            streamTicks_.erase(symbol);
+        }
+    }
+    
+    std::cout << codec_->getName() << ": unsubscribed from market data for " << removed.size() << " symbols"
+              << std::endl;
+    return true;
+}
+
+WebSocketExchangeAPI::StreamState WebSocketExchangeAPI::getStreamState() const {
+    if (!streamWanted_) {
+        return StreamState::IDLE;
+    }
+    return isWebSocketConnected() ? StreamState::UP : StreamState::DOWN;
+}
+
+void WebSocketExchangeAPI::checkStreamHeartbeat(Duration interval) {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    if (!wsClient_ || interval <= Duration(0)) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    for (WebSocketClient* client : {wsClient_.get(), standbyClient_.get()}) {
+        if (!client->isConnected()) {
+            continue;
+        }
+        auto silence = now - client->getLastReceiveTime();
+        if (silence >= 2 * interval) {
+            std::cout << getStreamName() << ": no data for "
+                      << std::chrono::duration_cast<Duration>(silence).count() << "ms, dropping the connection"
+                      << std::endl;
+            client->disconnect();  // Fails over, or reports the stream down
+        } else if (silence >= interval) {
+            client->ping();  // Quiet markets still answer a ping
+        }
+    }
+}
+
+bool WebSocketExchangeAPI::restoreStream() {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    if (!codec_ || streamSymbols_.empty() || isWebSocketConnected()) {
+        return true;  // Nothing to restore
+    }
+    
+    streamWanted_ = true;  // A failed attempt leaves the stream DOWN, not IDLE
+    wsUrl_ = codec_->buildStreamUrl(streamEndpoint_, streamSymbols_);
+    if (!connectWebSocket()) {
+        return false;
+    }
+    if (!codec_->subscribesInUrl() &&
+        !sendWebSocketMessage(codec_->buildSubscription(streamSymbols_, true, ++streamRequestId_))) {
+        return false;
+    }
+    std::cout << codec_->getName() << ": market data stream restored for " << streamSymbols_.size() << " symbols"
+              << std::endl;
+    return true;
+}
+
+bool WebSocketExchangeAPI::ensureStandby() {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    if (!codec_ || !streamWanted_ || !isWebSocketConnected()) {
+        return false;  // A standby only backs a live stream
+    }
+    WebSocketClient* standby = peerOf(activeClient_);
+    if (standby->isConnected()) {
+        return true;
+    }
+    
+    if (!standby->connect(codec_->buildStreamUrl(streamEndpoint_, streamSymbols_))) {
+        setError("Standby stream: " + standby->getLastError());
+        return false;
+    }
+    if (!codec_->subscribesInUrl()) {
+        standby->send(codec_->buildSubscription(streamSymbols_, true, ++streamRequestId_));
+    }
+    std::cout << codec_->getName() << ": standby market data connection ready" << std::endl;
+    return true;
+}
+
+void WebSocketExchangeAPI::dropStandby() {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    if (wsClient_) {
+        peerOf(activeClient_)->disconnect();
+    }
+}
+
+bool WebSocketExchangeAPI::hasStandby() const {
+    WebSocketClient* client = activeClient_;
+    return client && peerOf(client)->isConnected();
+}
+
+void WebSocketExchangeAPI::setStreamStateCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(streamStateMutex_);
+    streamStateCallback_ = std::move(callback);
+}
+
+bool WebSocketExchangeAPI::getStreamTick(const Symbol& symbol, Tick& tick) const {
+    std::lock_guard<std::mutex> lock(streamTicksMutex_);
+    auto it = streamTicks_.find(symbol);
+    if (it == streamTicks_.end()) {
+        return false;
+    }
+    tick = it->second;
+    return true;
+}
+
+void WebSocketExchangeAPI::applyVenueEvent(const VenueEvent& event) {
+    switch (event.type) {
+        case VenueEvent::Type::TICK:
+        case VenueEvent::Type::TRADE: {
+            Tick tick;
+            {
+                std::lock_guard<std::mutex> lock(streamTicksMutex_);
+                Tick& cached = streamTicks_[event.symbol];
+                cached.symbol = event.symbol;
+                if (event.type == VenueEvent::Type::TRADE) {
+                    cached.last = event.price;
+                    cached.volume = event.quantity;  // Size of the last trade
+                } else {
+                    // Venues leave out fields that did not change
+                    cached.bid = event.bid > 0 ? event.bid : cached.bid;
+                    cached.ask = event.ask > 0 ? event.ask : cached.ask;
+                    cached.last = event.price > 0 ? event.price : cached.last;
+                }
+                cached.timestamp = event.time;
+                tick = cached;
+            }
+            notifyTick(tick);
+            break;
+        }
+        case VenueEvent::Type::BOOK_SNAPSHOT:
+            getOrCreateOrderBook(event.symbol).applySnapshot(event.bids, event.asks, event.sequence);
+            notifyOrderBookUpdate(event.symbol);
+            break;
+        case VenueEvent::Type::BOOK_UPDATE:
+            getOrCreateOrderBook(event.symbol).applyDiff(event.bids, event.asks, event.sequence);
+            notifyOrderBookUpdate(event.symbol);
+            break;
+    }
+    if (venueEventCallback_) {
+        venueEventCallback_(event);
+    }
+}
+
+void WebSocketExchangeAPI::fetchBookSnapshot(const std::string& path, const std::string& query,
+                                             std::function<void(const HttpResponse&)> done) {
+    // Reactor thread: the client is created on the stream's own reactor
+    if (!snapshotClient_) {
+        snapshotClient_ = std::make_unique<HttpClient>(snapshotEndpoint_, HttpClientConfig(), wsClient_->getReactor());
+    }
+    snapshotClient_->request("GET", path, query, "", std::move(done));
+}
+
+// Private methods
+void WebSocketExchangeAPI::bindStreamClient(WebSocketClient* client) {
+    client->setMessageHandler([this, client](const char* data, size_t length) {
+        if (activeClient_.load(std::memory_order_relaxed) == client) {
+            onWebSocketMessage(data, length);  // A standby's copy is dropped unread
+        }
+    });
+    client->setConnectHandler([this, client]() {
+        if (activeClient_ == client) {
+            wsConnected_ = true;
+            onWebSocketConnect();
+        }
+    });
+    client->setDisconnectHandler([this, client]() { onStreamLost(client); });
+    client->setErrorHandler([this, client](const std::string& error) {
+        if (activeClient_ == client) {
+            onWebSocketError(error);
+        }
+    });
+}
+
+WebSocketClient* WebSocketExchangeAPI::peerOf(WebSocketClient* client) const {
+    return client == wsClient_.get() ? standbyClient_.get() : wsClient_.get();
+}
+
+void WebSocketExchangeAPI::onStreamLost(WebSocketClient* client) {
+    // Reactor thread
+    if (activeClient_ != client) {
+        if (streamWanted_) {
+            notifyStreamState();  // The standby: the supervisor opens another
+        }
+        return;
+    }
+    
+    if (bookSync_) {
+        bookSync_->onStreamSwitch();  // Whichever connection comes next continues the books
+    }
+    WebSocketClient* peer = peerOf(client);
+    if (streamWanted_ && peer->isConnected()) {
+        activeClient_ = peer;
+        failovers_++;
+        std::cout << getStreamName() << ": market data failed over to the standby connection" << std::endl;
+        notifyStreamState();
+        return;
+    }
+    wsConnected_ = false;
+    onWebSocketDisconnect();
+    if (streamWanted_) {
+        notifyStreamState();
+    }
+}
+
+void WebSocketExchangeAPI::notifyStreamState() {
+    std::lock_guard<std::mutex> lock(streamStateMutex_);
+    if (streamStateCallback_) {
+        streamStateCallback_();
+    }
+}
+
+void WebSocketExchangeAPI::sendToStandby(const std::string& message) {
+    // Caller holds streamMutex_
+    WebSocketClient* standby = peerOf(activeClient_);
+    if (standby->isConnected()) {
+        standby->send(message);
+    }
+}
+
+std::string WebSocketExchangeAPI::getStreamName() const {
+    return codec_ ? codec_->getName() : "WebSocket";
+}
+
+void WebSocketExchangeAPI::onVenueEvent(const VenueEvent& event) {
+    if (event.type == VenueEvent::Type::BOOK_UPDATE) {
+        uint64_t generation = 0;
+        switch (bookSync_->onUpdate(event, generation)) {
+            case BookSynchronizer::Action::APPLY:
+                break;
+            case BookSynchronizer::Action::HOLD:
+                return;
+            case BookSynchronizer::Action::FETCH:
+                std::cout << codec_->getName() << " " << event.symbol << " book needs a snapshot at update "
+                          << event.sequence << ", holding updates" << std::endl;
+                requestBookSnapshot(event.symbol, generation);
+                return;
+        }
+    } else if (event.type == VenueEvent::Type::BOOK_SNAPSHOT) {
+        bookSync_->onStreamSnapshot(event);
+    }
+    applyVenueEvent(event);
+}
+
+void WebSocketExchangeAPI::requestBookSnapshot(const Symbol& symbol, uint64_t generation) {
+    std::string path;
+    std::string query;
+    if (!codec_->buildSnapshotRequest(symbol, path, query)) {
+        return;
+    }
+    // Completions come back to the stream's reactor, where the synchronizer lives
+    EventReactor* reactor = wsClient_->getReactor();
+    fetchBookSnapshot(path, query, [this, reactor, symbol, generation](const HttpResponse& response) {
+        reactor->post([this, symbol, generation, response]() { onBookSnapshot(symbol, generation, response); });
+    });
+}
+
+void WebSocketExchangeAPI::onBookSnapshot(const Symbol& symbol, uint64_t generation, const HttpResponse& response) {
+    if (!bookSync_->isRecovering(symbol, generation)) {
+        return;  // Abandoned: disconnected, or the stream resent the book itself
+    }
+    snapshotRetryTimers_.erase(symbol);
+    
+    VenueEvent& snapshot = *snapshotEvent_;
+    Duration delay(0);
+    if (response.ok() &&
+        codec_->decodeSnapshot(symbol, response.body.data(), response.body.size(), snapshot)) {
+        if (bookSync_->onSnapshot(snapshot, generation, [this](const VenueEvent& event) { applyVenueEvent(event); })) {
+            return;
+        }
+        delay = bookSync_->getRetryDelay(symbol);  // Older than the held updates
+    } else {
+        delay = bookSync_->onSnapshotFailed(symbol, generation);
+        std::cout << codec_->getName() << " " << symbol << " book snapshot failed ("
+                  << (response.error.empty() ? "HTTP " + std::to_string(response.status) : response.error)
+                  << "), retrying in " << delay.count() << "ms" << std::endl;
+    }
+    
+    snapshotRetryTimers_[symbol] = wsClient_->getReactor()->runAt(
+        std::chrono::steady_clock::now() + delay, [this, symbol, generation]() {
+            snapshotRetryTimers_.erase(symbol);
+            if (bookSync_->isRecovering(symbol, generation)) {
+                requestBookSnapshot(symbol, generation);
+            }
+        });
+}
+
+void WebSocketExchangeAPI::stopBookRecovery() {
+    // Reactor thread
+    for (const auto& timer : snapshotRetryTimers_) {
+        wsClient_->getReactor()->cancelTimer(timer.second);
+    }
+    snapshotRetryTimers_.clear();
+    if (bookSync_) {
+        bookSync_->clear();
     }
 }
 
 // RestExchangeAPI implementation
 RestExchangeAPI::RestExchangeAPI(Exchange exchangeType)
-    : ExchangeAPI(exchangeType) {
+    : ExchangeAPI(exchangeType), rateLimiter_(std::make_unique<RateLimiter>()),
+      coalescer_(std::make_unique<RequestCoalescer>()) {
     std::cout << "RestExchangeAPI initialized" << std::endl;
 }
 
-RestExchangeAPI::~RestExchangeAPI() = default;
+RestExchangeAPI::~RestExchangeAPI() {
+    closeHttpClient();
+}
+
+void RestExchangeAPI::setBaseUrl(const std::string& url) {
+    std::shared_ptr<HttpClient> previous;
+    {
+        std::lock_guard<std::mutex> lock(httpClientMutex_);
+        baseUrl_ = url;
+        previous.swap(httpClient_);
+    }
+    if (previous) {
+        previous->close();
+    }
+}
+
+std::string RestExchangeAPI::getBaseUrl() const {
+    std::lock_guard<std::mutex> lock(httpClientMutex_);
+    return baseUrl_;
+}
+
+void RestExchangeAPI::setRateLimit(const RateLimitConfig& config) {
+    rateLimiter_->setConfig(config);
+}
+
+RateLimitConfig RestExchangeAPI::getRateLimit() const {
+    return rateLimiter_->getConfig();
+}
+
+RateLimiterStats RestExchangeAPI::getRateLimiterStats() const {
+    return rateLimiter_->getStats();
+}
+
+TimerWheel& RestExchangeAPI::maintenanceTimers() {
+    // Never destroyed, like the shared reactor pool: venues may still stop during static destruction
+    static TimerWheel* timers = [] {
+        auto* wheel = new TimerWheel(std::chrono::milliseconds(100));
+        wheel->start();
+        return wheel;
+    }();
+    return *timers;
+}
+
+std::shared_ptr<HttpClient> RestExchangeAPI::getHttpClient() const {
+    std::lock_guard<std::mutex> lock(httpClientMutex_);
+    if (!httpClient_) {
+        httpClient_ = std::make_shared<HttpClient>(baseUrl_, HttpClientConfig(), &ReactorPool::shared().next());
+        applyAuthHeader(*httpClient_);
+    }
+    return httpClient_;
+}
+
+void RestExchangeAPI::refreshAuthHeader() {
+    std::lock_guard<std::mutex> lock(httpClientMutex_);
+    if (httpClient_) {
+        applyAuthHeader(*httpClient_);
+    }
+}
+
+void RestExchangeAPI::closeHttpClient() {
+    rateLimiter_->stop();  // Queued requests are refused before the client goes
+    
+    std::shared_ptr<HttpClient> client;
+    {
+        std::lock_guard<std::mutex> lock(httpClientMutex_);
+        client = httpClient_;
+    }
+    if (client) {
+        client->close();
+    }
+}
+
+std::string RestExchangeAPI::coalesce(const std::string& key, const std::function<std::string()>& fetch) const {
+    bool coalesced = false;
+    std::string result = coalescer_->run(key, fetch, &coalesced);
+    if (coalesced) {
+        rateLimiter_->recordCoalesced();
+    }
+    return result;
+}
+
+// Private methods
+void RestExchangeAPI::applyAuthHeader(HttpClient& client) const {
+    // Caller holds httpClientMutex_
+    if (apiKey_.empty()) {
+        return;
+    }
+    std::string header = buildAuthHeader();
+    size_t colon = header.find(':');
+    if (colon != std::string::npos) {
+        size_t valueStart = header.find_first_not_of(' ', colon + 1);
+        client.setDefaultHeader(header.substr(0, colon),
+                                valueStart == std::string::npos ? "" : header.substr(valueStart));
+    }
+}
 
 } // namespace MasterMind 
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "api/ExchangeAPI.h"
 #include "api/BinanceAPI.h"
+#include "api/SimulatedExchangeAPI.h"
+#include "api/StreamingExchangeAPI.h"
 #include <memory>
 #include <iostream>
 
@@ -17,6 +19,8 @@ std::unique_ptr<ExchangeAPI> ExchangeAPIFactory::createExchangeAPI(Exchange exch
             return createMT4API();
         case Exchange::MT5:
             return createMT5API();
+        case Exchange::SIMULATED:
+            return createSimulatedAPI();
         default:
             std::cerr << "Unsupported exchange type" << std::endl;
             return nullptr;
@@ -28,29 +32,31 @@ std::unique_ptr<ExchangeAPI> ExchangeAPIFactory::createBinanceAPI() {
 }
 
 std::unique_ptr<ExchangeAPI> ExchangeAPIFactory::createDeribitAPI() {
-    // Placeholder - would create DeribitAPI instance
-    std::cout << "Deribit API not yet implemented" << std::endl;
-    return nullptr;
+    // Market data through DeribitCodec; order entry not yet implemented
+    return std::make_unique<StreamingExchangeAPI>(Exchange::DERIBIT);
 }
 
 std::unique_ptr<ExchangeAPI> ExchangeAPIFactory::createCoinbaseAPI() {
-    // Placeholder - would create CoinbaseAPI instance
-    std::cout << "Coinbase API not yet implemented" << std::endl;
-    return nullptr;
+    // Market data through CoinbaseCodec; order entry not yet implemented
+    return std::make_unique<StreamingExchangeAPI>(Exchange::COINBASE);
 }
 
 std::unique_ptr<ExchangeAPI> ExchangeAPIFactory::createMT4API() {
-    // Placeholder - would create MT4API instance
+    // MetaTrader has no public socket API; needs a terminal-side bridge (EA) first
     std::cout << "MT4 API not yet implemented" << std::endl;
     return nullptr;
 }
 
 std::unique_ptr<ExchangeAPI> ExchangeAPIFactory::createMT5API() {
-    // Placeholder - would create MT5API instance
+    // MetaTrader has no public socket API; needs a terminal-side bridge (EA) first
     std::cout << "MT5 API not yet implemented" << std::endl;
     return nullptr;
 }
 
+std::unique_ptr<ExchangeAPI> ExchangeAPIFactory::createSimulatedAPI() {
+    return std::make_unique<SimulatedExchangeAPI>();
+}
+
 std::unique_ptr<ExchangeAPI> ExchangeAPIFactory::createFromConfig(const std::string& configFile) {
     // Placeholder - would read config and create appropriate API
     std::cout << "Configuration-based factory not yet implemented" << std::endl;
@@ -0,0 +1,810 @@
+#include "api/HttpClient.h"
+#include "api/WebSocketProtocol.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#ifdef __linux__
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#ifdef SSL_ENABLED
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#endif
+
+namespace MasterMind {
+
+using SteadyClock = std::chrono::steady_clock;
+
+struct HttpClient::Connection {
+    enum class State { CONNECTING, HANDSHAKING, READY };
+
+    int socket = -1;
+    void* ssl = nullptr;           // SSL* on https connections
+    State state = State::CONNECTING;
+    bool writeInterest = false;
+    std::deque<PendingRequest> inFlight;  // Responses arrive in this order
+    std::string output;
+    size_t outputOffset = 0;
+    std::string input;
+    bool closeAfterResponse = false;      // Server sent Connection: close
+    bool exclusive = false;               // A non-idempotent request is in flight
+    uint64_t served = 0;
+    SteadyClock::time_point opened;
+    SteadyClock::time_point lastActive;
+};
+
+namespace {
+constexpr size_t READ_CHUNK = 16 * 1024;
+
+bool isIdempotent(const std::string& method) {
+    return method == "GET" || method == "HEAD" || method == "PUT" || method == "DELETE" || method == "OPTIONS";
+}
+
+void bump(std::atomic<uint64_t>& counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+}
+
+std::string HttpResponse::header(const std::string& name) const {
+    return WebSocketProtocol::findHeader(head, name);
+}
+
+HttpClient::HttpClient(const std::string& baseUrl, const HttpClientConfig& config, EventReactor* reactor)
+    : baseUrl_(baseUrl), config_(config), secure_(false), valid_(false), reactor_(reactor), running_(false),
+      passPosted_(false), timer_(0), timerDeadline_(SteadyClock::time_point::max()), sslContext_(nullptr), openConnections_(0), requestsSent_(0), responsesReceived_(0), connectionsOpened_(0),
+      reusedConnections_(0), pipelinedRequests_(0), retries_(0), timeouts_(0), failures_(0) {
+    config_.maxConnections = std::max<size_t>(config_.maxConnections, 1);
+    config_.maxPipelineDepth = std::max<size_t>(config_.maxPipelineDepth, 1);
+
+    size_t hostStart = 0;
+    if (baseUrl.compare(0, 7, "http://") == 0) {
+        hostStart = 7;
+    } else if (baseUrl.compare(0, 8, "https://") == 0) {
+        secure_ = true;
+        hostStart = 8;
+    }
+    size_t hostEnd = std::min(baseUrl.find('/', hostStart), baseUrl.size());
+    std::string authority = hostStart > 0 ? baseUrl.substr(hostStart, hostEnd - hostStart) : "";
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos && authority.find(']', colon) == std::string::npos) {
+        host_ = authority.substr(0, colon);
+        port_ = authority.substr(colon + 1);
+    } else {
+        host_ = authority;
+        port_ = secure_ ? "443" : "80";
+    }
+    if (host_.size() > 2 && host_.front() == '[' && host_.back() == ']') {
+        host_ = host_.substr(1, host_.size() - 2);
+    }
+    valid_ = !host_.empty() && !port_.empty() && baseUrl.find_first_not_of('/', hostEnd) == std::string::npos;
+    if (!valid_) {
+        std::cout << "HttpClient: invalid base URL " << baseUrl << std::endl;
+        return;
+    }
+
+#ifdef __linux__
+#ifdef SSL_ENABLED
+    if (secure_) {
+        SSL_CTX* context = SSL_CTX_new(TLS_client_method());
+        if (context) {
+            SSL_CTX_set_default_verify_paths(context);
+            SSL_CTX_set_verify(context, SSL_VERIFY_PEER, nullptr);
+        }
+        sslContext_ = context;
+    }
+#endif
+    if (!reactor_) {
+        ownReactor_ = std::make_unique<EventReactor>("http");
+        if (!ownReactor_->start()) {
+            ownReactor_.reset();
+            return;  // Requests fail as closed
+        }
+        reactor_ = ownReactor_.get();
+    }
+    running_ = true;
+#endif
+}
+
+HttpClient::~HttpClient() {
+    close();
+}
+
+void HttpClient::setDefaultHeader(const std::string& name, const std::string& value) {
+    std::lock_guard<std::mutex> lock(templateMutex_);
+    auto it = std::find_if(defaultHeaders_.begin(), defaultHeaders_.end(),
+                           [&name](const std::pair<std::string, std::string>& header) { return header.first == name; });
+    if (value.empty()) {
+        if (it != defaultHeaders_.end()) {
+            defaultHeaders_.erase(it);
+        }
+    } else if (it != defaultHeaders_.end()) {
+        it->second = value;
+    } else {
+        defaultHeaders_.emplace_back(name, value);
+    }
+    templates_.clear();
+}
+
+void HttpClient::request(const std::string& method, const std::string& path, const std::string& query,
+                         const std::string& body, ResponseCallback callback) {
+    auto requestTemplate = getTemplate(method, path);
+
+    PendingRequest request;
+    request.idempotent = requestTemplate->idempotent;
+    request.expectsBody = requestTemplate->expectsBody;
+    request.retried = false;
+    request.submitted = SteadyClock::now();
+    request.deadline = request.submitted + config_.requestTimeout;
+    request.callback = std::move(callback);
+
+    std::string& wire = request.wire;
+    wire.reserve(requestTemplate->prefix.size() + query.size() + requestTemplate->suffix.size() + body.size() + 96);
+    wire += requestTemplate->prefix;
+    if (!query.empty()) {
+        wire += '?';
+        wire += query;
+    }
+    wire += requestTemplate->suffix;
+    if (!body.empty() || !requestTemplate->idempotent) {
+        wire += "Content-Type: application/x-www-form-urlencoded\r\nContent-Length: ";
+        wire += std::to_string(body.size());
+        wire += "\r\n";
+    }
+    wire += "\r\n";
+    wire += body;
+
+    {
+        // Checked under the lock the reactor drains with on shutdown, so no request is stranded
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (valid_ && running_) {
+            submitted_.push_back(std::move(request));
+            schedulePass();
+            return;
+        }
+    }
+    fail(request, valid_ ? "HTTP client is closed" : "Invalid base URL: " + baseUrl_);
+}
+
+std::future<HttpResponse> HttpClient::request(const std::string& method, const std::string& path,
+                                              const std::string& query, const std::string& body) {
+    auto promise = std::make_shared<std::promise<HttpResponse>>();
+    std::future<HttpResponse> future = promise->get_future();
+    if (reactor_ && reactor_->inReactorThread()) {
+        // The response could only arrive on this thread, which would be blocked in get()
+        HttpResponse response;
+        response.error = "Blocking request from the reactor thread; use the callback overload";
+        bump(failures_);
+        promise->set_value(response);
+        return future;
+    }
+    request(method, path, query, body, [promise](const HttpResponse& response) {
+        promise->set_value(response);
+    });
+    return future;
+}
+
+HttpClientStats HttpClient::getStats() const {
+    HttpClientStats stats;
+    stats.requestsSent = requestsSent_.load(std::memory_order_relaxed);
+    stats.responsesReceived = responsesReceived_.load(std::memory_order_relaxed);
+    stats.connectionsOpened = connectionsOpened_.load(std::memory_order_relaxed);
+    stats.reusedConnections = reusedConnections_.load(std::memory_order_relaxed);
+    stats.pipelinedRequests = pipelinedRequests_.load(std::memory_order_relaxed);
+    stats.retries = retries_.load(std::memory_order_relaxed);
+    stats.timeouts = timeouts_.load(std::memory_order_relaxed);
+    stats.failures = failures_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// Private methods
+std::shared_ptr<const HttpClient::RequestTemplate> HttpClient::getTemplate(const std::string& method,
+                                                                           const std::string& path) {
+    std::string key = method + ' ' + path;
+    std::lock_guard<std::mutex> lock(templateMutex_);
+    auto it = templates_.find(key);
+    if (it != templates_.end()) {
+        return it->second;
+    }
+
+    auto requestTemplate = std::make_shared<RequestTemplate>();
+    requestTemplate->prefix = key;
+    bool defaultPort = port_ == (secure_ ? "443" : "80");
+    requestTemplate->suffix = " HTTP/1.1\r\nHost: " + host_ + (defaultPort ? "" : ":" + port_) + "\r\n"
+                              "Connection: keep-alive\r\n"
+                              "Accept: application/json\r\n"
+                              "User-Agent: MasterMindTrader/1.0\r\n";
+    for (const auto& header : defaultHeaders_) {
+        requestTemplate->suffix += header.first + ": " + header.second + "\r\n";
+    }
+    requestTemplate->idempotent = isIdempotent(method);
+    requestTemplate->expectsBody = method != "HEAD";
+    templates_[key] = requestTemplate;
+    return requestTemplate;
+}
+
+void HttpClient::complete(PendingRequest& request, HttpResponse& response) {
+    response.latencyMicros = std::chrono::duration<double, std::micro>(SteadyClock::now() - request.submitted).count();
+    bump(responsesReceived_);
+    if (request.callback) {
+        request.callback(response);
+    }
+}
+
+void HttpClient::fail(PendingRequest& request, const std::string& error) {
+    HttpResponse response;
+    response.error = error;
+    response.latencyMicros = std::chrono::duration<double, std::micro>(SteadyClock::now() - request.submitted).count();
+    bump(failures_);
+    if (request.callback) {
+        request.callback(response);
+    }
+}
+
+bool HttpClient::parseResponses(Connection& connection, bool atEof) {
+    while (!connection.inFlight.empty()) {
+        size_t headEnd = connection.input.find("\r\n\r\n");
+        if (headEnd == std::string::npos) {
+            break;
+        }
+        std::string head = connection.input.substr(0, headEnd + 2);
+        if (head.compare(0, 5, "HTTP/") != 0 || head.size() < 12) {
+            closeConnection(connection, "Malformed HTTP response");
+            return false;
+        }
+        int status = std::atoi(head.c_str() + 9);
+        if (status >= 100 && status < 200) {
+            connection.input.erase(0, headEnd + 4);  // Interim response
+            continue;
+        }
+
+        PendingRequest& request = connection.inFlight.front();
+        HttpResponse response;
+        response.status = status;
+        response.head = head;
+        size_t bodyStart = headEnd + 4;
+        size_t consumed = 0;
+        std::string lengthHeader = WebSocketProtocol::findHeader(head, "Content-Length");
+        std::string encoding = WebSocketProtocol::findHeader(head, "Transfer-Encoding");
+        std::string connectionHeader = WebSocketProtocol::findHeader(head, "Connection");
+        bool closeAfter = connectionHeader == "close" || connectionHeader == "Close" || head.compare(0, 8, "HTTP/1.0") == 0;
+
+        if (!request.expectsBody || status == 204 || status == 304) {
+            consumed = bodyStart;
+        } else if (encoding.find("chunked") != std::string::npos) {
+            size_t position = bodyStart;
+            for (;;) {
+                size_t lineEnd = connection.input.find("\r\n", position);
+                if (lineEnd == std::string::npos) {
+                    return true;  // Wait for the rest
+                }
+                size_t chunkSize = std::strtoul(connection.input.c_str() + position, nullptr, 16);
+                if (chunkSize == 0) {
+                    size_t trailerEnd = connection.input.find("\r\n\r\n", lineEnd);  // Trailers end with a blank line
+                    if (trailerEnd == std::string::npos) {
+                        return true;
+                    }
+                    consumed = trailerEnd + 4;
+                    break;
+                }
+                if (connection.input.size() < lineEnd + 2 + chunkSize + 2) {
+                    return true;
+                }
+                response.body.append(connection.input, lineEnd + 2, chunkSize);
+                position = lineEnd + 2 + chunkSize + 2;
+            }
+        } else if (!lengthHeader.empty()) {
+            size_t length = std::strtoull(lengthHeader.c_str(), nullptr, 10);
+            if (connection.input.size() < bodyStart + length) {
+                return true;
+            }
+            response.body.assign(connection.input, bodyStart, length);
+            consumed = bodyStart + length;
+        } else {
+            if (!atEof) {
+                return true;  // Body runs to the end of the connection
+            }
+            response.body.assign(connection.input, bodyStart, std::string::npos);
+            consumed = connection.input.size();
+            closeAfter = true;
+        }
+
+        connection.input.erase(0, consumed);
+        connection.closeAfterResponse = connection.closeAfterResponse || closeAfter;
+        PendingRequest done = std::move(connection.inFlight.front());
+        connection.inFlight.pop_front();
+        connection.exclusive = connection.exclusive && !connection.inFlight.empty();
+        ++connection.served;
+        connection.lastActive = SteadyClock::now();
+        complete(done, response);
+    }
+
+    if (connection.closeAfterResponse) {
+        closeConnection(connection, "Server closed the connection");
+        return false;
+    }
+    return true;
+}
+
+void HttpClient::dispatch(SteadyClock::time_point now) {
+    while (!waiting_.empty()) {
+        Connection* connection = findConnection(waiting_.front());
+        if (!connection) {
+            // Grow the pool while requests outnumber the connections on their way
+            size_t connecting = std::count_if(connections_.begin(), connections_.end(), [](const std::unique_ptr<Connection>& c) {
+                return c->socket >= 0 && c->state != Connection::State::READY;
+            });
+            if (connecting < waiting_.size() && connections_.size() < config_.maxConnections) {
+                if (openConnection(now)) {
+                    continue;
+                }
+            }
+            break;
+        }
+
+        PendingRequest request = std::move(waiting_.front());
+        waiting_.pop_front();
+        if (connection->served > 0 || !connection->inFlight.empty()) {
+            bump(reusedConnections_);
+        }
+        if (!connection->inFlight.empty()) {
+            bump(pipelinedRequests_);
+        }
+        bump(requestsSent_);
+
+        connection->output += request.wire;
+        connection->exclusive = !request.idempotent;
+        connection->inFlight.push_back(std::move(request));
+        writeConnection(*connection);
+    }
+}
+
+HttpClient::Connection* HttpClient::findConnection(const PendingRequest& request) {
+    Connection* best = nullptr;
+    for (auto& connection : connections_) {
+        if (connection->socket < 0 || connection->state != Connection::State::READY ||
+            connection->closeAfterResponse || connection->exclusive) {
+            continue;
+        }
+        if (connection->inFlight.empty()) {
+            return connection.get();
+        }
+        if (request.idempotent && connection->inFlight.size() < config_.maxPipelineDepth &&
+            (!best || connection->inFlight.size() < best->inFlight.size())) {
+            best = connection.get();
+        }
+    }
+    return best;
+}
+
+void HttpClient::expire(SteadyClock::time_point now) {
+    for (auto it = waiting_.begin(); it != waiting_.end();) {
+        if (it->deadline <= now) {
+            bump(timeouts_);
+            fail(*it, "Request timed out");
+            it = waiting_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Connections are not shared with callbacks, so they can be closed in place
+    for (size_t i = 0; i < connections_.size(); ++i) {
+        Connection& connection = *connections_[i];
+        if (connection.socket < 0) {
+            continue;
+        }
+        if (connection.state != Connection::State::READY) {
+            if (now - connection.opened >= config_.connectTimeout) {
+                closeConnection(connection, "Connect timed out");
+            }
+            continue;
+        }
+
+        bool expired = false;
+        for (auto it = connection.inFlight.begin(); it != connection.inFlight.end();) {
+            if (it->deadline <= now) {
+                bump(timeouts_);
+                fail(*it, "Request timed out");
+                it = connection.inFlight.erase(it);
+                expired = true;
+            } else {
+                ++it;
+            }
+        }
+        if (expired) {
+            // The late response would be matched to the wrong request
+            closeConnection(connection, "Request timed out");
+        } else if (connection.inFlight.empty() && now - connection.lastActive >= config_.idleTimeout) {
+            closeConnection(connection, "Idle");
+        }
+    }
+}
+
+SteadyClock::time_point HttpClient::nextDeadline() const {
+    SteadyClock::time_point next = SteadyClock::time_point::max();
+    for (const auto& request : waiting_) {
+        next = std::min(next, request.deadline);
+    }
+    for (const auto& connection : connections_) {
+        if (connection->socket < 0) {
+            continue;
+        }
+        if (connection->state != Connection::State::READY) {
+            next = std::min(next, connection->opened + config_.connectTimeout);
+        } else if (connection->inFlight.empty()) {
+            next = std::min(next, connection->lastActive + config_.idleTimeout);
+        }
+        for (const auto& request : connection->inFlight) {
+            next = std::min(next, request.deadline);
+        }
+    }
+    return next;
+}
+
+void HttpClient::schedulePass() {
+    if (passPosted_.exchange(true, std::memory_order_acq_rel)) {
+        return;  // One pass picks up everything submitted before it runs
+    }
+    reactor_->post([this]() {
+        passPosted_.store(false, std::memory_order_release);
+        pass();
+    });
+}
+
+void HttpClient::pass() {
+    if (!running_) {
+        return;
+    }
+    std::vector<PendingRequest> incoming;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        incoming.swap(submitted_);
+    }
+    for (auto& request : incoming) {
+        waiting_.push_back(std::move(request));
+    }
+
+    SteadyClock::time_point now = SteadyClock::now();
+    expire(now);
+    dispatch(now);
+    connections_.erase(std::remove_if(connections_.begin(), connections_.end(),
+                                      [](const std::unique_ptr<Connection>& c) { return c->socket < 0; }),
+                       connections_.end());
+
+    // One reactor timer for the earliest connect, request or idle deadline
+    SteadyClock::time_point next = nextDeadline();
+    if (next != timerDeadline_) {
+        if (timer_ != 0) {
+            reactor_->cancelTimer(timer_);
+            timer_ = 0;
+        }
+        timerDeadline_ = next;
+        if (next != SteadyClock::time_point::max()) {
+            timer_ = reactor_->runAt(next, [this]() {
+                timer_ = 0;
+                timerDeadline_ = SteadyClock::time_point::max();
+                pass();
+            });
+        }
+    }
+}
+
+#ifdef __linux__
+
+void HttpClient::close() {
+    bool wasRunning;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        wasRunning = running_.exchange(false);
+    }
+    if (wasRunning) {
+        reactor_->runSync([this]() { shutdown(); });
+    }
+    ownReactor_.reset();
+#ifdef SSL_ENABLED
+    if (sslContext_) {
+        SSL_CTX_free(static_cast<SSL_CTX*>(sslContext_));
+    }
+#endif
+    sslContext_ = nullptr;
+}
+
+void HttpClient::onConnectionEvent(Connection& connection, uint32_t events) {
+    if (connection.socket < 0 || !running_) {
+        return;
+    }
+    if (connection.state != Connection::State::READY) {
+        advanceConnect(connection);
+    } else {
+        bool open = true;
+        if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            open = readConnection(connection);
+        }
+        if (open && connection.socket >= 0 && (events & EPOLLOUT)) {
+            writeConnection(connection);
+        }
+    }
+    pass();  // Queued requests may fit now; closed connections are dropped
+}
+
+void HttpClient::shutdown() {
+    // Nothing queued or in flight will be answered
+    if (timer_ != 0) {
+        reactor_->cancelTimer(timer_);
+        timer_ = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        for (auto& request : submitted_) {
+            waiting_.push_back(std::move(request));
+        }
+        submitted_.clear();
+    }
+    // Connections stay allocated: close() may run inside one of their callbacks
+    for (auto& connection : connections_) {
+        for (auto& request : connection->inFlight) {
+            request.retried = true;  // Fail rather than requeue
+        }
+        closeConnection(*connection, "HTTP client closed");
+    }
+    for (auto& request : waiting_) {
+        fail(request, "HTTP client closed");
+    }
+    waiting_.clear();
+}
+
+bool HttpClient::openConnection(SteadyClock::time_point now) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    int status = getaddrinfo(host_.c_str(), port_.c_str(), &hints, &addresses);
+
+    std::string error;
+    int fd = -1;
+    if (status != 0) {
+        error = "Cannot resolve " + host_ + ": " + gai_strerror(status);
+    } else {
+        fd = ::socket(addresses->ai_family, addresses->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                      addresses->ai_protocol);
+        if (fd >= 0 && ::connect(fd, addresses->ai_addr, addresses->ai_addrlen) != 0 && errno != EINPROGRESS) {
+            error = "Cannot connect to " + host_ + ":" + port_ + ": " + std::strerror(errno);
+            ::close(fd);
+            fd = -1;
+        } else if (fd < 0) {
+            error = std::string("Cannot create socket: ") + std::strerror(errno);
+        }
+        freeaddrinfo(addresses);
+    }
+
+    if (fd < 0) {
+        // Nothing can be sent until the origin is reachable again
+        while (!waiting_.empty()) {
+            fail(waiting_.front(), error);
+            waiting_.pop_front();
+        }
+        return false;
+    }
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    auto connection = std::make_unique<Connection>();
+    connection->socket = fd;
+    connection->opened = connection->lastActive = now;
+    connection->writeInterest = true;
+    Connection* added = connection.get();
+    if (!reactor_->add(fd, EPOLLOUT, [this, added](uint32_t events) { onConnectionEvent(*added, events); })) {
+        ::close(fd);
+        while (!waiting_.empty()) {
+            fail(waiting_.front(), "Cannot register connection with reactor " + reactor_->getName());
+            waiting_.pop_front();
+        }
+        return false;
+    }
+
+    connections_.push_back(std::move(connection));
+    openConnections_.fetch_add(1, std::memory_order_relaxed);
+    bump(connectionsOpened_);
+    return true;
+}
+
+bool HttpClient::advanceConnect(Connection& connection) {
+    if (connection.state == Connection::State::CONNECTING) {
+        int error = 0;
+        socklen_t length = sizeof(error);
+        getsockopt(connection.socket, SOL_SOCKET, SO_ERROR, &error, &length);
+        if (error != 0) {
+            std::string reason = "Cannot connect to " + host_ + ":" + port_ + ": " + std::strerror(error);
+            closeConnection(connection, reason);
+            bool usable = std::any_of(connections_.begin(), connections_.end(), [](const std::unique_ptr<Connection>& c) {
+                return c->socket >= 0;
+            });
+            while (!usable && !waiting_.empty()) {
+                fail(waiting_.front(), reason);
+                waiting_.pop_front();
+            }
+            return false;
+        }
+        connection.state = secure_ ? Connection::State::HANDSHAKING : Connection::State::READY;
+
+#ifdef SSL_ENABLED
+        if (secure_) {
+            SSL* ssl = sslContext_ ? SSL_new(static_cast<SSL_CTX*>(sslContext_)) : nullptr;
+            connection.ssl = ssl;
+            if (ssl) {
+                SSL_set_fd(ssl, connection.socket);
+                SSL_set_tlsext_host_name(ssl, host_.c_str());
+                SSL_set1_host(ssl, host_.c_str());
+                SSL_set_mode(ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+            }
+        }
+#endif
+    }
+
+    if (connection.state == Connection::State::HANDSHAKING) {
+#ifdef SSL_ENABLED
+        SSL* ssl = static_cast<SSL*>(connection.ssl);
+        int result = ssl ? SSL_connect(ssl) : -1;
+        if (result != 1) {
+            int error = ssl ? SSL_get_error(ssl, result) : SSL_ERROR_SSL;
+            if (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE) {
+                updateInterest(connection, error == SSL_ERROR_WANT_WRITE);
+                return true;
+            }
+            char reason[256];
+            ERR_error_string_n(ERR_get_error(), reason, sizeof(reason));
+            closeConnection(connection, std::string("TLS handshake failed: ") + reason);
+            return false;
+        }
+        connection.state = Connection::State::READY;
+#else
+        closeConnection(connection, "https:// requires a build with OpenSSL (SSL_ENABLED)");
+        while (!waiting_.empty()) {
+            fail(waiting_.front(), "https:// requires a build with OpenSSL (SSL_ENABLED)");
+            waiting_.pop_front();
+        }
+        return false;
+#endif
+    }
+
+    connection.lastActive = SteadyClock::now();
+    updateInterest(connection, false);
+    return true;
+}
+
+bool HttpClient::readConnection(Connection& connection) {
+    bool atEof = false;
+    for (;;) {
+        size_t used = connection.input.size();
+        connection.input.resize(used + READ_CHUNK);
+        long n;
+        bool wouldBlock;
+#ifdef SSL_ENABLED
+        if (connection.ssl) {
+            SSL* ssl = static_cast<SSL*>(connection.ssl);
+            int result = SSL_read(ssl, &connection.input[used], static_cast<int>(READ_CHUNK));
+            int error = result > 0 ? SSL_ERROR_NONE : SSL_get_error(ssl, result);
+            n = result;
+            wouldBlock = error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE;
+        } else
+#endif
+        {
+            n = ::recv(connection.socket, &connection.input[used], READ_CHUNK, 0);
+            wouldBlock = n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+        }
+        connection.input.resize(used + static_cast<size_t>(std::max<long>(n, 0)));
+        if (n > 0) {
+            continue;
+        }
+        atEof = !wouldBlock;  // Orderly shutdown or error
+        break;
+    }
+
+    if (!parseResponses(connection, atEof)) {
+        return false;
+    }
+    if (atEof) {
+        closeConnection(connection, "Connection closed by server");
+        return false;
+    }
+    return true;
+}
+
+bool HttpClient::writeConnection(Connection& connection) {
+    while (connection.outputOffset < connection.output.size()) {
+        const char* data = connection.output.data() + connection.outputOffset;
+        size_t length = connection.output.size() - connection.outputOffset;
+        long n;
+#ifdef SSL_ENABLED
+        if (connection.ssl) {
+            SSL* ssl = static_cast<SSL*>(connection.ssl);
+            int result = SSL_write(ssl, data, static_cast<int>(std::min<size_t>(length, INT32_MAX)));
+            int error = result > 0 ? SSL_ERROR_NONE : SSL_get_error(ssl, result);
+            n = result > 0 ? result : (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE) ? 0 : -1;
+        } else
+#endif
+        {
+            ssize_t sent = ::send(connection.socket, data, length, MSG_NOSIGNAL);
+            n = sent >= 0 ? sent : (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+        }
+        if (n < 0) {
+            closeConnection(connection, "Write failed");
+            return false;
+        }
+        if (n == 0) {
+            updateInterest(connection, true);
+            return true;
+        }
+        connection.outputOffset += static_cast<size_t>(n);
+    }
+    connection.output.clear();
+    connection.outputOffset = 0;
+    connection.lastActive = SteadyClock::now();
+    updateInterest(connection, false);
+    return true;
+}
+
+void HttpClient::updateInterest(Connection& connection, bool wantWrite) {
+    if (connection.state == Connection::State::READY && wantWrite == connection.writeInterest) {
+        return;
+    }
+    connection.writeInterest = wantWrite;
+    uint32_t events = wantWrite ? EPOLLOUT : EPOLLIN;
+    if (connection.state == Connection::State::READY) {
+        events = wantWrite ? EPOLLIN | EPOLLOUT : EPOLLIN;
+    }
+    reactor_->modify(connection.socket, events);
+}
+
+void HttpClient::closeConnection(Connection& connection, const std::string& reason) {
+    if (connection.socket < 0) {
+        return;
+    }
+    reactor_->remove(connection.socket);
+#ifdef SSL_ENABLED
+    if (connection.ssl) {
+        SSL_free(static_cast<SSL*>(connection.ssl));
+    }
+#endif
+    connection.ssl = nullptr;
+    ::close(connection.socket);
+    connection.socket = -1;
+    openConnections_.fetch_sub(1, std::memory_order_relaxed);
+
+    // Unanswered requests: resend idempotent ones once, in order, ahead of new work
+    while (!connection.inFlight.empty()) {
+        PendingRequest request = std::move(connection.inFlight.back());
+        connection.inFlight.pop_back();
+        if (request.idempotent && !request.retried) {
+            request.retried = true;
+            bump(retries_);
+            waiting_.push_front(std::move(request));
+        } else {
+            fail(request, reason);
+        }
+    }
+}
+
+#else
+
+void HttpClient::close() { running_ = false; }
+void HttpClient::onConnectionEvent(Connection&, uint32_t) { }
+void HttpClient::shutdown() { }
+bool HttpClient::openConnection(SteadyClock::time_point) { return false; }
+bool HttpClient::advanceConnect(Connection&) { return false; }
+bool HttpClient::readConnection(Connection&) { return false; }
+bool HttpClient::writeConnection(Connection&) { return false; }
+void HttpClient::updateInterest(Connection&, bool) { }
+void HttpClient::closeConnection(Connection& connection, const std::string&) { connection.socket = -1; }
+
+#endif
+
+} // namespace MasterMind
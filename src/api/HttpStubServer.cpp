@@ -0,0 +1,331 @@
+#include "api/HttpStubServer.h"
+#include "api/WebSocketProtocol.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace MasterMind {
+
+using SteadyClock = std::chrono::steady_clock;
+
+namespace {
+constexpr int MAX_EVENTS = 16;
+
+const char* reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        case 418: return "I'm a teapot";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "Status";
+    }
+}
+
+std::string serializeResponse(const HttpStubResponse& response) {
+    std::string wire = "HTTP/1.1 " + std::to_string(response.status) + " " + reasonPhrase(response.status) + "\r\n"
+                       "Content-Type: application/json\r\n";
+    if (response.close) {
+        wire += "Connection: close\r\n";
+    }
+    if (!response.chunked) {
+        wire += "Content-Length: " + std::to_string(response.body.size()) + "\r\n\r\n" + response.body;
+        return wire;
+    }
+
+    // Two chunks, so clients have to reassemble
+    wire += "Transfer-Encoding: chunked\r\n\r\n";
+    size_t half = response.body.size() / 2;
+    for (const std::string& chunk : {response.body.substr(0, half), response.body.substr(half)}) {
+        if (!chunk.empty()) {
+            char size[20];
+            std::snprintf(size, sizeof(size), "%zx\r\n", chunk.size());
+            wire += size + chunk + "\r\n";
+        }
+    }
+    return wire + "0\r\n\r\n";
+}
+}
+
+HttpStubServer::HttpStubServer(uint16_t port)
+    : requestedPort_(port), port_(0), listenSocket_(-1), epoll_(-1), wake_(-1), running_(false),
+      requestCount_(0), connectionCount_(0), maxPipelined_(0) {
+}
+
+HttpStubServer::~HttpStubServer() {
+    stop();
+}
+
+void HttpStubServer::setHandler(Handler handler) {
+    handler_ = std::move(handler);
+}
+
+std::string HttpStubServer::getUrl() const {
+    return "http://127.0.0.1:" + std::to_string(port_);
+}
+
+std::vector<HttpStubRequest> HttpStubServer::getRequests() const {
+    std::lock_guard<std::mutex> lock(requestsMutex_);
+    return requests_;
+}
+
+// Private methods
+bool HttpStubServer::parseRequests(Session& session) {
+    for (;;) {
+        size_t headEnd = session.input.find("\r\n\r\n");
+        if (headEnd == std::string::npos) {
+            return true;
+        }
+
+        HttpStubRequest request;
+        request.head = session.input.substr(0, headEnd + 2);
+        size_t methodEnd = request.head.find(' ');
+        size_t targetEnd = methodEnd == std::string::npos ? std::string::npos : request.head.find(' ', methodEnd + 1);
+        if (targetEnd == std::string::npos) {
+            return false;
+        }
+        request.method = request.head.substr(0, methodEnd);
+        request.target = request.head.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+
+        size_t length = std::strtoull(WebSocketProtocol::findHeader(request.head, "Content-Length").c_str(), nullptr, 10);
+        if (session.input.size() < headEnd + 4 + length) {
+            return true;
+        }
+        request.body = session.input.substr(headEnd + 4, length);
+        session.input.erase(0, headEnd + 4 + length);
+
+        HttpStubResponse response = handler_ ? handler_(request) : HttpStubResponse(200, "{}");
+        {
+            std::lock_guard<std::mutex> lock(requestsMutex_);
+            requests_.push_back(std::move(request));
+        }
+        requestCount_.fetch_add(1, std::memory_order_relaxed);
+
+        // Responses leave in request order, so a delay holds back everything behind it
+        Queued queued;
+        queued.wire = serializeResponse(response);
+        queued.due = SteadyClock::now() + response.delay;
+        if (!session.responses.empty()) {
+            queued.due = std::max(queued.due, session.responses.back().due);
+        }
+        queued.close = response.close;
+        session.responses.push_back(std::move(queued));
+        if (session.responses.size() > maxPipelined_.load(std::memory_order_relaxed)) {
+            maxPipelined_.store(session.responses.size(), std::memory_order_relaxed);
+        }
+    }
+}
+
+int HttpStubServer::nextTimeoutMillis(SteadyClock::time_point now) const {
+    SteadyClock::time_point next = SteadyClock::time_point::max();
+    for (const auto& session : sessions_) {
+        if (session.socket >= 0 && !session.responses.empty()) {
+            next = std::min(next, session.responses.front().due);
+        }
+    }
+    if (next == SteadyClock::time_point::max()) {
+        return -1;
+    }
+    if (next <= now) {
+        return 0;
+    }
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        next - now + std::chrono::microseconds(999)).count());
+}
+
+#ifdef __linux__
+
+bool HttpStubServer::start() {
+    if (running_) {
+        return true;
+    }
+
+    listenSocket_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    setsockopt(listenSocket_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(requestedPort_);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressLength = sizeof(address);
+    if (listenSocket_ < 0 ||
+        ::bind(listenSocket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenSocket_, 64) != 0 ||
+        getsockname(listenSocket_, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) {
+        std::cout << "HTTP stub server: cannot listen on port " << requestedPort_ << ": " << std::strerror(errno) << std::endl;
+        stop();
+        return false;
+    }
+    port_ = ntohs(address.sin_port);
+
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenSocket_;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, listenSocket_, &event);
+    event.data.fd = wake_;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, wake_, &event);
+
+    running_ = true;
+    thread_ = std::thread(&HttpStubServer::serverLoop, this);
+    return true;
+}
+
+void HttpStubServer::stop() {
+    if (thread_.joinable()) {
+        running_ = false;
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wake_, &one, sizeof(one));
+        (void)ignored;
+        thread_.join();
+    }
+    running_ = false;
+    for (int* fd : {&listenSocket_, &epoll_, &wake_}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void HttpStubServer::serverLoop() {
+    epoll_event events[MAX_EVENTS];
+    while (running_) {
+        int n = epoll_wait(epoll_, events, MAX_EVENTS, nextTimeoutMillis(SteadyClock::now()));
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wake_) {
+                uint64_t count;
+                ssize_t ignored = ::read(wake_, &count, sizeof(count));
+                (void)ignored;
+            } else if (fd == listenSocket_) {
+                acceptClients();
+            } else if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                auto it = std::find_if(sessions_.begin(), sessions_.end(),
+                                       [fd](const Session& session) { return session.socket == fd; });
+                if (it != sessions_.end() && !readSession(*it)) {
+                    closeSession(*it);
+                }
+            }
+        }
+
+        // Edge-triggered sockets: every session gets a write pass each round
+        SteadyClock::time_point now = SteadyClock::now();
+        for (auto& session : sessions_) {
+            if (session.socket >= 0 && !writeSession(session, now)) {
+                closeSession(session);
+            }
+        }
+        sessions_.erase(std::remove_if(sessions_.begin(), sessions_.end(),
+                                       [](const Session& session) { return session.socket < 0; }),
+                        sessions_.end());
+    }
+
+    for (auto& session : sessions_) {
+        closeSession(session);
+    }
+    sessions_.clear();
+}
+
+void HttpStubServer::acceptClients() {
+    for (;;) {
+        int fd = ::accept4(listenSocket_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+        event.data.fd = fd;
+        epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event);
+
+        Session session;
+        session.socket = fd;
+        sessions_.push_back(std::move(session));
+        connectionCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool HttpStubServer::readSession(Session& session) {
+    char buffer[16 * 1024];
+    for (;;) {
+        ssize_t n = ::recv(session.socket, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            session.input.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            break;
+        }
+        return false;  // Client went away
+    }
+    return parseRequests(session);
+}
+
+bool HttpStubServer::writeSession(Session& session, SteadyClock::time_point now) {
+    while (!session.closeAfterWrite && !session.responses.empty() && session.responses.front().due <= now) {
+        session.output += session.responses.front().wire;
+        session.closeAfterWrite = session.responses.front().close;
+        session.responses.erase(session.responses.begin());
+    }
+
+    while (session.outputOffset < session.output.size()) {
+        ssize_t n = ::send(session.socket, session.output.data() + session.outputOffset,
+                           session.output.size() - session.outputOffset, MSG_NOSIGNAL);
+        if (n < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        session.outputOffset += static_cast<size_t>(n);
+    }
+    session.output.clear();
+    session.outputOffset = 0;
+    return !session.closeAfterWrite;
+}
+
+void HttpStubServer::closeSession(Session& session) {
+    if (session.socket < 0) {
+        return;
+    }
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, session.socket, nullptr);
+    ::close(session.socket);
+    session.socket = -1;
+}
+
+#else
+
+bool HttpStubServer::start() {
+    std::cout << "HTTP stub server requires Linux (epoll)" << std::endl;
+    return false;
+}
+
+void HttpStubServer::stop() { running_ = false; }
+void HttpStubServer::serverLoop() { }
+void HttpStubServer::acceptClients() { }
+bool HttpStubServer::readSession(Session&) { return false; }
+bool HttpStubServer::writeSession(Session&, SteadyClock::time_point) { return false; }
+void HttpStubServer::closeSession(Session& session) { session.socket = -1; }
+
+#endif
+
+} // namespace MasterMind
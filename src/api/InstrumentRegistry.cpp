@@ -0,0 +1,172 @@
+#include "api/InstrumentRegistry.h"
+#include <algorithm>
+#include <iostream>
+
+namespace MasterMind {
+
+using SteadyClock = std::chrono::steady_clock;
+
+constexpr std::chrono::seconds InstrumentRegistry::RETIRE_GRACE;
+
+// InstrumentSnapshot implementation
+InstrumentSnapshot::InstrumentSnapshot(std::vector<InstrumentSpec> specs, std::vector<SymbolId> specIds,
+                                       std::unordered_map<Symbol, SymbolId> ids, size_t idCount, uint64_t version)
+    : specs_(std::move(specs)), byId_(idCount, nullptr), ids_(std::move(ids)), version_(version),
+      loadTime_(std::chrono::system_clock::now()) {
+    // specs_ is final here, so pointers into it stay put
+    for (size_t i = 0; i < specs_.size(); ++i) {
+        byId_[specIds[i]] = &specs_[i];
+    }
+}
+
+SymbolId InstrumentSnapshot::getId(const Symbol& symbol) const {
+    auto it = ids_.find(symbol);
+    return it != ids_.end() ? it->second : INVALID_SYMBOL_ID;
+}
+
+// InstrumentRegistry implementation
+InstrumentRegistry::InstrumentRegistry()
+    : version_(0), refreshes_(0), failures_(0), lastLoadMillis_(0), refreshTimers_(nullptr),
+      refreshTimer_(TimerWheel::INVALID_TIMER) {
+    owner_ = std::make_shared<InstrumentSnapshot>(std::vector<InstrumentSpec>(), std::vector<SymbolId>(),
+                                                  std::unordered_map<Symbol, SymbolId>(), 0, 0);
+    current_.store(owner_.get(), std::memory_order_release);
+}
+
+InstrumentRegistry::~InstrumentRegistry() {
+    stopRefresh();
+}
+
+std::shared_ptr<const InstrumentSnapshot> InstrumentRegistry::acquire() const {
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    return owner_;
+}
+
+uint64_t InstrumentRegistry::publish(const std::vector<InstrumentSpec>& specs) {
+    std::lock_guard<std::mutex> lock(publishMutex_);
+
+    // Later duplicates of a symbol replace earlier ones
+    std::vector<InstrumentSpec> unique;
+    std::vector<SymbolId> specIds;
+    std::unordered_map<SymbolId, size_t> positions;
+    unique.reserve(specs.size());
+    specIds.reserve(specs.size());
+    for (const auto& spec : specs) {
+        if (spec.symbol.empty()) {
+            continue;
+        }
+        auto assigned = ids_.emplace(spec.symbol, static_cast<SymbolId>(ids_.size()));
+        SymbolId id = assigned.first->second;
+        auto position = positions.find(id);
+        if (position != positions.end()) {
+            unique[position->second] = spec;
+            continue;
+        }
+        positions.emplace(id, unique.size());
+        unique.push_back(spec);
+        specIds.push_back(id);
+    }
+
+    auto snapshot = std::make_shared<InstrumentSnapshot>(std::move(unique), std::move(specIds), ids_,
+                                                         ids_.size(), ++version_);
+    current_.store(snapshot.get(), std::memory_order_release);
+
+    // Readers may still hold the old raw pointer; free it only after the grace period
+    auto now = SteadyClock::now();
+    retired_.emplace_back(std::move(owner_), now);
+    owner_ = std::move(snapshot);
+    retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                  [now](const std::pair<std::shared_ptr<const InstrumentSnapshot>, SteadyClock::time_point>& entry) {
+                                      return now - entry.second >= RETIRE_GRACE;
+                                  }),
+                   retired_.end());
+    return version_;
+}
+
+void InstrumentRegistry::setLoader(Loader loader) {
+    std::lock_guard<std::mutex> lock(loaderMutex_);
+    loader_ = std::move(loader);
+}
+
+bool InstrumentRegistry::refresh() {
+    // One load at a time; a refresh requested mid-load waits for it
+    std::lock_guard<std::mutex> lock(loaderMutex_);
+    if (!loader_) {
+        return false;
+    }
+
+    auto start = SteadyClock::now();
+    std::vector<InstrumentSpec> specs;
+    bool loaded = false;
+    try {
+        loaded = loader_(specs);
+    } catch (const std::exception& e) {
+        std::cout << "Instrument refresh failed: " << e.what() << std::endl;
+    }
+    if (!loaded) {
+        ++failures_;
+        return false;
+    }
+
+    publish(specs);
+    ++refreshes_;
+    lastRefresh_ = std::chrono::system_clock::now();
+    lastLoadMillis_ = std::chrono::duration<double, std::milli>(SteadyClock::now() - start).count();
+    return true;
+}
+
+bool InstrumentRegistry::startRefresh(Duration interval, TimerWheel& timers) {
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        if (refreshTimers_) {
+            return true;
+        }
+    }
+    bool loaded = refresh();
+
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+    if (!refreshTimers_) {
+        refreshTimers_ = &timers;
+        refreshTimer_ = timers.scheduleRepeating(std::max(interval, Duration(std::chrono::seconds(1))),
+                                                 [this]() { refresh(); });
+    }
+    return loaded;
+}
+
+void InstrumentRegistry::stopRefresh() {
+    TimerWheel* timers;
+    TimerId timer;
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        timers = refreshTimers_;
+        timer = refreshTimer_;
+        refreshTimers_ = nullptr;
+        refreshTimer_ = TimerWheel::INVALID_TIMER;
+    }
+    if (timers) {
+        timers->cancelSync(timer);  // A refresh in progress finishes first
+    }
+}
+
+bool InstrumentRegistry::isRefreshing() const {
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+    return refreshTimers_ != nullptr;
+}
+
+InstrumentRegistryStats InstrumentRegistry::getStats() const {
+    InstrumentRegistryStats stats;
+    {
+        std::lock_guard<std::mutex> lock(publishMutex_);
+        stats.version = version_;
+        stats.instruments = owner_->size();
+        stats.symbolIds = ids_.size();
+    }
+    std::lock_guard<std::mutex> lock(loaderMutex_);
+    stats.refreshes = refreshes_;
+    stats.failures = failures_;
+    stats.lastRefresh = lastRefresh_;
+    stats.lastLoadMillis = lastLoadMillis_;
+    return stats;
+}
+
+} // namespace MasterMind
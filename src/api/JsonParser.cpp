@@ -0,0 +1,619 @@
+#include "api/JsonParser.h"
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace MasterMind {
+
+namespace {
+constexpr uint64_t MANTISSA_LIMIT = 1000000000000000000ULL;  // Room for one more digit in uint64_t
+constexpr uint64_t MAX_EXACT_MANTISSA = 1ULL << 53;   // Exactly representable in a double
+constexpr int MAX_EXACT_POWER = 22;                   // Largest exact power of ten
+
+const double POWERS_OF_TEN[MAX_EXACT_POWER + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool isDigit(char c) {
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool SWAR_DIGITS = false;
+#else
+constexpr bool SWAR_DIGITS = true;
+#endif
+
+// Eight ASCII digits at once (little-endian load), the common width of an
+// exchange price or quantity fraction
+inline bool loadEightDigits(const char* p, uint64_t& word) {
+    std::memcpy(&word, p, sizeof(word));
+    return (((word & 0xF0F0F0F0F0F0F0F0ULL) |
+             (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+}
+
+inline uint64_t parseEightDigits(uint64_t word) {
+    word -= 0x3030303030303030ULL;
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+            (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return word;
+}
+
+inline bool isNumberChar(char c) {
+    return isDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+int hexValue(char c) {
+    if (isDigit(c)) return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool parseHex4(const char* text, uint32_t& value) {
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        int digit = hexValue(text[i]);
+        if (digit < 0) {
+            return false;
+        }
+        value = (value << 4) | static_cast<uint32_t>(digit);
+    }
+    return true;
+}
+
+void appendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+bool unescape(std::string_view raw, std::string& out) {
+    out.clear();
+    for (size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (c != '\\') {
+            out.push_back(c);
+            continue;
+        }
+        if (++i >= raw.size()) {
+            return false;
+        }
+        switch (raw[i]) {
+            case '"':  out.push_back('"'); break;
+            case '\\': out.push_back('\\'); break;
+            case '/':  out.push_back('/'); break;
+            case 'b':  out.push_back('\b'); break;
+            case 'f':  out.push_back('\f'); break;
+            case 'n':  out.push_back('\n'); break;
+            case 'r':  out.push_back('\r'); break;
+            case 't':  out.push_back('\t'); break;
+            case 'u': {
+                uint32_t codePoint;
+                if (i + 4 >= raw.size() || !parseHex4(raw.data() + i + 1, codePoint)) {
+                    return false;
+                }
+                i += 4;
+                // A high surrogate must be followed by an escaped low surrogate
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    uint32_t low;
+                    if (i + 6 >= raw.size() || raw[i + 1] != '\\' || raw[i + 2] != 'u' ||
+                        !parseHex4(raw.data() + i + 3, low) || low < 0xDC00 || low > 0xDFFF) {
+                        return false;
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                appendUtf8(out, codePoint);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+// Decodes the number starting at p; returns the end of it, or nullptr
+const char* decodeDouble(const char* p, const char* end, double& value) {
+    const char* start = p;
+    bool negative = p < end && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    if (p == end || !isDigit(*p)) {
+        return nullptr;
+    }
+
+    // Digits accumulate exactly until the mantissa would overflow; later
+    // ones only move the exponent, and a dropped non-zero digit forces the
+    // slow path
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    bool exact = true;
+    for (; p < end && isDigit(*p); ++p) {
+        if (mantissa < MANTISSA_LIMIT) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        } else {
+            ++exponent;
+            exact &= *p == '0';
+        }
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        if (p == end || !isDigit(*p)) {
+            return nullptr;
+        }
+        uint64_t word;
+        if (SWAR_DIGITS) {
+            while (end - p >= 8 && mantissa < MANTISSA_LIMIT / 100000000 && loadEightDigits(p, word)) {
+                mantissa = mantissa * 100000000 + parseEightDigits(word);
+                exponent -= 8;
+                p += 8;
+            }
+        }
+        for (; p < end && isDigit(*p); ++p) {
+            if (mantissa < MANTISSA_LIMIT) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                --exponent;
+            } else {
+                exact &= *p == '0';
+            }
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+')) {
+            ++p;
+        }
+        if (p == end || !isDigit(*p)) {
+            return nullptr;
+        }
+        int written = 0;
+        for (; p < end && isDigit(*p); ++p) {
+            if (written < 10000) {
+                written = written * 10 + (*p - '0');
+            }
+        }
+        exponent += negativeExponent ? -written : written;
+    }
+
+    // Clinger's fast path: both operands exact, so one rounding
+    if (exact && mantissa <= MAX_EXACT_MANTISSA && exponent >= -MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER) {
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+        value = negative ? -result : result;
+        return p;
+    }
+
+    size_t length = static_cast<size_t>(p - start);
+    char buffer[64];
+    std::string copy;
+    const char* terminated;
+    if (length < sizeof(buffer)) {
+        std::memcpy(buffer, start, length);
+        buffer[length] = '\0';
+        terminated = buffer;
+    } else {
+        copy.assign(start, length);
+        terminated = copy.c_str();
+    }
+    value = std::strtod(terminated, nullptr);
+    return p;
+}
+
+// Integer part and fraction as exact digits; no exponent
+bool parseFixed(std::string_view text, int scale, int64_t& value) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    bool negative = p < end && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    if (p == end || !isDigit(*p)) {
+        return false;
+    }
+
+    const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    uint64_t result = 0;
+    auto append = [&](int digit) {
+        if (result > (limit - digit) / 10) {
+            return false;
+        }
+        result = result * 10 + digit;
+        return true;
+    };
+
+    while (p < end && isDigit(*p)) {
+        if (!append(*p++ - '0')) {
+            return false;
+        }
+    }
+    int fractionDigits = 0;
+    if (p < end && *p == '.') {
+        ++p;
+        if (p == end || !isDigit(*p)) {
+            return false;
+        }
+        while (p < end && isDigit(*p)) {
+            if (fractionDigits < scale) {
+                if (!append(*p - '0')) {
+                    return false;
+                }
+                ++fractionDigits;
+            }
+            ++p;  // Digits beyond the scale are truncated
+        }
+    }
+    if (p != end) {
+        return false;
+    }
+    for (; fractionDigits < scale; ++fractionDigits) {
+        if (!append(0)) {
+            return false;
+        }
+    }
+
+    value = negative ? -static_cast<int64_t>(result) : static_cast<int64_t>(result);
+    return true;
+}
+
+// Decodes the digits starting at p; returns the end of them, or nullptr
+const char* decodeUnsigned(const char* p, const char* end, uint64_t& value) {
+    if (p == end || !isDigit(*p)) {
+        return nullptr;
+    }
+    value = 0;
+    for (; p < end && isDigit(*p); ++p) {
+        uint64_t digit = static_cast<uint64_t>(*p - '0');
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+            return nullptr;
+        }
+        value = value * 10 + digit;
+    }
+    return p;
+}
+}
+
+JsonReader::JsonReader(const char* data, size_t length)
+    : begin_(data), position_(data), end_(data + length), failed_(data == nullptr) {
+}
+
+JsonReader::JsonReader(std::string_view text)
+    : JsonReader(text.data(), text.size()) {
+}
+
+JsonType JsonReader::peek() {
+    skipWhitespace();
+    if (failed_ || position_ >= end_) {
+        return JsonType::NONE;
+    }
+    switch (*position_) {
+        case '{': return JsonType::OBJECT;
+        case '[': return JsonType::ARRAY;
+        case '"': return JsonType::STRING;
+        case 't':
+        case 'f': return JsonType::BOOLEAN;
+        case 'n': return JsonType::NULL_VALUE;
+        default:
+            return (*position_ == '-' || isDigit(*position_)) ? JsonType::NUMBER : JsonType::NONE;
+    }
+}
+
+bool JsonReader::enterObject() {
+    return !failed_ && expect('{');
+}
+
+bool JsonReader::nextKey(std::string_view& key) {
+    if (failed_) {
+        return false;
+    }
+    skipWhitespace();
+    if (position_ < end_ && *position_ == '}') {
+        ++position_;
+        return false;
+    }
+    if (position_ < end_ && *position_ == ',') {
+        ++position_;
+        skipWhitespace();
+    }
+    if (position_ >= end_ || *position_ != '"') {
+        return fail();
+    }
+    return scanString(key) && expect(':');
+}
+
+bool JsonReader::enterArray() {
+    return !failed_ && expect('[');
+}
+
+bool JsonReader::nextElement() {
+    if (failed_) {
+        return false;
+    }
+    skipWhitespace();
+    if (position_ >= end_) {
+        return fail();
+    }
+    if (*position_ == ']') {
+        ++position_;
+        return false;
+    }
+    if (*position_ == ',') {
+        ++position_;
+    }
+    return true;
+}
+
+bool JsonReader::readString(std::string_view& value) {
+    if (failed_) {
+        return false;
+    }
+    skipWhitespace();
+    if (position_ >= end_ || *position_ != '"') {
+        return fail();
+    }
+    return scanString(value);
+}
+
+bool JsonReader::readString(std::string& value) {
+    std::string_view raw;
+    if (!readString(raw)) {
+        return false;
+    }
+    if (raw.find('\\') == std::string_view::npos) {
+        value.assign(raw.data(), raw.size());  // Reuses the caller's capacity
+        return true;
+    }
+    return unescape(raw, value) || fail();
+}
+
+bool JsonReader::readDouble(double& value) {
+    if (failed_) {
+        return false;
+    }
+    // Decoded in place: quoted prices are not scanned twice
+    skipWhitespace();
+    bool quoted = position_ < end_ && *position_ == '"';
+    const char* next = decodeDouble(position_ + quoted, end_, value);
+    if (!next || (quoted && (next == end_ || *next != '"'))) {
+        return fail();
+    }
+    position_ = next + quoted;
+    return true;
+}
+
+bool JsonReader::readInteger(int64_t& value) {
+    uint64_t magnitude;
+    bool negative;
+    if (!readMagnitude(magnitude, negative)) {
+        return false;
+    }
+    const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    if (magnitude > limit + (negative ? 1 : 0)) {
+        return fail();
+    }
+    value = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+bool JsonReader::readUnsigned(uint64_t& value) {
+    bool negative;
+    return readMagnitude(value, negative) && (!negative || fail());
+}
+
+bool JsonReader::readFixed(int64_t& value, int scale) {
+    std::string_view text;
+    return (scanNumberOrString(text) && scale >= 0 && parseFixed(text, scale, value)) || fail();
+}
+
+bool JsonReader::readPair(double& first, double& second) {
+    // One call per depth level instead of a walk through four
+    if (!enterArray() || !readDouble(first)) {
+        return false;
+    }
+    skipWhitespace();
+    if (position_ >= end_ || *position_ != ',') {
+        return fail();
+    }
+    ++position_;
+    if (!readDouble(second)) {
+        return false;
+    }
+    skipWhitespace();
+    if (position_ < end_ && *position_ == ']') {
+        ++position_;
+        return true;
+    }
+    while (nextElement()) {
+        skipValue();  // Trailing per-level fields
+    }
+    return ok();
+}
+
+bool JsonReader::readBool(bool& value) {
+    if (failed_) {
+        return false;
+    }
+    skipWhitespace();
+    if (skipLiteral("true", 4)) {
+        value = true;
+        return true;
+    }
+    if (skipLiteral("false", 5)) {
+        value = false;
+        return true;
+    }
+    return fail();
+}
+
+bool JsonReader::readNull() {
+    if (failed_) {
+        return false;
+    }
+    skipWhitespace();
+    return skipLiteral("null", 4) || fail();
+}
+
+bool JsonReader::skipValue() {
+    std::string_view ignored;
+    switch (peek()) {
+        case JsonType::STRING:
+            return scanString(ignored);
+        case JsonType::NUMBER:
+            return scanNumber(ignored);
+        case JsonType::BOOLEAN: {
+            bool flag;
+            return readBool(flag);
+        }
+        case JsonType::NULL_VALUE:
+            return readNull();
+        case JsonType::OBJECT:
+        case JsonType::ARRAY:
+            break;
+        default:
+            return fail();
+    }
+
+    // Containers are skipped by bracket depth alone; strings are stepped
+    // over so brackets inside them do not count
+    int depth = 0;
+    while (position_ < end_) {
+        char c = *position_;
+        if (c == '"') {
+            if (!scanString(ignored)) {
+                return false;
+            }
+            continue;
+        }
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (--depth == 0) {
+                ++position_;
+                return true;
+            }
+        }
+        ++position_;
+    }
+    return fail();
+}
+
+bool JsonReader::atEnd() {
+    skipWhitespace();
+    return position_ >= end_;
+}
+
+bool JsonReader::parseDouble(std::string_view text, double& value) {
+    const char* end = text.data() + text.size();
+    return decodeDouble(text.data(), end, value) == end;
+}
+
+// Private methods
+void JsonReader::skipWhitespace() {
+    while (position_ < end_ && (*position_ == ' ' || *position_ == '\n' || *position_ == '\r' || *position_ == '\t')) {
+        ++position_;
+    }
+}
+
+bool JsonReader::fail() {
+    failed_ = true;
+    return false;
+}
+
+bool JsonReader::expect(char c) {
+    skipWhitespace();
+    if (position_ < end_ && *position_ == c) {
+        ++position_;
+        return true;
+    }
+    return fail();
+}
+
+// position_ is on the opening quote
+bool JsonReader::scanString(std::string_view& value) {
+    const char* start = ++position_;
+    while (position_ < end_) {
+        char c = *position_;
+        if (c == '"') {
+            value = std::string_view(start, static_cast<size_t>(position_ - start));
+            ++position_;
+            return true;
+        }
+        if (c == '\\') {
+            if (end_ - position_ < 2) {
+                break;
+            }
+            position_ += 2;
+            continue;
+        }
+        ++position_;
+    }
+    return fail();
+}
+
+// position_ is on the first character
+bool JsonReader::scanNumber(std::string_view& value) {
+    const char* start = position_;
+    while (position_ < end_ && isNumberChar(*position_)) {
+        ++position_;
+    }
+    if (position_ == start) {
+        return fail();
+    }
+    value = std::string_view(start, static_cast<size_t>(position_ - start));
+    return true;
+}
+
+// Integer, bare or quoted, decoded in place
+bool JsonReader::readMagnitude(uint64_t& magnitude, bool& negative) {
+    if (failed_) {
+        return false;
+    }
+    skipWhitespace();
+    bool quoted = position_ < end_ && *position_ == '"';
+    const char* p = position_ + quoted;
+    negative = p < end_ && *p == '-';
+    const char* next = decodeUnsigned(p + negative, end_, magnitude);
+    if (!next || (quoted && (next == end_ || *next != '"'))) {
+        return fail();
+    }
+    position_ = next + quoted;
+    return true;
+}
+
+bool JsonReader::scanNumberOrString(std::string_view& value) {
+    JsonType type = peek();
+    if (type == JsonType::STRING) {
+        return scanString(value);
+    }
+    if (type == JsonType::NUMBER) {
+        return scanNumber(value);
+    }
+    return fail();
+}
+
+bool JsonReader::skipLiteral(const char* literal, size_t length) {
+    if (static_cast<size_t>(end_ - position_) >= length && std::memcmp(position_, literal, length) == 0) {
+        position_ += length;
+        return true;
+    }
+    return false;
+}
+
+} // namespace MasterMind
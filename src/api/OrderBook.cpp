@@ -0,0 +1,220 @@
+#include "api/OrderBook.h"
+#include <algorithm>
+
+namespace MasterMind {
+
+OrderBook::OrderBook(const Symbol& symbol, size_t reserveLevels)
+    : symbol_(symbol), lastUpdateId_(0), updateCount_(0) {
+    bids_.reserve(reserveLevels);
+    asks_.reserve(reserveLevels);
+}
+
+void OrderBook::applySnapshot(const std::vector<PriceLevel>& bids,
+                              const std::vector<PriceLevel>& asks,
+                              uint64_t updateId) {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+
+    // assign() reuses the reserved capacity
+    bids_.assign(bids.begin(), bids.end());
+    asks_.assign(asks.begin(), asks.end());
+    bids_.erase(std::remove_if(bids_.begin(), bids_.end(),
+                               [](const PriceLevel& l) { return l.quantity <= 0; }), bids_.end());
+    asks_.erase(std::remove_if(asks_.begin(), asks_.end(),
+                               [](const PriceLevel& l) { return l.quantity <= 0; }), asks_.end());
+    std::sort(bids_.begin(), bids_.end(),
+              [](const PriceLevel& a, const PriceLevel& b) { return a.price < b.price; });
+    std::sort(asks_.begin(), asks_.end(),
+              [](const PriceLevel& a, const PriceLevel& b) { return a.price > b.price; });
+
+    lastUpdateId_ = updateId;
+    updateCount_++;
+    lastUpdateTime_ = std::chrono::system_clock::now();
+}
+
+void OrderBook::applyDiff(const std::vector<PriceLevel>& bids,
+                          const std::vector<PriceLevel>& asks,
+                          uint64_t updateId) {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+
+    for (const auto& level : bids) {
+        setLevel(bids_, true, level.price, level.quantity);
+    }
+    for (const auto& level : asks) {
+        setLevel(asks_, false, level.price, level.quantity);
+    }
+
+    lastUpdateId_ = updateId;
+    updateCount_++;
+    lastUpdateTime_ = std::chrono::system_clock::now();
+}
+
+void OrderBook::applyUpdate(OrderSide side, Price price, Volume quantity) {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+
+    setLevel(sideLevels(side), side == OrderSide::BUY, price, quantity);
+    updateCount_++;
+    lastUpdateTime_ = std::chrono::system_clock::now();
+}
+
+void OrderBook::clear() {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+    bids_.clear();
+    asks_.clear();
+    lastUpdateId_ = 0;
+}
+
+TopOfBook OrderBook::getTopOfBook() const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+
+    TopOfBook top;
+    if (!bids_.empty()) {
+        top.bid = bids_.back().price;
+        top.bidQuantity = bids_.back().quantity;
+    }
+    if (!asks_.empty()) {
+        top.ask = asks_.back().price;
+        top.askQuantity = asks_.back().quantity;
+    }
+    top.updateId = lastUpdateId_;
+    return top;
+}
+
+Price OrderBook::getBestBid() const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+    return bids_.empty() ? 0 : bids_.back().price;
+}
+
+Price OrderBook::getBestAsk() const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+    return asks_.empty() ? 0 : asks_.back().price;
+}
+
+Price OrderBook::getMidPrice() const {
+    TopOfBook top = getTopOfBook();
+    if (top.bid <= 0 || top.ask <= 0) {
+        return top.bid > 0 ? top.bid : top.ask;
+    }
+    return (top.bid + top.ask) / 2.0;
+}
+
+Price OrderBook::getSpread() const {
+    TopOfBook top = getTopOfBook();
+    return (top.bid > 0 && top.ask > 0) ? top.ask - top.bid : 0;
+}
+
+std::vector<PriceLevel> OrderBook::getDepth(OrderSide side, size_t levels) const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+
+    const auto& book = sideLevels(side);
+    size_t count = std::min(levels, book.size());
+    return std::vector<PriceLevel>(book.rbegin(), book.rbegin() + count);
+}
+
+Volume OrderBook::getCumulativeVolume(OrderSide side, size_t levels) const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+
+    const auto& book = sideLevels(side);
+    size_t count = std::min(levels, book.size());
+    Volume total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += book[book.size() - 1 - i].quantity;
+    }
+    return total;
+}
+
+Volume OrderBook::getVolumeWithin(OrderSide side, Price limitPrice) const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+
+    const auto& book = sideLevels(side);
+    Volume total = 0;
+    for (auto it = book.rbegin(); it != book.rend(); ++it) {
+        bool inside = side == OrderSide::BUY ? it->price >= limitPrice : it->price <= limitPrice;
+        if (!inside) {
+            break;
+        }
+        total += it->quantity;
+    }
+    return total;
+}
+
+Price OrderBook::estimateAverageFillPrice(OrderSide side, Volume quantity,
+                                          Volume* filledQuantity) const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+
+    // An aggressive buy consumes the asks and vice versa
+    const auto& book = side == OrderSide::BUY ? asks_ : bids_;
+    Volume remaining = quantity;
+    double notional = 0;
+
+    for (auto it = book.rbegin(); it != book.rend() && remaining > 0; ++it) {
+        Volume take = std::min(remaining, it->quantity);
+        notional += take * it->price;
+        remaining -= take;
+    }
+
+    Volume filled = quantity - remaining;
+    if (filledQuantity) {
+        *filledQuantity = filled;
+    }
+    return filled > 0 ? notional / filled : 0;
+}
+
+size_t OrderBook::getLevelCount(OrderSide side) const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+    return sideLevels(side).size();
+}
+
+bool OrderBook::isEmpty() const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+    return bids_.empty() && asks_.empty();
+}
+
+uint64_t OrderBook::getLastUpdateId() const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+    return lastUpdateId_;
+}
+
+uint64_t OrderBook::getUpdateCount() const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+    return updateCount_;
+}
+
+TimePoint OrderBook::getLastUpdateTime() const {
+    std::lock_guard<std::mutex> lock(bookMutex_);
+    return lastUpdateTime_;
+}
+
+// Private methods
+void OrderBook::setLevel(std::vector<PriceLevel>& levels, bool ascending, Price price, Volume quantity) {
+    // Most updates hit the few levels at the touch - probe from the back first
+    size_t probe = std::min<size_t>(levels.size(), 8);
+    for (size_t i = 0; i < probe; ++i) {
+        PriceLevel& level = levels[levels.size() - 1 - i];
+        if (level.price == price) {
+            if (quantity > 0) {
+                level.quantity = quantity;
+            } else {
+                levels.erase(levels.end() - 1 - i);
+            }
+            return;
+        }
+    }
+
+    auto it = ascending
+        ? std::lower_bound(levels.begin(), levels.end(), price,
+                           [](const PriceLevel& l, Price p) { return l.price < p; })
+        : std::lower_bound(levels.begin(), levels.end(), price,
+                           [](const PriceLevel& l, Price p) { return l.price > p; });
+
+    if (it != levels.end() && it->price == price) {
+        if (quantity > 0) {
+            it->quantity = quantity;
+        } else {
+            levels.erase(it);
+        }
+    } else if (quantity > 0) {
+        levels.insert(it, PriceLevel(price, quantity));
+    }
+}
+
+} // namespace MasterMind
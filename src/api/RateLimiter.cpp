@@ -0,0 +1,406 @@
+#include "api/RateLimiter.h"
+#include <algorithm>
+
+namespace MasterMind {
+
+using SystemClock = std::chrono::system_clock;
+using SteadyClock = std::chrono::steady_clock;
+
+namespace {
+size_t laneIndex(RequestPriority priority) {
+    return std::min(static_cast<size_t>(priority), static_cast<size_t>(RequestPriority::COUNT) - 1);
+}
+}
+
+RateLimiter::RateLimiter(const RateLimitConfig& config, EventReactor* reactor)
+    : stopped_(false), reactor_(reactor ? reactor : &ReactorPool::shared().next()), timer_(0),
+      timerArmed_(false), timerGeneration_(0) {
+    setConfig(config);
+}
+
+RateLimiter::~RateLimiter() {
+    stop();
+}
+
+void RateLimiter::setConfig(const RateLimitConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    const std::pair<double, Duration> limits[] = {{config.weightLimit, config.weightWindow},
+                                                  {config.orderLimit, config.orderWindow}};
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        Rule& rule = rules_[i];
+        int64_t windowMillis = std::max<int64_t>(limits[i].second.count(), 1);
+        if (windowMillis != rule.windowMillis) {
+            rule.windowMillis = windowMillis;
+            rule.windowIndex = -1;  // Usage of the old window does not carry over
+            rule.used = 0;
+            rule.carry = 0;
+        }
+        rule.limit = limits[i].first;
+    }
+    if (queuedLocked() > 0) {
+        armTimer(SteadyClock::now());  // Waiters may fit the new limits
+    }
+}
+
+RateLimitConfig RateLimiter::getConfig() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+bool RateLimiter::tryAcquire(RequestPriority priority, uint32_t weight, uint32_t orders) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_ || !lanes_[laneIndex(priority)].empty()) {
+        return false;
+    }
+    return admit(priority, weight, orders, SystemClock::now());
+}
+
+void RateLimiter::submit(RequestPriority priority, uint32_t weight, uint32_t orders, Callback callback) {
+    size_t lane = laneIndex(priority);
+    bool admitted = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopped_ && lanes_[lane].empty()) {
+            admitted = admit(priority, weight, orders, SystemClock::now());
+        }
+        if (!admitted) {
+            if (stopped_ || lanes_[lane].size() >= config_.maxQueued) {
+                ++stats_.refused;
+            } else {
+                SteadyClock::time_point steadyNow = SteadyClock::now();
+                lanes_[lane].push_back(Waiter{weight, orders, steadyNow, std::move(callback)});
+                ++stats_.delayed[lane];
+                stats_.maxQueued = std::max(stats_.maxQueued, queuedLocked());
+                armTimer(nextWake(SystemClock::now(), steadyNow));
+                return;
+            }
+        }
+    }
+    if (callback) {
+        callback(admitted);
+    }
+}
+
+bool RateLimiter::acquire(RequestPriority priority, uint32_t weight, uint32_t orders) {
+    std::promise<bool> admitted;
+    std::future<bool> result = admitted.get_future();
+    submit(priority, weight, orders, [&admitted](bool ok) { admitted.set_value(ok); });
+    return result.get();
+}
+
+void RateLimiter::sync(RateLimitRule rule, double usedInWindow) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rollWindows(toMillis(SystemClock::now()));
+    Rule& target = rules_[static_cast<size_t>(rule)];
+    if (usedInWindow > target.used) {
+        target.used = usedInWindow;
+        ++stats_.resynced;
+    }
+}
+
+void RateLimiter::pause(Duration duration) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pausedUntil_ = std::max(pausedUntil_, SystemClock::now() + duration);
+    ++stats_.throttled;
+}
+
+void RateLimiter::recordCoalesced() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.coalesced;
+}
+
+void RateLimiter::stop() {
+    std::vector<Admission> refused;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        for (auto& lane : lanes_) {
+            for (auto& waiter : lane) {
+                refused.emplace_back(std::move(waiter.callback), false);
+            }
+            stats_.refused += lane.size();
+            lane.clear();
+        }
+        if (timerArmed_) {
+            reactor_->cancelTimer(timer_);
+            timerArmed_ = false;
+        }
+    }
+    // A timer that already fired may still be running; let it finish before the limiter goes
+    reactor_->runSync([]() {});
+    for (auto& admission : refused) {
+        if (admission.first) {
+            admission.first(false);
+        }
+    }
+}
+
+RateLimiterStats RateLimiter::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RateLimiterStats stats = stats_;
+    stats.queued = queuedLocked();
+
+    // Windows roll lazily; a stale window has nothing used yet
+    int64_t nowMillis = toMillis(SystemClock::now());
+    double used[2];
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        const Rule& rule = rules_[i];
+        int64_t index = windowIndexAt(rule, nowMillis);
+        used[i] = index == rule.windowIndex ? rule.used : index == rule.windowIndex + 1 ? rule.carry : 0;
+    }
+    stats.weightUsed = used[static_cast<size_t>(RateLimitRule::REQUEST_WEIGHT)];
+    stats.ordersUsed = used[static_cast<size_t>(RateLimitRule::ORDERS)];
+    return stats;
+}
+
+// Private methods
+void RateLimiter::onTimer(uint64_t generation) {
+    // Reactor thread
+    std::vector<Admission> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (generation == timerGeneration_) {
+            timerArmed_ = false;
+        }
+        if (stopped_) {
+            return;
+        }
+        SteadyClock::time_point steadyNow = SteadyClock::now();
+        SystemClock::time_point now = SystemClock::now();
+        expireLanes(steadyNow, ready);
+        drainLanes(now, ready);
+        if (queuedLocked() > 0) {
+            armTimer(nextWake(now, steadyNow));
+        }
+    }
+
+    // Admitted requests are sent from their callbacks, outside the lock
+    for (auto& admission : ready) {
+        if (admission.first) {
+            admission.first(admission.second);
+        }
+    }
+}
+
+void RateLimiter::armTimer(SteadyClock::time_point when) {
+    if (timerArmed_ && timerDue_ <= when) {
+        return;
+    }
+    if (timerArmed_) {
+        reactor_->cancelTimer(timer_);
+    }
+    uint64_t generation = ++timerGeneration_;
+    timer_ = reactor_->runAt(when, [this, generation]() { onTimer(generation); });
+    timerDue_ = when;
+    timerArmed_ = true;
+}
+
+SteadyClock::time_point RateLimiter::nextWake(SystemClock::time_point now, SteadyClock::time_point steadyNow) const {
+    // Caller holds mutex_. A window opens, the pause ends or a waiter expires
+    SteadyClock::time_point wake = steadyNow + std::chrono::duration_cast<SteadyClock::duration>(nextOpening(now) - now);
+    for (const auto& lane : lanes_) {
+        if (!lane.empty()) {
+            wake = std::min(wake, lane.front().enqueued + config_.maxQueueDelay);
+        }
+    }
+    return wake;
+}
+
+bool RateLimiter::admit(RequestPriority priority, uint32_t weight, uint32_t orders, SystemClock::time_point now) {
+    // Caller holds mutex_
+    if (now < pausedUntil_) {
+        return false;
+    }
+    rollWindows(toMillis(now));
+    Hold hold;
+    size_t lane = laneIndex(priority);
+    for (size_t higher = 0; higher < lane; ++higher) {
+        if (!lanes_[higher].empty()) {
+            holdFor(lanes_[higher].front().weight, lanes_[higher].front().orders, hold);
+        }
+    }
+    if (!fits(weight, orders, hold)) {
+        return false;
+    }
+    charge(lane, weight, orders, toMillis(now));
+    return true;
+}
+
+void RateLimiter::drainLanes(SystemClock::time_point now, std::vector<Admission>& ready) {
+    // Caller holds mutex_
+    if (now < pausedUntil_) {
+        return;
+    }
+    int64_t nowMillis = toMillis(now);
+    rollWindows(nowMillis);
+    SteadyClock::time_point steadyNow = SteadyClock::now();
+
+    Hold hold;
+    for (size_t lane = 0; lane < lanes_.size(); ++lane) {
+        auto& waiters = lanes_[lane];
+        while (!waiters.empty()) {
+            Waiter& waiter = waiters.front();
+            if (!fits(waiter.weight, waiter.orders, hold)) {
+                holdFor(waiter.weight, waiter.orders, hold);  // Lower lanes must leave its budget alone
+                break;
+            }
+            charge(lane, waiter.weight, waiter.orders, nowMillis);
+            double waited = std::chrono::duration<double, std::micro>(steadyNow - waiter.enqueued).count();
+            stats_.totalWaitMicros += waited;
+            stats_.maxWaitMicros = std::max(stats_.maxWaitMicros, waited);
+            ready.emplace_back(std::move(waiter.callback), true);
+            waiters.pop_front();
+        }
+    }
+}
+
+void RateLimiter::expireLanes(SteadyClock::time_point now, std::vector<Admission>& ready) {
+    // Caller holds mutex_
+    for (auto& lane : lanes_) {
+        while (!lane.empty() && now - lane.front().enqueued >= config_.maxQueueDelay) {
+            ready.emplace_back(std::move(lane.front().callback), false);
+            lane.pop_front();
+            ++stats_.refused;
+        }
+    }
+}
+
+void RateLimiter::rollWindows(int64_t nowMillis) {
+    for (auto& rule : rules_) {
+        int64_t index = windowIndexAt(rule, nowMillis);
+        if (index != rule.windowIndex) {
+            rule.used = index == rule.windowIndex + 1 ? rule.carry : 0;
+            rule.carry = 0;
+            rule.windowIndex = index;
+        }
+    }
+}
+
+int64_t RateLimiter::windowIndexAt(const Rule& rule, int64_t nowMillis) const {
+    int64_t shifted = nowMillis - config_.windowGuard.count();
+    return shifted / rule.windowMillis;
+}
+
+void RateLimiter::holdFor(uint32_t weight, uint32_t orders, Hold& hold) const {
+    // A waiting head blocks the rules it cannot get and reserves its share of the others
+    const uint32_t costs[] = {weight, orders};
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        if (rules_[i].limit <= 0 || costs[i] == 0) {
+            continue;
+        }
+        if (fitsRule(i, costs[i], hold.reserved[i])) {
+            hold.reserved[i] += costs[i];
+        } else {
+            hold.blocked[i] = true;
+        }
+    }
+}
+
+bool RateLimiter::fits(uint32_t weight, uint32_t orders, const Hold& hold) const {
+    const uint32_t costs[] = {weight, orders};
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        if (rules_[i].limit <= 0 || costs[i] == 0) {
+            continue;
+        }
+        if (hold.blocked[i] || !fitsRule(i, costs[i], hold.reserved[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RateLimiter::fitsRule(size_t rule, uint32_t cost, double reserved) const {
+    // A request costlier than the whole limit still goes out, alone in a fresh window
+    double committed = rules_[rule].used + reserved;
+    return committed + cost <= rules_[rule].limit || committed <= 0;
+}
+
+void RateLimiter::charge(size_t lane, uint32_t weight, uint32_t orders, int64_t nowMillis) {
+    // Within windowGuard of the boundary the venue may already count the next window
+    const uint32_t costs[] = {weight, orders};
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        Rule& rule = rules_[i];
+        rule.used += costs[i];
+        if (nowMillis >= (rule.windowIndex + 1) * rule.windowMillis) {
+            rule.carry += costs[i];
+        }
+    }
+    ++stats_.admitted[lane];
+}
+
+SystemClock::time_point RateLimiter::nextOpening(SystemClock::time_point now) const {
+    // Caller holds mutex_
+    if (now < pausedUntil_) {
+        return pausedUntil_;
+    }
+    int64_t nowMillis = toMillis(now);
+    int64_t next = INT64_MAX;
+    for (const auto& rule : rules_) {
+        if (rule.limit > 0 && rule.used > 0) {
+            int64_t opening = (windowIndexAt(rule, nowMillis) + 1) * rule.windowMillis + config_.windowGuard.count();
+            next = std::min(next, opening);
+        }
+    }
+    if (next == INT64_MAX) {
+        return now + std::chrono::milliseconds(1);  // Nothing used, so nothing should be waiting
+    }
+    return SystemClock::time_point(std::chrono::milliseconds(next));
+}
+
+size_t RateLimiter::queuedLocked() const {
+    size_t queued = 0;
+    for (const auto& lane : lanes_) {
+        queued += lane.size();
+    }
+    return queued;
+}
+
+int64_t RateLimiter::toMillis(SystemClock::time_point time) const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+// RequestCoalescer implementation
+std::string RequestCoalescer::run(const std::string& key, const std::function<std::string()>& fetch,
+                                  bool* coalesced) {
+    std::promise<std::string> result;
+    std::shared_future<std::string> shared;
+    bool leader = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = inFlight_.find(key);
+        if (it != inFlight_.end()) {
+            shared = it->second;
+        } else {
+            shared = result.get_future().share();
+            inFlight_.emplace(key, shared);
+            leader = true;
+        }
+    }
+    if (coalesced) {
+        *coalesced = !leader;
+    }
+    if (!leader) {
+        return shared.get();  // Rethrows if the leader's fetch threw
+    }
+
+    std::string value;
+    try {
+        value = fetch();
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            inFlight_.erase(key);
+        }
+        result.set_exception(std::current_exception());
+        throw;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inFlight_.erase(key);
+    }
+    result.set_value(value);
+    return value;
+}
+
+} // namespace MasterMind
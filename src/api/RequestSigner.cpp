@@ -0,0 +1,201 @@
+#include "api/RequestSigner.h"
+#include <charconv>
+#include <cstring>
+#ifdef SSL_ENABLED
+// SHA256_Transform is deprecated in OpenSSL 3 but is the only way to reach its block function directly
+#define OPENSSL_SUPPRESS_DEPRECATED
+#include <openssl/sha.h>
+#endif
+
+namespace MasterMind {
+
+namespace {
+constexpr size_t BLOCK_SIZE = 64;
+
+constexpr std::array<uint32_t, 8> SHA256_INITIAL = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// Two characters per byte value
+struct HexTable {
+    char pairs[512];
+
+    constexpr HexTable() : pairs() {
+        const char digits[] = "0123456789abcdef";
+        for (int i = 0; i < 256; ++i) {
+            pairs[2 * i] = digits[i >> 4];
+            pairs[2 * i + 1] = digits[i & 15];
+        }
+    }
+};
+constexpr HexTable HEX_TABLE;
+
+#ifdef SSL_ENABLED
+void compress(std::array<uint32_t, 8>& state, const unsigned char* block) {
+    SHA256_CTX context;
+    std::memcpy(context.h, state.data(), sizeof(context.h));
+    SHA256_Transform(&context, block);
+    std::memcpy(state.data(), context.h, sizeof(context.h));
+}
+#else
+constexpr uint32_t ROUND_CONSTANTS[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t rotateRight(uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+void compress(std::array<uint32_t, 8>& state, const unsigned char* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (uint32_t(block[4 * i]) << 24) | (uint32_t(block[4 * i + 1]) << 16) |
+               (uint32_t(block[4 * i + 2]) << 8) | uint32_t(block[4 * i + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t t1 = h + (rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25)) + ((e & f) ^ (~e & g)) +
+                      ROUND_CONSTANTS[i] + w[i];
+        uint32_t t2 = (rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+#endif
+
+// Hash of prefixBytes already compressed into state, then data; digest written big-endian
+void finish(std::array<uint32_t, 8> state, uint64_t prefixBytes, const unsigned char* data, size_t length,
+            unsigned char* out) {
+    size_t whole = length - length % BLOCK_SIZE;
+    for (size_t offset = 0; offset < whole; offset += BLOCK_SIZE) {
+        compress(state, data + offset);
+    }
+
+    // Tail, 0x80, zeros, then the bit length in the last 8 bytes; one or two blocks
+    unsigned char tail[2 * BLOCK_SIZE] = {};
+    size_t rest = length - whole;
+    std::memcpy(tail, data + whole, rest);
+    tail[rest] = 0x80;
+    size_t tailLength = rest + 9 <= BLOCK_SIZE ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+    uint64_t bits = (prefixBytes + length) * 8;
+    for (int i = 0; i < 8; ++i) {
+        tail[tailLength - 1 - i] = static_cast<unsigned char>(bits >> (8 * i));
+    }
+    compress(state, tail);
+    if (tailLength == 2 * BLOCK_SIZE) {
+        compress(state, tail + BLOCK_SIZE);
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        out[4 * i] = static_cast<unsigned char>(state[i] >> 24);
+        out[4 * i + 1] = static_cast<unsigned char>(state[i] >> 16);
+        out[4 * i + 2] = static_cast<unsigned char>(state[i] >> 8);
+        out[4 * i + 3] = static_cast<unsigned char>(state[i]);
+    }
+}
+}
+
+RequestSigner::RequestSigner(const std::string& secret)
+    : innerState_(SHA256_INITIAL), outerState_(SHA256_INITIAL), keyed_(false) {
+    setSecret(secret);
+}
+
+void RequestSigner::setSecret(const std::string& secret) {
+    // Keys longer than a block are replaced by their hash (RFC 2104)
+    unsigned char key[BLOCK_SIZE] = {};
+    if (secret.size() > BLOCK_SIZE) {
+        finish(SHA256_INITIAL, 0, reinterpret_cast<const unsigned char*>(secret.data()), secret.size(), key);
+    } else {
+        std::memcpy(key, secret.data(), secret.size());
+    }
+
+    unsigned char pad[BLOCK_SIZE];
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        pad[i] = key[i] ^ 0x36;
+    }
+    innerState_ = SHA256_INITIAL;
+    compress(innerState_, pad);
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        pad[i] = key[i] ^ 0x5c;
+    }
+    outerState_ = SHA256_INITIAL;
+    compress(outerState_, pad);
+    keyed_ = !secret.empty();
+}
+
+void RequestSigner::sign(const char* data, size_t length, char* hex) const {
+    unsigned char innerDigest[DIGEST_SIZE];
+    unsigned char mac[DIGEST_SIZE];
+    finish(innerState_, BLOCK_SIZE, reinterpret_cast<const unsigned char*>(data), length, innerDigest);
+    finish(outerState_, BLOCK_SIZE, innerDigest, DIGEST_SIZE, mac);
+    toHex(mac, DIGEST_SIZE, hex);
+}
+
+std::string RequestSigner::sign(std::string_view message) const {
+    std::string hex(HEX_SIZE, '\0');
+    sign(message.data(), message.size(), &hex[0]);
+    return hex;
+}
+
+const std::string& RequestSigner::signParams(std::string_view params, int64_t timestampMillis) const {
+    static constexpr std::string_view TIMESTAMP = "timestamp=";
+    static constexpr std::string_view SIGNATURE = "&signature=";
+    thread_local std::string query;
+
+    // Grows to the longest query seen on this thread, then never allocates again
+    char digits[24];
+    char* digitsEnd = std::to_chars(digits, digits + sizeof(digits), timestampMillis).ptr;
+    size_t signedLength = params.size() + (params.empty() ? 0 : 1) + TIMESTAMP.size() + (digitsEnd - digits);
+    query.resize(signedLength + SIGNATURE.size() + HEX_SIZE);
+
+    char* out = &query[0];
+    if (!params.empty()) {
+        std::memcpy(out, params.data(), params.size());
+        out += params.size();
+        *out++ = '&';
+    }
+    std::memcpy(out, TIMESTAMP.data(), TIMESTAMP.size());
+    out += TIMESTAMP.size();
+    std::memcpy(out, digits, digitsEnd - digits);
+    out += digitsEnd - digits;
+    std::memcpy(out, SIGNATURE.data(), SIGNATURE.size());
+    out += SIGNATURE.size();
+    sign(query.data(), signedLength, out);
+    return query;
+}
+
+void RequestSigner::toHex(const unsigned char* bytes, size_t length, char* hex) {
+    for (size_t i = 0; i < length; ++i) {
+        std::memcpy(hex + 2 * i, HEX_TABLE.pairs + 2 * bytes[i], 2);
+    }
+}
+
+} // namespace MasterMind
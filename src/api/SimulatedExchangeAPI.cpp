@@ -0,0 +1,1181 @@
+#include "api/SimulatedExchangeAPI.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MasterMind {
+
+namespace {
+constexpr Volume QUANTITY_EPSILON = 1e-9;
+const char* const EXCHANGE_ID = "SIMULATED";
+
+bool isStopType(OrderType type) {
+    return type == OrderType::STOP || type == OrderType::STOP_LIMIT;
+}
+}
+
+SimulatedExchangeAPI::SimulatedExchangeAPI()
+    : SimulatedExchangeAPI(SimulationConfig()) {
+}
+
+SimulatedExchangeAPI::SimulatedExchangeAPI(const SimulationConfig& config)
+    : ExchangeAPI(Exchange::SIMULATED), config_(config), balance_(config.initialBalance),
+      realizedPnL_(0), clockStarted_(false), nextTag_(1), nextSequence_(0),
+      matchedEvents_(0), accountDirty_(false), rng_(config.randomSeed), bookUpdateId_(0),
+      pending_(std::make_unique<NotificationBuffer>()) {
+    fills_.reserve(256);
+    triggered_.reserve(64);
+    bookBids_.reserve(PUBLISHED_DEPTH + 1);
+    bookAsks_.reserve(PUBLISHED_DEPTH + 1);
+    pending_->records.reserve(64);
+    spareBuffers_.push_back(std::make_unique<NotificationBuffer>());
+    spareBuffers_.back()->records.reserve(64);
+    std::cout << "SimulatedExchangeAPI initialized" << std::endl;
+}
+
+SimulatedExchangeAPI::~SimulatedExchangeAPI() = default;
+
+// Simulation control
+void SimulatedExchangeAPI::setSimulationConfig(const SimulationConfig& config) {
+    std::lock_guard<std::mutex> lock(simMutex_);
+    config_ = config;
+    rng_.seed(config.randomSeed);
+}
+
+SimulatedExchangeAPI::SimulationConfig SimulatedExchangeAPI::getSimulationConfig() const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+    return config_;
+}
+
+void SimulatedExchangeAPI::addInstrument(const InstrumentSpec& spec) {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    auto it = symbols_.find(spec.symbol);
+    if (it == symbols_.end()) {
+        auto state = std::make_unique<SymbolState>(spec.tickSize);
+        state->spec = spec;
+        state->position.symbol = spec.symbol;
+        state->position.side = OrderSide::BUY;
+        state->position.exchange = EXCHANGE_ID;
+        symbols_.emplace(spec.symbol, std::move(state));
+        return;
+    }
+
+    SymbolState& state = *it->second;
+    state.spec = spec;
+    // Tick size can only change while nothing rests at the old granularity
+    if (state.book.getOrderCount() == 0 && state.buyStops.empty() && state.sellStops.empty()) {
+        state.book = SimulatedOrderBook(spec.tickSize);
+    }
+}
+
+void SimulatedExchangeAPI::onMarketTick(const Tick& tick) {
+    std::unique_ptr<NotificationBuffer> notifications;
+    {
+        std::lock_guard<std::mutex> lock(simMutex_);
+
+        SymbolState& state = getSymbolState(tick.symbol);
+        state.lastTick = tick;
+        state.hasTick = true;
+        state.tickLiquidityUsed = 0;
+        markBookDirty(state);
+
+        if (!clockStarted_ || tick.timestamp > clock_) {
+            clock_ = tick.timestamp;
+            clockStarted_ = true;
+        }
+
+        if (subscriptions_.count(tick.symbol)) {
+            queueNotification(Notification::Kind::TICK, pending_->ticks.add(tick));
+        }
+
+        releasePendingEvents();
+        matchRestingAgainstTick(state);
+        triggerStops(state);
+
+        // Mark the position to market
+        Position& position = state.position;
+        if (position.quantity > QUANTITY_EPSILON) {
+            double direction = position.isLong() ? 1.0 : -1.0;
+            position.currentPrice = tick.last;
+            position.unrealizedPnL = (tick.last - position.averagePrice) * position.quantity *
+                                     state.spec.contractSize * direction;
+            position.updateTime = tick.timestamp;
+            queuePositionUpdate(state);
+        }
+
+        notifications = takeNotifications();
+    }
+
+    dispatchNotifications(std::move(notifications));
+}
+
+void SimulatedExchangeAPI::replayTicks(const std::vector<Tick>& ticks) {
+    for (const auto& tick : ticks) {
+        onMarketTick(tick);
+    }
+}
+
+void SimulatedExchangeAPI::advanceTime(TimePoint now) {
+    std::unique_ptr<NotificationBuffer> notifications;
+    {
+        std::lock_guard<std::mutex> lock(simMutex_);
+        if (!clockStarted_ || now > clock_) {
+            clock_ = now;
+            clockStarted_ = true;
+        }
+        releasePendingEvents();
+        notifications = takeNotifications();
+    }
+
+    dispatchNotifications(std::move(notifications));
+}
+
+void SimulatedExchangeAPI::loadHistoricalData(const Symbol& symbol, const std::vector<OHLC>& bars) {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    auto& history = getSymbolState(symbol).history;
+    history.insert(history.end(), bars.begin(), bars.end());
+    std::stable_sort(history.begin(), history.end(),
+                     [](const OHLC& a, const OHLC& b) { return a.timestamp < b.timestamp; });
+}
+
+void SimulatedExchangeAPI::reset() {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    dirtyBooks_.clear();
+    symbols_.clear();
+    orders_.clear();
+    orderTags_.clear();
+    completedOrders_.clear();
+    pendingEvents_ = decltype(pendingEvents_)();
+    pending_->clear();
+    balance_ = config_.initialBalance;
+    realizedPnL_ = 0;
+    clock_ = TimePoint();
+    clockStarted_ = false;
+    nextSequence_ = 0;
+    matchedEvents_ = 0;
+    accountDirty_ = false;
+    rng_.seed(config_.randomSeed);
+
+    std::lock_guard<std::mutex> booksLock(orderBooksMutex_);
+    for (auto& pair : orderBooks_) {
+        pair.second->clear();
+    }
+}
+
+uint64_t SimulatedExchangeAPI::getMatchedEventCount() const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+    return matchedEvents_;
+}
+
+// Connection management
+bool SimulatedExchangeAPI::connect() {
+    sessionWanted_ = true;
+    connected_ = true;
+    std::cout << "Connected to simulated exchange" << std::endl;
+    return true;
+}
+
+bool SimulatedExchangeAPI::disconnect() {
+    sessionWanted_ = false;
+    if (!connected_) {
+        return true;
+    }
+
+    connected_ = false;
+    authenticated_ = false;
+    std::cout << "Disconnected from simulated exchange" << std::endl;
+    return true;
+}
+
+bool SimulatedExchangeAPI::isConnected() const {
+    return connected_;
+}
+
+bool SimulatedExchangeAPI::reconnect() {
+    disconnect();
+    return connect();
+}
+
+// Authentication
+bool SimulatedExchangeAPI::authenticate(const std::string& apiKey,
+                                        const std::string& apiSecret,
+                                        const std::string& passphrase) {
+    // Credentials are not checked by the simulator
+    authenticated_ = true;
+    return true;
+}
+
+bool SimulatedExchangeAPI::isAuthenticated() const {
+    return authenticated_;
+}
+
+// Market data
+bool SimulatedExchangeAPI::subscribeMarketData(const std::vector<Symbol>& symbols) {
+    std::lock_guard<std::mutex> lock(simMutex_);
+    subscriptions_.insert(symbols.begin(), symbols.end());
+    return true;
+}
+
+bool SimulatedExchangeAPI::unsubscribeMarketData(const std::vector<Symbol>& symbols) {
+    std::lock_guard<std::mutex> lock(simMutex_);
+    for (const auto& symbol : symbols) {
+        subscriptions_.erase(symbol);
+    }
+    return true;
+}
+
+Tick SimulatedExchangeAPI::getLastTick(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    const SymbolState* state = findSymbolState(symbol);
+    if (!state || !state->hasTick) {
+        setError("No market data for " + symbol);
+        Tick tick;
+        tick.symbol = symbol;
+        tick.bid = tick.ask = tick.last = 0;
+        tick.volume = 0;
+        return tick;
+    }
+    return state->lastTick;
+}
+
+std::vector<OHLC> SimulatedExchangeAPI::getHistoricalData(const Symbol& symbol,
+                                                          TimePoint start,
+                                                          TimePoint end,
+                                                          Duration interval) const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    std::vector<OHLC> result;
+    const SymbolState* state = findSymbolState(symbol);
+    if (!state) {
+        return result;
+    }
+
+    const auto& history = state->history;
+    auto first = std::lower_bound(history.begin(), history.end(), start,
+                                  [](const OHLC& bar, TimePoint t) { return bar.timestamp < t; });
+
+    // Aggregate stored bars into buckets of the requested interval
+    int64_t currentBucket = std::numeric_limits<int64_t>::min();
+    for (auto it = first; it != history.end() && it->timestamp <= end; ++it) {
+        int64_t bucket = interval.count() > 0
+            ? std::chrono::duration_cast<Duration>(it->timestamp.time_since_epoch()).count() / interval.count()
+            : static_cast<int64_t>(it - first);
+
+        if (bucket != currentBucket || result.empty()) {
+            OHLC bar = *it;
+            if (interval.count() > 0) {
+                bar.timestamp = TimePoint(Duration(bucket * interval.count()));
+            }
+            result.push_back(bar);
+            currentBucket = bucket;
+        } else {
+            OHLC& bar = result.back();
+            bar.high = std::max(bar.high, it->high);
+            bar.low = std::min(bar.low, it->low);
+            bar.close = it->close;
+            bar.volume += it->volume;
+        }
+    }
+
+    return result;
+}
+
+// Order management
+OrderId SimulatedExchangeAPI::placeOrder(const Order& order) {
+    if (!connected_ || !validateOrder(order)) {
+        std::lock_guard<std::mutex> lock(simMutex_);
+        setError(connected_ ? "Invalid order parameters" : "Not connected");
+        return "";
+    }
+
+    OrderId orderId;
+    std::unique_ptr<NotificationBuffer> notifications;
+    {
+        std::lock_guard<std::mutex> lock(simMutex_);
+
+        uint64_t tag = nextTag_++;
+        orderId = order.orderId.empty() ? "SIM-" + std::to_string(tag) : order.orderId;
+        if (orderTags_.count(orderId)) {
+            setError("Duplicate order id " + orderId);
+            return "";
+        }
+
+        SimOrder& simOrder = orders_[tag];
+        simOrder.tag = tag;
+        simOrder.order = order;
+        simOrder.order.orderId = orderId;
+        simOrder.order.filledQuantity = 0;
+        simOrder.order.status = OrderStatus::SUBMITTED;
+        simOrder.order.exchange = EXCHANGE_ID;
+        simOrder.order.createTime = currentTime();
+        simOrder.order.updateTime = simOrder.order.createTime;
+        orderTags_[orderId] = tag;
+
+        queueOrderUpdate(simOrder.order);
+
+        Duration latency = sampleLatency(config_.orderLatency);
+        if (latency.count() > 0) {
+            pendingEvents_.push({currentTime() + latency, nextSequence_++, EventType::NEW_ORDER, tag});
+        } else {
+            activateOrder(tag);
+        }
+
+        notifications = takeNotifications();
+    }
+
+    dispatchNotifications(std::move(notifications));
+    return orderId;
+}
+
+bool SimulatedExchangeAPI::cancelOrder(const OrderId& orderId) {
+    std::unique_ptr<NotificationBuffer> notifications;
+    {
+        std::lock_guard<std::mutex> lock(simMutex_);
+
+        auto it = orderTags_.find(orderId);
+        if (it == orderTags_.end()) {
+            setError("Unknown or completed order " + orderId);
+            return false;
+        }
+
+        Duration latency = sampleLatency(config_.cancelLatency);
+        if (latency.count() > 0) {
+            pendingEvents_.push({currentTime() + latency, nextSequence_++, EventType::CANCEL_ORDER, it->second});
+        } else {
+            executeCancel(it->second);
+        }
+
+        notifications = takeNotifications();
+    }
+
+    dispatchNotifications(std::move(notifications));
+    return true;
+}
+
+bool SimulatedExchangeAPI::modifyOrder(const OrderId& orderId, const Order& newOrder) {
+    std::unique_ptr<NotificationBuffer> notifications;
+    {
+        std::lock_guard<std::mutex> lock(simMutex_);
+
+        auto tagIt = orderTags_.find(orderId);
+        if (tagIt == orderTags_.end()) {
+            setError("Unknown or completed order " + orderId);
+            return false;
+        }
+
+        SimOrder& simOrder = orders_.at(tagIt->second);
+        Order& order = simOrder.order;
+        if (newOrder.quantity <= order.filledQuantity + QUANTITY_EPSILON) {
+            setError("New quantity must exceed filled quantity");
+            return false;
+        }
+
+        SymbolState& state = getSymbolState(order.symbol);
+        markBookDirty(state);
+        bool samePrice = state.book.toTicks(newOrder.price) == state.book.toTicks(order.price);
+
+        if (simOrder.handle != SimulatedOrderBook::INVALID_HANDLE &&
+            samePrice && newOrder.quantity < order.quantity) {
+            // Size-down in place keeps queue priority
+            state.book.reduce(simOrder.handle, newOrder.quantity - order.filledQuantity);
+            order.quantity = newOrder.quantity;
+            order.updateTime = currentTime();
+            queueOrderUpdate(order);
+        } else if (simOrder.handle != SimulatedOrderBook::INVALID_HANDLE) {
+            // Cancel-replace: re-enters at the back of the queue and may trade
+            state.book.cancel(simOrder.handle);
+            simOrder.handle = SimulatedOrderBook::INVALID_HANDLE;
+            order.price = newOrder.price;
+            order.quantity = newOrder.quantity;
+            order.visibleQuantity = newOrder.visibleQuantity;
+            order.updateTime = currentTime();
+            queueOrderUpdate(order);
+            executeOrder(simOrder, state);
+        } else if (isStopType(order.type) && simOrder.active && !simOrder.triggered) {
+            // Armed stop: re-arm at the new trigger, which may already be crossed
+            auto& stops = order.side == OrderSide::BUY ? state.buyStops : state.sellStops;
+            auto range = stops.equal_range(state.book.toTicks(order.triggerPrice));
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == simOrder.tag) {
+                    stops.erase(it);
+                    break;
+                }
+            }
+            order.price = newOrder.price;
+            order.triggerPrice = newOrder.triggerPrice;
+            order.quantity = newOrder.quantity;
+            order.updateTime = currentTime();
+            queueOrderUpdate(order);
+            activateOrder(simOrder.tag);
+        } else {
+            // Not yet active (latency) - amend the pending order
+            order.price = newOrder.price;
+            order.triggerPrice = newOrder.triggerPrice;
+            order.quantity = newOrder.quantity;
+            order.visibleQuantity = newOrder.visibleQuantity;
+            order.updateTime = currentTime();
+            queueOrderUpdate(order);
+        }
+
+        notifications = takeNotifications();
+    }
+
+    dispatchNotifications(std::move(notifications));
+    return true;
+}
+
+Order SimulatedExchangeAPI::getOrder(const OrderId& orderId) const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    auto it = orderTags_.find(orderId);
+    if (it != orderTags_.end()) {
+        return orders_.at(it->second).order;
+    }
+
+    for (auto rit = completedOrders_.rbegin(); rit != completedOrders_.rend(); ++rit) {
+        if (rit->orderId == orderId) {
+            return *rit;
+        }
+    }
+
+    setError("Order not found: " + orderId);
+    return Order();
+}
+
+std::vector<Order> SimulatedExchangeAPI::getActiveOrders() const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    std::vector<Order> result;
+    result.reserve(orders_.size());
+    for (const auto& pair : orders_) {
+        result.push_back(pair.second.order);
+    }
+    return result;
+}
+
+std::vector<Order> SimulatedExchangeAPI::getOrderHistory(const Symbol& symbol, int limit) const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    std::vector<Order> result;
+    for (auto it = completedOrders_.rbegin();
+         it != completedOrders_.rend() && static_cast<int>(result.size()) < limit; ++it) {
+        if (symbol.empty() || it->symbol == symbol) {
+            result.push_back(*it);
+        }
+    }
+    return result;
+}
+
+// Position management
+std::vector<Position> SimulatedExchangeAPI::getPositions() const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    std::vector<Position> result;
+    for (const auto& pair : symbols_) {
+        if (pair.second->position.quantity > QUANTITY_EPSILON) {
+            result.push_back(pair.second->position);
+        }
+    }
+    return result;
+}
+
+Position SimulatedExchangeAPI::getPosition(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    const SymbolState* state = findSymbolState(symbol);
+    if (!state) {
+        Position position;
+        position.symbol = symbol;
+        position.side = OrderSide::BUY;
+        position.exchange = EXCHANGE_ID;
+        return position;
+    }
+    return state->position;
+}
+
+bool SimulatedExchangeAPI::closePosition(const Symbol& symbol) {
+    Order order;
+    {
+        std::lock_guard<std::mutex> lock(simMutex_);
+
+        const SymbolState* state = findSymbolState(symbol);
+        if (!state || state->position.quantity <= QUANTITY_EPSILON) {
+            return true;
+        }
+
+        order.symbol = symbol;
+        order.type = OrderType::MARKET;
+        order.side = state->position.isLong() ? OrderSide::SELL : OrderSide::BUY;
+        order.quantity = state->position.quantity;
+        order.price = state->lastTick.last;
+        order.strategyId = "CLOSE_POSITION";
+    }
+
+    return !placeOrder(order).empty();
+}
+
+bool SimulatedExchangeAPI::closeAllPositions() {
+    std::vector<Symbol> symbols;
+    {
+        std::lock_guard<std::mutex> lock(simMutex_);
+        for (const auto& pair : symbols_) {
+            if (pair.second->position.quantity > QUANTITY_EPSILON) {
+                symbols.push_back(pair.first);
+            }
+        }
+    }
+
+    bool success = true;
+    for (const auto& symbol : symbols) {
+        success = closePosition(symbol) && success;
+    }
+    return success;
+}
+
+// Account information
+AccountInfo SimulatedExchangeAPI::getAccountInfo() const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+    return buildAccountInfo();
+}
+
+double SimulatedExchangeAPI::getBalance() const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+    return balance_;
+}
+
+double SimulatedExchangeAPI::getEquity() const {
+    return getAccountInfo().equity;
+}
+
+double SimulatedExchangeAPI::getMargin() const {
+    return getAccountInfo().margin;
+}
+
+double SimulatedExchangeAPI::getFreeMargin() const {
+    return getAccountInfo().freeMargin;
+}
+
+// Instrument information
+std::vector<InstrumentSpec> SimulatedExchangeAPI::getInstruments() const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    std::vector<InstrumentSpec> result;
+    result.reserve(symbols_.size());
+    for (const auto& pair : symbols_) {
+        result.push_back(pair.second->spec);
+    }
+    return result;
+}
+
+InstrumentSpec SimulatedExchangeAPI::getInstrumentSpec(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    const SymbolState* state = findSymbolState(symbol);
+    if (state) {
+        return state->spec;
+    }
+
+    InstrumentSpec spec;
+    spec.symbol = symbol;
+    spec.assetClass = AssetClass::CRYPTO;
+    spec.tickSize = config_.defaultTickSize;
+    spec.marginRequirement = 1.0;
+    spec.minOrderSize = 0;
+    return spec;
+}
+
+bool SimulatedExchangeAPI::isSymbolAvailable(const Symbol& symbol) const {
+    // Any symbol can be traded; state is created on first use
+    return !symbol.empty();
+}
+
+// Exchange-specific information
+std::string SimulatedExchangeAPI::getExchangeName() const {
+    return "Simulated";
+}
+
+std::vector<AssetClass> SimulatedExchangeAPI::getSupportedAssetClasses() const {
+    return {AssetClass::FOREX, AssetClass::CRYPTO, AssetClass::FUTURES, AssetClass::OPTIONS};
+}
+
+// Trading session information
+bool SimulatedExchangeAPI::isTradingSessionOpen() const {
+    return true;
+}
+
+TimePoint SimulatedExchangeAPI::getNextTradingSession() const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+    return currentTime();
+}
+
+std::vector<std::pair<TimePoint, TimePoint>> SimulatedExchangeAPI::getTradingSessions() const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+    auto now = currentTime();
+    return {{now, now + std::chrono::hours(24)}};
+}
+
+// Fee and cost calculations
+double SimulatedExchangeAPI::calculateTradingFee(const Order& order) const {
+    std::lock_guard<std::mutex> lock(simMutex_);
+
+    Price price = order.price;
+    if (price <= 0) {
+        const SymbolState* state = findSymbolState(order.symbol);
+        price = state ? state->lastTick.last : 0;
+    }
+    double rate = order.type == OrderType::MARKET ? config_.takerFeeRate : config_.makerFeeRate;
+    return order.quantity * price * rate;
+}
+
+double SimulatedExchangeAPI::calculateMarginRequirement(const Order& order) const {
+    InstrumentSpec spec = getInstrumentSpec(order.symbol);
+    return order.quantity * order.price * spec.contractSize * spec.marginRequirement;
+}
+
+// Error handling
+std::string SimulatedExchangeAPI::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    return lastError_;
+}
+
+void SimulatedExchangeAPI::clearErrors() {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    lastError_.clear();
+}
+
+// Protected methods
+bool SimulatedExchangeAPI::validateSymbol(const Symbol& symbol) const {
+    return isSymbolAvailable(symbol);
+}
+
+bool SimulatedExchangeAPI::validateOrder(const Order& order) const {
+    if (!validateSymbol(order.symbol) || order.quantity <= 0) {
+        return false;
+    }
+
+    bool needsPrice = order.type != OrderType::MARKET && order.type != OrderType::STOP;
+    if (needsPrice && order.price <= 0) {
+        return false;
+    }
+    if (isStopType(order.type) && order.triggerPrice <= 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(simMutex_);
+    const SymbolState* state = findSymbolState(order.symbol);
+    if (state && (order.quantity < state->spec.minOrderSize ||
+                  order.quantity > state->spec.maxOrderSize)) {
+        return false;
+    }
+    return true;
+}
+
+// Private methods - order lifecycle
+SimulatedExchangeAPI::SymbolState& SimulatedExchangeAPI::getSymbolState(const Symbol& symbol) {
+    auto it = symbols_.find(symbol);
+    if (it != symbols_.end()) {
+        return *it->second;
+    }
+
+    auto state = std::make_unique<SymbolState>(config_.defaultTickSize);
+    state->spec.symbol = symbol;
+    state->spec.assetClass = AssetClass::CRYPTO;
+    state->spec.tickSize = config_.defaultTickSize;
+    state->spec.marginRequirement = 1.0;
+    state->spec.minOrderSize = 0;
+    state->position.symbol = symbol;
+    state->position.side = OrderSide::BUY;
+    state->position.exchange = EXCHANGE_ID;
+
+    return *symbols_.emplace(symbol, std::move(state)).first->second;
+}
+
+const SimulatedExchangeAPI::SymbolState* SimulatedExchangeAPI::findSymbolState(const Symbol& symbol) const {
+    auto it = symbols_.find(symbol);
+    return it != symbols_.end() ? it->second.get() : nullptr;
+}
+
+void SimulatedExchangeAPI::activateOrder(uint64_t tag) {
+    auto it = orders_.find(tag);
+    if (it == orders_.end()) {
+        return;  // Cancelled while in flight
+    }
+
+    SimOrder& simOrder = it->second;
+    SymbolState& state = getSymbolState(simOrder.order.symbol);
+    markBookDirty(state);
+    simOrder.active = true;
+
+    if (isStopType(simOrder.order.type) && !simOrder.triggered) {
+        Price last = state.lastTick.last;
+        Price trigger = simOrder.order.triggerPrice;
+        bool crossed = state.hasTick &&
+            (simOrder.order.side == OrderSide::BUY ? last >= trigger : last <= trigger);
+        if (!crossed) {
+            auto& stops = simOrder.order.side == OrderSide::BUY ? state.buyStops : state.sellStops;
+            stops.emplace(state.book.toTicks(trigger), tag);
+            return;
+        }
+        simOrder.triggered = true;
+    }
+
+    executeOrder(simOrder, state);
+}
+
+void SimulatedExchangeAPI::executeOrder(SimOrder& simOrder, SymbolState& state) {
+    Order& order = simOrder.order;
+    bool marketable = order.type == OrderType::MARKET ||
+                      (order.type == OrderType::STOP && simOrder.triggered);
+
+    int64_t limitTicks = marketable
+        ? (order.side == OrderSide::BUY ? SimulatedOrderBook::MARKET_BUY_LIMIT
+                                        : SimulatedOrderBook::MARKET_SELL_LIMIT)
+        : state.book.toTicks(order.price);
+
+    takeLiquidity(simOrder, state, limitTicks);
+
+    Volume remaining = order.quantity - order.filledQuantity;
+    if (remaining <= QUANTITY_EPSILON) {
+        finishOrder(simOrder.tag, OrderStatus::FILLED);
+        return;
+    }
+
+    if (marketable) {
+        // Market orders are immediate-or-cancel against the available liquidity
+        if (order.filledQuantity <= QUANTITY_EPSILON) {
+            setError("No liquidity for market order " + order.orderId);
+            finishOrder(simOrder.tag, OrderStatus::REJECTED);
+        } else {
+            finishOrder(simOrder.tag, OrderStatus::CANCELLED);
+        }
+        return;
+    }
+
+    // Iceberg and hybrid orders show a slice; pegged and hybrid orders rest at
+    // the price the caller computed (re-pegging is done by the order manager)
+    Volume display = (order.type == OrderType::ICEBERG || order.type == OrderType::HYBRID)
+                         ? order.visibleQuantity : 0;
+    simOrder.handle = state.book.add(simOrder.tag, order.side, limitTicks, remaining, display);
+}
+
+void SimulatedExchangeAPI::executeCancel(uint64_t tag) {
+    auto it = orders_.find(tag);
+    if (it == orders_.end()) {
+        return;  // Filled or cancelled before the request arrived
+    }
+
+    SimOrder& simOrder = it->second;
+    SymbolState& state = getSymbolState(simOrder.order.symbol);
+    markBookDirty(state);
+
+    if (simOrder.handle != SimulatedOrderBook::INVALID_HANDLE) {
+        state.book.cancel(simOrder.handle);
+        simOrder.handle = SimulatedOrderBook::INVALID_HANDLE;
+    } else if (isStopType(simOrder.order.type) && !simOrder.triggered) {
+        auto& stops = simOrder.order.side == OrderSide::BUY ? state.buyStops : state.sellStops;
+        auto range = stops.equal_range(state.book.toTicks(simOrder.order.triggerPrice));
+        for (auto stopIt = range.first; stopIt != range.second; ++stopIt) {
+            if (stopIt->second == tag) {
+                stops.erase(stopIt);
+                break;
+            }
+        }
+    }
+
+    finishOrder(tag, OrderStatus::CANCELLED);
+}
+
+void SimulatedExchangeAPI::takeLiquidity(SimOrder& simOrder, SymbolState& state, int64_t limitTicks) {
+    Order& order = simOrder.order;
+
+    // Resting simulated orders have priority over the synthetic tick liquidity
+    fills_.clear();
+    state.book.match(order.side, limitTicks, order.quantity - order.filledQuantity, fills_);
+    for (const auto& fill : fills_) {
+        recordFill(simOrder, state, fill.quantity, state.book.toPrice(fill.priceTicks), false);
+    }
+    applyMakerFills(state);
+
+    Volume remaining = order.quantity - order.filledQuantity;
+    if (remaining <= QUANTITY_EPSILON || !state.hasTick) {
+        return;
+    }
+
+    const Tick& tick = state.lastTick;
+    Price quote = order.side == OrderSide::BUY ? tick.ask : tick.bid;
+    if (quote <= 0) {
+        quote = tick.last;
+    }
+    if (quote <= 0) {
+        return;
+    }
+
+    bool marketable = limitTicks == SimulatedOrderBook::MARKET_BUY_LIMIT ||
+                      limitTicks == SimulatedOrderBook::MARKET_SELL_LIMIT;
+    Price limitPrice = state.book.toPrice(limitTicks);
+    if (!marketable && (order.side == OrderSide::BUY ? quote > limitPrice : quote < limitPrice)) {
+        return;
+    }
+
+    Volume quantity = remaining;
+    if (config_.tickLiquidity > 0) {
+        quantity = std::min(quantity, config_.tickLiquidity - state.tickLiquidityUsed);
+        if (quantity <= QUANTITY_EPSILON) {
+            return;
+        }
+    }
+
+    double slippage = (config_.slippageBps + config_.impactBpsPerUnit * quantity) / 10000.0;
+    Price price = order.side == OrderSide::BUY ? quote * (1.0 + slippage) : quote * (1.0 - slippage);
+    if (!marketable) {
+        price = order.side == OrderSide::BUY ? std::min(price, limitPrice) : std::max(price, limitPrice);
+    }
+
+    state.tickLiquidityUsed += quantity;
+    recordFill(simOrder, state, quantity, price, false);
+}
+
+void SimulatedExchangeAPI::applyMakerFills(SymbolState& state) {
+    for (const auto& fill : fills_) {
+        auto it = orders_.find(fill.makerTag);
+        if (it == orders_.end()) {
+            continue;
+        }
+
+        SimOrder& maker = it->second;
+        recordFill(maker, state, fill.quantity, state.book.toPrice(fill.priceTicks), true);
+        if (fill.makerComplete) {
+            maker.handle = SimulatedOrderBook::INVALID_HANDLE;
+            finishOrder(fill.makerTag, OrderStatus::FILLED);
+        }
+    }
+    fills_.clear();
+}
+
+void SimulatedExchangeAPI::matchRestingAgainstTick(SymbolState& state) {
+    const Tick& tick = state.lastTick;
+    Volume available = config_.tickLiquidity > 0
+        ? config_.tickLiquidity - state.tickLiquidityUsed
+        : std::numeric_limits<Volume>::max();
+
+    // Resting bids trade with the market's offer when it trades through them
+    Price ask = tick.ask > 0 ? tick.ask : tick.last;
+    if (ask > 0 && state.book.hasBids() && available > QUANTITY_EPSILON) {
+        fills_.clear();
+        Volume matched = state.book.match(OrderSide::SELL, state.book.toTicks(ask), available, fills_);
+        state.tickLiquidityUsed += matched;
+        available -= matched;
+        applyMakerFills(state);
+    }
+
+    Price bid = tick.bid > 0 ? tick.bid : tick.last;
+    if (bid > 0 && state.book.hasAsks() && available > QUANTITY_EPSILON) {
+        fills_.clear();
+        Volume matched = state.book.match(OrderSide::BUY, state.book.toTicks(bid), available, fills_);
+        state.tickLiquidityUsed += matched;
+        applyMakerFills(state);
+    }
+}
+
+void SimulatedExchangeAPI::triggerStops(SymbolState& state) {
+    if (state.buyStops.empty() && state.sellStops.empty()) {
+        return;
+    }
+
+    int64_t lastTicks = state.book.toTicks(state.lastTick.last);
+    triggered_.clear();
+
+    // Buy stops trigger at or above their level, sell stops at or below
+    auto buyEnd = state.buyStops.upper_bound(lastTicks);
+    for (auto it = state.buyStops.begin(); it != buyEnd; ++it) {
+        triggered_.push_back(it->second);
+    }
+    state.buyStops.erase(state.buyStops.begin(), buyEnd);
+
+    auto sellBegin = state.sellStops.lower_bound(lastTicks);
+    for (auto it = sellBegin; it != state.sellStops.end(); ++it) {
+        triggered_.push_back(it->second);
+    }
+    state.sellStops.erase(sellBegin, state.sellStops.end());
+
+    for (uint64_t tag : triggered_) {
+        auto it = orders_.find(tag);
+        if (it != orders_.end()) {
+            it->second.triggered = true;
+            executeOrder(it->second, state);
+        }
+    }
+}
+
+void SimulatedExchangeAPI::finishOrder(uint64_t tag, OrderStatus status) {
+    auto it = orders_.find(tag);
+    if (it == orders_.end()) {
+        return;
+    }
+
+    Order& order = it->second.order;
+    order.status = status;
+    order.updateTime = currentTime();
+    queueOrderUpdate(order);
+
+    orderTags_.erase(order.orderId);
+    completedOrders_.push_back(std::move(order));
+    if (completedOrders_.size() > MAX_COMPLETED_ORDERS) {
+        completedOrders_.pop_front();
+    }
+    orders_.erase(it);
+}
+
+void SimulatedExchangeAPI::releasePendingEvents() {
+    while (!pendingEvents_.empty() && pendingEvents_.top().activateAt <= clock_) {
+        PendingEvent event = pendingEvents_.top();
+        pendingEvents_.pop();
+
+        if (event.type == EventType::NEW_ORDER) {
+            activateOrder(event.tag);
+        } else {
+            executeCancel(event.tag);
+        }
+    }
+}
+
+Duration SimulatedExchangeAPI::sampleLatency(Duration base) {
+    if (config_.latencyJitter.count() <= 0) {
+        return base;
+    }
+    std::uniform_int_distribution<int64_t> jitter(0, config_.latencyJitter.count());
+    return base + Duration(jitter(rng_));
+}
+
+// Private methods - accounting
+void SimulatedExchangeAPI::recordFill(SimOrder& simOrder, SymbolState& state,
+                                      Volume quantity, Price price, bool maker) {
+    Order& order = simOrder.order;
+    order.filledQuantity += quantity;
+    simOrder.notionalFilled += quantity * price;
+    order.updateTime = currentTime();
+    if (order.filledQuantity < order.quantity - QUANTITY_EPSILON) {
+        order.status = OrderStatus::PARTIALLY_FILLED;
+    }
+
+    double feeRate = maker ? config_.makerFeeRate : config_.takerFeeRate;
+    balance_ -= quantity * price * state.spec.contractSize * feeRate;
+    updatePosition(state, order.side, quantity, price);
+    matchedEvents_++;
+    accountDirty_ = true;
+
+    queueNotification(Notification::Kind::FILL, pending_->fillIds.add(order.orderId), quantity, price);
+
+    if (order.status == OrderStatus::PARTIALLY_FILLED) {
+        queueOrderUpdate(order);
+    }
+    queuePositionUpdate(state);
+}
+
+void SimulatedExchangeAPI::updatePosition(SymbolState& state, OrderSide side, Volume quantity, Price price) {
+    Position& position = state.position;
+    double contractSize = state.spec.contractSize;
+
+    if (position.quantity <= QUANTITY_EPSILON) {
+        position.side = side;
+        position.quantity = quantity;
+        position.averagePrice = price;
+        position.openTime = currentTime();
+    } else if (position.side == side) {
+        Volume total = position.quantity + quantity;
+        position.averagePrice = (position.averagePrice * position.quantity + price * quantity) / total;
+        position.quantity = total;
+    } else {
+        Volume closed = std::min(position.quantity, quantity);
+        double direction = position.isLong() ? 1.0 : -1.0;
+        double pnl = (price - position.averagePrice) * closed * contractSize * direction;
+
+        position.realizedPnL += pnl;
+        realizedPnL_ += pnl;
+        balance_ += pnl;
+        position.quantity -= closed;
+
+        Volume flipped = quantity - closed;
+        if (flipped > QUANTITY_EPSILON) {
+            position.side = side;
+            position.quantity = flipped;
+            position.averagePrice = price;
+            position.openTime = currentTime();
+        } else if (position.quantity <= QUANTITY_EPSILON) {
+            position.quantity = 0;
+            position.averagePrice = 0;
+        }
+    }
+
+    position.currentPrice = state.hasTick ? state.lastTick.last : price;
+    double direction = position.isLong() ? 1.0 : -1.0;
+    position.unrealizedPnL = (position.currentPrice - position.averagePrice) *
+                             position.quantity * contractSize * direction;
+    position.updateTime = currentTime();
+}
+
+AccountInfo SimulatedExchangeAPI::buildAccountInfo() const {
+    AccountInfo info;
+    info.balance = balance_;
+    info.realizedPnL = realizedPnL_;
+    info.currency = config_.currency;
+    info.lastUpdate = currentTime();
+
+    for (const auto& pair : symbols_) {
+        const SymbolState& state = *pair.second;
+        const Position& position = state.position;
+        if (position.quantity <= QUANTITY_EPSILON) {
+            continue;
+        }
+        info.unrealizedPnL += position.unrealizedPnL;
+        info.margin += position.quantity * position.currentPrice *
+                       state.spec.contractSize * state.spec.marginRequirement;
+    }
+
+    info.equity = info.balance + info.unrealizedPnL;
+    info.freeMargin = info.equity - info.margin;
+    info.marginLevel = info.margin > 0 ? info.equity / info.margin * 100.0 : 0;
+    return info;
+}
+
+void SimulatedExchangeAPI::queueOrderUpdate(const Order& order) {
+    queueNotification(Notification::Kind::ORDER, pending_->orders.add(order));
+}
+
+void SimulatedExchangeAPI::queuePositionUpdate(const SymbolState& state) {
+    queueNotification(Notification::Kind::POSITION, pending_->positions.add(state.position));
+}
+
+void SimulatedExchangeAPI::markBookDirty(SymbolState& state) {
+    if (!state.bookDirty) {
+        state.bookDirty = true;
+        dirtyBooks_.push_back(&state);
+    }
+}
+
+void SimulatedExchangeAPI::publishBook(SymbolState& state) {
+    const SimulatedOrderBook& book = state.book;
+    bookBids_.clear();
+    bookAsks_.clear();
+
+    for (size_t i = 0; i < std::min(book.getLevelCount(OrderSide::BUY), PUBLISHED_DEPTH); ++i) {
+        const auto& level = book.getLevel(OrderSide::BUY, i);
+        bookBids_.emplace_back(book.toPrice(level.priceTicks), level.visibleQuantity);
+    }
+    for (size_t i = 0; i < std::min(book.getLevelCount(OrderSide::SELL), PUBLISHED_DEPTH); ++i) {
+        const auto& level = book.getLevel(OrderSide::SELL, i);
+        bookAsks_.emplace_back(book.toPrice(level.priceTicks), level.visibleQuantity);
+    }
+
+    // The tick quote stands for the rest of the market's liquidity
+    if (state.hasTick) {
+        Volume quoteQuantity = config_.tickLiquidity > 0
+            ? std::max<Volume>(0, config_.tickLiquidity - state.tickLiquidityUsed)
+            : state.lastTick.volume;
+        auto addQuote = [&](std::vector<PriceLevel>& levels, Price price) {
+            if (price <= 0 || quoteQuantity <= 0) {
+                return;
+            }
+            Price rounded = book.toPrice(book.toTicks(price));
+            for (auto& level : levels) {
+                if (level.price == rounded) {
+                    level.quantity += quoteQuantity;
+                    return;
+                }
+            }
+            levels.emplace_back(rounded, quoteQuantity);
+        };
+        addQuote(bookBids_, state.lastTick.bid);
+        addQuote(bookAsks_, state.lastTick.ask);
+    }
+
+    getOrCreateOrderBook(state.spec.symbol).applySnapshot(bookBids_, bookAsks_, ++bookUpdateId_);
+
+    queueNotification(Notification::Kind::BOOK, pending_->books.add(state.spec.symbol));
+}
+
+TimePoint SimulatedExchangeAPI::currentTime() const {
+    return clockStarted_ ? clock_ : std::chrono::system_clock::now();
+}
+
+void SimulatedExchangeAPI::queueNotification(Notification::Kind kind, uint32_t index, Volume quantity, Price price) {
+    pending_->records.push_back({kind, index, quantity, price});
+}
+
+std::unique_ptr<SimulatedExchangeAPI::NotificationBuffer> SimulatedExchangeAPI::takeNotifications() {
+    for (SymbolState* state : dirtyBooks_) {
+        state->bookDirty = false;
+        publishBook(*state);
+    }
+    dirtyBooks_.clear();
+
+    if (accountDirty_) {
+        pending_->account = buildAccountInfo();
+        queueNotification(Notification::Kind::ACCOUNT, 0);
+        accountDirty_ = false;
+    }
+
+    std::unique_ptr<NotificationBuffer> spare;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        if (!spareBuffers_.empty()) {
+            spare = std::move(spareBuffers_.back());
+            spareBuffers_.pop_back();
+        }
+    }
+    if (!spare) {
+        spare = std::make_unique<NotificationBuffer>();  // Another thread is still dispatching
+    }
+    pending_.swap(spare);
+    return spare;
+}
+
+void SimulatedExchangeAPI::dispatchNotifications(std::unique_ptr<NotificationBuffer> notifications) {
+    if (!notifications) {
+        return;
+    }
+
+    const NotificationBuffer& buffer = *notifications;
+    for (const auto& record : buffer.records) {
+        switch (record.kind) {
+            case Notification::Kind::TICK:
+                notifyTick(buffer.ticks[record.index]);
+                break;
+            case Notification::Kind::FILL:
+                notifyFill(buffer.fillIds[record.index], record.quantity, record.price);
+                break;
+            case Notification::Kind::ORDER:
+                notifyOrderUpdate(buffer.orders[record.index]);
+                break;
+            case Notification::Kind::POSITION:
+                publishPosition(buffer.positions[record.index]);
+                break;
+            case Notification::Kind::ACCOUNT:
+                publishAccount(buffer.account);
+                break;
+            case Notification::Kind::BOOK:
+                notifyOrderBookUpdate(buffer.books[record.index]);
+                break;
+        }
+    }
+
+    notifications->clear();
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    spareBuffers_.push_back(std::move(notifications));
+}
+
+void SimulatedExchangeAPI::NotificationBuffer::clear() {
+    records.clear();
+    ticks.clear();
+    fillIds.clear();
+    orders.clear();
+    positions.clear();
+    books.clear();
+}
+
+} // namespace MasterMind
@@ -0,0 +1,296 @@
+#include "api/SimulatedOrderBook.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MasterMind {
+
+namespace {
+constexpr Volume QUANTITY_EPSILON = 1e-12;
+}
+
+SimulatedOrderBook::SimulatedOrderBook(double tickSize, size_t expectedOrders)
+    : tickSize_(tickSize > 0 ? tickSize : 0.01), orderCount_(0) {
+    nodes_.reserve(expectedOrders);
+    freeList_.reserve(expectedOrders);
+    bids_.reserve(1024);
+    asks_.reserve(1024);
+}
+
+SimulatedOrderBook::Handle SimulatedOrderBook::add(uint64_t tag, OrderSide side, int64_t priceTicks,
+                                                   Volume quantity, Volume displayQuantity) {
+    if (quantity <= QUANTITY_EPSILON) {
+        return INVALID_HANDLE;
+    }
+
+    uint32_t index = allocateNode();
+    Node& node = nodes_[index];
+    node.tag = tag;
+    node.priceTicks = priceTicks;
+    node.remaining = quantity;
+    node.displayQuantity = (displayQuantity > QUANTITY_EPSILON && displayQuantity < quantity)
+                               ? displayQuantity : 0;
+    node.visibleRemaining = node.displayQuantity > 0 ? node.displayQuantity : quantity;
+    node.side = side;
+    node.active = true;
+
+    Level& level = findOrInsertLevel(side, priceTicks);
+    appendToLevel(level, index);
+    level.visibleQuantity += node.visibleRemaining;
+    orderCount_++;
+
+    return makeHandle(index, node.generation);
+}
+
+bool SimulatedOrderBook::cancel(Handle handle) {
+    Node* node = resolve(handle);
+    if (!node) {
+        return false;
+    }
+
+    uint32_t index = static_cast<uint32_t>(handle & 0xFFFFFFFFu);
+    Level* level = findLevel(node->side, node->priceTicks);
+    if (level) {
+        level->visibleQuantity -= node->visibleRemaining;
+        unlinkFromLevel(*level, index);
+        if (level->orderCount == 0) {
+            eraseLevel(node->side, node->priceTicks);
+        }
+    }
+
+    releaseNode(index);
+    return true;
+}
+
+bool SimulatedOrderBook::reduce(Handle handle, Volume newQuantity) {
+    Node* node = resolve(handle);
+    if (!node || newQuantity >= node->remaining) {
+        return false;
+    }
+    if (newQuantity <= QUANTITY_EPSILON) {
+        return cancel(handle);
+    }
+
+    node->remaining = newQuantity;
+
+    Volume newVisible = std::min(node->visibleRemaining, newQuantity);
+    Level* level = findLevel(node->side, node->priceTicks);
+    if (level) {
+        level->visibleQuantity -= (node->visibleRemaining - newVisible);
+    }
+    node->visibleRemaining = newVisible;
+    return true;
+}
+
+Volume SimulatedOrderBook::match(OrderSide side, int64_t limitTicks, Volume quantity,
+                                 std::vector<Fill>& fills) {
+    OrderSide makerSide = (side == OrderSide::BUY) ? OrderSide::SELL : OrderSide::BUY;
+    std::vector<Level>& levels = sideLevels(makerSide);
+    Volume matched = 0;
+
+    while (quantity > QUANTITY_EPSILON && !levels.empty()) {
+        Level& level = levels.back();
+        bool crosses = (side == OrderSide::BUY) ? level.priceTicks <= limitTicks
+                                                : level.priceTicks >= limitTicks;
+        if (!crosses) {
+            break;
+        }
+
+        while (quantity > QUANTITY_EPSILON && level.head != NIL) {
+            uint32_t index = level.head;
+            Node& maker = nodes_[index];
+
+            Volume tradeQuantity = std::min(quantity, maker.visibleRemaining);
+            maker.visibleRemaining -= tradeQuantity;
+            maker.remaining -= tradeQuantity;
+            level.visibleQuantity -= tradeQuantity;
+            quantity -= tradeQuantity;
+            matched += tradeQuantity;
+
+            bool complete = maker.remaining <= QUANTITY_EPSILON;
+            fills.push_back({makeHandle(index, maker.generation), maker.tag,
+                             level.priceTicks, tradeQuantity, complete});
+
+            if (complete) {
+                unlinkFromLevel(level, index);
+                releaseNode(index);
+            } else if (maker.visibleRemaining <= QUANTITY_EPSILON) {
+                // Iceberg refill goes to the back of the queue
+                maker.visibleRemaining = std::min(maker.displayQuantity, maker.remaining);
+                level.visibleQuantity += maker.visibleRemaining;
+                unlinkFromLevel(level, index);
+                appendToLevel(level, index);
+            }
+        }
+
+        if (level.orderCount == 0) {
+            levels.pop_back();
+        }
+    }
+
+    return matched;
+}
+
+bool SimulatedOrderBook::contains(Handle handle) const {
+    return resolve(handle) != nullptr;
+}
+
+Volume SimulatedOrderBook::getRemaining(Handle handle) const {
+    const Node* node = resolve(handle);
+    return node ? node->remaining : 0;
+}
+
+uint64_t SimulatedOrderBook::getTag(Handle handle) const {
+    const Node* node = resolve(handle);
+    return node ? node->tag : 0;
+}
+
+int64_t SimulatedOrderBook::getPriceTicks(Handle handle) const {
+    const Node* node = resolve(handle);
+    return node ? node->priceTicks : 0;
+}
+
+size_t SimulatedOrderBook::getLevelCount(OrderSide side) const {
+    return sideLevels(side).size();
+}
+
+const SimulatedOrderBook::Level& SimulatedOrderBook::getLevel(OrderSide side, size_t index) const {
+    const auto& levels = sideLevels(side);
+    return levels[levels.size() - 1 - index];
+}
+
+int64_t SimulatedOrderBook::toTicks(Price price) const {
+    return static_cast<int64_t>(std::llround(price / tickSize_));
+}
+
+void SimulatedOrderBook::clear() {
+    nodes_.clear();
+    freeList_.clear();
+    bids_.clear();
+    asks_.clear();
+    orderCount_ = 0;
+}
+
+// Private methods
+uint32_t SimulatedOrderBook::allocateNode() {
+    if (!freeList_.empty()) {
+        uint32_t index = freeList_.back();
+        freeList_.pop_back();
+        return index;
+    }
+
+    nodes_.emplace_back();
+    Node& node = nodes_.back();
+    node.generation = 1;
+    node.prev = NIL;
+    node.next = NIL;
+    node.active = false;
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void SimulatedOrderBook::releaseNode(uint32_t index) {
+    Node& node = nodes_[index];
+    node.active = false;
+    node.generation++;
+    if (node.generation == 0) {
+        node.generation = 1;
+    }
+    freeList_.push_back(index);
+    orderCount_--;
+}
+
+SimulatedOrderBook::Node* SimulatedOrderBook::resolve(Handle handle) {
+    uint32_t index = static_cast<uint32_t>(handle & 0xFFFFFFFFu);
+    uint32_t generation = static_cast<uint32_t>(handle >> 32);
+    if (handle == INVALID_HANDLE || index >= nodes_.size()) {
+        return nullptr;
+    }
+    Node& node = nodes_[index];
+    return (node.active && node.generation == generation) ? &node : nullptr;
+}
+
+const SimulatedOrderBook::Node* SimulatedOrderBook::resolve(Handle handle) const {
+    return const_cast<SimulatedOrderBook*>(this)->resolve(handle);
+}
+
+SimulatedOrderBook::Level* SimulatedOrderBook::findLevel(OrderSide side, int64_t priceTicks) {
+    auto& levels = sideLevels(side);
+
+    // Scan from the top of book first - almost all activity is near the touch
+    for (size_t i = levels.size(), steps = 0; i > 0 && steps < 8; --i, ++steps) {
+        if (levels[i - 1].priceTicks == priceTicks) {
+            return &levels[i - 1];
+        }
+    }
+
+    auto it = (side == OrderSide::BUY)
+        ? std::lower_bound(levels.begin(), levels.end(), priceTicks,
+                           [](const Level& l, int64_t p) { return l.priceTicks < p; })
+        : std::lower_bound(levels.begin(), levels.end(), priceTicks,
+                           [](const Level& l, int64_t p) { return l.priceTicks > p; });
+    return (it != levels.end() && it->priceTicks == priceTicks) ? &*it : nullptr;
+}
+
+SimulatedOrderBook::Level& SimulatedOrderBook::findOrInsertLevel(OrderSide side, int64_t priceTicks) {
+    auto& levels = sideLevels(side);
+
+    auto it = (side == OrderSide::BUY)
+        ? std::lower_bound(levels.begin(), levels.end(), priceTicks,
+                           [](const Level& l, int64_t p) { return l.priceTicks < p; })
+        : std::lower_bound(levels.begin(), levels.end(), priceTicks,
+                           [](const Level& l, int64_t p) { return l.priceTicks > p; });
+    if (it != levels.end() && it->priceTicks == priceTicks) {
+        return *it;
+    }
+
+    Level level{priceTicks, 0, 0, NIL, NIL};
+    return *levels.insert(it, level);
+}
+
+void SimulatedOrderBook::eraseLevel(OrderSide side, int64_t priceTicks) {
+    auto& levels = sideLevels(side);
+    if (!levels.empty() && levels.back().priceTicks == priceTicks) {
+        levels.pop_back();
+        return;
+    }
+
+    Level* level = findLevel(side, priceTicks);
+    if (level) {
+        levels.erase(levels.begin() + (level - levels.data()));
+    }
+}
+
+void SimulatedOrderBook::appendToLevel(Level& level, uint32_t index) {
+    Node& node = nodes_[index];
+    node.prev = level.tail;
+    node.next = NIL;
+    if (level.tail != NIL) {
+        nodes_[level.tail].next = index;
+    } else {
+        level.head = index;
+    }
+    level.tail = index;
+    level.orderCount++;
+}
+
+void SimulatedOrderBook::unlinkFromLevel(Level& level, uint32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        level.head = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    } else {
+        level.tail = node.prev;
+    }
+    node.prev = NIL;
+    node.next = NIL;
+    level.orderCount--;
+}
+
+SimulatedOrderBook::Handle SimulatedOrderBook::makeHandle(uint32_t index, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) | index;
+}
+
+} // namespace MasterMind
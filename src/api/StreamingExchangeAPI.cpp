@@ -0,0 +1,233 @@
+#include "api/StreamingExchangeAPI.h"
+#include "api/VenueCodec.h"
+#include <algorithm>
+#include <iostream>
+
+namespace MasterMind {
+
+StreamingExchangeAPI::StreamingExchangeAPI(Exchange exchangeType)
+    : ExchangeAPI(exchangeType), WebSocketExchangeAPI(exchangeType) {
+    setCodec(VenueCodec::create(exchangeType));
+    name_ = codec_ ? codec_->getName() : "Unknown venue";
+    std::cout << "StreamingExchangeAPI initialized for " << name_ << std::endl;
+}
+
+StreamingExchangeAPI::~StreamingExchangeAPI() {
+    disconnectWebSocket();
+}
+
+bool StreamingExchangeAPI::connect() {
+    std::lock_guard<std::mutex> lock(connectionMutex_);
+    sessionWanted_ = true;
+    if (!codec_) {
+        setError("No market data codec for " + name_);
+        return false;
+    }
+    connected_ = true;  // The stream itself opens on the first subscription
+    std::cout << "Connected to " << name_ << " (market data only)" << std::endl;
+    return true;
+}
+
+bool StreamingExchangeAPI::disconnect() {
+    std::lock_guard<std::mutex> lock(connectionMutex_);
+    sessionWanted_ = false;
+    if (!connected_) {
+        return true;
+    }
+    connected_ = false;
+    disconnectWebSocket();
+    {
+        std::lock_guard<std::mutex> streamLock(streamMutex_);
+        streamSymbols_.clear();  // Subscribe again after reconnecting
+    }
+    std::cout << "Disconnected from " << name_ << std::endl;
+    return true;
+}
+
+bool StreamingExchangeAPI::isConnected() const {
+    return connected_;
+}
+
+bool StreamingExchangeAPI::reconnect() {
+    disconnect();
+    return connect();
+}
+
+bool StreamingExchangeAPI::authenticate(const std::string&, const std::string&, const std::string&) {
+    return unsupported("Authentication");
+}
+
+bool StreamingExchangeAPI::isAuthenticated() const {
+    return false;
+}
+
+bool StreamingExchangeAPI::subscribeMarketData(const std::vector<Symbol>& symbols) {
+    if (!connected_) {
+        setError("Not connected to " + name_);
+        return false;
+    }
+    return subscribeStreams(symbols);
+}
+
+bool StreamingExchangeAPI::unsubscribeMarketData(const std::vector<Symbol>& symbols) {
+    return unsubscribeStreams(symbols);
+}
+
+Tick StreamingExchangeAPI::getLastTick(const Symbol& symbol) const {
+    Tick tick(symbol, 0.0, 0.0, 0.0, 0.0, TimePoint());
+    getStreamTick(symbol, tick);
+    return tick;
+}
+
+std::vector<OHLC> StreamingExchangeAPI::getHistoricalData(const Symbol&, TimePoint, TimePoint, Duration) const {
+    unsupported("Historical data");
+    return {};
+}
+
+OrderId StreamingExchangeAPI::placeOrder(const Order&) {
+    unsupported("Order entry");
+    return "";
+}
+
+bool StreamingExchangeAPI::cancelOrder(const OrderId&) {
+    return unsupported("Order entry");
+}
+
+bool StreamingExchangeAPI::modifyOrder(const OrderId&, const Order&) {
+    return unsupported("Order entry");
+}
+
+Order StreamingExchangeAPI::getOrder(const OrderId&) const {
+    unsupported("Order queries");
+    return Order{};
+}
+
+std::vector<Order> StreamingExchangeAPI::getActiveOrders() const {
+    return {};
+}
+
+std::vector<Order> StreamingExchangeAPI::getOrderHistory(const Symbol&, int) const {
+    return {};
+}
+
+std::vector<Position> StreamingExchangeAPI::getPositions() const {
+    return {};
+}
+
+Position StreamingExchangeAPI::getPosition(const Symbol& symbol) const {
+    Position position{};
+    position.symbol = symbol;
+    return position;
+}
+
+bool StreamingExchangeAPI::closePosition(const Symbol&) {
+    return unsupported("Order entry");
+}
+
+bool StreamingExchangeAPI::closeAllPositions() {
+    return unsupported("Order entry");
+}
+
+AccountInfo StreamingExchangeAPI::getAccountInfo() const {
+    return accountCache_.getAccountInfo();  // Empty: nothing publishes to it
+}
+
+double StreamingExchangeAPI::getBalance() const {
+    return 0.0;
+}
+
+double StreamingExchangeAPI::getEquity() const {
+    return 0.0;
+}
+
+double StreamingExchangeAPI::getMargin() const {
+    return 0.0;
+}
+
+double StreamingExchangeAPI::getFreeMargin() const {
+    return 0.0;
+}
+
+std::vector<InstrumentSpec> StreamingExchangeAPI::getInstruments() const {
+    // Copies the whole list: hold the snapshot rather than rely on the retire grace
+    return instrumentRegistry_.acquire()->getInstruments();
+}
+
+InstrumentSpec StreamingExchangeAPI::getInstrumentSpec(const Symbol& symbol) const {
+    std::shared_ptr<const InstrumentSnapshot> snapshot = instrumentRegistry_.acquire();
+    const InstrumentSpec* spec = snapshot->find(symbol);
+    return spec ? *spec : InstrumentSpec{};
+}
+
+bool StreamingExchangeAPI::isSymbolAvailable(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    return std::find(streamSymbols_.begin(), streamSymbols_.end(), symbol) != streamSymbols_.end();
+}
+
+std::string StreamingExchangeAPI::getExchangeName() const {
+    return name_;
+}
+
+std::vector<AssetClass> StreamingExchangeAPI::getSupportedAssetClasses() const {
+    return {AssetClass::CRYPTO};
+}
+
+bool StreamingExchangeAPI::isTradingSessionOpen() const {
+    return true;  // Crypto venues trade around the clock
+}
+
+TimePoint StreamingExchangeAPI::getNextTradingSession() const {
+    return std::chrono::system_clock::now();
+}
+
+std::vector<std::pair<TimePoint, TimePoint>> StreamingExchangeAPI::getTradingSessions() const {
+    auto now = std::chrono::system_clock::now();
+    return {{now, now + std::chrono::hours(24)}};
+}
+
+double StreamingExchangeAPI::calculateTradingFee(const Order&) const {
+    return 0.0;
+}
+
+double StreamingExchangeAPI::calculateMarginRequirement(const Order& order) const {
+    return order.quantity * order.price;
+}
+
+std::string StreamingExchangeAPI::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    return lastError_;
+}
+
+void StreamingExchangeAPI::clearErrors() {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    lastError_.clear();
+}
+
+// Protected methods
+bool StreamingExchangeAPI::validateSymbol(const Symbol& symbol) const {
+    return !symbol.empty();
+}
+
+bool StreamingExchangeAPI::validateOrder(const Order&) const {
+    return false;
+}
+
+void StreamingExchangeAPI::onWebSocketConnect() {
+    std::cout << name_ << " market data stream connected" << std::endl;
+}
+
+void StreamingExchangeAPI::onWebSocketDisconnect() {
+    std::cout << name_ << " market data stream disconnected" << std::endl;
+}
+
+void StreamingExchangeAPI::onWebSocketError(const std::string& error) {
+    setError("Market data stream: " + error);
+}
+
+// Private methods
+bool StreamingExchangeAPI::unsupported(const char* operation) const {
+    setError(std::string(operation) + " is not supported by the " + name_ + " adapter (market data only)");
+    return false;
+}
+
+} // namespace MasterMind
@@ -0,0 +1,140 @@
+#include "api/VenueCodec.h"
+#include "api/JsonParser.h"
+#include <algorithm>
+#include <cctype>
+
+namespace MasterMind {
+
+std::unique_ptr<VenueCodec> VenueCodec::create(Exchange exchange) {
+    switch (exchange) {
+        case Exchange::BINANCE:
+            return std::make_unique<BinanceCodec>();
+        case Exchange::DERIBIT:
+            return std::make_unique<DeribitCodec>();
+        case Exchange::COINBASE:
+            return std::make_unique<CoinbaseCodec>();
+        default:
+            return nullptr;
+    }
+}
+
+std::string BinanceCodec::buildStreamUrl(const std::string& endpoint, const std::vector<Symbol>& symbols) const {
+    std::string path;
+    for (const auto& symbol : symbols) {
+        for (const auto& stream : streamNames(symbol)) {
+            path += (path.empty() ? "" : "/") + stream;
+        }
+    }
+    return endpoint + "/stream?streams=" + path;
+}
+
+std::string BinanceCodec::buildSubscription(const std::vector<Symbol>& symbols, bool subscribe,
+                                            uint64_t requestId) const {
+    std::string params;
+    for (const auto& symbol : symbols) {
+        for (const auto& stream : streamNames(symbol)) {
+            params += (params.empty() ? "\"" : ",\"") + stream + "\"";
+        }
+    }
+    return std::string("{\"method\":\"") + (subscribe ? "SUBSCRIBE" : "UNSUBSCRIBE") + "\",\"params\":[" + params +
+           "],\"id\":" + std::to_string(requestId) + "}";
+}
+
+bool BinanceCodec::decode(const char* data, size_t length, const EventSink& sink) {
+    std::string_view stream;
+    std::string_view payload;
+    if (!BinanceMessageParser::parseStreamEnvelope(data, length, stream, payload)) {
+        return false;  // Subscription replies ({"result":null,"id":1}) carry no stream
+    }
+    std::string_view kind = stream.substr(stream.find('@') + 1);
+    VenueEvent& event = event_;
+    event.venue = Exchange::BINANCE;
+
+    if (kind == "bookTicker") {
+        if (!BinanceMessageParser::parseTicker(payload.data(), payload.size(), tick_)) {
+            return false;
+        }
+        event.reset(VenueEvent::Type::TICK);
+        event.symbol = tick_.symbol;
+        event.time = tick_.timestamp;
+        event.bid = tick_.bid;
+        event.ask = tick_.ask;
+        event.price = tick_.last;
+    } else if (kind.compare(0, 5, "depth") == 0) {
+        if (!BinanceMessageParser::parseDepthUpdate(payload.data(), payload.size(), depth_)) {
+            return false;
+        }
+        event.reset(VenueEvent::Type::BOOK_UPDATE);
+        event.symbol = depth_.symbol;
+        event.time = depth_.eventTime == TimePoint() ? std::chrono::system_clock::now() : depth_.eventTime;
+        event.bids.swap(depth_.bids);  // Swapped back below, so both keep their capacity
+        event.asks.swap(depth_.asks);
+        event.firstSequence = depth_.firstUpdateId;
+        event.sequence = depth_.finalUpdateId;
+        event.previousSequence = depth_.previousUpdateId;
+        sink(event);
+        event.bids.swap(depth_.bids);
+        event.asks.swap(depth_.asks);
+        return true;
+    } else if (kind == "trade" || kind == "aggTrade") {
+        if (!BinanceMessageParser::parseTrade(payload.data(), payload.size(), trade_)) {
+            return false;
+        }
+        event.reset(VenueEvent::Type::TRADE);
+        event.symbol = trade_.symbol;
+        event.time = trade_.tradeTime;
+        event.price = trade_.price;
+        event.quantity = trade_.quantity;
+        event.side = trade_.buyerIsMaker ? OrderSide::SELL : OrderSide::BUY;
+        event.sequence = trade_.tradeId;
+    } else {
+        return false;
+    }
+    sink(event);
+    return true;
+}
+
+bool BinanceCodec::buildSnapshotRequest(const Symbol& symbol, std::string& path, std::string& query) const {
+    path = "/api/v3/depth";
+    query = "symbol=" + symbol + "&limit=1000";
+    return true;
+}
+
+bool BinanceCodec::decodeSnapshot(const Symbol& symbol, const char* data, size_t length, VenueEvent& snapshot) const {
+    // {"lastUpdateId":N,"bids":[["price","qty"],...],"asks":[...]}
+    JsonReader reader(data, length);
+    if (!reader.enterObject()) {
+        return false;
+    }
+    snapshot.reset(VenueEvent::Type::BOOK_SNAPSHOT);
+    snapshot.venue = Exchange::BINANCE;
+    snapshot.symbol = symbol;
+    snapshot.time = std::chrono::system_clock::now();
+    std::string_view key;
+    while (reader.nextKey(key)) {
+        if (key == "lastUpdateId") {
+            reader.readUnsigned(snapshot.sequence);
+        } else if (key == "bids" || key == "asks") {
+            std::vector<PriceLevel>& levels = key == "bids" ? snapshot.bids : snapshot.asks;
+            PriceLevel level;
+            if (reader.enterArray()) {
+                while (reader.nextElement() && reader.readPair(level.price, level.quantity)) {
+                    levels.push_back(level);
+                }
+            }
+        } else {
+            reader.skipValue();
+        }
+    }
+    snapshot.firstSequence = snapshot.sequence;
+    return reader.ok() && snapshot.sequence != 0;  // Error bodies carry code and msg instead
+}
+
+std::vector<std::string> BinanceCodec::streamNames(const Symbol& symbol) {
+    std::string name = symbol;
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return {name + "@bookTicker", name + "@depth@100ms", name + "@trade"};
+}
+
+} // namespace MasterMind
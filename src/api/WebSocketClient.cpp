@@ -0,0 +1,734 @@
+#include "api/WebSocketClient.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#ifdef __linux__
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#ifdef SSL_ENABLED
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#endif
+
+namespace MasterMind {
+
+namespace {
+constexpr size_t MAX_HANDSHAKE_SIZE = 16 * 1024;
+constexpr uint16_t CLOSE_NORMAL = 1000;
+
+// Single-writer counters: a plain load and store, no locked instruction
+inline void bump(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+}
+
+WebSocketClient::WebSocketClient(EventReactor* reactor)
+    : socket_(-1), epoll_(-1), ssl_(nullptr), sslContext_(nullptr), reactor_(reactor),
+      attached_(false), flushPosted_(false), dispatching_(false), connected_(false), closeRequested_(false), receiveStart_(0), receiveEnd_(0),
+      fragmentOpcode_(WebSocketOpcode::TEXT), inFragment_(false), writeOffset_(0),
+      maskGenerator_(std::random_device{}()), writeInterest_(false),
+      messagesReceived_(0), bytesReceived_(0), framesReceived_(0), messagesSent_(0),
+      pingsReceived_(0), readCalls_(0), maxDispatchMicros_(0), lastReceiveTicks_(0) {
+}
+
+WebSocketClient::~WebSocketClient() {
+    disconnect();
+    if (reactor_) {
+        reactor_->runSync([]() {});  // Flush tasks posted before the disconnect have run
+    }
+    ownReactor_.reset();
+}
+
+bool WebSocketClient::connect(const std::string& url, Duration timeout) {
+    disconnect();
+    url_ = url;
+
+    Endpoint endpoint;
+    if (!parseUrl(url, endpoint)) {
+        setError("Invalid WebSocket URL: " + url);
+        return false;
+    }
+
+#ifndef __linux__
+    setError("WebSocket transport requires Linux (epoll)");
+    return false;
+#else
+    receiveBuffer_.resize(std::max(receiveBuffer_.size(), INITIAL_BUFFER_SIZE));
+    receiveStart_ = receiveEnd_ = 0;
+    fragments_.clear();
+    inFragment_ = false;
+    {
+        std::lock_guard<std::mutex> lock(sendMutex_);
+        pendingSend_.clear();
+    }
+    writing_.clear();
+    writeOffset_ = 0;
+    writeInterest_ = false;
+    closeRequested_ = false;
+
+    TimePoint deadline = std::chrono::system_clock::now() + timeout;
+    if (!openSocket(endpoint, deadline) ||
+        (endpoint.secure && !startTls(endpoint, deadline)) ||
+        !performHandshake(endpoint, deadline)) {
+        closeSocket();
+        return false;
+    }
+
+    if (!reactor_) {
+        ownReactor_ = std::make_unique<EventReactor>("websocket");
+        if (!ownReactor_->start()) {
+            ownReactor_.reset();
+            setError("Cannot start WebSocket I/O reactor");
+            closeSocket();
+            return false;
+        }
+        reactor_ = ownReactor_.get();
+    }
+
+    // The handshake epoll only waited on the socket; the reactor takes it from here
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, socket_, nullptr);
+    lastReceiveTicks_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    connected_ = true;
+    std::cout << "WebSocket connected: " << url << std::endl;
+    if (connectHandler_) {
+        connectHandler_();  // Subscriptions sent here are flushed once attached
+    }
+
+    attached_ = true;
+    if (!reactor_->add(socket_, EPOLLIN, [this](uint32_t events) { onSocketEvent(events); })) {
+        attached_ = false;
+        setError("Cannot register WebSocket with reactor " + reactor_->getName());
+        dispatchDisconnect();
+        closeSocket();
+        return false;
+    }
+    reactor_->post([this]() {
+        if (attached_) {
+            dispatching_ = true;
+            bool open = processFrames();  // Frames that arrived with the handshake
+            dispatching_ = false;
+            finishIo(open);
+        }
+    });
+    return true;
+#endif
+}
+
+void WebSocketClient::disconnect() {
+    if (attached_) {
+        closeRequested_ = true;
+        if (reactor_->inReactorThread()) {
+            if (dispatching_) {
+                return;  // From one of our handlers: detached when it returns
+            }
+            detach(true);
+        } else {
+            reactor_->runSync([this]() { detach(true); });
+        }
+    }
+    closeSocket();
+}
+
+void WebSocketClient::clearHandlers() {
+    EventReactor::Task clear = [this]() {
+        messageHandler_ = nullptr;
+        connectHandler_ = nullptr;
+        disconnectHandler_ = nullptr;
+        errorHandler_ = nullptr;
+    };
+    if (reactor_) {
+        reactor_->runSync(clear);
+    } else {
+        clear();
+    }
+}
+
+bool WebSocketClient::isConnected() const {
+    return connected_;
+}
+
+bool WebSocketClient::send(const std::string& text) {
+    if (!connected_ || closeRequested_) {
+        return false;
+    }
+    queueFrame(WebSocketOpcode::TEXT, text.data(), text.size());
+    messagesSent_.fetch_add(1, std::memory_order_relaxed);
+    scheduleFlush();
+    return true;
+}
+
+bool WebSocketClient::ping() {
+    if (!connected_ || closeRequested_) {
+        return false;
+    }
+    queueFrame(WebSocketOpcode::PING, "", 0);
+    scheduleFlush();
+    return true;
+}
+
+std::chrono::steady_clock::time_point WebSocketClient::getLastReceiveTime() const {
+    return std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(lastReceiveTicks_.load(std::memory_order_relaxed)));
+}
+
+WebSocketStats WebSocketClient::getStats() const {
+    WebSocketStats stats;
+    stats.messagesReceived = messagesReceived_.load(std::memory_order_relaxed);
+    stats.bytesReceived = bytesReceived_.load(std::memory_order_relaxed);
+    stats.framesReceived = framesReceived_.load(std::memory_order_relaxed);
+    stats.messagesSent = messagesSent_.load(std::memory_order_relaxed);
+    stats.pingsReceived = pingsReceived_.load(std::memory_order_relaxed);
+    stats.readCalls = readCalls_.load(std::memory_order_relaxed);
+    stats.maxDispatchMicros = maxDispatchMicros_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string WebSocketClient::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    return lastError_;
+}
+
+// Private methods
+bool WebSocketClient::parseUrl(const std::string& url, Endpoint& endpoint) {
+    size_t hostStart;
+    if (url.compare(0, 5, "ws://") == 0) {
+        endpoint.secure = false;
+        hostStart = 5;
+    } else if (url.compare(0, 6, "wss://") == 0) {
+        endpoint.secure = true;
+        hostStart = 6;
+    } else {
+        return false;
+    }
+
+    size_t pathStart = url.find('/', hostStart);
+    std::string authority = url.substr(hostStart, pathStart == std::string::npos ? std::string::npos : pathStart - hostStart);
+    endpoint.path = pathStart == std::string::npos ? "/" : url.substr(pathStart);
+
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos && authority.find(']', colon) == std::string::npos) {
+        endpoint.host = authority.substr(0, colon);
+        endpoint.port = authority.substr(colon + 1);
+    } else {
+        endpoint.host = authority;
+        endpoint.port = endpoint.secure ? "443" : "80";
+    }
+    if (endpoint.host.size() > 2 && endpoint.host.front() == '[' && endpoint.host.back() == ']') {
+        endpoint.host = endpoint.host.substr(1, endpoint.host.size() - 2);  // IPv6 literal
+    }
+    return !endpoint.host.empty() && !endpoint.port.empty();
+}
+
+bool WebSocketClient::performHandshake(const Endpoint& endpoint, TimePoint deadline) {
+    std::string key = WebSocketProtocol::generateKey();
+    bool defaultPort = endpoint.port == (endpoint.secure ? "443" : "80");
+    std::string request = "GET " + endpoint.path + " HTTP/1.1\r\n"
+                          "Host: " + endpoint.host + (defaultPort ? "" : ":" + endpoint.port) + "\r\n"
+                          "Upgrade: websocket\r\n"
+                          "Connection: Upgrade\r\n"
+                          "Sec-WebSocket-Key: " + key + "\r\n"
+                          "Sec-WebSocket-Version: 13\r\n\r\n";
+
+    size_t written = 0;
+    while (written < request.size()) {
+        long n = writeSome(request.data() + written, request.size() - written);
+        if (n < 0) {
+            setError("WebSocket handshake write failed");
+            return false;
+        }
+        if (n == 0 && !waitFor(true, deadline)) {
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    // Read the response head; frames sent right behind it stay buffered
+    size_t headEnd = std::string::npos;
+    while (headEnd == std::string::npos) {
+        long n = readSome(&receiveBuffer_[receiveEnd_], MAX_HANDSHAKE_SIZE - receiveEnd_);
+        if (n < 0) {
+            setError("WebSocket connection closed during handshake");
+            return false;
+        }
+        if (n == 0) {
+            if (!waitFor(false, deadline)) {
+                return false;
+            }
+            continue;
+        }
+        receiveEnd_ += static_cast<size_t>(n);
+        std::string_view received(receiveBuffer_.data(), receiveEnd_);
+        headEnd = received.find("\r\n\r\n");
+        if (headEnd == std::string::npos && receiveEnd_ >= MAX_HANDSHAKE_SIZE) {
+            setError("WebSocket handshake response too large");
+            return false;
+        }
+    }
+
+    std::string head(receiveBuffer_.data(), headEnd + 2);
+    receiveStart_ = headEnd + 4;
+    if (head.compare(0, 12, "HTTP/1.1 101") != 0) {
+        setError("WebSocket upgrade rejected: " + head.substr(0, head.find("\r\n")));
+        return false;
+    }
+    if (WebSocketProtocol::findHeader(head, "Sec-WebSocket-Accept") != WebSocketProtocol::computeAccept(key)) {
+        setError("WebSocket upgrade returned an invalid Sec-WebSocket-Accept");
+        return false;
+    }
+    return true;
+}
+
+bool WebSocketClient::processFrames() {
+    while (receiveStart_ < receiveEnd_) {
+        WebSocketFrameHeader header;
+        int headerLength = WebSocketProtocol::parseHeader(&receiveBuffer_[receiveStart_],
+                                                          receiveEnd_ - receiveStart_, header);
+        if (headerLength < 0) {
+            setError("Malformed WebSocket frame");
+            return false;
+        }
+        if (headerLength == 0) {
+            break;
+        }
+        if (header.payloadLength > MAX_MESSAGE_SIZE) {
+            setError("WebSocket frame exceeds " + std::to_string(MAX_MESSAGE_SIZE) + " bytes");
+            return false;
+        }
+
+        size_t length = static_cast<size_t>(header.payloadLength);
+        size_t frameLength = static_cast<size_t>(headerLength) + length;
+        if (receiveEnd_ - receiveStart_ < frameLength) {
+            makeRoom(frameLength);  // Partial frame: make sure the rest fits
+            break;
+        }
+
+        char* payload = &receiveBuffer_[receiveStart_ + headerLength];
+        if (header.masked) {
+            WebSocketProtocol::unmask(payload, length, header.mask);
+        }
+        receiveStart_ += frameLength;
+        bump(framesReceived_);
+        if (!handleFrame(header, payload, length)) {
+            return false;
+        }
+    }
+
+    if (receiveStart_ == receiveEnd_) {
+        receiveStart_ = receiveEnd_ = 0;
+    }
+    return true;
+}
+
+bool WebSocketClient::handleFrame(const WebSocketFrameHeader& header, char* payload, size_t length) {
+    switch (header.opcode) {
+        case WebSocketOpcode::TEXT:
+        case WebSocketOpcode::BINARY:
+            if (inFragment_) {
+                setError("WebSocket data frame inside a fragmented message");
+                return false;
+            }
+            if (header.fin) {
+                dispatchMessage(payload, length);  // Straight from the receive buffer
+            } else {
+                inFragment_ = true;
+                fragmentOpcode_ = header.opcode;
+                fragments_.assign(payload, length);
+            }
+            return true;
+
+        case WebSocketOpcode::CONTINUATION:
+            if (!inFragment_ || fragments_.size() + length > MAX_MESSAGE_SIZE) {
+                setError("Unexpected or oversized WebSocket continuation frame");
+                return false;
+            }
+            fragments_.append(payload, length);
+            if (header.fin) {
+                inFragment_ = false;
+                dispatchMessage(fragments_.data(), fragments_.size());
+            }
+            return true;
+
+        case WebSocketOpcode::PING:
+            bump(pingsReceived_);
+            queueFrame(WebSocketOpcode::PONG, payload, length);
+            return true;
+
+        case WebSocketOpcode::PONG:
+            return true;
+
+        case WebSocketOpcode::CLOSE:
+            // Echo the status code, then drop the connection
+            queueFrame(WebSocketOpcode::CLOSE, payload, std::min<size_t>(length, 2));
+            flushWrites();
+            if (!closeRequested_) {
+                setError("WebSocket closed by server");
+            }
+            return false;
+    }
+    return true;
+}
+
+void WebSocketClient::dispatchMessage(const char* data, size_t length) {
+    bump(messagesReceived_);
+    bump(bytesReceived_, length);
+    if (!messageHandler_) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    messageHandler_(data, length);
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    if (micros > maxDispatchMicros_.load(std::memory_order_relaxed)) {
+        maxDispatchMicros_.store(micros, std::memory_order_relaxed);
+    }
+}
+
+void WebSocketClient::makeRoom(size_t frameLength) {
+    if (receiveStart_ + frameLength <= receiveBuffer_.size()) {
+        return;
+    }
+    if (frameLength > receiveBuffer_.size()) {
+        receiveBuffer_.resize(std::max(receiveBuffer_.size() * 2, frameLength));
+    }
+    if (receiveStart_ > 0) {
+        std::memmove(receiveBuffer_.data(), receiveBuffer_.data() + receiveStart_, receiveEnd_ - receiveStart_);
+        receiveEnd_ -= receiveStart_;
+        receiveStart_ = 0;
+    }
+}
+
+bool WebSocketClient::flushWrites() {
+    for (;;) {
+        if (writeOffset_ == writing_.size()) {
+            writing_.clear();
+            writeOffset_ = 0;
+            std::lock_guard<std::mutex> lock(sendMutex_);
+            if (pendingSend_.empty()) {
+                break;
+            }
+            writing_.swap(pendingSend_);
+        }
+
+        long n = writeSome(writing_.data() + writeOffset_, writing_.size() - writeOffset_);
+        if (n < 0) {
+            setError("WebSocket write failed");
+            return false;
+        }
+        if (n == 0) {
+            updateWriteInterest(true);  // Resume when the socket drains
+            return true;
+        }
+        writeOffset_ += static_cast<size_t>(n);
+    }
+    updateWriteInterest(false);
+    return true;
+}
+
+void WebSocketClient::queueFrame(WebSocketOpcode opcode, const char* payload, size_t length) {
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    uint32_t key = maskGenerator_();
+    uint8_t mask[4];
+    std::memcpy(mask, &key, sizeof(mask));
+    WebSocketProtocol::appendFrame(pendingSend_, opcode, payload, length, mask);
+}
+
+void WebSocketClient::scheduleFlush() {
+    if (!reactor_ || flushPosted_.exchange(true, std::memory_order_acq_rel)) {
+        return;  // One flush task covers every frame queued before it runs
+    }
+    reactor_->post([this]() {
+        flushPosted_.store(false, std::memory_order_release);
+        if (attached_) {
+            finishIo(true);
+        }
+    });
+}
+
+void WebSocketClient::finishIo(bool open) {
+    if (open) {
+        open = flushWrites();
+    }
+    if (!open) {
+        detach(false);
+    } else if (closeRequested_) {
+        detach(true);
+    }
+}
+
+void WebSocketClient::detach(bool sendClose) {
+    if (!attached_) {
+        return;
+    }
+    if (sendClose) {
+        uint8_t status[2] = {static_cast<uint8_t>(CLOSE_NORMAL >> 8), static_cast<uint8_t>(CLOSE_NORMAL & 0xFF)};
+        queueFrame(WebSocketOpcode::CLOSE, reinterpret_cast<const char*>(status), sizeof(status));
+        flushWrites();
+    }
+    attached_ = false;
+    reactor_->remove(socket_);
+    dispatchDisconnect();  // Last: the handler may reconnect or destroy this client
+}
+
+void WebSocketClient::setError(const std::string& error) {
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        lastError_ = error;
+    }
+    std::cout << "WebSocket error (" << url_ << "): " << error << std::endl;
+    if (errorHandler_) {
+        errorHandler_(error);
+    }
+}
+
+void WebSocketClient::dispatchDisconnect() {
+    if (connected_.exchange(false)) {
+        std::cout << "WebSocket disconnected: " << url_ << std::endl;
+        if (disconnectHandler_) {
+            disconnectHandler_();
+        }
+    }
+}
+
+#ifdef __linux__
+
+bool WebSocketClient::openSocket(const Endpoint& endpoint, TimePoint deadline) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    int status = getaddrinfo(endpoint.host.c_str(), endpoint.port.c_str(), &hints, &addresses);
+    if (status != 0) {
+        setError("Cannot resolve " + endpoint.host + ": " + gai_strerror(status));
+        return false;
+    }
+
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    bool connected = false;
+    for (addrinfo* address = addresses; address && !connected; address = address->ai_next) {
+        socket_ = ::socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                           address->ai_protocol);
+        if (socket_ < 0) {
+            continue;
+        }
+        int one = 1;
+        setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        epoll_event event{};
+        event.events = EPOLLOUT;
+        event.data.fd = socket_;
+        epoll_ctl(epoll_, EPOLL_CTL_ADD, socket_, &event);
+
+        if (::connect(socket_, address->ai_addr, address->ai_addrlen) == 0 ||
+            (errno == EINPROGRESS && waitFor(true, deadline))) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            getsockopt(socket_, SOL_SOCKET, SO_ERROR, &error, &length);
+            connected = error == 0;
+            if (!connected) {
+                setError("Cannot connect to " + endpoint.host + ":" + endpoint.port + ": " + std::strerror(error));
+            }
+        }
+        if (!connected) {
+            epoll_ctl(epoll_, EPOLL_CTL_DEL, socket_, nullptr);
+            ::close(socket_);
+            socket_ = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    return connected;
+}
+
+bool WebSocketClient::startTls(const Endpoint& endpoint, TimePoint deadline) {
+#ifdef SSL_ENABLED
+    SSL_CTX* context = SSL_CTX_new(TLS_client_method());
+    sslContext_ = context;
+    if (!context) {
+        setError("Cannot create TLS context");
+        return false;
+    }
+    SSL_CTX_set_default_verify_paths(context);
+    SSL_CTX_set_verify(context, SSL_VERIFY_PEER, nullptr);
+
+    SSL* ssl = SSL_new(context);
+    ssl_ = ssl;
+    SSL_set_fd(ssl, socket_);
+    SSL_set_tlsext_host_name(ssl, endpoint.host.c_str());
+    SSL_set1_host(ssl, endpoint.host.c_str());
+    SSL_set_mode(ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+    for (;;) {
+        int result = SSL_connect(ssl);
+        if (result == 1) {
+            return true;
+        }
+        int error = SSL_get_error(ssl, result);
+        if (error == SSL_ERROR_WANT_READ) {
+            if (!waitFor(false, deadline)) return false;
+        } else if (error == SSL_ERROR_WANT_WRITE) {
+            if (!waitFor(true, deadline)) return false;
+        } else {
+            char reason[256];
+            ERR_error_string_n(ERR_get_error(), reason, sizeof(reason));
+            setError(std::string("TLS handshake failed: ") + reason);
+            return false;
+        }
+    }
+#else
+    setError("wss:// requires a build with OpenSSL (SSL_ENABLED)");
+    return false;
+#endif
+}
+
+bool WebSocketClient::waitFor(bool writable, TimePoint deadline) {
+    epoll_event event{};
+    event.events = writable ? EPOLLOUT : EPOLLIN;
+    event.data.fd = socket_;
+    epoll_ctl(epoll_, EPOLL_CTL_MOD, socket_, &event);
+
+    for (;;) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::system_clock::now());
+        if (remaining.count() <= 0) {
+            setError("WebSocket connect timed out");
+            return false;
+        }
+        epoll_event ready;
+        int n = epoll_wait(epoll_, &ready, 1, static_cast<int>(remaining.count()));
+        if (n > 0) {
+            return true;
+        }
+        if (n < 0 && errno != EINTR) {
+            setError(std::string("epoll_wait failed: ") + std::strerror(errno));
+            return false;
+        }
+    }
+}
+
+void WebSocketClient::closeSocket() {
+#ifdef SSL_ENABLED
+    if (ssl_) {
+        SSL_free(static_cast<SSL*>(ssl_));
+    }
+    if (sslContext_) {
+        SSL_CTX_free(static_cast<SSL_CTX*>(sslContext_));
+    }
+#endif
+    ssl_ = nullptr;
+    sslContext_ = nullptr;
+    for (int* fd : {&socket_, &epoll_}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+    connected_ = false;
+}
+
+void WebSocketClient::onSocketEvent(uint32_t events) {
+    if (!attached_) {
+        return;
+    }
+    bool open = true;
+    dispatching_ = true;
+    if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        open = readAvailable();
+    }
+    dispatching_ = false;
+    finishIo(open);
+}
+
+bool WebSocketClient::readAvailable() {
+    for (;;) {
+        if (receiveEnd_ == receiveBuffer_.size()) {
+            makeRoom(receiveBuffer_.size() - receiveStart_ + 1);
+        }
+        long n = readSome(&receiveBuffer_[receiveEnd_], receiveBuffer_.size() - receiveEnd_);
+        if (n == 0) {
+            return true;
+        }
+        if (n < 0) {
+            if (!closeRequested_) {
+                setError("WebSocket connection lost");
+            }
+            return false;
+        }
+        bump(readCalls_);
+        lastReceiveTicks_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        receiveEnd_ += static_cast<size_t>(n);
+        if (!processFrames()) {
+            return false;
+        }
+        if (closeRequested_) {
+            return true;  // finishIo() sends the close frame
+        }
+    }
+}
+
+void WebSocketClient::updateWriteInterest(bool enable) {
+    if (enable == writeInterest_ || socket_ < 0) {
+        return;
+    }
+    writeInterest_ = enable;
+    reactor_->modify(socket_, enable ? EPOLLIN | EPOLLOUT : EPOLLIN);
+}
+
+long WebSocketClient::readSome(char* buffer, size_t length) {
+#ifdef SSL_ENABLED
+    if (ssl_) {
+        int n = SSL_read(static_cast<SSL*>(ssl_), buffer, static_cast<int>(std::min<size_t>(length, INT32_MAX)));
+        if (n > 0) {
+            return n;
+        }
+        int error = SSL_get_error(static_cast<SSL*>(ssl_), n);
+        return (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE) ? 0 : -1;
+    }
+#endif
+    ssize_t n = ::recv(socket_, buffer, length, 0);
+    if (n > 0) {
+        return static_cast<long>(n);
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return 0;
+    }
+    return -1;  // Orderly shutdown or error
+}
+
+long WebSocketClient::writeSome(const char* buffer, size_t length) {
+#ifdef SSL_ENABLED
+    if (ssl_) {
+        int n = SSL_write(static_cast<SSL*>(ssl_), buffer, static_cast<int>(std::min<size_t>(length, INT32_MAX)));
+        if (n > 0) {
+            return n;
+        }
+        int error = SSL_get_error(static_cast<SSL*>(ssl_), n);
+        return (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE) ? 0 : -1;
+    }
+#endif
+    ssize_t n = ::send(socket_, buffer, length, MSG_NOSIGNAL);
+    if (n >= 0) {
+        return static_cast<long>(n);
+    }
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+}
+
+#else
+
+bool WebSocketClient::openSocket(const Endpoint&, TimePoint) { return false; }
+bool WebSocketClient::startTls(const Endpoint&, TimePoint) { return false; }
+bool WebSocketClient::waitFor(bool, TimePoint) { return false; }
+void WebSocketClient::closeSocket() { connected_ = false; }
+void WebSocketClient::onSocketEvent(uint32_t) { }
+bool WebSocketClient::readAvailable() { return false; }
+void WebSocketClient::updateWriteInterest(bool) { }
+long WebSocketClient::readSome(char*, size_t) { return -1; }
+long WebSocketClient::writeSome(const char*, size_t) { return -1; }
+
+#endif
+
+} // namespace MasterMind
@@ -0,0 +1,240 @@
+#include "api/WebSocketProtocol.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <random>
+
+namespace MasterMind {
+
+namespace {
+const char* const HANDSHAKE_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+uint32_t rotateLeft(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// SHA-1, used only for Sec-WebSocket-Accept
+void sha1(const std::string& message, unsigned char digest[20]) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+    std::string padded = message;
+    uint64_t bitLength = static_cast<uint64_t>(message.size()) * 8;
+    padded.push_back(static_cast<char>(0x80));
+    while (padded.size() % 64 != 56) {
+        padded.push_back('\0');
+    }
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        padded.push_back(static_cast<char>((bitLength >> shift) & 0xFF));
+    }
+
+    for (size_t block = 0; block < padded.size(); block += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(&padded[block + i * 4]);
+            w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t temp = rotateLeft(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotateLeft(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    for (int i = 0; i < 5; ++i) {
+        digest[i * 4] = static_cast<unsigned char>(h[i] >> 24);
+        digest[i * 4 + 1] = static_cast<unsigned char>(h[i] >> 16);
+        digest[i * 4 + 2] = static_cast<unsigned char>(h[i] >> 8);
+        digest[i * 4 + 3] = static_cast<unsigned char>(h[i]);
+    }
+}
+
+bool isKnownOpcode(uint8_t opcode) {
+    return opcode <= 0x2 || (opcode >= 0x8 && opcode <= 0xA);
+}
+}
+
+int WebSocketProtocol::parseHeader(const char* data, size_t length, WebSocketFrameHeader& header) {
+    if (length < 2) {
+        return 0;
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+
+    // No extensions are negotiated, so the reserved bits must be clear
+    if (bytes[0] & 0x70 || !isKnownOpcode(bytes[0] & 0x0F)) {
+        return -1;
+    }
+    header.fin = (bytes[0] & 0x80) != 0;
+    header.opcode = static_cast<WebSocketOpcode>(bytes[0] & 0x0F);
+    header.masked = (bytes[1] & 0x80) != 0;
+
+    size_t position = 2;
+    uint64_t payloadLength = bytes[1] & 0x7F;
+    if (payloadLength == 126) {
+        if (length < position + 2) {
+            return 0;
+        }
+        payloadLength = (uint64_t(bytes[2]) << 8) | bytes[3];
+        position += 2;
+    } else if (payloadLength == 127) {
+        if (length < position + 8) {
+            return 0;
+        }
+        payloadLength = 0;
+        for (int i = 0; i < 8; ++i) {
+            payloadLength = (payloadLength << 8) | bytes[2 + i];
+        }
+        if (payloadLength >> 63) {
+            return -1;
+        }
+        position += 8;
+    }
+
+    if (static_cast<uint8_t>(header.opcode) >= 0x8 && (!header.fin || payloadLength > MAX_CONTROL_PAYLOAD)) {
+        return -1;  // Control frames are never fragmented and stay small
+    }
+
+    if (header.masked) {
+        if (length < position + 4) {
+            return 0;
+        }
+        std::memcpy(header.mask, bytes + position, 4);
+        position += 4;
+    }
+
+    header.payloadLength = payloadLength;
+    header.headerLength = position;
+    return static_cast<int>(position);
+}
+
+void WebSocketProtocol::unmask(char* payload, size_t length, const uint8_t mask[4]) {
+    uint32_t key32;
+    std::memcpy(&key32, mask, 4);
+    uint64_t key64 = (uint64_t(key32) << 32) | key32;
+
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, payload + i, 8);
+        word ^= key64;
+        std::memcpy(payload + i, &word, 8);
+    }
+    for (; i < length; ++i) {
+        payload[i] = static_cast<char>(payload[i] ^ mask[i & 3]);
+    }
+}
+
+void WebSocketProtocol::appendFrame(std::string& out, WebSocketOpcode opcode, const char* payload, size_t length,
+                                    const uint8_t* mask) {
+    out.push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));
+
+    uint8_t maskBit = mask ? 0x80 : 0x00;
+    if (length < 126) {
+        out.push_back(static_cast<char>(maskBit | length));
+    } else if (length <= 0xFFFF) {
+        out.push_back(static_cast<char>(maskBit | 126));
+        out.push_back(static_cast<char>((length >> 8) & 0xFF));
+        out.push_back(static_cast<char>(length & 0xFF));
+    } else {
+        out.push_back(static_cast<char>(maskBit | 127));
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out.push_back(static_cast<char>((uint64_t(length) >> shift) & 0xFF));
+        }
+    }
+
+    if (mask) {
+        out.append(reinterpret_cast<const char*>(mask), 4);
+    }
+    size_t payloadStart = out.size();
+    out.append(payload, length);
+    if (mask) {
+        unmask(&out[payloadStart], length, mask);  // XOR is its own inverse
+    }
+}
+
+std::string WebSocketProtocol::generateKey() {
+    std::random_device device;
+    unsigned char nonce[16];
+    for (auto& byte : nonce) {
+        byte = static_cast<unsigned char>(device() & 0xFF);
+    }
+    return base64Encode(nonce, sizeof(nonce));
+}
+
+std::string WebSocketProtocol::computeAccept(const std::string& key) {
+    unsigned char digest[20];
+    sha1(key + HANDSHAKE_GUID, digest);
+    return base64Encode(digest, sizeof(digest));
+}
+
+std::string WebSocketProtocol::base64Encode(const unsigned char* data, size_t length) {
+    static const char* const alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((length + 2) / 3 * 4);
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t group = uint32_t(data[i]) << 16;
+        if (i + 1 < length) group |= uint32_t(data[i + 1]) << 8;
+        if (i + 2 < length) group |= data[i + 2];
+        out.push_back(alphabet[(group >> 18) & 0x3F]);
+        out.push_back(alphabet[(group >> 12) & 0x3F]);
+        out.push_back(i + 1 < length ? alphabet[(group >> 6) & 0x3F] : '=');
+        out.push_back(i + 2 < length ? alphabet[group & 0x3F] : '=');
+    }
+    return out;
+}
+
+std::string WebSocketProtocol::findHeader(const std::string& head, const std::string& name) {
+    size_t lineStart = head.find("\r\n");
+    while (lineStart != std::string::npos) {
+        lineStart += 2;
+        size_t lineEnd = head.find("\r\n", lineStart);
+        if (lineEnd == std::string::npos) {
+            lineEnd = head.size();
+        }
+        size_t colon = head.find(':', lineStart);
+        if (colon != std::string::npos && colon < lineEnd && colon - lineStart == name.size() &&
+            std::equal(name.begin(), name.end(), head.begin() + lineStart, [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+            })) {
+            size_t valueStart = colon + 1;
+            while (valueStart < lineEnd && (head[valueStart] == ' ' || head[valueStart] == '\t')) {
+                ++valueStart;
+            }
+            size_t valueEnd = lineEnd;
+            while (valueEnd > valueStart && (head[valueEnd - 1] == ' ' || head[valueEnd - 1] == '\t')) {
+                --valueEnd;
+            }
+            return head.substr(valueStart, valueEnd - valueStart);
+        }
+        lineStart = lineEnd < head.size() ? lineEnd : std::string::npos;
+    }
+    return std::string();
+}
+
+} // namespace MasterMind
@@ -0,0 +1,456 @@
+#include "api/WebSocketReplayServer.h"
+#include "api/WebSocketProtocol.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace MasterMind {
+
+namespace {
+constexpr size_t MAX_REQUEST_SIZE = 16 * 1024;
+constexpr int MAX_EVENTS = 16;
+
+bool waitUntil(const std::function<bool()>& condition, Duration timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+}
+
+WebSocketReplayServer::WebSocketReplayServer(const ReplayConfig& config)
+    : config_(config), listenSocket_(-1), epoll_(-1), wake_(-1), port_(0), running_(false),
+      messagesSent_(0), clientCount_(0), timesClaimed_(false) {
+    offsets_.push_back(0);
+}
+
+WebSocketReplayServer::~WebSocketReplayServer() {
+    stop();
+}
+
+bool WebSocketReplayServer::loadCapture(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        setError("Cannot open capture file: " + path);
+        return false;
+    }
+
+    std::vector<std::string> messages;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        messages.push_back(line);
+    }
+    if (messages.empty()) {
+        setError("Capture file holds no messages: " + path);
+        return false;
+    }
+
+    setMessages(messages);
+    std::cout << "Loaded " << messages.size() << " replay messages from " << path << std::endl;
+    return true;
+}
+
+void WebSocketReplayServer::setMessages(const std::vector<std::string>& messages) {
+    frames_.clear();
+    offsets_.assign(1, 0);
+    for (const auto& message : messages) {
+        WebSocketProtocol::appendFrame(frames_, WebSocketOpcode::TEXT, message.data(), message.size());
+        offsets_.push_back(frames_.size());
+    }
+}
+
+std::string WebSocketReplayServer::getUrl(const std::string& path) const {
+    return "ws://127.0.0.1:" + std::to_string(port_) + (path.empty() || path[0] != '/' ? "/" : "") + path;
+}
+
+bool WebSocketReplayServer::waitForClients(size_t count, Duration timeout) const {
+    return waitUntil([&] { return getClientCount() >= count; }, timeout);
+}
+
+bool WebSocketReplayServer::waitForMessagesSent(uint64_t count, Duration timeout) const {
+    return waitUntil([&] { return getMessagesSent() >= count; }, timeout);
+}
+
+std::vector<std::string> WebSocketReplayServer::getRequestPaths() const {
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    return requestPaths_;
+}
+
+std::vector<std::string> WebSocketReplayServer::getReceivedMessages() const {
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    return receivedMessages_;
+}
+
+std::vector<WebSocketReplayServer::SteadyTime> WebSocketReplayServer::getSendTimes() const {
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    return sendTimes_;
+}
+
+std::string WebSocketReplayServer::getLastError() const {
+    std::lock_guard<std::mutex> lock(recordMutex_);
+    return lastError_;
+}
+
+// Private methods
+uint64_t WebSocketReplayServer::dueMessages(const Session& session, SteadyTime now) const {
+    uint64_t total = static_cast<uint64_t>(getMessageCount()) * config_.loops;
+    if (config_.messagesPerSecond <= 0) {
+        return total;
+    }
+    double elapsed = std::chrono::duration<double>(now - session.startTime).count();
+    uint64_t due = static_cast<uint64_t>(elapsed * config_.messagesPerSecond) + 1;
+    return std::min(due, total);
+}
+
+bool WebSocketReplayServer::hasPacedWork() const {
+    if (config_.messagesPerSecond <= 0) {
+        return false;
+    }
+    uint64_t total = static_cast<uint64_t>(getMessageCount()) * config_.loops;
+    return std::any_of(sessions_.begin(), sessions_.end(), [total](const Session& session) {
+        return session.upgraded && !session.closing && session.nextMessage < total;
+    });
+}
+
+bool WebSocketReplayServer::handleHandshake(Session& session) {
+    size_t headEnd = session.input.find("\r\n\r\n");
+    if (headEnd == std::string::npos) {
+        return session.input.size() < MAX_REQUEST_SIZE;
+    }
+
+    std::string head = session.input.substr(0, headEnd + 2);
+    session.input.erase(0, headEnd + 4);
+
+    std::string key = WebSocketProtocol::findHeader(head, "Sec-WebSocket-Key");
+    size_t pathStart = head.find(' ');
+    size_t pathEnd = pathStart == std::string::npos ? std::string::npos : head.find(' ', pathStart + 1);
+    if (head.compare(0, 4, "GET ") != 0 || key.empty() || pathEnd == std::string::npos) {
+        session.control = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        session.closing = true;
+        session.peerClosed = true;
+        return true;
+    }
+
+    session.control = "HTTP/1.1 101 Switching Protocols\r\n"
+                      "Upgrade: websocket\r\n"
+                      "Connection: Upgrade\r\n"
+                      "Sec-WebSocket-Accept: " + WebSocketProtocol::computeAccept(key) + "\r\n\r\n";
+    session.upgraded = true;
+    session.startTime = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(recordMutex_);
+        requestPaths_.push_back(head.substr(pathStart + 1, pathEnd - pathStart - 1));
+        if (config_.recordSendTimes && !timesClaimed_) {
+            timesClaimed_ = true;
+            session.recordTimes = true;
+        }
+    }
+    clientCount_.fetch_add(1, std::memory_order_relaxed);
+    return handleClientFrames(session);
+}
+
+bool WebSocketReplayServer::handleClientFrames(Session& session) {
+    size_t position = 0;
+    while (position < session.input.size()) {
+        WebSocketFrameHeader header;
+        int headerLength = WebSocketProtocol::parseHeader(&session.input[position], session.input.size() - position, header);
+        if (headerLength < 0 || (headerLength > 0 && !header.masked)) {
+            setError("Malformed or unmasked client frame");
+            return false;
+        }
+        size_t frameLength = static_cast<size_t>(headerLength) + static_cast<size_t>(header.payloadLength);
+        if (headerLength == 0 || session.input.size() - position < frameLength) {
+            break;
+        }
+
+        char* payload = &session.input[position + headerLength];
+        size_t length = static_cast<size_t>(header.payloadLength);
+        WebSocketProtocol::unmask(payload, length, header.mask);
+        position += frameLength;
+
+        switch (header.opcode) {
+            case WebSocketOpcode::TEXT: {
+                std::lock_guard<std::mutex> lock(recordMutex_);
+                receivedMessages_.emplace_back(payload, length);
+                break;
+            }
+            case WebSocketOpcode::PING:
+                WebSocketProtocol::appendFrame(session.control, WebSocketOpcode::PONG, payload, length);
+                break;
+            case WebSocketOpcode::CLOSE:
+                if (!session.closing) {
+                    WebSocketProtocol::appendFrame(session.control, WebSocketOpcode::CLOSE, payload, std::min<size_t>(length, 2));
+                    session.closing = true;
+                }
+                session.peerClosed = true;
+                break;
+            default:
+                break;  // Binary, continuation and pong frames are ignored
+        }
+    }
+    session.input.erase(0, position);
+    return true;
+}
+
+void WebSocketReplayServer::setError(const std::string& error) {
+    {
+        std::lock_guard<std::mutex> lock(recordMutex_);
+        lastError_ = error;
+    }
+    std::cout << "Replay server error: " << error << std::endl;
+}
+
+#ifdef __linux__
+
+bool WebSocketReplayServer::start() {
+    if (running_) {
+        return true;
+    }
+
+    listenSocket_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    setsockopt(listenSocket_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config_.port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressLength = sizeof(address);
+    if (listenSocket_ < 0 ||
+        ::bind(listenSocket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenSocket_, 16) != 0 ||
+        getsockname(listenSocket_, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) {
+        setError(std::string("Cannot listen on 127.0.0.1:") + std::to_string(config_.port) + ": " + std::strerror(errno));
+        stop();
+        return false;
+    }
+    port_ = ntohs(address.sin_port);
+
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenSocket_;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, listenSocket_, &event);
+    event.data.fd = wake_;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, wake_, &event);
+
+    running_ = true;
+    thread_ = std::thread(&WebSocketReplayServer::serverLoop, this);
+    std::cout << "Replay server listening on " << getUrl() << " (" << getMessageCount() << " messages)" << std::endl;
+    return true;
+}
+
+void WebSocketReplayServer::stop() {
+    if (thread_.joinable()) {
+        running_ = false;
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wake_, &one, sizeof(one));
+        (void)ignored;
+        thread_.join();
+    }
+    running_ = false;
+    for (int* fd : {&listenSocket_, &epoll_, &wake_}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void WebSocketReplayServer::serverLoop() {
+    epoll_event events[MAX_EVENTS];
+    while (running_) {
+        int n = epoll_wait(epoll_, events, MAX_EVENTS, hasPacedWork() ? 1 : -1);
+        if (n < 0 && errno != EINTR) {
+            setError(std::string("epoll_wait failed: ") + std::strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wake_) {
+                uint64_t count;
+                ssize_t ignored = ::read(wake_, &count, sizeof(count));
+                (void)ignored;
+            } else if (fd == listenSocket_) {
+                acceptClients();
+            } else if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                auto it = std::find_if(sessions_.begin(), sessions_.end(),
+                                       [fd](const Session& session) { return session.socket == fd; });
+                if (it != sessions_.end() && !readClient(*it)) {
+                    closeSession(*it);
+                }
+            }
+        }
+
+        // Sockets are edge-triggered, so every session gets a write pass each round
+        SteadyTime now = std::chrono::steady_clock::now();
+        for (auto& session : sessions_) {
+            if (session.socket >= 0 && !writeClient(session, now)) {
+                closeSession(session);
+            }
+        }
+        sessions_.erase(std::remove_if(sessions_.begin(), sessions_.end(),
+                                       [](const Session& session) { return session.socket < 0; }),
+                        sessions_.end());
+    }
+
+    for (auto& session : sessions_) {
+        closeSession(session);
+    }
+    sessions_.clear();
+}
+
+void WebSocketReplayServer::acceptClients() {
+    for (;;) {
+        int fd = ::accept4(listenSocket_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+        event.data.fd = fd;
+        epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event);
+
+        Session session;
+        session.socket = fd;
+        sessions_.push_back(std::move(session));
+    }
+}
+
+bool WebSocketReplayServer::readClient(Session& session) {
+    char buffer[4096];
+    for (;;) {
+        ssize_t n = ::recv(session.socket, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            session.input.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            break;
+        }
+        return false;  // Client went away
+    }
+    return session.upgraded ? handleClientFrames(session) : handleHandshake(session);
+}
+
+bool WebSocketReplayServer::writeClient(Session& session, SteadyTime now) {
+    size_t count = getMessageCount();
+    uint64_t total = static_cast<uint64_t>(count) * config_.loops;
+
+    for (;;) {
+        // Control frames go out between messages, never inside one
+        if (session.partial == 0 && session.controlOffset < session.control.size()) {
+            ssize_t n = ::send(session.socket, session.control.data() + session.controlOffset,
+                               session.control.size() - session.controlOffset, MSG_NOSIGNAL);
+            if (n < 0) {
+                return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+            }
+            session.controlOffset += static_cast<size_t>(n);
+            if (session.controlOffset < session.control.size()) {
+                return true;
+            }
+            session.control.clear();
+            session.controlOffset = 0;
+        }
+        if (session.peerClosed && session.control.empty()) {
+            return false;
+        }
+        if (!session.upgraded || session.closing) {
+            return true;
+        }
+
+        uint64_t due = dueMessages(session, now);
+        if (session.nextMessage >= due) {
+            if (session.nextMessage == total && config_.closeWhenDone) {
+                const char status[2] = {static_cast<char>(1000 >> 8), static_cast<char>(1000 & 0xFF)};
+                WebSocketProtocol::appendFrame(session.control, WebSocketOpcode::CLOSE, status, sizeof(status));
+                session.closing = true;
+                continue;
+            }
+            return true;
+        }
+
+        // Write the due messages of this pass straight from the framed capture
+        size_t index = static_cast<size_t>(session.nextMessage % count);
+        size_t limit = static_cast<size_t>(std::min<uint64_t>(due - session.nextMessage, count - index));
+        size_t begin = offsets_[index] + session.partial;
+        size_t end = offsets_[index + limit];
+        ssize_t n = ::send(session.socket, frames_.data() + begin, end - begin, MSG_NOSIGNAL);
+        if (n < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+
+        size_t position = begin + static_cast<size_t>(n);
+        auto boundary = std::upper_bound(offsets_.begin() + index + 1, offsets_.begin() + index + limit + 1, position);
+        size_t completed = static_cast<size_t>(boundary - (offsets_.begin() + index + 1));
+        session.nextMessage += completed;
+        session.partial = position - offsets_[index + completed];
+        messagesSent_.fetch_add(completed, std::memory_order_relaxed);
+
+        if (session.recordTimes && completed > 0) {
+            SteadyTime sent = std::chrono::steady_clock::now();
+            std::lock_guard<std::mutex> lock(recordMutex_);
+            sendTimes_.insert(sendTimes_.end(), completed, sent);
+        }
+        if (position < end) {
+            return true;  // Socket full; EPOLLOUT resumes
+        }
+    }
+}
+
+void WebSocketReplayServer::closeSession(Session& session) {
+    if (session.socket < 0) {
+        return;
+    }
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, session.socket, nullptr);
+    ::close(session.socket);
+    session.socket = -1;
+    if (session.upgraded) {
+        clientCount_.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+#else
+
+bool WebSocketReplayServer::start() {
+    setError("Replay server requires Linux (epoll)");
+    return false;
+}
+
+void WebSocketReplayServer::stop() { running_ = false; }
+void WebSocketReplayServer::serverLoop() { }
+void WebSocketReplayServer::acceptClients() { }
+bool WebSocketReplayServer::readClient(Session&) { return false; }
+bool WebSocketReplayServer::writeClient(Session&, SteadyTime) { return false; }
+void WebSocketReplayServer::closeSession(Session& session) { session.socket = -1; }
+
+#endif
+
+} // namespace MasterMind
@@ -186,6 +186,11 @@ ConfigManager::ExchangeConfig ConfigManager::getDefaultExchangeConfig(Exchange e
             config.rateLimitRequests = 50;
             config.rateLimitWindow = 1;
             break;
+        case Exchange::SIMULATED:
+            config.baseUrl = "sim://local";
+            config.rateLimitRequests = 1000000;
+            config.rateLimitWindow = 1;
+            break;
     }
     
     return config;
@@ -0,0 +1,425 @@
+#include "core/CounterLedger.h"
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace MasterMind {
+
+namespace {
+constexpr uint32_t SNAPSHOT_MAGIC = 0x53434D4D;  // "MMCS"
+constexpr uint32_t SNAPSHOT_VERSION = 2;  // 2 added dailyRiskUsed
+constexpr uint32_t MAX_RECORD_SIZE = 1 << 20;
+constexpr size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+bool syncDirectory(const std::string& directory) {
+    int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+
+// CRC-32 (IEEE 802.3, reflected)
+const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320u : 0);
+            }
+            entries[i] = crc;
+        }
+        return entries;
+    }();
+    return table;
+}
+
+uint32_t crc32(const char* data, size_t length) {
+    const auto& table = crcTable();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void putString(std::string& out, const std::string& value) {
+    put<uint32_t>(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+void putTime(std::string& out, TimePoint time) {
+    put<int64_t>(out, std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+}
+
+// Bounds-checked decoder; any overrun latches ok to false
+struct Reader {
+    const char* position;
+    const char* end;
+    bool ok;
+
+    Reader(const char* data, size_t length) : position(data), end(data + length), ok(true) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (static_cast<size_t>(end - position) < sizeof(T)) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+
+    std::string getString() {
+        uint32_t length = get<uint32_t>();
+        if (!ok || static_cast<size_t>(end - position) < length) {
+            ok = false;
+            return std::string();
+        }
+        std::string value(position, length);
+        position += length;
+        return value;
+    }
+
+    TimePoint getTime() {
+        std::chrono::nanoseconds since(get<int64_t>());
+        return TimePoint(std::chrono::duration_cast<TimePoint::duration>(since));
+    }
+};
+
+void encodeCounter(std::string& out, const CounterRecord& counter) {
+    put<int32_t>(out, counter.counterNumber);
+    put<int32_t>(out, counter.ordersCount);
+    put<uint32_t>(out, static_cast<uint32_t>(counter.orderIds.size()));
+    for (const auto& orderId : counter.orderIds) {
+        putString(out, orderId);
+    }
+    put<double>(out, counter.initialCapital);
+    put<double>(out, counter.currentCapital);
+    put<double>(out, counter.totalPnL);
+    put<double>(out, counter.totalCharges);
+    putTime(out, counter.startTime);
+    putTime(out, counter.endTime);
+    put<uint8_t>(out, counter.isComplete ? 1 : 0);
+}
+
+CounterRecord decodeCounter(Reader& in) {
+    CounterRecord counter;
+    counter.counterNumber = in.get<int32_t>();
+    counter.ordersCount = in.get<int32_t>();
+    uint32_t orderCount = in.get<uint32_t>();
+    for (uint32_t i = 0; i < orderCount && in.ok; ++i) {
+        counter.orderIds.push_back(in.getString());
+    }
+    counter.initialCapital = in.get<double>();
+    counter.currentCapital = in.get<double>();
+    counter.totalPnL = in.get<double>();
+    counter.totalCharges = in.get<double>();
+    counter.startTime = in.getTime();
+    counter.endTime = in.getTime();
+    counter.isComplete = in.get<uint8_t>() != 0;
+    return counter;
+}
+}
+
+CounterLedger::CounterLedger(size_t snapshotInterval)
+    : snapshotInterval_(snapshotInterval > 0 ? snapshotInterval : 4096), log_(nullptr),
+      sequence_(0), eventsSinceSnapshot_(0), replayed_(0), recoveryMillis_(0) {
+}
+
+CounterLedger::~CounterLedger() {
+    close();
+}
+
+bool CounterLedger::open(const std::string& directory, SnapshotHandler onSnapshot, EventHandler onEvent) {
+    close();
+    auto start = std::chrono::steady_clock::now();
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    logPath_ = (std::filesystem::path(directory) / "counters.log").string();
+    snapshotPath_ = (std::filesystem::path(directory) / "counters.snap").string();
+
+    sequence_ = 0;
+    LedgerSnapshot snapshot;
+    if (loadSnapshot(snapshot)) {
+        sequence_ = snapshot.sequence;
+        if (onSnapshot) {
+            onSnapshot(snapshot);
+        }
+    }
+
+    // Replay the tail, then cut off anything after the last intact record
+    long validEnd = replayLog(snapshot.sequence, onEvent);
+    if (validEnd >= 0 && std::filesystem::file_size(logPath_, error) > static_cast<uintmax_t>(validEnd)) {
+        std::cout << "Counter ledger: discarding torn tail at offset " << validEnd << std::endl;
+        std::filesystem::resize_file(logPath_, static_cast<uintmax_t>(validEnd), error);
+        if (error) {
+            return false;
+        }
+    }
+
+    log_ = std::fopen(logPath_.c_str(), "ab");
+    if (!log_) {
+        std::cout << "Counter ledger: cannot open " << logPath_ << std::endl;
+        return false;
+    }
+    // A newly created log must keep its directory entry through a host crash
+    if (!syncDirectory(std::filesystem::path(logPath_).parent_path().string())) {
+        std::cout << "Counter ledger: cannot sync " << directory << std::endl;
+        close();
+        return false;
+    }
+
+    eventsSinceSnapshot_ = replayed_;
+    recoveryMillis_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Counter ledger opened at sequence " << sequence_ << " (" << replayed_
+              << " events replayed in " << recoveryMillis_ << " ms)" << std::endl;
+    return true;
+}
+
+void CounterLedger::close() {
+    if (log_) {
+        std::fclose(log_);
+        log_ = nullptr;
+    }
+}
+
+bool CounterLedger::isOpen() const {
+    return log_ != nullptr;
+}
+
+bool CounterLedger::append(LedgerEvent& event) {
+    if (!log_) {
+        return false;
+    }
+    event.sequence = sequence_ + 1;
+
+    buffer_.clear();
+    put<uint32_t>(buffer_, 0);  // Length and CRC, filled in below
+    put<uint32_t>(buffer_, 0);
+    put<uint8_t>(buffer_, static_cast<uint8_t>(event.type));
+    put<uint64_t>(buffer_, event.sequence);
+    putTime(buffer_, event.timestamp);
+    put<int64_t>(buffer_, event.count);
+    put<double>(buffer_, event.value);
+    put<double>(buffer_, event.value2);
+    putString(buffer_, event.reference);
+
+    uint32_t length = static_cast<uint32_t>(buffer_.size() - RECORD_HEADER_SIZE);
+    uint32_t crc = crc32(buffer_.data() + RECORD_HEADER_SIZE, length);
+    std::memcpy(&buffer_[0], &length, sizeof(length));
+    std::memcpy(&buffer_[sizeof(length)], &crc, sizeof(crc));
+
+    if (std::fwrite(buffer_.data(), 1, buffer_.size(), log_) != buffer_.size() || std::fflush(log_) != 0 ||
+        ::fsync(fileno(log_)) != 0) {
+        // Part of the record may be on disk; appending after it would hide every later
+        // event from recovery, so the ledger stays closed until open() cuts the tail off
+        std::cout << "Counter ledger: write failed, closing the log" << std::endl;
+        close();
+        return false;
+    }
+
+    sequence_ = event.sequence;
+    eventsSinceSnapshot_++;
+    return true;
+}
+
+bool CounterLedger::writeSnapshot(const LedgerSnapshot& snapshot) {
+    if (!log_) {
+        return false;
+    }
+
+    std::string payload;
+    put<uint64_t>(payload, snapshot.sequence);
+    encodeCounter(payload, snapshot.currentCounter);
+    put<uint32_t>(payload, static_cast<uint32_t>(snapshot.completedCounters.size()));
+    for (const auto& counter : snapshot.completedCounters) {
+        encodeCounter(payload, counter);
+    }
+    put<int32_t>(payload, snapshot.completedCount);
+    put<int32_t>(payload, snapshot.consecutiveLosses);
+    put<int32_t>(payload, snapshot.consecutiveWins);
+    put<int32_t>(payload, snapshot.maxConsecutiveLosses);
+    put<double>(payload, snapshot.totalTrades);
+    put<double>(payload, snapshot.profitableTrades);
+    put<uint8_t>(payload, snapshot.paperMode ? 1 : 0);
+    put<double>(payload, snapshot.dailyStartBalance);
+    put<double>(payload, snapshot.dailyPnL);
+    putTime(payload, snapshot.lastDailyReset);
+    put<double>(payload, snapshot.dailyRiskUsed);
+
+    std::string file;
+    put<uint32_t>(file, SNAPSHOT_MAGIC);
+    put<uint32_t>(file, SNAPSHOT_VERSION);
+    put<uint32_t>(file, static_cast<uint32_t>(payload.size()));
+    put<uint32_t>(file, crc32(payload.data(), payload.size()));
+    file.append(payload);
+
+    // Write beside the live snapshot, then swap it in atomically
+    std::string temporaryPath = snapshotPath_ + ".tmp";
+    std::FILE* out = std::fopen(temporaryPath.c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+    bool written = std::fwrite(file.data(), 1, file.size(), out) == file.size() &&
+                   std::fflush(out) == 0 && ::fsync(fileno(out)) == 0;
+    written = std::fclose(out) == 0 && written;
+
+    // The rename is only trusted once the file's data and the directory entry
+    // are on disk; the log is truncated right after
+    std::error_code error;
+    if (written) {
+        std::filesystem::rename(temporaryPath, snapshotPath_, error);
+    }
+    if (written && !error) {
+        written = syncDirectory(std::filesystem::path(snapshotPath_).parent_path().string());
+    }
+    if (!written || error) {
+        std::cout << "Counter ledger: snapshot failed" << std::endl;
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    // Events up to snapshot.sequence are now redundant; a crash before the
+    // truncation only leaves records that recovery skips
+    std::fclose(log_);
+    log_ = std::fopen(logPath_.c_str(), "wb");
+    eventsSinceSnapshot_ = sequence_ > snapshot.sequence ? sequence_ - snapshot.sequence : 0;
+    return log_ != nullptr;
+}
+
+bool CounterLedger::isSnapshotDue() const {
+    return eventsSinceSnapshot_ >= snapshotInterval_;
+}
+
+uint64_t CounterLedger::getSequence() const {
+    return sequence_;
+}
+
+size_t CounterLedger::getEventsSinceSnapshot() const {
+    return eventsSinceSnapshot_;
+}
+
+size_t CounterLedger::getReplayedCount() const {
+    return replayed_;
+}
+
+double CounterLedger::getRecoveryMillis() const {
+    return recoveryMillis_;
+}
+
+// Private methods
+bool CounterLedger::loadSnapshot(LedgerSnapshot& snapshot) const {
+    std::FILE* in = std::fopen(snapshotPath_.c_str(), "rb");
+    if (!in) {
+        return false;
+    }
+
+    uint32_t header[4];
+    std::string payload;
+    bool ok = std::fread(header, sizeof(uint32_t), 4, in) == 4 &&
+              header[0] == SNAPSHOT_MAGIC && header[1] >= 1 && header[1] <= SNAPSHOT_VERSION;
+    if (ok) {
+        payload.resize(header[2]);
+        ok = std::fread(&payload[0], 1, payload.size(), in) == payload.size() &&
+             crc32(payload.data(), payload.size()) == header[3];
+    }
+    std::fclose(in);
+    if (!ok) {
+        std::cout << "Counter ledger: ignoring invalid snapshot " << snapshotPath_ << std::endl;
+        return false;
+    }
+
+    Reader reader(payload.data(), payload.size());
+    LedgerSnapshot decoded;
+    decoded.sequence = reader.get<uint64_t>();
+    decoded.currentCounter = decodeCounter(reader);
+    uint32_t completed = reader.get<uint32_t>();
+    for (uint32_t i = 0; i < completed && reader.ok; ++i) {
+        decoded.completedCounters.push_back(decodeCounter(reader));
+    }
+    decoded.completedCount = reader.get<int32_t>();
+    decoded.consecutiveLosses = reader.get<int32_t>();
+    decoded.consecutiveWins = reader.get<int32_t>();
+    decoded.maxConsecutiveLosses = reader.get<int32_t>();
+    decoded.totalTrades = reader.get<double>();
+    decoded.profitableTrades = reader.get<double>();
+    decoded.paperMode = reader.get<uint8_t>() != 0;
+    decoded.dailyStartBalance = reader.get<double>();
+    decoded.dailyPnL = reader.get<double>();
+    decoded.lastDailyReset = reader.getTime();
+    if (header[1] >= 2) {
+        decoded.dailyRiskUsed = reader.get<double>();
+    }
+    if (!reader.ok) {
+        return false;
+    }
+
+    snapshot = decoded;
+    return true;
+}
+
+long CounterLedger::replayLog(uint64_t afterSequence, const EventHandler& onEvent) {
+    replayed_ = 0;
+    std::FILE* in = std::fopen(logPath_.c_str(), "rb");
+    if (!in) {
+        return -1;
+    }
+
+    long validEnd = 0;
+    std::string payload;
+    uint32_t header[2];
+    while (std::fread(header, sizeof(uint32_t), 2, in) == 2) {
+        uint32_t length = header[0];
+        if (length > MAX_RECORD_SIZE) {
+            break;
+        }
+        payload.resize(length);
+        if (std::fread(&payload[0], 1, length, in) != length || crc32(payload.data(), length) != header[1]) {
+            break;
+        }
+
+        Reader reader(payload.data(), length);
+        LedgerEvent event;
+        event.type = static_cast<LedgerEventType>(reader.get<uint8_t>());
+        event.sequence = reader.get<uint64_t>();
+        event.timestamp = reader.getTime();
+        event.count = reader.get<int64_t>();
+        event.value = reader.get<double>();
+        event.value2 = reader.get<double>();
+        event.reference = reader.getString();
+        if (!reader.ok) {
+            break;
+        }
+
+        validEnd = std::ftell(in);
+        if (event.sequence <= afterSequence) {
+            continue;  // Already folded into the snapshot
+        }
+        if (onEvent) {
+            onEvent(event);
+        }
+        sequence_ = event.sequence;
+        replayed_++;
+    }
+
+    std::fclose(in);
+    return validEnd;
+}
+
+} // namespace MasterMind
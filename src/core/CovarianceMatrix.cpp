@@ -0,0 +1,262 @@
+#include "core/CovarianceMatrix.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MasterMind {
+
+CovarianceMatrix::CovarianceMatrix(double lambda, Duration sampleInterval)
+    : lambda_(lambda > 0 && lambda < 1 ? lambda : 0.94),
+      sampleInterval_(sampleInterval > Duration::zero() ? sampleInterval : std::chrono::minutes(1)),
+      size_(0), stride_(0), stagedSlot_(0), staged_(false), updates_(0) {
+}
+
+size_t CovarianceMatrix::addSymbol(const Symbol& symbol) {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    return addSymbolLocked(symbol);
+}
+
+bool CovarianceMatrix::hasSymbol(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    return indices_.count(symbol) > 0;
+}
+
+std::vector<Symbol> CovarianceMatrix::getSymbols() const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    return symbols_;
+}
+
+size_t CovarianceMatrix::size() const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    return size_;
+}
+
+void CovarianceMatrix::onBar(const Symbol& symbol, Price close, TimePoint barTime) {
+    if (close <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    int64_t slot = gridSlot(barTime);
+    if (staged_ && slot > stagedSlot_) {
+        commitLocked();
+    }
+    if (!staged_ || slot > stagedSlot_) {
+        stagedSlot_ = slot;
+    }
+
+    size_t index = addSymbolLocked(symbol);
+    stagedClose_[index] = close;
+    staged_ = true;
+}
+
+bool CovarianceMatrix::commitBar() {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    return commitLocked();
+}
+
+void CovarianceMatrix::update(const std::vector<double>& returns) {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    if (returns.size() != size_) {
+        return;
+    }
+    applyUpdate(returns.data());
+}
+
+void CovarianceMatrix::reset() {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    std::fill(matrix_.begin(), matrix_.end(), 0.0);
+    std::fill(lastClose_.begin(), lastClose_.end(), 0.0);
+    std::fill(stagedClose_.begin(), stagedClose_.end(), 0.0);
+    staged_ = false;
+    updates_ = 0;
+}
+
+double CovarianceMatrix::getCovariance(const Symbol& a, const Symbol& b) const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    auto itA = indices_.find(a);
+    auto itB = indices_.find(b);
+    if (itA == indices_.end() || itB == indices_.end()) {
+        return 0;
+    }
+    return matrix_[itA->second * stride_ + itB->second];
+}
+
+double CovarianceMatrix::getCorrelation(const Symbol& a, const Symbol& b) const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    auto itA = indices_.find(a);
+    auto itB = indices_.find(b);
+    if (itA == indices_.end() || itB == indices_.end()) {
+        return 0;
+    }
+
+    size_t i = itA->second;
+    size_t j = itB->second;
+    double denominator = std::sqrt(matrix_[i * stride_ + i] * matrix_[j * stride_ + j]);
+    return denominator > 0 ? matrix_[i * stride_ + j] / denominator : 0;
+}
+
+double CovarianceMatrix::getVolatility(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    auto it = indices_.find(symbol);
+    return it != indices_.end() ? std::sqrt(matrix_[it->second * stride_ + it->second]) : 0;
+}
+
+double CovarianceMatrix::portfolioVariance(const std::vector<double>& weights) const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    if (weights.size() != size_) {
+        return 0;
+    }
+    return quadraticForm(weights.data());
+}
+
+double CovarianceMatrix::portfolioVariance(const std::unordered_map<Symbol, double>& weights) const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    std::vector<double> dense;
+    denseWeights(weights, dense);
+    return quadraticForm(dense.data());
+}
+
+double CovarianceMatrix::undiversifiedVariance(const std::unordered_map<Symbol, double>& weights) const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    double variance = 0;
+    for (const auto& pair : weights) {
+        auto it = indices_.find(pair.first);
+        if (it != indices_.end()) {
+            variance += pair.second * pair.second * matrix_[it->second * stride_ + it->second];
+        }
+    }
+    return variance;
+}
+
+double CovarianceMatrix::covarianceWithPortfolio(const Symbol& symbol,
+                                                 const std::unordered_map<Symbol, double>& weights) const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    auto it = indices_.find(symbol);
+    if (it == indices_.end()) {
+        return 0;
+    }
+
+    const double* row = &matrix_[it->second * stride_];
+    double covariance = 0;
+    for (const auto& pair : weights) {
+        auto weightIt = indices_.find(pair.first);
+        if (weightIt != indices_.end()) {
+            covariance += row[weightIt->second] * pair.second;
+        }
+    }
+    return covariance;
+}
+
+uint64_t CovarianceMatrix::getUpdateCount() const {
+    std::lock_guard<std::mutex> lock(matrixMutex_);
+    return updates_;
+}
+
+double CovarianceMatrix::getLambda() const {
+    return lambda_;
+}
+
+Duration CovarianceMatrix::getSampleInterval() const {
+    return sampleInterval_;
+}
+
+// Private methods
+size_t CovarianceMatrix::addSymbolLocked(const Symbol& symbol) {
+    auto it = indices_.find(symbol);
+    if (it != indices_.end()) {
+        return it->second;
+    }
+
+    // Grow the padded stride geometrically; rows keep their values
+    if (size_ == stride_) {
+        size_t stride = std::max(ROW_ALIGN, stride_ * 2);
+        std::vector<double> matrix(stride * stride, 0.0);
+        for (size_t i = 0; i < size_; ++i) {
+            std::copy(matrix_.begin() + i * stride_, matrix_.begin() + i * stride_ + size_,
+                      matrix.begin() + i * stride);
+        }
+        matrix_.swap(matrix);
+        stride_ = stride;
+        returns_.resize(stride_, 0.0);
+    }
+
+    size_t index = size_++;
+    symbols_.push_back(symbol);
+    indices_[symbol] = index;
+    lastClose_.push_back(0);
+    stagedClose_.push_back(0);
+    return index;
+}
+
+int64_t CovarianceMatrix::gridSlot(TimePoint barTime) const {
+    // Nearest grid point, so skew either side of it stays in one slot
+    int64_t interval = sampleInterval_.count();
+    int64_t time = std::chrono::duration_cast<Duration>(barTime.time_since_epoch()).count() + interval / 2;
+    return time >= 0 ? time / interval : (time - interval + 1) / interval;
+}
+
+void CovarianceMatrix::applyUpdate(const double* returns) {
+    const double decay = lambda_;
+    const double weight = 1.0 - lambda_;
+    for (size_t i = 0; i < size_; ++i) {
+        double* row = &matrix_[i * stride_];
+        const double scaled = weight * returns[i];
+        for (size_t j = 0; j < size_; ++j) {
+            row[j] = decay * row[j] + scaled * returns[j];
+        }
+    }
+    updates_++;
+}
+
+bool CovarianceMatrix::commitLocked() {
+    if (!staged_) {
+        return false;
+    }
+    staged_ = false;
+
+    // Unobserved symbols carry their last close forward: a flat sample
+    size_t observed = 0;
+    for (size_t i = 0; i < size_; ++i) {
+        double previous = lastClose_[i];
+        double close = stagedClose_[i] > 0 ? stagedClose_[i] : previous;
+        returns_[i] = close > 0 && previous > 0 ? close / previous - 1.0 : 0.0;
+        observed += stagedClose_[i] > 0 && previous > 0;
+        lastClose_[i] = close;
+        stagedClose_[i] = 0;
+    }
+
+    // The first bar of a series only establishes the reference closes
+    if (observed == 0) {
+        return false;
+    }
+    applyUpdate(returns_.data());
+    return true;
+}
+
+double CovarianceMatrix::quadraticForm(const double* weights) const {
+    double variance = 0;
+    for (size_t i = 0; i < size_; ++i) {
+        if (weights[i] == 0) {
+            continue;
+        }
+        const double* row = &matrix_[i * stride_];
+        double dot = 0;
+        for (size_t j = 0; j < size_; ++j) {
+            dot += row[j] * weights[j];
+        }
+        variance += weights[i] * dot;
+    }
+    return variance;
+}
+
+void CovarianceMatrix::denseWeights(const std::unordered_map<Symbol, double>& weights, std::vector<double>& dense) const {
+    dense.assign(size_, 0.0);
+    for (const auto& pair : weights) {
+        auto it = indices_.find(pair.first);
+        if (it != indices_.end()) {
+            dense[it->second] = pair.second;
+        }
+    }
+}
+
+} // namespace MasterMind
@@ -1,13 +1,212 @@
 #include "core/DatabaseManager.h"
+#include <sqlite3.h>
 #include <iostream>
 #include <sstream>
 #include <chrono>
+#include <filesystem>
 #include <iomanip>
+#include <type_traits>
 
 namespace MasterMind {
 
-DatabaseManager::DatabaseManager() 
+namespace {
+constexpr int SCHEMA_VERSION = 1;
+
+// One entry per DatabaseManager::Statement, in declaration order
+const char* const STATEMENT_SQL[] = {
+    // INSERT_ORDER
+    "INSERT OR REPLACE INTO orders (order_id, symbol, type, side, price, quantity, filled_quantity, status, "
+    "create_time, update_time, exchange, strategy_id, stop_loss, take_profit, trigger_price, "
+    "visible_quantity, tick_offset) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15, ?16, ?17)",
+    // UPDATE_ORDER
+    "UPDATE orders SET symbol = ?2, type = ?3, side = ?4, price = ?5, quantity = ?6, filled_quantity = ?7, "
+    "status = ?8, create_time = ?9, update_time = ?10, exchange = ?11, strategy_id = ?12, stop_loss = ?13, "
+    "take_profit = ?14, trigger_price = ?15, visible_quantity = ?16, tick_offset = ?17 WHERE order_id = ?1",
+    // DELETE_ORDER
+    "DELETE FROM orders WHERE order_id = ?1",
+    // GET_ORDER
+    "SELECT order_id, symbol, type, side, price, quantity, filled_quantity, status, create_time, update_time, "
+    "exchange, strategy_id, stop_loss, take_profit, trigger_price, visible_quantity, tick_offset "
+    "FROM orders WHERE order_id = ?1",
+    // ORDER_HISTORY
+    "SELECT order_id, symbol, type, side, price, quantity, filled_quantity, status, create_time, update_time, "
+    "exchange, strategy_id, stop_loss, take_profit, trigger_price, visible_quantity, tick_offset "
+    "FROM orders ORDER BY create_time DESC LIMIT ?1",
+    // ORDER_HISTORY_BY_SYMBOL
+    "SELECT order_id, symbol, type, side, price, quantity, filled_quantity, status, create_time, update_time, "
+    "exchange, strategy_id, stop_loss, take_profit, trigger_price, visible_quantity, tick_offset "
+    "FROM orders WHERE symbol = ?1 ORDER BY create_time DESC LIMIT ?2",
+    // ORDER_COUNT
+    "SELECT COUNT(*) FROM orders",
+    // ORDER_COUNT_BY_SYMBOL
+    "SELECT COUNT(*) FROM orders WHERE symbol = ?1",
+    // INSERT_POSITION
+    "INSERT OR REPLACE INTO positions (symbol, exchange, side, quantity, average_price, current_price, "
+    "unrealized_pnl, realized_pnl, open_time, update_time) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10)",
+    // UPDATE_POSITION
+    "UPDATE positions SET side = ?3, quantity = ?4, average_price = ?5, current_price = ?6, unrealized_pnl = ?7, "
+    "realized_pnl = ?8, open_time = ?9, update_time = ?10 WHERE symbol = ?1 AND exchange = ?2",
+    // GET_POSITIONS
+    "SELECT symbol, exchange, side, quantity, average_price, current_price, unrealized_pnl, realized_pnl, "
+    "open_time, update_time FROM positions",
+    // GET_POSITIONS_BY_SYMBOL
+    "SELECT symbol, exchange, side, quantity, average_price, current_price, unrealized_pnl, realized_pnl, "
+    "open_time, update_time FROM positions WHERE symbol = ?1",
+    // INSERT_TRADE_RESULT (symbol copied from the order so P&L per symbol needs no join)
+    "INSERT INTO trade_results (order_id, symbol, pnl, strategy, time) "
+    "VALUES (?1, COALESCE((SELECT symbol FROM orders WHERE order_id = ?1), ''), ?2, ?3, ?4)",
+    // UPDATE_PERFORMANCE
+    "INSERT OR REPLACE INTO performance_stats (id, total_trades, winning_trades, losing_trades, total_profit, "
+    "total_loss, largest_win, largest_loss, win_rate, profit_factor, sharpe_ratio, consecutive_wins, "
+    "consecutive_losses, current_streak, last_update) "
+    "VALUES (1, ?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14)",
+    // GET_PERFORMANCE
+    "SELECT total_trades, winning_trades, losing_trades, total_profit, total_loss, largest_win, largest_loss, "
+    "win_rate, profit_factor, sharpe_ratio, consecutive_wins, consecutive_losses, current_streak, last_update "
+    "FROM performance_stats WHERE id = 1",
+    // TOTAL_PNL
+    "SELECT COALESCE(SUM(pnl), 0) FROM trade_results",
+    // TOTAL_PNL_BY_SYMBOL
+    "SELECT COALESCE(SUM(pnl), 0) FROM trade_results WHERE symbol = ?1",
+    // TRADE_COUNT
+    "SELECT COUNT(*) FROM trade_results",
+    // WIN_RATE
+    "SELECT COALESCE(AVG(pnl > 0), 0) FROM trade_results",
+    // INSERT_RISK_EVENT
+    "INSERT INTO risk_events (time, event, details) VALUES (?1, ?2, ?3)",
+    // INSERT_COUNTER_RESULT
+    "INSERT INTO counter_results (counter_number, pnl, order_count, time) VALUES (?1, ?2, ?3, ?4)",
+    // GET_RISK_EVENTS
+    "SELECT time, event, details FROM risk_events ORDER BY id DESC LIMIT ?1",
+    // INSERT_CONFIG
+    "INSERT INTO config_backups (time, config) VALUES (?1, ?2)",
+    // LATEST_CONFIG
+    "SELECT config FROM config_backups ORDER BY id DESC LIMIT 1",
+    // CONFIG_HISTORY
+    "SELECT config FROM config_backups ORDER BY id DESC",
+    // INSERT_AUDIT
+    "INSERT INTO audit_trail (time, action, details, user_id) VALUES (?1, ?2, ?3, ?4)",
+    // GET_AUDIT_TRAIL
+    "SELECT time, action, details, user_id FROM audit_trail WHERE time BETWEEN ?1 AND ?2 ORDER BY time",
+    // BEGIN, COMMIT, ROLLBACK
+    "BEGIN IMMEDIATE",
+    "COMMIT",
+    "ROLLBACK"
+};
+
+const char* const SCHEMA_TABLES[] = {
+    "orders", "positions", "trade_results", "performance_stats",
+    "risk_events", "counter_results", "audit_trail", "config_backups"
+};
+
+int64_t toMillis(const TimePoint& time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+TimePoint fromMillis(int64_t millis) {
+    return TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::milliseconds(millis)));
+}
+
+std::string formatMillis(int64_t millis) {
+    std::time_t time = std::chrono::system_clock::to_time_t(fromMillis(millis));
+    std::ostringstream oss;
+    oss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
+    return oss.str();
+}
+
+void bindText(sqlite3_stmt* stmt, int index, const std::string& value) {
+    sqlite3_bind_text(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_TRANSIENT);
+}
+
+std::string columnText(sqlite3_stmt* stmt, int column) {
+    const unsigned char* text = sqlite3_column_text(stmt, column);
+    return text ? std::string(reinterpret_cast<const char*>(text), sqlite3_column_bytes(stmt, column)) : std::string();
+}
+
+void bindOrder(sqlite3_stmt* stmt, const Order& order) {
+    bindText(stmt, 1, order.orderId);
+    bindText(stmt, 2, order.symbol);
+    sqlite3_bind_int(stmt, 3, static_cast<int>(order.type));
+    sqlite3_bind_int(stmt, 4, static_cast<int>(order.side));
+    sqlite3_bind_double(stmt, 5, order.price);
+    sqlite3_bind_double(stmt, 6, order.quantity);
+    sqlite3_bind_double(stmt, 7, order.filledQuantity);
+    sqlite3_bind_int(stmt, 8, static_cast<int>(order.status));
+    sqlite3_bind_int64(stmt, 9, toMillis(order.createTime));
+    sqlite3_bind_int64(stmt, 10, toMillis(order.updateTime));
+    bindText(stmt, 11, order.exchange);
+    bindText(stmt, 12, order.strategyId);
+    sqlite3_bind_double(stmt, 13, order.stopLoss);
+    sqlite3_bind_double(stmt, 14, order.takeProfit);
+    sqlite3_bind_double(stmt, 15, order.triggerPrice);
+    sqlite3_bind_double(stmt, 16, order.visibleQuantity);
+    sqlite3_bind_int(stmt, 17, order.tickOffset);
+}
+
+Order readOrder(sqlite3_stmt* stmt) {
+    Order order;
+    order.orderId = columnText(stmt, 0);
+    order.symbol = columnText(stmt, 1);
+    order.type = static_cast<OrderType>(sqlite3_column_int(stmt, 2));
+    order.side = static_cast<OrderSide>(sqlite3_column_int(stmt, 3));
+    order.price = sqlite3_column_double(stmt, 4);
+    order.quantity = sqlite3_column_double(stmt, 5);
+    order.filledQuantity = sqlite3_column_double(stmt, 6);
+    order.status = static_cast<OrderStatus>(sqlite3_column_int(stmt, 7));
+    order.createTime = fromMillis(sqlite3_column_int64(stmt, 8));
+    order.updateTime = fromMillis(sqlite3_column_int64(stmt, 9));
+    order.exchange = columnText(stmt, 10);
+    order.strategyId = columnText(stmt, 11);
+    order.stopLoss = sqlite3_column_double(stmt, 12);
+    order.takeProfit = sqlite3_column_double(stmt, 13);
+    order.triggerPrice = sqlite3_column_double(stmt, 14);
+    order.visibleQuantity = sqlite3_column_double(stmt, 15);
+    order.tickOffset = sqlite3_column_int(stmt, 16);
+    return order;
+}
+
+void bindPosition(sqlite3_stmt* stmt, const Position& position) {
+    bindText(stmt, 1, position.symbol);
+    bindText(stmt, 2, position.exchange);
+    sqlite3_bind_int(stmt, 3, static_cast<int>(position.side));
+    sqlite3_bind_double(stmt, 4, position.quantity);
+    sqlite3_bind_double(stmt, 5, position.averagePrice);
+    sqlite3_bind_double(stmt, 6, position.currentPrice);
+    sqlite3_bind_double(stmt, 7, position.unrealizedPnL);
+    sqlite3_bind_double(stmt, 8, position.realizedPnL);
+    sqlite3_bind_int64(stmt, 9, toMillis(position.openTime));
+    sqlite3_bind_int64(stmt, 10, toMillis(position.updateTime));
+}
+
+Position readPosition(sqlite3_stmt* stmt) {
+    Position position;
+    position.symbol = columnText(stmt, 0);
+    position.exchange = columnText(stmt, 1);
+    position.side = static_cast<OrderSide>(sqlite3_column_int(stmt, 2));
+    position.quantity = sqlite3_column_double(stmt, 3);
+    position.averagePrice = sqlite3_column_double(stmt, 4);
+    position.currentPrice = sqlite3_column_double(stmt, 5);
+    position.unrealizedPnL = sqlite3_column_double(stmt, 6);
+    position.realizedPnL = sqlite3_column_double(stmt, 7);
+    position.openTime = fromMillis(sqlite3_column_int64(stmt, 8));
+    position.updateTime = fromMillis(sqlite3_column_int64(stmt, 9));
+    return position;
+}
+
+// Copies a whole database between connections page by page
+bool copyDatabase(sqlite3* destination, sqlite3* source) {
+    sqlite3_backup* backup = sqlite3_backup_init(destination, "main", source, "main");
+    if (!backup) {
+        return false;
+    }
+    sqlite3_backup_step(backup, -1);
+    return sqlite3_backup_finish(backup) == SQLITE_OK;
+}
+}
+
+DatabaseManager::DatabaseManager()
     : connected_(false), dbHandle_(nullptr) {
+    statements_.fill(nullptr);
     std::cout << "DatabaseManager initialized" << std::endl;
 }
 
@@ -20,34 +219,24 @@ DatabaseManager::~DatabaseManager() {
 bool DatabaseManager::initialize(const std::string& connectionString) {
     std::lock_guard<std::mutex> lock(dbMutex_);
     connectionString_ = connectionString;
-    
+
     std::cout << "Database initialized with connection string: " << connectionString << std::endl;
     return true;
 }
 
 bool DatabaseManager::connect() {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    
-    if (connected_) {
-        return true;
-    }
-    
-    // Stub implementation - simulate connection
-    connected_ = true;
-    clearError();
-    
-    std::cout << "Connected to database" << std::endl;
-    return true;
+    return connectLocked();
 }
 
 bool DatabaseManager::disconnect() {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    
+
     if (!connected_) {
         return true;
     }
-    
-    connected_ = false;
+
+    disconnectLocked();
     std::cout << "Disconnected from database" << std::endl;
     return true;
 }
@@ -58,193 +247,444 @@ bool DatabaseManager::isConnected() const {
 }
 
 bool DatabaseManager::createTables() {
-    std::cout << "Creating database tables" << std::endl;
-    
-    // Simulate table creation
-    return createOrdersTable() && 
-           createPositionsTable() && 
-           createPerformanceTable() && 
-           createRiskEventsTable() && 
-           createAuditTrailTable() && 
-           createConfigBackupTable();
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    return connected_ && createTablesLocked();
 }
 
 bool DatabaseManager::dropTables() {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    if (!connected_) {
+        return false;
+    }
+
     std::cout << "Dropping database tables" << std::endl;
-    return true;
+    finalizeStatements();
+    for (const char* table : SCHEMA_TABLES) {
+        if (!executeQuery(std::string("DROP TABLE IF EXISTS ") + table)) {
+            return false;
+        }
+    }
+    return executeQuery("PRAGMA user_version = 0");
 }
 
 bool DatabaseManager::migrateTables() {
-    std::cout << "Migrating database tables" << std::endl;
-    return true;
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    if (!connected_) {
+        return false;
+    }
+
+    auto rows = executeSelect("PRAGMA user_version");
+    int version = rows.empty() || rows[0].empty() ? 0 : std::stoi(rows[0][0]);
+    if (version == SCHEMA_VERSION) {
+        return true;
+    }
+
+    // Version 1 is the first schema; older files only need the tables created
+    std::cout << "Migrating database schema from version " << version << " to " << SCHEMA_VERSION << std::endl;
+    return createTablesLocked();
 }
 
 bool DatabaseManager::validateSchema() const {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    if (!connected_) {
+        return false;
+    }
+
+    for (const char* table : SCHEMA_TABLES) {
+        if (!tableExists(table)) {
+            return false;
+        }
+    }
     return true;
 }
 
 bool DatabaseManager::insertOrder(const Order& order) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Inserting order: " << order.orderId << std::endl;
-    return true;
+    return insertOrderLocked(order);
 }
 
 bool DatabaseManager::updateOrder(const Order& order) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Updating order: " << order.orderId << std::endl;
-    return true;
+    return updateOrderLocked(order);
 }
 
 bool DatabaseManager::deleteOrder(const OrderId& orderId) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Deleting order: " << orderId << std::endl;
-    return true;
+    sqlite3_stmt* stmt = statement(Statement::DELETE_ORDER);
+    if (!stmt) {
+        return false;
+    }
+    bindText(stmt, 1, orderId);
+    return execute(stmt) && sqlite3_changes(dbHandle_) > 0;
 }
 
 Order DatabaseManager::getOrder(const OrderId& orderId) const {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    // Return empty order for stub implementation
-    Order order;
-    order.orderId = orderId;
+    sqlite3_stmt* stmt = statement(Statement::GET_ORDER);
+    if (!stmt) {
+        return Order();
+    }
+
+    bindText(stmt, 1, orderId);
+    Order order = sqlite3_step(stmt) == SQLITE_ROW ? readOrder(stmt) : Order();
+    sqlite3_reset(stmt);
     return order;
 }
 
 std::vector<Order> DatabaseManager::getOrderHistory(const Symbol& symbol, int limit) const {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    // Return empty vector for stub implementation
-    return std::vector<Order>();
+    std::vector<Order> orders;
+    sqlite3_stmt* stmt = statement(symbol.empty() ? Statement::ORDER_HISTORY : Statement::ORDER_HISTORY_BY_SYMBOL);
+    if (!stmt) {
+        return orders;
+    }
+
+    if (symbol.empty()) {
+        sqlite3_bind_int(stmt, 1, limit);
+    } else {
+        bindText(stmt, 1, symbol);
+        sqlite3_bind_int(stmt, 2, limit);
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        orders.push_back(readOrder(stmt));
+    }
+    sqlite3_reset(stmt);
+    return orders;
 }
 
 bool DatabaseManager::insertPosition(const Position& position) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Inserting position for: " << position.symbol << std::endl;
-    return true;
+    return insertPositionLocked(position);
 }
 
 bool DatabaseManager::updatePosition(const Position& position) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Updating position for: " << position.symbol << std::endl;
-    return true;
+    return updatePositionLocked(position);
 }
 
 std::vector<Position> DatabaseManager::getPositions(const Symbol& symbol) const {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    return std::vector<Position>();
+    std::vector<Position> positions;
+    sqlite3_stmt* stmt = statement(symbol.empty() ? Statement::GET_POSITIONS : Statement::GET_POSITIONS_BY_SYMBOL);
+    if (!stmt) {
+        return positions;
+    }
+
+    if (!symbol.empty()) {
+        bindText(stmt, 1, symbol);
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        positions.push_back(readPosition(stmt));
+    }
+    sqlite3_reset(stmt);
+    return positions;
 }
 
 bool DatabaseManager::insertTradeResult(const OrderId& orderId, double pnl, const std::string& strategy) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Inserting trade result - Order: " << orderId << ", PnL: " << pnl << std::endl;
-    return true;
+    return insertTradeResultLocked(orderId, pnl, strategy, std::chrono::system_clock::now());
 }
 
 bool DatabaseManager::updatePerformanceStats(const TradingStats& stats) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Updating performance statistics" << std::endl;
-    return true;
+    sqlite3_stmt* stmt = statement(Statement::UPDATE_PERFORMANCE);
+    if (!stmt) {
+        return false;
+    }
+    sqlite3_bind_int(stmt, 1, stats.totalTrades);
+    sqlite3_bind_int(stmt, 2, stats.winningTrades);
+    sqlite3_bind_int(stmt, 3, stats.losingTrades);
+    sqlite3_bind_double(stmt, 4, stats.totalProfit);
+    sqlite3_bind_double(stmt, 5, stats.totalLoss);
+    sqlite3_bind_double(stmt, 6, stats.largestWin);
+    sqlite3_bind_double(stmt, 7, stats.largestLoss);
+    sqlite3_bind_double(stmt, 8, stats.winRate);
+    sqlite3_bind_double(stmt, 9, stats.profitFactor);
+    sqlite3_bind_double(stmt, 10, stats.sharpeRatio);
+    sqlite3_bind_int(stmt, 11, stats.consecutiveWins);
+    sqlite3_bind_int(stmt, 12, stats.consecutiveLosses);
+    sqlite3_bind_int(stmt, 13, stats.currentStreak);
+    sqlite3_bind_int64(stmt, 14, toMillis(stats.lastUpdate));
+    return execute(stmt);
 }
 
 TradingStats DatabaseManager::getPerformanceStats() const {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    return TradingStats();
+    TradingStats stats;
+    sqlite3_stmt* stmt = statement(Statement::GET_PERFORMANCE);
+    if (!stmt) {
+        return stats;
+    }
+
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        stats.totalTrades = sqlite3_column_int(stmt, 0);
+        stats.winningTrades = sqlite3_column_int(stmt, 1);
+        stats.losingTrades = sqlite3_column_int(stmt, 2);
+        stats.totalProfit = sqlite3_column_double(stmt, 3);
+        stats.totalLoss = sqlite3_column_double(stmt, 4);
+        stats.largestWin = sqlite3_column_double(stmt, 5);
+        stats.largestLoss = sqlite3_column_double(stmt, 6);
+        stats.winRate = sqlite3_column_double(stmt, 7);
+        stats.profitFactor = sqlite3_column_double(stmt, 8);
+        stats.sharpeRatio = sqlite3_column_double(stmt, 9);
+        stats.consecutiveWins = sqlite3_column_int(stmt, 10);
+        stats.consecutiveLosses = sqlite3_column_int(stmt, 11);
+        stats.currentStreak = sqlite3_column_int(stmt, 12);
+        stats.lastUpdate = fromMillis(sqlite3_column_int64(stmt, 13));
+    }
+    sqlite3_reset(stmt);
+    return stats;
 }
 
 bool DatabaseManager::insertRiskEvent(const std::string& event, const std::string& details) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Inserting risk event: " << event << std::endl;
-    return true;
+    return insertRiskEventLocked(event, details, std::chrono::system_clock::now());
 }
 
 bool DatabaseManager::insertCounterResult(int counterNumber, double pnl, int orderCount) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Inserting counter result #" << counterNumber << ", PnL: " << pnl << std::endl;
-    return true;
+    return insertCounterResultLocked(counterNumber, pnl, orderCount, std::chrono::system_clock::now());
 }
 
 std::vector<std::string> DatabaseManager::getRiskEvents(int limit) const {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    return std::vector<std::string>();
+    std::vector<std::string> events;
+    sqlite3_stmt* stmt = statement(Statement::GET_RISK_EVENTS);
+    if (!stmt) {
+        return events;
+    }
+
+    sqlite3_bind_int(stmt, 1, limit);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        events.push_back(formatMillis(sqlite3_column_int64(stmt, 0)) + " " + columnText(stmt, 1) +
+                         ": " + columnText(stmt, 2));
+    }
+    sqlite3_reset(stmt);
+    return events;
 }
 
 bool DatabaseManager::backupConfiguration(const std::string& configJson) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Backing up configuration" << std::endl;
-    return true;
+    sqlite3_stmt* stmt = statement(Statement::INSERT_CONFIG);
+    if (!stmt) {
+        return false;
+    }
+    sqlite3_bind_int64(stmt, 1, toMillis(std::chrono::system_clock::now()));
+    bindText(stmt, 2, configJson);
+    return execute(stmt);
 }
 
 std::string DatabaseManager::getLatestConfiguration() const {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    return "{}"; // Empty JSON
+    sqlite3_stmt* stmt = statement(Statement::LATEST_CONFIG);
+    if (!stmt) {
+        return "{}";
+    }
+
+    std::string config = sqlite3_step(stmt) == SQLITE_ROW ? columnText(stmt, 0) : "{}";
+    sqlite3_reset(stmt);
+    return config;
 }
 
 std::vector<std::string> DatabaseManager::getConfigurationHistory() const {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    return std::vector<std::string>();
+    std::vector<std::string> history;
+    sqlite3_stmt* stmt = statement(Statement::CONFIG_HISTORY);
+    if (!stmt) {
+        return history;
+    }
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        history.push_back(columnText(stmt, 0));
+    }
+    sqlite3_reset(stmt);
+    return history;
 }
 
 bool DatabaseManager::insertAuditEntry(const std::string& action, const std::string& details, const std::string& userId) {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Audit: " << action << " by " << userId << std::endl;
-    return true;
+    return insertAuditEntryLocked(action, details, userId, std::chrono::system_clock::now());
 }
 
 std::vector<std::string> DatabaseManager::getAuditTrail(const TimePoint& startTime, const TimePoint& endTime) const {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    return std::vector<std::string>();
+    std::vector<std::string> entries;
+    sqlite3_stmt* stmt = statement(Statement::GET_AUDIT_TRAIL);
+    if (!stmt) {
+        return entries;
+    }
+
+    sqlite3_bind_int64(stmt, 1, toMillis(startTime));
+    sqlite3_bind_int64(stmt, 2, toMillis(endTime));
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        entries.push_back(formatMillis(sqlite3_column_int64(stmt, 0)) + " [" + columnText(stmt, 3) + "] " +
+                          columnText(stmt, 1) + ": " + columnText(stmt, 2));
+    }
+    sqlite3_reset(stmt);
+    return entries;
 }
 
 bool DatabaseManager::cleanupOldData(int daysToKeep) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    if (!connected_) {
+        return false;
+    }
+
     std::cout << "Cleaning up data older than " << daysToKeep << " days" << std::endl;
-    return true;
+    int64_t cutoff = toMillis(std::chrono::system_clock::now() - std::chrono::hours(24) * daysToKeep);
+    std::string before = std::to_string(cutoff);
+
+    // Live orders and the latest configuration are kept whatever their age
+    std::ostringstream finished;
+    finished << static_cast<int>(OrderStatus::FILLED) << ", " << static_cast<int>(OrderStatus::CANCELLED) << ", "
+             << static_cast<int>(OrderStatus::REJECTED) << ", " << static_cast<int>(OrderStatus::EXPIRED);
+    if (!executeQuery("BEGIN")) {
+        return false;
+    }
+    bool cleaned = executeQuery("DELETE FROM orders WHERE update_time < " + before + " AND status IN (" + finished.str() + ")") &&
+                   executeQuery("DELETE FROM trade_results WHERE time < " + before) &&
+                   executeQuery("DELETE FROM risk_events WHERE time < " + before) &&
+                   executeQuery("DELETE FROM counter_results WHERE time < " + before) &&
+                   executeQuery("DELETE FROM audit_trail WHERE time < " + before) &&
+                   executeQuery("DELETE FROM config_backups WHERE time < " + before +
+                                " AND id <> (SELECT MAX(id) FROM config_backups)");
+    return executeQuery(cleaned ? "COMMIT" : "ROLLBACK") && cleaned;
 }
 
 bool DatabaseManager::vacuum() {
+    std::lock_guard<std::mutex> lock(dbMutex_);
     std::cout << "Vacuuming database" << std::endl;
-    return true;
+    return connected_ && executeQuery("VACUUM");
 }
 
 bool DatabaseManager::backup(const std::string& backupPath) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    if (!connected_) {
+        return false;
+    }
+
     std::cout << "Backing up database to: " << backupPath << std::endl;
-    return true;
+    sqlite3* destination = nullptr;
+    bool copied = sqlite3_open(backupPath.c_str(), &destination) == SQLITE_OK &&
+                  copyDatabase(destination, dbHandle_);
+    if (!copied) {
+        logError("Backup to " + backupPath + " failed: " + sqlite3_errmsg(destination ? destination : dbHandle_));
+    }
+    sqlite3_close(destination);
+    return copied;
 }
 
 bool DatabaseManager::restore(const std::string& backupPath) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    if (!connected_) {
+        return false;
+    }
+
     std::cout << "Restoring database from: " << backupPath << std::endl;
-    return true;
+    sqlite3* source = nullptr;
+    finalizeStatements();
+    bool copied = sqlite3_open_v2(backupPath.c_str(), &source, SQLITE_OPEN_READONLY, nullptr) == SQLITE_OK &&
+                  copyDatabase(dbHandle_, source);
+    if (!copied) {
+        logError("Restore from " + backupPath + " failed: " + sqlite3_errmsg(source ? source : dbHandle_));
+    }
+    sqlite3_close(source);
+    return copied;
 }
 
 int DatabaseManager::getOrderCount(const Symbol& symbol) const {
-    return 0; // Stub implementation
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    sqlite3_stmt* stmt = statement(symbol.empty() ? Statement::ORDER_COUNT : Statement::ORDER_COUNT_BY_SYMBOL);
+    if (!stmt) {
+        return 0;
+    }
+
+    if (!symbol.empty()) {
+        bindText(stmt, 1, symbol);
+    }
+    int count = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : 0;
+    sqlite3_reset(stmt);
+    return count;
 }
 
 double DatabaseManager::getTotalPnL(const Symbol& symbol) const {
-    return 0.0; // Stub implementation
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    sqlite3_stmt* stmt = statement(symbol.empty() ? Statement::TOTAL_PNL : Statement::TOTAL_PNL_BY_SYMBOL);
+    if (!stmt) {
+        return 0.0;
+    }
+
+    if (!symbol.empty()) {
+        bindText(stmt, 1, symbol);
+    }
+    double total = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_double(stmt, 0) : 0.0;
+    sqlite3_reset(stmt);
+    return total;
 }
 
 int DatabaseManager::getTradeCount() const {
-    return 0; // Stub implementation
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    sqlite3_stmt* stmt = statement(Statement::TRADE_COUNT);
+    if (!stmt) {
+        return 0;
+    }
+
+    int count = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : 0;
+    sqlite3_reset(stmt);
+    return count;
 }
 
 double DatabaseManager::getWinRate() const {
-    return 0.0; // Stub implementation
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    sqlite3_stmt* stmt = statement(Statement::WIN_RATE);
+    if (!stmt) {
+        return 0.0;
+    }
+
+    double winRate = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_double(stmt, 0) : 0.0;
+    sqlite3_reset(stmt);
+    return winRate;
 }
 
 bool DatabaseManager::beginTransaction() {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Beginning transaction" << std::endl;
-    return true;
+    sqlite3_stmt* stmt = statement(Statement::BEGIN);
+    return stmt && execute(stmt);
 }
 
 bool DatabaseManager::commitTransaction() {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Committing transaction" << std::endl;
-    return true;
+    sqlite3_stmt* stmt = statement(Statement::COMMIT);
+    return stmt && execute(stmt);
 }
 
 bool DatabaseManager::rollbackTransaction() {
     std::lock_guard<std::mutex> lock(dbMutex_);
-    std::cout << "Rolling back transaction" << std::endl;
-    return true;
+    sqlite3_stmt* stmt = statement(Statement::ROLLBACK);
+    return stmt && execute(stmt);
+}
+
+size_t DatabaseManager::writeBatch(const PersistenceRecord* records, size_t count) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    sqlite3_stmt* begin = statement(Statement::BEGIN);
+    if (!begin || !execute(begin)) {
+        return 0;
+    }
+    
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        written += applyRecord(records[i]) ? 1 : 0;
+    }
+    
+    sqlite3_stmt* commit = statement(Statement::COMMIT);
+    if (!commit || !execute(commit)) {
+        sqlite3_stmt* rollback = statement(Statement::ROLLBACK);
+        if (rollback) {
+            execute(rollback);
+        }
+        return 0;
+    }
+    return written;
 }
 
 std::string DatabaseManager::getLastError() const {
@@ -261,45 +701,428 @@ void DatabaseManager::clearError() {
     lastError_.clear();
 }
 
+// PersistenceRecord
+static_assert(std::is_trivially_copyable<PersistenceRecord>::value,
+              "PersistenceRecord must stay plain data: ring slots are filled without allocating");
+
+void PersistenceRecord::setOrder(Kind recordKind, const Order& value) {
+    kind = recordKind;
+    bool fits = order.orderId.assign(value.orderId);
+    fits &= order.symbol.assign(value.symbol);
+    fits &= order.exchange.assign(value.exchange);
+    fits &= order.strategyId.assign(value.strategyId);
+    releaseOverflow();
+    if (!fits) {
+        overflow = new Overflow();
+        overflow->order = value;
+    }
+    order.type = static_cast<uint8_t>(value.type);
+    order.side = static_cast<uint8_t>(value.side);
+    order.status = static_cast<uint8_t>(value.status);
+    order.tickOffset = value.tickOffset;
+    order.price = value.price;
+    order.quantity = value.quantity;
+    order.filledQuantity = value.filledQuantity;
+    order.stopLoss = value.stopLoss;
+    order.takeProfit = value.takeProfit;
+    order.triggerPrice = value.triggerPrice;
+    order.visibleQuantity = value.visibleQuantity;
+    order.createTime = value.createTime.time_since_epoch().count();
+    order.updateTime = value.updateTime.time_since_epoch().count();
+}
+
+void PersistenceRecord::setPosition(Kind recordKind, const Position& value) {
+    kind = recordKind;
+    bool fits = position.symbol.assign(value.symbol);
+    fits &= position.exchange.assign(value.exchange);
+    releaseOverflow();
+    if (!fits) {
+        overflow = new Overflow();
+        overflow->position = value;
+    }
+    position.side = static_cast<uint8_t>(value.side);
+    position.quantity = value.quantity;
+    position.averagePrice = value.averagePrice;
+    position.currentPrice = value.currentPrice;
+    position.unrealizedPnL = value.unrealizedPnL;
+    position.realizedPnL = value.realizedPnL;
+    position.openTime = value.openTime.time_since_epoch().count();
+    position.updateTime = value.updateTime.time_since_epoch().count();
+}
+
+void PersistenceRecord::setEvent(Kind recordKind, const std::string& key, const std::string& text,
+                                 const std::string& user, double value, int number, int count) {
+    kind = recordKind;
+    bool fits = event.key.assign(key);
+    fits &= event.text.assign(text);
+    fits &= event.user.assign(user);
+    releaseOverflow();
+    if (!fits) {
+        overflow = new Overflow();
+        overflow->key = key;
+        overflow->text = text;
+        overflow->user = user;
+    }
+    event.value = value;
+    event.number = number;
+    event.count = count;
+}
+
+void PersistenceRecord::releaseOverflow() {
+    delete overflow;
+    overflow = nullptr;
+}
+
+Order PersistenceRecord::toOrder() const {
+    if (overflow) {
+        return overflow->order;
+    }
+    Order result;
+    result.orderId = order.orderId.str();
+    result.symbol = order.symbol.str();
+    result.exchange = order.exchange.str();
+    result.strategyId = order.strategyId.str();
+    result.type = static_cast<OrderType>(order.type);
+    result.side = static_cast<OrderSide>(order.side);
+    result.status = static_cast<OrderStatus>(order.status);
+    result.tickOffset = order.tickOffset;
+    result.price = order.price;
+    result.quantity = order.quantity;
+    result.filledQuantity = order.filledQuantity;
+    result.stopLoss = order.stopLoss;
+    result.takeProfit = order.takeProfit;
+    result.triggerPrice = order.triggerPrice;
+    result.visibleQuantity = order.visibleQuantity;
+    result.createTime = TimePoint(TimePoint::duration(order.createTime));
+    result.updateTime = TimePoint(TimePoint::duration(order.updateTime));
+    return result;
+}
+
+Position PersistenceRecord::toPosition() const {
+    if (overflow) {
+        return overflow->position;
+    }
+    Position result;
+    result.symbol = position.symbol.str();
+    result.exchange = position.exchange.str();
+    result.side = static_cast<OrderSide>(position.side);
+    result.quantity = position.quantity;
+    result.averagePrice = position.averagePrice;
+    result.currentPrice = position.currentPrice;
+    result.unrealizedPnL = position.unrealizedPnL;
+    result.realizedPnL = position.realizedPnL;
+    result.openTime = TimePoint(TimePoint::duration(position.openTime));
+    result.updateTime = TimePoint(TimePoint::duration(position.updateTime));
+    return result;
+}
+
+std::string PersistenceRecord::eventKey() const {
+    return overflow ? overflow->key : event.key.str();
+}
+
+std::string PersistenceRecord::eventText() const {
+    return overflow ? overflow->text : event.text.str();
+}
+
+std::string PersistenceRecord::eventUser() const {
+    return overflow ? overflow->user : event.user.str();
+}
+
 // Private methods
-bool DatabaseManager::createOrdersTable() {
-    std::cout << "Creating orders table" << std::endl;
+sqlite3_stmt* DatabaseManager::statement(Statement id) const {
+    static_assert(sizeof(STATEMENT_SQL) / sizeof(STATEMENT_SQL[0]) == static_cast<size_t>(Statement::COUNT),
+                  "STATEMENT_SQL must have one entry per Statement");
+    if (!connected_) {
+        logError("Not connected");
+        return nullptr;
+    }
+
+    sqlite3_stmt*& stmt = statements_[static_cast<size_t>(id)];
+    if (stmt) {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        return stmt;
+    }
+
+    if (sqlite3_prepare_v3(dbHandle_, STATEMENT_SQL[static_cast<size_t>(id)], -1,
+                           SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK) {
+        logError(sqlite3_errmsg(dbHandle_));
+        stmt = nullptr;
+    }
+    return stmt;
+}
+
+bool DatabaseManager::execute(sqlite3_stmt* stmt) const {
+    int result;
+    while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
+    }
+    sqlite3_reset(stmt);
+    if (result != SQLITE_DONE) {
+        logError(sqlite3_errmsg(dbHandle_));
+        return false;
+    }
     return true;
 }
 
-bool DatabaseManager::createPositionsTable() {
-    std::cout << "Creating positions table" << std::endl;
+void DatabaseManager::finalizeStatements() {
+    for (auto& stmt : statements_) {
+        sqlite3_finalize(stmt);
+        stmt = nullptr;
+    }
+}
+
+bool DatabaseManager::insertOrderLocked(const Order& order) {
+    sqlite3_stmt* stmt = statement(Statement::INSERT_ORDER);
+    if (!stmt) {
+        return false;
+    }
+    bindOrder(stmt, order);
+    return execute(stmt);
+}
+
+bool DatabaseManager::updateOrderLocked(const Order& order) {
+    sqlite3_stmt* stmt = statement(Statement::UPDATE_ORDER);
+    if (!stmt) {
+        return false;
+    }
+    bindOrder(stmt, order);
+    return execute(stmt) && sqlite3_changes(dbHandle_) > 0;
+}
+
+bool DatabaseManager::insertPositionLocked(const Position& position) {
+    sqlite3_stmt* stmt = statement(Statement::INSERT_POSITION);
+    if (!stmt) {
+        return false;
+    }
+    bindPosition(stmt, position);
+    return execute(stmt);
+}
+
+bool DatabaseManager::updatePositionLocked(const Position& position) {
+    sqlite3_stmt* stmt = statement(Statement::UPDATE_POSITION);
+    if (!stmt) {
+        return false;
+    }
+    bindPosition(stmt, position);
+    return execute(stmt) && sqlite3_changes(dbHandle_) > 0;
+}
+
+bool DatabaseManager::insertTradeResultLocked(const OrderId& orderId, double pnl, const std::string& strategy, TimePoint time) {
+    sqlite3_stmt* stmt = statement(Statement::INSERT_TRADE_RESULT);
+    if (!stmt) {
+        return false;
+    }
+    bindText(stmt, 1, orderId);
+    sqlite3_bind_double(stmt, 2, pnl);
+    bindText(stmt, 3, strategy);
+    sqlite3_bind_int64(stmt, 4, toMillis(time));
+    return execute(stmt);
+}
+
+bool DatabaseManager::insertRiskEventLocked(const std::string& event, const std::string& details, TimePoint time) {
+    sqlite3_stmt* stmt = statement(Statement::INSERT_RISK_EVENT);
+    if (!stmt) {
+        return false;
+    }
+    sqlite3_bind_int64(stmt, 1, toMillis(time));
+    bindText(stmt, 2, event);
+    bindText(stmt, 3, details);
+    return execute(stmt);
+}
+
+bool DatabaseManager::insertCounterResultLocked(int counterNumber, double pnl, int orderCount, TimePoint time) {
+    sqlite3_stmt* stmt = statement(Statement::INSERT_COUNTER_RESULT);
+    if (!stmt) {
+        return false;
+    }
+    sqlite3_bind_int(stmt, 1, counterNumber);
+    sqlite3_bind_double(stmt, 2, pnl);
+    sqlite3_bind_int(stmt, 3, orderCount);
+    sqlite3_bind_int64(stmt, 4, toMillis(time));
+    return execute(stmt);
+}
+
+bool DatabaseManager::insertAuditEntryLocked(const std::string& action, const std::string& details, const std::string& userId, TimePoint time) {
+    sqlite3_stmt* stmt = statement(Statement::INSERT_AUDIT);
+    if (!stmt) {
+        return false;
+    }
+    sqlite3_bind_int64(stmt, 1, toMillis(time));
+    bindText(stmt, 2, action);
+    bindText(stmt, 3, details);
+    bindText(stmt, 4, userId);
+    return execute(stmt);
+}
+
+bool DatabaseManager::applyRecord(const PersistenceRecord& record) {
+    const PersistenceRecord::EventFields& event = record.event;
+    switch (record.kind) {
+        case PersistenceRecord::Kind::ORDER:
+            return insertOrderLocked(record.toOrder());
+        case PersistenceRecord::Kind::ORDER_UPDATE:
+            return updateOrderLocked(record.toOrder());
+        case PersistenceRecord::Kind::POSITION:
+            return insertPositionLocked(record.toPosition());
+        case PersistenceRecord::Kind::POSITION_UPDATE:
+            return updatePositionLocked(record.toPosition());
+        case PersistenceRecord::Kind::TRADE_RESULT:
+            return insertTradeResultLocked(record.eventKey(), event.value, record.eventText(), record.time);
+        case PersistenceRecord::Kind::RISK_EVENT:
+            return insertRiskEventLocked(record.eventKey(), record.eventText(), record.time);
+        case PersistenceRecord::Kind::COUNTER_RESULT:
+            return insertCounterResultLocked(event.number, event.value, event.count, record.time);
+        case PersistenceRecord::Kind::AUDIT_ENTRY:
+            return insertAuditEntryLocked(record.eventKey(), record.eventText(), record.eventUser(), record.time);
+    }
+    return false;
+}
+
+bool DatabaseManager::connectLocked() {
+    if (connected_) {
+        return true;
+    }
+
+    std::string path = connectionString_.empty() ? ":memory:" : connectionString_;
+    if (path != ":memory:") {
+        std::error_code error;
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) {
+            std::filesystem::create_directories(parent, error);
+        }
+    }
+
+    // dbMutex_ serializes all access, so SQLite's own connection mutex is not needed
+    if (sqlite3_open_v2(path.c_str(), &dbHandle_,
+                        SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) {
+        logError("Cannot open " + path + ": " + (dbHandle_ ? sqlite3_errmsg(dbHandle_) : "out of memory"));
+        sqlite3_close(dbHandle_);
+        dbHandle_ = nullptr;
+        return false;
+    }
+
+    connected_ = true;
+    clearError();
+
+    // WAL: readers never block the writer; NORMAL sync is durable at checkpoints only
+    sqlite3_busy_timeout(dbHandle_, 5000);
+    if (!executeQuery("PRAGMA journal_mode = WAL") ||
+        !executeQuery("PRAGMA synchronous = NORMAL") ||
+        !executeQuery("PRAGMA temp_store = MEMORY") ||
+        !createTablesLocked()) {
+        disconnectLocked();
+        return false;
+    }
+
+    std::cout << "Connected to database: " << path << std::endl;
     return true;
 }
 
+void DatabaseManager::disconnectLocked() {
+    finalizeStatements();
+    sqlite3_close(dbHandle_);
+    dbHandle_ = nullptr;
+    connected_ = false;
+}
+
+bool DatabaseManager::createTablesLocked() {
+    bool created = createOrdersTable() &&
+                   createPositionsTable() &&
+                   createPerformanceTable() &&
+                   createRiskEventsTable() &&
+                   createAuditTrailTable() &&
+                   createConfigBackupTable();
+    return created && executeQuery("PRAGMA user_version = " + std::to_string(SCHEMA_VERSION));
+}
+
+bool DatabaseManager::createOrdersTable() {
+    // (symbol, create_time) serves getOrderHistory(symbol, limit) newest-first
+    return executeQuery(
+        "CREATE TABLE IF NOT EXISTS orders ("
+        "order_id TEXT PRIMARY KEY, symbol TEXT NOT NULL, type INTEGER NOT NULL, side INTEGER NOT NULL, "
+        "price REAL, quantity REAL, filled_quantity REAL, status INTEGER NOT NULL, "
+        "create_time INTEGER NOT NULL, update_time INTEGER NOT NULL, exchange TEXT, strategy_id TEXT, "
+        "stop_loss REAL, take_profit REAL, trigger_price REAL, visible_quantity REAL, tick_offset INTEGER)") &&
+        executeQuery("CREATE INDEX IF NOT EXISTS idx_orders_symbol_time ON orders (symbol, create_time)") &&
+        executeQuery("CREATE INDEX IF NOT EXISTS idx_orders_time ON orders (create_time)");
+}
+
+bool DatabaseManager::createPositionsTable() {
+    return executeQuery(
+        "CREATE TABLE IF NOT EXISTS positions ("
+        "symbol TEXT NOT NULL, exchange TEXT NOT NULL DEFAULT '', side INTEGER NOT NULL, quantity REAL, "
+        "average_price REAL, current_price REAL, unrealized_pnl REAL, realized_pnl REAL, "
+        "open_time INTEGER, update_time INTEGER, PRIMARY KEY (symbol, exchange))");
+}
+
 bool DatabaseManager::createPerformanceTable() {
-    std::cout << "Creating performance table" << std::endl;
-    return true;
+    // (symbol, pnl) covers getTotalPnL(symbol) without touching the table rows
+    return executeQuery(
+        "CREATE TABLE IF NOT EXISTS trade_results ("
+        "id INTEGER PRIMARY KEY, order_id TEXT NOT NULL, symbol TEXT NOT NULL, pnl REAL NOT NULL, "
+        "strategy TEXT, time INTEGER NOT NULL)") &&
+        executeQuery("CREATE INDEX IF NOT EXISTS idx_trade_results_symbol ON trade_results (symbol, pnl)") &&
+        executeQuery("CREATE INDEX IF NOT EXISTS idx_trade_results_time ON trade_results (time)") &&
+        executeQuery(
+        "CREATE TABLE IF NOT EXISTS performance_stats ("
+        "id INTEGER PRIMARY KEY CHECK (id = 1), total_trades INTEGER, winning_trades INTEGER, "
+        "losing_trades INTEGER, total_profit REAL, total_loss REAL, largest_win REAL, largest_loss REAL, "
+        "win_rate REAL, profit_factor REAL, sharpe_ratio REAL, consecutive_wins INTEGER, "
+        "consecutive_losses INTEGER, current_streak INTEGER, last_update INTEGER)");
 }
 
 bool DatabaseManager::createRiskEventsTable() {
-    std::cout << "Creating risk events table" << std::endl;
-    return true;
+    return executeQuery(
+        "CREATE TABLE IF NOT EXISTS risk_events ("
+        "id INTEGER PRIMARY KEY, time INTEGER NOT NULL, event TEXT NOT NULL, details TEXT)") &&
+        executeQuery("CREATE INDEX IF NOT EXISTS idx_risk_events_time ON risk_events (time)") &&
+        executeQuery(
+        "CREATE TABLE IF NOT EXISTS counter_results ("
+        "id INTEGER PRIMARY KEY, counter_number INTEGER NOT NULL, pnl REAL, order_count INTEGER, "
+        "time INTEGER NOT NULL)");
 }
 
 bool DatabaseManager::createAuditTrailTable() {
-    std::cout << "Creating audit trail table" << std::endl;
-    return true;
+    // time serves getAuditTrail(start, end) as a range scan
+    return executeQuery(
+        "CREATE TABLE IF NOT EXISTS audit_trail ("
+        "id INTEGER PRIMARY KEY, time INTEGER NOT NULL, action TEXT NOT NULL, details TEXT, user_id TEXT)") &&
+        executeQuery("CREATE INDEX IF NOT EXISTS idx_audit_trail_time ON audit_trail (time)");
 }
 
 bool DatabaseManager::createConfigBackupTable() {
-    std::cout << "Creating config backup table" << std::endl;
-    return true;
+    return executeQuery(
+        "CREATE TABLE IF NOT EXISTS config_backups ("
+        "id INTEGER PRIMARY KEY, time INTEGER NOT NULL, config TEXT NOT NULL)");
 }
 
 bool DatabaseManager::executeQuery(const std::string& query) const {
-    // Stub implementation
+    char* message = nullptr;
+    if (sqlite3_exec(dbHandle_, query.c_str(), nullptr, nullptr, &message) != SQLITE_OK) {
+        logError(message ? message : sqlite3_errmsg(dbHandle_));
+        sqlite3_free(message);
+        return false;
+    }
     return true;
 }
 
 std::vector<std::vector<std::string>> DatabaseManager::executeSelect(const std::string& query) const {
-    // Stub implementation
-    return std::vector<std::vector<std::string>>();
+    std::vector<std::vector<std::string>> rows;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(dbHandle_, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        logError(sqlite3_errmsg(dbHandle_));
+        return rows;
+    }
+
+    int columns = sqlite3_column_count(stmt);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        std::vector<std::string> row;
+        for (int column = 0; column < columns; ++column) {
+            row.push_back(columnText(stmt, column));
+        }
+        rows.push_back(std::move(row));
+    }
+    sqlite3_finalize(stmt);
+    return rows;
 }
 
 std::string DatabaseManager::orderToJson(const Order& order) const {
@@ -329,20 +1152,23 @@ Position DatabaseManager::jsonToPosition(const std::string& json) const {
 std::string DatabaseManager::getCurrentTimestamp() const {
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
-    
+
     std::ostringstream oss;
     oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
     return oss.str();
 }
 
 bool DatabaseManager::tableExists(const std::string& tableName) const {
-    // Stub implementation
-    return true;
+    std::string escaped;
+    for (char c : tableName) {
+        escaped += c == '\'' ? std::string("''") : std::string(1, c);
+    }
+    return !executeSelect("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = '" + escaped + "'").empty();
 }
 
-void DatabaseManager::logError(const std::string& error) {
+void DatabaseManager::logError(const std::string& error) const {
     lastError_ = error;
     std::cerr << "Database error: " << error << std::endl;
 }
 
-} // namespace MasterMind 
\ No newline at end of file
+} // namespace MasterMind
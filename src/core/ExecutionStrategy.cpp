@@ -0,0 +1,191 @@
+#include "core/OrderManager.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MasterMind {
+
+namespace {
+constexpr int MAX_SLICES = 1000;
+const Duration DAY = std::chrono::hours(24);
+
+// Spread `total` over weights; the last slice takes the rounding remainder
+std::vector<ExecutionSlice> buildSlices(Volume total, Duration window, const std::vector<double>& weights) {
+    std::vector<ExecutionSlice> slices;
+    if (weights.empty() || total <= 0) {
+        return slices;
+    }
+
+    slices.reserve(weights.size());
+    Duration step = window / static_cast<int64_t>(weights.size());
+    Volume assigned = 0;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        Volume quantity = i + 1 == weights.size() ? total - assigned : total * weights[i];
+        assigned += quantity;
+        if (quantity > 0) {
+            slices.emplace_back(step * static_cast<int64_t>(i), quantity);
+        }
+    }
+    return slices;
+}
+}
+
+// ExecutionStrategy
+Volume ExecutionStrategy::sizeSlice(const Order& parent, Volume scheduled, const OrderBook* book) const {
+    return scheduled;
+}
+
+// TWAPStrategy
+TWAPStrategy::TWAPStrategy(Duration timeWindow, int slices)
+    : timeWindow_(std::max(timeWindow, Duration::zero())),
+      slices_(std::min(std::max(slices, 1), MAX_SLICES)) {
+}
+
+std::vector<ExecutionSlice> TWAPStrategy::plan(const Order& order, TimePoint start) const {
+    return buildSlices(order.quantity, timeWindow_, std::vector<double>(slices_, 1.0 / slices_));
+}
+
+// VWAPStrategy
+VWAPStrategy::VWAPStrategy(Duration timeWindow, std::shared_ptr<const VolumeProfileCache> profiles, int slices)
+    : timeWindow_(std::max(timeWindow, Duration::zero())),
+      profiles_(std::move(profiles)),
+      slices_(std::min(std::max(slices, 0), MAX_SLICES)) {
+}
+
+std::vector<ExecutionSlice> VWAPStrategy::plan(const Order& order, TimePoint start) const {
+    int slices = slices_;
+    if (slices == 0) {
+        Duration bucket = profiles_ ? profiles_->getBucketSize() : std::chrono::minutes(5);
+        slices = static_cast<int>(std::min<int64_t>(MAX_SLICES, std::max<int64_t>(1, timeWindow_ / bucket)));
+    }
+
+    std::vector<double> weights = profiles_
+        ? profiles_->getSliceWeights(order.symbol, start, timeWindow_, slices)
+        : std::vector<double>(slices, 1.0 / slices);
+    return buildSlices(order.quantity, timeWindow_, weights);
+}
+
+// MinimizeSlippageStrategy
+MinimizeSlippageStrategy::MinimizeSlippageStrategy(double maxSlippage, Duration interval)
+    : maxSlippage_(std::max(0.0, maxSlippage)),
+      interval_(std::max(interval, Duration(1))) {
+}
+
+std::vector<ExecutionSlice> MinimizeSlippageStrategy::plan(const Order& order, TimePoint start) const {
+    // Everything is due at once; sizeSlice holds back what the book cannot absorb
+    return {ExecutionSlice(Duration::zero(), order.quantity)};
+}
+
+Volume MinimizeSlippageStrategy::sizeSlice(const Order& parent, Volume scheduled, const OrderBook* book) const {
+    Price mid = book ? book->getMidPrice() : 0;
+    if (mid <= 0) {
+        return scheduled;  // No depth information - nothing to hold back for
+    }
+
+    // Take only the liquidity within maxSlippage of mid
+    Volume available = parent.side == OrderSide::BUY
+        ? book->getVolumeWithin(OrderSide::SELL, mid * (1.0 + maxSlippage_))
+        : book->getVolumeWithin(OrderSide::BUY, mid * (1.0 - maxSlippage_));
+    return std::min(scheduled, available);
+}
+
+// VolumeProfileCache
+VolumeProfileCache::VolumeProfileCache(Duration bucketSize)
+    : bucketSize_(std::min(std::max(bucketSize, Duration(std::chrono::minutes(1))), DAY)),
+      bucketsPerDay_(static_cast<size_t>((DAY + bucketSize_ - Duration(1)) / bucketSize_)) {
+}
+
+void VolumeProfileCache::buildProfile(const Symbol& symbol, const std::vector<OHLC>& bars) {
+    auto profile = std::make_shared<Profile>(bucketsPerDay_, 0.0);
+    std::vector<int> counts(bucketsPerDay_, 0);
+
+    for (const auto& bar : bars) {
+        if (bar.volume <= 0) {
+            continue;
+        }
+        Duration timeOfDay = std::chrono::duration_cast<Duration>(bar.timestamp.time_since_epoch()) % DAY;
+        if (timeOfDay < Duration::zero()) {
+            timeOfDay += DAY;
+        }
+        size_t bucket = static_cast<size_t>(timeOfDay / bucketSize_);
+        (*profile)[bucket] += bar.volume;
+        counts[bucket]++;
+    }
+
+    for (size_t i = 0; i < bucketsPerDay_; ++i) {
+        if (counts[i] > 0) {
+            (*profile)[i] /= counts[i];
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(profileMutex_);
+    profiles_[symbol] = profile;
+}
+
+bool VolumeProfileCache::hasProfile(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(profileMutex_);
+    return profiles_.count(symbol) > 0;
+}
+
+void VolumeProfileCache::removeProfile(const Symbol& symbol) {
+    std::lock_guard<std::mutex> lock(profileMutex_);
+    profiles_.erase(symbol);
+}
+
+void VolumeProfileCache::clear() {
+    std::lock_guard<std::mutex> lock(profileMutex_);
+    profiles_.clear();
+}
+
+std::vector<double> VolumeProfileCache::getSliceWeights(const Symbol& symbol, TimePoint start,
+                                                        Duration window, int slices) const {
+    slices = std::max(slices, 1);
+    std::vector<double> weights(slices, 1.0 / slices);
+
+    std::shared_ptr<const Profile> profile;
+    {
+        std::lock_guard<std::mutex> lock(profileMutex_);
+        auto it = profiles_.find(symbol);
+        if (it == profiles_.end()) {
+            return weights;
+        }
+        profile = it->second;
+    }
+
+    Duration step = window / slices;
+    if (step <= Duration::zero()) {
+        return weights;
+    }
+
+    // Integrate the bucket profile over each slice interval
+    Duration origin = std::chrono::duration_cast<Duration>(start.time_since_epoch()) % DAY;
+    if (origin < Duration::zero()) {
+        origin += DAY;
+    }
+    double total = 0;
+    for (int i = 0; i < slices; ++i) {
+        Duration t = origin + step * i;
+        Duration end = t + step;
+        double weight = 0;
+        while (t < end) {
+            Duration timeOfDay = t % DAY;
+            Duration bucketEnd = t - timeOfDay % bucketSize_ + bucketSize_;
+            Duration segment = std::min(end, bucketEnd) - t;
+            size_t bucket = std::min(static_cast<size_t>(timeOfDay / bucketSize_), bucketsPerDay_ - 1);
+            weight += (*profile)[bucket] * segment.count() / static_cast<double>(bucketSize_.count());
+            t += segment;
+        }
+        weights[i] = weight;
+        total += weight;
+    }
+
+    if (total <= 0) {
+        std::fill(weights.begin(), weights.end(), 1.0 / slices);
+        return weights;
+    }
+    for (auto& weight : weights) {
+        weight /= total;
+    }
+    return weights;
+}
+
+} // namespace MasterMind
@@ -0,0 +1,248 @@
+#include "core/ExposureTracker.h"
+#include "core/SeqLock.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MasterMind {
+
+namespace {
+constexpr double QUANTITY_EPSILON = 1e-9;
+
+void add(std::atomic<double>& value, double delta) {
+    value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+}
+
+ExposureTracker::ExposureTracker(double marginRate)
+    : states_(new SymbolState[SymbolRegistry::CAPACITY]),
+      totalsSequence_(0), grossExposure_(0), netExposure_(0), unrealizedPnL_(0),
+      realizedPnL_(0), margin_(0), openPositions_(0),
+      marginRate_(marginRate > 0 ? marginRate : 1.0) {
+    for (size_t i = 0; i < SymbolRegistry::CAPACITY; ++i) {
+        SymbolState& state = states_[i];
+        state.sequence.store(0, std::memory_order_relaxed);
+        state.position.store(0, std::memory_order_relaxed);
+        state.averagePrice.store(0, std::memory_order_relaxed);
+        state.markPrice.store(0, std::memory_order_relaxed);
+        state.realizedPnL.store(0, std::memory_order_relaxed);
+        state.marginRate.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ExposureTracker::onFill(const Symbol& symbol, OrderSide side, Volume quantity, Price price) {
+    if (quantity <= 0 || price <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    SymbolState* state = stateFor(symbol);
+    if (!state) {
+        return;
+    }
+
+    double position = state->position.load(std::memory_order_relaxed);
+    double average = state->averagePrice.load(std::memory_order_relaxed);
+    double delta = side == OrderSide::BUY ? quantity : -quantity;
+    double updated = position + delta;
+    double realized = 0;
+
+    if (position == 0 || (position > 0) == (delta > 0)) {
+        average = (std::abs(position) * average + quantity * price) / std::abs(updated);
+    } else {
+        // Reducing: realize P&L on the closed part, a flip opens the rest at the fill price
+        double closed = std::min(quantity, std::abs(position));
+        realized = closed * (price - average) * (position > 0 ? 1.0 : -1.0);
+        if (std::abs(updated) < QUANTITY_EPSILON) {
+            updated = 0;
+            average = 0;
+        } else if ((updated > 0) != (position > 0)) {
+            average = price;
+        }
+    }
+
+    double mark = state->markPrice.load(std::memory_order_relaxed);
+    publish(*state, updated, average, mark > 0 ? mark : price, realized,
+            state->marginRate.load(std::memory_order_relaxed));
+}
+
+void ExposureTracker::onMark(const Symbol& symbol, Price price) {
+    // Symbols never traded have nothing to mark - skip the lock
+    if (price <= 0 || registry_.find(symbol) == SymbolRegistry::INVALID_SLOT) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    SymbolState* state = stateFor(symbol);
+    publish(*state, state->position.load(std::memory_order_relaxed),
+            state->averagePrice.load(std::memory_order_relaxed), price, 0,
+            state->marginRate.load(std::memory_order_relaxed));
+}
+
+void ExposureTracker::setPosition(const Symbol& symbol, Volume signedQuantity, Price averagePrice, Price markPrice) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    SymbolState* state = stateFor(symbol);
+    if (!state) {
+        return;
+    }
+
+    if (markPrice <= 0) {
+        markPrice = state->markPrice.load(std::memory_order_relaxed);
+    }
+    publish(*state, signedQuantity, averagePrice, markPrice > 0 ? markPrice : averagePrice, 0,
+            state->marginRate.load(std::memory_order_relaxed));
+}
+
+void ExposureTracker::setMarginRate(double marginRate) {
+    if (marginRate <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    double change = marginRate - marginRate_.load(std::memory_order_relaxed);
+    marginRate_.store(marginRate, std::memory_order_relaxed);
+
+    // Symbol snapshots derive margin on read; only the total needs adjusting
+    double grossAtPortfolioRate = 0;
+    for (size_t slot = 0; slot < registry_.size(); ++slot) {
+        const SymbolState& state = states_[slot];
+        if (state.marginRate.load(std::memory_order_relaxed) <= 0) {
+            grossAtPortfolioRate += std::abs(state.position.load(std::memory_order_relaxed)) *
+                                    state.markPrice.load(std::memory_order_relaxed);
+        }
+    }
+
+    SeqLock::beginWrite(totalsSequence_);
+    add(margin_, grossAtPortfolioRate * change);
+    SeqLock::endWrite(totalsSequence_);
+}
+
+void ExposureTracker::setMarginRate(const Symbol& symbol, double marginRate) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    SymbolState* state = stateFor(symbol);
+    if (state) {
+        publish(*state, state->position.load(std::memory_order_relaxed),
+                state->averagePrice.load(std::memory_order_relaxed),
+                state->markPrice.load(std::memory_order_relaxed), 0, marginRate);
+    }
+}
+
+void ExposureTracker::reset() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+
+    for (size_t slot = 0; slot < registry_.size(); ++slot) {
+        SymbolState& state = states_[slot];
+        SeqLock::beginWrite(state.sequence);
+        state.position.store(0, std::memory_order_relaxed);
+        state.averagePrice.store(0, std::memory_order_relaxed);
+        state.realizedPnL.store(0, std::memory_order_relaxed);
+        SeqLock::endWrite(state.sequence);
+    }
+
+    // Starting the totals from zero also drops accumulated rounding drift
+    SeqLock::beginWrite(totalsSequence_);
+    grossExposure_.store(0, std::memory_order_relaxed);
+    netExposure_.store(0, std::memory_order_relaxed);
+    unrealizedPnL_.store(0, std::memory_order_relaxed);
+    realizedPnL_.store(0, std::memory_order_relaxed);
+    margin_.store(0, std::memory_order_relaxed);
+    openPositions_.store(0, std::memory_order_relaxed);
+    SeqLock::endWrite(totalsSequence_);
+}
+
+SymbolExposure ExposureTracker::getSymbolExposure(const Symbol& symbol) const {
+    SymbolExposure result;
+    SymbolRegistry::SlotId slot = registry_.find(symbol);
+    if (slot == SymbolRegistry::INVALID_SLOT) {
+        return result;
+    }
+
+    const SymbolState& state = states_[slot];
+    double marginRate;
+    uint32_t begin;
+    do {
+        begin = SeqLock::beginRead(state.sequence);
+        result.position = state.position.load(std::memory_order_relaxed);
+        result.averagePrice = state.averagePrice.load(std::memory_order_relaxed);
+        result.markPrice = state.markPrice.load(std::memory_order_relaxed);
+        result.realizedPnL = state.realizedPnL.load(std::memory_order_relaxed);
+        marginRate = state.marginRate.load(std::memory_order_relaxed);
+    } while (!SeqLock::endRead(state.sequence, begin));
+
+    if (marginRate <= 0) {
+        marginRate = marginRate_.load(std::memory_order_relaxed);
+    }
+    result.exposure = std::abs(result.position) * result.markPrice;
+    result.unrealizedPnL = result.position * (result.markPrice - result.averagePrice);
+    result.margin = result.exposure * marginRate;
+    return result;
+}
+
+Volume ExposureTracker::getPosition(const Symbol& symbol) const {
+    SymbolRegistry::SlotId slot = registry_.find(symbol);
+    if (slot == SymbolRegistry::INVALID_SLOT) {
+        return 0;
+    }
+    return states_[slot].position.load(std::memory_order_relaxed);
+}
+
+PortfolioExposure ExposureTracker::getPortfolioExposure() const {
+    PortfolioExposure result;
+    uint32_t begin;
+    do {
+        begin = SeqLock::beginRead(totalsSequence_);
+        result.grossExposure = grossExposure_.load(std::memory_order_relaxed);
+        result.netExposure = netExposure_.load(std::memory_order_relaxed);
+        result.unrealizedPnL = unrealizedPnL_.load(std::memory_order_relaxed);
+        result.realizedPnL = realizedPnL_.load(std::memory_order_relaxed);
+        result.margin = margin_.load(std::memory_order_relaxed);
+        result.openPositions = openPositions_.load(std::memory_order_relaxed);
+    } while (!SeqLock::endRead(totalsSequence_, begin));
+    return result;
+}
+
+// Private methods
+ExposureTracker::SymbolState* ExposureTracker::stateFor(const Symbol& symbol) {
+    SymbolRegistry::SlotId slot = registry_.registerSymbol(symbol);
+    return slot != SymbolRegistry::INVALID_SLOT ? &states_[slot] : nullptr;
+}
+
+ExposureTracker::Contribution ExposureTracker::contribution(const SymbolState& state) const {
+    Contribution result;
+    double position = state.position.load(std::memory_order_relaxed);
+    double mark = state.markPrice.load(std::memory_order_relaxed);
+    double rate = state.marginRate.load(std::memory_order_relaxed);
+
+    result.open = position != 0;
+    result.gross = std::abs(position) * mark;
+    result.net = position * mark;
+    result.unrealized = position * (mark - state.averagePrice.load(std::memory_order_relaxed));
+    result.margin = result.gross * (rate > 0 ? rate : marginRate_.load(std::memory_order_relaxed));
+    return result;
+}
+
+void ExposureTracker::publish(SymbolState& state, double position, double averagePrice, double markPrice,
+                              double realizedDelta, double marginRate) {
+    Contribution before = contribution(state);
+
+    SeqLock::beginWrite(state.sequence);
+    state.position.store(position, std::memory_order_relaxed);
+    state.averagePrice.store(averagePrice, std::memory_order_relaxed);
+    state.markPrice.store(markPrice, std::memory_order_relaxed);
+    add(state.realizedPnL, realizedDelta);
+    state.marginRate.store(marginRate, std::memory_order_relaxed);
+    SeqLock::endWrite(state.sequence);
+
+    Contribution after = contribution(state);
+
+    SeqLock::beginWrite(totalsSequence_);
+    add(grossExposure_, after.gross - before.gross);
+    add(netExposure_, after.net - before.net);
+    add(unrealizedPnL_, after.unrealized - before.unrealized);
+    add(realizedPnL_, realizedDelta);
+    add(margin_, after.margin - before.margin);
+    openPositions_.store(openPositions_.load(std::memory_order_relaxed) + after.open - before.open,
+                         std::memory_order_relaxed);
+    SeqLock::endWrite(totalsSequence_);
+}
+
+} // namespace MasterMind
@@ -0,0 +1,285 @@
+#include "core/MonteCarloRiskSimulator.h"
+#include "core/StreamingRiskEstimator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace MasterMind {
+
+namespace {
+constexpr size_t LANES = 16;
+constexpr int PERCENTILES = 101;
+constexpr size_t HISTOGRAM_BINS = 4096;
+
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256**: small state, fast, one independent stream per worker
+class PathRng {
+public:
+    PathRng(uint64_t seed, uint64_t stream) {
+        uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+        for (auto& word : s_) {
+            word = splitMix64(state);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    // Unbiased enough for bootstrap sizes, and no division
+    size_t below(size_t bound) {
+        return static_cast<size_t>(((next() >> 32) * static_cast<uint64_t>(bound)) >> 32);
+    }
+
+private:
+    uint64_t s_[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+// Fixed-range histogram: counter returns are bounded, so a bin increment
+// replaces a sketch insert on the hottest accumulation path
+class BoundedHistogram {
+public:
+    BoundedHistogram(double low, double high)
+        : low_(low), scale_(high > low ? HISTOGRAM_BINS / (high - low) : 0), bins_(HISTOGRAM_BINS, 0) {
+    }
+
+    void add(double value) {
+        double position = (value - low_) * scale_;
+        size_t bin = static_cast<size_t>(std::min(std::max(position, 0.0), HISTOGRAM_BINS - 1.0));
+        bins_[bin]++;
+    }
+
+    void merge(const BoundedHistogram& other) {
+        for (size_t i = 0; i < HISTOGRAM_BINS; ++i) {
+            bins_[i] += other.bins_[i];
+        }
+    }
+
+    std::vector<double> percentiles() const {
+        std::vector<double> values(PERCENTILES, low_);
+        uint64_t total = 0;
+        for (uint64_t count : bins_) {
+            total += count;
+        }
+        if (total == 0 || scale_ == 0) {
+            return values;
+        }
+
+        // Interpolate linearly inside the bin holding each rank
+        uint64_t cumulative = 0;
+        size_t bin = 0;
+        for (int p = 0; p < PERCENTILES; ++p) {
+            double rank = p / 100.0 * total;
+            while (bin + 1 < HISTOGRAM_BINS && cumulative + bins_[bin] < rank) {
+                cumulative += bins_[bin++];
+            }
+            double fraction = bins_[bin] > 0 ? (rank - cumulative) / bins_[bin] : 0;
+            values[p] = low_ + (bin + std::min(std::max(fraction, 0.0), 1.0)) / scale_;
+        }
+        return values;
+    }
+
+private:
+    double low_;
+    double scale_;
+    std::vector<uint64_t> bins_;
+};
+
+struct WorkerResult {
+    TDigest maxDrawdowns;
+    TDigest finalEquity;
+    BoundedHistogram counterReturns;
+    std::vector<uint64_t> ruinedByCounter;
+    double drawdownSum = 0;
+    double equitySum = 0;
+    double paperTrades = 0;
+    double trades = 0;
+
+    WorkerResult(double counterLow, double counterHigh) : counterReturns(counterLow, counterHigh) {}
+};
+
+std::vector<double> percentiles(const TDigest& digest) {
+    std::vector<double> values(PERCENTILES);
+    for (int p = 0; p < PERCENTILES; ++p) {
+        values[p] = digest.quantile(p / 100.0);
+    }
+    return values;
+}
+}
+
+MonteCarloRiskSimulator::MonteCarloRiskSimulator(const RiskParameters& params)
+    : params_(params) {
+}
+
+void MonteCarloRiskSimulator::setRiskParameters(const RiskParameters& params) {
+    params_ = params;
+}
+
+void MonteCarloRiskSimulator::setTradeResults(const std::vector<double>& rMultiples) {
+    tradeResults_ = rMultiples;
+}
+
+size_t MonteCarloRiskSimulator::getTradeResultCount() const {
+    return tradeResults_.size();
+}
+
+MonteCarloResult MonteCarloRiskSimulator::run(const MonteCarloConfig& config) const {
+    MonteCarloResult result;
+    if (tradeResults_.empty() || config.paths == 0 || config.counters <= 0) {
+        return result;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    const int counters = config.counters;
+    const int tradesPerCounter = std::max(params_.ordersPerCounter, 1);
+    const double riskFraction = params_.dailyRiskPercent;
+    const double lossLimit = std::max(params_.consecutiveLossLimit, 1);
+    const double liveAfterWins = std::max(config.liveAfterWins, 1);
+    const double ruinLevel = 1.0 - config.ruinDrawdown;
+    const double* results = tradeResults_.data();
+    const size_t resultCount = tradeResults_.size();
+
+    const uint64_t batches = (config.paths + LANES - 1) / LANES;
+    unsigned threadCount = config.threads > 0 ? config.threads : std::thread::hardware_concurrency();
+    threadCount = static_cast<unsigned>(std::max<uint64_t>(1, std::min<uint64_t>(std::max(threadCount, 1u), batches)));
+
+    // A counter's return lies between all-worst and all-best live trades
+    auto bounds = std::minmax_element(tradeResults_.begin(), tradeResults_.end());
+    double counterLow = std::pow(std::max(0.0, 1.0 + std::min(*bounds.first, 0.0) * riskFraction), tradesPerCounter) - 1.0;
+    double counterHigh = std::pow(1.0 + std::max(*bounds.second, 0.0) * riskFraction, tradesPerCounter) - 1.0;
+
+    std::vector<WorkerResult> workers(threadCount, WorkerResult(counterLow, counterHigh));
+    auto simulate = [&](unsigned worker) {
+        WorkerResult& out = workers[worker];
+        out.ruinedByCounter.assign(counters, 0);
+        PathRng rng(config.seed, worker);
+
+        uint64_t firstBatch = batches * worker / threadCount;
+        uint64_t lastBatch = batches * (worker + 1) / threadCount;
+
+        // Lane state as structure of arrays; flags are 0/1 doubles so updates stay branchless
+        alignas(64) double equity[LANES], peak[LANES], maxDrawdown[LANES], counterStart[LANES];
+        alignas(64) double losses[LANES], wins[LANES], paper[LANES], ruined[LANES], paperTrades[LANES];
+        alignas(64) double draw[LANES];
+
+        for (uint64_t batch = firstBatch; batch < lastBatch; ++batch) {
+            size_t lanes = static_cast<size_t>(std::min<uint64_t>(LANES, config.paths - batch * LANES));
+
+            for (size_t l = 0; l < LANES; ++l) {
+                equity[l] = peak[l] = 1.0;
+                maxDrawdown[l] = losses[l] = wins[l] = paper[l] = ruined[l] = paperTrades[l] = 0;
+            }
+
+            for (int counter = 0; counter < counters; ++counter) {
+                for (size_t l = 0; l < LANES; ++l) {
+                    counterStart[l] = equity[l];
+                }
+
+                for (int trade = 0; trade < tradesPerCounter; ++trade) {
+                    for (size_t l = 0; l < LANES; ++l) {
+                        draw[l] = results[rng.below(resultCount)];
+                    }
+
+                    for (size_t l = 0; l < LANES; ++l) {
+                        double alive = 1.0 - ruined[l];
+                        double live = (1.0 - paper[l]) * alive;
+                        paperTrades[l] += paper[l] * alive;
+                        equity[l] *= 1.0 + live * draw[l] * riskFraction;
+
+                        double loss = draw[l] < 0 ? 1.0 : 0.0;
+                        losses[l] = (losses[l] + 1.0) * loss;
+                        wins[l] = (wins[l] + 1.0) * (1.0 - loss);
+                        double toPaper = (1.0 - paper[l]) * (losses[l] >= lossLimit ? 1.0 : 0.0);
+                        double toLive = paper[l] * (wins[l] >= liveAfterWins ? 1.0 : 0.0);
+                        paper[l] += toPaper - toLive;
+
+                        peak[l] = std::max(peak[l], equity[l]);
+                        maxDrawdown[l] = std::max(maxDrawdown[l], 1.0 - equity[l] / peak[l]);
+                        ruined[l] = std::max(ruined[l], equity[l] <= ruinLevel ? 1.0 : 0.0);
+                    }
+                }
+
+                for (size_t l = 0; l < lanes; ++l) {
+                    out.counterReturns.add(equity[l] / counterStart[l] - 1.0);
+                    out.ruinedByCounter[counter] += ruined[l] > 0;
+                }
+            }
+
+            for (size_t l = 0; l < lanes; ++l) {
+                out.maxDrawdowns.add(maxDrawdown[l]);
+                out.finalEquity.add(equity[l]);
+                out.drawdownSum += maxDrawdown[l];
+                out.equitySum += equity[l];
+                out.paperTrades += paperTrades[l];
+            }
+            out.trades += static_cast<double>(lanes) * counters * tradesPerCounter;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned worker = 1; worker < threadCount; ++worker) {
+        threads.emplace_back(simulate, worker);
+    }
+    simulate(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Combine the workers' accumulators
+    TDigest maxDrawdowns;
+    TDigest finalEquity;
+    BoundedHistogram counterReturns(counterLow, counterHigh);
+    std::vector<uint64_t> ruinedByCounter(counters, 0);
+    double drawdownSum = 0;
+    double equitySum = 0;
+    double paperTrades = 0;
+    double trades = 0;
+    for (const auto& worker : workers) {
+        maxDrawdowns.merge(worker.maxDrawdowns);
+        finalEquity.merge(worker.finalEquity);
+        counterReturns.merge(worker.counterReturns);
+        for (int counter = 0; counter < counters; ++counter) {
+            ruinedByCounter[counter] += worker.ruinedByCounter[counter];
+        }
+        drawdownSum += worker.drawdownSum;
+        equitySum += worker.equitySum;
+        paperTrades += worker.paperTrades;
+        trades += worker.trades;
+    }
+
+    double paths = static_cast<double>(config.paths);
+    result.paths = config.paths;
+    result.ruinProbabilityByCounter.resize(counters);
+    for (int counter = 0; counter < counters; ++counter) {
+        result.ruinProbabilityByCounter[counter] = ruinedByCounter[counter] / paths;
+    }
+    result.ruinProbability = result.ruinProbabilityByCounter.back();
+    result.meanMaxDrawdown = drawdownSum / paths;
+    result.maxDrawdownPercentiles = percentiles(maxDrawdowns);
+    result.meanFinalEquity = equitySum / paths;
+    result.finalEquityPercentiles = percentiles(finalEquity);
+    result.counterReturnPercentiles = counterReturns.percentiles();
+    result.paperTradeFraction = trades > 0 ? paperTrades / trades : 0;
+    result.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+} // namespace MasterMind
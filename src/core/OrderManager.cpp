@@ -1,14 +1,60 @@
 #include "core/OrderManager.h"
 #include "api/ExchangeAPI.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 
 namespace MasterMind {
 
+namespace {
+constexpr Volume QUANTITY_EPSILON = 1e-9;
+constexpr int MAX_FAILED_SLICES = 3;
+constexpr Duration VOLUME_PROFILE_LOOKBACK = std::chrono::hours(24 * 7);
+constexpr Duration VOLUME_PROFILE_REFRESH = std::chrono::hours(24);
+
+// Peg price pegOffset behind the same-side touch, never through the parent's
+// limit. Our own resting child is skipped when it alone makes up the touch,
+// otherwise the peg would chase itself and never step back.
+Price pegToBook(const Order& parent, Price pegOffset, double tickSize, const OrderBook* book,
+                Price ownPrice, Volume ownQuantity) {
+    Price touch = 0;
+    if (book) {
+        for (const auto& level : book->getDepth(parent.side, 2)) {
+            bool ownLevel = ownQuantity > 0 && std::abs(level.price - ownPrice) < 1e-12 &&
+                            level.quantity <= ownQuantity + QUANTITY_EPSILON;
+            if (!ownLevel) {
+                touch = level.price;
+                break;
+            }
+        }
+    }
+    if (touch <= 0) {
+        return parent.price;
+    }
+    
+    bool buy = parent.side == OrderSide::BUY;
+    Price peg = buy ? touch - pegOffset : touch + pegOffset;
+    if (tickSize > 0) {
+        peg = buy ? std::floor(peg / tickSize + 1e-9) * tickSize
+                  : std::ceil(peg / tickSize - 1e-9) * tickSize;
+    }
+    if (parent.price > 0) {
+        peg = buy ? std::min(peg, parent.price) : std::max(peg, parent.price);
+    }
+    return peg;
+}
+}
+
 OrderManager::OrderManager() 
-    : running_(false), smartRoutingEnabled_(true), maxSlippagePercent_(0.01), 
-      riskValidationEnabled_(true) {
+    : router_(std::make_unique<SmartOrderRouter>()), maxSplitSlices_(4),
+      volumeProfiles_(std::make_shared<VolumeProfileCache>()),
+      running_(false), timerWheel_(nullptr), orderTimeout_(Duration::zero()),
+      smartRoutingEnabled_(true), maxSlippagePercent_(0.01), 
+      riskValidationEnabled_(true), stopEngine_(std::make_unique<StopEngine>()),
+      activeHybridCount_(0),
+      minRepegInterval_(std::chrono::milliseconds(100)) {
     
     std::cout << "OrderManager initialized" << std::endl;
 }
@@ -17,6 +63,7 @@ OrderManager::~OrderManager() {
     if (running_) {
         stop();
     }
+    setTimerWheel(nullptr);
 }
 
 bool OrderManager::initialize() {
@@ -31,9 +78,12 @@ void OrderManager::start() {
     
     running_ = true;
     
-    // Start worker threads (stub implementation)
+    // Start worker threads. Expiry runs on the shared timer wheel when one is
+    // attached, so the polling status thread is only needed standalone.
     orderProcessingThread_ = std::thread(&OrderManager::orderProcessingWorker, this);
-    statusUpdateThread_ = std::thread(&OrderManager::statusUpdateWorker, this);
+    if (!timerWheel_) {
+        statusUpdateThread_ = std::thread(&OrderManager::statusUpdateWorker, this);
+    }
     
     std::cout << "OrderManager started" << std::endl;
 }
@@ -76,6 +126,7 @@ OrderId OrderManager::submitOrder(const Order& order) {
         std::lock_guard<std::mutex> lock(ordersMutex_);
         activeOrders_[newOrder.orderId] = newOrder;
         orderQueue_.push(newOrder);
+        scheduleExpiry(newOrder.orderId);
     }
     
     orderCV_.notify_one();
@@ -87,37 +138,116 @@ OrderId OrderManager::submitOrder(const Order& order) {
 }
 
 bool OrderManager::cancelOrder(const OrderId& orderId) {
-    std::lock_guard<std::mutex> lock(ordersMutex_);
-    
-    auto it = activeOrders_.find(orderId);
-    if (it != activeOrders_.end()) {
-        it->second.status = OrderStatus::CANCELLED;
-        updateOrderStatus(orderId, OrderStatus::CANCELLED);
+    std::vector<std::pair<ExchangeAPI*, OrderId>> venueOrders;
+    {
+        std::unique_lock<std::mutex> lock(ordersMutex_);
         
-        std::cout << "Order cancelled: " << orderId << std::endl;
-        return true;
+        auto it = activeOrders_.find(orderId);
+        if (it == activeOrders_.end()) {
+            return false;
+        }
+        
+        // Resting local stop - nothing at a venue yet
+        if (stopLossOrders_.count(orderId)) {
+            releaseStop(orderId);
+            it->second.status = OrderStatus::CANCELLED;
+            it->second.updateTime = std::chrono::system_clock::now();
+            Order cancelled = it->second;
+            lock.unlock();
+            
+            std::cout << "Order cancelled: " << orderId << std::endl;
+            notifyOrderUpdate(cancelled);
+            moveToHistory(orderId);
+            return true;
+        }
+        
+        venueOrders = collectVenueOrders(orderId);
+        
+        // Scheduled parents stop slicing; open children are cancelled below
+        auto scheduledIt = scheduledExecutions_.find(orderId);
+        if (scheduledIt != scheduledExecutions_.end()) {
+            ScheduledExecution& execution = scheduledIt->second;
+            execution.cancelled = true;
+            if (timerWheel_ && execution.timer != TimerWheel::INVALID_TIMER) {
+                timerWheel_->cancel(execution.timer);
+            }
+            execution.timer = TimerWheel::INVALID_TIMER;
+            
+            if (venueOrders.empty()) {
+                Order parent;
+                bool completed = completeScheduledExecution(orderId, parent);
+                lock.unlock();
+                if (completed) {
+                    std::cout << "Order cancelled: " << orderId << std::endl;
+                    notifyOrderUpdate(parent);
+                    moveToHistory(orderId);
+                }
+                return true;
+            }
+        } else if (hybridOrders_.count(orderId)) {
+            HybridOrderInfo& info = hybridOrders_[orderId];
+            info.cancelled = true;
+            
+            if (venueOrders.empty()) {
+                Order parent;
+                bool completed = completeHybridOrder(orderId, parent);
+                lock.unlock();
+                if (completed) {
+                    std::cout << "Order cancelled: " << orderId << std::endl;
+                    notifyOrderUpdate(parent);
+                    moveToHistory(orderId);
+                }
+                return true;
+            }
+        } else if (venueOrders.empty()) {
+            // Not sent yet - the processing thread drops it
+            it->second.status = OrderStatus::CANCELLED;
+            it->second.updateTime = std::chrono::system_clock::now();
+            
+            std::cout << "Order cancelled: " << orderId << std::endl;
+            return true;
+        }
     }
     
-    return false;
+    // The exchange confirms through onOrderUpdate (called without our lock held)
+    bool cancelled = false;
+    for (const auto& venueOrder : venueOrders) {
+        cancelled = venueOrder.first->cancelOrder(venueOrder.second) || cancelled;
+    }
+    return cancelled;
 }
 
 bool OrderManager::modifyOrder(const OrderId& orderId, const Order& newOrder) {
-    std::lock_guard<std::mutex> lock(ordersMutex_);
-    
-    auto it = activeOrders_.find(orderId);
-    if (it != activeOrders_.end() && it->second.status == OrderStatus::PENDING) {
-        Order modified = it->second;
-        modified.price = newOrder.price;
-        modified.quantity = newOrder.quantity;
-        modified.updateTime = std::chrono::system_clock::now();
+    ExchangeAPI* api = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
         
-        activeOrders_[orderId] = modified;
+        auto it = activeOrders_.find(orderId);
+        if (it == activeOrders_.end()) {
+            return false;
+        }
         
-        std::cout << "Order modified: " << orderId << std::endl;
-        return true;
+        if (it->second.status == OrderStatus::PENDING) {
+            Order modified = it->second;
+            modified.price = newOrder.price;
+            modified.quantity = newOrder.quantity;
+            modified.updateTime = std::chrono::system_clock::now();
+            
+            activeOrders_[orderId] = modified;
+            
+            std::cout << "Order modified: " << orderId << std::endl;
+            return true;
+        }
+        
+        // Orders split across venues cannot be amended as a whole
+        auto routeIt = orderRouting_.find(orderId);
+        if (routeIt == orderRouting_.end()) {
+            return false;
+        }
+        api = getExchange(routeIt->second);
     }
     
-    return false;
+    return api && api->modifyOrder(orderId, newOrder);
 }
 
 Order OrderManager::getOrder(const OrderId& orderId) const {
@@ -160,6 +290,13 @@ std::vector<Order> OrderManager::getOrderHistory(const Symbol& symbol) const {
     return orders;
 }
 
+Price OrderManager::getStopLevel(const OrderId& orderId) const {
+    std::lock_guard<std::mutex> lock(ordersMutex_);
+    
+    auto it = stopLossOrders_.find(orderId);
+    return it != stopLossOrders_.end() ? stopEngine_->getStopPrice(it->second.stopId) : 0;
+}
+
 OrderStatus OrderManager::getOrderStatus(const OrderId& orderId) const {
     std::lock_guard<std::mutex> lock(ordersMutex_);
     
@@ -171,26 +308,64 @@ OrderStatus OrderManager::getOrderStatus(const OrderId& orderId) const {
     return OrderStatus::REJECTED; // Default if not found
 }
 
+void OrderManager::onTick(const Tick& tick) {
+    Price price = tick.last > 0 ? tick.last : (tick.bid + tick.ask) / 2.0;
+    checkStops(tick.symbol, price);
+}
+
 void OrderManager::onOrderUpdate(const Order& order) {
+    OrderId parentId;
     {
         std::lock_guard<std::mutex> lock(ordersMutex_);
-        activeOrders_[order.orderId] = order;
+        auto parentIt = childToParent_.find(order.orderId);
+        if (parentIt != childToParent_.end()) {
+            parentId = parentIt->second;
+        } else if (!activeOrders_.count(order.orderId) && orderHistory_.count(order.orderId)) {
+            return;  // Late report for an order we already completed
+        } else {
+            activeOrders_[order.orderId] = order;
+        }
+    }
+    
+    if (!parentId.empty()) {
+        onChildOrderUpdate(parentId, order);
+        return;
+    }
+    
+    bool complete = order.status == OrderStatus::FILLED || 
+                    order.status == OrderStatus::CANCELLED ||
+                    order.status == OrderStatus::REJECTED ||
+                    order.status == OrderStatus::EXPIRED;
+    if (order.status == OrderStatus::SUBMITTED) {
+        router_->onOrderAcknowledged(order.orderId);
+    } else if (complete) {
+        router_->onOrderCompleted(order.orderId);
     }
     
     notifyOrderUpdate(order);
     
-    if (order.status == OrderStatus::FILLED || 
-        order.status == OrderStatus::CANCELLED ||
-        order.status == OrderStatus::REJECTED) {
+    if (complete) {
         moveToHistory(order.orderId);
     }
 }
 
-void OrderManager::onFillUpdate(const OrderId& orderId, Volume fillQuantity, Price fillPrice) {
-    std::lock_guard<std::mutex> lock(ordersMutex_);
+void OrderManager::onFillUpdate(const OrderId& venueOrderId, Volume fillQuantity, Price fillPrice) {
+    router_->onOrderFill(venueOrderId, fillQuantity, fillPrice);
     
-    auto it = activeOrders_.find(orderId);
-    if (it != activeOrders_.end()) {
+    // Callbacks fire on a copy after the lock is released: a strategy or the
+    // risk manager reacting to the fill may call back into the order manager
+    Order filled;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        
+        // Fills of split children accrue to the parent order
+        auto parentIt = childToParent_.find(venueOrderId);
+        const OrderId& orderId = parentIt != childToParent_.end() ? parentIt->second : venueOrderId;
+        
+        auto it = activeOrders_.find(orderId);
+        if (it == activeOrders_.end()) {
+            return;
+        }
         it->second.filledQuantity += fillQuantity;
         it->second.updateTime = std::chrono::system_clock::now();
         
@@ -200,6 +375,21 @@ void OrderManager::onFillUpdate(const OrderId& orderId, Volume fillQuantity, Pri
             it->second.status = OrderStatus::PARTIALLY_FILLED;
         }
         
+        auto scheduledIt = scheduledExecutions_.find(orderId);
+        if (scheduledIt != scheduledExecutions_.end()) {
+            ScheduledExecution& execution = scheduledIt->second;
+            ExecutionProgress& progress = execution.progress;
+            execution.failedSlices = 0;
+            execution.fillNotional += fillQuantity * fillPrice;
+            progress.filledQuantity += fillQuantity;
+            progress.averageFillPrice = execution.fillNotional / progress.filledQuantity;
+            if (progress.arrivalPrice > 0) {
+                double direction = it->second.side == OrderSide::BUY ? 1.0 : -1.0;
+                progress.slippage = direction * (progress.averageFillPrice - progress.arrivalPrice) /
+                                    progress.arrivalPrice;
+            }
+        }
+        
         // Calculate slippage
         double slippage = calculateSlippage(it->second, fillPrice);
         updateSlippageStats(it->second.symbol, slippage);
@@ -208,14 +398,20 @@ void OrderManager::onFillUpdate(const OrderId& orderId, Volume fillQuantity, Pri
                   << " (" << fillQuantity << " @ " << fillPrice 
                   << ", slippage: " << slippage << ")" << std::endl;
         
-        if (fillCallback_) {
-            fillCallback_(orderId, fillQuantity, fillPrice);
-        }
+        filled = it->second;
+    }
+    
+    if (fillCallback_) {
+        fillCallback_(filled.orderId, fillQuantity, fillPrice);
+    }
+    if (tradeCallback_) {
+        tradeCallback_(filled, fillQuantity, fillPrice);
     }
 }
 
 void OrderManager::onOrderRejected(const OrderId& orderId, const std::string& reason) {
     updateOrderStatus(orderId, OrderStatus::REJECTED);
+    moveToHistory(orderId);
     
     std::cout << "Order rejected: " << orderId << " - " << reason << std::endl;
     
@@ -224,6 +420,31 @@ void OrderManager::onOrderRejected(const OrderId& orderId, const std::string& re
     }
 }
 
+void OrderManager::onOrderBookUpdate(Exchange exchange, const Symbol& symbol) {
+    // Called on the feed thread for every book change - stay cheap
+    if (activeHybridCount_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        bool pegged = false;
+        for (const auto& pair : hybridOrders_) {
+            if (pair.second.symbol == symbol && pair.second.exchange == exchange) {
+                pegged = true;
+                break;
+            }
+        }
+        
+        // Coalesce: a symbol is queued at most once until the worker drains it
+        if (!pegged || !pendingRepegs_.insert(symbol).second) {
+            return;
+        }
+        repegQueue_.push(symbol);
+    }
+    orderCV_.notify_one();
+}
+
 void OrderManager::setOrderCallback(OrderCallback callback) {
     orderCallback_ = callback;
 }
@@ -232,6 +453,10 @@ void OrderManager::setFillCallback(std::function<void(const OrderId&, Volume, Pr
     fillCallback_ = callback;
 }
 
+void OrderManager::setTradeCallback(std::function<void(const Order&, Volume, Price)> callback) {
+    tradeCallback_ = callback;
+}
+
 void OrderManager::setRejectionCallback(std::function<void(const OrderId&, const std::string&)> callback) {
     rejectionCallback_ = callback;
 }
@@ -292,7 +517,22 @@ void OrderManager::orderProcessingWorker() {
     std::unique_lock<std::mutex> lock(ordersMutex_);
     
     while (running_) {
-        orderCV_.wait(lock, [this] { return !orderQueue_.empty() || !running_; });
+        orderCV_.wait(lock, [this] {
+            return !orderQueue_.empty() || !dueSlices_.empty() || !hybridRefills_.empty() ||
+                   !repegQueue_.empty() || !profileRefreshes_.empty() || !running_;
+        });
+        
+        // Volume profiles first, so queued VWAP parents plan on fresh ones
+        while (!profileRefreshes_.empty() && running_) {
+            Symbol symbol = profileRefreshes_.front();
+            profileRefreshes_.pop();
+            
+            lock.unlock();
+            
+            refreshVolumeProfile(symbol);
+            
+            lock.lock();
+        }
         
         while (!orderQueue_.empty() && running_) {
             Order order = orderQueue_.front();
@@ -300,11 +540,46 @@ void OrderManager::orderProcessingWorker() {
             
             lock.unlock();
             
-            // Process order (stub implementation)
             processOrder(order);
             
             lock.lock();
         }
+        
+        // Slices of scheduled parents queued by their timers
+        while (!dueSlices_.empty() && running_) {
+            OrderId parentId = dueSlices_.front();
+            dueSlices_.pop();
+            
+            lock.unlock();
+            
+            processDueSlice(parentId);
+            
+            lock.lock();
+        }
+        
+        // Hybrid orders: refills after child completion, then re-pegs
+        while (!hybridRefills_.empty() && running_) {
+            OrderId parentId = hybridRefills_.front();
+            hybridRefills_.pop();
+            
+            lock.unlock();
+            
+            submitNextSlice(parentId);
+            
+            lock.lock();
+        }
+        
+        while (!repegQueue_.empty() && running_) {
+            Symbol symbol = repegQueue_.front();
+            repegQueue_.pop();
+            pendingRepegs_.erase(symbol);
+            
+            lock.unlock();
+            
+            repegHybridOrders(symbol);
+            
+            lock.lock();
+        }
     }
 }
 
@@ -318,20 +593,38 @@ void OrderManager::statusUpdateWorker() {
 }
 
 void OrderManager::processOrder(const Order& order) {
-    // Stub implementation - simulate order processing
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    
-    Order updatedOrder = order;
-    updatedOrder.status = OrderStatus::SUBMITTED;
-    updatedOrder.updateTime = std::chrono::system_clock::now();
+    std::shared_ptr<ExecutionStrategy> strategy;
+    bool hybrid = false;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto it = activeOrders_.find(order.orderId);
+        if (it == activeOrders_.end() || it->second.status != OrderStatus::PENDING) {
+            return;  // Cancelled or expired while queued
+        }
+        hybrid = hybridOrders_.count(order.orderId) > 0;
+        
+        // Slicing needs the timer wheel; without one orders route immediately.
+        // Triggered stop exits are never sliced.
+        auto strategyIt = executionStrategies_.find(order.symbol);
+        if (strategyIt != executionStrategies_.end() && timerWheel_ && order.triggerPrice <= 0) {
+            strategy = strategyIt->second;
+        }
+    }
     
-    onOrderUpdate(updatedOrder);
+    if (hybrid) {
+        Order hybridOrder = order;
+        executeHybridOrder(hybridOrder);
+        return;
+    }
     
-    // Simulate execution after some time
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (strategy && startScheduledExecution(order, strategy)) {
+        return;
+    }
     
-    // Simulate fill
-    onFillUpdate(order.orderId, order.quantity, order.price);
+    Order routedOrder = order;
+    if (!routeOrder(routedOrder)) {
+        moveToHistory(order.orderId);
+    }
 }
 
 bool OrderManager::validateOrder(const Order& order) const {
@@ -376,10 +669,97 @@ void OrderManager::moveToHistory(const OrderId& orderId) {
         orderHistory_[orderId] = it->second;
         activeOrders_.erase(it);
     }
+    orderRouting_.erase(orderId);
+    clearExpiry(orderId);
+    releaseHybridOrder(orderId);
+    releaseStop(orderId);
 }
 
 void OrderManager::cleanupExpiredOrders() {
-    // Stub implementation
+    // Polling fallback used when no timer wheel is attached
+    std::vector<OrderId> expired;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto now = std::chrono::system_clock::now();
+        for (const auto& pair : orderDeadlines_) {
+            if (pair.second <= now) {
+                expired.push_back(pair.first);
+            }
+        }
+    }
+    
+    for (const auto& orderId : expired) {
+        expireOrder(orderId);
+    }
+}
+
+void OrderManager::expireOrder(const OrderId& orderId) {
+    Order expiredOrder;
+    std::vector<std::pair<ExchangeAPI*, OrderId>> venueOrders;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        expiryTimers_.erase(orderId);
+        orderDeadlines_.erase(orderId);
+        
+        auto it = activeOrders_.find(orderId);
+        if (it == activeOrders_.end() || it->second.status == OrderStatus::FILLED) {
+            return;
+        }
+        
+        it->second.status = OrderStatus::EXPIRED;
+        it->second.updateTime = std::chrono::system_clock::now();
+        expiredOrder = it->second;
+        orderHistory_[orderId] = it->second;
+        activeOrders_.erase(it);
+        
+        venueOrders = collectVenueOrders(orderId);
+        orderRouting_.erase(orderId);
+        
+        auto scheduledIt = scheduledExecutions_.find(orderId);
+        if (scheduledIt != scheduledExecutions_.end()) {
+            if (timerWheel_ && scheduledIt->second.timer != TimerWheel::INVALID_TIMER) {
+                timerWheel_->cancel(scheduledIt->second.timer);
+            }
+            scheduledIt->second.progress.complete = true;
+            executionHistory_[orderId] = scheduledIt->second.progress;
+            scheduledExecutions_.erase(scheduledIt);
+        }
+        releaseHybridOrder(orderId);
+    }
+    
+    for (const auto& venueOrder : venueOrders) {
+        venueOrder.first->cancelOrder(venueOrder.second);
+    }
+    
+    std::cout << "Order expired: " << orderId << std::endl;
+    notifyOrderUpdate(expiredOrder);
+}
+
+void OrderManager::scheduleExpiry(const OrderId& orderId) {
+    // Caller holds ordersMutex_
+    if (orderTimeout_.count() <= 0) {
+        return;
+    }
+    
+    orderDeadlines_[orderId] = std::chrono::system_clock::now() + orderTimeout_;
+    if (timerWheel_) {
+        expiryTimers_[orderId] = timerWheel_->schedule(orderTimeout_, [this, orderId]() {
+            expireOrder(orderId);
+        });
+    }
+}
+
+void OrderManager::clearExpiry(const OrderId& orderId) {
+    // Caller holds ordersMutex_
+    orderDeadlines_.erase(orderId);
+    
+    auto it = expiryTimers_.find(orderId);
+    if (it != expiryTimers_.end()) {
+        if (timerWheel_) {
+            timerWheel_->cancel(it->second);
+        }
+        expiryTimers_.erase(it);
+    }
 }
 
 void OrderManager::notifyOrderUpdate(const Order& order) {
@@ -407,21 +787,103 @@ void OrderManager::updateSlippageStats(const Symbol& symbol, double slippage) {
 
 // Stub implementations for other methods
 OrderId OrderManager::submitHybridOrder(const Order& order, Volume icebergQuantity, Price pegOffset) {
-    std::cout << "Hybrid order submitted (stub)" << std::endl;
-    return submitOrder(order);
+    if (!validateOrder(order)) {
+        std::cout << "Order validation failed for " << order.symbol << std::endl;
+        return "";
+    }
+    
+    Order newOrder = order;
+    newOrder.orderId = generateOrderId();
+    newOrder.type = OrderType::HYBRID;
+    newOrder.createTime = std::chrono::system_clock::now();
+    newOrder.status = OrderStatus::PENDING;
+    
+    HybridOrderInfo info;
+    info.parentOrderId = newOrder.orderId;
+    info.symbol = newOrder.symbol;
+    info.totalQuantity = newOrder.quantity;
+    info.visibleQuantity = icebergQuantity > 0 ? std::min(icebergQuantity, newOrder.quantity) : newOrder.quantity;
+    info.pegOffset = pegOffset;
+    
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        activeOrders_[newOrder.orderId] = newOrder;
+        hybridOrders_[newOrder.orderId] = info;
+        activeHybridCount_++;
+        orderQueue_.push(newOrder);
+        scheduleExpiry(newOrder.orderId);
+    }
+    
+    orderCV_.notify_one();
+    
+    std::cout << "Hybrid order submitted: " << newOrder.orderId << " for " << newOrder.symbol
+              << " (visible " << info.visibleQuantity << ", peg offset " << pegOffset << ")" << std::endl;
+    
+    return newOrder.orderId;
 }
 
 OrderId OrderManager::submitStopOrder(const Order& order, Price triggerPrice, int tickBuffer) {
-    std::cout << "Stop order submitted (stub)" << std::endl;
-    return submitOrder(order);
+    return registerStop(order, triggerPrice, 0, false, false, tickBuffer);
 }
 
 OrderId OrderManager::submitTrailingStop(const Order& order, Price trailAmount, bool usePercent) {
-    std::cout << "Trailing stop submitted (stub)" << std::endl;
-    return submitOrder(order);
+    return registerStop(order, 0, usePercent ? trailAmount / 100.0 : trailAmount, true, usePercent, 0);
 }
 
 bool OrderManager::setStopLoss(const Symbol& symbol, Price stopPrice) { 
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto posIt = positionStops_.find(symbol);
+        if (posIt != positionStops_.end()) {
+            // Move the existing position stop (a trailing one becomes fixed again)
+            StopLossInfo& info = stopLossOrders_.at(posIt->second);
+            if (!info.isTrailing) {
+                if (!stopEngine_->updateStop(info.stopId, stopPrice)) {
+                    return false;
+                }
+            } else {
+                OrderSide exitSide = activeOrders_.at(info.orderId).side;
+                StopId stopId = stopEngine_->addStop(symbol, exitSide, stopPrice);
+                if (!stopId) {
+                    return false;
+                }
+                stopEngine_->cancelStop(info.stopId);
+                stopOrderIds_.erase(info.stopId);
+                stopOrderIds_[stopId] = info.orderId;
+                info.stopId = stopId;
+                info.isTrailing = false;
+            }
+            info.stopPrice = stopPrice;
+            info.lastUpdate = std::chrono::system_clock::now();
+            
+            std::cout << "Stop loss moved for " << symbol << " to " << stopPrice << std::endl;
+            return true;
+        }
+    }
+    
+    // Protect the open position on the symbol's venue
+    Order exitOrder;
+    exitOrder.symbol = symbol;
+    ExchangeAPI* api = getExchange(selectOptimalExchange(exitOrder));
+    Position position = api ? api->getPosition(symbol) : Position();
+    if (position.quantity <= 0) {
+        std::cout << "No position to protect for " << symbol << std::endl;
+        return false;
+    }
+    
+    exitOrder.type = OrderType::MARKET;
+    exitOrder.side = position.side == OrderSide::BUY ? OrderSide::SELL : OrderSide::BUY;
+    exitOrder.quantity = position.quantity;
+    exitOrder.price = stopPrice;
+    
+    OrderId orderId = registerStop(exitOrder, stopPrice, 0, false, false, 0);
+    if (orderId.empty()) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(ordersMutex_);
+    positionStops_[symbol] = orderId;
+    
     std::cout << "Stop loss set for " << symbol << " at " << stopPrice << std::endl;
     return true; 
 }
@@ -432,25 +894,192 @@ bool OrderManager::setTakeProfit(const Symbol& symbol, Price targetPrice) {
 }
 
 bool OrderManager::updateTrailingStop(const Symbol& symbol, Price newTrailPrice) { 
-    std::cout << "Trailing stop updated for " << symbol << std::endl;
+    std::lock_guard<std::mutex> lock(ordersMutex_);
+    
+    auto posIt = positionStops_.find(symbol);
+    if (posIt == positionStops_.end() || newTrailPrice <= 0) {
+        return false;
+    }
+    
+    StopLossInfo& info = stopLossOrders_.at(posIt->second);
+    if (info.isTrailing) {
+        if (!stopEngine_->updateTrail(info.stopId, newTrailPrice)) {
+            return false;
+        }
+    } else {
+        // Convert the fixed position stop; the trail starts from the current price
+        OrderSide exitSide = activeOrders_.at(info.orderId).side;
+        Price reference = exitSide == OrderSide::SELL ? info.stopPrice + newTrailPrice
+                                                      : info.stopPrice - newTrailPrice;
+        StopId stopId = stopEngine_->addTrailingStop(symbol, exitSide, reference, newTrailPrice, false);
+        if (!stopId) {
+            return false;
+        }
+        stopEngine_->cancelStop(info.stopId);
+        stopOrderIds_.erase(info.stopId);
+        stopOrderIds_[stopId] = info.orderId;
+        info.stopId = stopId;
+        info.isTrailing = true;
+        info.usePercent = false;
+    }
+    info.trailAmount = newTrailPrice;
+    info.lastUpdate = std::chrono::system_clock::now();
+    
+    std::cout << "Trailing stop updated for " << symbol << " (trail " << newTrailPrice << ")" << std::endl;
     return true; 
 }
 
 void OrderManager::addExchange(Exchange exchange, std::unique_ptr<ExchangeAPI> api) {
-    std::cout << "Exchange added (stub implementation)" << std::endl;
+    if (!api) {
+        return;
+    }
+    
+    // Execution reports flow back through the regular update handlers
+    api->setOrderCallback([this](const Order& order) { onOrderUpdate(order); });
+    api->setFillCallback([this](const OrderId& orderId, Volume quantity, Price price) {
+        onFillUpdate(orderId, quantity, price);
+    });
+    api->setOrderBookCallback([this, exchange](const Symbol& symbol) {
+        onOrderBookUpdate(exchange, symbol);
+    });
+    
+    std::string name = api->getExchangeName();
+    {
+        std::lock_guard<std::mutex> lock(exchangesMutex_);
+        router_->addExchange(exchange, api.get());
+        exchanges_[exchange] = std::move(api);
+    }
+    
+    std::cout << "Exchange added: " << name << std::endl;
+}
+
+ExchangeAPI* OrderManager::getExchange(Exchange exchange) const {
+    std::lock_guard<std::mutex> lock(exchangesMutex_);
+    auto it = exchanges_.find(exchange);
+    return it != exchanges_.end() ? it->second.get() : nullptr;
 }
 
 Exchange OrderManager::getBestExchange(const Symbol& symbol, OrderSide side, Volume quantity) const {
-    return Exchange::BINANCE; // Default
+    Order probe;
+    probe.symbol = symbol;
+    probe.type = OrderType::MARKET;
+    probe.side = side;
+    probe.quantity = quantity;
+    return selectOptimalExchange(probe);
 }
 
 bool OrderManager::routeOrder(Order& order) { 
-    std::cout << "Order routed (stub)" << std::endl;
+    std::string error = "No exchange available";
+    
+    if (smartRoutingEnabled_ && maxSplitSlices_ > 1 && getRoutableExchanges().size() > 1) {
+        std::vector<Order> children = router_->splitOrder(order, maxSplitSlices_);
+        if (children.size() > 1) {
+            return routeSplitOrder(order, children);
+        }
+    }
+    
+    Exchange exchange = selectOptimalExchange(order);
+    if (!sendToExchange(order, exchange, error)) {
+        onOrderRejected(order.orderId, error);
+        return false;
+    }
     return true; 
 }
 
 void OrderManager::setExecutionStrategy(const Symbol& symbol, const std::string& strategy) {
-    executionStrategies_[symbol] = strategy;
+    std::shared_ptr<ExecutionStrategy> instance;
+    if (strategy == "TWAP") {
+        instance = std::make_shared<TWAPStrategy>(std::chrono::minutes(5), 10);
+    } else if (strategy == "VWAP") {
+        instance = std::make_shared<VWAPStrategy>(std::chrono::minutes(30), volumeProfiles_);
+    } else if (strategy == "MinSlippage") {
+        instance = std::make_shared<MinimizeSlippageStrategy>(maxSlippagePercent_);
+    } else if (!strategy.empty()) {
+        std::cout << "Unknown execution strategy: " << strategy << std::endl;
+        return;
+    }
+    setExecutionStrategy(symbol, instance);
+}
+
+void OrderManager::setExecutionStrategy(const Symbol& symbol, std::shared_ptr<ExecutionStrategy> strategy) {
+    std::lock_guard<std::mutex> lock(ordersMutex_);
+    bool vwap = strategy && strategy->getName() == "VWAP";
+    if (strategy) {
+        executionStrategies_[symbol] = std::move(strategy);
+    } else {
+        executionStrategies_.erase(symbol);
+    }
+    
+    // VWAP profiles are built on setup and rebuilt daily while the symbol trades VWAP
+    auto timerIt = profileTimers_.find(symbol);
+    if (vwap && timerIt == profileTimers_.end()) {
+        scheduleProfileRefresh(symbol);
+        if (!volumeProfiles_->hasProfile(symbol)) {
+            profileRefreshes_.push(symbol);
+            orderCV_.notify_one();
+        }
+    } else if (!vwap && timerIt != profileTimers_.end()) {
+        if (timerWheel_) {
+            timerWheel_->cancel(timerIt->second);
+        }
+        profileTimers_.erase(timerIt);
+    }
+}
+
+std::shared_ptr<VolumeProfileCache> OrderManager::getVolumeProfileCache() const {
+    return volumeProfiles_;
+}
+
+bool OrderManager::refreshVolumeProfile(const Symbol& symbol) {
+    TimePoint end = std::chrono::system_clock::now();
+    Duration interval = volumeProfiles_->getBucketSize();
+    
+    // First connected venue with history for the symbol
+    for (Exchange exchange : getRoutableExchanges()) {
+        ExchangeAPI* api = getExchange(exchange);
+        if (!api) {
+            continue;
+        }
+        std::vector<OHLC> bars = api->getHistoricalData(symbol, end - VOLUME_PROFILE_LOOKBACK, end, interval);
+        if (bars.empty()) {
+            continue;
+        }
+        volumeProfiles_->buildProfile(symbol, bars);
+        std::cout << "Volume profile for " << symbol << " built from " << bars.size()
+                  << " bars on " << api->getExchangeName() << std::endl;
+        return true;
+    }
+    
+    // An existing profile is kept; without one VWAP plans uniformly
+    std::cout << "No historical bars for " << symbol << " volume profile" << std::endl;
+    return false;
+}
+
+ExecutionProgress OrderManager::getExecutionProgress(const OrderId& parentOrderId) const {
+    std::lock_guard<std::mutex> lock(ordersMutex_);
+    
+    auto it = scheduledExecutions_.find(parentOrderId);
+    if (it != scheduledExecutions_.end()) {
+        return it->second.progress;
+    }
+    
+    auto histIt = executionHistory_.find(parentOrderId);
+    if (histIt != executionHistory_.end()) {
+        return histIt->second;
+    }
+    
+    return ExecutionProgress();
+}
+
+std::vector<ExecutionProgress> OrderManager::getActiveExecutions() const {
+    std::lock_guard<std::mutex> lock(ordersMutex_);
+    
+    std::vector<ExecutionProgress> executions;
+    executions.reserve(scheduledExecutions_.size());
+    for (const auto& pair : scheduledExecutions_) {
+        executions.push_back(pair.second.progress);
+    }
+    return executions;
 }
 
 void OrderManager::enableSmartRouting(bool enable) {
@@ -461,4 +1090,935 @@ void OrderManager::setSlippageThreshold(double maxSlippagePercent) {
     maxSlippagePercent_ = maxSlippagePercent;
 }
 
-} // namespace MasterMind 
\ No newline at end of file
+void OrderManager::setMaxSplitSlices(int maxSlices) {
+    maxSplitSlices_ = std::max(1, maxSlices);
+}
+
+SmartOrderRouter* OrderManager::getSmartRouter() const {
+    return router_.get();
+}
+
+Exchange OrderManager::selectOptimalExchange(const Order& order) const {
+    auto mapped = symbolExchangeMapping_.find(order.symbol);
+    if (mapped != symbolExchangeMapping_.end() && isExchangeAvailable(mapped->second)) {
+        return mapped->second;
+    }
+    
+    std::vector<Exchange> available = getRoutableExchanges();
+    if (available.empty()) {
+        return Exchange::BINANCE;
+    }
+    return smartRoutingEnabled_ ? router_->selectBestExchange(order, available) : available.front();
+}
+
+double OrderManager::calculateExecutionCost(const Order& order, Exchange exchange) const {
+    return router_->estimateExecutionCost(order, exchange);
+}
+
+bool OrderManager::isExchangeAvailable(Exchange exchange) const {
+    ExchangeAPI* api = getExchange(exchange);
+    return api && api->isConnected();
+}
+
+std::vector<Exchange> OrderManager::getRoutableExchanges() const {
+    std::lock_guard<std::mutex> lock(exchangesMutex_);
+    
+    std::vector<Exchange> available;
+    for (const auto& pair : exchanges_) {
+        if (pair.second->isConnected()) {
+            available.push_back(pair.first);
+        }
+    }
+    return available;
+}
+
+bool OrderManager::sendToExchange(Order& order, Exchange exchange, std::string& error) {
+    ExchangeAPI* api = getExchange(exchange);
+    if (!api) {
+        error = "No exchange available";
+        return false;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        orderRouting_[order.orderId] = exchange;
+    }
+    router_->onOrderSent(order, exchange);
+    
+    // Called without ordersMutex_ held: the exchange may report synchronously
+    OrderId exchangeOrderId = api->placeOrder(order);
+    if (exchangeOrderId.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(ordersMutex_);
+            orderRouting_.erase(order.orderId);
+        }
+        router_->onOrderCompleted(order.orderId);
+        error = api->getLastError();
+        return false;
+    }
+    
+    if (exchangeOrderId != order.orderId) {
+        // Reports arrive under the venue's id and will not match this order
+        std::cout << "Warning: " << api->getExchangeName() << " renamed order " << order.orderId << " to "
+                  << exchangeOrderId << std::endl;
+    }
+    std::cout << "Order routed: " << order.orderId << " -> " << api->getExchangeName() << std::endl;
+    return true;
+}
+
+bool OrderManager::routeSplitOrder(const Order& parent, std::vector<Order>& children) {
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        
+        SplitOrderInfo& info = splitOrders_[parent.orderId];
+        for (size_t i = 0; i < children.size(); ++i) {
+            children[i].orderId = parent.orderId + "-" + std::to_string(i + 1);
+            info.childOrders.push_back(children[i].orderId);
+            childToParent_[children[i].orderId] = parent.orderId;
+        }
+        info.openChildren = children.size();
+        
+        auto it = activeOrders_.find(parent.orderId);
+        if (it != activeOrders_.end()) {
+            it->second.status = OrderStatus::SUBMITTED;
+            it->second.updateTime = std::chrono::system_clock::now();
+        }
+    }
+    
+    std::cout << "Order split: " << parent.orderId << " into " << children.size() << " venues" << std::endl;
+    
+    for (auto& child : children) {
+        Exchange exchange;
+        std::string error = "Unknown venue " + child.exchange;
+        if (!SmartOrderRouter::fromExchangeId(child.exchange, exchange) ||
+            !sendToExchange(child, exchange, error)) {
+            std::cout << "Child order failed: " << child.orderId << " - " << error << std::endl;
+            child.status = OrderStatus::REJECTED;
+            onChildOrderUpdate(parent.orderId, child);
+        }
+    }
+    return true;
+}
+
+void OrderManager::onChildOrderUpdate(const OrderId& parentId, const Order& child) {
+    bool complete = child.status == OrderStatus::FILLED || 
+                    child.status == OrderStatus::CANCELLED ||
+                    child.status == OrderStatus::REJECTED ||
+                    child.status == OrderStatus::EXPIRED;
+    if (child.status == OrderStatus::SUBMITTED) {
+        router_->onOrderAcknowledged(child.orderId);
+    }
+    if (!complete) {
+        return;
+    }
+    router_->onOrderCompleted(child.orderId);
+    
+    Order parent;
+    bool refill = false;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        if (childToParent_.erase(child.orderId) == 0) {
+            return;  // Completion already handled
+        }
+        orderRouting_.erase(child.orderId);
+        
+        auto scheduledIt = scheduledExecutions_.find(parentId);
+        auto hybridIt = hybridOrders_.find(parentId);
+        if (scheduledIt != scheduledExecutions_.end()) {
+            if (!onScheduledChildDone(parentId, scheduledIt->second, child) ||
+                !completeScheduledExecution(parentId, parent)) {
+                return;
+            }
+        } else if (hybridIt != hybridOrders_.end()) {
+            HybridOrderInfo& info = hybridIt->second;
+            if (info.activeChild == child.orderId) {
+                info.activeChild.clear();
+            }
+            if (child.status == OrderStatus::REJECTED) {
+                if (++info.failedSlices >= MAX_FAILED_SLICES) {
+                    info.cancelled = true;
+                }
+            } else {
+                info.failedSlices = 0;
+            }
+            
+            auto it = activeOrders_.find(parentId);
+            if (it == activeOrders_.end()) {
+                return;
+            }
+            
+            // Refill from the processing thread, not from inside the venue's callback
+            if (!info.cancelled && it->second.filledQuantity < it->second.quantity - QUANTITY_EPSILON) {
+                hybridRefills_.push(parentId);
+                refill = true;
+            } else if (!completeHybridOrder(parentId, parent)) {
+                return;
+            }
+        } else {
+            auto infoIt = splitOrders_.find(parentId);
+            if (infoIt == splitOrders_.end() || --infoIt->second.openChildren > 0) {
+                return;
+            }
+            splitOrders_.erase(infoIt);
+        
+            auto it = activeOrders_.find(parentId);
+            if (it == activeOrders_.end()) {
+                return;  // Parent already expired
+            }
+        
+            // Last child done: the parent's outcome follows from what filled
+            Order& order = it->second;
+            if (order.filledQuantity >= order.quantity) {
+                order.status = OrderStatus::FILLED;
+            } else if (order.filledQuantity > 0) {
+                order.status = OrderStatus::CANCELLED;
+            } else {
+                order.status = child.status;
+            }
+            order.updateTime = std::chrono::system_clock::now();
+            parent = order;
+        }
+    }
+    
+    if (refill) {
+        orderCV_.notify_one();
+        return;
+    }
+    
+    notifyOrderUpdate(parent);
+    moveToHistory(parentId);
+}
+
+std::vector<std::pair<ExchangeAPI*, OrderId>> OrderManager::collectVenueOrders(const OrderId& orderId) const {
+    std::vector<std::pair<ExchangeAPI*, OrderId>> venueOrders;
+    
+    auto addVenueOrder = [&](const OrderId& venueOrderId) {
+        auto routeIt = orderRouting_.find(venueOrderId);
+        ExchangeAPI* api = routeIt != orderRouting_.end() ? getExchange(routeIt->second) : nullptr;
+        if (api) {
+            venueOrders.emplace_back(api, venueOrderId);
+        }
+    };
+    
+    // Completed children have already left orderRouting_
+    auto splitIt = splitOrders_.find(orderId);
+    auto scheduledIt = scheduledExecutions_.find(orderId);
+    if (splitIt != splitOrders_.end()) {
+        for (const auto& childId : splitIt->second.childOrders) {
+            addVenueOrder(childId);
+        }
+    } else if (scheduledIt != scheduledExecutions_.end()) {
+        for (const auto& childId : scheduledIt->second.childOrders) {
+            addVenueOrder(childId);
+        }
+    } else if (hybridOrders_.count(orderId)) {
+        const OrderId& activeChild = hybridOrders_.at(orderId).activeChild;
+        if (!activeChild.empty()) {
+            addVenueOrder(activeChild);
+        }
+    } else {
+        addVenueOrder(orderId);
+    }
+    return venueOrders;
+}
+
+bool OrderManager::startScheduledExecution(const Order& order, std::shared_ptr<ExecutionStrategy> strategy) {
+    if (strategy->getName() == "VWAP" && !volumeProfiles_->hasProfile(order.symbol)) {
+        refreshVolumeProfile(order.symbol);
+    }
+    
+    TimePoint now = std::chrono::system_clock::now();
+    std::vector<ExecutionSlice> slices = strategy->plan(order, now);
+    if (slices.empty()) {
+        return false;
+    }
+    
+    // Arrival price for slippage tracking: venue mid when known, else the limit
+    Price arrivalPrice = order.price;
+    ExchangeAPI* api = getExchange(selectOptimalExchange(order));
+    auto book = api ? api->getOrderBook(order.symbol) : nullptr;
+    if (book && book->getMidPrice() > 0) {
+        arrivalPrice = book->getMidPrice();
+    }
+    
+    size_t sliceCount = slices.size();
+    bool sendNow = false;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto it = activeOrders_.find(order.orderId);
+        if (it == activeOrders_.end() || it->second.status != OrderStatus::PENDING) {
+            return true;  // Cancelled or expired meanwhile
+        }
+        it->second.status = OrderStatus::SUBMITTED;
+        it->second.updateTime = now;
+        
+        ScheduledExecution& execution = scheduledExecutions_[order.orderId];
+        execution.strategy = strategy;
+        execution.slices = std::move(slices);
+        
+        ExecutionProgress& progress = execution.progress;
+        progress.parentOrderId = order.orderId;
+        progress.symbol = order.symbol;
+        progress.strategy = strategy->getName();
+        progress.targetQuantity = order.quantity;
+        progress.arrivalPrice = arrivalPrice;
+        progress.slicesPlanned = static_cast<int>(execution.slices.size());
+        progress.startTime = now;
+        progress.scheduledEndTime = now + execution.slices.back().offset;
+        
+        Duration firstOffset = execution.slices.front().offset;
+        if (firstOffset > Duration::zero()) {
+            scheduleSlice(order.orderId, execution, firstOffset);
+        } else {
+            execution.slicePending = true;
+            sendNow = true;
+        }
+    }
+    
+    std::cout << "Order scheduled: " << order.orderId << " (" << strategy->getName() << ", "
+              << sliceCount << " slices)" << std::endl;
+    
+    if (sendNow) {
+        processDueSlice(order.orderId);
+    }
+    return true;
+}
+
+void OrderManager::processDueSlice(const OrderId& parentId) {
+    Order parent;
+    std::shared_ptr<ExecutionStrategy> strategy;
+    Volume scheduled = 0;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto it = scheduledExecutions_.find(parentId);
+        auto parentIt = activeOrders_.find(parentId);
+        if (it == scheduledExecutions_.end() || parentIt == activeOrders_.end()) {
+            return;
+        }
+        
+        ScheduledExecution& execution = it->second;
+        execution.slicePending = false;
+        execution.timer = TimerWheel::INVALID_TIMER;
+        if (execution.cancelled) {
+            return;
+        }
+        
+        // Take this slice and arm the next one relative to it
+        if (execution.nextSlice < execution.slices.size()) {
+            const ExecutionSlice& slice = execution.slices[execution.nextSlice++];
+            execution.carry += slice.quantity;
+            if (execution.nextSlice < execution.slices.size()) {
+                scheduleSlice(parentId, execution, execution.slices[execution.nextSlice].offset - slice.offset);
+            }
+        }
+        
+        scheduled = execution.carry;
+        strategy = execution.strategy;
+        parent = parentIt->second;
+    }
+    
+    if (scheduled <= QUANTITY_EPSILON) {
+        return;
+    }
+    
+    // Size against the book of the venue the slice will go to
+    Order child = parent;
+    child.quantity = scheduled;
+    Exchange exchange = selectOptimalExchange(child);
+    ExchangeAPI* api = getExchange(exchange);
+    auto book = api ? api->getOrderBook(parent.symbol) : nullptr;
+    Volume quantity = std::min(scheduled, strategy->sizeSlice(parent, scheduled, book.get()));
+    
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto it = scheduledExecutions_.find(parentId);
+        if (it == scheduledExecutions_.end() || it->second.cancelled) {
+            return;
+        }
+        
+        ScheduledExecution& execution = it->second;
+        if (quantity > QUANTITY_EPSILON) {
+            execution.carry -= quantity;
+            execution.progress.sentQuantity += quantity;
+            execution.progress.slicesSent++;
+            
+            child.orderId = parentId + "-S" + std::to_string(execution.progress.slicesSent);
+            child.quantity = quantity;
+            child.filledQuantity = 0;
+            child.status = OrderStatus::PENDING;
+            child.createTime = std::chrono::system_clock::now();
+            child.updateTime = child.createTime;
+            execution.childOrders.push_back(child.orderId);
+            execution.openChildren++;
+            childToParent_[child.orderId] = parentId;
+        }
+        
+        // Quantity held back after the last planned slice is retried later
+        if (execution.carry > QUANTITY_EPSILON && !execution.slicePending) {
+            scheduleSlice(parentId, execution, execution.strategy->getRetryInterval());
+        }
+        
+        if (quantity <= QUANTITY_EPSILON) {
+            return;
+        }
+    }
+    
+    std::string error;
+    if (!sendToExchange(child, exchange, error)) {
+        std::cout << "Slice failed: " << child.orderId << " - " << error << std::endl;
+        child.status = OrderStatus::REJECTED;
+        onChildOrderUpdate(parentId, child);
+    }
+}
+
+void OrderManager::scheduleSlice(const OrderId& parentId, ScheduledExecution& execution, Duration delay) {
+    // Caller holds ordersMutex_
+    if (!timerWheel_) {
+        return;
+    }
+    
+    execution.slicePending = true;
+    execution.nextDue = std::chrono::system_clock::now() + delay;
+    execution.timer = timerWheel_->schedule(delay, [this, parentId]() {
+        {
+            std::lock_guard<std::mutex> lock(ordersMutex_);
+            auto it = scheduledExecutions_.find(parentId);
+            if (it == scheduledExecutions_.end()) {
+                return;
+            }
+            it->second.timer = TimerWheel::INVALID_TIMER;
+            dueSlices_.push(parentId);
+        }
+        // Sent from the order processing thread - the wheel thread never blocks on a venue
+        orderCV_.notify_one();
+    });
+}
+
+void OrderManager::scheduleProfileRefresh(const Symbol& symbol) {
+    if (!timerWheel_) {
+        return;
+    }
+    profileTimers_[symbol] = timerWheel_->scheduleRepeating(VOLUME_PROFILE_REFRESH, [this, symbol]() {
+        {
+            std::lock_guard<std::mutex> lock(ordersMutex_);
+            profileRefreshes_.push(symbol);
+        }
+        orderCV_.notify_one();
+    });
+}
+
+bool OrderManager::onScheduledChildDone(const OrderId& parentId, ScheduledExecution& execution, const Order& child) {
+    // Caller holds ordersMutex_
+    if (execution.openChildren > 0) {
+        execution.openChildren--;
+    }
+    
+    if (child.status == OrderStatus::REJECTED && ++execution.failedSlices >= MAX_FAILED_SLICES) {
+        std::cout << "Scheduled execution aborted after " << execution.failedSlices
+                  << " rejected slices: " << parentId << std::endl;
+        execution.cancelled = true;
+        if (timerWheel_ && execution.timer != TimerWheel::INVALID_TIMER) {
+            timerWheel_->cancel(execution.timer);
+        }
+        execution.timer = TimerWheel::INVALID_TIMER;
+        execution.slicePending = false;
+    }
+    
+    // Whatever the child left unfilled goes back into the schedule
+    Volume unfilled = child.quantity - child.filledQuantity;
+    if (!execution.cancelled && unfilled > QUANTITY_EPSILON) {
+        execution.carry += unfilled;
+        if (!execution.slicePending) {
+            scheduleSlice(parentId, execution, execution.strategy->getRetryInterval());
+        }
+    }
+    
+    return isScheduleDone(execution);
+}
+
+bool OrderManager::completeScheduledExecution(const OrderId& parentId, Order& parent) {
+    // Caller holds ordersMutex_
+    auto it = scheduledExecutions_.find(parentId);
+    if (it == scheduledExecutions_.end()) {
+        return false;
+    }
+    
+    ScheduledExecution& execution = it->second;
+    execution.progress.complete = true;
+    executionHistory_[parentId] = execution.progress;
+    bool rejected = execution.failedSlices >= MAX_FAILED_SLICES;
+    scheduledExecutions_.erase(it);
+    
+    auto parentIt = activeOrders_.find(parentId);
+    if (parentIt == activeOrders_.end()) {
+        return false;
+    }
+    
+    Order& order = parentIt->second;
+    if (order.filledQuantity >= order.quantity - QUANTITY_EPSILON) {
+        order.status = OrderStatus::FILLED;
+    } else if (rejected && order.filledQuantity <= 0) {
+        order.status = OrderStatus::REJECTED;
+    } else {
+        order.status = OrderStatus::CANCELLED;
+    }
+    order.updateTime = std::chrono::system_clock::now();
+    parent = order;
+    return true;
+}
+
+bool OrderManager::isScheduleDone(const ScheduledExecution& execution) const {
+    if (execution.openChildren > 0) {
+        return false;
+    }
+    return execution.cancelled ||
+           (execution.nextSlice >= execution.slices.size() && execution.carry <= QUANTITY_EPSILON);
+}
+
+void OrderManager::setTimerWheel(TimerWheel* timerWheel) {
+    std::lock_guard<std::mutex> lock(ordersMutex_);
+    
+    if (timerWheel_) {
+        for (const auto& pair : expiryTimers_) {
+            timerWheel_->cancel(pair.second);
+        }
+    }
+    expiryTimers_.clear();
+    for (const auto& pair : scheduledExecutions_) {
+        if (timerWheel_ && pair.second.timer != TimerWheel::INVALID_TIMER) {
+            timerWheel_->cancel(pair.second.timer);
+        }
+    }
+    // Deferred re-pegs are dropped; the next book update re-arms them
+    for (auto& pair : hybridOrders_) {
+        if (timerWheel_ && pair.second.repegTimer != TimerWheel::INVALID_TIMER) {
+            timerWheel_->cancel(pair.second.repegTimer);
+        }
+        pair.second.repegTimer = TimerWheel::INVALID_TIMER;
+    }
+    std::vector<Symbol> profileSymbols;
+    for (const auto& pair : profileTimers_) {
+        if (timerWheel_) {
+            timerWheel_->cancel(pair.second);
+        }
+        profileSymbols.push_back(pair.first);
+    }
+    profileTimers_.clear();
+    timerWheel_ = timerWheel;
+    
+    for (const Symbol& symbol : profileSymbols) {
+        scheduleProfileRefresh(symbol);
+    }
+    
+    // Re-arm outstanding deadlines on the new wheel
+    if (timerWheel_) {
+        auto now = std::chrono::system_clock::now();
+        for (const auto& pair : orderDeadlines_) {
+            OrderId orderId = pair.first;
+            auto remaining = std::chrono::duration_cast<Duration>(pair.second - now);
+            expiryTimers_[orderId] = timerWheel_->schedule(remaining, [this, orderId]() {
+                expireOrder(orderId);
+            });
+        }
+    }
+    
+    // Re-arm pending slice timers; slices already queued are left alone
+    for (auto& pair : scheduledExecutions_) {
+        ScheduledExecution& execution = pair.second;
+        if (execution.timer == TimerWheel::INVALID_TIMER) {
+            continue;
+        }
+        execution.timer = TimerWheel::INVALID_TIMER;
+        if (timerWheel_) {
+            auto now = std::chrono::system_clock::now();
+            scheduleSlice(pair.first, execution,
+                          std::max(Duration::zero(), std::chrono::duration_cast<Duration>(execution.nextDue - now)));
+        } else {
+            execution.slicePending = false;
+        }
+    }
+}
+
+void OrderManager::setOrderTimeout(Duration timeout) {
+    std::lock_guard<std::mutex> lock(ordersMutex_);
+    orderTimeout_ = timeout;
+}
+
+void OrderManager::setMinRepegInterval(Duration interval) {
+    std::lock_guard<std::mutex> lock(ordersMutex_);
+    minRepegInterval_ = std::max(interval, Duration::zero());
+}
+
+bool OrderManager::executeHybridOrder(Order& order) {
+    Exchange exchange = selectOptimalExchange(order);
+    ExchangeAPI* api = getExchange(exchange);
+    if (!api) {
+        onOrderRejected(order.orderId, "No exchange available");
+        return false;
+    }
+    double tickSize = api->getInstrumentSpec(order.symbol).tickSize;
+    
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto infoIt = hybridOrders_.find(order.orderId);
+        auto it = activeOrders_.find(order.orderId);
+        if (infoIt == hybridOrders_.end() || it == activeOrders_.end()) {
+            return false;
+        }
+        
+        // The peg follows one venue's book for the life of the order
+        infoIt->second.exchange = exchange;
+        infoIt->second.tickSize = tickSize;
+        it->second.status = OrderStatus::SUBMITTED;
+        it->second.updateTime = std::chrono::system_clock::now();
+    }
+    
+    std::cout << "Hybrid order working: " << order.orderId << " on " << api->getExchangeName() << std::endl;
+    submitNextSlice(order.orderId);
+    return true;
+}
+
+void OrderManager::submitNextSlice(const OrderId& parentId) {
+    Order parent;
+    Exchange exchange;
+    Price pegOffset;
+    double tickSize;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto infoIt = hybridOrders_.find(parentId);
+        auto it = activeOrders_.find(parentId);
+        if (infoIt == hybridOrders_.end() || it == activeOrders_.end() ||
+            infoIt->second.cancelled || !infoIt->second.activeChild.empty()) {
+            return;
+        }
+        parent = it->second;
+        exchange = infoIt->second.exchange;
+        pegOffset = infoIt->second.pegOffset;
+        tickSize = infoIt->second.tickSize;
+    }
+    
+    ExchangeAPI* api = getExchange(exchange);
+    auto book = api ? api->getOrderBook(parent.symbol) : nullptr;
+    Price price = pegToBook(parent, pegOffset, tickSize, book.get(), 0, 0);
+    
+    Order child;
+    Order finished;
+    bool completed = false;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto infoIt = hybridOrders_.find(parentId);
+        auto it = activeOrders_.find(parentId);
+        if (infoIt == hybridOrders_.end() || it == activeOrders_.end() ||
+            infoIt->second.cancelled || !infoIt->second.activeChild.empty()) {
+            return;
+        }
+        
+        HybridOrderInfo& info = infoIt->second;
+        Volume remaining = it->second.quantity - it->second.filledQuantity;
+        if (remaining <= QUANTITY_EPSILON) {
+            completed = completeHybridOrder(parentId, finished);
+        } else {
+            child = it->second;
+            child.orderId = parentId + "-H" + std::to_string(++info.currentSlice);
+            child.type = OrderType::LIMIT;
+            child.price = price;
+            child.quantity = std::min(info.visibleQuantity, remaining);
+            child.filledQuantity = 0;
+            child.visibleQuantity = 0;
+            child.status = OrderStatus::PENDING;
+            child.createTime = std::chrono::system_clock::now();
+            child.updateTime = child.createTime;
+            
+            info.childOrders.push_back(child.orderId);
+            info.activeChild = child.orderId;
+            info.activePrice = price;
+            info.activeQuantity = child.quantity;
+            info.lastRepeg = child.createTime;
+            childToParent_[child.orderId] = parentId;
+        }
+    }
+    
+    if (completed) {
+        notifyOrderUpdate(finished);
+        moveToHistory(parentId);
+        return;
+    }
+    
+    std::string error;
+    if (!sendToExchange(child, exchange, error)) {
+        std::cout << "Slice failed: " << child.orderId << " - " << error << std::endl;
+        child.status = OrderStatus::REJECTED;
+        onChildOrderUpdate(parentId, child);
+    }
+}
+
+void OrderManager::repegHybridOrders(const Symbol& symbol) {
+    std::vector<OrderId> parents;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        for (const auto& pair : hybridOrders_) {
+            if (pair.second.symbol == symbol && !pair.second.activeChild.empty()) {
+                parents.push_back(pair.first);
+            }
+        }
+    }
+    
+    for (const auto& parentId : parents) {
+        manageHybridOrder(parentId);
+    }
+}
+
+void OrderManager::manageHybridOrder(const OrderId& parentId) {
+    Order parent;
+    Exchange exchange;
+    Price pegOffset;
+    double tickSize;
+    OrderId activeChild;
+    Price activePrice;
+    Volume activeQuantity;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto infoIt = hybridOrders_.find(parentId);
+        auto it = activeOrders_.find(parentId);
+        if (infoIt == hybridOrders_.end() || it == activeOrders_.end() ||
+            infoIt->second.cancelled || infoIt->second.activeChild.empty()) {
+            return;
+        }
+        const HybridOrderInfo& info = infoIt->second;
+        parent = it->second;
+        exchange = info.exchange;
+        pegOffset = info.pegOffset;
+        tickSize = info.tickSize;
+        activeChild = info.activeChild;
+        activePrice = info.activePrice;
+        activeQuantity = info.activeQuantity;
+    }
+    
+    ExchangeAPI* api = getExchange(exchange);
+    if (!api) {
+        return;
+    }
+    auto book = api->getOrderBook(parent.symbol);
+    Price target = pegToBook(parent, pegOffset, tickSize, book.get(), activePrice, activeQuantity);
+    double threshold = tickSize > 0 ? tickSize / 2.0 : 1e-9;
+    if (std::abs(target - activePrice) < threshold) {
+        return;
+    }
+    
+    Order replacement;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto infoIt = hybridOrders_.find(parentId);
+        if (infoIt == hybridOrders_.end() || infoIt->second.cancelled ||
+            infoIt->second.activeChild != activeChild) {
+            return;
+        }
+        HybridOrderInfo& info = infoIt->second;
+        
+        // Rate limit: defer to one timer that re-evaluates once the interval has passed
+        auto now = std::chrono::system_clock::now();
+        auto sinceLast = std::chrono::duration_cast<Duration>(now - info.lastRepeg);
+        if (sinceLast < minRepegInterval_) {
+            if (timerWheel_ && info.repegTimer == TimerWheel::INVALID_TIMER) {
+                Symbol symbol = parent.symbol;
+                info.repegTimer = timerWheel_->schedule(minRepegInterval_ - sinceLast, [this, parentId, symbol]() {
+                    {
+                        std::lock_guard<std::mutex> lock(ordersMutex_);
+                        auto it = hybridOrders_.find(parentId);
+                        if (it == hybridOrders_.end()) {
+                            return;
+                        }
+                        it->second.repegTimer = TimerWheel::INVALID_TIMER;
+                        if (!pendingRepegs_.insert(symbol).second) {
+                            return;
+                        }
+                        repegQueue_.push(symbol);
+                    }
+                    orderCV_.notify_one();
+                });
+            }
+            return;
+        }
+        
+        info.lastRepeg = now;
+        info.activePrice = target;
+        info.repegCount++;
+        
+        replacement = parent;
+        replacement.orderId = activeChild;
+        replacement.type = OrderType::LIMIT;
+        replacement.price = target;
+        replacement.quantity = activeQuantity;
+        replacement.visibleQuantity = 0;
+    }
+    
+    // One amend per re-peg; venues that cannot amend get a cancel and the
+    // refill re-enters at the new peg
+    if (!api->modifyOrder(activeChild, replacement)) {
+        api->cancelOrder(activeChild);
+    }
+}
+
+bool OrderManager::completeHybridOrder(const OrderId& parentId, Order& parent) {
+    // Caller holds ordersMutex_
+    auto infoIt = hybridOrders_.find(parentId);
+    auto it = activeOrders_.find(parentId);
+    if (infoIt == hybridOrders_.end() || it == activeOrders_.end()) {
+        return false;
+    }
+    
+    Order& order = it->second;
+    if (order.filledQuantity >= order.quantity - QUANTITY_EPSILON) {
+        order.status = OrderStatus::FILLED;
+    } else if (infoIt->second.failedSlices >= MAX_FAILED_SLICES && order.filledQuantity <= 0) {
+        order.status = OrderStatus::REJECTED;
+    } else {
+        order.status = OrderStatus::CANCELLED;
+    }
+    order.updateTime = std::chrono::system_clock::now();
+    parent = order;
+    
+    std::cout << "Hybrid order done: " << parentId << " (" << infoIt->second.currentSlice
+              << " slices, " << infoIt->second.repegCount << " re-pegs)" << std::endl;
+    return true;
+}
+
+void OrderManager::releaseHybridOrder(const OrderId& parentId) {
+    // Caller holds ordersMutex_
+    auto infoIt = hybridOrders_.find(parentId);
+    if (infoIt == hybridOrders_.end()) {
+        return;
+    }
+    if (timerWheel_ && infoIt->second.repegTimer != TimerWheel::INVALID_TIMER) {
+        timerWheel_->cancel(infoIt->second.repegTimer);
+    }
+    hybridOrders_.erase(infoIt);
+    activeHybridCount_--;
+}
+
+OrderId OrderManager::registerStop(const Order& order, Price stopPrice, Price trail,
+                                   bool trailing, bool usePercent, int tickBuffer) {
+    Order stopOrder = order;
+    if (stopOrder.price <= 0) {
+        stopOrder.price = stopPrice;  // Reference price for validation and slippage
+    }
+    if (!validateOrder(stopOrder)) {
+        std::cout << "Order validation failed for " << order.symbol << std::endl;
+        return "";
+    }
+    
+    bool stopLimit = order.type == OrderType::LIMIT || order.type == OrderType::STOP_LIMIT;
+    Price limitOffset = 0;
+    if (stopLimit && tickBuffer > 0) {
+        ExchangeAPI* api = getExchange(selectOptimalExchange(stopOrder));
+        limitOffset = api ? tickBuffer * api->getInstrumentSpec(order.symbol).tickSize : 0;
+    }
+    
+    stopOrder.orderId = generateOrderId();
+    stopOrder.type = stopLimit ? OrderType::STOP_LIMIT : OrderType::STOP;
+    stopOrder.triggerPrice = stopPrice;
+    stopOrder.tickOffset = tickBuffer;
+    stopOrder.createTime = std::chrono::system_clock::now();
+    stopOrder.status = OrderStatus::PENDING;
+    
+    {
+        // Registered under ordersMutex_ so a trigger can always find the order
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        StopId stopId = trailing
+            ? stopEngine_->addTrailingStop(order.symbol, order.side, stopOrder.price, trail, usePercent)
+            : stopEngine_->addStop(order.symbol, order.side, stopPrice);
+        if (!stopId) {
+            std::cout << "Invalid stop parameters for " << order.symbol << std::endl;
+            return "";
+        }
+        
+        StopLossInfo info;
+        info.orderId = stopOrder.orderId;
+        info.symbol = order.symbol;
+        info.stopId = stopId;
+        info.stopPrice = stopPrice;
+        info.trailAmount = trail;
+        info.isTrailing = trailing;
+        info.usePercent = usePercent;
+        info.limitOffset = limitOffset;
+        info.lastUpdate = stopOrder.createTime;
+        
+        activeOrders_[stopOrder.orderId] = stopOrder;
+        stopLossOrders_[stopOrder.orderId] = info;
+        stopOrderIds_[stopId] = stopOrder.orderId;
+    }
+    
+    std::cout << (trailing ? "Trailing stop submitted: " : "Stop order submitted: ") << stopOrder.orderId
+              << " for " << order.symbol << std::endl;
+    return stopOrder.orderId;
+}
+
+void OrderManager::checkStops(const Symbol& symbol, Price currentPrice) {
+    std::vector<StopEngine::Trigger> triggered;
+    if (stopEngine_->onPrice(symbol, currentPrice, triggered) == 0) {
+        return;
+    }
+    
+    for (const auto& trigger : triggered) {
+        triggerStop(trigger);
+    }
+}
+
+void OrderManager::triggerStop(const StopEngine::Trigger& trigger) {
+    OrderId orderId;
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex_);
+        auto idIt = stopOrderIds_.find(trigger.stopId);
+        if (idIt == stopOrderIds_.end()) {
+            return;
+        }
+        orderId = idIt->second;
+        
+        auto infoIt = stopLossOrders_.find(orderId);
+        Price limitOffset = infoIt != stopLossOrders_.end() ? infoIt->second.limitOffset : 0;
+        releaseStop(orderId);
+        
+        auto it = activeOrders_.find(orderId);
+        if (it == activeOrders_.end() || it->second.status != OrderStatus::PENDING) {
+            return;
+        }
+        
+        // The exit goes straight to the processing queue
+        Order& order = it->second;
+        order.triggerPrice = trigger.stopPrice;
+        if (order.type == OrderType::STOP_LIMIT) {
+            order.type = OrderType::LIMIT;
+            order.price = order.side == OrderSide::SELL ? trigger.stopPrice - limitOffset
+                                                        : trigger.stopPrice + limitOffset;
+        } else {
+            order.type = OrderType::MARKET;
+            order.price = trigger.stopPrice;
+        }
+        order.updateTime = std::chrono::system_clock::now();
+        
+        orderQueue_.push(order);
+        scheduleExpiry(orderId);
+    }
+    
+    orderCV_.notify_one();
+    
+    std::cout << "Stop triggered: " << orderId << " at " << trigger.stopPrice << std::endl;
+}
+
+void OrderManager::releaseStop(const OrderId& orderId) {
+    // Caller holds ordersMutex_
+    auto it = stopLossOrders_.find(orderId);
+    if (it == stopLossOrders_.end()) {
+        return;
+    }
+    
+    stopEngine_->cancelStop(it->second.stopId);
+    stopOrderIds_.erase(it->second.stopId);
+    auto posIt = positionStops_.find(it->second.symbol);
+    if (posIt != positionStops_.end() && posIt->second == orderId) {
+        positionStops_.erase(posIt);
+    }
+    stopLossOrders_.erase(it);
+}
+
+} // namespace MasterMind
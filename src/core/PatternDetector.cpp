@@ -5,12 +5,15 @@ namespace MasterMind {
 
 PatternDetector::PatternDetector() 
     : minConfidence_(0.7), partialBrickThreshold_(0.75), tickBuffer_(2),
-      setup1Enabled_(true), setup2Enabled_(true) {
+      setup1Enabled_(true), setup2Enabled_(true),
+      patternTimeout_(std::chrono::minutes(30)), timerWheel_(nullptr), expiryGeneration_(0) {
     
     std::cout << "PatternDetector initialized" << std::endl;
 }
 
-PatternDetector::~PatternDetector() = default;
+PatternDetector::~PatternDetector() {
+    setTimerWheel(nullptr);
+}
 
 std::vector<PatternResult> PatternDetector::detectPatterns(const RenkoChart& chart) {
     std::vector<PatternResult> results;
@@ -61,6 +64,7 @@ PatternResult PatternDetector::detectSetup1Pattern(const RenkoChart& chart) {
             result.suggestedEntry = chart.calculateSetup1EntryPrice(OrderSide::BUY, tickBuffer_);
             result.suggestedStop = chart.calculateStopLoss(OrderSide::BUY, tickBuffer_);
             result.bricks = recentBricks;
+            activatePattern(result);
             
             std::cout << "Setup 1 pattern detected for " << chart.getSymbol() << std::endl;
         }
@@ -97,6 +101,7 @@ PatternResult PatternDetector::detectSetup2Pattern(const RenkoChart& chart) {
             result.suggestedEntry = chart.calculateSetup2EntryPrice(OrderSide::BUY, tickBuffer_);
             result.suggestedStop = chart.calculateStopLoss(OrderSide::BUY, tickBuffer_);
             result.bricks = recentBricks;
+            activatePattern(result);
             
             std::cout << "Setup 2 pattern detected for " << chart.getSymbol() << std::endl;
         }
@@ -182,18 +187,47 @@ void PatternDetector::enableSetup2(bool enable) {
     std::cout << "Setup 2 " << (enable ? "enabled" : "disabled") << std::endl;
 }
 
+void PatternDetector::setPatternTimeout(Duration timeout) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    patternTimeout_ = timeout;
+}
+
+void PatternDetector::setTimerWheel(TimerWheel* timerWheel) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    
+    // Expiry timers belong to the previous wheel
+    if (timerWheel_) {
+        for (const auto& pair : expiryTimers_) {
+            timerWheel_->cancel(pair.second.timerId);
+        }
+    }
+    expiryTimers_.clear();
+    timerWheel_ = timerWheel;
+}
+
 bool PatternDetector::isPatternActive(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     return activePatterns_.find(symbol) != activePatterns_.end();
 }
 
 PatternType PatternDetector::getActivePattern(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     auto it = activePatterns_.find(symbol);
     return (it != activePatterns_.end()) ? it->second : PatternType::NONE;
 }
 
 void PatternDetector::clearPatternState(const Symbol& symbol) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     activePatterns_.erase(symbol);
     patternStartTime_.erase(symbol);
+    
+    auto it = expiryTimers_.find(symbol);
+    if (it != expiryTimers_.end()) {
+        if (timerWheel_) {
+            timerWheel_->cancel(it->second.timerId);
+        }
+        expiryTimers_.erase(it);
+    }
 }
 
 void PatternDetector::updatePatternStats(const PatternResult& pattern, bool successful) {
@@ -271,6 +305,52 @@ Price PatternDetector::calculateTakeProfit(const PatternResult& pattern,
     }
 }
 
+void PatternDetector::activatePattern(const PatternResult& pattern) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    
+    activePatterns_[pattern.symbol] = pattern.type;
+    patternStartTime_[pattern.symbol] = pattern.detectionTime;
+    
+    if (!timerWheel_ || patternTimeout_.count() <= 0) {
+        return;
+    }
+    
+    // Re-detection restarts the expiry window
+    auto it = expiryTimers_.find(pattern.symbol);
+    if (it != expiryTimers_.end()) {
+        timerWheel_->cancel(it->second.timerId);
+    }
+    
+    Symbol symbol = pattern.symbol;
+    uint64_t generation = ++expiryGeneration_;
+    TimerId timerId = timerWheel_->schedule(patternTimeout_, [this, symbol, generation]() {
+        expirePattern(symbol, generation);
+    });
+    expiryTimers_[symbol] = ExpiryTimer{timerId, generation};
+}
+
+void PatternDetector::expirePattern(const Symbol& symbol, uint64_t generation) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    
+    // A callback already taken off the wheel when the pattern was re-detected or cleared
+    auto timer = expiryTimers_.find(symbol);
+    if (timer == expiryTimers_.end() || timer->second.generation != generation) {
+        return;
+    }
+    expiryTimers_.erase(timer);
+    
+    auto it = activePatterns_.find(symbol);
+    if (it == activePatterns_.end()) {
+        return;
+    }
+    
+    std::cout << "Pattern expired for " << symbol << ": "
+              << patternTypeToString(it->second) << std::endl;
+    
+    activePatterns_.erase(it);
+    patternStartTime_.erase(symbol);
+}
+
 OrderSide PatternDetector::getOppositeDirection(OrderSide side) const {
     return (side == OrderSide::BUY) ? OrderSide::SELL : OrderSide::BUY;
 }
@@ -0,0 +1,283 @@
+#include "core/PersistenceQueue.h"
+#include <algorithm>
+#include <iostream>
+
+namespace MasterMind {
+
+namespace {
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+}
+
+PersistenceQueue::PersistenceQueue(DatabaseManager& database, size_t capacity,
+                                   Duration maxLatency, size_t maxBatch)
+    : database_(database), capacity_(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2))),
+      maxLatency_(maxLatency), maxBatch_(std::max<size_t>(maxBatch, 1)),
+      slots_(new Slot[capacity_]), enqueuePosition_(0), dequeuePosition_(0), processed_(0),
+      producerStalls_(0), oversizedText_(0), dropped_(0), written_(0), failed_(0), batches_(0), maxDepth_(0),
+      maxBatchSize_(0), lastCommitMicros_(0), maxCommitMicros_(0), maxRecordLatencyMicros_(0),
+      running_(false), wakeRequested_(false) {
+    for (size_t i = 0; i < capacity_; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+PersistenceQueue::~PersistenceQueue() {
+    stop();
+}
+
+bool PersistenceQueue::start() {
+    if (running_.exchange(true)) {
+        return true;
+    }
+    writer_ = std::thread(&PersistenceQueue::writerLoop, this);
+    std::cout << "Persistence queue started (capacity " << capacity_ << ")" << std::endl;
+    return true;
+}
+
+void PersistenceQueue::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    wakeWriter();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    std::cout << "Persistence queue stopped after " << written_.load() << " writes" << std::endl;
+}
+
+bool PersistenceQueue::isRunning() const {
+    return running_;
+}
+
+void PersistenceQueue::insertOrder(const Order& order) {
+    PersistenceRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.setOrder(PersistenceRecord::Kind::ORDER, order);
+    enqueue(record);
+}
+
+void PersistenceQueue::updateOrder(const Order& order) {
+    PersistenceRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.setOrder(PersistenceRecord::Kind::ORDER_UPDATE, order);
+    enqueue(record);
+}
+
+void PersistenceQueue::insertPosition(const Position& position) {
+    PersistenceRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.setPosition(PersistenceRecord::Kind::POSITION, position);
+    enqueue(record);
+}
+
+void PersistenceQueue::updatePosition(const Position& position) {
+    PersistenceRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.setPosition(PersistenceRecord::Kind::POSITION_UPDATE, position);
+    enqueue(record);
+}
+
+void PersistenceQueue::insertTradeResult(const OrderId& orderId, double pnl, const std::string& strategy) {
+    PersistenceRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.setEvent(PersistenceRecord::Kind::TRADE_RESULT, orderId, strategy, std::string(), pnl);
+    enqueue(record);
+}
+
+void PersistenceQueue::insertRiskEvent(const std::string& event, const std::string& details) {
+    PersistenceRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.setEvent(PersistenceRecord::Kind::RISK_EVENT, event, details);
+    enqueue(record);
+}
+
+void PersistenceQueue::insertCounterResult(int counterNumber, double pnl, int orderCount) {
+    PersistenceRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.setEvent(PersistenceRecord::Kind::COUNTER_RESULT, std::string(), std::string(), std::string(), pnl,
+                    counterNumber, orderCount);
+    enqueue(record);
+}
+
+void PersistenceQueue::insertAuditEntry(const std::string& action, const std::string& details,
+                                        const std::string& userId) {
+    PersistenceRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.setEvent(PersistenceRecord::Kind::AUDIT_ENTRY, action, details, userId);
+    enqueue(record);
+}
+
+void PersistenceQueue::enqueue(const PersistenceRecord& record) {
+    if (record.overflow) {
+        oversizedText_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const uint64_t mask = capacity_ - 1;
+    uint64_t position = enqueuePosition_.load(std::memory_order_relaxed);
+    bool stalled = false;
+
+    // Claim a slot: its sequence equals the position while it is free
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[position & mask];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Full: wait for the writer unless there is none to wait for
+            if (!running_) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                delete record.overflow;
+                return;
+            }
+            if (!stalled) {
+                stalled = true;
+                producerStalls_.fetch_add(1, std::memory_order_relaxed);
+                wakeWriter();
+            }
+            std::this_thread::yield();
+            position = enqueuePosition_.load(std::memory_order_relaxed);
+        } else {
+            position = enqueuePosition_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record = record;
+    slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+bool PersistenceQueue::flush(Duration timeout) {
+    uint64_t target = enqueuePosition_.load(std::memory_order_acquire);
+    if (!running_) {
+        return processed_.load(std::memory_order_acquire) >= target;
+    }
+
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    wakeRequested_ = true;
+    wakeCondition_.notify_one();
+    return flushCondition_.wait_for(lock, timeout, [this, target]() {
+        return processed_.load(std::memory_order_acquire) >= target;
+    });
+}
+
+PersistenceStats PersistenceQueue::getStats() const {
+    PersistenceStats stats;
+    stats.enqueued = enqueuePosition_.load(std::memory_order_relaxed);
+    stats.written = written_.load(std::memory_order_relaxed);
+    stats.failed = failed_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.producerStalls = producerStalls_.load(std::memory_order_relaxed);
+    stats.oversizedText = oversizedText_.load(std::memory_order_relaxed);
+    stats.depth = static_cast<size_t>(stats.enqueued - dequeuePosition_.load(std::memory_order_relaxed));
+    stats.maxDepth = maxDepth_.load(std::memory_order_relaxed);
+    stats.maxBatch = maxBatchSize_.load(std::memory_order_relaxed);
+    stats.lastCommitMicros = lastCommitMicros_.load(std::memory_order_relaxed);
+    stats.maxCommitMicros = maxCommitMicros_.load(std::memory_order_relaxed);
+    stats.maxRecordLatencyMicros = maxRecordLatencyMicros_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t PersistenceQueue::getCapacity() const {
+    return capacity_;
+}
+
+// Private methods
+void PersistenceQueue::writerLoop() {
+    std::vector<PersistenceRecord> batch;
+    batch.reserve(maxBatch_);
+
+    for (;;) {
+        size_t drained = drain(batch);
+        if (drained > 0) {
+            commit(batch);
+            if (drained == maxBatch_) {
+                continue;  // Backlog - keep going without waiting
+            }
+        }
+
+        if (!running_) {
+            // Exit only once claimed slots have all been published and written
+            if (enqueuePosition_.load(std::memory_order_acquire) == dequeuePosition_.load(std::memory_order_relaxed)) {
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCondition_.wait_for(lock, maxLatency_, [this]() { return wakeRequested_ || !running_; });
+        wakeRequested_ = false;
+    }
+}
+
+size_t PersistenceQueue::drain(std::vector<PersistenceRecord>& batch) {
+    const uint64_t mask = capacity_ - 1;
+    uint64_t position = dequeuePosition_.load(std::memory_order_relaxed);
+    size_t depth = static_cast<size_t>(enqueuePosition_.load(std::memory_order_relaxed) - position);
+    if (depth > maxDepth_.load(std::memory_order_relaxed)) {
+        maxDepth_.store(depth, std::memory_order_relaxed);
+    }
+
+    size_t count = 0;
+    while (count < maxBatch_) {
+        Slot& slot = slots_[position & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            break;  // Empty, or claimed but not yet published
+        }
+        batch.push_back(slot.record);
+        slot.sequence.store(position + capacity_, std::memory_order_release);
+        ++position;
+        ++count;
+    }
+
+    dequeuePosition_.store(position, std::memory_order_relaxed);
+    return count;
+}
+
+void PersistenceQueue::commit(std::vector<PersistenceRecord>& batch) {
+    auto start = std::chrono::steady_clock::now();
+    size_t written = database_.writeBatch(batch.data(), batch.size());
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    // Records are enqueued in order, so the first one waited longest
+    double latency = std::chrono::duration<double, std::micro>(std::chrono::system_clock::now() - batch.front().time).count();
+
+    written_.fetch_add(written, std::memory_order_relaxed);
+    failed_.fetch_add(batch.size() - written, std::memory_order_relaxed);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    maxBatchSize_.store(std::max(maxBatchSize_.load(std::memory_order_relaxed), batch.size()), std::memory_order_relaxed);
+    lastCommitMicros_.store(micros, std::memory_order_relaxed);
+    maxCommitMicros_.store(std::max(maxCommitMicros_.load(std::memory_order_relaxed), micros), std::memory_order_relaxed);
+    maxRecordLatencyMicros_.store(std::max(maxRecordLatencyMicros_.load(std::memory_order_relaxed), latency),
+                                  std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        processed_.fetch_add(batch.size(), std::memory_order_release);
+    }
+    flushCondition_.notify_all();
+    for (auto& record : batch) {
+        record.releaseOverflow();
+    }
+    batch.clear();
+}
+
+void PersistenceQueue::wakeWriter() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        wakeRequested_ = true;
+    }
+    wakeCondition_.notify_one();
+}
+
+} // namespace MasterMind
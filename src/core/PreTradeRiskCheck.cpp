@@ -0,0 +1,212 @@
+#include "core/PreTradeRiskCheck.h"
+#include "core/ExposureTracker.h"
+#include <cmath>
+#include <limits>
+
+namespace MasterMind {
+
+namespace {
+const double UNLIMITED = std::numeric_limits<double>::infinity();
+const double USE_DEFAULT = -1.0;  // Symbol limit sentinel: fall back to the default limit
+}
+
+// SymbolRegistry
+SymbolRegistry::SymbolRegistry()
+    : count_(0) {
+    for (auto& entry : table_) {
+        entry.store(0, std::memory_order_relaxed);
+    }
+}
+
+SymbolRegistry::SlotId SymbolRegistry::registerSymbol(const Symbol& symbol) {
+    std::lock_guard<std::mutex> lock(registerMutex_);
+
+    SlotId existing = find(symbol);
+    size_t count = count_.load(std::memory_order_relaxed);
+    if (existing != INVALID_SLOT || count >= CAPACITY) {
+        return existing;
+    }
+
+    // Write the name first; publishing the index makes it visible to find()
+    SlotId slot = static_cast<SlotId>(count);
+    symbols_[slot] = symbol;
+    size_t index = std::hash<Symbol>()(symbol) & (TABLE_SIZE - 1);
+    while (table_[index].load(std::memory_order_relaxed) != 0) {
+        index = (index + 1) & (TABLE_SIZE - 1);
+    }
+    table_[index].store(slot + 1, std::memory_order_release);
+    count_.store(count + 1, std::memory_order_release);
+    return slot;
+}
+
+SymbolRegistry::SlotId SymbolRegistry::find(const Symbol& symbol) const {
+    size_t index = std::hash<Symbol>()(symbol) & (TABLE_SIZE - 1);
+    for (;;) {
+        uint32_t entry = table_[index].load(std::memory_order_acquire);
+        if (entry == 0) {
+            return INVALID_SLOT;
+        }
+        if (symbols_[entry - 1] == symbol) {
+            return entry - 1;
+        }
+        index = (index + 1) & (TABLE_SIZE - 1);
+    }
+}
+
+size_t SymbolRegistry::size() const {
+    return count_.load(std::memory_order_acquire);
+}
+
+// PreTradeRiskCheck
+PreTradeRiskCheck::PreTradeRiskCheck(const ExposureTracker* positions)
+    : gates_(0), remainingDailyRisk_(UNLIMITED),
+      defaultMaxPosition_(UNLIMITED), defaultMaxExposure_(UNLIMITED), positions_(positions),
+      symbolLimits_(new SymbolLimits[SymbolRegistry::CAPACITY]) {
+    for (size_t i = 0; i < SymbolRegistry::CAPACITY; ++i) {
+        symbolLimits_[i].maxPosition.store(USE_DEFAULT, std::memory_order_relaxed);
+        symbolLimits_[i].maxExposure.store(USE_DEFAULT, std::memory_order_relaxed);
+    }
+}
+
+RiskRejectReason PreTradeRiskCheck::check(const Order& order) const {
+    checks_.value.fetch_add(1, std::memory_order_relaxed);
+
+    RiskRejectReason reason = evaluate(order);
+    if (reason != RiskRejectReason::NONE) {
+        rejects_[static_cast<size_t>(reason)].value.fetch_add(1, std::memory_order_relaxed);
+        if (rejectionCallback_) {
+            rejectionCallback_({order.orderId, order.symbol, reason});
+        }
+    }
+    return reason;
+}
+
+void PreTradeRiskCheck::setEmergencyStop(bool active) {
+    setGate(GATE_EMERGENCY, active);
+}
+
+void PreTradeRiskCheck::updateAccount(double remainingDailyRisk, bool drawdownBreached) {
+    std::lock_guard<std::mutex> lock(limitsMutex_);
+    remainingDailyRisk_.store(remainingDailyRisk, std::memory_order_relaxed);
+    setGate(GATE_DAILY_RISK, remainingDailyRisk <= 0);
+    setGate(GATE_DRAWDOWN, drawdownBreached);
+}
+
+void PreTradeRiskCheck::setDefaultLimits(Volume maxPosition, double maxExposure) {
+    std::lock_guard<std::mutex> lock(limitsMutex_);
+    defaultMaxPosition_.store(maxPosition > 0 ? maxPosition : UNLIMITED, std::memory_order_relaxed);
+    defaultMaxExposure_.store(maxExposure > 0 ? maxExposure : UNLIMITED, std::memory_order_relaxed);
+}
+
+bool PreTradeRiskCheck::setSymbolLimits(const Symbol& symbol, Volume maxPosition, double maxExposure) {
+    std::lock_guard<std::mutex> lock(limitsMutex_);
+    SymbolLimits* limits = limitsFor(symbol);
+    if (!limits) {
+        return false;
+    }
+    limits->maxPosition.store(maxPosition > 0 ? maxPosition : UNLIMITED, std::memory_order_relaxed);
+    limits->maxExposure.store(maxExposure > 0 ? maxExposure : UNLIMITED, std::memory_order_relaxed);
+    return true;
+}
+
+uint64_t PreTradeRiskCheck::getCheckCount() const {
+    return checks_.value.load(std::memory_order_relaxed);
+}
+
+uint64_t PreTradeRiskCheck::getRejectCount() const {
+    uint64_t total = 0;
+    for (const auto& counter : rejects_) {
+        total += counter.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t PreTradeRiskCheck::getRejectCount(RiskRejectReason reason) const {
+    size_t index = static_cast<size_t>(reason);
+    return index < rejects_.size() ? rejects_[index].value.load(std::memory_order_relaxed) : 0;
+}
+
+void PreTradeRiskCheck::resetCounters() {
+    checks_.value.store(0, std::memory_order_relaxed);
+    for (auto& counter : rejects_) {
+        counter.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+void PreTradeRiskCheck::setRejectionCallback(std::function<void(const RiskRejection&)> callback) {
+    rejectionCallback_ = callback;
+}
+
+const char* PreTradeRiskCheck::reasonToString(RiskRejectReason reason) {
+    switch (reason) {
+        case RiskRejectReason::NONE: return "None";
+        case RiskRejectReason::EMERGENCY_STOP: return "Emergency stop active";
+        case RiskRejectReason::DRAWDOWN_LIMIT: return "Drawdown limit exceeded";
+        case RiskRejectReason::DAILY_RISK_LIMIT: return "Daily risk limit exceeded";
+        case RiskRejectReason::INVALID_ORDER: return "Invalid order";
+        case RiskRejectReason::POSITION_LIMIT: return "Position limit exceeded";
+        case RiskRejectReason::EXPOSURE_LIMIT: return "Exposure limit exceeded";
+        default: return "Unknown";
+    }
+}
+
+// Private methods
+RiskRejectReason PreTradeRiskCheck::evaluate(const Order& order) const {
+    uint32_t gates = gates_.load(std::memory_order_acquire);
+    if (gates & GATE_EMERGENCY) {
+        return RiskRejectReason::EMERGENCY_STOP;
+    }
+
+    if (!(order.quantity > 0) || !(order.price > 0)) {
+        return RiskRejectReason::INVALID_ORDER;
+    }
+
+    double maxPosition = defaultMaxPosition_.load(std::memory_order_relaxed);
+    double maxExposure = defaultMaxExposure_.load(std::memory_order_relaxed);
+    double position = positions_ ? positions_->getPosition(order.symbol) : 0;
+    SymbolRegistry::SlotId slot = registry_.find(order.symbol);
+    if (slot != SymbolRegistry::INVALID_SLOT) {
+        const SymbolLimits& limits = symbolLimits_[slot];
+        double symbolMaxPosition = limits.maxPosition.load(std::memory_order_relaxed);
+        double symbolMaxExposure = limits.maxExposure.load(std::memory_order_relaxed);
+        maxPosition = symbolMaxPosition >= 0 ? symbolMaxPosition : maxPosition;
+        maxExposure = symbolMaxExposure >= 0 ? symbolMaxExposure : maxExposure;
+    }
+
+    // Orders that shrink the position are always allowed to reduce risk - stop-loss
+    // exits above all, which matter most once drawdown or the daily budget is hit
+    double projected = std::abs(position + (order.side == OrderSide::BUY ? order.quantity : -order.quantity));
+    if (projected <= std::abs(position)) {
+        return RiskRejectReason::NONE;
+    }
+
+    if (gates != 0) {
+        return gates & GATE_DRAWDOWN ? RiskRejectReason::DRAWDOWN_LIMIT : RiskRejectReason::DAILY_RISK_LIMIT;
+    }
+    double orderRisk = order.stopLoss > 0 ? order.quantity * std::abs(order.price - order.stopLoss) : 0.0;
+    if (orderRisk > remainingDailyRisk_.load(std::memory_order_relaxed)) {
+        return RiskRejectReason::DAILY_RISK_LIMIT;
+    }
+    if (projected > maxPosition) {
+        return RiskRejectReason::POSITION_LIMIT;
+    }
+    if (projected * order.price > maxExposure) {
+        return RiskRejectReason::EXPOSURE_LIMIT;
+    }
+    return RiskRejectReason::NONE;
+}
+
+PreTradeRiskCheck::SymbolLimits* PreTradeRiskCheck::limitsFor(const Symbol& symbol) {
+    SymbolRegistry::SlotId slot = registry_.registerSymbol(symbol);
+    return slot != SymbolRegistry::INVALID_SLOT ? &symbolLimits_[slot] : nullptr;
+}
+
+void PreTradeRiskCheck::setGate(uint32_t gate, bool active) {
+    if (active) {
+        gates_.fetch_or(gate, std::memory_order_release);
+    } else {
+        gates_.fetch_and(~gate, std::memory_order_release);
+    }
+}
+
+} // namespace MasterMind
@@ -1,13 +1,21 @@
 #include "core/RiskManager.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace MasterMind {
 
 RiskManager::RiskManager() 
     : currentStatus_(RiskStatus::NORMAL), paperMode_(false), emergencyStop_(false),
+      exposureTracker_(std::make_unique<ExposureTracker>()),
+      preTradeCheck_(std::make_unique<PreTradeRiskCheck>(exposureTracker_.get())),
+      covariance_(std::make_unique<CovarianceMatrix>()), accountEquity_(0),
       equityHighWaterMark_(0), currentDrawdown_(0), maxDrawdown_(0),
       dailyStartBalance_(0), dailyPnL_(0), dailyRiskUsed_(0),
-      consecutiveLosses_(0), consecutiveWins_(0), maxConsecutiveLosses_(0),
+      lastDailyReset_(std::chrono::system_clock::now()),
+      timerWheel_(nullptr), dailyResetTimer_(TimerWheel::INVALID_TIMER),
+      returnSampleTimer_(TimerWheel::INVALID_TIMER), lastSampledPnL_(0),
+      completedCount_(0), consecutiveLosses_(0), consecutiveWins_(0), maxConsecutiveLosses_(0),
       totalTrades_(0), profitableTrades_(0) {
     
     // Initialize with default parameters
@@ -19,20 +27,28 @@ RiskManager::RiskManager()
     std::cout << "RiskManager initialized" << std::endl;
 }
 
-RiskManager::~RiskManager() = default;
+RiskManager::~RiskManager() {
+    setTimerWheel(nullptr);
+}
 
 bool RiskManager::initialize(const RiskParameters& params) {
-    std::lock_guard<std::mutex> lock(paramsMutex_);
-    params_ = params;
-    paperMode_ = params.paperTradingMode;
+    {
+        std::lock_guard<std::mutex> lock(paramsMutex_);
+        params_ = params;
+        paperMode_ = params.paperTradingMode;
+    }
+    publishLimits();
     
     std::cout << "RiskManager initialized with parameters" << std::endl;
     return true;
 }
 
 void RiskManager::updateRiskParameters(const RiskParameters& params) {
-    std::lock_guard<std::mutex> lock(paramsMutex_);
-    params_ = params;
+    {
+        std::lock_guard<std::mutex> lock(paramsMutex_);
+        params_ = params;
+    }
+    publishLimits();
     std::cout << "Risk parameters updated" << std::endl;
 }
 
@@ -56,6 +72,9 @@ double RiskManager::calculatePositionSize(const Symbol& symbol,
     
     double positionSize = riskAmount / (stopDistance * instrument.tickValue);
     
+    // Scale down when the new position would add to correlated exposure
+    positionSize *= getCorrelationAdjustment(symbol, signal.side);
+    
     // Apply minimum and maximum limits
     positionSize = std::max(positionSize, params_.minLotSize);
     positionSize = std::min(positionSize, account.equity * 0.1); // Max 10% of equity
@@ -79,27 +98,50 @@ Volume RiskManager::calculateLotSize(const Symbol& symbol,
     return std::max(lotSize, params_.minLotSize);
 }
 
+bool RiskManager::validateOrder(const Order& order) const {
+    return preTradeCheck_->check(order) == RiskRejectReason::NONE;
+}
+
 bool RiskManager::validateOrder(const Order& order,
                               const AccountInfo& account,
                               const std::vector<Position>& positions) const {
+    return validateOrder(order);
+}
+
+void RiskManager::setSymbolLimits(const Symbol& symbol, Volume maxPosition, double maxExposure) {
+    preTradeCheck_->setSymbolLimits(symbol, maxPosition, maxExposure);
+}
+
+void RiskManager::onFill(const Symbol& symbol, OrderSide side, Volume quantity, Price price) {
+    exposureTracker_->onFill(symbol, side, quantity, price);
+}
+
+void RiskManager::onFill(const Order& order, Volume quantity, Price price) {
+    // Only the part that opens or adds to a position puts new risk on
+    double position = exposureTracker_->getSymbolExposure(order.symbol).position;
+    double updated = position + (order.side == OrderSide::BUY ? quantity : -quantity);
+    double opened = position * updated < 0 ? std::abs(updated)
+                                           : std::max(0.0, std::abs(updated) - std::abs(position));
+    onFill(order.symbol, order.side, quantity, price);
     
-    // Basic validation checks
-    if (emergencyStop_) {
-        std::cout << "Order rejected: Emergency stop active" << std::endl;
-        return false;
-    }
-    
-    if (!isWithinDailyRiskLimit(order, account)) {
-        std::cout << "Order rejected: Daily risk limit exceeded" << std::endl;
-        return false;
-    }
-    
-    if (!isWithinDrawdownLimit(account)) {
-        std::cout << "Order rejected: Drawdown limit exceeded" << std::endl;
-        return false;
+    if (opened > 0 && order.stopLoss > 0) {
+        {
+            std::lock_guard<std::mutex> lock(counterMutex_);
+            LedgerEvent event(LedgerEventType::RISK_USED, std::chrono::system_clock::now());
+            event.value = opened * std::abs(price - order.stopLoss);
+            event.reference = order.orderId;
+            commitCounterEvent(event);
+        }
+        publishLimits();
     }
-    
-    return true;
+}
+
+void RiskManager::onMarketPrice(const Symbol& symbol, Price price) {
+    exposureTracker_->onMark(symbol, price);
+}
+
+PreTradeRiskCheck* RiskManager::getPreTradeCheck() const {
+    return preTradeCheck_.get();
 }
 
 bool RiskManager::isWithinDailyRiskLimit(const Order& order,
@@ -125,7 +167,19 @@ RiskStatus RiskManager::getCurrentRiskStatus() const {
 void RiskManager::updateRiskStatus(const AccountInfo& account,
                                  const std::vector<Position>& positions) {
     
+    accountEquity_ = account.equity;
     calculateDrawdown(account.equity);
+    returnEstimator_.addEquity(account.equity);
+    if (dailyStartBalance_ <= 0) {
+        dailyStartBalance_ = account.equity;
+    }
+    
+    for (const auto& position : positions) {
+        Volume signedQuantity = position.isShort() ? -position.quantity : position.quantity;
+        exposureTracker_->setPosition(position.symbol, signedQuantity,
+                                      position.averagePrice, position.currentPrice);
+    }
+    publishLimits();
     
     if (emergencyStop_) {
         currentStatus_ = RiskStatus::LIMIT_REACHED;
@@ -163,14 +217,20 @@ bool RiskManager::shouldSwitchToLiveMode() const {
 }
 
 void RiskManager::switchToPaperMode() {
-    paperMode_ = true;
-    currentStatus_ = RiskStatus::PAPER_MODE;
-    std::cout << "Switched to paper trading mode" << std::endl;
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    LedgerEvent event(LedgerEventType::MODE_CHANGED, std::chrono::system_clock::now());
+    event.count = 1;
+    if (commitCounterEvent(event)) {
+        std::cout << "Switched to paper trading mode" << std::endl;
+    }
 }
 
 void RiskManager::switchToLiveMode() {
-    paperMode_ = false;
-    std::cout << "Switched to live trading mode" << std::endl;
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    LedgerEvent event(LedgerEventType::MODE_CHANGED, std::chrono::system_clock::now());
+    if (commitCounterEvent(event)) {
+        std::cout << "Switched to live trading mode" << std::endl;
+    }
 }
 
 bool RiskManager::isPaperMode() const {
@@ -178,20 +238,20 @@ bool RiskManager::isPaperMode() const {
 }
 
 void RiskManager::recordTrade(const Order& order, bool profitable) {
-    totalTrades_++;
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    LedgerEvent event(LedgerEventType::TRADE_RECORDED, std::chrono::system_clock::now());
+    event.count = profitable ? 1 : 0;
+    event.reference = order.orderId;
+    if (!commitCounterEvent(event)) {
+        return;
+    }
     
-    if (profitable) {
-        consecutiveWins_++;
-        consecutiveLosses_ = 0;
-        profitableTrades_++;
-    } else {
-        consecutiveLosses_++;
-        consecutiveWins_ = 0;
-        maxConsecutiveLosses_ = std::max(maxConsecutiveLosses_, consecutiveLosses_);
-        
-        if (shouldSwitchToPaperMode() && !paperMode_) {
-            switchToPaperMode();
-        }
+    // Logged as its own event so replay does not depend on the loss limit in force
+    if (!profitable && shouldSwitchToPaperMode() && !paperMode_) {
+        LedgerEvent modeChange(LedgerEventType::MODE_CHANGED, event.timestamp);
+        modeChange.count = 1;
+        commitCounterEvent(modeChange);
+        std::cout << "Switched to paper trading mode" << std::endl;
     }
     
     std::cout << "Trade recorded: " << (profitable ? "Profit" : "Loss") 
@@ -207,14 +267,21 @@ int RiskManager::getConsecutiveWins() const {
 }
 
 void RiskManager::resetConsecutiveCount() {
-    consecutiveLosses_ = 0;
-    consecutiveWins_ = 0;
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    LedgerEvent event(LedgerEventType::STREAK_RESET, std::chrono::system_clock::now());
+    commitCounterEvent(event);
 }
 
 void RiskManager::performDailyReset() {
-    dailyPnL_ = 0;
-    dailyRiskUsed_ = 0;
-    lastDailyReset_ = std::chrono::system_clock::now();
+    double equity = accountEquity_;
+    {
+        std::lock_guard<std::mutex> lock(counterMutex_);
+        LedgerEvent event(LedgerEventType::DAILY_RESET, std::chrono::system_clock::now());
+        event.value = equity > 0 ? equity : dailyStartBalance_;
+        commitCounterEvent(event);
+    }
+    
+    publishLimits();
     std::cout << "Daily reset performed" << std::endl;
 }
 
@@ -226,18 +293,172 @@ bool RiskManager::isDailyResetRequired() const {
     return isNewTradingDay();
 }
 
+void RiskManager::setTimerWheel(TimerWheel* timerWheel) {
+    if (timerWheel_) {
+        timerWheel_->cancel(dailyResetTimer_);
+        timerWheel_->cancel(returnSampleTimer_);
+        dailyResetTimer_ = TimerWheel::INVALID_TIMER;
+        returnSampleTimer_ = TimerWheel::INVALID_TIMER;
+    }
+    
+    timerWheel_ = timerWheel;
+    if (!timerWheel_) {
+        return;
+    }
+    
+    // First reset at the next UTC midnight, then every 24 hours
+    const auto day = std::chrono::hours(24);
+    auto now = std::chrono::system_clock::now();
+    auto sinceMidnight = now.time_since_epoch() % day;
+    auto untilMidnight = std::chrono::duration_cast<Duration>(day - sinceMidnight);
+    
+    dailyResetTimer_ = timerWheel_->scheduleRepeating(day, [this]() {
+        performDailyReset();
+    }, untilMidnight);
+    
+    PortfolioExposure exposure = exposureTracker_->getPortfolioExposure();
+    lastSampledPnL_ = exposure.realizedPnL + exposure.unrealizedPnL;
+    returnSampleTimer_ = timerWheel_->scheduleRepeating(RETURN_SAMPLE_INTERVAL, [this]() {
+        sampleReturn();
+    });
+}
+
+void RiskManager::recordReturn(double periodReturn) {
+    returnEstimator_.addReturn(periodReturn);
+}
+
+double RiskManager::getValueAtRisk(double confidence) const {
+    return returnEstimator_.getValueAtRisk(confidence);
+}
+
+double RiskManager::getExpectedShortfall(double confidence) const {
+    return returnEstimator_.getExpectedShortfall(confidence);
+}
+
+double RiskManager::getVolatility() const {
+    return returnEstimator_.getVolatility();
+}
+
+const StreamingRiskEstimator& RiskManager::getReturnEstimator() const {
+    return returnEstimator_;
+}
+
+double RiskManager::getTotalExposure() const {
+    return exposureTracker_->getPortfolioExposure().grossExposure;
+}
+
+double RiskManager::getSymbolExposure(const Symbol& symbol) const {
+    return exposureTracker_->getSymbolExposure(symbol).exposure;
+}
+
+PortfolioExposure RiskManager::getPortfolioExposure() const {
+    return exposureTracker_->getPortfolioExposure();
+}
+
+ExposureTracker* RiskManager::getExposureTracker() const {
+    return exposureTracker_.get();
+}
+
+void RiskManager::onBar(const Symbol& symbol, const OHLC& bar) {
+    covariance_->onBar(symbol, bar.close, bar.timestamp);
+}
+
+double RiskManager::getPortfolioRisk() const {
+    return calculatePortfolioRisk(getCurrentExposures());
+}
+
+double RiskManager::getCorrelationRisk() const {
+    return calculateCorrelationRisk(getCurrentExposures());
+}
+
+double RiskManager::getCorrelationAdjustment(const Symbol& symbol, OrderSide side) const {
+    std::unordered_map<Symbol, double> exposures = getCurrentExposures();
+    double portfolioVariance = covariance_->portfolioVariance(exposures);
+    double volatility = covariance_->getVolatility(symbol);
+    if (portfolioVariance <= 0 || volatility <= 0) {
+        return 1.0;
+    }
+    
+    // Correlation of the candidate's returns with the current portfolio's P&L
+    double correlation = covariance_->covarianceWithPortfolio(symbol, exposures) /
+                         (volatility * std::sqrt(portfolioVariance));
+    double direction = side == OrderSide::BUY ? 1.0 : -1.0;
+    return 1.0 / (1.0 + std::max(0.0, std::min(1.0, direction * correlation)));
+}
+
+CovarianceMatrix* RiskManager::getCovarianceMatrix() const {
+    return covariance_.get();
+}
+
+double RiskManager::calculatePortfolioRisk(const std::vector<Position>& positions) const {
+    std::unordered_map<Symbol, double> exposures;
+    for (const auto& position : positions) {
+        exposures[position.symbol] += position.isShort() ? -position.getMarketValue() : position.getMarketValue();
+    }
+    return calculatePortfolioRisk(exposures);
+}
+
+double RiskManager::calculateCorrelationRisk(const std::vector<Position>& positions) const {
+    std::unordered_map<Symbol, double> exposures;
+    for (const auto& position : positions) {
+        exposures[position.symbol] += position.isShort() ? -position.getMarketValue() : position.getMarketValue();
+    }
+    return calculateCorrelationRisk(exposures);
+}
+
+double RiskManager::calculatePortfolioRisk(const std::unordered_map<Symbol, double>& exposures) const {
+    return std::sqrt(std::max(0.0, covariance_->portfolioVariance(exposures)));
+}
+
+double RiskManager::calculateCorrelationRisk(const std::unordered_map<Symbol, double>& exposures) const {
+    // Positive when correlations concentrate risk, negative when they hedge it
+    double undiversified = std::sqrt(std::max(0.0, covariance_->undiversifiedVariance(exposures)));
+    return calculatePortfolioRisk(exposures) - undiversified;
+}
+
+std::unordered_map<Symbol, double> RiskManager::getCurrentExposures() const {
+    std::unordered_map<Symbol, double> exposures;
+    for (const auto& symbol : covariance_->getSymbols()) {
+        SymbolExposure exposure = exposureTracker_->getSymbolExposure(symbol);
+        if (exposure.position != 0) {
+            exposures[symbol] = exposure.position * exposure.markPrice;
+        }
+    }
+    return exposures;
+}
+
+double RiskManager::getTotalExposure(const std::vector<Position>& positions) const {
+    double exposure = 0;
+    for (const auto& position : positions) {
+        exposure += std::abs(position.getMarketValue());
+    }
+    return exposure;
+}
+
+double RiskManager::getSymbolExposure(const Symbol& symbol, const std::vector<Position>& positions) const {
+    double exposure = 0;
+    for (const auto& position : positions) {
+        if (position.symbol == symbol) {
+            exposure += std::abs(position.getMarketValue());
+        }
+    }
+    return exposure;
+}
+
 double RiskManager::getEquityHighWaterMark() const {
     return equityHighWaterMark_;
 }
 
 void RiskManager::enableEmergencyStop() {
     emergencyStop_ = true;
+    preTradeCheck_->setEmergencyStop(true);
     currentStatus_ = RiskStatus::LIMIT_REACHED;
     std::cout << "Emergency stop activated" << std::endl;
 }
 
 void RiskManager::disableEmergencyStop() {
     emergencyStop_ = false;
+    preTradeCheck_->setEmergencyStop(false);
     std::cout << "Emergency stop deactivated" << std::endl;
 }
 
@@ -257,8 +478,161 @@ void RiskManager::calculateDrawdown(double currentEquity) {
     
     if (equityHighWaterMark_ > 0) {
         currentDrawdown_ = (equityHighWaterMark_ - currentEquity) / equityHighWaterMark_;
-        maxDrawdown_ = std::max(maxDrawdown_, currentDrawdown_);
+        maxDrawdown_ = std::max(maxDrawdown_, currentDrawdown_.load());
+    }
+}
+
+void RiskManager::publishLimits() {
+    double equity = accountEquity_;
+    if (equity <= 0) {
+        return;  // No account snapshot yet - the budget is unknown
     }
+    
+    RiskParameters params = getRiskParameters();
+    double remaining = equity * params.dailyRiskPercent - dailyRiskUsed_;
+    preTradeCheck_->updateAccount(remaining, currentDrawdown_ >= params.maxDrawdownPercent);
+    
+    // Symbols without configured limits may hold up to the usable capital
+    preTradeCheck_->setDefaultLimits(0, equity * params.capitalUtilization);
+}
+
+void RiskManager::addDailyRiskUsed(double risk) {
+    double used = dailyRiskUsed_.load();
+    while (!dailyRiskUsed_.compare_exchange_weak(used, used + risk)) {
+    }
+}
+
+void RiskManager::sampleReturn() {
+    // Fills move realized P&L and marks the unrealized part; the tracker
+    // carries both, so one snapshot covers everything since the last sample
+    PortfolioExposure exposure = exposureTracker_->getPortfolioExposure();
+    double pnl = exposure.realizedPnL + exposure.unrealizedPnL;
+    double change = pnl - lastSampledPnL_;
+    lastSampledPnL_ = pnl;
+    
+    double equity = accountEquity_;
+    if (equity <= 0 || (change == 0 && exposure.openPositions == 0)) {
+        return;  // Flat and idle: no return to speak of
+    }
+    recordReturn(change / equity);
+}
+
+bool RiskManager::commitCounterEvent(LedgerEvent& event) {
+    // Write-ahead: the event is durable before the state reflects it. State
+    // that can no longer be persisted must not drive trading, so a failed
+    // write leaves it unchanged and halts new orders.
+    if (ledger_ && !ledger_->append(event)) {
+        if (!emergencyStop_) {
+            enableEmergencyStop();
+            sendRiskAlert("Counter ledger write failed; new orders halted by emergency stop");
+        }
+        return false;
+    }
+    applyCounterEvent(event);
+    
+    if (ledger_ && ledger_->isSnapshotDue()) {
+        ledger_->writeSnapshot(makeSnapshot());
+    }
+    return true;
+}
+
+void RiskManager::applyCounterEvent(const LedgerEvent& event) {
+    switch (event.type) {
+        case LedgerEventType::COUNTER_STARTED:
+            currentCounter_ = TradingCounter();
+            currentCounter_.counterNumber = static_cast<int>(event.count);
+            currentCounter_.initialCapital = event.value;
+            currentCounter_.currentCapital = event.value;
+            currentCounter_.startTime = event.timestamp;
+            break;
+        case LedgerEventType::ORDER_ADDED:
+            currentCounter_.orderIds.push_back(event.reference);
+            currentCounter_.ordersCount++;
+            break;
+        case LedgerEventType::COUNTER_PNL:
+            currentCounter_.totalPnL += event.value;
+            currentCounter_.totalCharges += event.value2;
+            currentCounter_.currentCapital = currentCounter_.initialCapital +
+                                             currentCounter_.totalPnL - currentCounter_.totalCharges;
+            dailyPnL_ += event.value - event.value2;
+            break;
+        case LedgerEventType::COUNTER_COMPLETED:
+            currentCounter_.isComplete = true;
+            currentCounter_.endTime = event.timestamp;
+            completedCounters_.push_back(currentCounter_);
+            if (completedCounters_.size() > MAX_COMPLETED_COUNTERS) {
+                completedCounters_.pop_front();
+            }
+            completedCount_++;
+            break;
+        case LedgerEventType::TRADE_RECORDED:
+            totalTrades_++;
+            lastTradeTime_ = event.timestamp;
+            if (event.count != 0) {
+                consecutiveWins_++;
+                consecutiveLosses_ = 0;
+                profitableTrades_++;
+            } else {
+                consecutiveLosses_++;
+                consecutiveWins_ = 0;
+                maxConsecutiveLosses_ = std::max(maxConsecutiveLosses_, consecutiveLosses_);
+            }
+            break;
+        case LedgerEventType::MODE_CHANGED:
+            paperMode_ = event.count != 0;
+            if (paperMode_) {
+                currentStatus_ = RiskStatus::PAPER_MODE;
+            }
+            break;
+        case LedgerEventType::DAILY_RESET:
+            dailyStartBalance_ = event.value;
+            dailyPnL_ = 0;
+            dailyRiskUsed_ = 0;
+            lastDailyReset_ = event.timestamp;
+            break;
+        case LedgerEventType::STREAK_RESET:
+            consecutiveLosses_ = 0;
+            consecutiveWins_ = 0;
+            break;
+        case LedgerEventType::RISK_USED:
+            addDailyRiskUsed(event.value);
+            break;
+    }
+}
+
+LedgerSnapshot RiskManager::makeSnapshot() const {
+    LedgerSnapshot snapshot;
+    snapshot.sequence = ledger_ ? ledger_->getSequence() : 0;
+    snapshot.currentCounter = currentCounter_;
+    snapshot.completedCounters.assign(completedCounters_.begin(), completedCounters_.end());
+    snapshot.completedCount = completedCount_;
+    snapshot.consecutiveLosses = consecutiveLosses_;
+    snapshot.consecutiveWins = consecutiveWins_;
+    snapshot.maxConsecutiveLosses = maxConsecutiveLosses_;
+    snapshot.totalTrades = totalTrades_;
+    snapshot.profitableTrades = profitableTrades_;
+    snapshot.paperMode = paperMode_;
+    snapshot.dailyStartBalance = dailyStartBalance_;
+    snapshot.dailyPnL = dailyPnL_;
+    snapshot.dailyRiskUsed = dailyRiskUsed_;
+    snapshot.lastDailyReset = lastDailyReset_;
+    return snapshot;
+}
+
+void RiskManager::restoreSnapshot(const LedgerSnapshot& snapshot) {
+    currentCounter_ = snapshot.currentCounter;
+    completedCounters_.assign(snapshot.completedCounters.begin(), snapshot.completedCounters.end());
+    completedCount_ = snapshot.completedCount;
+    consecutiveLosses_ = snapshot.consecutiveLosses;
+    consecutiveWins_ = snapshot.consecutiveWins;
+    maxConsecutiveLosses_ = snapshot.maxConsecutiveLosses;
+    totalTrades_ = snapshot.totalTrades;
+    profitableTrades_ = snapshot.profitableTrades;
+    paperMode_ = snapshot.paperMode;
+    dailyStartBalance_ = snapshot.dailyStartBalance;
+    dailyPnL_ = snapshot.dailyPnL;
+    dailyRiskUsed_ = snapshot.dailyRiskUsed;
+    lastDailyReset_ = snapshot.lastDailyReset;
 }
 
 bool RiskManager::isNewTradingDay() const {
@@ -271,29 +645,42 @@ bool RiskManager::isNewTradingDay() const {
 void RiskManager::startNewCounter() {
     std::lock_guard<std::mutex> lock(counterMutex_);
     if (currentCounter_.isComplete || currentCounter_.ordersCount == 0) {
-        currentCounter_ = TradingCounter();
-        currentCounter_.counterNumber = completedCounters_.size() + 1;
-        currentCounter_.startTime = std::chrono::system_clock::now();
+        LedgerEvent event(LedgerEventType::COUNTER_STARTED, std::chrono::system_clock::now());
+        event.count = completedCount_ + 1;
+        event.value = accountEquity_;
+        if (!commitCounterEvent(event)) {
+            return;
+        }
         std::cout << "Started new counter #" << currentCounter_.counterNumber << std::endl;
     }
 }
 
 void RiskManager::addOrderToCounter(const Order& order) {
     std::lock_guard<std::mutex> lock(counterMutex_);
-    currentCounter_.orders.push_back(order);
-    currentCounter_.ordersCount++;
+    LedgerEvent event(LedgerEventType::ORDER_ADDED, std::chrono::system_clock::now());
+    event.reference = order.orderId;
+    if (!commitCounterEvent(event)) {
+        return;
+    }
     
-    if (currentCounter_.ordersCount >= params_.ordersPerCounter) {
-        completeCounter();
+    if (currentCounter_.ordersCount >= params_.ordersPerCounter && !currentCounter_.isComplete) {
+        LedgerEvent completion(LedgerEventType::COUNTER_COMPLETED, event.timestamp);
+        commitCounterEvent(completion);
+        std::cout << "Counter #" << currentCounter_.counterNumber 
+                  << " completed with " << currentCounter_.ordersCount << " orders" << std::endl;
     }
 }
 
 void RiskManager::completeCounter() {
     std::lock_guard<std::mutex> lock(counterMutex_);
-    currentCounter_.isComplete = true;
-    currentCounter_.endTime = std::chrono::system_clock::now();
+    if (currentCounter_.isComplete) {
+        return;
+    }
     
-    completedCounters_.push_back(currentCounter_);
+    LedgerEvent event(LedgerEventType::COUNTER_COMPLETED, std::chrono::system_clock::now());
+    if (!commitCounterEvent(event)) {
+        return;
+    }
     std::cout << "Counter #" << currentCounter_.counterNumber 
               << " completed with " << currentCounter_.ordersCount << " orders" << std::endl;
 }
@@ -318,16 +705,147 @@ double RiskManager::getCounterPnL() const {
 }
 
 double RiskManager::getCapitalAfterCounter(double initialCapital) const {
-    return initialCapital + getCounterPnL() - currentCounter_.totalCharges;
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    return initialCapital + currentCounter_.totalPnL - currentCounter_.totalCharges;
+}
+
+void RiskManager::recordCounterPnL(double pnl, double charges) {
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    LedgerEvent event(LedgerEventType::COUNTER_PNL, std::chrono::system_clock::now());
+    event.value = pnl;
+    event.value2 = charges;
+    commitCounterEvent(event);
+}
+
+int RiskManager::getCompletedCounterCount() const {
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    return completedCount_;
+}
+
+bool RiskManager::openLedger(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    ledger_ = std::make_unique<CounterLedger>();
+    bool opened = ledger_->open(directory,
+        [this](const LedgerSnapshot& snapshot) { restoreSnapshot(snapshot); },
+        [this](const LedgerEvent& event) { applyCounterEvent(event); });
+    if (!opened) {
+        ledger_.reset();
+        return false;
+    }
+    
+    if (paperMode_) {
+        currentStatus_ = RiskStatus::PAPER_MODE;
+    }
+    publishLimits();  // Restored daily risk shrinks the remaining budget
+    std::cout << "Counter state restored: counter #" << currentCounter_.counterNumber
+              << ", " << consecutiveLosses_ << " consecutive losses" << std::endl;
+    return true;
+}
+
+void RiskManager::closeLedger() {
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    ledger_.reset();
+}
+
+bool RiskManager::snapshotLedger() {
+    std::lock_guard<std::mutex> lock(counterMutex_);
+    return ledger_ && ledger_->writeSnapshot(makeSnapshot());
+}
+
+MonteCarloResult RiskManager::simulateCounters(const std::vector<double>& tradeResults,
+                                               const MonteCarloConfig& config) const {
+    MonteCarloRiskSimulator simulator(getRiskParameters());
+    simulator.setTradeResults(tradeResults);
+    return simulator.run(config);
 }
 
 // Stub implementations for remaining methods
 double RiskManager::getRiskAdjustedReturn() const { return 0.0; }
-double RiskManager::getSharpeRatio() const { return 0.0; }
+double RiskManager::getSharpeRatio() const {
+    const Duration year = std::chrono::hours(24 * 365);  // Crypto venues trade around the clock
+    return returnEstimator_.getSharpeRatio(0.02, static_cast<int>(year / RETURN_SAMPLE_INTERVAL));
+}
 double RiskManager::getMaxConsecutiveLoss() const { return maxConsecutiveLosses_; }
 double RiskManager::getMaxPositionSize(const Symbol& symbol, const InstrumentSpec& instrument) const { return 1000.0; }
-double RiskManager::getTotalExposure(const std::vector<Position>& positions) const { return 0.0; }
-double RiskManager::getSymbolExposure(const Symbol& symbol, const std::vector<Position>& positions) const { return 0.0; }
 void RiskManager::setRiskAlertCallback(std::function<void(const std::string&)> callback) { riskAlertCallback_ = callback; }
 
-} // namespace MasterMind 
\ No newline at end of file
+void RiskManager::sendRiskAlert(const std::string& message) {
+    std::cout << "Risk alert: " << message << std::endl;
+    if (riskAlertCallback_) {
+        riskAlertCallback_(message);
+    }
+}
+
+// RiskAssessment
+double RiskAssessment::calculateVaR(const std::vector<double>& returns, double confidence) {
+    if (returns.empty()) {
+        return 0.0;
+    }
+    
+    // Selection, not a sort: only the tail quantile has to be in place
+    std::vector<double> values(returns);
+    size_t index = std::min(values.size() - 1,
+                            static_cast<size_t>((1.0 - confidence) * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return -values[index];
+}
+
+double RiskAssessment::calculateExpectedShortfall(const std::vector<double>& returns, double confidence) {
+    if (returns.empty()) {
+        return 0.0;
+    }
+    
+    std::vector<double> values(returns);
+    size_t index = std::min(values.size() - 1,
+                            static_cast<size_t>((1.0 - confidence) * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    
+    double sum = 0;
+    for (size_t i = 0; i <= index; ++i) {
+        sum += values[i];
+    }
+    return -sum / (index + 1);
+}
+
+double RiskAssessment::calculateMaxDrawdown(const std::vector<double>& equityCurve) {
+    double peak = 0;
+    double maxDrawdown = 0;
+    for (double equity : equityCurve) {
+        peak = std::max(peak, equity);
+        if (peak > 0) {
+            maxDrawdown = std::max(maxDrawdown, (peak - equity) / peak);
+        }
+    }
+    return maxDrawdown;
+}
+
+double RiskAssessment::calculateSharpeRatio(const std::vector<double>& returns, double riskFreeRate) {
+    const int periodsPerYear = 252;
+    double volatility = calculateVolatility(returns);
+    if (volatility <= 0) {
+        return 0.0;
+    }
+    
+    double mean = 0;
+    for (double value : returns) {
+        mean += value;
+    }
+    mean /= returns.size();
+    return (mean - riskFreeRate / periodsPerYear) / volatility * std::sqrt(static_cast<double>(periodsPerYear));
+}
+
+double RiskAssessment::calculateVolatility(const std::vector<double>& returns) {
+    // Welford: one pass, numerically stable
+    double mean = 0;
+    double m2 = 0;
+    size_t count = 0;
+    for (double value : returns) {
+        count++;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+    return count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+}
+
+} // namespace MasterMind
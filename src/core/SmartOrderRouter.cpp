@@ -0,0 +1,332 @@
+#include "core/OrderManager.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MasterMind {
+
+namespace {
+constexpr double UNFILLED_PENALTY = 0.01;       // Quantity the visible book cannot absorb
+constexpr double NO_BOOK_PENALTY = 0.0005;      // Venue without depth or history
+constexpr double FILL_FAILURE_PENALTY = 0.002;  // Scaled by (1 - fill rate)
+constexpr size_t MARKET_DEPTH_LEVELS = 10;
+const double NO_DATA = std::numeric_limits<double>::quiet_NaN();
+
+double valueOr(double value, double fallback) {
+    return std::isnan(value) ? fallback : value;
+}
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+}
+
+SmartOrderRouter::SmartOrderRouter()
+    : latencyCostPerMs_(0.00001), alpha_(0.1) {
+    for (auto& slot : slots_) {
+        slot.api = nullptr;
+        slot.avgSpread = NO_DATA;
+        slot.avgSlippage = NO_DATA;
+        slot.fillRate = NO_DATA;
+        slot.avgLatencyMs = NO_DATA;
+        slot.avgVolume = NO_DATA;
+        slot.samples = 0;
+        slot.lastUpdateMs = 0;
+    }
+}
+
+void SmartOrderRouter::addExchange(Exchange exchange, ExchangeAPI* api) {
+    slots_[static_cast<size_t>(exchange)].api.store(api, std::memory_order_release);
+}
+
+void SmartOrderRouter::removeExchange(Exchange exchange) {
+    slots_[static_cast<size_t>(exchange)].api.store(nullptr, std::memory_order_release);
+}
+
+std::vector<Exchange> SmartOrderRouter::getExchanges() const {
+    std::vector<Exchange> exchanges;
+    for (size_t i = 0; i < MAX_EXCHANGES; ++i) {
+        if (slots_[i].api.load(std::memory_order_acquire)) {
+            exchanges.push_back(static_cast<Exchange>(i));
+        }
+    }
+    return exchanges;
+}
+
+Exchange SmartOrderRouter::selectBestExchange(const Order& order,
+                                              const std::vector<Exchange>& availableExchanges) const {
+    if (availableExchanges.empty()) {
+        return Exchange::BINANCE;
+    }
+
+    Exchange best = availableExchanges.front();
+    double bestCost = std::numeric_limits<double>::infinity();
+    for (Exchange exchange : availableExchanges) {
+        double cost = estimateExecutionCost(order, exchange);
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = exchange;
+        }
+    }
+    return best;
+}
+
+std::vector<Order> SmartOrderRouter::splitOrder(const Order& order, int maxSlices) const {
+    std::vector<Order> children;
+    if (maxSlices < 1 || order.quantity <= 0) {
+        return children;
+    }
+
+    struct Candidate {
+        Exchange exchange;
+        double cost;
+        Volume depth;
+    };
+    std::array<Candidate, MAX_EXCHANGES> candidates;
+    size_t count = 0;
+
+    OrderSide bookSide = order.side == OrderSide::BUY ? OrderSide::SELL : OrderSide::BUY;
+    bool priced = order.type != OrderType::MARKET && order.type != OrderType::STOP && order.price > 0;
+
+    for (size_t i = 0; i < MAX_EXCHANGES; ++i) {
+        ExchangeAPI* api = slots_[i].api.load(std::memory_order_acquire);
+        if (!api) {
+            continue;
+        }
+        Exchange exchange = static_cast<Exchange>(i);
+        double cost = estimateExecutionCost(order, exchange);
+        if (!std::isfinite(cost)) {
+            continue;
+        }
+
+        Volume depth = 0;
+        auto book = api->getOrderBook(order.symbol);
+        if (book) {
+            depth = priced ? book->getVolumeWithin(bookSide, order.price)
+                           : book->getCumulativeVolume(bookSide, MARKET_DEPTH_LEVELS);
+        }
+        // Insertion keeps the (at most MAX_EXCHANGES) candidates ordered by cost
+        size_t pos = count++;
+        while (pos > 0 && candidates[pos - 1].cost > cost) {
+            candidates[pos] = candidates[pos - 1];
+            --pos;
+        }
+        candidates[pos] = {exchange, cost, depth};
+    }
+
+    if (count == 0) {
+        return children;
+    }
+
+    // Fill the cheapest venues up to their displayed depth
+    Volume remaining = order.quantity;
+    for (size_t i = 0; i < count && remaining > 0 && static_cast<int>(children.size()) < maxSlices; ++i) {
+        Volume quantity = std::min(remaining, candidates[i].depth);
+        if (quantity <= 0) {
+            continue;
+        }
+        Order child = order;
+        child.quantity = quantity;
+        child.exchange = toExchangeId(candidates[i].exchange);
+        children.push_back(child);
+        remaining -= quantity;
+    }
+
+    // Whatever the books cannot show goes to the cheapest venue
+    if (remaining > 0) {
+        if (children.empty()) {
+            Order child = order;
+            child.exchange = toExchangeId(candidates[0].exchange);
+            children.push_back(child);
+        } else {
+            children.front().quantity += remaining;
+        }
+    }
+
+    return children;
+}
+
+double SmartOrderRouter::estimateExecutionCost(const Order& order, Exchange exchange) const {
+    const MetricsSlot& slot = slots_[static_cast<size_t>(exchange)];
+    ExchangeAPI* api = slot.api.load(std::memory_order_acquire);
+    if (!api || !api->isConnected() || !api->isSymbolAvailable(order.symbol) || order.quantity <= 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double avgSpread = valueOr(slot.avgSpread.load(std::memory_order_relaxed), 0.0);
+    double avgSlippage = valueOr(slot.avgSlippage.load(std::memory_order_relaxed), 0.0);
+    double fillRate = valueOr(slot.fillRate.load(std::memory_order_relaxed), 1.0);
+    double latencyMs = valueOr(slot.avgLatencyMs.load(std::memory_order_relaxed), 0.0);
+
+    // Spread and impact from the live book, falling back to history
+    double impact = 0;
+    Price reference = order.price;
+    auto book = api->getOrderBook(order.symbol);
+    Price mid = book ? book->getMidPrice() : 0;
+    if (mid > 0) {
+        Volume filled = 0;
+        Price average = book->estimateAverageFillPrice(order.side, order.quantity, &filled);
+        if (filled > 0) {
+            double direction = order.side == OrderSide::BUY ? 1.0 : -1.0;
+            impact = direction * (average - mid) / mid;
+        }
+        impact += (order.quantity - filled) / order.quantity * UNFILLED_PENALTY;
+        reference = mid;
+    } else {
+        impact = avgSpread / 2.0 + std::max(0.0, avgSlippage) +
+                 (slot.samples.load(std::memory_order_relaxed) == 0 ? NO_BOOK_PENALTY : 0.0);
+    }
+
+    double fee = 0;
+    if (reference > 0) {
+        Order priced = order;
+        priced.price = reference;
+        fee = api->calculateTradingFee(priced) / (reference * order.quantity);
+    }
+
+    double latency = latencyMs * latencyCostPerMs_.load(std::memory_order_relaxed);
+    double fillRisk = (1.0 - fillRate) * FILL_FAILURE_PENALTY;
+
+    return fee + impact + latency + fillRisk;
+}
+
+void SmartOrderRouter::onOrderSent(const Order& order, Exchange exchange) {
+    MetricsSlot& slot = slots_[static_cast<size_t>(exchange)];
+    ExchangeAPI* api = slot.api.load(std::memory_order_acquire);
+
+    std::lock_guard<std::mutex> lock(feedbackMutex_);
+
+    auto book = api ? api->getOrderBook(order.symbol) : nullptr;
+    if (book) {
+        TopOfBook top = book->getTopOfBook();
+        if (top.bid > 0 && top.ask > 0) {
+            updateAverage(slot.avgSpread, (top.ask - top.bid) / ((top.ask + top.bid) / 2.0));
+        }
+    }
+
+    RoutedOrder routed{exchange, order, referencePrice(api, order),
+                       std::chrono::system_clock::now(), 0, 0, false};
+    routedOrders_[order.orderId] = routed;
+}
+
+void SmartOrderRouter::onOrderAcknowledged(const OrderId& orderId) {
+    std::lock_guard<std::mutex> lock(feedbackMutex_);
+
+    auto it = routedOrders_.find(orderId);
+    if (it == routedOrders_.end() || it->second.acknowledged) {
+        return;
+    }
+
+    auto latency = std::chrono::duration<double, std::milli>(
+        std::chrono::system_clock::now() - it->second.sentAt).count();
+    updateAverage(slots_[static_cast<size_t>(it->second.exchange)].avgLatencyMs, latency);
+    it->second.acknowledged = true;
+}
+
+void SmartOrderRouter::onOrderFill(const OrderId& orderId, Volume quantity, Price price) {
+    std::lock_guard<std::mutex> lock(feedbackMutex_);
+
+    auto it = routedOrders_.find(orderId);
+    if (it != routedOrders_.end()) {
+        it->second.filledQuantity += quantity;
+        it->second.filledNotional += quantity * price;
+    }
+}
+
+void SmartOrderRouter::onOrderCompleted(const OrderId& orderId) {
+    std::lock_guard<std::mutex> lock(feedbackMutex_);
+
+    auto it = routedOrders_.find(orderId);
+    if (it == routedOrders_.end()) {
+        return;
+    }
+
+    RoutedOrder& routed = it->second;
+    double slippage = 0;
+    if (routed.filledQuantity > 0 && routed.arrivalPrice > 0) {
+        Price averageFill = routed.filledNotional / routed.filledQuantity;
+        double direction = routed.order.side == OrderSide::BUY ? 1.0 : -1.0;
+        slippage = direction * (averageFill - routed.arrivalPrice) / routed.arrivalPrice;
+    }
+
+    routed.order.filledQuantity = routed.filledQuantity;
+    updateExchangeMetrics(routed.exchange, routed.order, slippage, routed.filledQuantity > 0);
+    routedOrders_.erase(it);
+}
+
+SmartOrderRouter::ExchangeMetrics SmartOrderRouter::getExchangeMetrics(Exchange exchange) const {
+    const MetricsSlot& slot = slots_[static_cast<size_t>(exchange)];
+
+    ExchangeMetrics metrics;
+    metrics.avgSpread = valueOr(slot.avgSpread.load(std::memory_order_relaxed), 0.0);
+    metrics.avgSlippage = valueOr(slot.avgSlippage.load(std::memory_order_relaxed), 0.0);
+    metrics.fillRate = valueOr(slot.fillRate.load(std::memory_order_relaxed), 1.0);
+    metrics.avgLatencyMs = valueOr(slot.avgLatencyMs.load(std::memory_order_relaxed), 0.0);
+    metrics.avgVolume = valueOr(slot.avgVolume.load(std::memory_order_relaxed), 0.0);
+    metrics.samples = slot.samples.load(std::memory_order_relaxed);
+    metrics.lastUpdate = TimePoint(std::chrono::milliseconds(slot.lastUpdateMs.load(std::memory_order_relaxed)));
+    return metrics;
+}
+
+void SmartOrderRouter::setLatencyCostPerMs(double cost) {
+    latencyCostPerMs_ = std::max(0.0, cost);
+}
+
+void SmartOrderRouter::setMetricsSmoothing(double alpha) {
+    alpha_ = std::min(1.0, std::max(0.001, alpha));
+}
+
+ExchangeId SmartOrderRouter::toExchangeId(Exchange exchange) {
+    switch (exchange) {
+        case Exchange::BINANCE: return "BINANCE";
+        case Exchange::DERIBIT: return "DERIBIT";
+        case Exchange::COINBASE: return "COINBASE";
+        case Exchange::DELTA_EXCHANGE: return "DELTA_EXCHANGE";
+        case Exchange::MT4: return "MT4";
+        case Exchange::MT5: return "MT5";
+        case Exchange::SIMULATED: return "SIMULATED";
+    }
+    return "";
+}
+
+bool SmartOrderRouter::fromExchangeId(const ExchangeId& id, Exchange& exchange) {
+    for (size_t i = 0; i < MAX_EXCHANGES; ++i) {
+        if (toExchangeId(static_cast<Exchange>(i)) == id) {
+            exchange = static_cast<Exchange>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Private methods (caller holds feedbackMutex_)
+void SmartOrderRouter::updateExchangeMetrics(Exchange exchange, const Order& order,
+                                             double slippage, bool filled) {
+    MetricsSlot& slot = slots_[static_cast<size_t>(exchange)];
+
+    if (filled) {
+        updateAverage(slot.avgSlippage, slippage);
+        updateAverage(slot.avgVolume, order.filledQuantity);
+    }
+    double fillRatio = order.quantity > 0 ? std::min(1.0, order.filledQuantity / order.quantity) : 0.0;
+    updateAverage(slot.fillRate, fillRatio);
+
+    slot.samples.fetch_add(1, std::memory_order_relaxed);
+    slot.lastUpdateMs.store(nowMs(), std::memory_order_relaxed);
+}
+
+void SmartOrderRouter::updateAverage(std::atomic<double>& average, double sample) const {
+    double current = average.load(std::memory_order_relaxed);
+    double alpha = alpha_.load(std::memory_order_relaxed);
+    average.store(std::isnan(current) ? sample : current + alpha * (sample - current),
+                  std::memory_order_relaxed);
+}
+
+Price SmartOrderRouter::referencePrice(ExchangeAPI* api, const Order& order) const {
+    auto book = api ? api->getOrderBook(order.symbol) : nullptr;
+    Price mid = book ? book->getMidPrice() : 0;
+    return mid > 0 ? mid : order.price;
+}
+
+} // namespace MasterMind
@@ -0,0 +1,335 @@
+#include "core/StopEngine.h"
+#include <algorithm>
+#include <limits>
+
+namespace MasterMind {
+
+namespace {
+const double NO_LEVEL = -std::numeric_limits<double>::infinity();
+}
+
+StopEngine::StopEngine()
+    : nextStopId_(1), stopCount_(0) {
+}
+
+StopId StopEngine::addStop(const Symbol& symbol, OrderSide exitSide, Price stopPrice) {
+    if (stopPrice <= 0) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(engineMutex_);
+
+    SymbolStops& stops = symbols_[symbol];
+    Side& side = stops.sides[sideIndex(exitSide)];
+
+    StopId stopId = nextStopId_++;
+    StopRecord& record = stops_[stopId];
+    record.symbol = symbol;
+    record.exitSide = exitSide;
+    record.fixedIt = side.fixed.emplace(side.sign * stopPrice, stopId);
+
+    stops.count++;
+    stopCount_++;
+    return stopId;
+}
+
+StopId StopEngine::addTrailingStop(const Symbol& symbol, OrderSide exitSide, Price referencePrice,
+                                   double trail, bool percent) {
+    if (trail <= 0 || (percent && trail >= 1.0)) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(engineMutex_);
+
+    SymbolStops& stops = symbols_[symbol];
+    Price price = stops.lastPrice > 0 ? stops.lastPrice : referencePrice;
+    if (price <= 0) {
+        return 0;
+    }
+
+    // The new stop's high-water mark is the current price: join the top
+    // group when it sits exactly there, otherwise start a new one
+    Side& side = stops.sides[sideIndex(exitSide)];
+    double x = side.sign * price;
+    ratchet(side, x);
+    if (side.groups.empty() || side.groups.back()->peak != x) {
+        side.groups.push_back(std::make_unique<Group>());
+        side.groups.back()->peak = x;
+    }
+    Group& group = *side.groups.back();
+
+    StopId stopId = nextStopId_++;
+    StopRecord& record = stops_[stopId];
+    record.symbol = symbol;
+    record.exitSide = exitSide;
+    record.trailing = true;
+    record.percent = percent;
+    record.trail = trail;
+    record.group = &group;
+    record.trailIt = (percent ? group.percentTrails : group.amountTrails).emplace(trail, stopId);
+    recomputePrefix(side, side.groups.size() - 1);
+
+    stops.count++;
+    stopCount_++;
+    return stopId;
+}
+
+bool StopEngine::cancelStop(StopId stopId) {
+    std::lock_guard<std::mutex> lock(engineMutex_);
+
+    auto it = stops_.find(stopId);
+    if (it == stops_.end()) {
+        return false;
+    }
+
+    StopRecord& record = it->second;
+    SymbolStops& stops = symbols_.at(record.symbol);
+    Side& side = stops.sides[sideIndex(record.exitSide)];
+    if (record.trailing) {
+        eraseTrailing(side, record);
+    } else {
+        side.fixed.erase(record.fixedIt);
+    }
+
+    stops_.erase(it);
+    stops.count--;
+    stopCount_--;
+    return true;
+}
+
+bool StopEngine::updateStop(StopId stopId, Price stopPrice) {
+    if (stopPrice <= 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(engineMutex_);
+
+    auto it = stops_.find(stopId);
+    if (it == stops_.end() || it->second.trailing) {
+        return false;
+    }
+
+    StopRecord& record = it->second;
+    Side& side = symbols_.at(record.symbol).sides[sideIndex(record.exitSide)];
+    side.fixed.erase(record.fixedIt);
+    record.fixedIt = side.fixed.emplace(side.sign * stopPrice, stopId);
+    return true;
+}
+
+bool StopEngine::updateTrail(StopId stopId, double trail) {
+    std::lock_guard<std::mutex> lock(engineMutex_);
+
+    auto it = stops_.find(stopId);
+    if (it == stops_.end() || !it->second.trailing || trail <= 0 || (it->second.percent && trail >= 1.0)) {
+        return false;
+    }
+
+    StopRecord& record = it->second;
+    Side& side = symbols_.at(record.symbol).sides[sideIndex(record.exitSide)];
+    TrailMap& trails = record.percent ? record.group->percentTrails : record.group->amountTrails;
+    trails.erase(record.trailIt);
+    record.trail = trail;
+    record.trailIt = trails.emplace(trail, stopId);
+    recomputePrefix(side, findGroup(side, record.group));
+    return true;
+}
+
+size_t StopEngine::onPrice(const Symbol& symbol, Price price, std::vector<Trigger>& triggered) {
+    if (price <= 0) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(engineMutex_);
+
+    auto it = symbols_.find(symbol);
+    if (it == symbols_.end()) {
+        return 0;
+    }
+
+    SymbolStops& stops = it->second;
+    stops.lastPrice = price;
+    if (stops.count == 0) {
+        return 0;
+    }
+
+    size_t before = triggered.size();
+    for (auto& side : stops.sides) {
+        if (side.fixed.empty() && side.groups.empty()) {
+            continue;
+        }
+        double x = side.sign * price;
+        ratchet(side, x);
+        collectTriggers(stops, side, symbol, x, triggered);
+    }
+    return triggered.size() - before;
+}
+
+Price StopEngine::getStopPrice(StopId stopId) const {
+    std::lock_guard<std::mutex> lock(engineMutex_);
+
+    auto it = stops_.find(stopId);
+    if (it == stops_.end()) {
+        return 0;
+    }
+
+    const StopRecord& record = it->second;
+    const Side& side = symbols_.at(record.symbol).sides[sideIndex(record.exitSide)];
+    double level = record.trailing
+        ? trailLevel(side, record.group->peak, record.trail, record.percent)
+        : record.fixedIt->first;
+    return side.sign * level;
+}
+
+bool StopEngine::hasStop(StopId stopId) const {
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    return stops_.count(stopId) > 0;
+}
+
+size_t StopEngine::getStopCount() const {
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    return stopCount_;
+}
+
+size_t StopEngine::getStopCount(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    auto it = symbols_.find(symbol);
+    return it != symbols_.end() ? it->second.count : 0;
+}
+
+void StopEngine::clear() {
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    symbols_.clear();
+    stops_.clear();
+    stopCount_ = 0;
+}
+
+// Private methods
+double StopEngine::trailLevel(const Side& side, double peak, double trail, bool percent) {
+    return percent ? peak * (1.0 - side.sign * trail) : peak - trail;
+}
+
+double StopEngine::groupBest(const Side& side, const Group& group) {
+    double best = NO_LEVEL;
+    if (!group.amountTrails.empty()) {
+        best = trailLevel(side, group.peak, group.amountTrails.begin()->first, false);
+    }
+    if (!group.percentTrails.empty()) {
+        best = std::max(best, trailLevel(side, group.peak, group.percentTrails.begin()->first, true));
+    }
+    return best;
+}
+
+void StopEngine::ratchet(Side& side, double x) {
+    // Every group whose peak the price reaches shares the new peak
+    std::unique_ptr<Group> merged;
+    while (!side.groups.empty() && side.groups.back()->peak <= x) {
+        std::unique_ptr<Group> top = std::move(side.groups.back());
+        side.groups.pop_back();
+        if (!merged) {
+            merged = std::move(top);
+        } else {
+            if (top->size() > merged->size()) {
+                std::swap(top, merged);
+            }
+            mergeGroup(*merged, *top);
+        }
+    }
+
+    if (merged) {
+        merged->peak = x;
+        side.groups.push_back(std::move(merged));
+        recomputePrefix(side, side.groups.size() - 1);
+    }
+}
+
+void StopEngine::mergeGroup(Group& into, Group& from) {
+    for (const auto& entry : from.amountTrails) {
+        StopRecord& record = stops_.at(entry.second);
+        record.group = &into;
+        record.trailIt = into.amountTrails.emplace(entry.first, entry.second);
+    }
+    for (const auto& entry : from.percentTrails) {
+        StopRecord& record = stops_.at(entry.second);
+        record.group = &into;
+        record.trailIt = into.percentTrails.emplace(entry.first, entry.second);
+    }
+}
+
+void StopEngine::recomputePrefix(Side& side, size_t from) {
+    side.prefixBest.resize(side.groups.size());
+    for (size_t i = from; i < side.groups.size(); ++i) {
+        double best = groupBest(side, *side.groups[i]);
+        side.prefixBest[i] = i > 0 ? std::max(side.prefixBest[i - 1], best) : best;
+    }
+}
+
+size_t StopEngine::findGroup(const Side& side, const Group* group) const {
+    for (size_t i = side.groups.size(); i-- > 0;) {
+        if (side.groups[i].get() == group) {
+            return i;
+        }
+    }
+    return side.groups.size();
+}
+
+void StopEngine::eraseTrailing(Side& side, StopRecord& record) {
+    Group* group = record.group;
+    (record.percent ? group->percentTrails : group->amountTrails).erase(record.trailIt);
+
+    size_t index = findGroup(side, group);
+    if (group->size() == 0 && index < side.groups.size()) {
+        side.groups.erase(side.groups.begin() + index);
+    }
+    recomputePrefix(side, index);
+}
+
+void StopEngine::collectTriggers(SymbolStops& stops, Side& side, const Symbol& symbol, double x,
+                                 std::vector<Trigger>& triggered) {
+    OrderSide exitSide = side.sign > 0 ? OrderSide::SELL : OrderSide::BUY;
+
+    auto emit = [&](StopId stopId, double level) {
+        triggered.push_back({stopId, symbol, exitSide, side.sign * level});
+        stops_.erase(stopId);
+        stops.count--;
+        stopCount_--;
+    };
+
+    while (!side.fixed.empty() && side.fixed.begin()->first >= x) {
+        auto it = side.fixed.begin();
+        emit(it->second, it->first);
+        side.fixed.erase(it);
+    }
+
+    if (side.prefixBest.empty() || side.prefixBest.back() < x) {
+        return;
+    }
+
+    // Walk down only while some group at or below still holds a crossed level
+    size_t lowest = side.groups.size();
+    for (size_t i = side.groups.size(); i-- > 0 && side.prefixBest[i] >= x;) {
+        Group& group = *side.groups[i];
+        if (groupBest(side, group) < x) {
+            continue;
+        }
+        lowest = i;
+
+        for (TrailMap* trails : {&group.amountTrails, &group.percentTrails}) {
+            bool percent = trails == &group.percentTrails;
+            while (!trails->empty()) {
+                double level = trailLevel(side, group.peak, trails->begin()->first, percent);
+                if (level < x) {
+                    break;
+                }
+                emit(trails->begin()->second, level);
+                trails->erase(trails->begin());
+            }
+        }
+
+        if (group.size() == 0) {
+            side.groups.erase(side.groups.begin() + i);
+        }
+    }
+    recomputePrefix(side, lowest);
+}
+
+} // namespace MasterMind
@@ -0,0 +1,250 @@
+#include "core/StreamingRiskEstimator.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace MasterMind {
+
+// TDigest
+TDigest::TDigest(double compression)
+    : compression_(std::max(compression, 20.0)),
+      bufferLimit_(static_cast<size_t>(compression_) * 5),
+      totalWeight_(0),
+      min_(std::numeric_limits<double>::infinity()),
+      max_(-std::numeric_limits<double>::infinity()) {
+    buffer_.reserve(bufferLimit_);
+}
+
+void TDigest::add(double value, double weight) {
+    if (!std::isfinite(value) || weight <= 0) {
+        return;
+    }
+
+    buffer_.push_back({value, weight});
+    totalWeight_ += weight;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+
+    if (buffer_.size() >= bufferLimit_) {
+        flush();
+    }
+}
+
+void TDigest::merge(const TDigest& other) {
+    other.flush();
+    for (const auto& centroid : other.centroids_) {
+        add(centroid.mean, centroid.weight);
+    }
+    if (other.totalWeight_ > 0) {
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+}
+
+void TDigest::clear() {
+    centroids_.clear();
+    buffer_.clear();
+    totalWeight_ = 0;
+    min_ = std::numeric_limits<double>::infinity();
+    max_ = -std::numeric_limits<double>::infinity();
+}
+
+double TDigest::quantile(double q) const {
+    flush();
+    if (centroids_.empty()) {
+        return 0;
+    }
+    if (centroids_.size() == 1) {
+        return centroids_.front().mean;
+    }
+
+    q = std::min(std::max(q, 0.0), 1.0);
+    double index = q * totalWeight_;
+
+    // Centroid means sit at the middle of their weight; interpolate between them
+    const Centroid& first = centroids_.front();
+    if (index < first.weight / 2) {
+        return min_ + (first.mean - min_) * index / (first.weight / 2);
+    }
+
+    double cumulative = first.weight / 2;
+    for (size_t i = 0; i + 1 < centroids_.size(); ++i) {
+        double gap = (centroids_[i].weight + centroids_[i + 1].weight) / 2;
+        if (index < cumulative + gap) {
+            double fraction = (index - cumulative) / gap;
+            return centroids_[i].mean + (centroids_[i + 1].mean - centroids_[i].mean) * fraction;
+        }
+        cumulative += gap;
+    }
+
+    const Centroid& last = centroids_.back();
+    double fraction = std::min(1.0, (index - cumulative) / (last.weight / 2));
+    return last.mean + (max_ - last.mean) * fraction;
+}
+
+double TDigest::tailMean(double q) const {
+    flush();
+    if (centroids_.empty() || q <= 0) {
+        return centroids_.empty() ? 0 : min_;
+    }
+
+    double target = std::min(q, 1.0) * totalWeight_;
+    double weight = 0;
+    double sum = 0;
+    for (const auto& centroid : centroids_) {
+        double take = std::min(centroid.weight, target - weight);
+        sum += centroid.mean * take;
+        weight += take;
+        if (weight >= target) {
+            break;
+        }
+    }
+    return sum / weight;
+}
+
+double TDigest::getCount() const {
+    return totalWeight_;
+}
+
+double TDigest::getMin() const {
+    return totalWeight_ > 0 ? min_ : 0;
+}
+
+double TDigest::getMax() const {
+    return totalWeight_ > 0 ? max_ : 0;
+}
+
+size_t TDigest::getCentroidCount() const {
+    flush();
+    return centroids_.size();
+}
+
+void TDigest::flush() const {
+    if (buffer_.empty()) {
+        return;
+    }
+
+    auto byMean = [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; };
+    std::sort(buffer_.begin(), buffer_.end(), byMean);
+
+    std::vector<Centroid>& input = scratch_;
+    input.clear();
+    std::merge(centroids_.begin(), centroids_.end(), buffer_.begin(), buffer_.end(),
+               std::back_inserter(input), byMean);
+    buffer_.clear();
+
+    // Greedy merge: a centroid may grow while it stays within 4 * n * q(1-q) / compression
+    double total = totalWeight_;
+    centroids_.clear();
+    Centroid current = input.front();
+    double weightSoFar = 0;
+    for (size_t i = 1; i < input.size(); ++i) {
+        double proposed = current.weight + input[i].weight;
+        double q0 = weightSoFar / total;
+        double q2 = (weightSoFar + proposed) / total;
+        double limit = 4.0 * total * std::min(q0 * (1 - q0), q2 * (1 - q2)) / compression_;
+
+        if (proposed <= limit) {
+            current.mean += (input[i].mean - current.mean) * input[i].weight / proposed;
+            current.weight = proposed;
+        } else {
+            weightSoFar += current.weight;
+            centroids_.push_back(current);
+            current = input[i];
+        }
+    }
+    centroids_.push_back(current);
+}
+
+// StreamingRiskEstimator
+StreamingRiskEstimator::StreamingRiskEstimator(double compression)
+    : digest_(compression), count_(0), mean_(0), m2_(0),
+      equityPeak_(0), currentDrawdown_(0), maxDrawdown_(0) {
+}
+
+void StreamingRiskEstimator::addReturn(double periodReturn) {
+    if (!std::isfinite(periodReturn)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    digest_.add(periodReturn);
+
+    count_++;
+    double delta = periodReturn - mean_;
+    mean_ += delta / count_;
+    m2_ += delta * (periodReturn - mean_);
+}
+
+void StreamingRiskEstimator::addEquity(double equity) {
+    if (equity <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    equityPeak_ = std::max(equityPeak_, equity);
+    currentDrawdown_ = (equityPeak_ - equity) / equityPeak_;
+    maxDrawdown_ = std::max(maxDrawdown_, currentDrawdown_);
+}
+
+void StreamingRiskEstimator::reset() {
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    digest_.clear();
+    count_ = 0;
+    mean_ = 0;
+    m2_ = 0;
+    equityPeak_ = 0;
+    currentDrawdown_ = 0;
+    maxDrawdown_ = 0;
+}
+
+double StreamingRiskEstimator::getValueAtRisk(double confidence) const {
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    return count_ > 0 ? -digest_.quantile(1.0 - confidence) : 0;
+}
+
+double StreamingRiskEstimator::getExpectedShortfall(double confidence) const {
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    return count_ > 0 ? -digest_.tailMean(1.0 - confidence) : 0;
+}
+
+double StreamingRiskEstimator::getMean() const {
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    return mean_;
+}
+
+double StreamingRiskEstimator::getVolatility() const {
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    return count_ > 1 ? std::sqrt(m2_ / (count_ - 1)) : 0;
+}
+
+double StreamingRiskEstimator::getSharpeRatio(double riskFreeRate, int periodsPerYear) const {
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    if (count_ < 2 || periodsPerYear <= 0) {
+        return 0;
+    }
+
+    double volatility = std::sqrt(m2_ / (count_ - 1));
+    if (volatility <= 0) {
+        return 0;
+    }
+    return (mean_ - riskFreeRate / periodsPerYear) / volatility * std::sqrt(static_cast<double>(periodsPerYear));
+}
+
+double StreamingRiskEstimator::getMaxDrawdown() const {
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    return maxDrawdown_;
+}
+
+double StreamingRiskEstimator::getCurrentDrawdown() const {
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    return currentDrawdown_;
+}
+
+uint64_t StreamingRiskEstimator::getReturnCount() const {
+    std::lock_guard<std::mutex> lock(estimatorMutex_);
+    return count_;
+}
+
+} // namespace MasterMind
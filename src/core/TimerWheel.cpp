@@ -0,0 +1,348 @@
+#include "core/TimerWheel.h"
+#include <iostream>
+#include <algorithm>
+
+namespace MasterMind {
+
+TimerWheel::TimerWheel(Duration tickInterval, TimePoint epoch)
+    : tickInterval_(tickInterval.count() > 0 ? tickInterval : Duration(1)),
+      epoch_(epoch == TimePoint() ? std::chrono::system_clock::now() : epoch), currentTick_(0),
+      pendingCount_(0), firingNext_(0), firingTimer_(INVALID_TIMER), running_(false), firedCount_(0) {
+
+    for (auto& level : slots_) {
+        level.fill(NIL);
+    }
+    nodes_.reserve(1024);
+}
+
+TimerWheel::~TimerWheel() {
+    stop();
+}
+
+bool TimerWheel::start() {
+    if (running_) {
+        return true;
+    }
+
+    running_ = true;
+    driverThread_ = std::thread(&TimerWheel::driverWorker, this);
+
+    std::cout << "TimerWheel started (" << tickInterval_.count() << "ms resolution)" << std::endl;
+    return true;
+}
+
+void TimerWheel::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    if (driverThread_.joinable()) {
+        driverThread_.join();
+    }
+
+    std::cout << "TimerWheel stopped" << std::endl;
+}
+
+bool TimerWheel::isRunning() const {
+    return running_;
+}
+
+TimerId TimerWheel::schedule(Duration delay, Callback callback) {
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+    return scheduleTicks(currentTick_ + toTicks(delay), 0, std::move(callback));
+}
+
+TimerId TimerWheel::scheduleAt(TimePoint when, Callback callback) {
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+    return scheduleTicks(toTick(when), 0, std::move(callback));
+}
+
+TimerId TimerWheel::scheduleRepeating(Duration interval, Callback callback, Duration initialDelay) {
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+
+    uint64_t intervalTicks = std::max<uint64_t>(1, toTicks(interval));
+    uint64_t firstDelay = initialDelay.count() > 0 ? toTicks(initialDelay) : intervalTicks;
+    return scheduleTicks(currentTick_ + firstDelay, intervalTicks, std::move(callback));
+}
+
+bool TimerWheel::cancel(TimerId timerId) {
+    if (timerId == INVALID_TIMER) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+
+    uint32_t index = static_cast<uint32_t>(timerId & 0xFFFFFFFFu);
+    uint32_t generation = static_cast<uint32_t>(timerId >> 32);
+    if (index >= nodes_.size()) {
+        return false;
+    }
+
+    TimerNode& node = nodes_[index];
+    bool dropped = dropFiring(timerId);
+    if (!node.active || node.generation != generation) {
+        return dropped;
+    }
+
+    unlink(index);
+    releaseNode(index);
+    return true;
+}
+
+bool TimerWheel::cancelSync(TimerId timerId) {
+    if (timerId == INVALID_TIMER) {
+        return false;
+    }
+    bool cancelled = cancel(timerId);
+
+    std::unique_lock<std::mutex> lock(wheelMutex_);
+    if (firingThread_ != std::this_thread::get_id()) {
+        firedCV_.wait(lock, [this, timerId]() { return firingTimer_ != timerId; });
+    }
+    return cancelled;
+}
+
+bool TimerWheel::isScheduled(TimerId timerId) const {
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+
+    uint32_t index = static_cast<uint32_t>(timerId & 0xFFFFFFFFu);
+    uint32_t generation = static_cast<uint32_t>(timerId >> 32);
+    return index < nodes_.size() && nodes_[index].active &&
+           nodes_[index].generation == generation;
+}
+
+size_t TimerWheel::advance(TimePoint now) {
+    std::lock_guard<std::mutex> advanceLock(advanceMutex_);
+
+    {
+        std::lock_guard<std::mutex> lock(wheelMutex_);
+        uint64_t targetTick = toTick(now);
+
+        while (currentTick_ <= targetTick) {
+            if (pendingCount_ == 0) {
+                // Nothing to fire - jump straight to the target
+                currentTick_ = targetTick + 1;
+                break;
+            }
+            processTick();
+        }
+        firingNext_ = 0;
+        firingThread_ = std::this_thread::get_id();
+    }
+
+    // Fire the batch outside the wheel lock so callbacks can reschedule
+    size_t fired = 0;
+    while (true) {
+        Callback callback;
+        {
+            std::lock_guard<std::mutex> lock(wheelMutex_);
+            if (firingNext_ >= firing_.size()) {
+                firing_.clear();
+                firingNext_ = 0;
+                firingTimer_ = INVALID_TIMER;
+                firingThread_ = std::thread::id();
+                break;
+            }
+            firingTimer_ = firing_[firingNext_].first;
+            callback = std::move(firing_[firingNext_].second);
+            firingNext_++;
+        }
+        firedCV_.notify_all();  // The previous callback has returned
+        if (callback) {
+            callback();
+            fired++;
+        }
+    }
+    firedCV_.notify_all();
+
+    firedCount_ += fired;
+    return fired;
+}
+
+size_t TimerWheel::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(wheelMutex_);
+    return pendingCount_;
+}
+
+Duration TimerWheel::getTickInterval() const {
+    return tickInterval_;
+}
+
+uint64_t TimerWheel::getFiredCount() const {
+    return firedCount_;
+}
+
+// Private methods
+TimerId TimerWheel::scheduleTicks(uint64_t expiryTick, uint64_t intervalTicks, Callback callback) {
+    uint32_t index = allocateNode();
+    TimerNode& node = nodes_[index];
+    node.callback = std::move(callback);
+    node.expiryTick = std::max(expiryTick, currentTick_);
+    node.intervalTicks = intervalTicks;
+    node.active = true;
+
+    link(index);
+    pendingCount_++;
+
+    return makeId(index, node.generation);
+}
+
+uint64_t TimerWheel::toTick(TimePoint when) const {
+    if (when <= epoch_) {
+        return 0;
+    }
+    auto elapsed = std::chrono::duration_cast<Duration>(when - epoch_);
+    return static_cast<uint64_t>(elapsed.count() / tickInterval_.count());
+}
+
+uint64_t TimerWheel::toTicks(Duration delay) const {
+    if (delay.count() <= 0) {
+        return 0;
+    }
+    // Round up so a timer never fires before its requested delay (in wheel time)
+    return static_cast<uint64_t>((delay.count() + tickInterval_.count() - 1) / tickInterval_.count());
+}
+
+uint32_t TimerWheel::allocateNode() {
+    if (!freeList_.empty()) {
+        uint32_t index = freeList_.back();
+        freeList_.pop_back();
+        return index;
+    }
+
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void TimerWheel::releaseNode(uint32_t index) {
+    TimerNode& node = nodes_[index];
+    node.callback = nullptr;
+    node.active = false;
+    node.generation++;
+    if (node.generation == 0) {
+        node.generation = 1;  // Keep ids non-zero after wrap-around
+    }
+    freeList_.push_back(index);
+    pendingCount_--;
+}
+
+void TimerWheel::link(uint32_t index) {
+    TimerNode& node = nodes_[index];
+
+    uint64_t expiry = std::max(node.expiryTick, currentTick_);
+    uint64_t delta = expiry - currentTick_;
+
+    int level = 0;
+    if (delta >= (1ull << (3 * SLOT_BITS))) {
+        level = 3;
+        // Beyond the wheel horizon: park in the last reachable slot and
+        // re-evaluate on cascade
+        if (delta >= (1ull << (4 * SLOT_BITS))) {
+            expiry = currentTick_ + (1ull << (4 * SLOT_BITS)) - 1;
+        }
+    } else if (delta >= (1ull << (2 * SLOT_BITS))) {
+        level = 2;
+    } else if (delta >= (1ull << SLOT_BITS)) {
+        level = 1;
+    }
+
+    uint32_t slot = static_cast<uint32_t>((expiry >> (level * SLOT_BITS)) & SLOT_MASK);
+
+    node.level = static_cast<uint16_t>(level);
+    node.slot = static_cast<uint16_t>(slot);
+    node.prev = NIL;
+    node.next = slots_[level][slot];
+    if (node.next != NIL) {
+        nodes_[node.next].prev = index;
+    }
+    slots_[level][slot] = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    TimerNode& node = nodes_[index];
+
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        slots_[node.level][node.slot] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.prev = NIL;
+    node.next = NIL;
+}
+
+void TimerWheel::cascade(int level, uint32_t slot) {
+    uint32_t index = slots_[level][slot];
+    slots_[level][slot] = NIL;
+
+    while (index != NIL) {
+        uint32_t next = nodes_[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+void TimerWheel::processTick() {
+    uint64_t tick = currentTick_;
+
+    // Cascade higher levels whose boundary is reached at this tick
+    for (int level = LEVELS - 1; level > 0; --level) {
+        uint64_t mask = (1ull << (level * SLOT_BITS)) - 1;
+        if ((tick & mask) == 0) {
+            cascade(level, static_cast<uint32_t>((tick >> (level * SLOT_BITS)) & SLOT_MASK));
+        }
+    }
+
+    uint32_t slot = static_cast<uint32_t>(tick & SLOT_MASK);
+    uint32_t index = slots_[0][slot];
+    slots_[0][slot] = NIL;
+
+    while (index != NIL) {
+        TimerNode& node = nodes_[index];
+        uint32_t next = node.next;
+
+        if (node.expiryTick > tick) {
+            // Not due yet (parked beyond the horizon) - re-insert
+            link(index);
+        } else if (node.intervalTicks > 0) {
+            firing_.emplace_back(makeId(index, node.generation), node.callback);
+            node.expiryTick = tick + node.intervalTicks;
+            link(index);
+        } else {
+            firing_.emplace_back(makeId(index, node.generation), std::move(node.callback));
+            releaseNode(index);
+        }
+
+        index = next;
+    }
+
+    currentTick_++;
+}
+
+bool TimerWheel::dropFiring(TimerId timerId) {
+    // Caller holds wheelMutex_
+    bool dropped = false;
+    for (size_t i = firingNext_; i < firing_.size(); ++i) {
+        if (firing_[i].first == timerId && firing_[i].second) {
+            firing_[i].second = nullptr;
+            dropped = true;
+        }
+    }
+    return dropped;
+}
+
+void TimerWheel::driverWorker() {
+    while (running_) {
+        std::this_thread::sleep_for(tickInterval_);
+        advance(std::chrono::system_clock::now());
+    }
+}
+
+TimerId TimerWheel::makeId(uint32_t index, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) | index;
+}
+
+} // namespace MasterMind
@@ -6,13 +6,23 @@
 #include "core/ConfigManager.h"
 #include "Logger.h"
 #include "core/DatabaseManager.h"
+#include "core/PersistenceQueue.h"
+#include "api/SimulatedExchangeAPI.h"
+#include "api/ConnectionSupervisor.h"
+#include "api/RateLimiter.h"
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
 
 namespace MasterMind {
 
+namespace {
+const Duration RISK_UPDATE_INTERVAL = std::chrono::seconds(1);
+}
+
 TradingEngine::TradingEngine(const std::string& configFile) 
-    : configFilePath_(configFile), running_(false), riskStatus_(RiskStatus::NORMAL),
-      paperMode_(true), currentDrawdown_(0.0) {
+    : simulatedExchange_(nullptr), configFilePath_(configFile), running_(false),
+      riskStatus_(RiskStatus::NORMAL), paperMode_(true), currentDrawdown_(0.0) {
     std::cout << "TradingEngine created with config: " << configFile << std::endl;
 }
 
@@ -20,6 +30,30 @@ TradingEngine::~TradingEngine() {
     if (running_) {
         stop();
     }
+    
+    // Order updates must stop reaching the queue before it is destroyed
+    if (orderManager_) {
+        orderManager_->setOrderCallback(nullptr);
+    }
+    if (persistenceQueue_) {
+        persistenceQueue_->stop();
+    }
+    
+    if (timerWheel_) {
+        timerWheel_->cancel(riskUpdateTimer_);
+    }
+    
+    std::lock_guard<std::mutex> lock(sessionMutex_);
+    for (auto& pair : sessions_) {
+        cancelSessionTimers(pair.second);
+    }
+    
+    // Venues outlive the supervisor; their stream callbacks must not reach it
+    if (connectionSupervisor_) {
+        for (const auto& pair : exchanges_) {
+            connectionSupervisor_->removeVenue(pair.second);
+        }
+    }
 }
 
 bool TradingEngine::initialize() {
@@ -45,11 +79,82 @@ bool TradingEngine::initialize() {
         std::cerr << "Failed to initialize database" << std::endl;
         return false;
     }
+    if (databaseManager_->connect()) {
+        // The trading path only enqueues; a writer thread group-commits
+        persistenceQueue_ = std::make_unique<PersistenceQueue>(*databaseManager_);
+        persistenceQueue_->start();
+    } else {
+        // History is not required to trade; keep running without it
+        Logger::getInstance().warning("Database unavailable: " + databaseManager_->getLastError(), "Engine");
+    }
 
+    // Shared timer wheel for pattern expiry, order timeouts, resets and sessions
+    timerWheel_ = std::make_unique<TimerWheel>();
+    
     // Initialize other components (stub implementations)
     riskManager_ = std::make_unique<RiskManager>();
     orderManager_ = std::make_unique<OrderManager>();
     patternDetector_ = std::make_unique<PatternDetector>();
+    
+    // Limits from configuration; the account side follows from the venues' caches
+    riskManager_->initialize(configManager_->getGlobalRiskParameters());
+    for (const auto& symbolConfig : configManager_->getAllSymbolConfigs()) {
+        if (symbolConfig.isEnabled) {
+            riskManager_->setSymbolLimits(symbolConfig.symbol, 0, symbolConfig.capitalAllocation);
+        }
+    }
+    
+    // Counter, streak and daily state survive restarts beside the database
+    std::filesystem::path ledgerDirectory = std::filesystem::path(dbConfig.connectionString).parent_path() / "ledger";
+    if (!riskManager_->openLedger(ledgerDirectory.string())) {
+        std::cerr << "Failed to open counter ledger in " << ledgerDirectory.string() << std::endl;
+        Logger::getInstance().error("Failed to open counter ledger in " + ledgerDirectory.string(), "Engine");
+        return false;
+    }
+    
+    riskManager_->setTimerWheel(timerWheel_.get());
+    orderManager_->setTimerWheel(timerWheel_.get());
+    patternDetector_->setTimerWheel(timerWheel_.get());
+    patternDetector_->setPatternTimeout(configManager_->getPatternConfig().patternTimeout);
+    orderManager_->setOrderTimeout(configManager_->getSystemConfig().orderTimeout);
+    
+    // Every submission passes the lock-free pre-trade limits snapshot
+    orderManager_->setRiskValidationCallback([this](const Order& order) {
+        return riskManager_->validateOrder(order);
+    });
+    orderManager_->setTradeCallback([this](const Order& order, Volume quantity, Price price) {
+        riskManager_->onFill(order, quantity, price);
+    });
+    orderManager_->setOrderCallback([this](const Order& order) {
+        if (persistenceQueue_) {
+            persistenceQueue_->insertOrder(order);
+        }
+        if (orderCallback_) {
+            orderCallback_(order);
+        }
+    });
+
+    // Venue sessions and streams come back on their own, off the trading threads
+    auto systemConfig = configManager_->getSystemConfig();
+    SupervisorConfig supervisorConfig;
+    supervisorConfig.heartbeatInterval = systemConfig.heartbeatInterval;
+    supervisorConfig.maxBackoff = systemConfig.reconnectInterval;
+    // The attempt limit becomes a time budget: that many waits at the longest backoff
+    supervisorConfig.giveUpAfter = systemConfig.reconnectInterval * std::max(systemConfig.maxReconnectAttempts, 0);
+    supervisorConfig.hotStandby = systemConfig.hotStandbyStreams;
+    connectionSupervisor_ = std::make_unique<ConnectionSupervisor>(supervisorConfig);
+
+    // Paper mode executes against the in-process matching engine, fed by onTick
+    if (paperMode_) {
+        auto simulated = std::make_unique<SimulatedExchangeAPI>();
+        simulated->connect();
+        simulatedExchange_ = simulated.get();
+        orderManager_->addExchange(Exchange::SIMULATED, std::move(simulated));
+    }
+
+    riskUpdateTimer_ = timerWheel_->scheduleRepeating(RISK_UPDATE_INTERVAL, [this]() {
+        updateRiskStatus();
+    });
 
     std::cout << "TradingEngine initialized successfully" << std::endl;
     return true;
@@ -61,6 +166,15 @@ bool TradingEngine::start() {
     }
 
     try {
+        if (timerWheel_) {
+            timerWheel_->start();
+        }
+        if (orderManager_) {
+            orderManager_->start();  // Drains queued orders, triggered stop exits among them
+        }
+        if (connectionSupervisor_) {
+            connectionSupervisor_->start();
+        }
         running_ = true;
         std::cout << "TradingEngine started" << std::endl;
         return true;
@@ -77,6 +191,15 @@ void TradingEngine::stop() {
     }
 
     running_ = false;
+    if (connectionSupervisor_) {
+        connectionSupervisor_->stop();
+    }
+    if (orderManager_) {
+        orderManager_->stop();
+    }
+    if (timerWheel_) {
+        timerWheel_->stop();
+    }
     std::cout << "TradingEngine stopped" << std::endl;
 }
 
@@ -116,7 +239,24 @@ void TradingEngine::exportTradingReport(const std::string& filename) const {
 }
 
 void TradingEngine::onTick(const Tick& tick) {
-    // TODO: Process incoming tick data
+    if (simulatedExchange_) {
+        simulatedExchange_->onMarketTick(tick);
+    }
+    if (orderManager_) {
+        orderManager_->onTick(tick);  // Local stop triggers
+    }
+    if (riskManager_) {
+        riskManager_->onMarketPrice(tick.symbol, tick.last > 0 ? tick.last : (tick.bid + tick.ask) / 2.0);
+    }
+    if (tickCallback_) {
+        tickCallback_(tick);
+    }
+}
+
+void TradingEngine::onOHLC(const Symbol& symbol, const OHLC& ohlc) {
+    if (riskManager_) {
+        riskManager_->onBar(symbol, ohlc);  // Bar returns feed the correlation estimate
+    }
 }
 
 bool TradingEngine::loadConfiguration(const std::string& configFile) {
@@ -129,7 +269,6 @@ bool TradingEngine::reloadConfiguration() { return true; }
 void TradingEngine::addSymbol(const SymbolConfig& config) { }
 void TradingEngine::removeSymbol(const Symbol& symbol) { }
 void TradingEngine::updateSymbolConfig(const SymbolConfig& config) { }
-void TradingEngine::onOHLC(const OHLC& ohlc) { }
 void TradingEngine::processMarketData() { }
 void TradingEngine::onTradingSignal(const TradingSignal& signal) { }
 bool TradingEngine::placeOrder(const Order& order) { return false; }
@@ -147,16 +286,65 @@ Position TradingEngine::getPosition(const Symbol& symbol) const {
     return Position();
 }
 
-double TradingEngine::getUnrealizedPnL() const { return 0.0; }
-double TradingEngine::getRealizedPnL() const { return 0.0; }
+double TradingEngine::getUnrealizedPnL() const {
+    return riskManager_ ? riskManager_->getPortfolioExposure().unrealizedPnL : 0.0;
+}
+
+double TradingEngine::getRealizedPnL() const {
+    return riskManager_ ? riskManager_->getPortfolioExposure().realizedPnL : 0.0;
+}
 
 AccountInfo TradingEngine::getAccountInfo() const {
     return AccountInfo();
 }
 
-bool TradingEngine::addExchange(std::unique_ptr<ExchangeAPI> exchange) { return false; }
-ExchangeAPI* TradingEngine::getExchange(Exchange exchangeType) const { return nullptr; }
-std::vector<Exchange> TradingEngine::getActiveExchanges() const { return std::vector<Exchange>(); }
+bool TradingEngine::addExchange(std::unique_ptr<ExchangeAPI> exchange) {
+    if (!exchange || !orderManager_) {
+        return false;  // Venues join after initialize()
+    }
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    Exchange type = exchange->getExchangeType();
+    if (exchanges_.count(type) || orderManager_->getExchange(type)) {
+        return false;
+    }
+    
+    // The configured request budget replaces the venue's built-in one; its order rule stays
+    auto* rest = dynamic_cast<RestExchangeAPI*>(exchange.get());
+    ConfigManager::ExchangeConfig venueConfig = configManager_->getExchangeConfig(type);
+    if (rest && venueConfig.rateLimitRequests > 0 && venueConfig.rateLimitWindow > 0) {
+        RateLimitConfig limits = rest->getRateLimit();
+        limits.weightLimit = venueConfig.rateLimitRequests;
+        limits.weightWindow = std::chrono::duration_cast<Duration>(std::chrono::seconds(venueConfig.rateLimitWindow));
+        rest->setRateLimit(limits);
+    }
+    
+    // Live ticks drive stops, risk marks and the paper venue; reports go to the order manager
+    exchange->setTickCallback([this](const Tick& tick) { onTick(tick); });
+    ExchangeAPI* venue = exchange.get();
+    orderManager_->addExchange(type, std::move(exchange));
+    exchanges_[type] = venue;
+    if (connectionSupervisor_) {
+        connectionSupervisor_->addVenue(venue);
+    }
+    return true;
+}
+
+ExchangeAPI* TradingEngine::getExchange(Exchange exchangeType) const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    auto it = exchanges_.find(exchangeType);
+    return it != exchanges_.end() ? it->second : nullptr;
+}
+
+std::vector<Exchange> TradingEngine::getActiveExchanges() const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    std::vector<Exchange> active;
+    for (const auto& pair : exchanges_) {
+        if (pair.second->isConnected()) {
+            active.push_back(pair.first);
+        }
+    }
+    return active;
+}
 
 void TradingEngine::setTickCallback(TickCallback callback) { tickCallback_ = callback; }
 void TradingEngine::setOrderCallback(OrderCallback callback) { orderCallback_ = callback; }
@@ -166,7 +354,118 @@ std::vector<std::string> TradingEngine::getLogEntries(int count) const {
     return std::vector<std::string>();
 }
 
-bool TradingEngine::isWithinTradingSession(const Symbol& symbol) const { return true; }
-void TradingEngine::setTradingSession(const Symbol& symbol, TimePoint start, TimePoint end) { }
+bool TradingEngine::isWithinTradingSession(const Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(sessionMutex_);
+    
+    auto it = sessions_.find(symbol);
+    if (it == sessions_.end()) {
+        return true; // No session restriction configured
+    }
+    return it->second.isOpen;
+}
+
+void TradingEngine::setTradingSession(const Symbol& symbol, TimePoint start, TimePoint end) {
+    std::lock_guard<std::mutex> lock(sessionMutex_);
+    
+    SessionState& session = sessions_[symbol];
+    cancelSessionTimers(session);
+    session.start = start;
+    session.end = end;
+    
+    // Sessions repeat daily: only the time of day of start/end matters
+    const auto day = std::chrono::hours(24);
+    auto now = std::chrono::system_clock::now();
+    auto nowOfDay = now.time_since_epoch() % day;
+    auto startOfDay = start.time_since_epoch() % day;
+    auto endOfDay = end.time_since_epoch() % day;
+    
+    if (startOfDay <= endOfDay) {
+        session.isOpen = nowOfDay >= startOfDay && nowOfDay < endOfDay;
+    } else {
+        // Window wraps past midnight (e.g. Tokyo session in UTC)
+        session.isOpen = nowOfDay >= startOfDay || nowOfDay < endOfDay;
+    }
+    
+    if (!timerWheel_) {
+        return;
+    }
+    
+    auto untilNext = [&](std::chrono::system_clock::duration target) {
+        auto delta = (target - nowOfDay + day) % day;
+        return std::chrono::duration_cast<Duration>(delta);
+    };
+    
+    session.openTimer = timerWheel_->scheduleRepeating(day, [this, symbol]() {
+        onSessionEvent(symbol, true);
+    }, untilNext(startOfDay));
+    session.closeTimer = timerWheel_->scheduleRepeating(day, [this, symbol]() {
+        onSessionEvent(symbol, false);
+    }, untilNext(endOfDay));
+}
+
+TimerWheel* TradingEngine::getTimerWheel() const {
+    return timerWheel_.get();
+}
+
+void TradingEngine::onSessionEvent(const Symbol& symbol, bool open) {
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex_);
+        auto it = sessions_.find(symbol);
+        if (it == sessions_.end()) {
+            return;
+        }
+        it->second.isOpen = open;
+    }
+    
+    Logger::getInstance().info("Trading session " + std::string(open ? "opened" : "closed") +
+                               " for " + symbol, "Engine");
+}
+
+void TradingEngine::updateRiskStatus() {
+    // Every venue's pushed account and positions, summed into one risk budget
+    AccountInfo account;
+    std::vector<Position> positions;
+    auto addVenue = [&account, &positions](const ExchangeAPI& venue) {
+        const AccountCache& cache = venue.getAccountCache();
+        if (!cache.isInitialized()) {
+            return;
+        }
+        AccountInfo venueAccount = cache.getAccountInfo();
+        account.balance += venueAccount.balance;
+        account.equity += venueAccount.equity;
+        account.margin += venueAccount.margin;
+        account.freeMargin += venueAccount.freeMargin;
+        account.unrealizedPnL += venueAccount.unrealizedPnL;
+        account.realizedPnL += venueAccount.realizedPnL;
+        std::vector<Position> venuePositions = cache.getPositions();
+        positions.insert(positions.end(), venuePositions.begin(), venuePositions.end());
+    };
+    
+    if (simulatedExchange_) {
+        addVenue(*simulatedExchange_);
+    }
+    {
+        std::lock_guard<std::mutex> lock(dataMutex_);
+        for (const auto& pair : exchanges_) {
+            addVenue(*pair.second);
+        }
+    }
+    if (account.equity <= 0) {
+        return;  // No venue has reported an account yet
+    }
+    
+    riskManager_->updateRiskStatus(account, positions);
+    riskStatus_ = riskManager_->getCurrentRiskStatus();
+    currentDrawdown_ = riskManager_->getCurrentDrawdown();
+}
+
+void TradingEngine::cancelSessionTimers(SessionState& session) {
+    if (timerWheel_) {
+        timerWheel_->cancel(session.openTimer);
+        timerWheel_->cancel(session.closeTimer);
+    }
+    session.openTimer = TimerWheel::INVALID_TIMER;
+    session.closeTimer = TimerWheel::INVALID_TIMER;
+}
 
 } // namespace MasterMind 
\ No newline at end of file
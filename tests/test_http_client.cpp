@@ -0,0 +1,170 @@
+#include "api/HttpClient.h"
+#include "api/HttpStubServer.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MasterMind;
+
+/**
+ * @brief Drives HttpClient against HttpStubServer over loopback
+ *
+ * Covers keep-alive reuse (including a server that closes), pipelining of
+ * idempotent requests with responses matched in order, non-idempotent
+ * requests kept off busy connections, and request timeouts.
+ */
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "  FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool waitFor(const std::function<bool()>& done, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+// Echoes the method and target; /held and /slow answer late, /close drops the connection after answering
+HttpStubResponse echo(const HttpStubRequest& request) {
+    HttpStubResponse response(200, request.method + " " + request.target);
+    if (request.target.rfind("/slow", 0) == 0) {
+        response.delay = std::chrono::milliseconds(300);
+    } else if (request.target.rfind("/held", 0) == 0) {
+        response.delay = std::chrono::milliseconds(30);
+    } else if (request.target == "/close") {
+        response.close = true;
+    }
+    return response;
+}
+
+void testConnectionReuse() {
+    std::cout << "\n--- Connection reuse ---" << std::endl;
+    HttpStubServer server;
+    server.setHandler(echo);
+    check(server.start(), "stub server started");
+
+    HttpClientConfig config;
+    config.maxConnections = 1;
+    HttpClient client(server.getUrl(), config);
+    for (int i = 0; i < 5; ++i) {
+        std::string path = "/seq/" + std::to_string(i);
+        HttpResponse response = client.request("GET", path).get();
+        check(response.ok() && response.body == "GET " + path, "response to " + path + ": " + response.body);
+    }
+
+    HttpClientStats stats = client.getStats();
+    std::cout << "5 requests: " << stats.connectionsOpened << " connections, " << stats.reusedConnections
+              << " reused" << std::endl;
+    check(stats.connectionsOpened == 1 && server.getConnectionCount() == 1, "one connection for 5 requests");
+    check(stats.reusedConnections == 4, "4 requests on a reused connection");
+
+    // A server close costs a new connection, not a failed request
+    check(client.request("GET", "/close").get().ok(), "response before the server closes");
+    HttpResponse after = client.request("GET", "/after").get();
+    check(after.ok() && after.body == "GET /after", "request after the server closed: " + after.error);
+    check(client.getStats().connectionsOpened == 2, "reconnected once after the close");
+    check(client.getStats().failures == 0, "no failures");
+}
+
+void testPipelining() {
+    std::cout << "\n--- Pipelining ---" << std::endl;
+    HttpStubServer server;
+    server.setHandler(echo);
+    check(server.start(), "stub server started");
+
+    HttpClientConfig config;
+    config.maxConnections = 1;
+    config.maxPipelineDepth = 4;
+    HttpClient client(server.getUrl(), config);
+
+    const int count = 8;
+    std::mutex mutex;
+    std::vector<std::string> bodies(count);
+    std::atomic<int> done{0};
+    for (int i = 0; i < count; ++i) {
+        client.request("GET", "/held/" + std::to_string(i), "", "", [&, i](const HttpResponse& response) {
+            std::lock_guard<std::mutex> lock(mutex);
+            bodies[i] = response.ok() ? response.body : "error " + response.error;
+            done++;
+        });
+    }
+    check(waitFor([&]() { return done == count; }, std::chrono::milliseconds(5000)), "all pipelined responses");
+    for (int i = 0; i < count; ++i) {
+        std::string want = "GET /held/" + std::to_string(i);
+        check(bodies[i] == want, "pipelined response " + std::to_string(i) + " matched: " + bodies[i]);
+    }
+
+    HttpClientStats stats = client.getStats();
+    std::cout << count << " requests: " << stats.pipelinedRequests << " pipelined, server saw up to "
+              << server.getMaxPipelined() << " at once" << std::endl;
+    check(stats.pipelinedRequests > 0, "requests pipelined");
+    check(server.getMaxPipelined() > 1 && server.getMaxPipelined() <= config.maxPipelineDepth,
+          "pipeline depth within maxPipelineDepth");
+    check(stats.connectionsOpened == 1, "pipelined on one connection");
+
+    // A POST waits for an idle connection rather than queue behind held responses
+    size_t before = server.getRequestCount();
+    std::atomic<int> gets{0};
+    for (int i = 0; i < 3; ++i) {
+        client.request("GET", "/held/" + std::to_string(i), "", "", [&](const HttpResponse&) { gets++; });
+    }
+    HttpResponse posted = client.request("POST", "/order", "", "side=BUY").get();
+    check(posted.ok() && posted.body == "POST /order", "POST answered: " + posted.body);
+    check(gets == 3, "GETs ahead of the POST answered first");
+    auto requests = server.getRequests();
+    check(requests.size() == before + 4 && requests.back().method == "POST" && requests.back().body == "side=BUY",
+          "POST sent last, body intact");
+}
+
+void testTimeout() {
+    std::cout << "\n--- Request timeout ---" << std::endl;
+    HttpStubServer server;
+    server.setHandler(echo);
+    check(server.start(), "stub server started");
+
+    HttpClientConfig config;
+    config.requestTimeout = std::chrono::milliseconds(100);
+    HttpClient client(server.getUrl(), config);
+
+    auto start = std::chrono::steady_clock::now();
+    HttpResponse slow = client.request("GET", "/slow").get();
+    double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "/slow: status " << slow.status << " \"" << slow.error << "\" after " << millis << "ms"
+              << std::endl;
+    check(slow.status == 0 && !slow.error.empty(), "slow request failed with an error");
+    check(millis >= 90 && millis < 290, "failed at the request timeout, not the response");
+    check(client.getStats().timeouts == 1, "one timeout counted");
+
+    // The client stays usable afterwards
+    HttpResponse next = client.request("GET", "/next").get();
+    check(next.ok() && next.body == "GET /next", "request after a timeout: " + next.error);
+}
+}
+
+int main() {
+    std::cout << "\n=== HTTP CLIENT TEST ===" << std::endl;
+
+    testConnectionReuse();
+    testPipelining();
+    testTimeout();
+
+    std::cout << "\n" << (failures == 0 ? "All HTTP client tests passed" : std::to_string(failures) + " checks failed")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
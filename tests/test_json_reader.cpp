@@ -0,0 +1,195 @@
+#include "api/JsonParser.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace MasterMind;
+
+/**
+ * @brief Checks JsonReader number decoding and string escapes
+ *
+ * Decimals must match strtod bit for bit, whether they take the exact
+ * fast path (eight-digit fraction blocks, exact powers of ten) or fall back
+ * to strtod. This is checked on hand-picked edge cases and on random
+ * exchange-style prices. Integers, fixed point, quoted numbers and
+ * malformed numbers are covered next, then every JSON escape including
+ * surrogate pairs, and the reader latching its first error.
+ */
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "  FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// Reads text as a bare number, then quoted, and compares both with strtod
+void checkDouble(const std::string& text) {
+    double expected = std::strtod(text.c_str(), nullptr);
+
+    double bare = 0;
+    JsonReader reader(text);
+    check(reader.readDouble(bare) && reader.atEnd(), text + " decoded");
+    check(sameBits(bare, expected), text + " = " + std::to_string(bare) + ", strtod gives " + std::to_string(expected));
+
+    double quoted = 0;
+    std::string json = "\"" + text + "\"";
+    JsonReader quotedReader(json);
+    check(quotedReader.readDouble(quoted) && quotedReader.atEnd() && sameBits(quoted, expected), json + " decoded");
+
+    double direct = 0;
+    check(JsonReader::parseDouble(text, direct) && sameBits(direct, expected), text + " through parseDouble");
+}
+
+void testDoubles() {
+    std::cout << "\n--- Decimals ---" << std::endl;
+    const std::vector<std::string> cases = {
+        "0", "-0", "1", "-1", "67250.01", "0.00000001", "0.12345678", "3520.47000000", "99999999.99999999",
+        "1.7976931348623157e308", "2.2250738585072014e-308", "4.9e-324", "1e22", "1e23", "1e-22", "1e-23",
+        "-3.5E+2", "6.02214076e23", "0.1", "0.2", "0.30000000000000004", "9007199254740993",
+        "123456789012345678901234567890", "0.1234567890123456789", "12345678901234567.5", "1e400", "1e-400",
+        "0.000000000000000000000000000001", "47000000001", "1.0000000000000002", "0.9999999999999999"
+    };
+    for (const auto& text : cases) {
+        checkDouble(text);
+    }
+
+    // Exchange-style prices and sizes: up to 8 integer and 10 fraction digits
+    std::mt19937_64 random(20241017);
+    std::uniform_int_distribution<int> digitCount(1, 8);
+    std::uniform_int_distribution<int> fractionCount(0, 10);
+    std::uniform_int_distribution<int> digit(0, 9);
+    int mismatches = failures;
+    for (int i = 0; i < 20000; ++i) {
+        std::string text;
+        int integerDigits = digitCount(random);
+        for (int d = 0; d < integerDigits; ++d) {
+            text.push_back(static_cast<char>('0' + (d == 0 && integerDigits > 1 ? 1 + digit(random) % 9 : digit(random))));
+        }
+        int fractionDigits = fractionCount(random);
+        if (fractionDigits > 0) {
+            text.push_back('.');
+            for (int d = 0; d < fractionDigits; ++d) {
+                text.push_back(static_cast<char>('0' + digit(random)));
+            }
+        }
+        checkDouble(text);
+        if (failures - mismatches > 10) {
+            break;  // Enough to diagnose
+        }
+    }
+
+    // Malformed numbers fail, and the failure latches
+    for (const std::string text : {"1.", "-", ".5", "1e", "1e+", "--1", "\"12\"x", "\"12"}) {
+        double value;
+        JsonReader reader(text);
+        bool read = reader.readDouble(value);
+        check(!read || !reader.atEnd(), "'" + text + "' rejected");
+    }
+    double value;
+    JsonReader latched("[x, 1]");
+    check(latched.enterArray() && latched.nextElement() && !latched.readDouble(value), "bad element fails");
+    check(!latched.nextElement() && !latched.readDouble(value) && !latched.ok(), "error latched");
+}
+
+void testIntegers() {
+    std::cout << "\n--- Integers and fixed point ---" << std::endl;
+    int64_t value = 0;
+    uint64_t unsignedValue = 0;
+
+    JsonReader maximum("9223372036854775807");
+    check(maximum.readInteger(value) && value == std::numeric_limits<int64_t>::max(), "int64 max");
+    JsonReader minimum("-9223372036854775808");
+    check(minimum.readInteger(value) && value == std::numeric_limits<int64_t>::min(), "int64 min");
+    JsonReader over("9223372036854775808");
+    check(!over.readInteger(value) && !over.ok(), "int64 overflow rejected");
+    JsonReader quoted("\"47000000032\"");
+    check(quoted.readInteger(value) && value == 47000000032LL, "quoted integer");
+
+    JsonReader largest("18446744073709551615");
+    check(largest.readUnsigned(unsignedValue) && unsignedValue == std::numeric_limits<uint64_t>::max(), "uint64 max");
+    JsonReader wrap("18446744073709551616");
+    check(!wrap.readUnsigned(unsignedValue), "uint64 overflow rejected");
+    JsonReader negative("-1");
+    check(!negative.readUnsigned(unsignedValue), "negative unsigned rejected");
+
+    JsonReader fixed("[\"67250.123456789\", -0.5, 12, \"1e5\"]");
+    check(fixed.enterArray() && fixed.nextElement() && fixed.readFixed(value, 8) && value == 6725012345678LL,
+          "fraction truncated at the scale: " + std::to_string(value));
+    check(fixed.nextElement() && fixed.readFixed(value, 2) && value == -50, "negative fraction padded");
+    check(fixed.nextElement() && fixed.readFixed(value, 3) && value == 12000, "integer scaled");
+    check(fixed.nextElement() && !fixed.readFixed(value, 2), "exponent refused in fixed point");
+}
+
+void testStrings() {
+    std::cout << "\n--- Strings and escapes ---" << std::endl;
+    std::string json = "[\"plain\", \"q\\\"b\\\\s\\/n\\nt\\tr\\rb\\bf\\f\", \"\\u00e9\\u20AC\", \"\\ud83d\\ude00!\","
+                       " \"\\u0041\\u0000z\"]";
+    JsonReader reader(json);
+    std::string value;
+    std::string_view raw;
+
+    check(reader.enterArray() && reader.nextElement() && reader.readString(value) && value == "plain", "plain string");
+    check(reader.nextElement() && reader.readString(value) && value == "q\"b\\s/n\nt\tr\rb\bf\f",
+          "two-character escapes");
+    check(reader.nextElement() && reader.readString(value) && value == "\xC3\xA9\xE2\x82\xAC", "BMP escapes to UTF-8");
+    check(reader.nextElement() && reader.readString(value) && value == "\xF0\x9F\x98\x80!", "surrogate pair");
+    check(reader.nextElement() && reader.readString(value) && value == std::string("A\0z", 3), "escaped NUL kept");
+    check(!reader.nextElement() && reader.ok() && reader.atEnd(), "array closed");
+
+    // The view form leaves escapes in place and still finds the closing quote
+    JsonReader viewReader("{\"k\\\"ey\": \"a\\\"b\", \"next\": 1}");
+    std::string_view key;
+    check(viewReader.enterObject() && viewReader.nextKey(key) && key == "k\\\"ey", "escaped quote in a key");
+    check(viewReader.readString(raw) && raw == "a\\\"b", "raw view keeps escapes");
+    check(viewReader.nextKey(key) && key == "next", "next key after an escaped quote");
+
+    for (const std::string bad : {"\"\\ud83d\"", "\"\\ud83d\\u0041\"", "\"\\u12G4\"", "\"\\x\"", "\"\\u12\""}) {
+        JsonReader badReader(bad);
+        check(!badReader.readString(value) && !badReader.ok(), bad + " rejected");
+    }
+
+    // Brackets and quotes inside strings do not confuse skipValue
+    JsonReader skipper("{\"skip\": {\"a\": \"]}\\\"[\", \"b\": [1, {\"c\": null}]}, \"want\": true}");
+    bool flag = false;
+    check(skipper.enterObject() && skipper.nextKey(key) && skipper.skipValue(), "nested value skipped");
+    check(skipper.nextKey(key) && key == "want" && skipper.readBool(flag) && flag, "field after the skipped one");
+}
+
+void testDepthLevels() {
+    std::cout << "\n--- Depth levels ---" << std::endl;
+    JsonReader reader("[[\"67250.07\",\"0.18303966\"],[3520.41, 1.5, \"extra\", [0]]]");
+    double price = 0;
+    double quantity = 0;
+    check(reader.enterArray() && reader.nextElement() && reader.readPair(price, quantity) &&
+          sameBits(price, 67250.07) && sameBits(quantity, 0.18303966), "quoted level");
+    check(reader.nextElement() && reader.readPair(price, quantity) && sameBits(price, 3520.41) &&
+          sameBits(quantity, 1.5), "bare level with trailing fields");
+    check(!reader.nextElement() && reader.ok(), "levels closed");
+}
+}
+
+int main() {
+    std::cout << "\n=== JSON READER TEST ===" << std::endl;
+
+    testDoubles();
+    testIntegers();
+    testStrings();
+    testDepthLevels();
+
+    std::cout << "\n" << (failures == 0 ? "All JSON reader tests passed" : std::to_string(failures) + " checks failed")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
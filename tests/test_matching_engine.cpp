@@ -0,0 +1,287 @@
+#include "api/SimulatedExchangeAPI.h"
+#include "api/SimulatedOrderBook.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace MasterMind;
+
+/**
+ * @brief Checks the simulated matching engine
+ *
+ * SimulatedOrderBook on its own: price-time priority across and within
+ * levels, partial fills, cancel and size-down, iceberg refills going to the
+ * back of the queue. SimulatedExchangeAPI on top: simulated orders trading
+ * with each other at the maker's price, market and limit orders taking the
+ * replayed tick with slippage, resting orders filled by a crossing tick,
+ * stops triggered on the last price, and latency held in tick time.
+ */
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "  FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool near(double actual, double expected) {
+    return std::fabs(actual - expected) < 1e-9;
+}
+
+TimePoint at(int seconds) {
+    return TimePoint(std::chrono::seconds(1700000000 + seconds));
+}
+
+Tick tick(Price bid, Price ask, Price last, int seconds) {
+    return Tick("BTCUSDT", bid, ask, last, 1.0, at(seconds));
+}
+
+Order order(OrderType type, OrderSide side, Volume quantity, Price price = 0, Price trigger = 0) {
+    Order result;
+    result.symbol = "BTCUSDT";
+    result.type = type;
+    result.side = side;
+    result.quantity = quantity;
+    result.price = price;
+    result.triggerPrice = trigger;
+    return result;
+}
+
+// Fills and order updates in the order the callbacks saw them
+struct Events {
+    std::mutex mutex;
+    std::vector<std::string> log;
+    std::vector<Price> fillPrices;
+};
+
+void record(SimulatedExchangeAPI& exchange, Events& events) {
+    exchange.setFillCallback([&events](const OrderId& id, Volume quantity, Price price) {
+        std::lock_guard<std::mutex> lock(events.mutex);
+        events.log.push_back("fill " + id + " " + std::to_string(quantity));
+        events.fillPrices.push_back(price);
+    });
+    exchange.setOrderCallback([&events](const Order& update) {
+        std::lock_guard<std::mutex> lock(events.mutex);
+        events.log.push_back("order " + update.orderId + " " + std::to_string(static_cast<int>(update.status)));
+    });
+}
+
+void testPriority() {
+    std::cout << "\n--- Price-time priority ---" << std::endl;
+    SimulatedOrderBook book(0.5);
+    std::vector<SimulatedOrderBook::Fill> fills;
+
+    auto first = book.add(1, OrderSide::SELL, 200, 1.0);
+    auto second = book.add(2, OrderSide::SELL, 200, 2.0);
+    book.add(3, OrderSide::SELL, 199, 1.0);
+    book.add(4, OrderSide::SELL, 201, 5.0);
+    check(book.getBestAskTicks() == 199 && near(book.getBestAsk(), 99.5), "best ask 199 ticks = 99.5");
+    check(book.getLevelCount(OrderSide::SELL) == 3, "three ask levels");
+
+    // Better price first, then arrival order within the level
+    Volume matched = book.match(OrderSide::BUY, 200, 3.0, fills);
+    check(near(matched, 3.0), "matched 3 up to the limit");
+    check(fills.size() == 3 && fills[0].makerTag == 3 && fills[1].makerTag == 1 && fills[2].makerTag == 2,
+          "fills in price then time order");
+    check(fills.size() == 3 && near(fills[2].quantity, 1.0) && !fills[2].makerComplete, "second order partly filled");
+    check(!book.contains(first) && book.contains(second) && near(book.getRemaining(second), 1.0),
+          "first order gone, second left with 1");
+    check(book.getBestAskTicks() == 200, "level 199 removed");
+
+    // A limit below every ask matches nothing
+    fills.clear();
+    check(book.match(OrderSide::BUY, 150, 1.0, fills) == 0 && fills.empty(), "no match below the best ask");
+
+    // Market orders sweep every level
+    fills.clear();
+    matched = book.match(OrderSide::BUY, SimulatedOrderBook::MARKET_BUY_LIMIT, 100.0, fills);
+    check(near(matched, 6.0) && !book.hasAsks(), "market buy sweeps the book");
+}
+
+void testCancelAndReduce() {
+    std::cout << "\n--- Cancel and size-down ---" << std::endl;
+    SimulatedOrderBook book(0.01);
+    std::vector<SimulatedOrderBook::Fill> fills;
+
+    auto a = book.add(1, OrderSide::BUY, 10000, 2.0);
+    auto b = book.add(2, OrderSide::BUY, 10000, 2.0);
+    check(book.reduce(a, 1.0) && near(book.getLevel(OrderSide::BUY, 0).visibleQuantity, 3.0),
+          "size-down reduces the level");
+    check(!book.reduce(a, 5.0), "size-up refused");
+
+    // a kept its place ahead of b
+    book.match(OrderSide::SELL, 10000, 1.5, fills);
+    check(fills.size() == 2 && fills[0].makerTag == 1 && fills[0].makerComplete && fills[1].makerTag == 2,
+          "reduced order still first in the queue");
+
+    check(book.cancel(b) && !book.contains(b) && !book.hasBids(), "cancel empties the book");
+    check(!book.cancel(b), "second cancel of the same handle refused");
+
+    // A recycled node does not answer to the old handle
+    auto c = book.add(3, OrderSide::BUY, 10000, 1.0);
+    check(book.contains(c) && !book.contains(a) && book.getTag(c) == 3, "stale handle rejected");
+}
+
+void testIceberg() {
+    std::cout << "\n--- Iceberg refill ---" << std::endl;
+    SimulatedOrderBook book(1.0);
+    std::vector<SimulatedOrderBook::Fill> fills;
+
+    auto iceberg = book.add(1, OrderSide::SELL, 100, 10.0, 2.0);
+    book.add(2, OrderSide::SELL, 100, 3.0);
+    check(near(book.getLevel(OrderSide::SELL, 0).visibleQuantity, 5.0), "only the slice is visible");
+
+    // The refilled slice queues behind the plain order
+    book.match(OrderSide::BUY, 100, 4.0, fills);
+    check(fills.size() == 2 && fills[0].makerTag == 1 && near(fills[0].quantity, 2.0) && fills[1].makerTag == 2 &&
+          near(fills[1].quantity, 2.0), "slice, then the order behind it");
+    check(near(book.getRemaining(iceberg), 8.0), "iceberg has 8 left");
+    check(near(book.getLevel(OrderSide::SELL, 0).visibleQuantity, 3.0), "new slice plus the plain remainder");
+}
+
+void testCrossingOrders() {
+    std::cout << "\n--- Simulated orders crossing ---" << std::endl;
+    SimulatedExchangeAPI exchange;
+    exchange.connect();
+    Events events;
+    record(exchange, events);
+
+    OrderId maker = exchange.placeOrder(order(OrderType::LIMIT, OrderSide::SELL, 1.0, 100.00));
+    check(!maker.empty() && exchange.getOrder(maker).status == OrderStatus::SUBMITTED, "resting sell");
+
+    events.log.clear();
+    OrderId taker = exchange.placeOrder(order(OrderType::LIMIT, OrderSide::BUY, 1.5, 100.50));
+    Order takerState = exchange.getOrder(taker);
+    check(near(takerState.filledQuantity, 1.0) && takerState.status != OrderStatus::FILLED,
+          "taker filled 1 of 1.5 and rests");
+    check(exchange.getOrder(maker).status == OrderStatus::FILLED, "maker filled");
+    check(events.fillPrices.size() == 2 && near(events.fillPrices[0], 100.00) && near(events.fillPrices[1], 100.00),
+          "both sides filled at the maker's price");
+
+    // Fills are reported before the order updates they cause
+    size_t makerFill = events.log.size(), makerUpdate = events.log.size();
+    for (size_t i = 0; i < events.log.size(); ++i) {
+        if (events.log[i] == "fill " + maker + " 1.000000") {
+            makerFill = std::min(makerFill, i);
+        }
+        if (events.log[i] == "order " + maker + " " + std::to_string(static_cast<int>(OrderStatus::FILLED))) {
+            makerUpdate = i;
+        }
+    }
+    check(makerFill < makerUpdate && makerUpdate < events.log.size(), "maker fill before its FILLED update");
+
+    check(exchange.cancelOrder(taker) && exchange.getOrder(taker).status == OrderStatus::CANCELLED,
+          "resting remainder cancelled");
+    check(exchange.getActiveOrders().empty(), "nothing left active");
+}
+
+void testTickLiquidity() {
+    std::cout << "\n--- Tick liquidity and slippage ---" << std::endl;
+    SimulatedExchangeAPI::SimulationConfig config;
+    config.slippageBps = 10.0;
+    SimulatedExchangeAPI exchange(config);
+    exchange.connect();
+    Events events;
+    record(exchange, events);
+
+    OrderId blind = exchange.placeOrder(order(OrderType::MARKET, OrderSide::BUY, 1.0));
+    check(exchange.getOrder(blind).status == OrderStatus::REJECTED, "market order without a tick rejected");
+
+    exchange.onMarketTick(tick(99.90, 100.10, 100.00, 0));
+    events.fillPrices.clear();
+    OrderId market = exchange.placeOrder(order(OrderType::MARKET, OrderSide::BUY, 1.0));
+    check(exchange.getOrder(market).status == OrderStatus::FILLED, "market buy filled");
+    check(events.fillPrices.size() == 1 && near(events.fillPrices[0], 100.10 * 1.001),
+          "market buy at the ask plus 10bp");
+
+    // A limit through the ask is capped at its limit
+    events.fillPrices.clear();
+    OrderId capped = exchange.placeOrder(order(OrderType::LIMIT, OrderSide::BUY, 1.0, 100.15));
+    check(exchange.getOrder(capped).status == OrderStatus::FILLED && events.fillPrices.size() == 1 &&
+          near(events.fillPrices[0], 100.15), "marketable limit filled at its limit");
+
+    // A resting bid fills once the market's offer trades down through it
+    OrderId resting = exchange.placeOrder(order(OrderType::LIMIT, OrderSide::BUY, 1.0, 99.00));
+    check(exchange.getOrder(resting).status == OrderStatus::SUBMITTED, "bid below the ask rests");
+    exchange.onMarketTick(tick(98.80, 99.20, 99.00, 1));
+    check(exchange.getOrder(resting).status == OrderStatus::SUBMITTED, "offer above the bid leaves it");
+    exchange.onMarketTick(tick(98.80, 98.90, 98.85, 2));
+    check(exchange.getOrder(resting).status == OrderStatus::FILLED, "offer through the bid fills it");
+
+    Position position = exchange.getPosition("BTCUSDT");
+    check(near(position.quantity, 3.0) && position.isLong(), "long 3 after three buys");
+}
+
+void testStops() {
+    std::cout << "\n--- Stops ---" << std::endl;
+    SimulatedExchangeAPI exchange;
+    exchange.connect();
+    Events events;
+    record(exchange, events);
+    exchange.onMarketTick(tick(99.90, 100.10, 100.00, 0));
+
+    OrderId sellStop = exchange.placeOrder(order(OrderType::STOP, OrderSide::SELL, 1.0, 0, 95.00));
+    OrderId buyStop = exchange.placeOrder(order(OrderType::STOP, OrderSide::BUY, 1.0, 0, 105.00));
+    check(exchange.getOrder(sellStop).status == OrderStatus::SUBMITTED &&
+          exchange.getOrder(buyStop).status == OrderStatus::SUBMITTED, "stops armed");
+
+    exchange.onMarketTick(tick(95.40, 95.60, 95.50, 1));
+    check(exchange.getOrder(sellStop).status == OrderStatus::SUBMITTED, "sell stop untouched above its level");
+    exchange.onMarketTick(tick(94.90, 95.10, 95.00, 2));
+    check(exchange.getOrder(sellStop).status == OrderStatus::FILLED, "sell stop triggered at its level");
+    check(events.fillPrices.size() == 1 && near(events.fillPrices[0], 94.90), "sell stop sold at the bid");
+
+    // Moving a stop to a level already crossed triggers it at once
+    Order moved = order(OrderType::STOP, OrderSide::BUY, 1.0, 0, 94.00);
+    check(exchange.modifyOrder(buyStop, moved), "buy stop moved");
+    check(exchange.getOrder(buyStop).status == OrderStatus::FILLED, "crossed buy stop triggered on amend");
+}
+
+void testLatency() {
+    std::cout << "\n--- Latency ---" << std::endl;
+    SimulatedExchangeAPI::SimulationConfig config;
+    config.orderLatency = std::chrono::milliseconds(500);
+    config.cancelLatency = std::chrono::milliseconds(200);
+    SimulatedExchangeAPI exchange(config);
+    exchange.connect();
+    exchange.onMarketTick(tick(99.90, 100.10, 100.00, 0));
+
+    OrderId delayed = exchange.placeOrder(order(OrderType::MARKET, OrderSide::BUY, 1.0));
+    check(exchange.getOrder(delayed).status == OrderStatus::SUBMITTED, "market order in flight");
+    exchange.advanceTime(at(0) + std::chrono::milliseconds(499));
+    check(exchange.getOrder(delayed).status == OrderStatus::SUBMITTED, "still in flight at 499ms");
+    exchange.advanceTime(at(0) + std::chrono::milliseconds(500));
+    check(exchange.getOrder(delayed).status == OrderStatus::FILLED, "filled once the latency elapsed");
+
+    // A cancel in flight loses to a fill that reaches the book first
+    OrderId bid = exchange.placeOrder(order(OrderType::LIMIT, OrderSide::BUY, 1.0, 99.00));
+    exchange.advanceTime(at(1));
+    check(exchange.cancelOrder(bid), "cancel sent");
+    exchange.onMarketTick(tick(98.80, 98.90, 98.85, 1));
+    check(exchange.getOrder(bid).status == OrderStatus::FILLED, "filled before the cancel arrived");
+    exchange.advanceTime(at(2));
+    check(exchange.getOrder(bid).status == OrderStatus::FILLED, "late cancel changes nothing");
+}
+}
+
+int main() {
+    std::cout << "\n=== MATCHING ENGINE TEST ===" << std::endl;
+
+    testPriority();
+    testCancelAndReduce();
+    testIceberg();
+    testCrossingOrders();
+    testTickLiquidity();
+    testStops();
+    testLatency();
+
+    std::cout << "\n" << (failures == 0 ? "All matching engine tests passed" : std::to_string(failures) + " checks failed")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,230 @@
+#include "api/RateLimiter.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MasterMind;
+
+/**
+ * @brief Checks RateLimiter windows and priority lanes against the wall clock
+ *
+ * Windows are short (500ms) and each check starts at a known offset into
+ * one, so the test runs in a few seconds. Covers fixed windows that spend
+ * exactly the limit, usage inside windowGuard carried into the next window,
+ * lanes admitted cancels first, a query passing new orders that only wait
+ * for the order budget but never taking budget they reserve, venue sync and
+ * pause, queue bounds and timeouts, and stop().
+ */
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "  FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool waitFor(const std::function<bool()>& done, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+const int64_t WINDOW_MILLIS = 500;
+
+int64_t wallMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Sleeps until the wall clock is between from and to milliseconds into a window
+void waitForOffset(int64_t from, int64_t to) {
+    while (wallMillis() % WINDOW_MILLIS < from || wallMillis() % WINDOW_MILLIS > to) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+RateLimitConfig config(double weightLimit, double orderLimit = 0) {
+    RateLimitConfig result(weightLimit, std::chrono::milliseconds(WINDOW_MILLIS));
+    result.orderLimit = orderLimit;
+    result.orderWindow = std::chrono::milliseconds(WINDOW_MILLIS);
+    result.windowGuard = Duration::zero();
+    return result;
+}
+
+int drain(RateLimiter& limiter, RequestPriority priority) {
+    int admitted = 0;
+    while (admitted < 1000 && limiter.tryAcquire(priority, 1)) {
+        admitted++;
+    }
+    return admitted;
+}
+
+void testFixedWindow() {
+    std::cout << "\n--- Fixed window ---" << std::endl;
+    RateLimiter limiter(config(10));
+
+    waitForOffset(20, 250);
+    check(drain(limiter, RequestPriority::QUERY) == 10, "exactly the limit in one window");
+    check(limiter.getStats().weightUsed == 10, "10 used");
+
+    waitForOffset(0, 10);  // The next window
+    waitForOffset(20, 250);
+    check(drain(limiter, RequestPriority::QUERY) == 10, "the limit again in the next window");
+
+    // A request costlier than the whole limit goes out alone in a fresh window
+    waitForOffset(0, 10);
+    waitForOffset(20, 250);
+    check(limiter.tryAcquire(RequestPriority::QUERY, 25), "oversized request admitted in a fresh window");
+    check(!limiter.tryAcquire(RequestPriority::QUERY, 1), "nothing after it in that window");
+}
+
+void testGuard() {
+    std::cout << "\n--- Window guard ---" << std::endl;
+    RateLimitConfig guarded = config(10);
+    guarded.windowGuard = std::chrono::milliseconds(150);
+    RateLimiter limiter(guarded);
+
+    // Within the guard: the venue may already count its next window, so the
+    // usage opens the next local window too
+    waitForOffset(20, 100);
+    check(drain(limiter, RequestPriority::QUERY) == 10, "limit admitted inside the guard interval");
+    waitForOffset(180, 300);
+    check(drain(limiter, RequestPriority::QUERY) == 0, "carried usage fills the next local window");
+    check(limiter.getStats().weightUsed == 10, "carry reported as used");
+}
+
+void testLanes() {
+    std::cout << "\n--- Priority lanes ---" << std::endl;
+    RateLimiter limiter(config(5));
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&](const std::string& name) {
+        return [&, name](bool admitted) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(admitted ? name : "refused " + name);
+        };
+    };
+
+    waitForOffset(20, 250);
+    check(drain(limiter, RequestPriority::QUERY) == 5, "budget spent");
+
+    // Queued lowest priority first; admitted highest first when the window opens
+    limiter.submit(RequestPriority::QUERY, 1, 0, record("query1"));
+    limiter.submit(RequestPriority::QUERY, 1, 0, record("query2"));
+    limiter.submit(RequestPriority::NEW_ORDER, 1, 1, record("order1"));
+    limiter.submit(RequestPriority::NEW_ORDER, 1, 1, record("order2"));
+    limiter.submit(RequestPriority::CANCEL, 1, 0, record("cancel1"));
+    limiter.submit(RequestPriority::CANCEL, 1, 0, record("cancel2"));
+    check(limiter.getStats().queued == 6, "six queued");
+    check(!limiter.tryAcquire(RequestPriority::CANCEL, 1), "no jumping a queued lane");
+
+    check(waitFor([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order.size() == 5;
+    }, std::chrono::milliseconds(1000)), "five admitted when the window opened");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        check(order == std::vector<std::string>({"cancel1", "cancel2", "order1", "order2", "query1"}),
+              "cancels, then new orders, then queries");
+    }
+    check(waitFor([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order.size() == 6;
+    }, std::chrono::milliseconds(1000)) && order.back() == "query2", "last query in the window after");
+
+    RateLimiterStats stats = limiter.getStats();
+    check(stats.delayed[static_cast<size_t>(RequestPriority::CANCEL)] == 2 && stats.queued == 0, "lane stats");
+}
+
+void testOrderBudget() {
+    std::cout << "\n--- Order budget ---" << std::endl;
+    RateLimiter limiter(config(3, 1));
+
+    waitForOffset(20, 200);
+    check(limiter.tryAcquire(RequestPriority::NEW_ORDER, 1, 1), "first order");
+    std::atomic<int> orders{0};
+    limiter.submit(RequestPriority::NEW_ORDER, 1, 1, [&orders](bool admitted) { orders += admitted; });
+    check(orders == 0 && limiter.getStats().queued == 1, "second order waits for the order budget");
+
+    // The waiting order reserves 1 of the 2 weight left, so one query passes and one does not
+    check(limiter.tryAcquire(RequestPriority::QUERY, 1), "query passes the order waiting on its own rule");
+    check(!limiter.tryAcquire(RequestPriority::QUERY, 1), "query leaves the order's reserved weight alone");
+    check(waitFor([&]() { return orders == 1; }, std::chrono::milliseconds(1000)), "order admitted next window");
+}
+
+void testVenueFeedback() {
+    std::cout << "\n--- Venue feedback ---" << std::endl;
+    RateLimiter limiter(config(10));
+
+    waitForOffset(20, 200);
+    limiter.sync(RateLimitRule::REQUEST_WEIGHT, 9);
+    check(drain(limiter, RequestPriority::QUERY) == 1, "venue count of 9 leaves one");
+    limiter.sync(RateLimitRule::REQUEST_WEIGHT, 3);
+    check(limiter.getStats().resynced == 1 && limiter.getStats().weightUsed == 10, "lower venue count ignored");
+
+    RateLimiter paused(config(100));
+    paused.pause(std::chrono::milliseconds(200));
+    check(!paused.tryAcquire(RequestPriority::CANCEL, 1), "pause holds cancels too");
+    auto start = std::chrono::steady_clock::now();
+    check(paused.acquire(RequestPriority::CANCEL, 1), "admitted after the pause");
+    double waited = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    check(waited >= 150 && waited < 700, "waited out the pause: " + std::to_string(waited) + "ms");
+    check(paused.getStats().throttled == 1, "throttle counted");
+}
+
+void testQueueBounds() {
+    std::cout << "\n--- Queue bounds ---" << std::endl;
+    RateLimitConfig bounded = config(100);
+    bounded.maxQueued = 2;
+    bounded.maxQueueDelay = std::chrono::milliseconds(100);
+    RateLimiter limiter(bounded);
+    limiter.pause(std::chrono::seconds(5));
+
+    std::atomic<int> admitted{0};
+    std::atomic<int> refused{0};
+    auto count = [&](bool ok) { (ok ? admitted : refused)++; };
+    for (int i = 0; i < 3; ++i) {
+        limiter.submit(RequestPriority::QUERY, 1, 0, count);
+    }
+    check(refused == 1, "third request refused by a full lane");
+    check(waitFor([&]() { return refused == 3; }, std::chrono::milliseconds(1000)) && admitted == 0,
+          "queued requests refused after maxQueueDelay");
+
+    // stop() refuses what waits and everything after
+    limiter.submit(RequestPriority::CANCEL, 1, 0, count);
+    limiter.stop();
+    check(refused == 4, "waiter refused by stop");
+    limiter.submit(RequestPriority::CANCEL, 1, 0, count);
+    check(refused == 5 && !limiter.tryAcquire(RequestPriority::CANCEL, 1), "nothing admitted after stop");
+    check(limiter.getStats().refused == 5, "refusals counted");
+}
+}
+
+int main() {
+    std::cout << "\n=== RATE LIMITER TEST ===" << std::endl;
+
+    testFixedWindow();
+    testGuard();
+    testLanes();
+    testOrderBudget();
+    testVenueFeedback();
+    testQueueBounds();
+
+    std::cout << "\n" << (failures == 0 ? "All rate limiter tests passed" : std::to_string(failures) + " checks failed")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+#include "core/TimerWheel.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MasterMind;
+
+/**
+ * @brief Checks TimerWheel expiry, cascading and cancellation
+ *
+ * Apart from cancelSync(), which needs the driver thread, the wheel is
+ * driven by advance() from a fixed epoch, so every check is exact to the
+ * tick: timers on each of the four levels fire on their
+ * expiry tick and not one earlier, including after cascading down from a
+ * higher level. Cancellation is checked before expiry, for stale and
+ * recycled ids, for a callback already due in the same batch, and with
+ * cancelSync() against a callback running on the driver thread.
+ */
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "  FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool waitFor(const std::function<bool()>& done, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+const TimePoint EPOCH = TimePoint(std::chrono::seconds(1700000000));
+
+TimePoint tickTime(uint64_t tick, Duration interval) {
+    return EPOCH + interval * tick;
+}
+
+void testExpiry() {
+    std::cout << "\n--- Expiry ---" << std::endl;
+    const Duration interval = std::chrono::milliseconds(10);
+    TimerWheel wheel(interval, EPOCH);
+
+    int fired = 0;
+    wheel.schedule(std::chrono::milliseconds(45), [&fired]() { fired++; });  // Rounds up to tick 5
+    wheel.schedule(std::chrono::milliseconds(50), [&fired]() { fired++; });
+    check(wheel.getPendingCount() == 2, "two pending");
+
+    check(wheel.advance(tickTime(4, interval)) == 0 && fired == 0, "nothing at tick 4");
+    check(wheel.advance(tickTime(5, interval)) == 2 && fired == 2, "both at tick 5");
+    check(wheel.getPendingCount() == 0 && wheel.getFiredCount() == 2, "none pending, two fired");
+
+    // A time already passed fires on the next advance
+    wheel.scheduleAt(EPOCH, [&fired]() { fired++; });
+    check(wheel.advance(tickTime(6, interval)) == 1 && fired == 3, "past time fires at once");
+}
+
+void testCascading() {
+    std::cout << "\n--- Cascading ---" << std::endl;
+    const Duration interval = std::chrono::milliseconds(1);
+    TimerWheel wheel(interval, EPOCH);
+
+    // One timer at each level boundary and one inside each level
+    const std::vector<uint64_t> expiries = {255, 256, 300, 65535, 65536, 70000, 16777216, 17000000};
+    std::vector<uint64_t> firedAt(expiries.size(), 0);
+    uint64_t now = 0;
+    for (size_t i = 0; i < expiries.size(); ++i) {
+        wheel.schedule(interval * expiries[i], [&firedAt, &now, i]() { firedAt[i] = now; });
+    }
+
+    for (size_t i = 0; i < expiries.size(); ++i) {
+        now = expiries[i] - 1;
+        wheel.advance(tickTime(now, interval));
+        check(firedAt[i] == 0, "tick " + std::to_string(expiries[i]) + " not fired a tick early");
+        now = expiries[i];
+        wheel.advance(tickTime(now, interval));
+        check(firedAt[i] == expiries[i], "tick " + std::to_string(expiries[i]) + " fired on time, got " +
+              std::to_string(firedAt[i]));
+    }
+    check(wheel.getPendingCount() == 0, "every level drained");
+
+    // Scheduled mid-wheel, so the expiry lands across a level 1 boundary. Tick
+    // `now` is already processed: delays count from the next one.
+    uint64_t start = now + 1;
+    uint64_t landed = 0;
+    wheel.schedule(interval * 1000, [&landed, &now]() { landed = now; });
+    now = start + 999;
+    wheel.advance(tickTime(now, interval));
+    check(landed == 0, "mid-wheel timer not early");
+    now = start + 1000;
+    wheel.advance(tickTime(now, interval));
+    check(landed == start + 1000, "mid-wheel timer on time, got " + std::to_string(landed));
+}
+
+void testCancel() {
+    std::cout << "\n--- Cancel ---" << std::endl;
+    const Duration interval = std::chrono::milliseconds(10);
+    TimerWheel wheel(interval, EPOCH);
+
+    int fired = 0;
+    TimerId near = wheel.schedule(std::chrono::milliseconds(50), [&fired]() { fired++; });
+    TimerId far = wheel.schedule(std::chrono::seconds(10), [&fired]() { fired++; });
+    check(wheel.isScheduled(near) && wheel.isScheduled(far), "both scheduled");
+    check(wheel.cancel(far) && !wheel.isScheduled(far), "level 1 timer cancelled");
+    check(!wheel.cancel(far), "second cancel refused");
+    check(!wheel.cancel(TimerWheel::INVALID_TIMER), "invalid id refused");
+
+    wheel.advance(tickTime(2000, interval));
+    check(fired == 1, "only the uncancelled timer fired");
+    check(!wheel.cancel(near), "fired one-shot cannot be cancelled");
+
+    // The node is recycled under a new generation; the old id must not reach it
+    TimerId recycled = wheel.schedule(std::chrono::milliseconds(50), [&fired]() { fired++; });
+    check(recycled != near && recycled != far, "recycled node has a fresh id");
+    check(!wheel.cancel(near) && !wheel.cancel(far) && wheel.isScheduled(recycled), "stale ids miss the new timer");
+    wheel.advance(tickTime(2010, interval));
+    check(fired == 2, "recycled timer fired");
+
+    // Due together: whichever runs first cancels the other
+    TimerId first = TimerWheel::INVALID_TIMER;
+    TimerId second = TimerWheel::INVALID_TIMER;
+    int ran = 0;
+    first = wheel.schedule(std::chrono::milliseconds(10), [&]() { ran++; wheel.cancel(second); });
+    second = wheel.schedule(std::chrono::milliseconds(10), [&]() { ran++; wheel.cancel(first); });
+    wheel.advance(tickTime(2020, interval));
+    check(ran == 1, "callback cancelled in the same batch did not run");
+}
+
+void testRepeating() {
+    std::cout << "\n--- Repeating ---" << std::endl;
+    const Duration interval = std::chrono::milliseconds(10);
+    TimerWheel wheel(interval, EPOCH);
+
+    std::vector<uint64_t> ticks;
+    uint64_t now = 0;
+    TimerId repeating = TimerWheel::INVALID_TIMER;
+    repeating = wheel.scheduleRepeating(std::chrono::milliseconds(100), [&]() {
+        ticks.push_back(now);
+        if (ticks.size() == 3) {
+            wheel.cancel(repeating);
+        }
+    });
+    for (now = 1; now <= 100; ++now) {
+        wheel.advance(tickTime(now, interval));
+    }
+    check(ticks == std::vector<uint64_t>({10, 20, 30}), "every 10 ticks until cancelled from its callback");
+    check(wheel.getPendingCount() == 0, "cancelled repeating timer released");
+}
+
+void testCancelSync() {
+    std::cout << "\n--- cancelSync ---" << std::endl;
+    TimerWheel wheel(std::chrono::milliseconds(1));
+    wheel.start();
+
+    std::atomic<bool> inside{false};
+    std::atomic<bool> finished{false};
+    TimerId slow = wheel.schedule(std::chrono::milliseconds(5), [&]() {
+        inside = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        finished = true;
+    });
+    check(waitFor([&]() { return inside.load(); }, std::chrono::milliseconds(2000)), "slow callback started");
+    wheel.cancelSync(slow);
+    check(finished, "cancelSync returned only after the running callback");
+
+    // From its own callback it must not wait for itself
+    std::atomic<bool> done{false};
+    std::atomic<TimerId> self{TimerWheel::INVALID_TIMER};
+    self = wheel.schedule(std::chrono::milliseconds(50), [&]() {
+        wheel.cancelSync(self.load());
+        done = true;
+    });
+    check(waitFor([&]() { return done.load(); }, std::chrono::milliseconds(2000)), "cancelSync from own callback");
+
+    wheel.stop();
+}
+}
+
+int main() {
+    std::cout << "\n=== TIMER WHEEL TEST ===" << std::endl;
+
+    testExpiry();
+    testCascading();
+    testCancel();
+    testRepeating();
+    testCancelSync();
+
+    std::cout << "\n" << (failures == 0 ? "All timer wheel tests passed" : std::to_string(failures) + " checks failed")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+#include "api/BinanceAPI.h"
+#include "api/HttpStubServer.h"
+#include "api/OrderBook.h"
+#include "api/StreamingExchangeAPI.h"
+#include "api/WebSocketReplayServer.h"
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MasterMind;
+
+/**
+ * @brief Replays the captured venue feeds in tests/data through the clients
+ *
+ * Each capture is served by WebSocketReplayServer to the venue's own
+ * WebSocketExchangeAPI, and the decoded result is checked against the
+ * capture: the update id of every book change in order, the number of
+ * ticks and the last one, and the top of book once the replay is done.
+ * Binance depth snapshots come from an HttpStubServer; Coinbase and
+ * Deribit send theirs in the stream.
+ *
+ * Usage: VenueReplayTest [data directory], default tests/data
+ */
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "  FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool near(double actual, double expected) {
+    return std::fabs(actual - expected) < 1e-9;
+}
+
+std::string describe(const std::vector<uint64_t>& ids) {
+    std::string text;
+    for (uint64_t id : ids) {
+        text += (text.empty() ? "" : " ") + std::to_string(id);
+    }
+    return text;
+}
+
+struct Expected {
+    Symbol symbol;
+    std::vector<uint64_t> bookSequence;  // getLastUpdateId() after each book callback
+    size_t ticks;
+    Tick lastTick;                       // Volume is the size of the last trade seen
+    Price bestBid;
+    Price bestAsk;
+    size_t bidLevels;
+};
+
+// Decoded market data, as the callbacks saw it
+struct Capture {
+    std::mutex mutex;
+    std::map<Symbol, std::vector<uint64_t>> bookSequence;
+    std::map<Symbol, std::vector<Tick>> ticks;
+};
+
+bool waitFor(const std::function<bool()>& done, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+void replay(WebSocketExchangeAPI& api, const std::string& capture, const std::vector<Expected>& expected) {
+    std::cout << "\n--- " << api.getExchangeName() << " (" << capture << ") ---" << std::endl;
+
+    WebSocketReplayServer server;
+    if (!server.loadCapture(capture) || !server.start()) {
+        check(false, "replay server for " + capture);
+        return;
+    }
+
+    Capture seen;
+    api.setOrderBookCallback([&api, &seen](const Symbol& symbol) {
+        auto book = api.getOrderBook(symbol);
+        std::lock_guard<std::mutex> lock(seen.mutex);
+        seen.bookSequence[symbol].push_back(book ? book->getLastUpdateId() : 0);
+    });
+    api.setTickCallback([&seen](const Tick& tick) {
+        std::lock_guard<std::mutex> lock(seen.mutex);
+        seen.ticks[tick.symbol].push_back(tick);
+    });
+
+    std::vector<Symbol> symbols;
+    for (const auto& symbol : expected) {
+        symbols.push_back(symbol.symbol);
+    }
+    api.setStreamEndpoint(server.getUrl(""));
+    check(api.subscribeMarketData(symbols), "subscribe: " + api.getLastError());
+    check(server.waitForMessagesSent(server.getMessageCount(), std::chrono::milliseconds(5000)),
+          "all " + std::to_string(server.getMessageCount()) + " frames sent");
+
+    // Books behind a REST snapshot catch up after the last frame
+    bool settled = waitFor([&]() {
+        std::lock_guard<std::mutex> lock(seen.mutex);
+        for (const auto& symbol : expected) {
+            if (seen.bookSequence[symbol.symbol].size() < symbol.bookSequence.size() ||
+                seen.ticks[symbol.symbol].size() < symbol.ticks) {
+                return false;
+            }
+        }
+        return true;
+    }, std::chrono::milliseconds(5000));
+    check(settled, "every book update and tick decoded");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  // Nothing extra trails in
+
+    for (const auto& symbol : expected) {
+        std::vector<uint64_t> sequence;
+        std::vector<Tick> ticks;
+        {
+            std::lock_guard<std::mutex> lock(seen.mutex);
+            sequence = seen.bookSequence[symbol.symbol];
+            ticks = seen.ticks[symbol.symbol];
+        }
+        const Symbol& name = symbol.symbol;
+        std::cout << name << ": " << sequence.size() << " book updates, " << ticks.size() << " ticks" << std::endl;
+
+        check(sequence == symbol.bookSequence, name + " book sequence " + describe(sequence) +
+              ", expected " + describe(symbol.bookSequence));
+        check(ticks.size() == symbol.ticks, name + " tick count " + std::to_string(ticks.size()) +
+              ", expected " + std::to_string(symbol.ticks));
+
+        Tick last = api.getLastTick(name);
+        const Tick& want = symbol.lastTick;
+        check(near(last.bid, want.bid) && near(last.ask, want.ask) && near(last.last, want.last) &&
+              near(last.volume, want.volume),
+              name + " last tick " + std::to_string(last.bid) + "/" + std::to_string(last.ask) + " last " +
+              std::to_string(last.last) + " x " + std::to_string(last.volume));
+        if (!ticks.empty()) {
+            check(near(ticks.back().last, last.last) && near(ticks.back().bid, last.bid),
+                  name + " callback and getLastTick agree");
+        }
+
+        auto book = api.getOrderBook(name);
+        check(book != nullptr, name + " has a book");
+        if (book) {
+            check(near(book->getBestBid(), symbol.bestBid) && near(book->getBestAsk(), symbol.bestAsk),
+                  name + " top of book " + std::to_string(book->getBestBid()) + "/" +
+                  std::to_string(book->getBestAsk()));
+            check(book->getDepth(OrderSide::BUY, 1000).size() == symbol.bidLevels,
+                  name + " bid levels " + std::to_string(book->getDepth(OrderSide::BUY, 1000).size()));
+        }
+    }
+
+    api.disconnect();
+    server.stop();
+    api.setOrderBookCallback(nullptr);
+    api.setTickCallback(nullptr);
+}
+
+Tick tick(Price bid, Price ask, Price last, Volume volume) {
+    return Tick("", bid, ask, last, volume, TimePoint());
+}
+
+// Depth snapshots for the Binance capture: one far level a side, each just before the first diff
+HttpStubResponse binanceDepth(const HttpStubRequest& request) {
+    if (request.target.find("symbol=BTCUSDT") != std::string::npos) {
+        return HttpStubResponse(200, "{\"lastUpdateId\":47000000001,"
+                                     "\"bids\":[[\"67000.00\",\"1.0\"]],\"asks\":[[\"67500.00\",\"1.0\"]]}");
+    }
+    if (request.target.find("symbol=ETHUSDT") != std::string::npos) {
+        return HttpStubResponse(200, "{\"lastUpdateId\":31000000000,"
+                                     "\"bids\":[[\"3500.00\",\"1.0\"]],\"asks\":[[\"3600.00\",\"1.0\"]]}");
+    }
+    return HttpStubResponse(404, "{\"code\":-1121,\"msg\":\"Invalid symbol.\"}");
+}
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "\n=== VENUE REPLAY TEST ===" << std::endl;
+    std::string data = argc > 1 ? argv[1] : "tests/data";
+
+    HttpStubServer rest;
+    rest.setHandler(binanceDepth);
+    if (!rest.start()) {
+        std::cout << "Could not start the REST stub" << std::endl;
+        return 1;
+    }
+
+    {
+        // Snapshot, then every diff from the capture, held ones included
+        BinanceAPI binance;
+        binance.setBaseUrl(rest.getUrl());
+        replay(binance, data + "/binance_frames.jsonl", {
+            {"BTCUSDT",
+             {47000000001, 47000000007, 47000000013, 47000000016, 47000000019, 47000000026, 47000000032},
+             14, tick(67250.07, 67250.08, 67250.09, 0.18303966), 67250.07, 67250.11, 23},
+            {"ETHUSDT",
+             {31000000000, 31000000006, 31000000009, 31000000015, 31000000020, 31000000023, 31000000026,
+              31000000031},
+             13, tick(3520.47, 3520.48, 3520.48, 0.00913918), 3520.41, 3520.44, 23},
+        });
+    }
+    {
+        // level2_batch carries no sequence numbers: a snapshot and 12 updates per product
+        StreamingExchangeAPI coinbase(Exchange::COINBASE);
+        check(coinbase.connect(), "Coinbase connect");
+        replay(coinbase, data + "/coinbase_frames.jsonl", {
+            {"BTC-USD", std::vector<uint64_t>(13, 0),
+             9, tick(67250.01, 67250.02, 67250.01, 0.005), 67250.01, 67250.02, 2},
+            {"ETH-USD", std::vector<uint64_t>(13, 0),
+             4, tick(3520.18, 3520.19, 3520.19, 0.0), 3520.18, 3520.19, 2},
+        });
+    }
+    {
+        // Snapshot in the stream, then change_id per change; one BTC trades message carries two trades
+        StreamingExchangeAPI deribit(Exchange::DERIBIT);
+        check(deribit.connect(), "Deribit connect");
+        replay(deribit, data + "/deribit_frames.jsonl", {
+            {"BTC-PERPETUAL",
+             {68000000001, 68000000004, 68000000008, 68000000011, 68000000015, 68000000018, 68000000022,
+              68000000025, 68000000029, 68000000032, 68000000036, 68000000039, 68000000043},
+             12, tick(67250.0, 67250.5, 67250.5, 120.0), 67250.0, 67250.5, 2},
+            {"ETH-PERPETUAL",
+             {41000000001, 41000000003, 41000000005, 41000000007, 41000000009, 41000000011, 41000000013,
+              41000000015, 41000000017, 41000000019, 41000000021, 41000000023, 41000000025},
+             7, tick(3520.2, 3520.25, 3520.25, 42.0), 3520.2, 3520.25, 2},
+        });
+    }
+
+    std::cout << "\n" << (failures == 0 ? "All replays passed" : std::to_string(failures) + " checks failed")
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}